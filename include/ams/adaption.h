@@ -2,8 +2,10 @@
 #define SERDES_AMS_ADAPTION_H
 
 #include <systemc>
+#include <deque>
 #include <vector>
 #include "common/parameters.h"
+#include "common/checkpoint.h"
 
 namespace serdes {
 
@@ -16,6 +18,14 @@ namespace serdes {
  * - Threshold adaptation (based on statistics from DfeAdaptTdf)
  * - Vref command generation (for DfeAdaptTdf, when Vref adaptation is enabled)
  *
+ * Scheduling (AdaptionParams::update_mode):
+ * - "multi-rate" / "periodic": fast and slow SC_THREADs wake every
+ *   fast_update_period / slow_update_period
+ * - "event": one SC_THREAD woken by adapt_tick, a decimated counter from
+ *   the TDF side (DfeAdaptTdf). Each wake runs all fast/slow loop updates
+ *   that fell due since the last one, and the thread sleeps on mode/reset
+ *   only while frozen or with every loop disabled
+ *
  * Note: DFE tap update has been moved to DfeAdaptTdf (TDF domain, Plan A).
  *       This module no longer maintains DFE history or performs tap updates.
  */
@@ -41,6 +51,9 @@ public:
     sc_core::sc_in<double> stat_Delta;        // Asymmetry metric
     sc_core::sc_in<int> stat_dfe_state;       // DFE state machine state (0=STARTUP,1=ACQUIRE,2=TRACK)
 
+    // Decimated wake-up tick from the TDF side (update_mode "event" only)
+    sc_core::sc_vector<sc_core::sc_in<int>> adapt_tick;
+
     // ========================================================================
     // Output Ports (to RX/CDR)
     // ========================================================================
@@ -84,6 +97,19 @@ public:
      */
     double get_current_gain() const { return m_current_gain; }
 
+    /**
+     * @brief CTLE setting driven on ctle_zero/ctle_pole/ctle_dc_gain
+     *
+     * AdaptionDe does not adapt the CTLE; it holds this setting (seeded by
+     * RxTopModule from RxCtleParams). Non-positive values (the default)
+     * tell RxCtleTdf to keep its own setting.
+     */
+    void set_ctle_setting(double zero, double pole, double dc_gain) {
+        m_ctle_zero = zero;
+        m_ctle_pole = pole;
+        m_ctle_dc_gain = dc_gain;
+    }
+
     /**
      * @brief Get update count
      */
@@ -94,6 +120,26 @@ public:
      */
     bool is_frozen() const { return m_freeze_flag; }
 
+    /**
+     * @brief Get number of scheduler wake-ups that ran loop updates
+     */
+    int get_wake_count() const { return m_wake_count; }
+
+    /**
+     * @brief Store loop state (AGC/CDR integrators, commands, counters)
+     *        under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+
+    /**
+     * @brief Continue from a checkpoint; call before sc_start so the
+     *        initial output writes carry the restored values
+     *
+     * Rollback snapshots are not restored (they are time-stamped against
+     * the saving run); the restored state starts a fresh snapshot history.
+     */
+    void restore_state(const StateCheckpoint& cp);
+
 private:
     // ========================================================================
     // Parameters
@@ -119,11 +165,17 @@ private:
     // Vref command state
     double m_current_vref_cmd;      // Current Vref command value
 
+    // CTLE setting (held, see set_ctle_setting)
+    double m_ctle_zero;
+    double m_ctle_pole;
+    double m_ctle_dc_gain;
+
     // Update tracking
     int m_update_count;             // Total update count
     int m_fast_update_count;        // Fast path update count
     int m_slow_update_count;        // Slow path update count
     bool m_freeze_flag;             // Freeze flag
+    int m_wake_count;               // Scheduler wake-ups that ran updates
 
     // Snapshot structure for rollback
     struct Snapshot {
@@ -138,12 +190,15 @@ private:
         Snapshot() : vga_gain(0), threshold(0), hysteresis(0),
                      phase_cmd(0), vref_cmd(0), valid(false) {}
     };
-    std::vector<Snapshot> m_snapshots;
+    std::deque<Snapshot> m_snapshots;   // Bounded ring (oldest dropped first)
     sc_core::sc_time m_last_snapshot_time;
 
     // Timing
     sc_core::sc_time m_fast_period;
     sc_core::sc_time m_slow_period;
+    sc_core::sc_time m_last_fast_time;  // Last fast update due time ("event" mode)
+    sc_core::sc_time m_last_slow_time;  // Last slow update due time ("event" mode)
+    sc_core::sc_event m_wake_event;     // Wakes the event thread after reset
 
     // ========================================================================
     // SC_METHOD/SC_THREAD Processes
@@ -161,6 +216,12 @@ private:
      */
     void slow_path_process();
 
+    /**
+     * @brief Event-driven scheduler ("event" mode)
+     * Woken by adapt_tick; runs the fast/slow updates due since last wake
+     */
+    void event_path_process();
+
     /**
      * @brief Reset handler process
      * Triggered by reset signal
@@ -171,6 +232,25 @@ private:
     // Algorithm Implementation Methods
     // ========================================================================
 
+    /**
+     * @brief Run n fast-path loop updates (freeze check, CDR PI)
+     * @param current_mode Operating mode
+     * @param n Number of fast_update_period steps to apply
+     */
+    void fast_path_update(int current_mode, int n);
+
+    /**
+     * @brief Run n slow-path loop updates (snapshot, AGC, Vref command)
+     * @param current_mode Operating mode
+     * @param n Number of slow_update_period steps to apply
+     */
+    void slow_path_update(int current_mode, int n);
+
+    /**
+     * @brief True when no loop would update (frozen or all disabled)
+     */
+    bool is_idle(int current_mode) const;
+
     /**
      * @brief AGC PI controller update
      * @param amplitude Current amplitude RMS
@@ -0,0 +1,123 @@
+#ifndef SERDES_BATHTUB_H
+#define SERDES_BATHTUB_H
+
+#include <cstdint>
+#include <vector>
+#include "common/parameters.h"
+
+namespace serdes {
+
+/**
+ * @brief Per-phase amplitude histograms of the sampler input, split by level
+ *
+ * Phase p is (p - num_phases / 2) / num_phases UI from the eye center; each
+ * phase keeps one histogram for UIs decided as 1 and one for UIs decided as
+ * 0. Samples outside [v_min, v_max) are counted in the end bins.
+ */
+class EyeHistogram {
+public:
+    /**
+     * @throws std::invalid_argument for num_phases < 1, num_bins < 2 or v_max <= v_min
+     */
+    EyeHistogram(int num_phases, int num_bins, double v_min, double v_max);
+
+    void add(int phase, bool one, double v);
+    void clear();
+
+    int get_num_phases() const { return m_num_phases; }
+    int get_num_bins() const { return m_num_bins; }
+    double get_v_min() const { return m_v_min; }
+    double get_v_max() const { return m_v_max; }
+    double get_bin_width() const { return (m_v_max - m_v_min) / m_num_bins; }
+
+    std::uint64_t count(int phase, bool one, int bin) const {
+        return m_counts[index(phase, one) + bin];
+    }
+    std::uint64_t total(int phase, bool one) const {
+        return m_totals[2 * phase + (one ? 1 : 0)];
+    }
+
+private:
+    size_t index(int phase, bool one) const {
+        return (2 * static_cast<size_t>(phase) + (one ? 1 : 0)) * m_num_bins;
+    }
+
+    int m_num_phases;
+    int m_num_bins;
+    double m_v_min;
+    double m_v_max;
+    std::vector<std::uint64_t> m_counts;    // num_phases x {0, 1} x num_bins
+    std::vector<std::uint64_t> m_totals;    // num_phases x {0, 1}
+};
+
+/**
+ * @brief Inner tail of one level: P(error side of v) = rho * Q(|v - mu| / sigma)
+ *
+ * For the 1 level the tail is P(V < v), for the 0 level P(V > v). rho is the
+ * weight of the innermost Dirac (1 for the Gaussian model).
+ */
+struct TailFit {
+    double rho;
+    double mu;                        // V
+    double sigma;                     // V
+    int num_points;                   // Bin edges in the fit (0 = moment fallback)
+};
+
+/**
+ * @brief Extrapolated bathtubs and contours of one EyeHistogram
+ */
+struct BathtubResult {
+    int num_phases;
+    std::vector<double> phase;        // UI from the eye center
+    std::vector<TailFit> fit_one;     // Per phase: lower tail of the 1 level
+    std::vector<TailFit> fit_zero;    // Per phase: upper tail of the 0 level
+    std::vector<double> ber_threshold;   // Horizontal bathtub: BER at the threshold per phase
+    int best_index;                   // Phase with the lowest BER at the threshold
+    double best_phase;                // UI
+    std::vector<double> voltage;      // Vertical bathtub grid (V), the bin centers
+    std::vector<double> ber_vertical; // Vertical bathtub at best_phase
+    std::vector<double> target_bers;
+    std::vector<std::vector<double>> contour_upper;   // [target][phase], 0 where closed
+    std::vector<std::vector<double>> contour_lower;   // [target][phase], 0 where closed
+    std::vector<double> eye_height;   // Per target: largest upper - lower (V)
+    std::vector<double> eye_width;    // Per target: open span of the horizontal bathtub (UI)
+};
+
+/**
+ * @throws std::invalid_argument for out-of-range BathtubParams
+ */
+void validate_bathtub_params(const BathtubParams& params);
+
+/**
+ * @brief Fit the inner tail of one level (Q-scale fit)
+ *
+ * The bin edges whose tail probability T lies in [min_tail_count / N,
+ * tail_fraction] give points Q^-1(T / rho) that are linear in v for the
+ * model above. "gaussian" fits the line with rho = 1; "dual_dirac" also
+ * scans rho (from twice the largest T up to 1) for the best straight line.
+ * With fewer than 3 points the level's mean and standard deviation are used.
+ */
+TailFit fit_level_tail(const EyeHistogram& hist, int phase, bool one, const BathtubParams& params);
+
+/**
+ * @brief BER at threshold v: empirical where the histogram has hits, the
+ *        fitted tails beyond the last fitted edge
+ */
+double extrapolated_ber(const EyeHistogram& hist, int phase, double v,
+                        const TailFit& fit_one, const TailFit& fit_zero,
+                        const BathtubParams& params);
+
+/**
+ * @brief Fit every phase and build the bathtubs and the target-BER contours
+ *
+ * The horizontal bathtub is the per-phase BER at params.threshold, so the
+ * eye width at 1e-15 comes from amplitude tails measured over far fewer UI.
+ * Widths are interpolated on log10(BER) between phases; contours are found
+ * by scanning outwards from the threshold and bisecting.
+ * @throws std::invalid_argument for bad parameters or an empty histogram
+ */
+BathtubResult compute_bathtub(const EyeHistogram& hist, const BathtubParams& params);
+
+} // namespace serdes
+
+#endif // SERDES_BATHTUB_H
@@ -0,0 +1,111 @@
+#ifndef SERDES_CDR_NCO_H
+#define SERDES_CDR_NCO_H
+
+#include <cstdint>
+#include <string>
+#include "common/checkpoint.h"
+
+namespace serdes {
+
+/**
+ * @brief Fixed-point phase accumulator for the CDR sampling clock
+ *
+ * One UI is the full 2^64 range of an unsigned accumulator, so the UI wrap is
+ * the natural integer overflow and sampling points are integer compares.
+ * The phase interpolator is an integer code; code * resolution is the phase
+ * offset, positive codes delaying the sampling instant. The per-timestep
+ * increment is rounded once at configure(), so the phase never accumulates
+ * rounding error, however long the run.
+ */
+class CdrPhaseNco {
+public:
+    static const std::uint64_t EDGE_POINT = 0;                  ///< UI boundary
+    static const std::uint64_t DATA_POINT = 1ull << 63;         ///< UI center
+
+    CdrPhaseNco();
+
+    /**
+     * @param ui Unit interval (s)
+     * @param timestep Simulation timestep (s)
+     * @param resolution Phase interpolator step (s)
+     */
+    void configure(double ui, double timestep, double resolution);
+
+    /**
+     * @brief Clear accumulator and PI code
+     */
+    void reset();
+
+    /**
+     * @brief Set phase interpolator code (phase offset = code * resolution)
+     */
+    void set_code(std::int64_t code);
+    std::int64_t get_code() const { return m_code; }
+
+    /**
+     * @brief Advance the free-running accumulator by one timestep
+     */
+    void advance() {
+        m_prev = m_last;
+        m_acc += m_inc;
+        m_last = phase();
+    }
+
+    /**
+     * @brief Total phase within the UI (accumulator - interpolator offset)
+     */
+    std::uint64_t phase() const { return m_acc - m_offset; }
+
+    /**
+     * @brief Whether `target` lies in the phase interval covered since the
+     *        previous advance(), including interpolator code steps
+     *
+     * A code step that moves the phase backwards cannot re-cross a target
+     * already passed, so each sampling point fires once per UI.
+     * @param since Phase elapsed since the crossing, clamped below one
+     *              timestep increment (valid when true)
+     */
+    bool crossed(std::uint64_t target, std::uint64_t& since) const {
+        std::uint64_t delta = phase() - m_prev;
+        if (delta >= DATA_POINT) {
+            return false;           // Net backward move: no crossing
+        }
+        since = phase() - target;
+        if (since >= delta) {
+            return false;
+        }
+        if (m_inc > 0 && since >= m_inc) {
+            since = m_inc - 1;      // Crossed by a forward code step
+        }
+        return true;
+    }
+
+    /**
+     * @brief Convert phase units to seconds
+     */
+    double to_seconds(std::uint64_t units) const;
+
+    std::uint64_t get_increment() const { return m_inc; }
+    std::uint64_t get_code_step() const { return m_code_step; }
+
+    /**
+     * @brief Save / restore accumulator, code and crossing window under
+     *        "<key>."; restore after configure()
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+private:
+    double m_ui;
+    std::uint64_t m_inc;          // Phase units per timestep
+    std::uint64_t m_code_step;    // Phase units per interpolator code
+    std::uint64_t m_acc;          // Free-running accumulator
+    std::int64_t m_code;          // Phase interpolator code
+    std::uint64_t m_offset;       // code * m_code_step (mod 2^64)
+    std::uint64_t m_last;         // Phase at the last advance()
+    std::uint64_t m_prev;         // Phase at the advance() before that
+};
+
+} // namespace serdes
+
+#endif // SERDES_CDR_NCO_H
@@ -0,0 +1,69 @@
+#ifndef SERDES_CDR_PHASE_DETECTOR_H
+#define SERDES_CDR_PHASE_DETECTOR_H
+
+#include <string>
+#include "common/types.h"
+#include "common/checkpoint.h"
+
+namespace serdes {
+
+/**
+ * @brief Phase detector policy for RxCdrTdf
+ *
+ * Output convention (all types): negative when the data sample is late
+ * (sampling should move earlier), positive when early. BANG_BANG and
+ * MUELLER_MULLER return -1/0/+1; HOGGE returns a value in [-1, 1]
+ * proportional to the timing error.
+ *
+ * - BANG_BANG (Alexander): edge + data sample per UI, decisions only
+ * - HOGGE: edge + data sample per UI; the edge sample amplitude, normalized
+ *   by the data amplitude, gives a linear (Hogge-like) characteristic.
+ *   Needs analog sample values.
+ * - MUELLER_MULLER: baud-rate, sign of y[k]d[k-1] - y[k-1]d[k]; one data
+ *   sample per UI, no edge sampling. Needs analog sample values.
+ *
+ * LINEAR and TRI_STATE are not sampled-data detectors and are rejected.
+ */
+class CdrPhaseDetector {
+public:
+    CdrPhaseDetector();
+
+    /**
+     * @param type Detector type
+     * @param threshold Decision threshold applied to the samples
+     * @throws std::invalid_argument for unsupported types
+     */
+    void configure(PhaseDetectorType type, double threshold);
+
+    void reset();
+
+    /**
+     * @brief Whether the detector consumes an edge (UI boundary) sample
+     */
+    bool needs_edge_sample() const { return m_type != PhaseDetectorType::MUELLER_MULLER; }
+
+    /**
+     * @brief Evaluate one UI
+     * @param edge Sample at the UI boundary preceding `data` (ignored by MM)
+     * @param data Sample at the data instant
+     * @return Phase error (see class convention)
+     */
+    double detect(double edge, double data);
+
+    PhaseDetectorType get_type() const { return m_type; }
+
+    /**
+     * @brief Save / restore the previous data sample under "<key>."
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+private:
+    PhaseDetectorType m_type;
+    double m_threshold;
+    double m_prev_data;           ///< Previous UI's data sample
+};
+
+} // namespace serdes
+
+#endif // SERDES_CDR_PHASE_DETECTOR_H
@@ -3,7 +3,10 @@
 
 #include <systemc-ams>
 #include "common/parameters.h"
+#include "ams/crosstalk_aggressor.h"
+#include "ams/state_space_kernel.h"
 #include <vector>
+#include <complex>
 #include <string>
 #include <memory>
 #include <deque>
@@ -68,6 +71,21 @@ struct ChannelExtendedParams {
     
     // Configuration file path (JSON from Python preprocessing)
     std::string config_file;
+    
+    // State-space kernel precision (DOUBLE keeps the sca_ss signoff path)
+    ChannelPrecision precision = ChannelPrecision::DOUBLE;
+    
+    // Add E*du/dt (backward difference over one timestep) to the state-space
+    // output; off keeps the sca_ss output y = C*x + D*u
+    bool apply_e_matrix = false;
+    
+    // Accuracy check of FLOAT/MIXED against the sca_ss path:
+    // for the first precision_check_samples both run in lockstep on the live
+    // input and the sca_ss output is written; the channel then stays on
+    // DOUBLE if the relative error exceeds tolerance
+    bool precision_check = true;
+    int precision_check_samples = 8192;
+    double precision_tolerance = 1e-3;   // Max |error| / peak output
 };
 
 
@@ -126,11 +144,45 @@ public:
      */
     ChannelMethod get_method() const { return m_ext_params.method; }
     
+    /**
+     * Get active state-space kernel precision (after any fallback)
+     */
+    ChannelPrecision get_precision() const { return m_ext_params.precision; }
+    
+    /**
+     * Get result of the reduced-precision accuracy check (complete once
+     * precision_check_samples have been processed)
+     */
+    const PrecisionReport& get_precision_report() const { return m_precision_report; }
+    
+    /**
+     * Store filter, state-space kernel and aggressor state under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+    
+    /**
+     * Continue from a checkpoint; applied at the next initialize()
+     */
+    void restore_state(const StateCheckpoint& cp);
+    
     /**
      * Get DC gain of the channel
      */
     double get_dc_gain() const;
     
+    /**
+     * Get the continuous-time response of one output/input pair
+     * 
+     * SIMPLE: attenuation with a one-pole roll-off at bandwidth_hz.
+     * STATE_SPACE: C (j2pi*f I - A)^-1 B + D of the active matrices, plus
+     * j2pi*f E with apply_e_matrix; the terms the sca_ss path evaluates
+     * (delays are not applied).
+     * Valid after construction; crosstalk aggressors are not included.
+     * @throws std::invalid_argument for out-of-range port indices
+     */
+    std::vector<std::complex<double>> get_frequency_response(const std::vector<double>& freqs,
+                                                             int output = 0, int input = 0) const;
+    
     /**
      * Get number of active inputs
      */
@@ -141,6 +193,17 @@ public:
      */
     int get_n_active_outputs() const { return m_port_config.active_outputs.size(); }
     
+    /**
+     * Get number of crosstalk aggressors superposed on the victim output
+     */
+    int get_n_aggressors() const { return static_cast<int>(m_aggressors.size()); }
+    
+    /**
+     * Get total (differential) crosstalk voltage added in the last
+     * processing() call
+     */
+    double get_crosstalk_output() const { return m_xtalk_out; }
+    
     /**
      * Initialize state-space model
      * Sets up sca_ss filter from state-space matrices
@@ -174,6 +237,26 @@ private:
     // State-space filter and state
     sca_tdf::sca_ss m_ss_filter;
     sca_util::sca_vector<double> m_ss_state;
+    bool m_ss_started;                   // First sample processed (or state restored)
+    bool m_ss_has_e;                     // apply_e_matrix and any nonzero E
+    sca_util::sca_vector<double> m_ss_u_prev;
+    
+    // Reduced-precision discrete kernels (FLOAT / MIXED policies)
+    DiscreteStateSpace m_discrete_ss;
+    StateSpaceStepper<float, float> m_float_kernel;
+    StateSpaceStepper<float, double> m_mixed_kernel;
+    std::vector<double> m_kernel_u;
+    std::vector<double> m_kernel_y;
+    PrecisionReport m_precision_report;
+    int m_precision_check_left;          // Samples left in the lockstep check
+    
+    // Crosstalk aggressors (symbol-rate superposition, see CrosstalkAggressor)
+    std::vector<CrosstalkAggressor> m_aggressors;
+    double m_xtalk_out;
+    std::vector<double> m_xtalk_share;   // Per output, see crosstalk_output_share()
+    
+    // Pending checkpoint restore, applied in initialize()
+    StateCheckpoint m_restore;
     
     // Initialization flags
     bool m_config_loaded;
@@ -181,6 +264,11 @@ private:
     
     // Private methods
     void init_simple_model();
+    void init_crosstalk();
+    void init_precision_kernel();
+    void finish_precision_check();
+    double process_crosstalk();
+    void apply_restore();
     
     // Extract active matrices from full model based on port_config
     void extract_active_matrices();
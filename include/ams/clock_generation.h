@@ -4,17 +4,19 @@
  * 
  * This module implements clock generation with multiple modes:
  * - IDEAL: Ideal clock with no jitter or noise
- * - PLL: Analog Phase-Locked Loop (parameter structure defined, not yet implemented)
+ * - PLL: Charge-pump PLL, phase-domain model (PllPhaseModel)
  * - ADPLL: All-Digital PLL (parameter structure defined, not yet implemented)
  * 
  * Features:
  * - Phase accumulator architecture for precise phase generation
- * - Adaptive time step based on clock frequency
+ * - Time step of samples_per_period per clock period, or inherited from
+ *   the cluster (samples_per_period = 0) so the clock runs at the data rate
+ * - Optional rising-edge timestamp output (edge_output)
  * - Phase output in radians (0 to 2*pi range)
  * - Support for future PLL/ADPLL extension
  * 
- * @note Current implementation supports IDEAL mode only.
- *       PLL and ADPLL modes are planned for future versions.
+ * @note ADPLL mode is planned for a future version and currently
+ *       falls back to IDEAL.
  * 
  * @version 0.2
  * @date 2026-01-21
@@ -25,6 +27,7 @@
 
 #include <systemc-ams>
 #include "common/parameters.h"
+#include "ams/pll_phase_model.h"
 
 namespace serdes {
 
@@ -43,7 +46,8 @@ namespace serdes {
  * 
  * Design Principles:
  * - Phase accumulator avoids floating-point cumulative errors
- * - Time step adapts to clock frequency (100 samples per period)
+ * - Time step adapts to clock frequency (samples_per_period, default 100)
+ *   or follows the cluster; the phase increment uses the actual timestep
  * - Modulo 2*pi operation ensures numerical stability
  */
 class ClockGenerationTdf : public sca_tdf::sca_module {
@@ -58,6 +62,13 @@ public:
      * Downstream modules use this for sampling timing
      */
     sca_tdf::sca_out<double> clk_phase;
+    
+    /**
+     * @brief Rising-edge timestamp output (present only when edge_output)
+     * Absolute time (s) of the last rising edge (phase wrap) in the
+     * interval (t - timestep, t], or -1 if there was none
+     */
+    sc_core::sc_vector<sca_tdf::sca_out<double>> clk_edge;
 
     // ========================================================================
     // Constructor
@@ -78,15 +89,17 @@ public:
      * @brief Set module attributes (port rates, time step)
      * 
      * Sets adaptive time step based on clock frequency:
-     * timestep = 1 / (frequency * 100)
-     * This ensures 100 samples per clock period.
+     * timestep = 1 / (frequency * samples_per_period)
+     * With samples_per_period = 0 no timestep is set and the module
+     * inherits the cluster timestep (e.g. the data-path rate).
      */
     void set_attributes();
     
     /**
      * @brief Initialize module state
      * 
-     * Resets phase accumulator to initial value.
+     * Resets phase accumulator to initial value and derives the phase
+     * increment from the actual timestep.
      */
     void initialize();
     
@@ -122,6 +135,12 @@ public:
      */
     ClockType get_type() const { return m_params.type; }
     
+    /**
+     * @brief Get PLL loop state (control voltage, PFD error, VCO frequency)
+     * @return Phase-domain PLL model (meaningful in PLL mode only)
+     */
+    const PllPhaseModel& get_pll() const { return m_pll; }
+    
     /**
      * @brief Get phase increment per time step
      * @return Phase increment in radians
@@ -132,7 +151,12 @@ public:
      * @brief Get expected time step
      * @return Time step in seconds
      */
-    double get_expected_timestep() const { return 1.0 / (m_frequency * 100.0); }
+    double get_expected_timestep() const {
+        if (m_params.samples_per_period > 0) {
+            return 1.0 / (m_frequency * m_params.samples_per_period);
+        }
+        return m_timestep;  // Inherited; known after initialize()
+    }
 
 private:
     // ========================================================================
@@ -143,6 +167,9 @@ private:
     double m_phase;                 ///< Current phase accumulator (radians)
     double m_frequency;             ///< Clock frequency (Hz)
     double m_phase_increment;       ///< Phase increment per time step (radians)
+    double m_timestep;              ///< Actual time step (s), set in initialize()
+    double m_edge_time;             ///< Pending rising-edge timestamp (s), -1 if none
+    PllPhaseModel m_pll;            ///< PLL loop and VCO phase (PLL mode)
 
     // ========================================================================
     // Private Methods
@@ -161,8 +188,9 @@ private:
     void process_ideal();
     
     /**
-     * @brief Process PLL clock mode (placeholder)
-     * @note Not yet implemented, falls back to IDEAL mode
+     * @brief Process PLL clock mode
+     * Outputs the VCO phase, then advances the phase-domain loop by one
+     * timestep (loop updates happen at the reference edges inside it)
      */
     void process_pll();
     
@@ -171,6 +199,11 @@ private:
      * @note Not yet implemented, falls back to IDEAL mode
      */
     void process_adpll();
+    
+    /**
+     * @brief Write the pending edge timestamp (edge_output only)
+     */
+    void write_edge();
 };
 
 } // namespace serdes
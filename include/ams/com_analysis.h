@@ -0,0 +1,120 @@
+#ifndef SERDES_COM_ANALYSIS_H
+#define SERDES_COM_ANALYSIS_H
+
+#include <complex>
+#include <vector>
+#include "common/parameters.h"
+
+namespace serdes {
+
+/**
+ * @brief One member of the CTLE family: replaces the first zero, the first
+ *        pole and the DC gain of RxCtleParams (the CtleCoeffBank knobs)
+ */
+struct ComCtleSetting {
+    double zero;
+    double pole;
+    double dc_gain;
+};
+
+/**
+ * @brief COM of one channel and the equalizer setting that achieves it
+ */
+struct ComResult {
+    double com_db;                    // 20 log10(signal / noise)
+    double signal;                    // Main cursor A_s (V)
+    double noise;                     // Noise + interference A_ni at target_der (V)
+    int ffe_index;                    // Best TX FFE preset
+    int ctle_index;                   // Best CTLE setting
+    std::vector<double> ffe_taps;     // Taps of the best preset
+    ComCtleSetting ctle;
+    std::vector<double> dfe_taps;     // Volts / vtap, clamped; UI-spaced post-cursors 1..num_taps
+    std::vector<double> com_table;    // COM (dB) of every case, num_ctle x num_ffe
+};
+
+/**
+ * @brief Channel Operating Margin over a TX FFE / CTLE / DFE space
+ *
+ * Channels are given as frequency responses on get_frequencies() (for
+ * example ChannelSParamTdf::get_frequency_response()). The driver, symbol
+ * and channel are multiplied once per channel; each CTLE setting's response
+ * (CTLE x VGA) and its integrated noise are cached at construction. A CTLE
+ * case is then one product and one inverse FFT, and every FFE preset reuses
+ * that pulse in the sample domain. CTLE cases are spread over worker
+ * threads; each writes only its own row, so the result does not depend on
+ * the thread count.
+ *
+ * Per case, the pulse is sampled at its peak. DFE taps cancel post-cursors
+ * 1..num_taps within the DfeAdaptParams limits, the rest is interference.
+ * The residual ISI PDF is convolved with Gaussian noise of variance
+ *
+ *   eta0 * int_0^fb |H_rx|^2 df                       (RX)
+ * + 10^(-snr_tx/10) * sum h_k^2                       (TX)
+ * + (rj^2 + (dj/2)^2) * sum (UI * dh/dt at cursor k)^2   (jitter)
+ *
+ * and A_ni is the level below which the PDF holds target_der.
+ */
+class ComAnalyzer {
+public:
+    /**
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    ComAnalyzer(const ComParams& params, const TxParams& tx, const RxParams& rx,
+                const AdaptionParams& adaption, double ui, int samples_per_ui);
+
+    /**
+     * @brief Frequencies k * fs / N, k = 0..N/2, at which channels are sampled
+     */
+    const std::vector<double>& get_frequencies() const { return m_freqs; }
+
+    int get_num_ctle() const { return static_cast<int>(m_ctle.size()); }
+    int get_num_ffe() const { return static_cast<int>(m_ffe.size()); }
+    const ComCtleSetting& get_ctle(int index) const { return m_ctle[index]; }
+
+    /**
+     * @brief RX noise variance (V^2) of one CTLE setting: eta0 * int_0^fb |H_rx|^2 df
+     */
+    double get_rx_noise_var(int index) const { return m_rx_noise_var[index]; }
+
+    /**
+     * @brief Pulse response at the VGA output for one CTLE setting, without FFE
+     * @throws std::invalid_argument if the response does not match get_frequencies()
+     */
+    std::vector<double> pulse_response(const std::vector<std::complex<double>>& channel,
+                                       int ctle_index) const;
+
+    /**
+     * @brief Search the equalizer space for one channel
+     *
+     * An exception in a worker thread is rethrown here after all workers
+     * have joined (the first one wins).
+     * @throws std::invalid_argument if the response does not match get_frequencies()
+     *         or a case's pulse is not finite
+     */
+    ComResult evaluate(const std::vector<std::complex<double>>& channel) const;
+
+private:
+    std::vector<std::complex<double>> channel_product(
+        const std::vector<std::complex<double>>& channel) const;
+    std::vector<double> inverse(const std::vector<std::complex<double>>& product,
+                                int ctle_index) const;
+
+    ComParams m_params;
+    int m_spu;
+    size_t m_nfft;
+    int m_num_dfe;
+    double m_tap_min;
+    double m_tap_max;
+    double m_vtap;
+
+    std::vector<double> m_freqs;
+    std::vector<TxFfeParams> m_ffe;
+    std::vector<ComCtleSetting> m_ctle;
+    std::vector<std::complex<double>> m_tx_response;               // Symbol x driver
+    std::vector<std::vector<std::complex<double>>> m_rx_response;  // Per CTLE: CTLE x VGA
+    std::vector<double> m_rx_noise_var;                            // Per CTLE (V^2)
+};
+
+} // namespace serdes
+
+#endif // SERDES_COM_ANALYSIS_H
@@ -0,0 +1,98 @@
+#ifndef SERDES_CROSSTALK_AGGRESSOR_H
+#define SERDES_CROSSTALK_AGGRESSOR_H
+
+#include "common/parameters.h"
+#include "common/prbs.h"
+#include "common/checkpoint.h"
+#include <vector>
+
+namespace serdes {
+
+/**
+ * Crosstalk aggressor lane - symbol-rate superposition engine
+ *
+ * Models one aggressor as an independent PRBS symbol stream convolved with a
+ * precomputed NEXT/FEXT pulse response. The pulse response already holds the
+ * coupling path, so both types superpose the same way; the type is only
+ * validated. The pulse response is resampled once
+ * onto the channel timestep and stored as a polyphase table
+ * (samples_per_ui phases x span_ui taps), so each output sample costs span_ui
+ * multiply-adds instead of a full-rate convolution or a TX/channel model per
+ * aggressor:
+ *
+ *   y[n] = sum_k a[u - k] * p[k * samples_per_ui + phase],  u = n / spu
+ *
+ * Only the victim lane runs through the full TX/RX modules.
+ */
+class CrosstalkAggressor {
+public:
+    /**
+     * @param params Aggressor definition (pulse response, pattern, skew)
+     * @param ui Aggressor symbol period (s)
+     */
+    CrosstalkAggressor(const CrosstalkAggressorParams& params, double ui);
+
+    /**
+     * Build the polyphase pulse table for the given channel timestep
+     * @throws std::invalid_argument if the pulse response or timing is invalid
+     */
+    void initialize(double timestep);
+
+    /**
+     * Advance one channel timestep and return the coupled voltage
+     */
+    double process();
+
+    /**
+     * Restart the aggressor pattern and clear the symbol history
+     */
+    void reset();
+
+    int get_samples_per_ui() const { return m_samples_per_ui; }
+    int get_span_ui() const { return m_span_ui; }
+    double get_peak_coupling() const;
+
+    /**
+     * @brief Save / restore pattern position and symbol history under "<key>."
+     * @throws std::invalid_argument if the entry does not match the configuration
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+private:
+    double interpolate_pulse(double t, double src_dt) const;
+    void push_symbol(double a);
+
+    CrosstalkAggressorParams m_params;
+    double m_ui;
+
+    int m_samples_per_ui;
+    int m_span_ui;
+    int m_skew_samples;
+
+    // Polyphase taps: m_taps[phase * m_span_ui + k]
+    std::vector<double> m_taps;
+
+    // Symbol history, mirrored so that the newest-first window
+    // m_symbols[m_pos .. m_pos + m_span_ui) is always contiguous
+    std::vector<double> m_symbols;
+    int m_pos;
+
+    long long m_sample_index;   // Sample index relative to first aggressor symbol
+    int m_phase;                // Sample position within current UI
+    PrbsLfsr m_lfsr;
+};
+
+/**
+ * Share of the crosstalk voltage x added to channel output `index`
+ *
+ * Crosstalk is a differential disturbance on the victim. With two outputs
+ * they are the victim's P/N pair (SIMPLE differential mode, and the
+ * state-space channel as the link testbench wires it): +x/2 and -x/2.
+ * Otherwise output 0 is the victim's differential output and gets x.
+ */
+double crosstalk_output_share(int n_outputs, int index);
+
+} // namespace serdes
+
+#endif // SERDES_CROSSTALK_AGGRESSOR_H
@@ -0,0 +1,109 @@
+#ifndef SERDES_CTLE_COEFF_BANK_H
+#define SERDES_CTLE_COEFF_BANK_H
+
+#include <vector>
+#include <map>
+#include <tuple>
+#include <string>
+#include "common/checkpoint.h"
+
+namespace serdes {
+
+/**
+ * First-order discrete section: y = b0*x + b1*x[n-1] - a1*y[n-1]
+ */
+struct CtleSectionCoeffs {
+    double b0;
+    double b1;
+    double a1;
+};
+
+/**
+ * One discretized CTLE setting
+ *
+ * H(s) = dc_gain * prod(1 + s/wz_i) / prod(1 + s/wp_i), split into one
+ * first-order section per pole (bilinear transform). dc_gain is applied at
+ * the cascade output so that section states remain valid after a gain change.
+ */
+struct CtleCoeffSet {
+    double zero;
+    double pole;
+    double dc_gain;
+    std::vector<CtleSectionCoeffs> sections;
+};
+
+/**
+ * Cache of discretized CTLE coefficient sets indexed by setting
+ *
+ * The base zero/pole lists come from RxCtleParams; a setting replaces the
+ * first zero, the first pole and the DC gain (the knobs driven by AdaptionDe).
+ * Every setting shares the same section count, so a CtleSectionCascade can
+ * switch between sets without resetting its state.
+ */
+class CtleCoeffBank {
+public:
+    CtleCoeffBank();
+
+    /**
+     * Set base zeros/poles (Hz) and the discretization timestep
+     * @throws std::invalid_argument if there are more zeros than poles
+     */
+    void configure(const std::vector<double>& zeros,
+                   const std::vector<double>& poles,
+                   double timestep);
+
+    /**
+     * Return the index of a setting, discretizing and caching it on first use
+     */
+    int find_or_build(double zero, double pole, double dc_gain);
+
+    /**
+     * Return the cached setting closest to the request (log-frequency distance)
+     */
+    int find_nearest(double zero, double pole, double dc_gain) const;
+
+    const CtleCoeffSet& get(int index) const { return m_sets[index]; }
+    int size() const { return static_cast<int>(m_sets.size()); }
+    int get_num_sections() const { return m_num_sections; }
+
+private:
+    CtleCoeffSet discretize(double zero, double pole, double dc_gain) const;
+    CtleSectionCoeffs bilinear_section(double fz, double fp) const;
+
+    std::vector<double> m_zeros;
+    std::vector<double> m_poles;
+    double m_timestep;
+    int m_num_sections;
+
+    std::vector<CtleCoeffSet> m_sets;
+    std::map<std::tuple<double, double, double>, int> m_index;
+};
+
+/**
+ * Direct Form I section cascade whose state is coefficient-independent
+ *
+ * The stored states are the input/output samples of each section, which are
+ * physical signal values, so swapping to another CtleCoeffSet with the same
+ * section count continues smoothly instead of restarting from zero.
+ */
+class CtleSectionCascade {
+public:
+    void resize(int num_sections);
+    void reset();
+    double process(const CtleCoeffSet& set, double x);
+
+    /**
+     * @brief Save / restore the section delay states under "<key>."
+     * @throws std::invalid_argument if the entry does not match the configuration
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+private:
+    std::vector<double> m_x1;
+    std::vector<double> m_y1;
+};
+
+} // namespace serdes
+
+#endif // SERDES_CTLE_COEFF_BANK_H
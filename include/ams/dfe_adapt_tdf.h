@@ -2,8 +2,12 @@
 #define SERDES_DFE_ADAPT_TDF_H
 
 #include <systemc-ams>
+#include <string>
 #include <vector>
 #include "common/parameters.h"
+#include "common/checkpoint.h"
+#include "ams/dfe_feedback.h"
+#include "ams/dfe_tap_update.h"
 
 namespace serdes {
 
@@ -13,10 +17,15 @@ namespace serdes {
  * Implements the core DFE adaptation algorithm per the dual-threshold proposal:
  * - Receives three comparator outputs: d_k (main, thr=0), s_k (+Vref), s'_k (-Vref)
  * - Maintains decision history buffer at UI rate
- * - Executes Sign-Sign LMS tap update at UI rate: c[n] -= mu * sign_e * d[k-n]
+ * - Executes the tap update at UI rate, selected by DfeAdaptParams::algorithm:
+ *   "sign-lms" (default): c[n] -= mu * sign_e * d[k] * d[k-n]
+ *   "lms" / "nlms" / "rls": error magnitude from the main sampler value_in
+ *   "fixed": no update
  * - Accumulates statistics (N_A, N_B, N_C, N_D) every M UI
  * - Adapts Vref (optional, controlled by enable switch)
  * - Manages state machine: STARTUP -> ACQUIRE -> TRACK
+ * - Optionally emits a decimated wake-up tick (adapt_tick) for the
+ *   event-driven AdaptionDe scheduler
  *
  * Architecture role (Plan A):
  *   All per-UI signal processing lives in TDF domain.
@@ -36,6 +45,10 @@ public:
     // Sampling trigger (shared with main sampler, from CDR)
     sca_tdf::sca_in<bool> sampling_trigger;
 
+    // Main sampler analog value (v - threshold); present only for the
+    // error-magnitude algorithms ("lms", "nlms", "rls")
+    sc_core::sc_vector<sca_tdf::sca_in<double>> value_in;
+
     // ========================================================================
     // DE Input Ports (from AdaptionDe control)
     // ========================================================================
@@ -46,14 +59,9 @@ public:
     // ========================================================================
     // DE Output Ports (to DFE Summer)
     // ========================================================================
-    sca_tdf::sca_de::sca_out<double> tap1_de;       // DFE tap coefficients
-    sca_tdf::sca_de::sca_out<double> tap2_de;
-    sca_tdf::sca_de::sca_out<double> tap3_de;
-    sca_tdf::sca_de::sca_out<double> tap4_de;
-    sca_tdf::sca_de::sca_out<double> tap5_de;
-    sca_tdf::sca_de::sca_out<double> tap6_de;
-    sca_tdf::sca_de::sca_out<double> tap7_de;
-    sca_tdf::sca_de::sca_out<double> tap8_de;
+    // DFE tap coefficients, one port per tap (num_taps ports)
+    sc_core::sc_vector<sca_tdf::sca_de::sca_out<double>> tap_de;
+    sca_tdf::sca_de::sca_out<int> tap_seq_de;       // Incremented on every tap write
 
     // ========================================================================
     // DE Output Ports (statistics to AdaptionDe)
@@ -71,6 +79,10 @@ public:
     sca_tdf::sca_de::sca_out<int> stat_update_count;// Total tap update count
     sca_tdf::sca_de::sca_out<double> vref_current;  // Current Vref value (for feedback to AdaptionDe)
 
+    // Tick counter, incremented every tick_period_ui triggered UI outside
+    // freeze; present only when tick_period_ui > 0
+    sc_core::sc_vector<sca_tdf::sca_de::sca_out<int>> adapt_tick;
+
     // ========================================================================
     // Constructor
     // ========================================================================
@@ -81,10 +93,12 @@ public:
      * @param nm Module name
      * @param dfe_params DFE adaptation parameters
      * @param vref_params Vref adaptation parameters
+     * @param tick_period_ui UI between adapt_tick increments (0 = no tick port)
      */
     DfeAdaptTdf(sc_core::sc_module_name nm,
                 const AdaptionParams::DfeAdaptParams& dfe_params,
-                const AdaptionParams::VrefAdaptParams& vref_params);
+                const AdaptionParams::VrefAdaptParams& vref_params,
+                int tick_period_ui = 0);
 
     // ========================================================================
     // TDF Callbacks
@@ -93,14 +107,41 @@ public:
     void initialize();
     void processing();
 
+    /**
+     * @brief Bit mapping of the DFE summer the taps drive; the error
+     *        correction and the error-magnitude regressor use it.
+     *        Call before the simulation starts (default "pm1", 1.0).
+     * @param vtap RxDfeSummerParams::vtap
+     * @param map_mode RxDfeSummerParams::map_mode ("pm1" or "01")
+     */
+    void set_summer_mapping(double vtap, const std::string& map_mode);
+
     // ========================================================================
     // Public Accessors
     // ========================================================================
-    const double* get_taps() const { return m_taps; }
+    const std::vector<double>& get_taps() const { return m_taps; }
+    int get_num_taps() const { return m_num_taps; }
     int get_update_count() const { return m_update_count; }
     int get_state() const { return m_state; }
     double get_mu() const { return m_current_mu; }
 
+    // ========================================================================
+    // Checkpoint
+    // ========================================================================
+
+    /**
+     * @brief Store taps, history, updater, statistics and state machine
+     *        under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+
+    /**
+     * @brief Continue from a checkpoint (trained taps); applied at the next
+     *        initialize(). The tap sequence number restarts, so the summer
+     *        keeps its own restored taps until the next periodic write.
+     */
+    void restore_state(const StateCheckpoint& cp);
+
 private:
     // ========================================================================
     // Parameters
@@ -111,10 +152,11 @@ private:
     // ========================================================================
     // DFE State
     // ========================================================================
-    static const int MAX_TAPS = 8;
-    double m_taps[MAX_TAPS];             // DFE tap coefficients
-    double m_history[MAX_TAPS];          // Decision history: ±1 (UI rate)
-    int m_num_taps;                      // Active number of taps
+    int m_num_taps;                      // Number of taps
+    std::vector<double> m_taps;          // DFE tap coefficients
+    DfeBitHistory m_history;             // Packed decision history (UI rate)
+    std::vector<double> m_written_taps;  // Taps last written to the summer
+    DfeTapUpdater m_updater;             // Update rule (sign-lms/lms/nlms/rls/fixed)
 
     // ========================================================================
     // Statistics State
@@ -136,6 +178,10 @@ private:
     double m_current_mu;                 // Current step size
     double m_current_vref;               // Current Vref value (absolute, used for ±Vref)
     int m_update_count;                  // Total tap updates performed
+    int m_tap_seq;                       // Tap write sequence number
+    int m_tick_period_ui;                // UI per adapt_tick increment
+    int m_tick_ui;                       // UI counter within current tick period
+    int m_tick_count;                    // adapt_tick value
 
     // ========================================================================
     // Held values (sampled on trigger)
@@ -145,6 +191,8 @@ private:
     bool m_hold_s_pos;                   // Held +Vref comparator from last trigger
     bool m_hold_s_neg;                   // Held -Vref comparator from last trigger
 
+    StateCheckpoint m_restore;           // Pending restore, applied in initialize()
+
     // ========================================================================
     // Internal Methods
     // ========================================================================
@@ -160,14 +208,30 @@ private:
     double compute_sign_e(double d, double s_pos, double s_neg) const;
 
     /**
-     * @brief Shift history buffer and insert new decision
+     * @brief Apply m_restore (from initialize())
+     */
+    void apply_restore();
+
+    /**
+     * @brief Restore taps from initial_taps and clear the history
      */
-    void shift_history(double new_decision);
+    void reset_taps();
 
     /**
-     * @brief Execute Sign-Sign LMS tap update for one UI
+     * @brief Execute the tap update for one UI
+     * @param sign_e Comparator error sign (sign-lms)
+     * @param d Current decision (±1)
+     * @param error A-priori error magnitude (lms / nlms / rls)
      */
-    void update_taps(double sign_e);
+    void update_taps(double sign_e, double d, double error);
+
+    /**
+     * @brief A-priori error e = y - d * Vref for the current taps
+     * @param y Main sampler value (v - threshold), equalized by the summer
+     *          with the last written taps
+     * @param d Current decision (±1)
+     */
+    double compute_error(double y, double d) const;
 
     /**
      * @brief Accumulate one UI into statistics counters
@@ -203,11 +267,6 @@ private:
      * @brief Clamp value to range
      */
     double clamp(double val, double min_val, double max_val) const;
-
-    /**
-     * @brief Sign function (returns 0 for input 0)
-     */
-    static double sign_fn(double val);
 };
 
 } // namespace serdes
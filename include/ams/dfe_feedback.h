@@ -0,0 +1,163 @@
+#ifndef SERDES_DFE_FEEDBACK_H
+#define SERDES_DFE_FEEDBACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "common/checkpoint.h"
+
+namespace serdes {
+
+/**
+ * @brief Packed decision history for an N-tap DFE
+ *
+ * Decisions are stored one bit each in 64-bit words; bit k holds the
+ * decision k+1 symbols back (bit 0 = most recent). A push is a word-wide
+ * shift instead of an element-by-element move, so 24 taps cost one shift.
+ * filled() counts the decisions received since clear(), so callers can tell
+ * real history from the zero-initialized tail.
+ */
+class DfeBitHistory {
+public:
+    DfeBitHistory();
+
+    /**
+     * @brief Set history depth (number of taps) and clear it
+     */
+    void resize(std::size_t depth);
+    void clear();
+
+    /**
+     * @brief Insert the newest decision
+     * @return true if the stored history changed (false while the same
+     *         decision keeps repeating through a full history)
+     */
+    bool push(bool bit) {
+        if (m_words.empty()) {
+            return false;
+        }
+        std::uint64_t diff = 0;
+        for (std::size_t i = m_words.size() - 1; i > 0; --i) {
+            std::uint64_t w = (m_words[i] << 1) | (m_words[i - 1] >> 63);
+            if (i == m_words.size() - 1) {
+                w &= m_top_mask;
+            }
+            diff |= w ^ m_words[i];
+            m_words[i] = w;
+        }
+        std::uint64_t w0 = (m_words[0] << 1) | (bit ? 1u : 0u);
+        if (m_words.size() == 1) {
+            w0 &= m_top_mask;
+        }
+        diff |= w0 ^ m_words[0];
+        m_words[0] = w0;
+        if (m_filled < m_depth) {
+            ++m_filled;
+        }
+        return diff != 0;
+    }
+
+    bool bit(std::size_t k) const { return (m_words[k >> 6] >> (k & 63)) & 1u; }
+    std::uint64_t word(std::size_t i) const { return m_words[i]; }
+    std::size_t num_words() const { return m_words.size(); }
+    std::size_t size() const { return m_depth; }
+    std::size_t filled() const { return m_filled; }
+
+    /**
+     * @brief Save / restore the packed bits and fill count under "<key>."
+     * @throws std::invalid_argument if the entry does not match the configuration
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+private:
+    std::vector<std::uint64_t> m_words;
+    std::uint64_t m_top_mask;     // Valid bits of the last word
+    std::size_t m_depth;
+    std::size_t m_filled;
+};
+
+/**
+ * @brief DFE feedback as a packed-bit dot product
+ *
+ * For each tap the two possible contributions (bit 0 / bit 1, already
+ * scaled by vtap and mapped through pm1 or 01) are precomputed, so the
+ * feedback is a branch-free select-and-accumulate over the history words:
+ *
+ *   v_fb = sum_k select[k][bit_k]
+ *
+ * pm1 maps a bit to -c/+c, 01 maps it to 0/+c.
+ *
+ * Floating taps cancel isolated reflections beyond the fixed taps: each one
+ * weights the decision at its own position (UIs back), and the history is
+ * deepened to the furthest position. Only the bits they select are read,
+ * so a reflection 40 UIs out costs one extra select, not 40 taps.
+ */
+class DfeFeedbackKernel {
+public:
+    DfeFeedbackKernel();
+
+    /**
+     * @param taps Tap coefficients, taps[0] weights the most recent decision
+     * @param pm1 true for ±1 bit mapping, false for 0/1
+     * @param vtap Bit mapping voltage scale
+     */
+    void configure(const std::vector<double>& taps, bool pm1, double vtap);
+
+    /**
+     * @brief Set the floating taps (after configure(); clears the history)
+     * @param positions Decision delay of each tap in UIs, > size()
+     * @param coeffs Coefficient of each tap
+     * @throws std::invalid_argument if the sizes differ or a position is
+     *         not beyond the fixed taps
+     */
+    void configure_floating(const std::vector<int>& positions, const std::vector<double>& coeffs);
+
+    /**
+     * @brief Update one tap coefficient
+     * @return true if the value changed
+     */
+    bool set_tap(std::size_t k, double value);
+
+    /**
+     * @brief Insert the newest decision
+     * @return true if feedback() may have changed
+     */
+    bool push(bool bit) { return m_history.push(bit); }
+    void clear_history() { m_history.clear(); }
+
+    /**
+     * @brief Feedback voltage for the current history
+     */
+    double feedback() const;
+
+    const std::vector<double>& taps() const { return m_taps; }
+    const DfeBitHistory& history() const { return m_history; }
+    std::size_t size() const { return m_taps.size(); }
+    const std::vector<int>& floating_positions() const { return m_float_pos; }
+    const std::vector<double>& floating_taps() const { return m_float_taps; }
+
+    /**
+     * @brief Save / restore taps and decision history under "<key>."
+     * @throws std::invalid_argument if the entry does not match the configuration
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+private:
+    void fill_select(std::size_t k);
+
+    std::vector<double> m_taps;
+    std::vector<double> m_select;   // [2k] = bit 0 contribution, [2k+1] = bit 1
+    std::vector<int> m_float_pos;
+    std::vector<double> m_float_taps;
+    std::vector<double> m_float_select;   // As m_select, per floating tap
+    bool m_pm1;
+    double m_vtap;
+    DfeBitHistory m_history;
+};
+
+} // namespace serdes
+
+#endif // SERDES_DFE_FEEDBACK_H
@@ -0,0 +1,118 @@
+#ifndef SERDES_DFE_TAP_UPDATE_H
+#define SERDES_DFE_TAP_UPDATE_H
+
+#include <string>
+#include <vector>
+#include "common/types.h"
+#include "ams/dfe_feedback.h"
+
+namespace serdes {
+
+/**
+ * @brief Parse "sign-lms" / "lms" / "nlms" / "rls" / "fixed"
+ *
+ * Case-insensitive, '_' and ' ' read as '-'; the legacy sign-sign spellings
+ * "sign-sign", "sign-sign-lms", "ss-lms" and "sslms" select SIGN_LMS.
+ * Unknown names are reported on std::cerr and fall back to SIGN_LMS, the
+ * algorithm used before the rule became selectable.
+ */
+DFEUpdateAlgorithm parse_dfe_update_algorithm(const std::string& name);
+
+/**
+ * @brief Whether the rule needs the error magnitude (analog sample value)
+ */
+bool dfe_update_needs_error_magnitude(DFEUpdateAlgorithm algorithm);
+
+/**
+ * @brief Per-UI DFE tap update rules for DfeAdaptTdf
+ *
+ * The regressor is the decision history b[k-n-1] mapped as the DFE summer
+ * maps it, u[n] = vtap * (pm1 ? +-1 : 0/1) (0 for history not received
+ * yet), so u[n] is the derivative of the summer feedback by tap n; e =
+ * y - d[k] * Vref is the a-priori error of the equalized sample y. All
+ * rules descend E[e^2]:
+ *
+ * - SIGN_LMS: c[n] += mu * sign(e) * d[k-n-1], d in {-1, +1}; sign(e)
+ *             comes from the dual-threshold comparators, so no analog
+ *             sample is needed
+ * - LMS:      c[n] += mu * e * u[n]
+ * - NLMS:     c[n] += mu * e * u[n] / (eps + |u|^2)
+ * - RLS:      k = P u / (lambda + u' P u); c += k e; P = (P - k u' P) / lambda
+ *             The inverse correlation matrix P is kept between updates
+ *             (O(N^2) per UI, no matrix inversion); it is updated symmetrically
+ *             and re-initialized if it loses positive definiteness.
+ * - FIXED:    no update
+ */
+class DfeTapUpdater {
+public:
+    DfeTapUpdater();
+
+    /**
+     * @param algorithm Update rule
+     * @param num_taps Number of taps
+     * @param rls_lambda RLS forgetting factor (0, 1]
+     * @param rls_delta RLS initial P = delta * I (> 0)
+     * @param nlms_eps NLMS regularization (>= 0)
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    void configure(DFEUpdateAlgorithm algorithm, int num_taps,
+                   double rls_lambda, double rls_delta, double nlms_eps);
+
+    /**
+     * @brief Restore P = delta * I
+     */
+    void reset();
+
+    /**
+     * @brief Bit mapping of the DFE summer the taps are written to
+     *        (RxDfeSummerParams::map_mode == "pm1", vtap); default +-1, 1.0
+     */
+    void set_bit_mapping(bool pm1, double vtap);
+
+    /**
+     * @brief Summer feedback per unit tap for a history bit (error-magnitude rules)
+     */
+    double regressor(bool bit) const {
+        return bit ? m_vtap : (m_pm1 ? -m_vtap : 0.0);
+    }
+
+    bool needs_error_magnitude() const { return dfe_update_needs_error_magnitude(m_algorithm); }
+
+    /**
+     * @brief Apply one update to `taps`
+     * @param taps Tap coefficients (size num_taps), updated in place
+     * @param history Decision history providing the regressor
+     * @param mu Step size (SIGN_LMS, LMS, NLMS)
+     * @param sign_err sign(e) in {-1, 0, +1} (SIGN_LMS)
+     * @param error A-priori error e (LMS, NLMS, RLS)
+     * @return false when nothing was updated
+     */
+    bool update(std::vector<double>& taps, const DfeBitHistory& history,
+                double mu, double sign_err, double error);
+
+    DFEUpdateAlgorithm get_algorithm() const { return m_algorithm; }
+    const std::vector<double>& get_inverse_correlation() const { return m_P; }
+
+    /**
+     * @brief Save / restore the RLS inverse correlation under "<key>."
+     * @throws std::invalid_argument if the entry does not match the configuration
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+private:
+    DFEUpdateAlgorithm m_algorithm;
+    int m_num_taps;
+    double m_lambda;
+    double m_delta;
+    double m_eps;
+    bool m_pm1;
+    double m_vtap;
+    std::vector<double> m_u;      // Regressor
+    std::vector<double> m_P;      // Inverse correlation, row-major N x N
+    std::vector<double> m_Pu;     // P * u
+};
+
+} // namespace serdes
+
+#endif // SERDES_DFE_TAP_UPDATE_H
@@ -0,0 +1,119 @@
+#ifndef SERDES_EQ_OPTIMIZER_H
+#define SERDES_EQ_OPTIMIZER_H
+
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "common/parameters.h"
+#include "ams/com_analysis.h"
+
+namespace serdes {
+
+/**
+ * @brief One equalizer configuration and its pulse-response score
+ */
+struct EqCandidate {
+    double score;                     // Eye height (V) or slicer SNR (dB), per EqOptParams::metric
+    double eye_height;                // Worst-case eye height minus the noise margin (V)
+    double snr_db;                    // Main cursor^2 / (residual ISI^2 + noise^2)
+    double phase;                     // Sampling phase relative to the unequalized pulse peak (UI)
+    std::vector<double> ffe_taps;     // UI-spaced, sum |f| = 1
+    ComCtleSetting ctle;
+    double vga_gain;
+    std::vector<double> dfe_taps;     // Volts / vtap, clamped to [tap_min, tap_max]
+};
+
+struct EqOptResult {
+    std::vector<EqCandidate> best;    // Best first, at most top_k
+    std::uint64_t num_candidates;     // FFE x CTLE x VGA configurations in the space
+    std::uint64_t num_pruned;         // Configurations rejected by the bound
+};
+
+/**
+ * @brief Joint TX FFE / CTLE / VGA / DFE search on the linear pulse response
+ *
+ * Each CTLE setting's pulse comes from ComAnalyzer (one inverse FFT), is
+ * sampled into UI-spaced cursor tables for the phases around its peak, and
+ * is then shared by every FFE and VGA candidate: the FFE is a short
+ * convolution of those cursors, the VGA a scale factor. The DFE cancels
+ * post-cursors 1..num_taps within its tap limits (volts, so the VGA gain
+ * matters), everything else is residual ISI. With noise
+ * sigma^2 = vga^2 * sigma_rx^2 + slicer_sigma^2:
+ *
+ *   eye = vga * (h0 - sum |isi|) - dfe excess - Q(target_ber) * sigma
+ *   snr = (vga * h0)^2 / (vga^2 * sum isi^2 + dfe excess^2 + sigma^2)
+ *
+ * Branch-and-bound pruning: the ISI-free bound of a candidate, and the
+ * running bound while its ISI is summed, are compared with the worker's
+ * current K-th best, so most of the space is rejected after a few cursors.
+ * FFE grid slices are spread over worker threads with private top-K lists
+ * that are merged at the end (ties broken by enumeration order), so the
+ * result does not depend on the thread count.
+ */
+class EqOptimizer {
+public:
+    /**
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    EqOptimizer(const EqOptParams& params, const TxParams& tx, const RxParams& rx,
+                const AdaptionParams& adaption, double ui, int samples_per_ui);
+
+    /**
+     * @brief Frequencies at which the channel response must be sampled
+     */
+    const std::vector<double>& get_frequencies() const { return m_analyzer.get_frequencies(); }
+
+    std::uint64_t get_num_candidates() const;
+
+    /**
+     * @throws std::invalid_argument if the response does not match get_frequencies()
+     */
+    EqOptResult optimize(const std::vector<std::complex<double>>& channel) const;
+
+private:
+    EqOptParams m_params;
+    int m_spu;
+    int m_num_dfe;
+    double m_vtap;
+    double m_dfe_lo;                  // tap_min * vtap (V)
+    double m_dfe_hi;                  // tap_max * vtap (V)
+    double m_q;                       // Q(target_ber)
+    std::vector<double> m_vga;
+    std::vector<std::vector<double>> m_ffe_grid;   // Non-main tap combinations
+    ComAnalyzer m_analyzer;
+};
+
+/**
+ * @brief Write a candidate into the link parameters
+ *
+ * TxFfeParams::taps (UI-spaced via tap_spacing), the first CTLE zero/pole
+ * and the DC gain, the VGA DC gain, and the DFE taps into both
+ * RxDfeSummerParams::tap_coeffs and DfeAdaptParams::initial_taps.
+ * The DFE taps are UI-spaced post-cursors 1..num_taps, as the summer's
+ * once-per-UI decision history expects, so they are written unchanged.
+ * The sampling phase is not a link parameter: the CDR has to lock at
+ * EqCandidate::phase for the predicted eye.
+ */
+void apply_eq_candidate(const EqCandidate& c, int samples_per_ui,
+                        TxParams& tx, RxParams& rx, AdaptionParams& adaption);
+
+/**
+ * @brief Save a candidate as a JSON config fragment
+ *
+ * tx.ffe_taps, rx.vga.gain and rx.dfe.taps use the config/default.json
+ * keys; rx.ctle holds the replaced first zero/pole and the DC gain.
+ * @return false if the file cannot be written
+ */
+bool save_eq_candidate(const std::string& path, const EqCandidate& c, int rank,
+                       const std::string& metric);
+
+/**
+ * @brief Read a fragment written by save_eq_candidate()
+ * @throws std::invalid_argument / std::runtime_error for a missing or malformed file
+ */
+EqCandidate load_eq_candidate(const std::string& path);
+
+} // namespace serdes
+
+#endif // SERDES_EQ_OPTIMIZER_H
@@ -0,0 +1,164 @@
+#ifndef SERDES_EQ_SEED_H
+#define SERDES_EQ_SEED_H
+
+#include <string>
+#include <vector>
+#include "common/parameters.h"
+#include "ams/ctle_coeff_bank.h"
+
+namespace serdes {
+
+/**
+ * @brief Linear link cascade for pre-simulation pulse-response extraction
+ *
+ * Each stage is a CtleCoeffSet stepped by a CtleSectionCascade at the link
+ * timestep: zero/pole stages use the same bilinear sections as the adaptive
+ * CTLE, the simple channel uses ChannelSParamTdf's one-pole IIR. Saturation,
+ * offset and noise are ignored, so the result is the small-signal pulse the
+ * equalizers see around the operating point.
+ */
+class PulseResponseCascade {
+public:
+    /**
+     * @throws std::invalid_argument if timestep <= 0
+     */
+    explicit PulseResponseCascade(double timestep);
+
+    /**
+     * @brief Append H(s) = dc_gain * prod(1 + s/wz_i) / prod(1 + s/wp_j)
+     * @throws std::invalid_argument if there are more zeros than poles
+     */
+    void add_zero_pole(const std::vector<double>& zeros,
+                       const std::vector<double>& poles, double dc_gain);
+
+    /**
+     * @brief Append the SIMPLE channel model (attenuation + one-pole IIR)
+     */
+    void add_simple_channel(double attenuation_db, double bandwidth_hz);
+
+    /**
+     * @brief Response to a single symbol of `amplitude` held for one UI
+     * @return num_ui * samples_per_ui samples, symbol starting at sample 0
+     */
+    std::vector<double> pulse(int samples_per_ui, int num_ui, double amplitude) const;
+
+    int get_num_stages() const { return static_cast<int>(m_stages.size()); }
+
+private:
+    double m_timestep;
+    std::vector<CtleCoeffSet> m_stages;
+};
+
+/**
+ * @brief UI-spaced cursors of a sampled pulse response
+ *
+ * h[num_pre] is the main cursor, h[num_pre - k] the k-th pre-cursor and
+ * h[num_pre + k] the k-th post-cursor. The sampling phase is the peak of the
+ * pulse, which is where a centered CDR settles for a single dominant cursor.
+ */
+struct PulseCursors {
+    std::vector<double> h;
+    int num_pre;
+    int main_sample;              // Sample index of the main cursor in the pulse
+};
+
+/**
+ * @throws std::invalid_argument for an empty pulse or samples_per_ui < 1
+ */
+PulseCursors extract_cursors(const std::vector<double>& pulse, int samples_per_ui,
+                             int num_pre, int num_post);
+
+enum class EqSeedCriterion {
+    ZERO_FORCING,
+    MMSE
+};
+
+/**
+ * @brief Parse "zf" / "mmse"
+ * @throws std::invalid_argument for unknown names
+ */
+EqSeedCriterion parse_eq_seed_criterion(const std::string& name);
+
+struct EqSeedResult {
+    std::vector<double> ffe_taps;     // UI-spaced TX FFE taps, sum |f| = 1
+    std::vector<double> dfe_taps;     // DFE taps in volts / vtap, taps[0] = first post-cursor
+    std::vector<double> combined;     // Equalized cursors g = f * h
+    int main_index;                   // Index of the main cursor in `combined`
+    double main_cursor;               // Main cursor after the FFE (V)
+    double residual_isi;              // Sum |cursor| not removed by the DFE (V)
+};
+
+/**
+ * @brief Solve FFE and DFE coefficients from UI-spaced cursors
+ *
+ * The FFE f (num_ffe taps, main tap ffe_main) shapes g = f * h; the DFE
+ * cancels post-cursors 1..num_dfe of g exactly, so the FFE only has to
+ * force the remaining cursors to zero. Both criteria solve
+ *
+ *   (H' W H + lambda I) f = H' W delta
+ *
+ * with W selecting the cursors outside the DFE span and delta the unit main
+ * cursor: ZERO_FORCING uses lambda = 0 (a tiny ridge keeps the system
+ * regular), MMSE uses lambda = noise_sigma^2, the Wiener solution for white
+ * noise of that variance, which trades residual ISI against tap energy. The FFE is then scaled to sum |f| = 1 (the TX
+ * peak-swing constraint) and the DFE taps are the resulting post-cursors
+ * divided by vtap. num_ffe <= 1 leaves the channel unshaped (f = {1}).
+ *
+ * @throws std::invalid_argument for inconsistent sizes
+ */
+EqSeedResult compute_eq_seed(const PulseCursors& cursors, int num_ffe, int ffe_main,
+                             int num_dfe, double vtap, EqSeedCriterion criterion,
+                             double noise_sigma);
+
+/**
+ * @brief Differential driver output for a +1 symbol
+ *
+ * The symbol enters as 2 V differential (single-to-diff) and is scaled by
+ * dc_gain, then limited like TxDriverTdf's soft/hard saturation.
+ */
+double driver_symbol_level(const TxDriverParams& driver);
+
+/**
+ * @brief Pulse response of the TX driver, SIMPLE channel, CTLE and VGA
+ *
+ * A +1 symbol enters the driver as 2 V differential (single-to-diff) and is
+ * scaled to the driver's saturated level; the FFE is not included, it is
+ * applied in the cursor domain by compute_eq_seed(). The channel is the
+ * SIMPLE model (attenuation_db, bandwidth_hz); state-space channels are
+ * not covered.
+ */
+std::vector<double> link_pulse_response(const TxParams& tx, const ChannelParams& channel,
+                                        const RxParams& rx, double timestep,
+                                        int samples_per_ui, int num_ui);
+
+/**
+ * @brief Shape a sampled pulse with the TX FFE at its tap spacing (samples)
+ */
+std::vector<double> apply_ffe_to_pulse(const std::vector<double>& pulse, const TxFfeParams& ffe);
+
+/**
+ * @brief Extract the pulse response and solve the seed for the link
+ *
+ * The DFE span is adaption.dfe.num_taps; seed.ffe_taps = 0 keeps the
+ * configured TX FFE and solves the DFE against it.
+ */
+EqSeedResult compute_link_eq_seed(const EqSeedParams& seed, const TxParams& tx,
+                                  const ChannelParams& channel, const RxParams& rx,
+                                  const AdaptionParams& adaption,
+                                  double timestep, int samples_per_ui);
+
+/**
+ * @brief Write a seed into the link parameters
+ *
+ * Sets TxFfeParams::taps (UI-spaced via tap_spacing) when the FFE was
+ * solved, and the DFE taps, clamped to [tap_min, tap_max], into both
+ * RxDfeSummerParams::tap_coeffs and DfeAdaptParams::initial_taps. The DFE
+ * taps are UI-spaced post-cursors, matching the summer's once-per-UI
+ * decision history.
+ */
+void apply_eq_seed(const EqSeedResult& result, bool ffe_solved, int samples_per_ui,
+                   TxParams& tx, RxParams& rx, AdaptionParams& adaption);
+
+} // namespace serdes
+
+#endif // SERDES_EQ_SEED_H
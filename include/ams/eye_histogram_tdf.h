@@ -0,0 +1,106 @@
+#ifndef SERDES_EYE_HISTOGRAM_TDF_H
+#define SERDES_EYE_HISTOGRAM_TDF_H
+
+#include <systemc-ams>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "common/parameters.h"
+#include "ams/bathtub.h"
+#include "ams/prbs_sync_checker.h"
+
+namespace serdes {
+
+/**
+ * @brief In-sim per-phase amplitude histograms of the sampler input
+ *
+ * Accumulates in_p - in_n into an EyeHistogram with one phase per sample
+ * in the UI, without recording the waveform. Each one-UI window runs from
+ * center - spu/2 to center + spu/2 - 1 and is binned under one level.
+ *
+ * reference = "prbs" (default):
+ * - The window center is the sample of each CDR sampling trigger, so the
+ *   grid follows the recovered clock.
+ * - The recovered decisions (data_in, decision_latency samples after the
+ *   trigger) feed a self-synchronizing PRBS checker; the window is binned
+ *   under the checker's expected bit. A transmitted 1 sampled below the
+ *   threshold stays in the 1 histogram, so the inner tails (the errors
+ *   the bathtub extrapolates to) are kept.
+ * - Windows count only while the checker is locked, after warmup_ui
+ *   triggers (adaption transient).
+ *
+ * reference = "center" (no trigger or data ports):
+ * - Warm-up: for warmup_ui UIs the mean |v| of every sample slot of a
+ *   free-running grid is accumulated; the largest one is the eye center.
+ * - Then each window is binned under the level decided at its center
+ *   sample (v > threshold). This truncates the inner tails, so the
+ *   bathtub it gives is optimistic.
+ *
+ * compute() fits the tails and returns the bathtubs and contours, see
+ * compute_bathtub().
+ */
+class EyeHistogramTdf : public sca_tdf::sca_module {
+public:
+    // Sampler input (differential)
+    sca_tdf::sca_in<double> in_p;
+    sca_tdf::sca_in<double> in_n;
+
+    // CDR sampling trigger and recovered data (> 0.5 = bit 1); "prbs" only
+    sc_core::sc_vector<sca_tdf::sca_in<bool>> sampling_trigger;
+    sc_core::sc_vector<sca_tdf::sca_in<double>> data_in;
+
+    /**
+     * @brief Constructor
+     * @param nm Module name
+     * @param params Histogram / extrapolation parameters
+     * @param checker PRBS type and lock settings of the reference ("prbs")
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    EyeHistogramTdf(sc_core::sc_module_name nm, const BathtubParams& params,
+                    const PrbsCheckerParams& checker = PrbsCheckerParams());
+
+    void set_attributes() override;
+    void initialize() override;
+    void processing() override;
+
+    /**
+     * @throws std::invalid_argument if nothing was accumulated yet
+     */
+    BathtubResult compute() const;
+
+    // Debug interface
+    const EyeHistogram& get_histogram() const { return m_hist; }
+    bool is_aligned() const { return m_aligned; }
+    int get_center_slot() const { return m_center; }
+    std::uint64_t get_num_ui() const { return m_num_ui; }
+    std::uint64_t get_num_decision_errors() const { return m_num_errors; }   ///< "prbs": decision != reference
+
+private:
+    void accumulate_center(double v);
+    void accumulate_reference(double v);
+
+    BathtubParams m_params;
+    bool m_use_reference;
+    EyeHistogram m_hist;
+    int m_samples_per_ui;
+    int m_slot;                       // Sample slot within the free-running UI grid
+    int m_warmup_left;                // UIs left in the warm-up
+    bool m_aligned;
+    int m_center;                     // Slot of the eye center ("center")
+    int m_fill;                       // Samples in the current window
+    std::vector<double> m_abs_sum;    // Warm-up: sum |v| per slot
+    std::vector<double> m_window;
+    std::uint64_t m_num_ui;
+
+    // "prbs": recent samples, and the age (samples) of each pending trigger
+    PrbsSyncChecker m_reference;
+    std::vector<double> m_ring;
+    int m_ring_pos;                   // Slot of the next sample
+    int m_hold;                       // Age at which a window and its decision are complete
+    std::deque<int> m_pending;
+    std::uint64_t m_num_errors;
+};
+
+} // namespace serdes
+
+#endif // SERDES_EYE_HISTOGRAM_TDF_H
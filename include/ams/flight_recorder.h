@@ -0,0 +1,96 @@
+#ifndef SERDES_FLIGHT_RECORDER_H
+#define SERDES_FLIGHT_RECORDER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "common/parameters.h"
+
+namespace serdes {
+
+/**
+ * @throws std::invalid_argument for out-of-range FlightRecorderParams
+ */
+void validate_flight_recorder_params(const FlightRecorderParams& params);
+
+/**
+ * @brief Fixed-size multi-channel ring buffer with triggered capture
+ *
+ * Storage for pre_samples + 1 + post_samples samples is allocated once; a
+ * run of any length only overwrites it. A trigger refers to the last pushed
+ * sample and opens a capture: once post_samples more samples are pushed the
+ * buffer holds the window [trigger - pre, trigger + post] and push() returns
+ * true so the owner can write it out. Triggers while a capture is open, or
+ * after max_captures, are only counted.
+ *
+ * A channel with a bound triggers when |value| first exceeds it; it re-arms
+ * once the value is back within the bound.
+ */
+class FlightRecorder {
+public:
+    /**
+     * @throws std::invalid_argument for no channels, pre_samples < 0,
+     *         post_samples < 1 or max_captures < 0
+     */
+    FlightRecorder(const std::vector<std::string>& channels, int pre_samples, int post_samples,
+                   int max_captures);
+
+    /**
+     * @param bound Trigger level on |value| (0 = none)
+     * @throws std::out_of_range for a bad channel index
+     */
+    void set_bound(size_t channel, double bound);
+
+    /**
+     * @param values One value per channel
+     * @return true when an open capture has just been completed
+     */
+    bool push(double time, const double* values);
+
+    /**
+     * @return true if a capture was opened
+     */
+    bool trigger(const std::string& reason);
+
+    /**
+     * @brief Write the buffer, oldest sample first, as CSV (time_s, channels)
+     *
+     * After push() returned true this is exactly the capture window; for an
+     * open capture (end of run) the post window is cut short.
+     */
+    void write_capture(std::ostream& os) const;
+
+    bool is_capturing() const { return m_capturing; }
+    int get_num_captures() const { return m_num_captures; }
+    std::uint64_t get_num_triggers() const { return m_num_triggers; }
+    const std::string& get_reason() const { return m_reason; }
+    double get_trigger_time() const { return m_trigger_time; }
+    size_t get_capacity() const { return m_capacity; }
+    size_t get_size() const { return m_size; }
+    const std::vector<std::string>& get_channels() const { return m_channels; }
+
+private:
+    std::vector<std::string> m_channels;
+    size_t m_num_channels;
+    size_t m_capacity;
+    int m_post_samples;
+    int m_max_captures;
+    std::vector<double> m_time;       // capacity
+    std::vector<double> m_data;       // capacity x channels
+    size_t m_head;                    // Next slot to write
+    size_t m_size;
+    std::vector<double> m_bounds;
+    std::vector<char> m_over;         // Channel is outside its bound
+
+    bool m_capturing;
+    int m_post_left;
+    int m_num_captures;
+    std::uint64_t m_num_triggers;
+    std::string m_reason;
+    double m_trigger_time;
+};
+
+} // namespace serdes
+
+#endif // SERDES_FLIGHT_RECORDER_H
@@ -0,0 +1,82 @@
+#ifndef SERDES_FLIGHT_RECORDER_TDF_H
+#define SERDES_FLIGHT_RECORDER_TDF_H
+
+#include <systemc-ams>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "common/parameters.h"
+#include "ams/flight_recorder.h"
+
+namespace serdes {
+
+/**
+ * @brief In-sim flight recorder: the last pre_ui UIs of the inputs, dumped
+ *        around rare events
+ *
+ * Every decimation-th sample of the inputs goes into a FlightRecorder sized
+ * in initialize() for pre_ui + post_ui UIs, so memory does not grow with the
+ * run. Triggers:
+ * - error_count rises (checker error), if trigger_on_error
+ * - freeze rises (adaption freeze / rollback), if trigger_on_freeze
+ * - an input given a bound with set_bound() leaves it
+ *
+ * post_ui UIs after a trigger the window is written to
+ * <prefix>_flight<N>.csv and a line is added to <prefix>_flight.csv
+ * (capture, trigger time, reason, file). At most max_captures files are
+ * written; flush() writes an open capture at the end of the run.
+ */
+class FlightRecorderTdf : public sca_tdf::sca_module {
+public:
+    sc_core::sc_vector<sca_tdf::sca_in<double>> in;
+    sca_tdf::sca_de::sca_in<double> error_count;   // Checker error count
+    sca_tdf::sca_de::sca_in<bool> freeze;          // Adaption freeze flag
+
+    /**
+     * @brief Constructor
+     * @param nm Module name
+     * @param params Window / trigger parameters
+     * @param channels Input names (CSV columns), one input port each
+     * @param prefix Output file prefix
+     * @throws std::invalid_argument for out-of-range parameters or no channels
+     */
+    FlightRecorderTdf(sc_core::sc_module_name nm, const FlightRecorderParams& params,
+                      const std::vector<std::string>& channels, const std::string& prefix);
+
+    /**
+     * @brief Trigger when |in[channel]| exceeds bound; call before the simulation
+     */
+    void set_bound(size_t channel, double bound);
+
+    void set_attributes() override;
+    void initialize() override;
+    void processing() override;
+
+    /**
+     * @brief Write an open capture with its post window cut short
+     */
+    void flush();
+
+    int get_num_captures() const { return m_recorder.get_num_captures(); }
+    std::uint64_t get_num_triggers() const { return m_recorder.get_num_triggers(); }
+    size_t get_capacity() const { return m_recorder.get_capacity(); }
+
+private:
+    void dump();
+
+    FlightRecorderParams m_params;
+    std::vector<std::string> m_channels;
+    std::string m_prefix;
+    FlightRecorder m_recorder;
+    std::vector<double> m_bounds;
+    std::vector<double> m_values;
+    int m_phase;                      // Sample count modulo decimation
+    double m_last_errors;
+    bool m_last_freeze;
+    std::ofstream m_index;
+};
+
+} // namespace serdes
+
+#endif // SERDES_FLIGHT_RECORDER_TDF_H
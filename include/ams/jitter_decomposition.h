@@ -0,0 +1,123 @@
+#ifndef SERDES_JITTER_DECOMPOSITION_H
+#define SERDES_JITTER_DECOMPOSITION_H
+
+#include <cstdint>
+#include <vector>
+#include "common/parameters.h"
+
+namespace serdes {
+
+struct PjTone {
+    double frequency;                 // Hz
+    double amplitude_pp;              // s
+};
+
+/**
+ * @brief TJ/RJ/DJ decomposition of a TIE stream
+ *
+ * All times in seconds. dj_pp = ddj_pp + pj_pp and tj = dj_pp +
+ * 2 Q^-1(target_ber) rj_rms, the convention of eye_analyzer/jitter.py.
+ */
+struct JitterReport {
+    std::uint64_t num_edges;
+    double mean;                      // Static offset from the reference grid
+    double tie_rms;                   // About the mean
+    double tie_pp;                    // Observed peak-to-peak
+    int num_patterns;                 // Patterns with at least min_pattern_count edges
+    double ddj_pp;                    // Spread of the per-pattern means
+    double dcd;                       // Rising minus falling mean
+    double residual_rms;              // About the per-pattern means (RJ + PJ)
+    std::vector<PjTone> pj_tones;     // Strongest first
+    double pj_pp;                     // Sum of the tone amplitudes
+    double rj_rms;                    // Residual with the tone power removed
+    double dj_pp;
+    double tj;
+    double target_ber;
+    int psd_segments;
+    std::vector<double> psd_freq;     // Hz
+    std::vector<double> psd;          // One-sided residual PSD (s^2/Hz)
+};
+
+/**
+ * @throws std::invalid_argument for out-of-range JitterMonitorParams
+ */
+void validate_jitter_monitor_params(const JitterMonitorParams& params);
+
+/**
+ * @brief Streaming jitter decomposition with bounded memory
+ *
+ * Each edge's TIE is folded into running statistics; nothing is stored per
+ * edge:
+ * - Pattern-aligned averaging: one Welford mean / variance per pattern of
+ *   pattern_bits bits ending at the edge. The spread of the means is DDJ,
+ *   rising versus falling is DCD, and the pooled within-pattern variance is
+ *   the residual (RJ + PJ).
+ * - Running spectrum: the residual (TIE minus the current mean of its
+ *   pattern) is held between edges, averaged over psd_decimation UIs and
+ *   fed to a Welch estimate (Hann, 50 % overlap, psd_length points). PJ
+ *   tones are the PSD peaks above pj_threshold times the median floor;
+ *   their power is removed from the residual variance to give RJ.
+ *
+ * A stream without patterns (e.g. the recovered-clock phase, pattern 0 for
+ * every UI) gives DDJ = 0 and splits into RJ and PJ only.
+ */
+class JitterDecomposer {
+public:
+    /**
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    explicit JitterDecomposer(const JitterMonitorParams& params);
+
+    /**
+     * @brief Add one edge
+     * @param ui_index UI the edge starts; must not decrease between calls
+     * @param tie Time interval error from the reference grid (s)
+     * @param pattern Bits ending at the edge, newest in bit 0 (masked to pattern_bits)
+     */
+    void add_edge(std::uint64_t ui_index, double tie, unsigned pattern);
+    void clear();
+
+    /**
+     * @throws std::invalid_argument if no edge was added
+     */
+    JitterReport report() const;
+
+    std::uint64_t get_num_edges() const { return m_num_edges; }
+    int get_psd_segments() const { return m_segments; }
+
+private:
+    struct Moments {
+        std::uint64_t n;
+        double mean;
+        double m2;
+    };
+
+    static void update(Moments& m, double x);
+    void push_ui(double residual);
+    void process_segment();
+
+    JitterMonitorParams m_params;
+    unsigned m_pattern_mask;
+    std::vector<Moments> m_patterns;
+    Moments m_total;
+    double m_min;
+    double m_max;
+    std::uint64_t m_num_edges;
+
+    // Spectrum of the held, decimated residual
+    bool m_started;
+    std::uint64_t m_next_ui;          // Next UI to enter the decimator
+    double m_hold;                    // Residual of the last edge
+    double m_dec_sum;
+    int m_dec_count;
+    std::vector<double> m_segment;
+    int m_fill;
+    std::vector<double> m_window;     // Hann
+    double m_window_power;            // Sum of the squared window
+    std::vector<double> m_psd_sum;    // Sum of |X|^2 over the segments
+    int m_segments;
+};
+
+} // namespace serdes
+
+#endif // SERDES_JITTER_DECOMPOSITION_H
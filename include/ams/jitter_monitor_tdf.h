@@ -0,0 +1,89 @@
+#ifndef SERDES_JITTER_MONITOR_TDF_H
+#define SERDES_JITTER_MONITOR_TDF_H
+
+#include <systemc-ams>
+#include <cstdint>
+#include "common/parameters.h"
+#include "ams/jitter_decomposition.h"
+
+namespace serdes {
+
+/**
+ * @brief In-sim edge timing and jitter decomposition of data and recovered clock
+ *
+ * Extracts the zero crossings of in_p - in_n (threshold) by linear
+ * interpolation between samples, so edge times are resolved below the
+ * timestep, and decomposes them on the fly without recording the waveform:
+ * - Warm-up: during warmup_ui UIs the circular mean of the edge phases
+ *   fixes the reference grid (this also skips the adaption transient).
+ * - Then each edge's TIE is taken against the nearest grid boundary, and
+ *   the bits are decided on the input at the grid centers. Once the bit
+ *   after the edge is known, the edge enters the data JitterDecomposer
+ *   keyed by the last pattern_bits bits; crossings that do not match a
+ *   decided transition (glitches) are dropped.
+ * - clk_phase (the CDR phase, s) is sampled at every grid center into a
+ *   second JitterDecomposer, which splits the recovered-clock jitter into
+ *   RJ and PJ.
+ */
+class JitterMonitorTdf : public sca_tdf::sca_module {
+public:
+    // Data waveform (differential), e.g. channel or DFE output
+    sca_tdf::sca_in<double> in_p;
+    sca_tdf::sca_in<double> in_n;
+    // Recovered-clock phase offset (s)
+    sca_tdf::sca_in<double> clk_phase;
+
+    /**
+     * @brief Constructor
+     * @param nm Module name
+     * @param params Edge extraction / decomposition parameters
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    JitterMonitorTdf(sc_core::sc_module_name nm, const JitterMonitorParams& params);
+
+    void set_attributes() override;
+    void initialize() override;
+    void processing() override;
+
+    /**
+     * @throws std::invalid_argument if no edge was analysed yet
+     */
+    JitterReport data_report() const { return m_data.report(); }
+    JitterReport clock_report() const { return m_clock.report(); }
+
+    // Debug interface
+    bool is_aligned() const { return m_aligned; }
+    double get_reference_phase() const { return m_ref; }
+    std::uint64_t get_num_edges() const { return m_data.get_num_edges(); }
+    std::uint64_t get_num_clock_samples() const { return m_clock.get_num_edges(); }
+    std::uint64_t get_dropped_edges() const { return m_dropped; }
+
+private:
+    double center_time(std::int64_t k) const { return m_ref + (static_cast<double>(k) + 0.5) * m_params.ui; }
+
+    JitterMonitorParams m_params;
+    JitterDecomposer m_data;
+    JitterDecomposer m_clock;
+    bool m_have_prev;
+    double m_prev_t;
+    double m_prev_v;
+    double m_clk;                     // Latest clk_phase sample
+
+    // Warm-up: circular mean of the edge phases
+    bool m_aligned;
+    double m_cos_sum;
+    double m_sin_sum;
+    std::uint64_t m_warmup_edges;
+    double m_ref;                     // Grid boundary k at m_ref + k * ui (s)
+
+    std::int64_t m_next_bit;          // Next grid center to decide
+    unsigned m_history;               // Decided bits, newest in bit 0
+    bool m_pending;                   // Edge waiting for the bit after it
+    std::int64_t m_pending_k;
+    double m_pending_tie;
+    std::uint64_t m_dropped;
+};
+
+} // namespace serdes
+
+#endif // SERDES_JITTER_MONITOR_TDF_H
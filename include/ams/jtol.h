@@ -0,0 +1,82 @@
+#ifndef SERDES_JTOL_H
+#define SERDES_JTOL_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "common/parameters.h"
+
+namespace serdes {
+
+/**
+ * @brief JTOL mask: SJ limit (UI pp) versus frequency
+ *
+ * Interpolated on log-log axes between the breakpoints and flat outside
+ * them. The named masks are the tables of eye_analyzer/ber/template.py.
+ */
+class JtolMask {
+public:
+    /**
+     * @throws std::invalid_argument for fewer than 2 points, unsorted or
+     *         non-positive frequencies, or non-positive limits
+     */
+    JtolMask(const std::vector<double>& frequencies, const std::vector<double>& limits);
+
+    /**
+     * @throws std::invalid_argument for an unknown name
+     */
+    static JtolMask from_name(const std::string& name);
+    static std::vector<std::string> names();
+
+    double limit(double frequency) const;
+    const std::vector<double>& get_frequencies() const { return m_freqs; }
+
+private:
+    std::vector<double> m_freqs;
+    std::vector<double> m_limits;
+};
+
+/**
+ * @brief Result at one SJ frequency
+ */
+struct JtolPoint {
+    double frequency;                 // Hz
+    double mask;                      // Mask limit (UI pp)
+    double tolerance;                 // Largest passing SJ (UI pp), 0 if amp_min failed
+    double failing;                   // Smallest failing SJ (UI pp), 0 if amp_max passed
+    int trials;
+    bool pass;                        // tolerance >= mask
+    double margin_db;                 // 20 log10(tolerance / mask), -inf if nothing passed
+};
+
+struct JtolResult {
+    std::vector<JtolPoint> points;    // In frequency order
+    bool pass;                        // Every point meets the mask
+    int total_trials;
+};
+
+/**
+ * @brief One link run with SJ (frequency Hz, amplitude UI pp)
+ * @return true if the BER target is met
+ */
+typedef std::function<bool(double frequency, double sj_pp_ui)> JtolTrial;
+
+/**
+ * @brief Search the SJ tolerance at every frequency
+ *
+ * Per frequency: the first trial is at the mask limit, which decides
+ * compliance. The bracket is then widened by factors of 2 until it holds
+ * one passing and one failing amplitude (within [amp_min, amp_max]), and
+ * bisected geometrically until failing / passing < 1 + resolution. Pass /
+ * fail is assumed monotonic in amplitude.
+ *
+ * Frequencies are independent and are handed to num_workers threads; each
+ * blocks in its trial, which typically runs a simulation in a child process.
+ * An exception thrown by a trial is rethrown after all workers stop.
+ * @throws std::invalid_argument for out-of-range parameters
+ */
+JtolResult run_jtol_sweep(const JtolParams& params, const JtolMask& mask, const JtolTrial& trial);
+
+} // namespace serdes
+
+#endif // SERDES_JTOL_H
@@ -0,0 +1,88 @@
+#ifndef SERDES_NOISE_GENERATOR_H
+#define SERDES_NOISE_GENERATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "common/checkpoint.h"
+
+namespace serdes {
+
+/**
+ * @brief Counter-based noise stream shared by all noisy blocks
+ *
+ * Philox4x32-10 keyed by (global seed, hash of module path). Variate i is a
+ * pure function of (key, i), so:
+ * - runs are bit-reproducible regardless of module construction order
+ * - any sample index can be computed independently (parallel segments,
+ *   checkpoint/restore only needs the position counter)
+ * - normals are produced in batches (Box-Muller over 4-lane counter blocks)
+ *
+ * Normal and uniform variates use disjoint counter spaces of the same key.
+ */
+class NoiseStream {
+public:
+    NoiseStream();
+
+    /**
+     * @param seed Link seed or per-block override; 0 (no seed configured)
+     *             selects DEFAULT_SEED
+     * @param path Module hierarchical name (e.g. sc_object::name())
+     */
+    NoiseStream(std::uint64_t seed, const std::string& path);
+
+    void reseed(std::uint64_t seed, const std::string& path);
+
+    /**
+     * @brief Standard normal variate at absolute index (random access)
+     */
+    double normal_at(std::uint64_t index) const;
+
+    /**
+     * @brief Uniform variate in (0, 1) at absolute index (random access)
+     */
+    double uniform_at(std::uint64_t index) const;
+
+    /**
+     * @brief Fill out[0..n) with standard normals starting at first_index
+     */
+    void fill_normal(std::uint64_t first_index, double* out, std::size_t n) const;
+
+    /**
+     * @brief Sequential draws (buffered batches of BATCH normals)
+     */
+    double next_normal();
+    double next_uniform();
+
+    /**
+     * @brief Stream positions, for checkpoint/restore
+     */
+    std::uint64_t get_normal_position() const { return m_normal_pos; }
+    std::uint64_t get_uniform_position() const { return m_uniform_pos; }
+    void set_position(std::uint64_t normal_pos, std::uint64_t uniform_pos);
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+    std::uint64_t get_key() const;
+
+    /**
+     * @brief FNV-1a hash of a module path
+     */
+    static std::uint64_t hash_path(const std::string& path);
+
+    static const std::size_t BATCH = 64;
+
+private:
+    std::uint32_t m_key0;
+    std::uint32_t m_key1;
+
+    std::uint64_t m_normal_pos;     // Index of next normal to return
+    std::uint64_t m_uniform_pos;    // Index of next uniform to return
+    std::uint64_t m_batch_start;    // Index of m_batch[0]
+    bool m_batch_valid;
+    double m_batch[BATCH];
+};
+
+} // namespace serdes
+
+#endif // SERDES_NOISE_GENERATOR_H
@@ -0,0 +1,105 @@
+#ifndef SERDES_PLL_PHASE_MODEL_H
+#define SERDES_PLL_PHASE_MODEL_H
+
+#include <cstdint>
+#include <string>
+#include "common/parameters.h"
+#include "ams/noise_generator.h"
+
+namespace serdes {
+
+/**
+ * @brief Phase-domain model of a charge-pump PLL (tri-state PFD, series RC
+ *        loop filter, VCO, feedback divider)
+ *
+ * The loop is updated once per reference cycle. At reference edge k the
+ * PFD compares the reference with the divided VCO phase,
+ *
+ *   phi_e = k - theta_vco / N          (cycles, clamped to the +/-1 cycle PFD range)
+ *
+ * and the charge pump drives the cycle-averaged current I = Icp * phi_e into
+ * the loop filter until the next edge. Between edges the VCO phase is
+ * closed-form, so it can be sampled at any timestep:
+ *
+ *   Vctrl(tau) = Vc + I R + I tau / C
+ *   theta(tau) = theta + (f0 + Kvco (Vc + I R)) tau + Kvco I tau^2 / (2 C)
+ *
+ * and Vc advances by I T_ref / C per cycle. The cycle-averaged charge pump
+ * is the usual continuous-time approximation, valid while the loop
+ * bandwidth is well below f_ref / 10.
+ *
+ * Noise: the reference edges carry white jitter (seen by the PFD, low-pass
+ * filtered by the loop), and the VCO accumulates white-FM phase noise as a
+ * random walk of vco_jitter_rms per VCO cycle (high-pass filtered by the
+ * loop). Both are drawn from a NoiseStream keyed by the owner path.
+ */
+class PllPhaseModel {
+public:
+    PllPhaseModel();
+
+    /**
+     * @param params PLL parameters
+     * @param frequency Target output frequency (Hz); f_ref = frequency / divider
+     * @param path Owner hierarchical name for the noise stream key
+     * @throws std::invalid_argument for out-of-range parameters, or a
+     *         pd_type other than "tri-state" (the only PFD modelled)
+     */
+    void configure(const ClockPllParams& params, double frequency, const std::string& path);
+
+    /**
+     * @brief Restart at phase 0 with the loop filter at its initial charge
+     */
+    void reset();
+
+    /**
+     * @brief Advance by dt seconds, updating the loop at every reference
+     *        edge crossed in the interval
+     */
+    void advance(double dt);
+
+    /**
+     * @brief VCO output phase within the current cycle, [0, 1) cycles
+     */
+    double phase() const { return m_vco_frac; }
+
+    /**
+     * @brief Instantaneous VCO frequency (Hz)
+     */
+    double frequency() const;
+
+    double get_control_voltage() const;
+    double get_phase_error() const { return m_phase_error; }       ///< Last PFD output (cycles)
+    /**
+     * @brief Time into the last advance() of its last VCO cycle boundary
+     *        (rising edge), interpolated linearly; -1 if none was crossed
+     */
+    double get_last_edge_offset() const { return m_last_edge_offset; }
+    std::int64_t get_ref_edges() const { return m_ref_edges; }
+    double get_ref_period() const { return m_t_ref; }
+
+private:
+    // Advance the VCO phase analytically by tau within the current cycle
+    void advance_within_cycle(double tau);
+    void reference_edge();
+
+    ClockPllParams m_params;
+    double m_target;              // Target output frequency (Hz)
+    double m_t_ref;               // Reference period (s)
+    double m_vc_initial;          // Initial capacitor voltage (V)
+
+    double m_vc;                  // Capacitor voltage at the last edge (V)
+    double m_icp;                 // Cycle-averaged charge pump current (A)
+    double m_tau;                 // Time since the last reference edge (s)
+    double m_phase_error;         // Last PFD output (cycles)
+
+    std::int64_t m_ref_edges;     // Reference edges processed
+    std::int64_t m_vco_count;     // Completed VCO cycles
+    double m_vco_frac;            // VCO phase within the cycle [0, 1)
+    double m_last_edge_offset;    // See get_last_edge_offset()
+
+    NoiseStream m_noise;
+};
+
+} // namespace serdes
+
+#endif // SERDES_PLL_PHASE_MODEL_H
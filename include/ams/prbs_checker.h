@@ -0,0 +1,73 @@
+#ifndef SERDES_PRBS_CHECKER_H
+#define SERDES_PRBS_CHECKER_H
+
+#include <systemc-ams>
+#include <deque>
+#include "common/parameters.h"
+#include "ams/prbs_sync_checker.h"
+
+namespace serdes {
+
+/**
+ * @brief Streaming PRBS checker / BER counter TDF Module
+ *
+ * Compares the recovered data (RxTopModule::data_out, 0/1 held between
+ * decisions) with the expected PRBS at UI rate, without storing bits:
+ * - Self-synchronizes to the received stream (no seed or latency setting)
+ * - Counts errors on packed 64-bit words (popcount), tracks error bursts
+ * - Reports a confidence-level BER upper bound for error-free runs
+ *
+ * Bits are taken on the trigger port (CDR sampling trigger) when
+ * use_trigger is set, decision_latency samples after each trigger. Without
+ * a trigger they are taken once per UI at sample_phase on a free-running
+ * grid, which requires ui to be an integer multiple of the timestep. The DE
+ * outputs are refreshed once per 64 checked bits.
+ */
+class PrbsCheckerTdf : public sca_tdf::sca_module {
+public:
+    // Recovered data (> 0.5 = bit 1)
+    sca_tdf::sca_in<double> data_in;
+
+    // Decision strobe; present only when use_trigger is set
+    sc_core::sc_vector<sca_tdf::sca_in<bool>> trigger;
+
+    // Results (DE domain)
+    sca_tdf::sca_de::sca_out<bool> locked;          // Pattern lock
+    sca_tdf::sca_de::sca_out<double> bit_count;     // Checked bits
+    sca_tdf::sca_de::sca_out<double> error_count;   // Bit errors
+    sca_tdf::sca_de::sca_out<double> ber;           // errors / bits
+    sca_tdf::sca_de::sca_out<double> ber_upper;     // BER upper bound at params.confidence
+    sca_tdf::sca_de::sca_out<int> burst_count;      // Error bursts
+    sca_tdf::sca_de::sca_out<int> max_burst;        // Longest burst (bits)
+    sca_tdf::sca_de::sca_out<int> sync_losses;      // Re-acquisitions after a bit slip
+
+    /**
+     * @brief Constructor
+     * @param nm Module name
+     * @param params Checker parameters
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    PrbsCheckerTdf(sc_core::sc_module_name nm, const PrbsCheckerParams& params);
+
+    void set_attributes() override;
+    void initialize() override;
+    void processing() override;
+
+    // Debug interface
+    const PrbsSyncChecker& get_checker() const { return m_checker; }
+    int get_samples_per_ui() const { return m_samples_per_ui; }
+
+private:
+    void write_outputs();
+
+    PrbsCheckerParams m_params;
+    PrbsSyncChecker m_checker;
+    int m_samples_per_ui;
+    int m_sample_index;          // Sample within the UI that carries the bit
+    int m_sample_counter;
+    std::deque<int> m_pending;   // Age (samples) of each trigger awaiting its decision
+};
+
+} // namespace serdes
+
+#endif // SERDES_PRBS_CHECKER_H
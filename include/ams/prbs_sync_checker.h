@@ -0,0 +1,124 @@
+#ifndef SERDES_PRBS_SYNC_CHECKER_H
+#define SERDES_PRBS_SYNC_CHECKER_H
+
+#include <cstdint>
+#include "common/parameters.h"
+#include "common/prbs.h"
+
+namespace serdes {
+
+/**
+ * @brief Upper bound of the BER at a confidence level (Poisson statistics)
+ *
+ * Smallest BER such that observing at most `errors` in `bits` has
+ * probability 1 - confidence; with no errors this is -ln(1 - CL) / bits
+ * (about 3 / bits at 95%).
+ */
+double ber_upper_bound(std::uint64_t errors, std::uint64_t bits, double confidence);
+
+/**
+ * @brief Lower bound of the BER at a confidence level (Poisson statistics)
+ *
+ * Largest BER such that observing at least `errors` in `bits` has
+ * probability 1 - confidence; 0 when no error was seen.
+ */
+double ber_lower_bound(std::uint64_t errors, std::uint64_t bits, double confidence);
+
+/**
+ * @brief Self-synchronizing PRBS checker core (UI-rate, no per-bit storage)
+ *
+ * Acquisition: the last L received bits form an LFSR state; each new bit is
+ * compared with the prediction from that state. After sync_bits consecutive
+ * correct predictions the local LFSR takes over (any link latency is
+ * absorbed, and the TX seed is not needed). A run of sync_bits wrong
+ * predictions locks to the inverted pattern.
+ *
+ * Locked: received and expected bits are packed into 64-bit words; each
+ * closed word adds popcount(rx ^ expected) errors and feeds the burst
+ * statistics (a burst ends after burst_gap error-free bits). A word with
+ * more than loss_errors errors is taken as a bit slip: it is not counted,
+ * and the checker re-acquires.
+ */
+class PrbsSyncChecker {
+public:
+    PrbsSyncChecker();
+
+    /**
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    void configure(const PrbsCheckerParams& params);
+
+    /**
+     * @brief Drop lock and clear all counters
+     */
+    void reset();
+
+    /**
+     * @brief Process one received bit
+     * @return true when a 64-bit word was closed (counters changed)
+     */
+    bool push(bool bit);
+
+    bool is_locked() const { return m_locked; }
+    bool is_inverted() const { return m_invert; }
+
+    /**
+     * @brief Transmitted value of the last pushed bit: the local PRBS when
+     *        the bit was checked while locked, the bit itself otherwise
+     */
+    bool get_expected() const { return m_expected; }
+
+    /**
+     * @brief Checked bits and errors, including the partially filled word
+     */
+    std::uint64_t get_bit_count() const { return m_bits + m_fill; }
+    std::uint64_t get_error_count() const;
+    double get_ber() const;
+    double get_ber_upper() const;
+
+    std::uint64_t get_burst_count() const { return m_burst_count + (m_in_burst ? 1 : 0); }
+    std::uint64_t get_max_burst_length() const;     ///< First to last error (bits)
+    std::uint64_t get_max_burst_errors() const;
+    std::uint64_t get_sync_losses() const { return m_sync_losses; }
+
+private:
+    void acquire(bool bit);
+    void close_word();
+    void account_bursts(std::uint64_t err, int n);
+    void close_burst();
+
+    PrbsCheckerParams m_params;
+    PrbsLfsr m_lfsr;                 // Local reference, valid when locked
+    unsigned int m_mask;
+
+    // Acquisition
+    unsigned int m_seed;             // Last L received bits (bit 0 = newest)
+    int m_seed_fill;
+    int m_run_match;
+    int m_run_mismatch;
+    bool m_locked;
+    bool m_invert;
+    bool m_expected;                 // See get_expected()
+
+    // Packed word under construction
+    std::uint64_t m_diff;            // rx ^ expected, bit i = i-th bit of the word
+    int m_fill;
+
+    // Counters (closed words)
+    std::uint64_t m_bits;
+    std::uint64_t m_errors;
+    std::uint64_t m_sync_losses;
+
+    // Burst tracking
+    bool m_in_burst;
+    std::uint64_t m_gap;             // Error-free bits since the last error
+    std::uint64_t m_burst_len;
+    std::uint64_t m_burst_errors;
+    std::uint64_t m_burst_count;
+    std::uint64_t m_max_burst_len;
+    std::uint64_t m_max_burst_errors;
+};
+
+} // namespace serdes
+
+#endif // SERDES_PRBS_SYNC_CHECKER_H
@@ -0,0 +1,74 @@
+#ifndef SERDES_PULSE_EXTRACT_H
+#define SERDES_PULSE_EXTRACT_H
+
+#include <systemc-ams>
+#include "common/parameters.h"
+#include "ams/pulse_response_collector.h"
+
+namespace serdes {
+
+/**
+ * @brief Stimulus for single-bit-response extraction
+ *
+ * Outputs 0 for lead_ui UI, then amplitude for one UI ("pulse") or from
+ * then on ("step"). Drives the TX input in place of WaveGenerationTdf and,
+ * like it, sets the cluster timestep to ui / round(ui * sample_rate).
+ */
+class PulseStimulusTdf : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out;
+
+    /**
+     * @throws std::invalid_argument for non-positive rates or an unknown mode
+     */
+    PulseStimulusTdf(sc_core::sc_module_name nm, const PulseExtractParams& params,
+                     double sample_rate, double ui);
+
+    void set_attributes() override;
+    void initialize() override;
+    void processing() override;
+
+    int get_samples_per_ui() const { return m_samples_per_ui; }
+
+private:
+    PulseExtractParams m_params;
+    double m_ui;
+    int m_samples_per_ui;
+    long m_count;
+};
+
+/**
+ * @brief Link output probe for single-bit-response extraction
+ *
+ * Feeds in_p - in_n (normally the VGA output) to a PulseResponseCollector
+ * and calls sc_stop() as soon as the tail has decayed, so the run lasts
+ * only as long as the response.
+ */
+class PulseResponseProbeTdf : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<double> in_p;
+    sca_tdf::sca_in<double> in_n;
+
+    /**
+     * @param samples_per_ui Must match the stimulus
+     * @param stop_when_done Call sc_stop() once the response is complete
+     * @throws std::invalid_argument for bad parameters
+     */
+    PulseResponseProbeTdf(sc_core::sc_module_name nm, const PulseExtractParams& params,
+                          int samples_per_ui, bool stop_when_done = true);
+
+    void set_attributes() override;
+    void initialize() override;
+    void processing() override;
+
+    const PulseResponseCollector& get_collector() const { return m_collector; }
+
+private:
+    PulseResponseCollector m_collector;
+    bool m_stop_when_done;
+    bool m_stopped;
+};
+
+} // namespace serdes
+
+#endif // SERDES_PULSE_EXTRACT_H
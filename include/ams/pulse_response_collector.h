@@ -0,0 +1,82 @@
+#ifndef SERDES_PULSE_RESPONSE_COLLECTOR_H
+#define SERDES_PULSE_RESPONSE_COLLECTOR_H
+
+#include <vector>
+#include "common/parameters.h"
+
+namespace serdes {
+
+/**
+ * @brief Streaming single-bit-response extraction
+ *
+ * Consumes the differential link output one timestep at a time, starting
+ * lead_ui UI before the stimulus edge. The last lead UI gives the baseline
+ * (offsets, common-mode residue), which is removed. In "pulse" mode the
+ * response is the pulse directly; in "step" mode it is p[n] = s[n] - s[n - spu]
+ * (superposition of a step and its one-UI-delayed negative). Both are
+ * scaled by 1 / amplitude.
+ *
+ * The collection is complete once the response is at least min_ui long, the
+ * peak lies before the last tail_ui UI, and the energy in that window is
+ * below tail_threshold times the total energy; max_ui bounds the length.
+ */
+class PulseResponseCollector {
+public:
+    PulseResponseCollector();
+
+    /**
+     * @throws std::invalid_argument for an unknown mode or bad lengths
+     */
+    void configure(const PulseExtractParams& params, int samples_per_ui);
+
+    void reset();
+
+    /**
+     * @brief Process one output sample
+     * @return true once the response is complete (further samples are ignored)
+     */
+    bool push(double y);
+
+    bool is_done() const { return m_done; }
+    bool is_converged() const { return m_converged; }   ///< false if max_ui was hit
+
+    /**
+     * @brief Pulse response, sample 0 at the stimulus edge
+     */
+    const std::vector<double>& get_pulse() const { return m_pulse; }
+    int get_samples_per_ui() const { return m_spu; }
+    int get_main_sample() const { return m_main; }          ///< Peak sample
+    double get_baseline() const { return m_baseline; }
+    double get_tail_ratio() const { return m_tail_ratio; }
+
+    /**
+     * @brief Cursor-aligned samples per UI phase
+     *
+     * Row p is the sampling phase (p - spu/2) / spu UI from the peak, column
+     * num_pre + k the k-th cursor at that phase (0 = main, negative =
+     * pre-cursors); samples outside the response are 0.
+     */
+    std::vector<std::vector<double>> get_phase_cursors(int num_pre, int num_post) const;
+
+private:
+    void check_tail();
+
+    PulseExtractParams m_params;
+    int m_spu;
+    bool m_step;
+
+    long m_count;                    // Samples seen, including the lead
+    double m_baseline_sum;
+    double m_baseline;
+    std::vector<double> m_step_resp; // Step mode: baseline-free step response
+    std::vector<double> m_pulse;
+    double m_energy;
+    int m_main;
+    double m_tail_ratio;
+    bool m_done;
+    bool m_converged;
+};
+
+} // namespace serdes
+
+#endif // SERDES_PULSE_RESPONSE_COLLECTOR_H
@@ -2,18 +2,21 @@
  * @file rx_cdr.h
  * @brief Clock and Data Recovery (CDR) module for SerDes receiver
  * 
- * This module implements a behavioral-level CDR using Bang-Bang phase detector
- * and PI (Proportional-Integral) loop filter architecture.
+ * This module implements a behavioral-level CDR with a selectable phase
+ * detector and PI (Proportional-Integral) loop filter architecture.
  * 
  * Features:
- * - Bang-Bang phase detection based on data edge transitions
+ * - Selectable phase detector (CdrParams::pd): Alexander bang-bang, Hogge
+ *   (linear), or baud-rate Mueller-Muller (data triggers only)
  * - Digital PI loop filter with configurable Kp and Ki gains
  * - Phase interpolator with configurable resolution and range
  * - Phase quantization and range limiting
+ * - Integer (64-bit fixed-point) sampling-clock phase accumulator
  * 
  * @note This is a simplified implementation suitable for system-level simulation.
- *       The Bang-Bang PD uses edge polarity detection rather than a full
- *       data/edge sampler XOR architecture.
+ *       With CdrParams::edge_strobe the two-sample PDs drive a separate edge
+ *       sampler (edge_trigger / edge_in), so sampling_trigger carries data
+ *       triggers only; without it both triggers share sampling_trigger / in.
  * 
  * @version 0.2
  * @date 2026-01-20
@@ -23,7 +26,11 @@
 #define SERDES_RX_CDR_H
 
 #include <systemc-ams>
+#include <deque>
 #include "common/parameters.h"
+#include "ams/cdr_nco.h"
+#include "ams/cdr_phase_detector.h"
+#include "common/checkpoint.h"
 
 namespace serdes {
 
@@ -66,9 +73,29 @@ public:
     /**
      * @brief Sampling trigger output port
      * Outputs true for one timestep when sampling should occur
-     * Connected to sampler's sampling_trigger input
+     * Connected to sampler's sampling_trigger input. With edge_strobe it
+     * fires once per UI at the data point only; otherwise two-sample PDs
+     * also fire it at the edge point.
      */
     sca_tdf::sca_out<bool> sampling_trigger;
+    
+    /**
+     * @brief Edge sampling trigger and edge sample input (optional)
+     * Present only when CdrParams::edge_strobe is set and the PD needs an
+     * edge sample: edge_trigger fires once per UI at the edge point, and
+     * edge_in returns that trigger's sample decision_latency steps later.
+     */
+    sc_core::sc_vector<sca_tdf::sca_out<bool>> edge_trigger;
+    sc_core::sc_vector<sca_tdf::sca_in<double>> edge_in;
+    
+    /**
+     * @brief Sub-timestep sampling offset (optional)
+     * Present only when CdrParams::fractional_trigger is set. Written together
+     * with sampling_trigger: time (s) by which the ideal sampling instant,
+     * at full phase-interpolator resolution, precedes the trigger timestep.
+     * Range [0, timestep).
+     */
+    sc_core::sc_vector<sca_tdf::sca_out<double>> sampling_offset;
 
     // ========================================================================
     // Constructor
@@ -111,8 +138,8 @@ public:
     double get_integral_state() const { return m_integral; }
     
     /**
-     * @brief Get last phase error from Bang-Bang PD
-     * @return Phase error (+1, -1, or 0)
+     * @brief Get last phase error from the phase detector
+     * @return Phase error (+1, -1, or 0; within [-1, 1] for HOGGE)
      */
     double get_phase_error() const { return m_last_phase_error; }
     
@@ -121,6 +148,40 @@ public:
      * @return Raw phase value in seconds
      */
     double get_raw_phase() const { return m_phase; }
+    
+    /**
+     * @brief Get current phase interpolator code
+     * @return Quantized phase in units of PAI resolution
+     */
+    std::int64_t get_phase_code() const { return m_nco.get_code(); }
+    
+    /**
+     * @brief Get number of phase detector evaluations (loop updates)
+     */
+    unsigned long get_num_updates() const { return m_num_updates; }
+    
+    /**
+     * @brief Get the recently written sampling triggers
+     * @return Bit i = sampling_trigger written i steps ago (samples still
+     *         in flight through the delayed trigger ports)
+     */
+    std::uint64_t get_trigger_history() const { return m_trigger_bits; }
+
+    // ========================================================================
+    // Checkpoint
+    // ========================================================================
+    
+    /**
+     * @brief Store loop filter, NCO and PD state, and the outputs in flight
+     *        through the delayed output ports, under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+    
+    /**
+     * @brief Continue from a checkpoint (trained loop); applied at the next
+     *        initialize()
+     */
+    void restore_state(const StateCheckpoint& cp);
 
 private:
     // ========================================================================
@@ -128,28 +189,39 @@ private:
     // ========================================================================
     
     /**
-     * @brief Sampling state for double-sampling BBPD
+     * @brief Sampling state for double-sampling PDs (BANG_BANG, HOGGE)
      * 
      * Within each UI, CDR generates two triggers:
      * 1. EDGE: At UI boundary (phase = 0 or UI)
      * 2. DATA: At UI center (phase = UI/2)
      * 
-     * State machine tracks which sample is expected next
+     * State machine tracks which sampling point fires next; it advances
+     * only when that trigger fires. Baud-rate PDs stay in WAIT_DATA (data
+     * triggers only).
      */
     enum class SampleState {
         WAIT_EDGE,   ///< Waiting for edge sample (at UI boundary)
         WAIT_DATA    ///< Waiting for data sample (at UI/2), then compare
     };
     
-    SampleState m_sample_state;    ///< Current sampling state
+    SampleState m_sample_state;    ///< Sampling point of the next trigger
+    
+    /**
+     * @brief Fired trigger whose sample has not reached the input yet
+     * (one step of trigger delay plus decision_latency)
+     */
+    struct PendingSample {
+        int wait;                  ///< Steps until the sample is read
+        bool edge;                 ///< Edge (true) or data (false) sample
+    };
     
     // ========================================================================
     // Sample Storage for BBPD
     // ========================================================================
     
-    bool m_edge_sample;            ///< Edge sample value (at UI boundary)
-    bool m_data_sample;            ///< Data sample value (at UI/2)
-    bool m_prev_data_sample;       ///< Previous UI's data sample for transition detection
+    double m_edge_value;           ///< Edge sample value (at UI boundary)
+    std::deque<PendingSample> m_pending;  ///< Samples in flight, oldest first
+    CdrPhaseDetector m_pd;         ///< Phase detector policy
     
     // ========================================================================
     // Member Variables
@@ -159,7 +231,13 @@ private:
     double m_phase;               ///< Current phase accumulation (s)
     double m_integral;            ///< PI controller integral state
     double m_last_phase_error;    ///< Last phase error from BB-PD
-    double m_free_running_phase;  ///< Free-running phase accumulator for sampling trigger generation
+    double m_quantized_phase;     ///< Phase interpolator output (code * resolution, s)
+    unsigned long m_num_updates;  ///< Loop updates (PD evaluations)
+    CdrPhaseNco m_nco;            ///< Fixed-point sampling clock phase (trigger generation)
+    std::uint64_t m_trigger_bits; ///< Written triggers, bit i = i steps ago
+    bool m_edge_out;              ///< Last edge_trigger written
+    double m_offset_out;          ///< Last sampling_offset written (s)
+    StateCheckpoint m_restore;    ///< Pending restore, applied in initialize()
 
     // ========================================================================
     // Private Methods
@@ -170,6 +248,11 @@ private:
      * @throws std::invalid_argument if parameters are invalid
      */
     void validate_params();
+    
+    /**
+     * @brief PI update, range limiting and PAI quantization for one PD output
+     */
+    void update_loop(double phase_error);
 };
 
 } // namespace serdes
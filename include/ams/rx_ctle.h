@@ -3,7 +3,9 @@
 
 #include <systemc-ams>
 #include "common/parameters.h"
-#include <random>
+#include "ams/ctle_coeff_bank.h"
+#include "ams/noise_generator.h"
+#include "common/checkpoint.h"
 
 namespace serdes {
 
@@ -20,6 +22,7 @@ namespace serdes {
  * - PSRR path (power supply rejection)
  * - CMFB (common mode feedback) loop
  * - CMRR (common mode rejection) path
+ * - Runtime zero/pole/gain reconfiguration via DE ports (adapt.enable)
  */
 class RxCtleTdf : public sca_tdf::sca_module {
 public:
@@ -34,6 +37,13 @@ public:
     sca_tdf::sca_out<double> out_p;
     sca_tdf::sca_out<double> out_n;
     
+    // Runtime configuration from DE domain, only created when adapt.enable
+    // cfg_de[CFG_ZERO] / cfg_de[CFG_POLE] (Hz), cfg_de[CFG_DC_GAIN] (linear)
+    sc_core::sc_vector<sca_tdf::sca_de::sca_in<double>> cfg_de;
+    static const int CFG_ZERO = 0;
+    static const int CFG_POLE = 1;
+    static const int CFG_DC_GAIN = 2;
+    
     /**
      * @brief Constructor
      * @param nm Module name
@@ -60,6 +70,21 @@ public:
      * @brief Main processing function
      */
     void processing() override;
+    
+    /**
+     * @brief Store filter, CMFB and noise state under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+    
+    /**
+     * @brief Continue from a checkpoint; applied at the next initialize()
+     */
+    void restore_state(const StateCheckpoint& cp);
+    
+    // Debug interface (runtime reconfiguration, valid when adapt.enable)
+    int get_active_setting() const { return m_active_setting; }
+    int get_bank_size() const { return m_bank.size(); }
+    const CtleCoeffSet& get_active_coeffs() const { return m_bank.get(m_active_setting); }
 
 private:
     RxCtleParams m_params;
@@ -73,18 +98,22 @@ private:
     // Transfer function coefficients for main CTLE
     sca_util::sca_vector<double> m_num_ctle;   // Numerator coefficients
     sca_util::sca_vector<double> m_den_ctle;   // Denominator coefficients
+    sca_util::sca_vector<double> m_state_ctle;
     
     // Transfer function coefficients for PSRR
     sca_util::sca_vector<double> m_num_psrr;
     sca_util::sca_vector<double> m_den_psrr;
+    sca_util::sca_vector<double> m_state_psrr;
     
     // Transfer function coefficients for CMRR
     sca_util::sca_vector<double> m_num_cmrr;
     sca_util::sca_vector<double> m_den_cmrr;
+    sca_util::sca_vector<double> m_state_cmrr;
     
     // Transfer function coefficients for CMFB
     sca_util::sca_vector<double> m_num_cmfb;
     sca_util::sca_vector<double> m_den_cmfb;
+    sca_util::sca_vector<double> m_state_cmfb;
     
     // Filter enable flags
     bool m_ctle_filter_enabled;
@@ -97,9 +126,19 @@ private:
     double m_out_p_prev;                 // Previous out_p for CMFB measurement
     double m_out_n_prev;                 // Previous out_n for CMFB measurement
     
-    // Random number generator for noise
-    std::mt19937 m_rng;
-    std::normal_distribution<double> m_noise_dist;
+    // Runtime reconfiguration: cached coefficient bank + state-preserving cascade
+    CtleCoeffBank m_bank;
+    CtleSectionCascade m_cascade;
+    int m_active_setting;
+    double m_cfg_zero;
+    double m_cfg_pole;
+    double m_cfg_dc_gain;
+    
+    // Counter-based noise stream (keyed by noise_seed and module path)
+    NoiseStream m_noise;
+    
+    // Pending checkpoint restore, applied in initialize()
+    StateCheckpoint m_restore;
     
     /**
      * @brief Build transfer function coefficients from zeros and poles
@@ -129,6 +168,11 @@ private:
         const std::vector<double>& p1,
         const std::vector<double>& p2);
     
+    /**
+     * @brief Read DE configuration and switch coefficient set if it changed
+     */
+    void read_cfg_updates();
+    
     /**
      * @brief Apply soft saturation using tanh
      * @param x Input value
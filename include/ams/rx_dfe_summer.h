@@ -13,6 +13,8 @@
 
 #include <systemc-ams>
 #include "common/parameters.h"
+#include "ams/dfe_feedback.h"
+#include "common/checkpoint.h"
 #include <vector>
 #include <cmath>
 
@@ -24,7 +26,7 @@ namespace serdes {
  * 
  * 功能：
  * - 接收差分输入信号 (in_p, in_n)
- * - 基于历史判决计算反馈电压
+ * - 基于历史判决计算反馈电压（历史每 UI 移入一次，抽头 k 对应 k UI 前的判决）
  * - 输出均衡后的差分信号 (out_p, out_n)
  * - 支持 DE 域抽头系数动态更新
  */
@@ -41,6 +43,9 @@ public:
     // ========================================================================
     sca_tdf::sca_in<double> data_in;    ///< 历史判决输入 (来自 Sampler，0.0/1.0)
     
+    /// CDR 采样触发 (decision_trigger 使能时存在)，置位后下一样本移入新判决
+    sc_core::sc_vector<sca_tdf::sca_in<bool>> sampling_trigger;
+    
     // ========================================================================
     // TDF 域差分输出端口
     // ========================================================================
@@ -48,13 +53,13 @@ public:
     sca_tdf::sca_out<double> out_n;     ///< 差分输出负端 (送往 Sampler)
     
     // ========================================================================
-    // DE→TDF 桥接端口 (抽头系数动态更新，可选)
+    // DE→TDF 桥接端口 (抽头系数动态更新)
     // ========================================================================
-    sca_tdf::sca_de::sca_in<double> tap1_de;  ///< DE 域抽头1更新
-    sca_tdf::sca_de::sca_in<double> tap2_de;  ///< DE 域抽头2更新
-    sca_tdf::sca_de::sca_in<double> tap3_de;  ///< DE 域抽头3更新
-    sca_tdf::sca_de::sca_in<double> tap4_de;  ///< DE 域抽头4更新
-    sca_tdf::sca_de::sca_in<double> tap5_de;  ///< DE 域抽头5更新
+    /// DE 域抽头更新，每个抽头一个端口，数量 = tap_coeffs.size()
+    sc_core::sc_vector<sca_tdf::sca_de::sca_in<double>> tap_de;
+    
+    /// 抽头更新序号 (tap_update_seq 使能时存在)，变化时才读取 tap_de
+    sc_core::sc_vector<sca_tdf::sca_de::sca_in<int>> tap_seq_de;
     
     // ========================================================================
     // 构造函数
@@ -70,6 +75,7 @@ public:
     // TDF 回调函数
     // ========================================================================
     void set_attributes() override;
+    void initialize() override;
     void processing() override;
     
     // ========================================================================
@@ -78,13 +84,33 @@ public:
     /**
      * @brief 获取当前抽头系数
      */
-    const std::vector<double>& get_tap_coeffs() const { return m_tap_coeffs; }
+    const std::vector<double>& get_tap_coeffs() const { return m_kernel.taps(); }
     
     /**
      * @brief 获取最近一次反馈电压
      */
     double get_last_feedback() const { return m_last_feedback; }
     
+    /**
+     * @brief 获取反馈电压重算次数（缓存命中以外的样本数）
+     */
+    unsigned long get_feedback_updates() const { return m_feedback_updates; }
+    
+    /**
+     * @brief 获取移入历史的判决数（每 UI 一次）
+     */
+    unsigned long get_decisions() const { return m_decisions; }
+    
+    /**
+     * @brief 检查点：保存/恢复抽头系数、判决历史与 UI 计数（键前缀 "<name>."）
+     * 
+     * 抽头更新序号不保存：恢复后由 DfeAdaptTdf 以新序号重写抽头。
+     * 可选键 data_in_tokens / trigger_tokens 为延迟输入端口中尚未读取的
+     * 样本（由写端给出，见 RxTopModule::save_state），在 initialize() 中恢复。
+     */
+    void save_state(StateCheckpoint& cp) const;
+    void restore_state(const StateCheckpoint& cp);
+    
 private:
     // ========================================================================
     // 参数
@@ -94,21 +120,21 @@ private:
     // ========================================================================
     // 内部状态
     // ========================================================================
-    std::vector<double> m_tap_coeffs;     ///< 当前抽头系数
-    std::vector<double> m_history_bits;   ///< 历史判决缓冲区
-    double m_last_feedback;               ///< 上一次反馈电压（调试用）
+    DfeFeedbackKernel m_kernel;           ///< 抽头系数 + 打包比特历史
+    double m_last_feedback;               ///< 缓存的反馈电压
+    bool m_feedback_dirty;                ///< 历史或抽头变化，需重算反馈
+    unsigned long m_feedback_updates;     ///< 反馈重算次数
+    unsigned long m_decisions;            ///< 移入历史的判决数
+    int m_samples_per_ui;                 ///< 无触发输入时每 UI 样本数
+    int m_ui_count;                       ///< 无触发输入时的 UI 内样本计数
+    int m_last_tap_seq;                   ///< 上次读取抽头时的更新序号（0 = 尚未写入，保留 tap_coeffs）
     bool m_de_ports_connected;            ///< DE端口是否连接标志
+    std::vector<double> m_data_in_tokens; ///< 待恢复的 data_in 延迟样本（按读取顺序）
+    std::vector<bool> m_trigger_tokens;   ///< 待恢复的 sampling_trigger 延迟样本（按读取顺序）
     
     // ========================================================================
     // 内部方法
     // ========================================================================
-    /**
-     * @brief 比特映射函数
-     * @param bit_val 输入比特值 (0.0 或 1.0)
-     * @return 映射后的值 (pm1模式: -1/+1, 01模式: 0/1)
-     */
-    double bit_map(double bit_val) const;
-    
     /**
      * @brief 计算反馈电压
      * @return 反馈电压 v_fb
@@ -122,6 +148,11 @@ private:
      */
     double soft_saturate(double v_in) const;
     
+    /**
+     * @brief 当前样本是否为 UI 判决沿（移入新判决）
+     */
+    bool decision_edge();
+    
     /**
      * @brief 更新历史缓冲区
      * @param new_bit 新的判决比特
@@ -129,7 +160,7 @@ private:
     void update_history(double new_bit);
     
     /**
-     * @brief 从 DE 端口读取抽头更新（如果连接）
+     * @brief 从 DE 端口读取抽头更新（tap_update_seq 模式下仅序号变化时读取）
      */
     void read_de_tap_updates();
 };
@@ -2,7 +2,10 @@
 #define SERDES_RX_SAMPLER_H
 #include <systemc-ams>
 #include "common/parameters.h"
-#include <random>
+#include "ams/noise_generator.h"
+#include "ams/sample_interpolator.h"
+#include "common/checkpoint.h"
+#include <deque>
 
 namespace serdes {
 
@@ -15,6 +18,7 @@ namespace serdes {
  * - Hysteresis-based decision with Schmitt trigger effect
  * - Fuzzy decision mechanism for resolution region
  * - Offset and noise injection
+ * - Sub-sample interpolation at the fractional CDR phase (cubic / windowed sinc)
  * - Parameter validation
  */
 class RxSamplerTdf : public sca_tdf::sca_module {
@@ -27,10 +31,18 @@ public:
     sca_tdf::sca_in<double> clk_sample;      // Clock input for clock-driven mode
     sca_tdf::sca_in<bool> sampling_trigger;  // Sampling trigger from CDR (phase-driven mode)
     
+    // Sub-timestep offset (s) of the ideal instant before the trigger step,
+    // from RxCdrTdf::sampling_offset. Present only when interp != "none".
+    sc_core::sc_vector<sca_tdf::sca_in<double>> sampling_offset;
+    
     // Digital outputs
     sca_tdf::sca_out<double> data_out;      // TDF domain output (analog-compatible)
     sca_tdf::sca_de::sca_out<bool> data_out_de;  // TDF to DE domain bridge output
     
+    // Sampled voltage relative to threshold, held between decisions.
+    // Present only when value_output is set (Hogge / Mueller-Muller CDR input).
+    sc_core::sc_vector<sca_tdf::sca_out<double>> value_out;
+    
     /**
      * @brief Constructor
      * @param nm Module name
@@ -45,6 +57,11 @@ public:
      */
     bool get_last_sampled_bit() const { return m_last_sampled_bit; }
     
+    /**
+     * @brief Decision latency added by interpolation (timesteps)
+     */
+    int get_interp_latency() const { return m_interp.get_latency(); }
+    
     /**
      * @brief Set TDF module attributes
      */
@@ -60,17 +77,42 @@ public:
      */
     void processing();
     
+    /**
+     * @brief Store decision, noise and interpolation state under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+    
+    /**
+     * @brief Continue from a checkpoint; applied at the next initialize()
+     */
+    void restore_state(const StateCheckpoint& cp);
+    
 private:
     RxSamplerParams m_params;
     
     // Internal states
     bool m_prev_bit;
     bool m_last_sampled_bit;      ///< Last sampled bit value (held between triggers)
+    double m_last_value;          ///< Last sampled voltage minus threshold
+    
+    // Counter-based noise stream for noise and fuzzy decision
+    NoiseStream m_noise;
     
-    // Random number generator for noise and fuzzy decision
-    std::mt19937 m_rng;
-    std::normal_distribution<double> m_noise_dist;
-    std::uniform_real_distribution<double> m_decision_dist;
+    // Fractional-phase interpolation
+    struct PendingDecision {
+        int wait;                 ///< Timesteps until the kernel has enough future samples
+        double offset;            ///< Ideal instant before the trigger step (timesteps)
+    };
+    SampleInterpolator m_interp;
+    std::deque<PendingDecision> m_pending;
+    
+    // Pending checkpoint restore, applied in initialize()
+    StateCheckpoint m_restore;
+    
+    /**
+     * @brief Apply offset/noise and make the decision for one sample
+     */
+    void decide(double v_diff);
     
     /**
      * @brief Validate sampler parameters
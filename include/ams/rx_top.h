@@ -2,6 +2,8 @@
 #define SERDES_RX_TOP_H
 
 #include <systemc-ams>
+#include <stdexcept>
+#include <string>
 #include "common/parameters.h"
 #include "ams/rx_ctle.h"
 #include "ams/rx_vga.h"
@@ -79,15 +81,40 @@ public:
         return m_sig_cdr_phase;
     }
 
+    /**
+     * @brief CDR data sampling trigger (once per UI; edge triggers go to a
+     *        separate edge sampler); the decision for a trigger reaches
+     *        data_out get_decision_latency() samples later
+     */
+    const sca_tdf::sca_signal<bool>& get_sampling_trigger_signal() const {
+        return m_sig_sampling_trigger;
+    }
+    sca_tdf::sca_signal<bool>& get_sampling_trigger_signal() {
+        return m_sig_sampling_trigger;
+    }
+    int get_decision_latency() const { return m_sampler->get_interp_latency(); }
+
+    /**
+     * @brief Get DFE tap signal (1-based index)
+     * @throws std::out_of_range if tap_index is not in 1..get_num_dfe_tap_signals()
+     */
     sc_core::sc_signal<double>& get_dfe_tap_signal(int tap_index) {
-        switch (tap_index) {
-            case 1: return m_sig_dfe_tap1_de;
-            case 2: return m_sig_dfe_tap2_de;
-            case 3: return m_sig_dfe_tap3_de;
-            case 4: return m_sig_dfe_tap4_de;
-            case 5: return m_sig_dfe_tap5_de;
-            default: return m_sig_dfe_tap1_de;
+        if (tap_index < 1 || tap_index > get_num_dfe_tap_signals()) {
+            throw std::out_of_range("RxTopModule: DFE tap index " + std::to_string(tap_index) +
+                                    " out of range");
         }
+        return m_sig_dfe_tap_de[tap_index - 1];
+    }
+
+    int get_num_dfe_tap_signals() const {
+        return static_cast<int>(m_sig_dfe_tap_de.size());
+    }
+
+    /**
+     * @brief Get the adaption freeze/rollback flag (DE)
+     */
+    sc_core::sc_signal<bool>& get_freeze_flag_signal() {
+        return m_sig_freeze_flag_de;
     }
 
     /**
@@ -97,6 +124,19 @@ public:
         return m_sig_stat_C_de;
     }
 
+    /**
+     * @brief Store the trained RX state: CTLE/VGA filters, DFE taps and
+     *        history, samplers, CDR loop and NCO, DFE adaptation, AdaptionDe
+     */
+    void save_state(StateCheckpoint& cp) const;
+
+    /**
+     * @brief Continue from a checkpoint (call before sc_start); TDF state is
+     *        applied at initialize()
+     * @throws std::invalid_argument if an entry is missing or mismatched
+     */
+    void restore_state(const StateCheckpoint& cp);
+
 private:
     // ========================================================================
     // Sub-modules (TDF domain)
@@ -107,6 +147,7 @@ private:
     RxSamplerTdf* m_sampler;              // Main sampler (thr=0, data decision d_k)
     RxSamplerTdf* m_vref_pos_sampler;     // +Vref comparator (thr=+Vref, s_k)
     RxSamplerTdf* m_vref_neg_sampler;     // -Vref comparator (thr=-Vref, s'_k)
+    RxSamplerTdf* m_edge_sampler;         // CDR edge sampler (BANG_BANG / HOGGE only, else null)
     RxCdrTdf* m_cdr;
     DfeAdaptTdf* m_dfe_adapt;             // DFE adaptation engine (TDF domain)
 
@@ -133,7 +174,12 @@ private:
     sca_tdf::sca_signal<double> m_sig_dfe_to_vneg_in;   // DFE out -> vref_neg sampler in_p
     sca_tdf::sca_signal<double> m_sig_cdr_phase;
     sca_tdf::sca_signal<double> m_sig_cdr_in;
-    sca_tdf::sca_signal<bool> m_sig_sampling_trigger;
+    sca_tdf::sca_signal<bool> m_sig_sampling_trigger;   // CDR data trigger
+    sca_tdf::sca_signal<bool> m_sig_edge_trigger;       // CDR edge trigger -> edge sampler
+    sca_tdf::sca_signal<double> m_sig_edge_out;         // Edge sampler decision -> CDR (BANG_BANG)
+    sca_tdf::sca_signal<double> m_sig_edge_value;       // Edge sampler voltage -> CDR (HOGGE)
+    sca_tdf::sca_signal<double> m_sig_sampling_offset;  // CDR sub-timestep offset (interp mode)
+    sca_tdf::sca_signal<double> m_sig_sampler_value;    // Sampled voltage -> CDR (HOGGE / MM)
     sca_tdf::sca_signal<double> m_sig_data_feedback;
     sca_tdf::sca_signal<double> m_sig_clk;
 
@@ -142,14 +188,8 @@ private:
     // ========================================================================
 
     // DfeAdaptTdf -> DFE Summer (tap coefficients)
-    sc_core::sc_signal<double> m_sig_dfe_tap1_de;
-    sc_core::sc_signal<double> m_sig_dfe_tap2_de;
-    sc_core::sc_signal<double> m_sig_dfe_tap3_de;
-    sc_core::sc_signal<double> m_sig_dfe_tap4_de;
-    sc_core::sc_signal<double> m_sig_dfe_tap5_de;
-    sc_core::sc_signal<double> m_sig_dfe_tap6_de;
-    sc_core::sc_signal<double> m_sig_dfe_tap7_de;
-    sc_core::sc_signal<double> m_sig_dfe_tap8_de;
+    sc_core::sc_vector<sc_core::sc_signal<double>> m_sig_dfe_tap_de;
+    sc_core::sc_signal<int> m_sig_dfe_tap_seq_de;
 
     // DfeAdaptTdf -> AdaptionDe (statistics)
     sc_core::sc_signal<int> m_sig_stat_N_A_de;
@@ -164,6 +204,7 @@ private:
     sc_core::sc_signal<double> m_sig_stat_mu_de;
     sc_core::sc_signal<int> m_sig_stat_update_count_de;
     sc_core::sc_signal<double> m_sig_vref_current_de;
+    sc_core::sc_signal<int> m_sig_adapt_tick_de;
 
     // AdaptionDe -> DfeAdaptTdf (control)
     sc_core::sc_signal<int> m_sig_mode_de;
@@ -174,6 +215,7 @@ private:
     sc_core::sc_signal<bool> m_sig_dummy_data_out_de_0;
     sc_core::sc_signal<bool> m_sig_dummy_data_out_de_pos;
     sc_core::sc_signal<bool> m_sig_dummy_data_out_de_neg;
+    sc_core::sc_signal<bool> m_sig_dummy_data_out_de_edge;
 
     // AdaptionDe -> VGA (gain)
     sc_core::sc_signal<double> m_sig_vga_gain_de;
@@ -187,7 +229,7 @@ private:
     sc_core::sc_signal<double> m_sig_amplitude_rms_de;
     sc_core::sc_signal<double> m_sig_scenario_switch_de;
 
-    // AdaptionDe outputs (monitoring)
+    // AdaptionDe outputs (monitoring; CTLE ones also drive ctle.adapt)
     sc_core::sc_signal<double> m_sig_ctle_zero_de;
     sc_core::sc_signal<double> m_sig_ctle_pole_de;
     sc_core::sc_signal<double> m_sig_ctle_dc_gain_de;
@@ -3,7 +3,8 @@
 
 #include <systemc-ams>
 #include "common/parameters.h"
-#include <random>
+#include "ams/noise_generator.h"
+#include "common/checkpoint.h"
 
 namespace serdes {
 
@@ -60,6 +61,16 @@ public:
      * @brief Main processing function
      */
     void processing() override;
+    
+    /**
+     * @brief Store filter, CMFB and noise state under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+    
+    /**
+     * @brief Continue from a checkpoint; applied at the next initialize()
+     */
+    void restore_state(const StateCheckpoint& cp);
 
 private:
     RxVgaParams m_params;
@@ -73,18 +84,22 @@ private:
     // Transfer function coefficients for main VGA
     sca_util::sca_vector<double> m_num_vga;   // Numerator coefficients
     sca_util::sca_vector<double> m_den_vga;   // Denominator coefficients
+    sca_util::sca_vector<double> m_state_vga;
     
     // Transfer function coefficients for PSRR
     sca_util::sca_vector<double> m_num_psrr;
     sca_util::sca_vector<double> m_den_psrr;
+    sca_util::sca_vector<double> m_state_psrr;
     
     // Transfer function coefficients for CMRR
     sca_util::sca_vector<double> m_num_cmrr;
     sca_util::sca_vector<double> m_den_cmrr;
+    sca_util::sca_vector<double> m_state_cmrr;
     
     // Transfer function coefficients for CMFB
     sca_util::sca_vector<double> m_num_cmfb;
     sca_util::sca_vector<double> m_den_cmfb;
+    sca_util::sca_vector<double> m_state_cmfb;
     
     // Filter enable flags
     bool m_vga_filter_enabled;
@@ -97,9 +112,11 @@ private:
     double m_out_p_prev;                 // Previous out_p for CMFB measurement
     double m_out_n_prev;                 // Previous out_n for CMFB measurement
     
-    // Random number generator for noise
-    std::mt19937 m_rng;
-    std::normal_distribution<double> m_noise_dist;
+    // Counter-based noise stream (keyed by noise_seed and module path)
+    NoiseStream m_noise;
+    
+    // Pending checkpoint restore, applied in initialize()
+    StateCheckpoint m_restore;
     
     /**
      * @brief Build transfer function coefficients from zeros and poles
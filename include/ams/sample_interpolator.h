@@ -0,0 +1,89 @@
+#ifndef SERDES_SAMPLE_INTERPOLATOR_H
+#define SERDES_SAMPLE_INTERPOLATOR_H
+
+#include <string>
+#include <vector>
+#include "common/checkpoint.h"
+
+namespace serdes {
+
+/**
+ * @brief Interpolation kernel used by the sampler
+ */
+enum class SampleInterpKind {
+    NONE,       ///< Decide on the grid sample (legacy behaviour)
+    CUBIC,      ///< 4-point cubic Lagrange
+    SINC        ///< Blackman-windowed sinc, polyphase table
+};
+
+/**
+ * @brief Parse "none" / "cubic" / "sinc"
+ * @throws std::invalid_argument for unknown names
+ */
+SampleInterpKind parse_sample_interp(const std::string& name);
+
+/**
+ * @brief Fractional-delay interpolator over a short sample history
+ *
+ * Samples are pushed once per timestep. at(delay) returns the signal value
+ * `delay` timesteps before the newest sample (delay may be fractional).
+ * The kernel spans 2*W points around the target, so the target must be at
+ * least W-1 samples old: get_latency() is the number of timesteps a caller
+ * has to wait after an instant before interpolating it.
+ *
+ * Sinc taps are tabulated for TABLE_PHASES fractional positions and linearly
+ * blended between adjacent phases; each phase is normalized to unity DC gain.
+ */
+class SampleInterpolator {
+public:
+    SampleInterpolator();
+
+    /**
+     * @param kind Kernel type
+     * @param sinc_taps Sinc kernel length (even, 4..32); ignored otherwise
+     * @throws std::invalid_argument on invalid tap count
+     */
+    void configure(SampleInterpKind kind, int sinc_taps = 8);
+
+    void reset();
+
+    void push(double x);
+
+    /**
+     * @brief Interpolated value `delay` timesteps before the newest sample
+     * @note delay is clamped to [get_latency(), max representable]
+     */
+    double at(double delay) const;
+
+    SampleInterpKind get_kind() const { return m_kind; }
+    int get_half_width() const { return m_half_width; }
+    int get_latency() const { return m_half_width > 0 ? m_half_width - 1 : 0; }
+
+    /**
+     * @brief Save / restore the sample history under "<key>."
+     * @throws std::invalid_argument if the entry does not match the configuration
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const;
+    void restore_state(const StateCheckpoint& cp, const std::string& key);
+
+    static const int TABLE_PHASES = 256;
+
+private:
+    SampleInterpKind m_kind;
+    int m_half_width;                 // W: kernel spans ages i-W+1 .. i+W
+
+    // Mirrored history: m_hist[k] == m_hist[k + m_size], newest at m_head
+    std::vector<double> m_hist;
+    int m_size;
+    int m_head;
+
+    // Sinc polyphase table, (TABLE_PHASES + 1) rows of 2W taps
+    std::vector<double> m_table;
+
+    void build_sinc_table();
+    double sample_age(int age) const { return m_hist[m_head + age]; }
+};
+
+} // namespace serdes
+
+#endif // SERDES_SAMPLE_INTERPOLATOR_H
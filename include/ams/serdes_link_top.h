@@ -9,6 +9,7 @@
 #include "ams/channel_sparam.h"
 #include "ams/single_to_diff.h"
 #include "ams/rx_top.h"
+#include "ams/pulse_extract.h"
 
 namespace serdes {
 
@@ -25,7 +26,8 @@ struct SerdesLinkParams {
     AdaptionParams adaption;    ///< Adaption parameters (AGC, DFE tap adaptation)
     double sample_rate;         ///< Sampling rate (Hz)
     double data_rate;           ///< Data rate (bps), determines UI
-    unsigned int seed;          ///< Random seed for PRBS
+    unsigned int seed;          ///< Link seed: PRBS jitter and every noise stream without its own noise_seed
+    PulseExtractParams pulse_extract;   ///< Single-bit-response extraction mode
     
     SerdesLinkParams()
         : sample_rate(640e9)    ///< 640 GHz sampling (64x oversampling for 10G)
@@ -57,6 +59,12 @@ struct SerdesLinkParams {
  * 
  * This module provides a complete end-to-end SerDes simulation in a single
  * instantiation, suitable for system-level verification.
+ *
+ * With pulse_extract.enabled the data pattern is replaced by a single pulse
+ * (or step) stimulus, the VGA output is collected as the single-bit response
+ * of the linear TX/channel/CTLE/VGA path, and the simulation stops as soon
+ * as its tail has decayed; run sc_start() with a generous limit and read
+ * get_pulse_response() afterwards. AGC should stay disabled in this mode.
  */
 SC_MODULE(SerdesLinkTopModule) {
 public:
@@ -122,7 +130,7 @@ public:
     
     /**
      * @brief Get DFE tap coefficient (for monitoring)
-     * @param tap_index Tap index (1-5)
+     * @param tap_index Tap index (1..number of DFE taps; 0.0 outside)
      * @return Current DFE tap value
      */
     double get_dfe_tap(int tap_index) const;
@@ -270,6 +278,18 @@ public:
         return m_rx->get_cdr_integral_state();
     }
     
+    // ========================================================================
+    // Pulse Response Extraction
+    // ========================================================================
+    
+    /**
+     * @brief Extracted single-bit response
+     * @return nullptr unless pulse_extract.enabled
+     */
+    const PulseResponseCollector* get_pulse_response() const {
+        return m_pulse_probe ? &m_pulse_probe->get_collector() : nullptr;
+    }
+    
     // ========================================================================
     // Parameter Access
     // ========================================================================
@@ -284,6 +304,8 @@ private:
     // Sub-modules
     // ========================================================================
     WaveGenerationTdf* m_wavegen;       ///< Wave generation (PRBS/pulse)
+    PulseStimulusTdf* m_pulse_stim;     ///< Extraction stimulus (replaces m_wavegen)
+    PulseResponseProbeTdf* m_pulse_probe; ///< Extraction probe on the VGA output
     TxTopModule* m_tx;                  ///< TX chain (FFE + Driver)
     DiffToSingleTdf* m_d2s;             ///< Differential to single-ended converter
     ChannelSParamTdf* m_channel;        ///< Channel model
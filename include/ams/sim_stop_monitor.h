@@ -0,0 +1,62 @@
+#ifndef SERDES_SIM_STOP_MONITOR_H
+#define SERDES_SIM_STOP_MONITOR_H
+
+#include <systemc>
+#include <functional>
+#include "common/parameters.h"
+#include "ams/stop_criteria.h"
+
+namespace serdes {
+
+/**
+ * @brief SimStopMonitor - DE module that ends a link run early
+ *
+ * Every check_interval it reads the PRBS checker results and the DFE taps,
+ * evaluates StopCriteria and calls sc_stop() when a criterion is met. The
+ * criterion and the stop time are kept for the run summary.
+ *
+ * The CDR phase lives inside the TDF CDR, so it is read through a probe
+ * function (e.g. RxTopModule::get_cdr_phase) rather than a port; without a
+ * probe the phase counts as stable.
+ */
+class SimStopMonitor : public sc_core::sc_module {
+public:
+    // PRBS checker results
+    sc_core::sc_in<bool> locked;
+    sc_core::sc_in<double> bit_count;
+    sc_core::sc_in<double> error_count;
+    sc_core::sc_in<int> sync_losses;
+
+    // DFE taps (DE domain)
+    sc_core::sc_vector<sc_core::sc_in<double>> tap;
+
+    SC_HAS_PROCESS(SimStopMonitor);
+
+    /**
+     * @brief Constructor
+     * @param nm Module name
+     * @param params Stop criteria
+     * @param num_taps Number of DFE tap ports
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    SimStopMonitor(sc_core::sc_module_name nm, const StopCriteriaParams& params, int num_taps);
+
+    void set_phase_probe(std::function<double()> probe) { m_phase_probe = probe; }
+
+    StopReason get_reason() const { return m_criteria.get_reason(); }
+    double get_stop_time() const { return m_stop_time; }       ///< 0 while running
+    int get_check_count() const { return m_check_count; }
+
+private:
+    void check_process();
+
+    StopCriteriaParams m_params;
+    StopCriteria m_criteria;
+    std::function<double()> m_phase_probe;
+    double m_stop_time;
+    int m_check_count;
+};
+
+} // namespace serdes
+
+#endif // SERDES_SIM_STOP_MONITOR_H
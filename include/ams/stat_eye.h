@@ -0,0 +1,63 @@
+#ifndef SERDES_STAT_EYE_H
+#define SERDES_STAT_EYE_H
+
+#include <vector>
+#include "common/parameters.h"
+
+namespace serdes {
+
+/**
+ * @brief Statistical (pulse-response based) NRZ eye
+ *
+ * ber[p * num_bins + v] is the probability of a wrong decision when
+ * sampling at phase[p] with threshold voltage[v]. Phases are in UI relative
+ * to the main cursor (pulse peak), one per pulse sample; voltages are bin
+ * centers, voltage[num_bins / 2] = 0.
+ */
+struct StatEyeResult {
+    int num_phases;
+    int num_bins;
+    std::vector<double> phase;            // UI
+    std::vector<double> voltage;          // V
+    std::vector<double> ber;              // num_phases x num_bins
+    std::vector<double> ber_zero;         // BER at threshold 0 per phase
+    std::vector<double> contour_upper;    // Lowest voltage above 0 with BER >= target, per phase
+    std::vector<double> contour_lower;    // Highest voltage below 0 with BER >= target, per phase
+    double main_cursor;                   // Pulse peak (V)
+    double eye_height;                    // Largest contour_upper - contour_lower (V)
+    double eye_width;                     // Phases with ber_zero < target (UI)
+    double best_phase;                    // Phase of eye_height (UI)
+
+    double ber_at(int p, int v) const { return ber[static_cast<size_t>(p) * num_bins + v]; }
+};
+
+/**
+ * @brief Build the statistical eye of a sampled pulse response
+ *
+ * For every sampling phase the cursors h_k = pulse[main + phase + k * spu]
+ * (minus the DFE taps for k = 1..num_dfe) each contribute a +/-h_k
+ * two-point PDF. Their convolution is formed as a product of spectra on a
+ * power-of-two voltage grid (one inverse FFT per phase); Gaussian noise
+ * enters as the spectrum of its binned histogram. Dual-Dirac jitter
+ * (dj, rj) is then applied by averaging the BER over neighbouring phases.
+ * The ideal DFE taps are the post-cursors at the main phase, so the DFE
+ * residual grows away from the eye center as it does in hardware.
+ *
+ * @param pulse Response to one +1 symbol (NRZ symbols are +/-1)
+ * @param samples_per_ui Pulse samples per UI
+ * @throws std::invalid_argument for an empty/zero pulse or bad parameters
+ */
+StatEyeResult compute_stat_eye(const std::vector<double>& pulse, int samples_per_ui,
+                               const StatEyeParams& params);
+
+/**
+ * @brief Statistical eye of the linear link (driver, SIMPLE channel, CTLE,
+ *        VGA and the configured TX FFE), see link_pulse_response()
+ */
+StatEyeResult link_stat_eye(const StatEyeParams& params, const TxParams& tx,
+                            const ChannelParams& channel, const RxParams& rx,
+                            double timestep, int samples_per_ui);
+
+} // namespace serdes
+
+#endif // SERDES_STAT_EYE_H
@@ -0,0 +1,248 @@
+#ifndef SERDES_STATE_SPACE_KERNEL_H
+#define SERDES_STATE_SPACE_KERNEL_H
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "common/checkpoint.h"
+
+namespace serdes {
+
+/**
+ * Channel kernel numeric precision
+ */
+enum class ChannelPrecision {
+    DOUBLE,  // double state and accumulation (signoff, default)
+    FLOAT,   // float state, matrices and accumulation (fastest sweeps)
+    MIXED    // float state update, double accumulation at the output
+};
+
+/**
+ * Discretized state-space model (trapezoidal rule), row-major storage
+ *
+ *   x[n+1] = Ad * x[n] + Bt * (u[n] + u[n+1])
+ *   y[n+1] = C  * x[n+1] + D * u[n+1] + Eh * (u[n+1] - u[n])
+ *
+ * with Ad = (I - A*h/2)^-1 (I + A*h/2), Bt = (I - A*h/2)^-1 B*h/2 and
+ * Eh = E/h (the E*du/dt term as a backward difference, as the channel's
+ * sca_ss path evaluates it). The state update is the rule the sca_ss
+ * solver applies, so the two differ by rounding only.
+ */
+struct DiscreteStateSpace {
+    int n_states{0};
+    int n_inputs{0};
+    int n_outputs{0};
+    std::vector<double> Ad;  // n_states x n_states
+    std::vector<double> Bt;  // n_states x n_inputs
+    std::vector<double> C;   // n_outputs x n_states
+    std::vector<double> D;   // n_outputs x n_inputs
+    std::vector<double> Eh;  // n_outputs x n_inputs, E / h (empty = no derivative term)
+};
+
+/**
+ * Discretize continuous-time (A, B, C, D) with timestep h
+ * @return false if (I - A*h/2) is singular
+ */
+bool discretize_trapezoidal(const std::vector<double>& A,
+                            const std::vector<double>& B,
+                            const std::vector<double>& C,
+                            const std::vector<double>& D,
+                            int n_states, int n_inputs, int n_outputs,
+                            double h,
+                            DiscreteStateSpace& out);
+
+/**
+ * Discretize continuous-time (A, B, C, D, E), y = C x + D u + E du/dt
+ * @return false if (I - A*h/2) is singular
+ */
+bool discretize_trapezoidal(const std::vector<double>& A,
+                            const std::vector<double>& B,
+                            const std::vector<double>& C,
+                            const std::vector<double>& D,
+                            const std::vector<double>& E,
+                            int n_states, int n_inputs, int n_outputs,
+                            double h,
+                            DiscreteStateSpace& out);
+
+/**
+ * Frequency response of one input/output pair of a continuous-time model
+ *
+ *   H(j*2*pi*f) = C (j*2*pi*f*I - A)^-1 B + D
+ *
+ * A is reduced to upper Hessenberg form once (Householder), so each
+ * frequency costs an O(n^2) Hessenberg solve instead of a full LU.
+ * @throws std::invalid_argument for inconsistent sizes or port indices
+ */
+std::vector<std::complex<double>> state_space_frequency_response(
+    const std::vector<double>& A, const std::vector<double>& B,
+    const std::vector<double>& C, const std::vector<double>& D,
+    int n_states, int n_inputs, int n_outputs,
+    int input, int output, const std::vector<double>& freqs);
+
+/**
+ * State-space stepper parameterized on state and output-accumulator type
+ *
+ * StateT = AccT = double : reference path
+ * StateT = AccT = float  : FLOAT policy
+ * StateT = float, AccT = double : MIXED policy
+ */
+template <typename StateT, typename AccT>
+class StateSpaceStepper {
+public:
+    StateSpaceStepper() : m_n(0), m_ni(0), m_no(0) {}
+
+    void configure(const DiscreteStateSpace& dss) {
+        m_n = dss.n_states;
+        m_ni = dss.n_inputs;
+        m_no = dss.n_outputs;
+        m_Ad.assign(dss.Ad.begin(), dss.Ad.end());
+        m_Bt.assign(dss.Bt.begin(), dss.Bt.end());
+        m_C.assign(dss.C.begin(), dss.C.end());
+        m_D.assign(dss.D.begin(), dss.D.end());
+        m_Eh.assign(dss.Eh.begin(), dss.Eh.end());
+        reset();
+    }
+
+    void reset() {
+        m_x.assign(m_n, StateT(0));
+        m_x_next.assign(m_n, StateT(0));
+        m_u_prev.assign(m_ni, StateT(0));
+        m_u_sum.assign(m_ni, StateT(0));
+        m_du.assign(m_ni, AccT(0));
+    }
+
+    /**
+     * Take the input before the first step as u (no step at t = 0), the
+     * convention sca_ss applies to a fresh state vector
+     */
+    void prime(const double* u) {
+        for (int j = 0; j < m_ni; ++j) {
+            m_u_prev[j] = static_cast<StateT>(u[j]);
+        }
+    }
+
+    /**
+     * Advance one timestep
+     * @param u Input vector (n_inputs)
+     * @param y Output vector (n_outputs)
+     */
+    void step(const double* u, double* y) {
+        for (int j = 0; j < m_ni; ++j) {
+            StateT uj = static_cast<StateT>(u[j]);
+            m_du[j] = static_cast<AccT>(u[j]) - static_cast<AccT>(m_u_prev[j]);
+            m_u_sum[j] = m_u_prev[j] + uj;
+            m_u_prev[j] = uj;
+        }
+
+        for (int i = 0; i < m_n; ++i) {
+            const StateT* a = &m_Ad[static_cast<size_t>(i) * m_n];
+            const StateT* b = &m_Bt[static_cast<size_t>(i) * m_ni];
+            StateT acc = StateT(0);
+            for (int k = 0; k < m_n; ++k) {
+                acc += a[k] * m_x[k];
+            }
+            for (int j = 0; j < m_ni; ++j) {
+                acc += b[j] * m_u_sum[j];
+            }
+            m_x_next[i] = acc;
+        }
+        m_x.swap(m_x_next);
+
+        for (int i = 0; i < m_no; ++i) {
+            const AccT* c = &m_C[static_cast<size_t>(i) * m_n];
+            const AccT* d = &m_D[static_cast<size_t>(i) * m_ni];
+            AccT acc = AccT(0);
+            for (int k = 0; k < m_n; ++k) {
+                acc += c[k] * static_cast<AccT>(m_x[k]);
+            }
+            for (int j = 0; j < m_ni; ++j) {
+                acc += d[j] * static_cast<AccT>(u[j]);
+            }
+            if (!m_Eh.empty()) {
+                const AccT* e = &m_Eh[static_cast<size_t>(i) * m_ni];
+                for (int j = 0; j < m_ni; ++j) {
+                    acc += e[j] * m_du[j];
+                }
+            }
+            y[i] = static_cast<double>(acc);
+        }
+    }
+
+    const std::vector<StateT>& get_state() const { return m_x; }
+
+    void set_state(const std::vector<double>& x) {
+        for (int i = 0; i < m_n && i < static_cast<int>(x.size()); ++i) {
+            m_x[i] = static_cast<StateT>(x[i]);
+        }
+    }
+
+    /**
+     * Save / restore state and trapezoidal input memory under "<key>."
+     * (float values are exact in double)
+     */
+    void save_state(StateCheckpoint& cp, const std::string& key) const {
+        cp.put_real(key + ".x", std::vector<double>(m_x.begin(), m_x.end()));
+        cp.put_real(key + ".u_prev", std::vector<double>(m_u_prev.begin(), m_u_prev.end()));
+    }
+
+    void restore_state(const StateCheckpoint& cp, const std::string& key) {
+        const std::vector<double>& x = cp.get_real_vector(key + ".x");
+        const std::vector<double>& u = cp.get_real_vector(key + ".u_prev");
+        if (static_cast<int>(x.size()) != m_n || static_cast<int>(u.size()) != m_ni) {
+            throw std::invalid_argument("StateSpaceStepper: checkpoint size mismatch at '" +
+                                        key + "'");
+        }
+        set_state(x);
+        for (int j = 0; j < m_ni; ++j) {
+            m_u_prev[j] = static_cast<StateT>(u[j]);
+        }
+    }
+
+private:
+    int m_n, m_ni, m_no;
+    std::vector<StateT> m_Ad, m_Bt;
+    std::vector<AccT> m_C, m_D, m_Eh;
+    std::vector<StateT> m_x, m_x_next;
+    std::vector<StateT> m_u_prev, m_u_sum;
+    std::vector<AccT> m_du;
+};
+
+/**
+ * Accuracy of a reduced-precision path relative to a double reference
+ */
+struct PrecisionReport {
+    double max_abs_error{0.0};  // max |y_policy - y_ref| over all outputs
+    double rms_error{0.0};      // RMS error over all outputs
+    double peak_output{0.0};    // max |y_ref|, reference for relative error
+    double rel_error{0.0};      // max_abs_error / peak_output
+    double sq_sum{0.0};         // Sum of squared errors, for rms_error
+    int n_samples{0};
+    
+    /**
+     * Accumulate one sample of all outputs
+     */
+    void add(const double* y_policy, const double* y_ref, int n_outputs);
+    
+    /**
+     * Compute rms_error and rel_error from the accumulated samples
+     */
+    void finish(int n_outputs);
+};
+
+/**
+ * Run the selected precision policy and a double-precision stepper of the
+ * same discretization in lockstep on an NRZ PRBS7 pattern (samples_per_ui
+ * samples per bit, on input 0) and report the output deviation. This
+ * isolates rounding; ChannelSParamTdf validates a policy against its
+ * actual sca_ss evaluation while the simulation runs.
+ */
+PrecisionReport check_precision(const DiscreteStateSpace& dss,
+                                ChannelPrecision policy,
+                                int n_samples,
+                                int samples_per_ui);
+
+} // namespace serdes
+
+#endif // SERDES_STATE_SPACE_KERNEL_H
@@ -0,0 +1,90 @@
+#ifndef SERDES_STOP_CRITERIA_H
+#define SERDES_STOP_CRITERIA_H
+
+#include <cstdint>
+#include <vector>
+#include "common/parameters.h"
+
+namespace serdes {
+
+/**
+ * @brief Why a link simulation ended
+ */
+enum class StopReason {
+    NONE,           // Still running / ran the full duration
+    BER_PASS,       // BER upper bound below target at the confidence level
+    BER_FAIL,       // BER lower bound above target at the confidence level
+    SYNC_LOSS,      // PRBS checker lost lock (bit slip); the slipped words are not in the BER
+    SETTLED         // DFE taps and CDR phase stable for settle_checks checks
+};
+
+const char* stop_reason_name(StopReason reason);
+
+/**
+ * @brief Snapshot of the metrics the stop criteria look at
+ */
+struct LinkMetrics {
+    double time;                 // Simulation time (s)
+    bool locked;                 // PRBS checker lock
+    std::uint64_t bits;          // Checked bits
+    std::uint64_t errors;        // Bit errors
+    std::uint64_t sync_losses;   // Checker re-acquisitions (bit slips)
+    std::vector<double> taps;    // DFE taps
+    double cdr_phase;            // CDR phase (s)
+
+    LinkMetrics() : time(0.0), locked(false), bits(0), errors(0), sync_losses(0), cdr_phase(0.0) {}
+};
+
+/**
+ * @brief Pass / fail verdict of a trial run (e.g. one JTOL point)
+ *
+ * A decided stop reason is taken as is; an undecided run is judged on the
+ * BER point estimate. An unlocked checker or any sync loss fails the
+ * trial, since the words dropped at a slip are missing from the BER.
+ */
+bool trial_passed(const LinkMetrics& m, StopReason reason, double target_ber);
+
+/**
+ * @brief Stop-criterion evaluation, called once per check interval
+ *
+ * Decisions are taken only after min_time and, for the BER criteria, only
+ * while the PRBS checker is locked. The failing criteria (a sync loss, then
+ * the BER lower bound) are checked first, so a corner that has clearly
+ * failed is never reported as passed or settled; a pass also needs a run
+ * without sync losses.
+ */
+class StopCriteria {
+public:
+    StopCriteria();
+
+    /**
+     * @throws std::invalid_argument for out-of-range parameters
+     */
+    void configure(const StopCriteriaParams& params);
+
+    void reset();
+
+    /**
+     * @brief Evaluate one metrics snapshot
+     * @return The criterion that is met, NONE to keep running; once a
+     *         criterion has been met it is returned on every later call
+     */
+    StopReason evaluate(const LinkMetrics& m);
+
+    StopReason get_reason() const { return m_reason; }
+    int get_stable_checks() const { return m_stable_checks; }
+
+private:
+    bool is_stable(const LinkMetrics& m) const;
+
+    StopCriteriaParams m_params;
+    StopReason m_reason;
+    int m_stable_checks;
+    bool m_have_prev;
+    std::vector<double> m_prev_taps;
+    double m_prev_phase;
+};
+
+} // namespace serdes
+
+#endif // SERDES_STOP_CRITERIA_H
@@ -3,6 +3,7 @@
 
 #include <systemc-ams>
 #include "common/parameters.h"
+#include "common/checkpoint.h"
 #include <vector>
 #include <string>
 
@@ -83,6 +84,21 @@ public:
      */
     void processing() override;
     
+    // ========================================================================
+    // Checkpoint
+    // ========================================================================
+    
+    /**
+     * @brief Store filter and slew state under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+    
+    /**
+     * @brief Continue from a checkpoint; applied at the next initialize()
+     * @throws std::invalid_argument (at initialize) if entries are missing
+     */
+    void restore_state(const StateCheckpoint& cp);
+    
 private:
     // ========================================================================
     // Parameters
@@ -95,6 +111,7 @@ private:
     sca_tdf::sca_ltf_nd m_bw_filter;
     sca_util::sca_vector<double> m_num_bw;
     sca_util::sca_vector<double> m_den_bw;
+    sca_util::sca_vector<double> m_state_bw;   ///< Explicit filter state (checkpointable)
     bool m_bw_filter_enabled;
     
     // ========================================================================
@@ -103,6 +120,7 @@ private:
     sca_tdf::sca_ltf_nd m_psrr_filter;
     sca_util::sca_vector<double> m_num_psrr;
     sca_util::sca_vector<double> m_den_psrr;
+    sca_util::sca_vector<double> m_state_psrr;
     bool m_psrr_enabled;
     
     // ========================================================================
@@ -111,6 +129,7 @@ private:
     double m_prev_vout_p;              ///< Previous output positive (for slew rate)
     double m_prev_vout_n;              ///< Previous output negative (for slew rate)
     double m_prev_vin_diff;            ///< Previous input differential (for skew)
+    StateCheckpoint m_restore;         ///< Pending restore, applied in initialize()
     
     // ========================================================================
     // Helper Methods
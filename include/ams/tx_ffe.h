@@ -3,6 +3,7 @@
 
 #include <systemc-ams>
 #include "common/parameters.h"
+#include "common/checkpoint.h"
 #include <vector>
 
 namespace serdes {
@@ -17,6 +18,10 @@ public:
     void set_attributes();
     void processing();
     
+    // 检查点：保存/恢复延迟线（键前缀 "<name>."）
+    void save_state(StateCheckpoint& cp) const;
+    void restore_state(const StateCheckpoint& cp);
+    
 private:
     TxFfeParams m_params;
     std::vector<double> m_buffer;  // 循环缓冲区
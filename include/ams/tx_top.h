@@ -76,6 +76,20 @@ public:
         return m_sig_mux_out; 
     }
     
+    // ========================================================================
+    // Checkpoint
+    // ========================================================================
+    
+    /**
+     * @brief Store FFE delay line and driver filter state
+     */
+    void save_state(StateCheckpoint& cp) const;
+    
+    /**
+     * @brief Continue from a checkpoint (call before sc_start)
+     */
+    void restore_state(const StateCheckpoint& cp);
+    
 private:
     // ========================================================================
     // Sub-modules
@@ -3,7 +3,8 @@
 
 #include <systemc-ams>
 #include "common/parameters.h"
-#include <random>
+#include "ams/noise_generator.h"
+#include "common/checkpoint.h"
 
 namespace serdes {
 
@@ -15,6 +16,12 @@ namespace serdes {
  * - Single-bit pulse (SBR) mode for transient response testing
  * - Random Jitter (RJ) and Sinusoidal Jitter (SJ) injection
  * - NRZ modulation (+1.0V/-1.0V)
+ *
+ * Jitter moves the edge between symbols k-1 and k to
+ * k * UI + sum_i (SJ_pp_i / 2) * sin(2 pi SJ_freq_i * k * UI) + RJ_sigma * n_k;
+ * each sample takes the symbol in force at its instant, so the levels stay
+ * +/-1 and edge times are resolved to one timestep. SJ amplitudes are not
+ * limited to 0.5 UI (low-frequency JTOL points need several UI).
  */
 class WaveGenerationTdf : public sca_tdf::sca_module {
 public:
@@ -47,6 +54,17 @@ public:
     double get_sample_rate() const { return m_sample_rate; }
     double get_ui() const { return m_ui; }
     int get_samples_per_ui() const { return m_samples_per_ui; }
+    bool has_jitter() const { return m_jitter; }
+    
+    /**
+     * @brief Store LFSR position, UI phase and jitter stream under "<name>."
+     */
+    void save_state(StateCheckpoint& cp) const;
+    
+    /**
+     * @brief Continue the pattern from a checkpoint; applied at the next initialize()
+     */
+    void restore_state(const StateCheckpoint& cp);
     
 private:
     /**
@@ -55,6 +73,16 @@ private:
      */
     bool generate_prbs_bit();
     
+    /**
+     * @brief Level of symbol k (PRBS, or the single-pulse window)
+     */
+    double next_symbol_value(std::uint64_t k);
+    
+    /**
+     * @brief Jittered position of the edge before symbol k (samples)
+     */
+    double edge_position(std::uint64_t k);
+    
     WaveGenParams m_params;
     unsigned int m_lfsr_state;
     double m_sample_rate;
@@ -64,7 +92,12 @@ private:
     double m_current_bit_value;     // Current bit value held during UI
     double m_time;
     unsigned int m_seed;
-    std::mt19937 m_rng;
+    NoiseStream m_noise;            // Jitter noise stream (keyed by seed and module path)
+    bool m_jitter;                  // SJ or RJ configured
+    std::uint64_t m_sample_index;   // Jittered path: samples since start
+    std::uint64_t m_symbol;         // Jittered path: symbol in force
+    double m_next_edge;             // Jittered path: edge before symbol m_symbol + 1 (samples)
+    StateCheckpoint m_restore;      // Pending restore, applied in initialize()
 };
 
 } // namespace serdes
@@ -0,0 +1,203 @@
+#ifndef SERDES_COMMON_CHECKPOINT_H
+#define SERDES_COMMON_CHECKPOINT_H
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace serdes {
+
+/**
+ * @brief Named simulation state, serializable to a text file
+ *
+ * Modules store their adaptive and filter state under keys prefixed with
+ * their hierarchical name (e.g. "tb.rx.cdr.integral"), so one checkpoint
+ * holds a whole link. Reals are written with 17 significant digits and
+ * integers exactly (unsigned 64-bit values by bit pattern), so a restored
+ * run continues bit-for-bit from the saved one.
+ *
+ * File format, one entry per line:
+ *   r <key> <n> v0 ... v(n-1)     real vector
+ *   i <key> <n> v0 ... v(n-1)     integer vector
+ */
+class StateCheckpoint {
+public:
+    void put_real(const std::string& key, const std::vector<double>& values) {
+        m_real[key] = values;
+    }
+    void put_real(const std::string& key, double value) {
+        m_real[key] = std::vector<double>(1, value);
+    }
+    void put_int(const std::string& key, const std::vector<std::int64_t>& values) {
+        m_int[key] = values;
+    }
+    void put_int(const std::string& key, std::int64_t value) {
+        m_int[key] = std::vector<std::int64_t>(1, value);
+    }
+    void put_uint(const std::string& key, std::uint64_t value) {
+        put_int(key, static_cast<std::int64_t>(value));
+    }
+
+    /**
+     * @brief Store / load a sca_util::sca_vector (length(), resize(),
+     *        operator()), e.g. the explicit state of an sca_ltf_nd
+     */
+    template <typename V>
+    void put_sca_vector(const std::string& key, const V& v) {
+        std::vector<double> values(v.length());
+        for (std::size_t k = 0; k < values.size(); ++k) values[k] = v(static_cast<unsigned>(k));
+        put_real(key, values);
+    }
+    template <typename V>
+    void get_sca_vector(const std::string& key, V& v) const {
+        const std::vector<double>& values = get_real_vector(key);
+        v.resize(static_cast<unsigned>(values.size()));
+        for (std::size_t k = 0; k < values.size(); ++k) v(static_cast<unsigned>(k)) = values[k];
+    }
+
+    bool has(const std::string& key) const {
+        return m_real.count(key) > 0 || m_int.count(key) > 0;
+    }
+
+    /**
+     * @throws std::invalid_argument if the key is missing
+     */
+    const std::vector<double>& get_real_vector(const std::string& key) const {
+        auto it = m_real.find(key);
+        if (it == m_real.end()) {
+            throw std::invalid_argument("StateCheckpoint: missing real entry '" + key + "'");
+        }
+        return it->second;
+    }
+    double get_real(const std::string& key) const {
+        return scalar(get_real_vector(key), key);
+    }
+    const std::vector<std::int64_t>& get_int_vector(const std::string& key) const {
+        auto it = m_int.find(key);
+        if (it == m_int.end()) {
+            throw std::invalid_argument("StateCheckpoint: missing integer entry '" + key + "'");
+        }
+        return it->second;
+    }
+    std::int64_t get_int(const std::string& key) const {
+        return scalar(get_int_vector(key), key);
+    }
+    std::uint64_t get_uint(const std::string& key) const {
+        return static_cast<std::uint64_t>(get_int(key));
+    }
+
+    /**
+     * @brief Entries whose key starts with prefix
+     */
+    StateCheckpoint subset(const std::string& prefix) const {
+        StateCheckpoint out;
+        for (auto it = m_real.lower_bound(prefix);
+             it != m_real.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            out.m_real.insert(*it);
+        }
+        for (auto it = m_int.lower_bound(prefix);
+             it != m_int.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            out.m_int.insert(*it);
+        }
+        return out;
+    }
+
+    bool empty() const { return m_real.empty() && m_int.empty(); }
+    std::size_t size() const { return m_real.size() + m_int.size(); }
+    void clear() {
+        m_real.clear();
+        m_int.clear();
+    }
+
+    void write(std::ostream& os) const {
+        os << std::setprecision(17);
+        for (const auto& e : m_real) {
+            os << "r " << e.first << ' ' << e.second.size();
+            for (double v : e.second) os << ' ' << v;
+            os << '\n';
+        }
+        for (const auto& e : m_int) {
+            os << "i " << e.first << ' ' << e.second.size();
+            for (std::int64_t v : e.second) os << ' ' << v;
+            os << '\n';
+        }
+    }
+
+    /**
+     * @throws std::invalid_argument on a malformed line
+     */
+    void read(std::istream& is) {
+        clear();
+        std::string line;
+        while (std::getline(is, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream ls(line);
+            std::string type, key;
+            std::size_t n = 0;
+            if (!(ls >> type >> key >> n) || (type != "r" && type != "i")) {
+                throw std::invalid_argument("StateCheckpoint: malformed line '" + line + "'");
+            }
+            if (type == "r") {
+                std::vector<double>& v = m_real[key];
+                v.resize(n);
+                for (std::size_t k = 0; k < n; ++k) {
+                    if (!(ls >> v[k])) {
+                        throw std::invalid_argument("StateCheckpoint: short entry '" + key + "'");
+                    }
+                }
+            } else {
+                std::vector<std::int64_t>& v = m_int[key];
+                v.resize(n);
+                for (std::size_t k = 0; k < n; ++k) {
+                    if (!(ls >> v[k])) {
+                        throw std::invalid_argument("StateCheckpoint: short entry '" + key + "'");
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @throws std::runtime_error if the file cannot be written / read
+     */
+    void save(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("StateCheckpoint: cannot write " + path);
+        }
+        file << "# serdes state checkpoint v1\n";
+        write(file);
+    }
+    void load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("StateCheckpoint: cannot read " + path);
+        }
+        read(file);
+    }
+
+private:
+    template <typename T>
+    static T scalar(const std::vector<T>& v, const std::string& key) {
+        if (v.size() != 1) {
+            throw std::invalid_argument("StateCheckpoint: entry '" + key + "' is not a scalar");
+        }
+        return v[0];
+    }
+
+    std::map<std::string, std::vector<double>> m_real;
+    std::map<std::string, std::vector<std::int64_t>> m_int;
+};
+
+} // namespace serdes
+
+#endif // SERDES_COMMON_CHECKPOINT_H
@@ -0,0 +1,53 @@
+#ifndef SERDES_COMMON_FFT_H
+#define SERDES_COMMON_FFT_H
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace serdes {
+
+// ============================================================================
+// Radix-2 FFT shared by the frequency-domain link analyses
+// ============================================================================
+
+inline size_t next_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+/**
+ * @brief In-place iterative radix-2 FFT; the inverse is unscaled
+ * @param a Data, size must be a power of two
+ */
+inline void fft_radix2(std::vector<std::complex<double>>& a, bool inverse) {
+    typedef std::complex<double> Complex;
+    const size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        double ang = 2.0 * M_PI / static_cast<double>(len) * (inverse ? 1.0 : -1.0);
+        Complex wlen(std::cos(ang), std::sin(ang));
+        for (size_t i = 0; i < n; i += len) {
+            Complex w(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; ++k) {
+                Complex u = a[i + k];
+                Complex v = a[i + k + len / 2] * w;
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+}
+
+} // namespace serdes
+
+#endif // SERDES_COMMON_FFT_H
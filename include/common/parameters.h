@@ -63,8 +63,9 @@ struct WaveGenParams {
 // ============================================================================
 struct TxFfeParams {
     std::vector<double> taps;
+    int tap_spacing;             // Delay between taps in samples (oversampling ratio = UI-spaced)
     
-    TxFfeParams() : taps({0.2, 0.6, 0.2}) {}
+    TxFfeParams() : taps({0.2, 0.6, 0.2}), tap_spacing(1) {}
 };
 
 struct TxDriverParams {
@@ -132,13 +133,43 @@ struct TxParams {
 // ============================================================================
 // Channel Parameters
 // ============================================================================
+
+// One crosstalk aggressor lane: a cheap PRBS symbol stream driven through a
+// precomputed NEXT/FEXT pulse response and superposed on the victim output
+struct CrosstalkAggressorParams {
+    std::string type;                    // Coupling type: "next" or "fext"
+    std::vector<double> pulse_response;  // Coupled single-bit response (V per unit symbol)
+    double pulse_dt;                     // Pulse response sample spacing (s), 0 = channel timestep
+    PRBSType prbs;                       // Aggressor pattern
+    unsigned int seed;                   // Aggressor LFSR seed (must differ from victim)
+    double amplitude;                    // Aggressor symbol amplitude (symbols are +/-amplitude)
+    double skew_ui;                      // Aggressor timing offset relative to victim (UI)
+    
+    CrosstalkAggressorParams()
+        : type("fext")
+        , pulse_dt(0.0)
+        , prbs(PRBSType::PRBS31)
+        , seed(1)
+        , amplitude(1.0)
+        , skew_ui(0.0) {}
+};
+
+struct CrosstalkParams {
+    double ui;                                       // Aggressor symbol period (s)
+    std::vector<CrosstalkAggressorParams> aggressors;
+    
+    CrosstalkParams()
+        : ui(100e-12) {}
+};
+
 struct ChannelParams {
     std::string touchstone;     // S-parameter file path
     int ports;                  // Number of ports
-    bool crosstalk;             // Crosstalk enable
+    bool crosstalk;             // Crosstalk enable (superpose xtalk.aggressors on victim)
     bool bidirectional;         // Bidirectional enable
     double attenuation_db;      // Simple model attenuation (dB)
     double bandwidth_hz;        // Simple model bandwidth (Hz)
+    CrosstalkParams xtalk;      // Aggressor definitions used when crosstalk is enabled
     
     ChannelParams()
         : touchstone("")
@@ -168,6 +199,7 @@ struct RxCtleParams {
     // Noise
     bool noise_enable;               // Noise enable
     double vnoise_sigma;             // Noise standard deviation (V)
+    unsigned int noise_seed;         // Noise stream seed override; 0 = link seed (keyed with module path)
     
     // Saturation
     double sat_min;                  // Output minimum voltage (V)
@@ -211,6 +243,22 @@ struct RxCtleParams {
             , gain(0.0) {}
     } cmrr;
     
+    // Runtime reconfiguration through DE ports (cfg_de[zero, pole, dc_gain])
+    struct AdaptParams {
+        struct Setting {
+            double zero;             // Replaces zeros[0] (Hz)
+            double pole;             // Replaces poles[0] (Hz)
+            double dc_gain;          // Replaces dc_gain (linear)
+        };
+        bool enable;                 // Create cfg_de ports and use coefficient bank
+        // Settings pre-discretized at initialize(); DE requests snap to the
+        // nearest of these (or the base zeros/poles/dc_gain)
+        std::vector<Setting> settings;
+        
+        AdaptParams()
+            : enable(false) {}
+    } adapt;
+    
     RxCtleParams()
         : zeros({2e9})
         , poles({30e9})
@@ -220,6 +268,7 @@ struct RxCtleParams {
         , vos(0.0)
         , noise_enable(false)
         , vnoise_sigma(0.0)
+        , noise_seed(0)
         , sat_min(-0.5)
         , sat_max(0.5) {}
 };
@@ -240,6 +289,7 @@ struct RxVgaParams {
     // Noise
     bool noise_enable;               // Noise enable
     double vnoise_sigma;             // Noise standard deviation (V)
+    unsigned int noise_seed;         // Noise stream seed override; 0 = link seed (keyed with module path)
     
     // Saturation
     double sat_min;                  // Output minimum voltage (V)
@@ -292,6 +342,7 @@ struct RxVgaParams {
         , vos(0.0)
         , noise_enable(false)
         , vnoise_sigma(0.0)
+        , noise_seed(0)
         , sat_min(-0.5)
         , sat_max(0.5) {}
 };
@@ -310,7 +361,14 @@ struct RxSamplerParams {
     // Noise configuration
     bool noise_enable;
     double noise_sigma;
-    unsigned int noise_seed;
+    unsigned int noise_seed;         // Noise stream seed override; 0 = link seed (keyed with module path)
+    
+    // Sub-sample interpolation at the CDR phase ("none" / "cubic" / "sinc")
+    std::string interp;
+    int interp_taps;              // Sinc kernel length (even, 4..32)
+    
+    // Sampled voltage output (for linear / baud-rate CDR phase detectors)
+    bool value_output;
     
     RxSamplerParams()
         : threshold(0.0)
@@ -322,7 +380,10 @@ struct RxSamplerParams {
         , offset_value(0.0)
         , noise_enable(false)
         , noise_sigma(0.0)
-        , noise_seed(DEFAULT_SEED) {}  
+        , noise_seed(0)
+        , interp("none")
+        , interp_taps(8)
+        , value_output(false) {}  
 };
 struct RxDfeParams {
     std::vector<double> taps;
@@ -340,6 +401,12 @@ struct RxDfeParams {
 // ============================================================================
 struct RxDfeSummerParams {
     std::vector<double> tap_coeffs;  // 后游抽头系数
+    
+    // 浮动抽头：抵消固定抽头之外的孤立反射，位置为判决延迟 (UI，> tap_coeffs.size())，
+    // 系数静态（不经 tap_de 更新，DfeAdaptTdf 不自适应）
+    std::vector<int> floating_positions;
+    std::vector<double> floating_coeffs;
+    
     double ui;                       // 单位间隔 (s)
     double vcm_out;                  // 输出共模电压 (V)
     double vtap;                     // 比特映射电压缩放
@@ -351,6 +418,14 @@ struct RxDfeSummerParams {
     double sat_min;
     double sat_max;
     
+    // 抽头更新序号输入：使能后仅在 tap_seq_de 变化时重读 tap_de
+    bool tap_update_seq;
+    
+    // 判决触发输入：使能后历史仅在 sampling_trigger 置位时移入（每 UI 一次），
+    // 否则按 ui / 时间步的样本计数每 UI 移入一次
+    bool decision_trigger;
+    int decision_latency;            // 触发到判决输出的延迟 (样本，插值采样器)
+    
     RxDfeSummerParams()
         : tap_coeffs({-0.05, -0.02, 0.01})
         , ui(100e-12)
@@ -360,7 +435,10 @@ struct RxDfeSummerParams {
         , enable(true)
         , sat_enable(false)
         , sat_min(-0.5)
-        , sat_max(0.5) {}
+        , sat_max(0.5)
+        , tap_update_seq(false)
+        , decision_trigger(false)
+        , decision_latency(0) {}
 };
 
 // ============================================================================
@@ -391,14 +469,22 @@ struct CdrPaiParams {
 struct CdrParams {
     CdrPiParams pi;
     CdrPaiParams pai;
+    PhaseDetectorType pd;             // BANG_BANG (Alexander) / HOGGE / MUELLER_MULLER
     double ui;                        // Unit interval (s) for PI output scaling
     double sample_point;              // Sampling point within UI (0~1, default 0.5 = center)
     bool debug_enable;                // Debug output enable
+    bool fractional_trigger;          // Emit sub-timestep sampling offset with each trigger
+    bool edge_strobe;                 // Two-sample PDs: edge triggers on edge_trigger[0], samples on edge_in[0]
+    int decision_latency;             // Extra samples until a trigger's sample reaches `in` / `edge_in`
     
     CdrParams() 
-        : ui(1e-10)                   // Default 100ps (10Gbps)
+        : pd(PhaseDetectorType::BANG_BANG)
+        , ui(1e-10)                   // Default 100ps (10Gbps)
         , sample_point(0.5)           // Default sample at UI center
-        , debug_enable(false) {}
+        , debug_enable(false)
+        , fractional_trigger(false)
+        , edge_strobe(false)
+        , decision_latency(0) {}
 };
 
 // ============================================================================
@@ -411,19 +497,30 @@ struct RxParams {
     RxDfeSummerParams dfe_summer;    // 差分 DFE Summer (替代双 RxDfeTdf)
     CdrParams cdr;                    // CDR parameters for closed-loop operation
     // AdaptionParams 通过 RxTopModule 构造函数单独传入
+    
+    // Noise blocks without their own noise_seed take the link seed
+    void inherit_noise_seed(unsigned int seed) {
+        if (ctle.noise_seed == 0) ctle.noise_seed = seed;
+        if (vga.noise_seed == 0) vga.noise_seed = seed;
+        if (sampler.noise_seed == 0) sampler.noise_seed = seed;
+    }
 };
 
 // ============================================================================
 // Clock Generation Parameters
 // ============================================================================
 struct ClockPllParams {
-    std::string pd_type;     // Phase detector type
+    std::string pd_type;     // Phase detector type: "tri-state" (PFD) only
     double cp_current;       // Charge pump current (A)
     double lf_R;             // Loop filter resistance (Ohm)
     double lf_C;             // Loop filter capacitance (F)
     double vco_Kvco;         // VCO gain (Hz/V)
-    double vco_f0;           // VCO center frequency (Hz)
+    double vco_f0;           // VCO center frequency (Hz); lock needs Vctrl = (f - f0) / Kvco
     int divider;             // Divider ratio
+    double initial_freq_offset;  // VCO start frequency - target (Hz); 0 = loop filter pre-charged to lock
+    double ref_jitter_rms;   // Reference edge RMS jitter (s)
+    double vco_jitter_rms;   // Free-running VCO period jitter per cycle (s), accumulates as a random walk
+    unsigned int noise_seed; // Noise stream seed override; 0 = link seed (keyed with module path)
     
     ClockPllParams()
         : pd_type("tri-state")
@@ -432,17 +529,30 @@ struct ClockPllParams {
         , lf_C(1e-10)
         , vco_Kvco(1e8)
         , vco_f0(1e10)
-        , divider(4) {}
+        , divider(4)
+        , initial_freq_offset(0.0)
+        , ref_jitter_rms(0.0)
+        , vco_jitter_rms(0.0)
+        , noise_seed(0) {}
 };
 
 struct ClockParams {
     ClockType type;
     double frequency;           // Clock frequency (Hz)
+    int samples_per_period;     // Timestep = 1 / (frequency * N); 0 = inherit the cluster timestep
+    bool edge_output;           // Add clk_edge port carrying rising-edge timestamps
     ClockPllParams pll;
     
     ClockParams()
-        : type(ClockType::PLL)
-        , frequency(40e9) {}
+        : type(ClockType::IDEAL)
+        , frequency(40e9)
+        , samples_per_period(100)
+        , edge_output(false) {}
+    
+    // The PLL noise takes the link seed unless pll.noise_seed is set
+    void inherit_noise_seed(unsigned int seed) {
+        if (pll.noise_seed == 0) pll.noise_seed = seed;
+    }
 };
 
 // ============================================================================
@@ -459,6 +569,60 @@ struct EyeParams {
         , measure_length(1e-4) {}
 };
 
+// ============================================================================
+// PRBS Checker Parameters (streaming BER measurement)
+// ============================================================================
+struct PrbsCheckerParams {
+    PRBSType type;               // Expected pattern (polynomial only; the seed is not needed)
+    bool use_trigger;            // Sample on the trigger port; otherwise once per UI
+    int decision_latency;        // Samples from a trigger to its decision on data_in (trigger only)
+    double ui;                   // Unit interval (s), used without a trigger; integer multiple of the timestep
+    double sample_phase;         // Sampling instant within the UI [0, 1), used without a trigger
+    int sync_bits;               // Consecutive correct predictions to declare lock
+    int loss_errors;             // Errors in one 64-bit word that drop lock (slip)
+    int burst_gap;               // Error-free bits that close an error burst
+    double confidence;           // Confidence level of the BER upper bound
+    
+    PrbsCheckerParams()
+        : type(PRBSType::PRBS31)
+        , use_trigger(false)
+        , decision_latency(0)
+        , ui(100e-12)
+        , sample_phase(0.5)
+        , sync_bits(64)
+        , loss_errors(16)
+        , burst_gap(32)
+        , confidence(0.95) {}
+};
+
+// ============================================================================
+// Stop Criteria Parameters (early termination of link simulations)
+// ============================================================================
+struct StopCriteriaParams {
+    bool enabled;                // Watch the metrics and stop the run early
+    double check_interval;       // Metric check period (s)
+    double min_time;             // No early stop before this time (s)
+    double target_ber;           // BER target for the pass/fail decisions
+    double confidence;           // Confidence level of the pass/fail decisions
+    bool stop_on_pass;           // Stop once the BER upper bound is below target
+    bool stop_on_fail;           // Stop once the BER lower bound is above target
+    int settle_checks;           // Stop after this many stable checks (0 = off)
+    double tap_tolerance;        // Max DFE tap change per check to count as stable (V)
+    double phase_tolerance;      // Max CDR phase change per check to count as stable (s)
+    
+    StopCriteriaParams()
+        : enabled(false)
+        , check_interval(100e-9)
+        , min_time(0.0)
+        , target_ber(1e-12)
+        , confidence(0.95)
+        , stop_on_pass(true)
+        , stop_on_fail(true)
+        , settle_checks(0)
+        , tap_tolerance(1e-3)
+        , phase_tolerance(0.5e-12) {}
+};
+
 // ============================================================================
 // Adaption Parameters (DE domain adaptive control)
 // ============================================================================
@@ -470,6 +634,7 @@ struct AdaptionParams {
     std::string update_mode;         // "event"|"periodic"|"multi-rate"
     double fast_update_period;       // Fast path update period (s)
     double slow_update_period;       // Slow path update period (s)
+    int event_decimation;            // "event" mode: fast updates batched per TDF tick
     
     // AGC (Automatic Gain Control) parameters
     struct AgcParams {
@@ -496,8 +661,8 @@ struct AdaptionParams {
     // DFE (Decision Feedback Equalizer) tap update parameters
     struct DfeAdaptParams {
         bool enabled;                // Enable DFE online update
-        int num_taps;                // Number of taps (1-8)
-        std::string algorithm;       // Update algorithm: "sign-lms" (default, per proposal)
+        int num_taps;                // Number of taps (>= 1)
+        std::string algorithm;       // Update algorithm: "sign-lms" (default, per proposal), "lms", "nlms", "rls", "fixed"
         double mu;                   // Step size coefficient (startup phase)
         double leakage;              // Leakage coefficient (0-1)
         std::vector<double> initial_taps;  // Initial tap coefficients
@@ -510,6 +675,11 @@ struct AdaptionParams {
         double mu_acquire;           // Step size during ACQUIRE phase
         double mu_track;             // Step size during TRACK phase
 
+        // Error-magnitude algorithms
+        double nlms_eps;             // NLMS regularization
+        double rls_lambda;           // RLS forgetting factor (0, 1]
+        double rls_delta;            // RLS initial inverse correlation P = delta * I
+
         DfeAdaptParams()
             : enabled(true)
             , num_taps(5)
@@ -522,7 +692,10 @@ struct AdaptionParams {
             , stats_period(1024)
             , mu_startup(0.125)       // 1/8
             , mu_acquire(0.03125)     // 1/32
-            , mu_track(0.0078125) {}  // 1/128
+            , mu_track(0.0078125)     // 1/128
+            , nlms_eps(1e-3)
+            , rls_lambda(0.999)
+            , rls_delta(1.0) {}
     } dfe;
     
     // Vref adaptation parameters (for dual-threshold DFE error extraction)
@@ -586,7 +759,8 @@ struct AdaptionParams {
         , seed(12345)
         , update_mode("multi-rate")
         , fast_update_period(2.5e-10)
-        , slow_update_period(2.5e-7) {}
+        , slow_update_period(2.5e-7)
+        , event_decimation(8) {}
 
     // Convenience: get DFE tap count
     int dfe_num_taps() const { return dfe.enabled ? dfe.num_taps : 0; }
@@ -598,6 +772,257 @@ struct AdaptionParams {
     double get_vref_neg() const { return vref_adapt.vref_neg; }
 };
 
+// ============================================================================
+// Equalizer Seeding Parameters (pre-simulation pulse-response solve)
+// ============================================================================
+struct EqSeedParams {
+    bool enabled;                // Seed TX FFE / DFE taps before simulation
+    std::string criterion;       // "zf" (zero-forcing) or "mmse"
+    int ffe_taps;                // TX FFE taps to solve (0 = keep TxFfeParams::taps)
+    int ffe_main;                // Index of the FFE main tap
+    double noise_sigma;          // RX-referred noise (V), used by "mmse"
+    int pulse_ui;                // Pulse response length (UI)
+    
+    EqSeedParams()
+        : enabled(false)
+        , criterion("mmse")
+        , ffe_taps(0)
+        , ffe_main(1)
+        , noise_sigma(0.005)
+        , pulse_ui(64) {}
+};
+
+// ============================================================================
+// Pulse Response Extraction Parameters (single-bit response of the link)
+// ============================================================================
+struct PulseExtractParams {
+    bool enabled;                // Replace the data pattern by the extraction stimulus
+    std::string mode;            // "pulse" (one-UI pulse) or "step" (p[n] = s[n] - s[n - UI])
+    double amplitude;            // Stimulus level (TX input units, symbols are +/-1)
+    int lead_ui;                 // Zero input before the edge; the last UI sets the baseline
+    int min_ui;                  // Minimum response length after the edge
+    int max_ui;                  // Response length limit (stops even if the tail has not decayed)
+    int tail_ui;                 // Window of the tail-energy test
+    double tail_threshold;       // Stop when window energy / total energy falls below this
+    
+    PulseExtractParams()
+        : enabled(false)
+        , mode("pulse")
+        , amplitude(1.0)
+        , lead_ui(8)
+        , min_ui(8)
+        , max_ui(512)
+        , tail_ui(4)
+        , tail_threshold(1e-6) {}
+};
+
+// ============================================================================
+// Statistical Eye Parameters (pulse-response based BER contour)
+// ============================================================================
+struct StatEyeParams {
+    int voltage_bins;            // Vertical bins over the display window
+    double window_factor;        // Display window = +/- window_factor * |main cursor|
+    int num_dfe;                 // Post-cursors cancelled by an ideal DFE at the main phase
+    std::vector<double> dfe_taps;// Fixed DFE taps (V); overrides num_dfe when not empty
+    double noise_sigma;          // RX-referred Gaussian noise (V)
+    double dj;                   // Dual-Dirac deterministic jitter, peak-to-peak (UI)
+    double rj;                   // Random jitter sigma (UI)
+    double target_ber;           // BER of the reported contour / eye opening
+    int pulse_ui;                // Pulse response length (UI)
+    
+    StatEyeParams()
+        : voltage_bins(256)
+        , window_factor(2.0)
+        , num_dfe(0)
+        , noise_sigma(0.002)
+        , dj(0.0)
+        , rj(0.0)
+        , target_ber(1e-12)
+        , pulse_ui(64) {}
+};
+
+// ============================================================================
+// COM Parameters (channel operating margin, equalizer-space search)
+// ============================================================================
+struct ComParams {
+    std::vector<std::vector<double>> ffe_presets;  // UI-spaced TX FFE presets (empty = TxFfeParams::taps)
+    std::vector<double> ctle_dc_gains;  // CTLE DC gain family (linear, empty = RxCtleParams::dc_gain)
+    std::vector<double> ctle_zeros;     // First-zero family (Hz, empty = RxCtleParams::zeros[0])
+    std::vector<double> ctle_poles;     // First-pole family (Hz, empty = RxCtleParams::poles[0])
+    double eta0;                 // RX input noise PSD, one-sided (V^2/Hz)
+    double snr_tx;               // TX signal-to-noise ratio (dB)
+    double rj;                   // Random jitter sigma (UI)
+    double dj;                   // Dual-Dirac deterministic jitter, peak-to-peak (UI)
+    double target_der;           // Detector error ratio at which the noise amplitude is taken
+    double voltage_step;         // PDF bin width relative to the main cursor
+    int pulse_ui;                // Pulse response / FFT window length (UI)
+    int num_threads;             // Search threads (0 = hardware concurrency)
+    
+    ComParams()
+        : eta0(5.2e-17)
+        , snr_tx(32.5)
+        , rj(0.01)
+        , dj(0.05)
+        , target_der(1e-12)
+        , voltage_step(1e-3)
+        , pulse_ui(64)
+        , num_threads(0) {}
+};
+
+// ============================================================================
+// Equalizer Optimizer Parameters (joint FFE/CTLE/VGA/DFE pulse-response search)
+// ============================================================================
+struct EqOptParams {
+    bool enabled;                // Optimize before the run and apply the best configuration
+    std::string metric;          // "eye" (worst-case eye height) or "snr" (SNR at the slicer)
+    int ffe_pre;                 // UI-spaced TX FFE pre-cursor taps
+    int ffe_post;                // UI-spaced TX FFE post-cursor taps
+    double ffe_step;             // Grid step of the non-main taps
+    double ffe_max;              // Grid limit |tap|; the main tap is 1 - sum |others|
+    std::vector<double> ctle_dc_gains;  // CTLE DC gain family (linear, empty = RxCtleParams::dc_gain)
+    std::vector<double> ctle_zeros;     // First-zero family (Hz, empty = RxCtleParams::zeros[0])
+    std::vector<double> ctle_poles;     // First-pole family (Hz, empty = RxCtleParams::poles[0])
+    std::vector<double> vga_gains;      // VGA DC gain family (linear, empty = RxVgaParams::dc_gain)
+    double eta0;                 // RX input noise PSD, one-sided (V^2/Hz)
+    double slicer_sigma;         // Noise at the slicer input (V), after the VGA
+    double target_ber;           // Eye metric subtracts Q(target_ber) noise sigmas
+    int phase_span;              // Sampling phases tried around the pulse peak (+/- samples)
+    int top_k;                   // Configurations kept / emitted
+    int pulse_ui;                // Pulse response / FFT window length (UI)
+    int num_threads;             // Search threads (0 = hardware concurrency)
+    
+    EqOptParams()
+        : enabled(false)
+        , metric("eye")
+        , ffe_pre(1)
+        , ffe_post(2)
+        , ffe_step(0.025)
+        , ffe_max(0.3)
+        , eta0(5.2e-17)
+        , slicer_sigma(0.002)
+        , target_ber(1e-12)
+        , phase_span(4)
+        , top_k(8)
+        , pulse_ui(64)
+        , num_threads(0) {}
+};
+
+// ============================================================================
+// Bathtub Parameters (BER extrapolation from in-sim sampler-input histograms)
+// ============================================================================
+struct BathtubParams {
+    bool enabled;                // Accumulate histograms during the run and report bathtubs
+    double ui;                   // Unit interval (s); one histogram per sample in the UI
+    int num_bins;                // Amplitude bins per phase and decided level
+    double v_range;              // Histogram window +/- v_range (V); samples outside land in the end bins
+    int warmup_ui;               // UIs skipped (adaption transient, PRBS lock) before accumulating
+    std::string reference;       // "prbs": windows on the CDR trigger, level = PRBS-expected bit
+                                 // "center": free-running grid, level of the window's center sample
+    int decision_latency;        // Samples from a trigger to its decision on data_in ("prbs")
+    double threshold;            // Decision threshold (V): level split and horizontal bathtub
+    std::string tail_model;      // "dual_dirac" (fit tail weight, mean, sigma) or "gaussian" (weight 1)
+    double tail_fraction;        // Largest tail probability included in the fit
+    int min_tail_count;          // Smallest hit count behind a fitted bin edge
+    std::vector<double> target_bers;   // Contour / eye-opening levels
+    
+    BathtubParams()
+        : enabled(false)
+        , ui(100e-12)
+        , num_bins(512)
+        , v_range(0.6)
+        , warmup_ui(1000)
+        , reference("prbs")
+        , decision_latency(0)
+        , threshold(0.0)
+        , tail_model("dual_dirac")
+        , tail_fraction(0.05)
+        , min_tail_count(10)
+        , target_bers{1e-12, 1e-13, 1e-14, 1e-15} {}
+};
+
+// ============================================================================
+// JTOL Parameters (sinusoidal jitter tolerance sweep)
+// ============================================================================
+struct JtolParams {
+    bool enabled;                // Run the sweep instead of a single simulation
+    std::string mask;            // ieee_802_3ck, oif_cei_112g, jedec_ddr5 or pcie_gen6
+    std::vector<double> frequencies;   // SJ frequencies (Hz), empty = the mask breakpoints
+    double amp_min;              // Smallest SJ tried (UI pp); below it the point fails
+    double amp_max;              // Largest SJ tried (UI pp); passing it ends the search
+    double resolution;           // Bisection ends when failing / passing < 1 + resolution
+    double target_ber;           // Trial BER target, decided by the stop criteria
+    int min_sj_periods;          // Each trial runs at least this many SJ periods
+    int num_workers;             // Parallel trial processes (0 = hardware concurrency)
+    
+    JtolParams()
+        : enabled(false)
+        , mask("ieee_802_3ck")
+        , amp_min(1e-3)
+        , amp_max(20.0)
+        , resolution(0.05)
+        , target_ber(1e-5)
+        , min_sj_periods(2)
+        , num_workers(0) {}
+};
+
+// ============================================================================
+// Jitter Monitor Parameters (in-sim edge timing and TJ/RJ/DJ decomposition)
+// ============================================================================
+struct JitterMonitorParams {
+    bool enabled;                // Extract edges during the run and report the decomposition
+    double ui;                   // Unit interval (s) of the ideal reference grid
+    double threshold;            // Crossing level of the differential input (V)
+    int warmup_ui;               // UIs used to find the mean edge phase before analysing
+    int pattern_bits;            // Bits (ending at the edge) that key the DDJ averages
+    int min_pattern_count;       // Edges a pattern needs to count towards DDJ
+    int psd_length;              // Welch segment length (power of 2)
+    int psd_decimation;          // UIs averaged into one PSD sample
+    double pj_threshold;         // PJ tone: PSD peak above this multiple of the median floor
+    int max_pj_tones;            // Largest number of PJ tones reported
+    double min_pj_freq;          // Tones below this frequency (Hz) are not PJ
+    double target_ber;           // TJ = DJ + 2 Q(target_ber) RJ
+    
+    JitterMonitorParams()
+        : enabled(false)
+        , ui(100e-12)
+        , threshold(0.0)
+        , warmup_ui(2000)
+        , pattern_bits(5)
+        , min_pattern_count(10)
+        , psd_length(2048)
+        , psd_decimation(8)
+        , pj_threshold(10.0)
+        , max_pj_tones(8)
+        , min_pj_freq(1e6)
+        , target_ber(1e-12) {}
+};
+
+// ============================================================================
+// Flight Recorder Parameters (ring-buffer capture around rare events)
+// ============================================================================
+struct FlightRecorderParams {
+    bool enabled;                // Keep the last UIs in a ring buffer and dump them around triggers
+    double ui;                   // Unit interval (s)
+    int pre_ui;                  // UIs kept before the trigger
+    int post_ui;                 // UIs recorded after the trigger before the dump
+    int decimation;              // Keep every n-th sample
+    int max_captures;            // Dumps per run; later triggers are only counted
+    bool trigger_on_error;       // Trigger when the checker error count rises
+    bool trigger_on_freeze;      // Trigger when the adaption freeze flag rises
+    double tap_bound;            // Trigger when a DFE tap leaves +/- tap_bound (V), 0 = off
+    
+    FlightRecorderParams()
+        : enabled(false)
+        , ui(100e-12)
+        , pre_ui(200)
+        , post_ui(100)
+        , decimation(1)
+        , max_captures(16)
+        , trigger_on_error(true)
+        , trigger_on_freeze(true)
+        , tap_bound(0.0) {}
+};
+
 // ============================================================================
 // System Configuration (top-level)
 // ============================================================================
@@ -610,7 +1035,24 @@ struct SystemParams {
     CdrParams cdr;
     ClockParams clock;
     EyeParams eye;
+    PrbsCheckerParams checker;
+    StopCriteriaParams stop;
     AdaptionParams adaption;
+    EqSeedParams eq_seed;
+    StatEyeParams stat_eye;
+    ComParams com;
+    EqOptParams eq_opt;
+    BathtubParams bathtub;
+    JtolParams jtol;
+    JitterMonitorParams jitter_monitor;
+    FlightRecorderParams flight_recorder;
+    
+    // Every noise stream derives from global.seed (keyed with its module
+    // path); a block's own noise_seed, if set, overrides it
+    void apply_global_seed() {
+        rx.inherit_noise_seed(global.seed);
+        clock.inherit_noise_seed(global.seed);
+    }
 };
 
 } // namespace serdes
@@ -0,0 +1,74 @@
+#ifndef SERDES_COMMON_PRBS_H
+#define SERDES_COMMON_PRBS_H
+
+#include "common/types.h"
+
+namespace serdes {
+
+// ============================================================================
+// PRBS polynomial table (ITU-T O.150), shared by all LFSR users
+// ============================================================================
+
+struct PRBSConfig {
+    int length;                 // LFSR length
+    unsigned int mask;          // Mask for state bits
+    int tap1;                   // First tap position
+    int tap2;                   // Second tap position
+    unsigned int default_init;  // Default initial state
+};
+
+inline const PRBSConfig& get_prbs_config(PRBSType type) {
+    static const PRBSConfig PRBS_CONFIGS[] = {
+        {7,  0x7F,       6,  5, 0x7F},       // PRBS7:  x^7 + x^6 + 1
+        {9,  0x1FF,      8,  4, 0x1FF},      // PRBS9:  x^9 + x^5 + 1
+        {15, 0x7FFF,     14, 13, 0x7FFF},    // PRBS15: x^15 + x^14 + 1
+        {23, 0x7FFFFF,   22, 17, 0x7FFFFF},  // PRBS23: x^23 + x^18 + 1
+        {31, 0x7FFFFFFF, 30, 27, 0x7FFFFFFF} // PRBS31: x^31 + x^28 + 1
+    };
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= 5) {
+        index = 4;  // CUSTOM and unknown types fall back to PRBS31
+    }
+    return PRBS_CONFIGS[index];
+}
+
+/**
+ * @brief Fibonacci LFSR producing the same bit sequence as WaveGenerationTdf
+ *
+ * The seed is folded into the default initial state exactly like the
+ * wave generator does, so a PrbsLfsr(type, seed) reproduces the TX pattern.
+ */
+class PrbsLfsr {
+public:
+    explicit PrbsLfsr(PRBSType type = PRBSType::PRBS31, unsigned int seed = 0)
+        : m_config(&get_prbs_config(type))
+        , m_state(0)
+    {
+        reset(seed);
+    }
+
+    void reset(unsigned int seed) {
+        m_state = (m_config->default_init ^ (seed & m_config->mask)) & m_config->mask;
+        if (m_state == 0) {
+            m_state = m_config->default_init;
+        }
+    }
+
+    bool next_bit() {
+        unsigned int feedback = ((m_state >> m_config->tap1) ^ (m_state >> m_config->tap2)) & 0x1;
+        m_state = ((m_state << 1) | feedback) & m_config->mask;
+        return (m_state & 0x1) != 0;
+    }
+
+    unsigned int get_state() const { return m_state; }
+    void set_state(unsigned int state) { m_state = state & m_config->mask; }
+    const PRBSConfig& get_config() const { return *m_config; }
+
+private:
+    const PRBSConfig* m_config;
+    unsigned int m_state;
+};
+
+} // namespace serdes
+
+#endif // SERDES_COMMON_PRBS_H
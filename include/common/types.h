@@ -46,10 +46,11 @@ enum class ClockType {
 
 // Phase detector types
 enum class PhaseDetectorType {
-    BANG_BANG,
+    BANG_BANG,        // Alexander (edge/data sample) bang-bang
     LINEAR,
     TRI_STATE,
-    HOGGE
+    HOGGE,            // Linear edge-amplitude detector (Hogge characteristic)
+    MUELLER_MULLER    // Baud-rate, one data sample per UI
 };
 
 // DFE update algorithms
@@ -123,6 +124,28 @@ inline std::string ClockTypeToString(ClockType type) {
     }
 }
 
+// Convert phase detector type to string
+inline std::string PhaseDetectorTypeToString(PhaseDetectorType type) {
+    switch (type) {
+        case PhaseDetectorType::BANG_BANG:      return "BANG_BANG";
+        case PhaseDetectorType::LINEAR:         return "LINEAR";
+        case PhaseDetectorType::TRI_STATE:      return "TRI_STATE";
+        case PhaseDetectorType::HOGGE:          return "HOGGE";
+        case PhaseDetectorType::MUELLER_MULLER: return "MUELLER_MULLER";
+        default: return "UNKNOWN";
+    }
+}
+
+// Convert string to phase detector type
+inline PhaseDetectorType StringToPhaseDetectorType(const std::string& str) {
+    if (str == "BANG_BANG" || str == "ALEXANDER") return PhaseDetectorType::BANG_BANG;
+    if (str == "LINEAR")         return PhaseDetectorType::LINEAR;
+    if (str == "TRI_STATE")      return PhaseDetectorType::TRI_STATE;
+    if (str == "HOGGE")          return PhaseDetectorType::HOGGE;
+    if (str == "MUELLER_MULLER" || str == "MM") return PhaseDetectorType::MUELLER_MULLER;
+    return PhaseDetectorType::BANG_BANG; // Default
+}
+
 } // namespace serdes
 
 #endif // SERDES_COMMON_TYPES_H
@@ -7,6 +7,7 @@
  * - CDR PI controller
  * - Vref command generation (for DfeAdaptTdf)
  * - Safety mechanisms: freeze on error, rollback to snapshot
+ * - Periodic or event-driven (TDF tick, batched updates) scheduling
  *
  * Note: DFE tap update has been moved to DfeAdaptTdf (TDF domain).
  *       AdaptionDe reads statistics from DfeAdaptTdf and generates Vref commands.
@@ -15,6 +16,7 @@
 #include "ams/adaption.h"
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
 
 namespace serdes {
 
@@ -39,6 +41,7 @@ AdaptionDe::AdaptionDe(sc_core::sc_module_name nm, const AdaptionParams& params)
     , stat_C("stat_C")
     , stat_Delta("stat_Delta")
     , stat_dfe_state("stat_dfe_state")
+    , adapt_tick("adapt_tick")
     // Output ports
     , vga_gain("vga_gain")
     , ctle_zero("ctle_zero")
@@ -52,6 +55,9 @@ AdaptionDe::AdaptionDe(sc_core::sc_module_name nm, const AdaptionParams& params)
     , freeze_flag("freeze_flag")
     // Parameters
     , m_params(params)
+    , m_ctle_zero(0.0)
+    , m_ctle_pole(0.0)
+    , m_ctle_dc_gain(0.0)
 {
     // Initialize timing
     m_fast_period = sc_core::sc_time(params.fast_update_period, sc_core::SC_SEC);
@@ -61,11 +67,19 @@ AdaptionDe::AdaptionDe(sc_core::sc_module_name nm, const AdaptionParams& params)
     initialize_state();
 
     // Register processes
-    SC_THREAD(fast_path_process);
-    sensitive << reset;
+    if (params.update_mode == "event") {
+        if (params.event_decimation < 1) {
+            throw std::invalid_argument("AdaptionDe: event_decimation must be >= 1");
+        }
+        adapt_tick.init(1);
+        SC_THREAD(event_path_process);
+    } else {
+        SC_THREAD(fast_path_process);
+        sensitive << reset;
 
-    SC_THREAD(slow_path_process);
-    sensitive << reset;
+        SC_THREAD(slow_path_process);
+        sensitive << reset;
+    }
 
     SC_METHOD(reset_process);
     sensitive << reset.pos();
@@ -103,19 +117,58 @@ void AdaptionDe::initialize_state() {
     m_fast_update_count = 0;
     m_slow_update_count = 0;
     m_freeze_flag = false;
+    m_wake_count = 0;
 
     // Snapshot management
     m_snapshots.clear();
-    m_snapshots.reserve(100);
     m_last_snapshot_time = sc_core::SC_ZERO_TIME;
 }
 
+// ============================================================================
+// Checkpoint
+// ============================================================================
+void AdaptionDe::save_state(StateCheckpoint& cp) const {
+    const std::string key = std::string(name()) + ".";
+    cp.put_real(key + "agc_integral", m_agc_integral);
+    cp.put_real(key + "gain", m_current_gain);
+    cp.put_real(key + "prev_gain", m_prev_gain);
+    cp.put_real(key + "cdr_integral", m_cdr_integral);
+    cp.put_real(key + "phase_cmd", m_current_phase_cmd);
+    cp.put_real(key + "threshold", m_current_threshold);
+    cp.put_real(key + "hysteresis", m_current_hysteresis);
+    cp.put_real(key + "vref_cmd", m_current_vref_cmd);
+    cp.put_int(key + "update_count", m_update_count);
+    cp.put_int(key + "fast_update_count", m_fast_update_count);
+    cp.put_int(key + "slow_update_count", m_slow_update_count);
+    cp.put_int(key + "freeze", m_freeze_flag ? 1 : 0);
+}
+
+void AdaptionDe::restore_state(const StateCheckpoint& cp) {
+    const std::string key = std::string(name()) + ".";
+    m_agc_integral = cp.get_real(key + "agc_integral");
+    m_current_gain = cp.get_real(key + "gain");
+    m_prev_gain = cp.get_real(key + "prev_gain");
+    m_cdr_integral = cp.get_real(key + "cdr_integral");
+    m_current_phase_cmd = cp.get_real(key + "phase_cmd");
+    m_current_threshold = cp.get_real(key + "threshold");
+    m_current_hysteresis = cp.get_real(key + "hysteresis");
+    m_current_vref_cmd = cp.get_real(key + "vref_cmd");
+    m_update_count = static_cast<int>(cp.get_int(key + "update_count"));
+    m_fast_update_count = static_cast<int>(cp.get_int(key + "fast_update_count"));
+    m_slow_update_count = static_cast<int>(cp.get_int(key + "slow_update_count"));
+    m_freeze_flag = cp.get_int(key + "freeze") != 0;
+    m_snapshots.clear();
+}
+
 // ============================================================================
 // Reset Handler
 // ============================================================================
 void AdaptionDe::reset_process() {
     if (reset.read()) {
         initialize_state();
+        m_last_fast_time = sc_core::sc_time_stamp();
+        m_last_slow_time = m_last_fast_time;
+        m_wake_event.notify(sc_core::SC_ZERO_TIME);
     }
 }
 
@@ -140,29 +193,35 @@ void AdaptionDe::fast_path_process() {
             continue;
         }
 
-        // Check for freeze conditions
-        if (m_params.safety.freeze_on_error && check_freeze_condition()) {
-            m_freeze_flag = true;
-            freeze_flag.write(true);
+        fast_path_update(current_mode, 1);
+    }
+}
 
-            if (m_params.safety.rollback_enable) {
-                rollback_to_snapshot();
-            }
-            continue;
+void AdaptionDe::fast_path_update(int current_mode, int n) {
+    // Check for freeze conditions
+    if (m_params.safety.freeze_on_error && check_freeze_condition()) {
+        m_freeze_flag = true;
+        freeze_flag.write(true);
+
+        if (m_params.safety.rollback_enable) {
+            rollback_to_snapshot();
         }
+        return;
+    }
 
-        // CDR PI Update
-        if (m_params.cdr_pi.enabled && (current_mode == 1 || current_mode == 2)) {
-            double phase_err = phase_error.read();
+    // CDR PI Update; a batch holds the phase error read at this wake
+    if (m_params.cdr_pi.enabled && (current_mode == 1 || current_mode == 2)) {
+        double phase_err = phase_error.read();
+        for (int i = 0; i < n; ++i) {
             m_current_phase_cmd = cdr_pi_update(phase_err);
-            phase_cmd.write(m_current_phase_cmd);
         }
-
-        // Update counters
-        m_fast_update_count++;
-        m_update_count++;
-        update_count.write(m_update_count);
+        phase_cmd.write(m_current_phase_cmd);
     }
+
+    // Update counters
+    m_fast_update_count += n;
+    m_update_count += n;
+    update_count.write(m_update_count);
 }
 
 // ============================================================================
@@ -182,30 +241,105 @@ void AdaptionDe::slow_path_process() {
             continue;
         }
 
-        // Snapshot Management
-        sc_core::sc_time current_time = sc_core::sc_time_stamp();
-        sc_core::sc_time snapshot_interval(m_params.safety.snapshot_interval, sc_core::SC_SEC);
+        slow_path_update(current_mode, 1);
+    }
+}
 
-        if ((current_time - m_last_snapshot_time) >= snapshot_interval) {
-            save_snapshot();
-            m_last_snapshot_time = current_time;
-        }
+void AdaptionDe::slow_path_update(int current_mode, int n) {
+    // Snapshot Management
+    sc_core::sc_time current_time = sc_core::sc_time_stamp();
+    sc_core::sc_time snapshot_interval(m_params.safety.snapshot_interval, sc_core::SC_SEC);
 
-        // AGC Update
-        if (m_params.agc.enabled && (current_mode == 1 || current_mode == 2)) {
-            double amp = amplitude_rms.read();
+    if ((current_time - m_last_snapshot_time) >= snapshot_interval) {
+        save_snapshot();
+        m_last_snapshot_time = current_time;
+    }
+
+    // AGC Update; a batch holds the amplitude read at this wake
+    if (m_params.agc.enabled && (current_mode == 1 || current_mode == 2)) {
+        double amp = amplitude_rms.read();
+        for (int i = 0; i < n; ++i) {
             m_current_gain = agc_pi_update(amp);
-            vga_gain.write(m_current_gain);
+        }
+        vga_gain.write(m_current_gain);
+    }
+
+    // Vref command generation (statistics change once per stats period,
+    // so one step per wake)
+    if (m_params.dfe.enabled && m_params.vref_adapt.enabled) {
+        update_vref_command();
+        vref_cmd.write(m_current_vref_cmd);
+    }
+
+    // Update counters
+    m_slow_update_count += n;
+}
+
+// ============================================================================
+// Event-Driven Scheduler ("event" mode)
+// ============================================================================
+bool AdaptionDe::is_idle(int current_mode) const {
+    if (current_mode == 3 || m_freeze_flag) {
+        return true;
+    }
+    return !m_params.cdr_pi.enabled && !m_params.agc.enabled &&
+           !(m_params.dfe.enabled && m_params.vref_adapt.enabled);
+}
+
+void AdaptionDe::event_path_process() {
+    wait(sc_core::SC_ZERO_TIME);
+
+    // Initialize outputs (fast and slow paths)
+    sampler_threshold.write(m_current_threshold);
+    sampler_hysteresis.write(m_current_hysteresis);
+    phase_cmd.write(m_current_phase_cmd);
+    update_count.write(m_update_count);
+    freeze_flag.write(m_freeze_flag);
+    write_all_outputs();
+
+    m_last_fast_time = sc_core::sc_time_stamp();
+    m_last_slow_time = m_last_fast_time;
+
+    while (true) {
+        if (is_idle(mode.read())) {
+            // Sleep without consuming ticks; time spent here is not
+            // adaptation time, so the update schedule restarts on wake
+            wait(mode.value_changed_event() | m_wake_event);
+            m_last_fast_time = sc_core::sc_time_stamp();
+            m_last_slow_time = m_last_fast_time;
+            continue;
         }
 
-        // Vref command generation
-        if (m_params.dfe.enabled && m_params.vref_adapt.enabled) {
-            update_vref_command();
-            vref_cmd.write(m_current_vref_cmd);
+        wait(adapt_tick[0].value_changed_event() | mode.value_changed_event() | m_wake_event);
+        if (!adapt_tick[0].event()) {
+            continue;
         }
 
-        // Update counters
-        m_slow_update_count++;
+        int current_mode = mode.read();
+        if (is_idle(current_mode)) {
+            continue;
+        }
+
+        // All loop updates that fell due since the last wake, in one batch
+        sc_core::sc_time now = sc_core::sc_time_stamp();
+        int n_fast = static_cast<int>((now - m_last_fast_time) / m_fast_period);
+        int n_slow = static_cast<int>((now - m_last_slow_time) / m_slow_period);
+        if (n_fast == 0 && n_slow == 0) {
+            continue;
+        }
+        ++m_wake_count;
+
+        if (n_fast > 0) {
+            m_last_fast_time += m_fast_period * static_cast<double>(n_fast);
+            fast_path_update(current_mode, n_fast);
+            if (m_freeze_flag) {
+                continue;
+            }
+        }
+        if (n_slow > 0) {
+            m_last_slow_time += m_slow_period * static_cast<double>(n_slow);
+            slow_path_update(current_mode, n_slow);
+        }
     }
 }
 
@@ -331,7 +465,7 @@ void AdaptionDe::save_snapshot() {
     snap.valid = true;
 
     if (m_snapshots.size() >= 100) {
-        m_snapshots.erase(m_snapshots.begin());
+        m_snapshots.pop_front();
     }
     m_snapshots.push_back(snap);
 }
@@ -371,9 +505,9 @@ double AdaptionDe::clamp(double val, double min_val, double max_val) const {
 void AdaptionDe::write_all_outputs() {
     vga_gain.write(m_current_gain);
 
-    ctle_zero.write(2e9);
-    ctle_pole.write(30e9);
-    ctle_dc_gain.write(1.5);
+    ctle_zero.write(m_ctle_zero);
+    ctle_pole.write(m_ctle_pole);
+    ctle_dc_gain.write(m_ctle_dc_gain);
 
     vref_cmd.write(m_current_vref_cmd);
 }
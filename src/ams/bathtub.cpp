@@ -0,0 +1,386 @@
+#include "ams/bathtub.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace serdes {
+
+namespace {
+
+double q_function(double x) {
+    return 0.5 * std::erfc(x / std::sqrt(2.0));
+}
+
+// Q^-1(p), p in (0, 1): rational approximation of the normal quantile
+// (Acklam) refined by one Halley step
+double inverse_q(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                               -2.759285104469687e+02, 1.383577518672690e+02,
+                               -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                               -1.556989798598866e+02, 6.680131188771972e+01,
+                               -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                               -2.400758277161838e+00, -2.549732539343734e+00,
+                               4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                               2.445134137142996e+00, 3.754408661907416e+00};
+    // x = Phi^-1(1 - p) = Q^-1(p)
+    double u = 1.0 - p;
+    double x;
+    if (u < 0.02425) {
+        double q = std::sqrt(-2.0 * std::log(u));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else if (p < 0.02425) {
+        double q = std::sqrt(-2.0 * std::log(p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else {
+        double q = u - 0.5;
+        double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+    // Halley step on Q(x) - p = 0
+    double e = q_function(x) - p;
+    double g = -e * std::sqrt(2.0 * M_PI) * std::exp(0.5 * x * x);
+    return x - g / (1.0 + 0.5 * x * g);
+}
+
+// Tail probability of the fitted model at depth d (v for the 1 level,
+// -v for the 0 level, with mu mirrored the same way)
+double model_tail(const TailFit& fit, double mu_d, double d) {
+    if (fit.sigma <= 0.0) {
+        return d > mu_d ? fit.rho : 0.0;
+    }
+    return fit.rho * q_function((mu_d - d) / fit.sigma);
+}
+
+// Cumulative hits of one level along the tail direction: tail[k] = hits
+// on the error side of edge k, edge k counted inwards from the far end
+struct LevelCdf {
+    std::vector<double> tail;
+    double total;
+};
+
+LevelCdf level_cdf(const EyeHistogram& hist, int phase, bool one) {
+    int nb = hist.get_num_bins();
+    LevelCdf cdf;
+    cdf.total = static_cast<double>(hist.total(phase, one));
+    cdf.tail.assign(nb + 1, 0.0);
+    for (int k = 1; k <= nb; ++k) {
+        int bin = one ? k - 1 : nb - k;
+        cdf.tail[k] = cdf.tail[k - 1] + static_cast<double>(hist.count(phase, one, bin));
+    }
+    return cdf;
+}
+
+// One phase: both levels' cumulative hits and fits
+class PhaseModel {
+public:
+    PhaseModel(const EyeHistogram& hist, int phase, const TailFit& fit_one,
+               const TailFit& fit_zero, int min_tail_count)
+        : m_one(level_cdf(hist, phase, true))
+        , m_zero(level_cdf(hist, phase, false))
+        , m_fit_one(fit_one)
+        , m_fit_zero(fit_zero)
+        , m_v_min(hist.get_v_min())
+        , m_v_max(hist.get_v_max())
+        , m_w(hist.get_bin_width())
+        , m_min_count(min_tail_count) {}
+
+    double ber(double v) const {
+        double n = m_one.total + m_zero.total;
+        double e1 = tail_prob(m_one, m_fit_one, m_fit_one.mu, v, (v - m_v_min) / m_w);
+        double e0 = tail_prob(m_zero, m_fit_zero, -m_fit_zero.mu, -v, (m_v_max - v) / m_w);
+        return (m_one.total * e1 + m_zero.total * e0) / n;
+    }
+
+private:
+    // pos: depth in bins from the far end of the window
+    double tail_prob(const LevelCdf& cdf, const TailFit& fit, double mu_d, double d,
+                     double pos) const {
+        if (cdf.total <= 0.0) return 0.0;
+        int nb = static_cast<int>(cdf.tail.size()) - 1;
+        double hits;
+        if (pos <= 0.0) {
+            hits = 0.0;
+        } else if (pos >= nb) {
+            hits = cdf.total;
+        } else {
+            int k = static_cast<int>(pos);
+            hits = cdf.tail[k] + (pos - k) * (cdf.tail[k + 1] - cdf.tail[k]);
+        }
+        if (hits >= m_min_count) {
+            return hits / cdf.total;
+        }
+        return model_tail(fit, mu_d, d);
+    }
+
+    LevelCdf m_one;
+    LevelCdf m_zero;
+    TailFit m_fit_one;
+    TailFit m_fit_zero;
+    double m_v_min;
+    double m_v_max;
+    double m_w;
+    int m_min_count;
+};
+
+} // anonymous namespace
+
+EyeHistogram::EyeHistogram(int num_phases, int num_bins, double v_min, double v_max)
+    : m_num_phases(num_phases)
+    , m_num_bins(num_bins)
+    , m_v_min(v_min)
+    , m_v_max(v_max)
+{
+    if (num_phases < 1) {
+        throw std::invalid_argument("EyeHistogram: num_phases must be >= 1");
+    }
+    if (num_bins < 2) {
+        throw std::invalid_argument("EyeHistogram: num_bins must be >= 2");
+    }
+    if (!(v_max > v_min)) {
+        throw std::invalid_argument("EyeHistogram: v_max must be above v_min");
+    }
+    m_counts.assign(2 * static_cast<size_t>(num_phases) * num_bins, 0);
+    m_totals.assign(2 * static_cast<size_t>(num_phases), 0);
+}
+
+void EyeHistogram::add(int phase, bool one, double v) {
+    int bin = static_cast<int>(std::floor((v - m_v_min) / get_bin_width()));
+    bin = std::max(0, std::min(m_num_bins - 1, bin));
+    ++m_counts[index(phase, one) + bin];
+    ++m_totals[2 * phase + (one ? 1 : 0)];
+}
+
+void EyeHistogram::clear() {
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    std::fill(m_totals.begin(), m_totals.end(), 0);
+}
+
+void validate_bathtub_params(const BathtubParams& params) {
+    if (!(params.ui > 0.0)) {
+        throw std::invalid_argument("Bathtub: ui must be positive");
+    }
+    if (params.num_bins < 16) {
+        throw std::invalid_argument("Bathtub: num_bins must be >= 16");
+    }
+    if (!(params.v_range > 0.0)) {
+        throw std::invalid_argument("Bathtub: v_range must be positive");
+    }
+    if (params.warmup_ui < 1) {
+        throw std::invalid_argument("Bathtub: warmup_ui must be >= 1");
+    }
+    if (params.reference != "prbs" && params.reference != "center") {
+        throw std::invalid_argument("Bathtub: reference must be 'prbs' or 'center'");
+    }
+    if (params.decision_latency < 0) {
+        throw std::invalid_argument("Bathtub: decision_latency must be >= 0");
+    }
+    if (params.tail_model != "dual_dirac" && params.tail_model != "gaussian") {
+        throw std::invalid_argument("Bathtub: tail_model must be 'dual_dirac' or 'gaussian'");
+    }
+    if (!(params.tail_fraction > 0.0 && params.tail_fraction <= 0.5)) {
+        throw std::invalid_argument("Bathtub: tail_fraction must be in (0, 0.5]");
+    }
+    if (params.min_tail_count < 1) {
+        throw std::invalid_argument("Bathtub: min_tail_count must be >= 1");
+    }
+    for (double t : params.target_bers) {
+        if (!(t > 0.0 && t < 0.5)) {
+            throw std::invalid_argument("Bathtub: target_bers must be in (0, 0.5)");
+        }
+    }
+}
+
+TailFit fit_level_tail(const EyeHistogram& hist, int phase, bool one, const BathtubParams& params) {
+    TailFit fit = {1.0, 0.0, 0.0, 0};
+    LevelCdf cdf = level_cdf(hist, phase, one);
+    if (cdf.total <= 0.0) {
+        return fit;
+    }
+    int nb = hist.get_num_bins();
+    double w = hist.get_bin_width();
+
+    // Points (depth, tail probability) inside the fit window
+    std::vector<double> xs, ts;
+    for (int k = 1; k < nb; ++k) {
+        double t = cdf.tail[k] / cdf.total;
+        if (cdf.tail[k] < params.min_tail_count) continue;
+        if (t > params.tail_fraction) break;
+        xs.push_back(one ? hist.get_v_min() + k * w : -(hist.get_v_max() - k * w));
+        ts.push_back(t);
+    }
+
+    if (xs.size() >= 3) {
+        double t_max = ts.back();
+        double rho_min = params.tail_model == "gaussian" ? 1.0 : std::min(1.0, 2.0 * t_max);
+        const int num_rho = rho_min < 1.0 ? 24 : 1;
+        double best_sse = std::numeric_limits<double>::infinity();
+        std::vector<double> ys(xs.size()), ws(xs.size());
+        for (int r = 0; r < num_rho; ++r) {
+            double rho = num_rho == 1 ? 1.0
+                                      : rho_min * std::pow(1.0 / rho_min, static_cast<double>(r) / (num_rho - 1));
+            // Weighted by the inverse variance of y: var(T) / (rho * phi(y))^2
+            double sw = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+            for (size_t i = 0; i < xs.size(); ++i) {
+                ys[i] = inverse_q(ts[i] / rho);
+                double phi = rho * std::exp(-0.5 * ys[i] * ys[i]);
+                ws[i] = phi * phi / (ts[i] * (1.0 - ts[i]));
+                sw += ws[i];
+                sx += ws[i] * xs[i];
+                sy += ws[i] * ys[i];
+                sxx += ws[i] * xs[i] * xs[i];
+                sxy += ws[i] * xs[i] * ys[i];
+            }
+            double den = sw * sxx - sx * sx;
+            if (den <= 0.0) continue;
+            double slope = (sw * sxy - sx * sy) / den;
+            double icpt = (sy - slope * sx) / sw;
+            if (!(slope < 0.0)) continue;
+            double sse = 0.0;
+            for (size_t i = 0; i < xs.size(); ++i) {
+                double e = ys[i] - (icpt + slope * xs[i]);
+                sse += ws[i] * e * e;
+            }
+            if (sse < best_sse) {
+                best_sse = sse;
+                // y = (mu_d - d) / sigma
+                fit.rho = rho;
+                fit.sigma = -1.0 / slope;
+                fit.mu = (one ? 1.0 : -1.0) * icpt * fit.sigma;
+                fit.num_points = static_cast<int>(xs.size());
+            }
+        }
+        if (fit.num_points > 0) {
+            return fit;
+        }
+    }
+
+    // Too few tail hits: Gaussian with the level's moments
+    double s1 = 0.0, s2 = 0.0;
+    for (int b = 0; b < nb; ++b) {
+        double v = hist.get_v_min() + (b + 0.5) * w;
+        double c = static_cast<double>(hist.count(phase, one, b));
+        s1 += c * v;
+        s2 += c * v * v;
+    }
+    fit.mu = s1 / cdf.total;
+    fit.sigma = std::sqrt(std::max(s2 / cdf.total - fit.mu * fit.mu, w * w / 12.0));
+    return fit;
+}
+
+double extrapolated_ber(const EyeHistogram& hist, int phase, double v,
+                        const TailFit& fit_one, const TailFit& fit_zero,
+                        const BathtubParams& params) {
+    if (hist.total(phase, true) + hist.total(phase, false) == 0) {
+        throw std::invalid_argument("Bathtub: no samples at this phase");
+    }
+    return PhaseModel(hist, phase, fit_one, fit_zero, params.min_tail_count).ber(v);
+}
+
+BathtubResult compute_bathtub(const EyeHistogram& hist, const BathtubParams& params) {
+    validate_bathtub_params(params);
+    const int np = hist.get_num_phases();
+    const int nb = hist.get_num_bins();
+    for (int p = 0; p < np; ++p) {
+        if (hist.total(p, true) + hist.total(p, false) == 0) {
+            throw std::invalid_argument("Bathtub: histogram has a phase without samples");
+        }
+    }
+
+    BathtubResult res;
+    res.num_phases = np;
+    res.phase.resize(np);
+    res.fit_one.resize(np);
+    res.fit_zero.resize(np);
+    res.ber_threshold.resize(np);
+    res.target_bers = params.target_bers;
+
+    std::vector<PhaseModel> models;
+    models.reserve(np);
+    for (int p = 0; p < np; ++p) {
+        res.phase[p] = static_cast<double>(p - np / 2) / np;
+        res.fit_one[p] = fit_level_tail(hist, p, true, params);
+        res.fit_zero[p] = fit_level_tail(hist, p, false, params);
+        models.emplace_back(hist, p, res.fit_one[p], res.fit_zero[p], params.min_tail_count);
+        res.ber_threshold[p] = models[p].ber(params.threshold);
+    }
+
+    // Best phase, ties to the one nearest the center
+    res.best_index = np / 2;
+    for (int off = 1; off <= np / 2; ++off) {
+        for (int p : {np / 2 - off, np / 2 + off}) {
+            if (p >= 0 && p < np && res.ber_threshold[p] < res.ber_threshold[res.best_index]) {
+                res.best_index = p;
+            }
+        }
+    }
+    res.best_phase = res.phase[res.best_index];
+
+    double w = hist.get_bin_width();
+    res.voltage.resize(nb);
+    res.ber_vertical.resize(nb);
+    for (int b = 0; b < nb; ++b) {
+        res.voltage[b] = hist.get_v_min() + (b + 0.5) * w;
+        res.ber_vertical[b] = models[res.best_index].ber(res.voltage[b]);
+    }
+
+    // Contours: walk out from the threshold in half bins, then bisect
+    const double step = 0.5 * w;
+    auto crossing = [&](const PhaseModel& m, double target, double dir, double limit) {
+        double inside = params.threshold;
+        double v = inside + dir * step;
+        while ((limit - v) * dir > 0.0) {
+            if (m.ber(v) >= target) {
+                for (int i = 0; i < 40; ++i) {
+                    double mid = 0.5 * (inside + v);
+                    (m.ber(mid) >= target ? v : inside) = mid;
+                }
+                return 0.5 * (inside + v);
+            }
+            inside = v;
+            v += dir * step;
+        }
+        return limit;
+    };
+
+    auto log_ber = [](double b) { return std::log10(std::max(b, 1e-300)); };
+    size_t nt = params.target_bers.size();
+    res.contour_upper.assign(nt, std::vector<double>(np, 0.0));
+    res.contour_lower.assign(nt, std::vector<double>(np, 0.0));
+    res.eye_height.assign(nt, 0.0);
+    res.eye_width.assign(nt, 0.0);
+    for (size_t t = 0; t < nt; ++t) {
+        double target = params.target_bers[t];
+        for (int p = 0; p < np; ++p) {
+            if (res.ber_threshold[p] >= target) continue;
+            res.contour_upper[t][p] = crossing(models[p], target, 1.0, hist.get_v_max());
+            res.contour_lower[t][p] = crossing(models[p], target, -1.0, hist.get_v_min());
+            res.eye_height[t] = std::max(res.eye_height[t],
+                                         res.contour_upper[t][p] - res.contour_lower[t][p]);
+        }
+
+        int best = res.best_index;
+        if (res.ber_threshold[best] >= target) continue;
+        int lo = best, hi = best;
+        while (lo > 0 && res.ber_threshold[lo - 1] < target) --lo;
+        while (hi < np - 1 && res.ber_threshold[hi + 1] < target) ++hi;
+        // Fraction of a phase step to the crossing on each side (half a step at the window edge)
+        auto edge = [&](int open, int closed) {
+            double a = log_ber(res.ber_threshold[open]);
+            double b = log_ber(res.ber_threshold[closed]);
+            return b > a ? (log_ber(target) - a) / (b - a) : 0.5;
+        };
+        double f_lo = lo > 0 ? edge(lo, lo - 1) : 0.5;
+        double f_hi = hi < np - 1 ? edge(hi, hi + 1) : 0.5;
+        res.eye_width[t] = (hi - lo + f_lo + f_hi) / np;
+    }
+    return res;
+}
+
+} // namespace serdes
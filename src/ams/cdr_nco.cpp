@@ -0,0 +1,75 @@
+#include "ams/cdr_nco.h"
+#include <cmath>
+
+namespace serdes {
+
+namespace {
+
+const long double PHASE_SCALE = 18446744073709551616.0L;   // 2^64 units per UI
+
+// Fraction of a UI (wrapped into [0, 1)) in phase units
+std::uint64_t ui_fraction_to_units(long double x) {
+    long double f = x - std::floor(x);
+    long double v = f * PHASE_SCALE + 0.5L;
+    if (v >= PHASE_SCALE) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(v);
+}
+
+} // namespace
+
+const std::uint64_t CdrPhaseNco::EDGE_POINT;
+const std::uint64_t CdrPhaseNco::DATA_POINT;
+
+CdrPhaseNco::CdrPhaseNco()
+    : m_ui(0.0)
+    , m_inc(0)
+    , m_code_step(0)
+    , m_acc(0)
+    , m_code(0)
+    , m_offset(0)
+    , m_last(0)
+    , m_prev(0)
+{
+}
+
+void CdrPhaseNco::configure(double ui, double timestep, double resolution) {
+    m_ui = ui;
+    m_inc = ui_fraction_to_units(static_cast<long double>(timestep) / ui);
+    m_code_step = ui_fraction_to_units(static_cast<long double>(resolution) / ui);
+    set_code(m_code);
+}
+
+void CdrPhaseNco::reset() {
+    m_acc = 0;
+    set_code(0);
+    m_last = 0;
+    m_prev = 0;
+}
+
+void CdrPhaseNco::set_code(std::int64_t code) {
+    m_code = code;
+    // Two's complement wrap gives the signed offset modulo one UI
+    m_offset = static_cast<std::uint64_t>(code) * m_code_step;
+}
+
+void CdrPhaseNco::save_state(StateCheckpoint& cp, const std::string& key) const {
+    cp.put_uint(key + ".acc", m_acc);
+    cp.put_int(key + ".code", m_code);
+    cp.put_uint(key + ".last", m_last);
+    cp.put_uint(key + ".prev", m_prev);
+}
+
+void CdrPhaseNco::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    m_acc = cp.get_uint(key + ".acc");
+    set_code(cp.get_int(key + ".code"));
+    m_last = cp.get_uint(key + ".last");
+    m_prev = cp.get_uint(key + ".prev");
+}
+
+double CdrPhaseNco::to_seconds(std::uint64_t units) const {
+    return static_cast<double>(static_cast<long double>(units) / PHASE_SCALE * m_ui);
+}
+
+} // namespace serdes
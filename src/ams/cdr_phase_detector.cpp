@@ -0,0 +1,92 @@
+#include "ams/cdr_phase_detector.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace serdes {
+
+CdrPhaseDetector::CdrPhaseDetector()
+    : m_type(PhaseDetectorType::BANG_BANG)
+    , m_threshold(0.5)
+    , m_prev_data(0.0)
+{
+    reset();
+}
+
+void CdrPhaseDetector::configure(PhaseDetectorType type, double threshold) {
+    if (type != PhaseDetectorType::BANG_BANG &&
+        type != PhaseDetectorType::HOGGE &&
+        type != PhaseDetectorType::MUELLER_MULLER) {
+        throw std::invalid_argument(
+            "CDR: phase detector must be BANG_BANG, HOGGE or MUELLER_MULLER, got " +
+            PhaseDetectorTypeToString(type));
+    }
+    m_type = type;
+    m_threshold = threshold;
+    reset();
+}
+
+void CdrPhaseDetector::reset() {
+    // Previous decision starts at 0 (below threshold), as in the original BBPD
+    m_prev_data = m_threshold - 1.0;
+    if (m_type == PhaseDetectorType::MUELLER_MULLER) {
+        m_prev_data = m_threshold;
+    }
+}
+
+void CdrPhaseDetector::save_state(StateCheckpoint& cp, const std::string& key) const {
+    cp.put_real(key + ".prev_data", m_prev_data);
+}
+
+void CdrPhaseDetector::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    m_prev_data = cp.get_real(key + ".prev_data");
+}
+
+double CdrPhaseDetector::detect(double edge, double data) {
+    double y = data - m_threshold;
+    double y_prev = m_prev_data - m_threshold;
+    bool bit = y > 0.0;
+    bool prev_bit = y_prev > 0.0;
+    m_prev_data = data;
+
+    switch (m_type) {
+        case PhaseDetectorType::BANG_BANG: {
+            if (bit == prev_bit) {
+                return 0.0;             // No transition, no information
+            }
+            // Edge sample already shows the new value -> sampled after the
+            // transition -> late
+            bool edge_bit = (edge - m_threshold) > 0.0;
+            return (edge_bit == bit) ? -1.0 : +1.0;
+        }
+
+        case PhaseDetectorType::HOGGE: {
+            if (bit == prev_bit) {
+                return 0.0;
+            }
+            double amp = 0.5 * (std::abs(y) + std::abs(y_prev));
+            if (amp <= 0.0) {
+                return 0.0;
+            }
+            double s = bit ? 1.0 : -1.0;
+            double e = -(edge - m_threshold) * s / amp;
+            return std::max(-1.0, std::min(1.0, e));
+        }
+
+        case PhaseDetectorType::MUELLER_MULLER: {
+            double d = bit ? 1.0 : -1.0;
+            double d_prev = prev_bit ? 1.0 : -1.0;
+            if (y_prev == 0.0) {
+                return 0.0;             // No previous sample yet
+            }
+            // E[y_k d_{k-1} - y_{k-1} d_k] = h(+1) - h(-1): negative when late
+            double e = y * d_prev - y_prev * d;
+            return (e > 0.0) ? 1.0 : ((e < 0.0) ? -1.0 : 0.0);
+        }
+
+        default:
+            return 0.0;
+    }
+}
+
+} // namespace serdes
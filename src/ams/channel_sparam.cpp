@@ -25,6 +25,10 @@ ChannelSParamTdf::ChannelSParamTdf(sc_core::sc_module_name nm, const ChannelPara
     , m_filter_state(0.0)
     , m_filter_state_n(0.0)
     , m_alpha(0.3)
+    , m_ss_started(false)
+    , m_ss_has_e(false)
+    , m_precision_check_left(0)
+    , m_xtalk_out(0.0)
     , m_config_loaded(false)
     , m_initialized(false)
 {
@@ -46,6 +50,10 @@ ChannelSParamTdf::ChannelSParamTdf(sc_core::sc_module_name nm,
     , m_filter_state(0.0)
     , m_filter_state_n(0.0)
     , m_alpha(0.3)
+    , m_ss_started(false)
+    , m_ss_has_e(false)
+    , m_precision_check_left(0)
+    , m_xtalk_out(0.0)
     , m_config_loaded(false)
     , m_initialized(false)
 {
@@ -115,10 +123,30 @@ void ChannelSParamTdf::initialize() {
             break;
     }
     
+    if (m_ext_params.method == ChannelMethod::STATE_SPACE &&
+        m_ext_params.precision != ChannelPrecision::DOUBLE) {
+        init_precision_kernel();
+    }
+    
+    m_xtalk_share.resize(out.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        m_xtalk_share[i] = crosstalk_output_share(static_cast<int>(out.size()), static_cast<int>(i));
+    }
+    if (m_params.crosstalk) {
+        init_crosstalk();
+    }
+    
+    if (!m_restore.empty()) {
+        apply_restore();
+    }
+    
     m_initialized = true;
 }
 
 void ChannelSParamTdf::processing() {
+    // Aggressor superposition is computed once and added to the victim output(s)
+    m_xtalk_out = m_aggressors.empty() ? 0.0 : process_crosstalk();
+    
     switch (m_ext_params.method) {
         case ChannelMethod::SIMPLE: {
             // Support both SISO and differential (2-port) modes
@@ -128,7 +156,7 @@ void ChannelSParamTdf::processing() {
                 // SISO mode
                 double x_in = in[0].read();
                 m_filter_state = m_alpha * x_in + (1.0 - m_alpha) * m_filter_state;
-                out[0].write(attenuation_linear * m_filter_state);
+                out[0].write(attenuation_linear * m_filter_state + m_xtalk_share[0] * m_xtalk_out);
             } else {
                 // Differential mode: process P and N with independent states
                 double x_p = in[0].read();
@@ -137,8 +165,9 @@ void ChannelSParamTdf::processing() {
                 m_filter_state = m_alpha * x_p + (1.0 - m_alpha) * m_filter_state;
                 m_filter_state_n = m_alpha * x_n + (1.0 - m_alpha) * m_filter_state_n;
                 
-                out[0].write(attenuation_linear * m_filter_state);
-                out[1].write(attenuation_linear * m_filter_state_n);
+                // Crosstalk is a differential disturbance: split evenly on P/N
+                out[0].write(attenuation_linear * m_filter_state + m_xtalk_share[0] * m_xtalk_out);
+                out[1].write(attenuation_linear * m_filter_state_n + m_xtalk_share[1] * m_xtalk_out);
             }
             break;
         }
@@ -218,6 +247,43 @@ bool ChannelSParamTdf::parse_json_config(const std::string& json_content) {
             m_ext_params.method = ChannelMethod::SIMPLE;
         }
         
+        // Optional kernel precision policy: "double", "float" or "mixed"
+        if (config.contains("precision")) {
+            std::string prec = config["precision"].get<std::string>();
+            std::transform(prec.begin(), prec.end(), prec.begin(), ::tolower);
+            if (prec == "float") {
+                m_ext_params.precision = ChannelPrecision::FLOAT;
+            } else if (prec == "mixed") {
+                m_ext_params.precision = ChannelPrecision::MIXED;
+            } else {
+                m_ext_params.precision = ChannelPrecision::DOUBLE;
+            }
+        }
+        if (config.contains("apply_e_matrix")) {
+            m_ext_params.apply_e_matrix = config["apply_e_matrix"].get<bool>();
+        }
+        
+        // Optional crosstalk aggressors (pulse responses from Python preprocessing)
+        if (config.contains("crosstalk")) {
+            const auto& xt = config["crosstalk"];
+            m_params.xtalk.ui = xt.value("ui", m_params.xtalk.ui);
+            m_params.xtalk.aggressors.clear();
+            for (const auto& a : xt.value("aggressors", json::array())) {
+                CrosstalkAggressorParams agg;
+                agg.type = a.value("type", agg.type);
+                agg.pulse_dt = a.value("dt", agg.pulse_dt);
+                agg.prbs = StringToPRBSType(a.value("prbs", std::string("PRBS31")));
+                agg.seed = a.value("seed", agg.seed);
+                agg.amplitude = a.value("amplitude", agg.amplitude);
+                agg.skew_ui = a.value("skew_ui", agg.skew_ui);
+                for (const auto& v : a.value("pulse_response", json::array())) {
+                    agg.pulse_response.push_back(v.get<double>());
+                }
+                m_params.xtalk.aggressors.push_back(agg);
+            }
+            m_params.crosstalk = xt.value("enable", true);
+        }
+        
         std::cout << "[DEBUG] ChannelSParamTdf: Configuration loaded successfully (method=" 
                   << static_cast<int>(m_ext_params.method) << ")" << std::endl;
         m_config_loaded = true;
@@ -511,6 +577,19 @@ void ChannelSParamTdf::extract_active_matrices() {
     for (int i = 1; i <= n_states; ++i) {
         m_ss_state(i) = 0.0;
     }
+    m_ss_u_prev.resize(n_active_in);
+    for (int j = 1; j <= n_active_in; ++j) {
+        m_ss_u_prev(j) = 0.0;
+    }
+    m_ss_started = false;
+    m_ss_has_e = false;
+    if (m_ext_params.apply_e_matrix) {
+        for (int i = 1; i <= n_active_out; ++i) {
+            for (int j = 1; j <= n_active_in; ++j) {
+                m_ss_has_e = m_ss_has_e || m_active_ss.E(i, j) != 0.0;
+            }
+        }
+    }
     
     std::cout << "[DEBUG] ChannelSParamTdf: Active matrices extracted" << std::endl;
     std::cout << "[DEBUG]   B: " << n_states << "x" << n_active_in << std::endl;
@@ -527,18 +606,240 @@ void ChannelSParamTdf::process_state_space_mimo() {
         u(i + 1) = in[i].read();
     }
     
-    // State-space computation using sca_ss
-    // y = C*x + D*u + E*du/dt
+    // Reduced-precision policies step the discretized kernel directly
+    bool reduced = m_ext_params.precision != ChannelPrecision::DOUBLE;
+    if (reduced) {
+        for (int i = 0; i < n_in; ++i) {
+            m_kernel_u[i] = u(i + 1);
+        }
+    }
+    
+    // sca_ss starts a fresh state with the first input as the previous one;
+    // the E term and the reduced kernels follow the same convention
+    if (!m_ss_started) {
+        m_ss_u_prev = u;
+        if (reduced) {
+            m_float_kernel.prime(m_kernel_u.data());
+            m_mixed_kernel.prime(m_kernel_u.data());
+        }
+        m_ss_started = true;
+    }
+    
+    if (reduced) {
+        if (m_ext_params.precision == ChannelPrecision::FLOAT) {
+            m_float_kernel.step(m_kernel_u.data(), m_kernel_y.data());
+        } else {
+            m_mixed_kernel.step(m_kernel_u.data(), m_kernel_y.data());
+        }
+        if (m_precision_check_left == 0) {
+            for (int i = 0; i < n_out; ++i) {
+                out[i].write(m_kernel_y[i] + m_xtalk_share[i] * m_xtalk_out);
+            }
+            return;
+        }
+    }
+    
+    // State-space computation using sca_ss: y = C*x + D*u, plus E*du/dt
+    // (backward difference over one step) with apply_e_matrix
     sca_util::sca_vector<double> y = m_ss_filter(
         m_active_ss.A, m_active_ss.B, m_active_ss.C,
         m_active_ss.D, m_ss_state, u, get_timestep());
+    if (m_ss_has_e) {
+        double dt = get_timestep().to_seconds();
+        for (int i = 0; i < n_out; ++i) {
+            for (int j = 0; j < n_in; ++j) {
+                y(i + 1) += m_active_ss.E(i + 1, j + 1) * (u(j + 1) - m_ss_u_prev(j + 1)) / dt;
+            }
+        }
+        m_ss_u_prev = u;
+    }
+    
+    // Accuracy check: the reduced kernel against this output
+    if (m_precision_check_left > 0) {
+        std::vector<double> y_ref(n_out);
+        for (int i = 0; i < n_out; ++i) {
+            y_ref[i] = y(i + 1);
+        }
+        m_precision_report.add(m_kernel_y.data(), y_ref.data(), n_out);
+        if (--m_precision_check_left == 0) {
+            finish_precision_check();
+        }
+    }
     
-    // Write outputs
+    // Write outputs (victim lane is the first active output, or the P/N
+    // pair when there are two; see crosstalk_output_share())
     for (int i = 0; i < n_out; ++i) {
-        out[i].write(y(i + 1));
+        out[i].write(y(i + 1) + m_xtalk_share[i] * m_xtalk_out);
+    }
+}
+
+// ============================================================================
+// Reduced-Precision Kernel
+// ============================================================================
+
+void ChannelSParamTdf::init_precision_kernel() {
+    int n = m_active_ss.n_states;
+    int n_in = m_active_ss.n_inputs;
+    int n_out = m_active_ss.n_outputs;
+    
+    // Flatten active matrices (sca_matrix is 1-based) to row-major vectors;
+    // E stays zero unless the sca_ss path applies it
+    std::vector<double> A(n * n), B(n * n_in), C(n_out * n), D(n_out * n_in), E(n_out * n_in);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) A[i * n + j] = m_active_ss.A(i + 1, j + 1);
+        for (int j = 0; j < n_in; ++j) B[i * n_in + j] = m_active_ss.B(i + 1, j + 1);
+    }
+    for (int i = 0; i < n_out; ++i) {
+        for (int j = 0; j < n; ++j) C[i * n + j] = m_active_ss.C(i + 1, j + 1);
+        for (int j = 0; j < n_in; ++j) D[i * n_in + j] = m_active_ss.D(i + 1, j + 1);
+        if (m_ss_has_e) {
+            for (int j = 0; j < n_in; ++j) E[i * n_in + j] = m_active_ss.E(i + 1, j + 1);
+        }
+    }
+    
+    double dt = get_timestep().to_seconds();
+    if (n == 0 || !discretize_trapezoidal(A, B, C, D, E, n, n_in, n_out, dt, m_discrete_ss)) {
+        std::cerr << "ChannelSParamTdf: Cannot discretize state-space, using double path" << std::endl;
+        m_ext_params.precision = ChannelPrecision::DOUBLE;
+        return;
     }
+    
+    m_float_kernel.configure(m_discrete_ss);
+    m_mixed_kernel.configure(m_discrete_ss);
+    m_kernel_u.assign(n_in, 0.0);
+    m_kernel_y.assign(n_out, 0.0);
+    
+    // The check runs in process_state_space_mimo() on the live input
+    m_precision_report = PrecisionReport();
+    m_precision_check_left = m_ext_params.precision_check ?
+        std::max(0, m_ext_params.precision_check_samples) : 0;
 }
 
+void ChannelSParamTdf::finish_precision_check() {
+    m_precision_report.finish(m_active_ss.n_outputs);
+    std::cout << "[DEBUG] ChannelSParamTdf: Precision check: max_err=" 
+              << m_precision_report.max_abs_error
+              << ", rel_err=" << m_precision_report.rel_error << std::endl;
+    if (m_precision_report.rel_error > m_ext_params.precision_tolerance) {
+        std::cerr << "ChannelSParamTdf: Reduced precision error " << m_precision_report.rel_error
+                  << " exceeds tolerance " << m_ext_params.precision_tolerance
+                  << ", using double path" << std::endl;
+        m_ext_params.precision = ChannelPrecision::DOUBLE;
+    }
+}
+
+// ============================================================================
+// Crosstalk Aggressor Superposition
+// ============================================================================
+
+void ChannelSParamTdf::init_crosstalk() {
+    m_aggressors.clear();
+    double dt = get_timestep().to_seconds();
+    
+    try {
+        for (const auto& agg : m_params.xtalk.aggressors) {
+            m_aggressors.emplace_back(agg, m_params.xtalk.ui);
+            m_aggressors.back().initialize(dt);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ChannelSParamTdf: Crosstalk disabled: " << e.what() << std::endl;
+        m_aggressors.clear();
+        return;
+    }
+    
+    std::cout << "[DEBUG] ChannelSParamTdf: Crosstalk enabled with " 
+              << m_aggressors.size() << " aggressor(s)" << std::endl;
+}
+
+double ChannelSParamTdf::process_crosstalk() {
+    double sum = 0.0;
+    for (auto& agg : m_aggressors) {
+        sum += agg.process();
+    }
+    return sum;
+}
+
+
+// ============================================================================
+// Checkpoint
+// ============================================================================
+
+void ChannelSParamTdf::save_state(StateCheckpoint& cp) const {
+    const std::string key = std::string(name()) + ".";
+    cp.put_real(key + "filter_state", m_filter_state);
+    cp.put_real(key + "filter_state_n", m_filter_state_n);
+    cp.put_sca_vector(key + "ss_state", m_ss_state);
+    cp.put_sca_vector(key + "ss_u_prev", m_ss_u_prev);
+    cp.put_int(key + "precision", static_cast<std::int64_t>(m_ext_params.precision));
+    cp.put_int(key + "precision_check_left", m_precision_check_left);
+    cp.put_real(key + "precision_check", {m_precision_report.max_abs_error,
+                                          m_precision_report.peak_output,
+                                          m_precision_report.sq_sum,
+                                          static_cast<double>(m_precision_report.n_samples)});
+    if (m_ext_params.method == ChannelMethod::STATE_SPACE &&
+        m_ext_params.precision == ChannelPrecision::FLOAT) {
+        m_float_kernel.save_state(cp, key + "float_kernel");
+    } else if (m_ext_params.method == ChannelMethod::STATE_SPACE &&
+               m_ext_params.precision == ChannelPrecision::MIXED) {
+        m_mixed_kernel.save_state(cp, key + "mixed_kernel");
+    }
+    for (size_t k = 0; k < m_aggressors.size(); ++k) {
+        m_aggressors[k].save_state(cp, key + "xtalk" + std::to_string(k));
+    }
+}
+
+void ChannelSParamTdf::restore_state(const StateCheckpoint& cp) {
+    m_restore = cp.subset(std::string(name()) + ".");
+}
+
+void ChannelSParamTdf::apply_restore() {
+    const std::string key = std::string(name()) + ".";
+    m_filter_state = m_restore.get_real(key + "filter_state");
+    m_filter_state_n = m_restore.get_real(key + "filter_state_n");
+    sca_util::sca_vector<double> ss_state;
+    m_restore.get_sca_vector(key + "ss_state", ss_state);
+    if (ss_state.length() != m_ss_state.length()) {
+        throw std::invalid_argument("ChannelSParamTdf: checkpoint state count mismatch");
+    }
+    m_ss_state = ss_state;
+    sca_util::sca_vector<double> ss_u_prev;
+    m_restore.get_sca_vector(key + "ss_u_prev", ss_u_prev);
+    if (ss_u_prev.length() != m_ss_u_prev.length()) {
+        throw std::invalid_argument("ChannelSParamTdf: checkpoint input count mismatch");
+    }
+    m_ss_u_prev = ss_u_prev;
+    m_ss_started = true;
+    
+    // A saved run that fell back to DOUBLE stays there; the check resumes
+    // where it stopped
+    if (m_restore.get_int(key + "precision") == static_cast<std::int64_t>(ChannelPrecision::DOUBLE)) {
+        m_ext_params.precision = ChannelPrecision::DOUBLE;
+    }
+    m_precision_check_left = static_cast<int>(m_restore.get_int(key + "precision_check_left"));
+    const std::vector<double>& check = m_restore.get_real_vector(key + "precision_check");
+    if (check.size() != 4) {
+        throw std::invalid_argument("ChannelSParamTdf: checkpoint precision check malformed");
+    }
+    m_precision_report = PrecisionReport();
+    m_precision_report.max_abs_error = check[0];
+    m_precision_report.peak_output = check[1];
+    m_precision_report.sq_sum = check[2];
+    m_precision_report.n_samples = static_cast<int>(check[3]);
+    if (m_precision_check_left == 0 && m_precision_report.n_samples > 0) {
+        m_precision_report.finish(m_active_ss.n_outputs);
+    }
+    if (m_ext_params.method == ChannelMethod::STATE_SPACE &&
+        m_ext_params.precision == ChannelPrecision::FLOAT) {
+        m_float_kernel.restore_state(m_restore, key + "float_kernel");
+    } else if (m_ext_params.method == ChannelMethod::STATE_SPACE &&
+               m_ext_params.precision == ChannelPrecision::MIXED) {
+        m_mixed_kernel.restore_state(m_restore, key + "mixed_kernel");
+    }
+    for (size_t k = 0; k < m_aggressors.size(); ++k) {
+        m_aggressors[k].restore_state(m_restore, key + "xtalk" + std::to_string(k));
+    }
+    m_restore.clear();
+}
 
 // ============================================================================
 // Signal Processing Methods
@@ -612,6 +913,46 @@ double ChannelSParamTdf::get_dc_gain() const {
     }
 }
 
+std::vector<std::complex<double>> ChannelSParamTdf::get_frequency_response(
+    const std::vector<double>& freqs, int output, int input) const {
+    if (m_ext_params.method == ChannelMethod::SIMPLE) {
+        if (output < 0 || output >= static_cast<int>(out.size()) ||
+            input < 0 || input >= static_cast<int>(in.size())) {
+            throw std::invalid_argument("ChannelSParamTdf: port index out of range");
+        }
+        std::vector<std::complex<double>> h(freqs.size());
+        if (output != input) {
+            return h;  // P and N are filtered independently
+        }
+        double attenuation_linear = std::pow(10.0, -m_params.attenuation_db / 20.0);
+        for (size_t i = 0; i < freqs.size(); ++i) {
+            h[i] = attenuation_linear / std::complex<double>(1.0, freqs[i] / m_params.bandwidth_hz);
+        }
+        return h;
+    }
+    
+    // Flatten active matrices (sca_matrix is 1-based) to row-major vectors
+    int n = m_active_ss.n_states;
+    int n_in = m_active_ss.n_inputs;
+    int n_out = m_active_ss.n_outputs;
+    std::vector<double> A(n * n), B(n * n_in), C(n_out * n), D(n_out * n_in);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) A[i * n + j] = m_active_ss.A(i + 1, j + 1);
+        for (int j = 0; j < n_in; ++j) B[i * n_in + j] = m_active_ss.B(i + 1, j + 1);
+    }
+    for (int i = 0; i < n_out; ++i) {
+        for (int j = 0; j < n; ++j) C[i * n + j] = m_active_ss.C(i + 1, j + 1);
+        for (int j = 0; j < n_in; ++j) D[i * n_in + j] = m_active_ss.D(i + 1, j + 1);
+    }
+    std::vector<std::complex<double>> h =
+        state_space_frequency_response(A, B, C, D, n, n_in, n_out, input, output, freqs);
+    double e = m_ext_params.apply_e_matrix ? m_active_ss.E(output + 1, input + 1) : 0.0;
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        h[i] += std::complex<double>(0.0, 2.0 * M_PI * freqs[i] * e);
+    }
+    return h;
+}
+
 // ============================================================================
 // LU Decomposition Helpers
 // ============================================================================
@@ -20,13 +20,24 @@ namespace serdes {
 ClockGenerationTdf::ClockGenerationTdf(sc_core::sc_module_name nm, const ClockParams& params)
     : sca_tdf::sca_module(nm)
     , clk_phase("clk_phase")
+    , clk_edge("clk_edge")
     , m_params(params)
     , m_phase(0.0)
     , m_frequency(params.frequency)
     , m_phase_increment(0.0)
+    , m_timestep(0.0)
+    , m_edge_time(-1.0)
 {
     // Validate parameters during construction
     validate_params();
+    
+    if (m_params.edge_output) {
+        clk_edge.init(1);
+    }
+    
+    if (m_params.type == ClockType::PLL) {
+        m_pll.configure(m_params.pll, m_frequency, name());
+    }
 }
 
 // ============================================================================
@@ -45,6 +56,11 @@ void ClockGenerationTdf::validate_params()
         throw std::invalid_argument("ClockGenerator: frequency must be between 1Hz and 1THz");
     }
     
+    // Validate samples per period (0 = inherit the cluster timestep)
+    if (m_params.samples_per_period < 0) {
+        throw std::invalid_argument("ClockGenerator: samples_per_period must be non-negative");
+    }
+    
     // Validate PLL parameters if PLL mode is selected
     if (m_params.type == ClockType::PLL) {
         // Validate charge pump current
@@ -83,15 +99,18 @@ void ClockGenerationTdf::set_attributes()
 {
     // Set port rate
     clk_phase.set_rate(1);
+    if (clk_edge.size() > 0) {
+        clk_edge[0].set_rate(1);
+    }
     
     // Set adaptive time step based on clock frequency
-    // Time step = 1 / (frequency * 100) ensures 100 samples per clock period
-    double timestep = 1.0 / (m_frequency * 100.0);
-    clk_phase.set_timestep(timestep, sc_core::SC_SEC);
-    
-    // Pre-calculate phase increment for efficiency
-    // delta_phi = 2 * pi * f * delta_t = 2 * pi / 100
-    m_phase_increment = 2.0 * M_PI / 100.0;
+    // Time step = 1 / (frequency * N) gives N samples per clock period;
+    // N = 0 leaves the timestep to the cluster so the clock can share the
+    // data-path rate without resampling
+    if (m_params.samples_per_period > 0) {
+        double timestep = 1.0 / (m_frequency * m_params.samples_per_period);
+        clk_phase.set_timestep(timestep, sc_core::SC_SEC);
+    }
 }
 
 // ============================================================================
@@ -100,8 +119,16 @@ void ClockGenerationTdf::set_attributes()
 
 void ClockGenerationTdf::initialize()
 {
-    // Reset phase accumulator
+    // Reset phase accumulator; phase 0 at t = 0 is a rising edge
     m_phase = 0.0;
+    m_edge_time = 0.0;
+    
+    // delta_phi = 2 * pi * f * delta_t from the actual (possibly inherited) timestep
+    m_timestep = clk_phase.get_timestep().to_seconds();
+    m_phase_increment = 2.0 * M_PI * m_frequency * m_timestep;
+    if (m_params.type == ClockType::PLL) {
+        m_pll.reset();
+    }
 }
 
 // ============================================================================
@@ -141,6 +168,7 @@ void ClockGenerationTdf::process_ideal()
     // Step 1: Output current phase
     // ========================================================================
     clk_phase.write(m_phase);
+    write_edge();
     
     // ========================================================================
     // Step 2: Calculate phase increment
@@ -152,6 +180,16 @@ void ClockGenerationTdf::process_ideal()
     // ========================================================================
     // Step 3: Update phase accumulator
     // ========================================================================
+    // Last rising edge crossed in (t, t + timestep]: cycle boundary k
+    // reached after (k - phase) / f
+    if (clk_edge.size() > 0) {
+        double cycles = (m_phase + delta_phi) / (2.0 * M_PI);
+        double k = std::floor(cycles);
+        if (k >= 1.0) {
+            m_edge_time = get_time().to_seconds()
+                        + (k - m_phase / (2.0 * M_PI)) / m_frequency;
+        }
+    }
     m_phase += delta_phi;
     
     // ========================================================================
@@ -174,21 +212,36 @@ void ClockGenerationTdf::process_ideal()
 void ClockGenerationTdf::process_pll()
 {
     // ========================================================================
-    // PLL Mode - Currently not implemented
-    // Falls back to IDEAL mode with a warning on first call
+    // Step 1: Output current VCO phase
     // ========================================================================
+    m_phase = 2.0 * M_PI * m_pll.phase();
+    clk_phase.write(m_phase);
+    write_edge();
     
-    // Future implementation would include:
-    // 1. Phase detector: compare reference and feedback phases
-    // 2. Charge pump: generate current based on phase error
-    // 3. Loop filter: convert current to control voltage
-    //    V_ctrl = I_cp * R / (1 + s*R*C)
-    // 4. VCO: generate output frequency based on control voltage
-    //    f_out = f0 + Kvco * V_ctrl
-    // 5. Divider: divide output frequency for feedback
-    
-    // For now, use ideal clock processing
-    process_ideal();
+    // ========================================================================
+    // Step 2: Advance the loop by one timestep
+    // ========================================================================
+    // PFD / charge pump / loop filter update once per reference cycle at
+    // the edges crossed in this step; the VCO phase in between is
+    // closed-form, so the result does not depend on the timestep
+    m_pll.advance(clk_phase.get_timestep().to_seconds());
+    if (m_pll.get_last_edge_offset() >= 0.0) {
+        m_edge_time = get_time().to_seconds() + m_pll.get_last_edge_offset();
+    }
+}
+
+// ============================================================================
+// Edge Timestamp Output
+// ============================================================================
+
+void ClockGenerationTdf::write_edge()
+{
+    if (clk_edge.size() == 0) {
+        return;
+    }
+    // Edges crossed by the previous advance are reported at this sample
+    clk_edge[0].write(m_edge_time);
+    m_edge_time = -1.0;
 }
 
 // ============================================================================
@@ -0,0 +1,360 @@
+#include "ams/com_analysis.h"
+#include "ams/eq_seed.h"
+#include "common/fft.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace serdes {
+
+namespace {
+
+typedef std::complex<double> Complex;
+
+double normal_cdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+// dc_gain * prod(1 + jf/fz) / prod(1 + jf/fp)
+Complex zero_pole_response(const std::vector<double>& zeros, const std::vector<double>& poles,
+                           double dc_gain, double f) {
+    Complex h(dc_gain, 0.0);
+    for (double z : zeros) h *= Complex(1.0, f / z);
+    for (double p : poles) h /= Complex(1.0, f / p);
+    return h;
+}
+
+struct CaseResult {
+    double com_db;
+    double signal;
+    double noise;
+    std::vector<double> dfe_taps;
+};
+
+// COM of one equalized pulse, sampled at its peak
+CaseResult com_case(const std::vector<double>& pulse, int spu, const ComParams& params,
+                    double rx_noise_var, int num_dfe, double tap_min, double tap_max,
+                    double vtap) {
+    for (double x : pulse) {
+        if (!std::isfinite(x)) {
+            throw std::invalid_argument("COM: equalized pulse response is not finite");
+        }
+    }
+    CaseResult r;
+    const long len = static_cast<long>(pulse.size());
+    const long main = static_cast<long>(std::max_element(pulse.begin(), pulse.end()) - pulse.begin());
+    r.signal = pulse[main];
+    r.dfe_taps.assign(num_dfe, 0.0);
+    if (!(r.signal > 0.0)) {
+        r.noise = 0.0;
+        r.com_db = -std::numeric_limits<double>::infinity();
+        return r;
+    }
+
+    // Interference cursors (DFE residuals included), TX noise and jitter power
+    std::vector<double> isi;
+    double cursor_power = 0.0;
+    double slope_power = 0.0;
+    for (long k = -(main / spu); main + k * spu < len; ++k) {
+        long idx = main + k * spu;
+        double h = pulse[idx];
+        cursor_power += h * h;
+        if (idx > 0 && idx + 1 < len) {
+            double slope = 0.5 * (pulse[idx + 1] - pulse[idx - 1]) * spu;   // V/UI
+            slope_power += slope * slope;
+        }
+        if (k == 0) {
+            continue;
+        }
+        if (k >= 1 && k <= num_dfe) {
+            double tap = std::max(tap_min, std::min(tap_max, h / vtap));
+            r.dfe_taps[k - 1] = tap;
+            h -= tap * vtap;
+        }
+        if (h != 0.0) {
+            isi.push_back(h);
+        }
+    }
+    double sigma = std::sqrt(rx_noise_var +
+                             std::pow(10.0, -params.snr_tx / 10.0) * cursor_power +
+                             (params.rj * params.rj + 0.25 * params.dj * params.dj) * slope_power);
+
+    // ISI PDF: each cursor a +/-h two-point PDF split linearly between bins
+    const double dy = params.voltage_step * r.signal;
+    const long ng = sigma > 0.0 ? static_cast<long>(std::ceil(8.0 * sigma / dy)) + 1 : 0;
+    long ni = 1;
+    for (double h : isi) ni += static_cast<long>(std::floor(std::fabs(h) / dy)) + 1;
+    const long half = ni + ng;
+    std::vector<double> pdf(2 * half + 1, 0.0), next(pdf.size(), 0.0);
+    pdf[half] = 1.0;
+    long lo = half, hi = half;
+    for (double h : isi) {
+        double u = std::fabs(h) / dy;
+        long j0 = static_cast<long>(std::floor(u));
+        double frac = u - j0;
+        std::fill(next.begin() + (lo - j0 - 1), next.begin() + (hi + j0 + 2), 0.0);
+        for (long i = lo; i <= hi; ++i) {
+            double w = 0.5 * pdf[i];
+            if (w == 0.0) continue;
+            next[i + j0] += w * (1.0 - frac);
+            next[i + j0 + 1] += w * frac;
+            next[i - j0] += w * (1.0 - frac);
+            next[i - j0 - 1] += w * frac;
+        }
+        lo -= j0 + 1;
+        hi += j0 + 1;
+        pdf.swap(next);
+    }
+
+    // Gaussian noise as a binned histogram, so the PDF stays non-negative
+    if (ng > 0) {
+        std::vector<double> g(2 * ng + 1);
+        double sum = 0.0;
+        for (long j = -ng; j <= ng; ++j) {
+            g[j + ng] = normal_cdf((j + 0.5) * dy / sigma) - normal_cdf((j - 0.5) * dy / sigma);
+            sum += g[j + ng];
+        }
+        std::fill(next.begin(), next.end(), 0.0);
+        for (long i = lo; i <= hi; ++i) {
+            if (pdf[i] == 0.0) continue;
+            for (long j = -ng; j <= ng; ++j) {
+                next[i + j] += pdf[i] * g[j + ng] / sum;
+            }
+        }
+        lo -= ng;
+        hi += ng;
+        pdf.swap(next);
+    }
+
+    // A_ni: the PDF below -A_ni holds target_der (interpolated within the bin)
+    double cdf = 0.0;
+    double y = 0.0;
+    for (long i = lo; i <= half; ++i) {
+        if (cdf + pdf[i] >= params.target_der) {
+            y = (i - half - 0.5 + (params.target_der - cdf) / pdf[i]) * dy;
+            break;
+        }
+        cdf += pdf[i];
+    }
+    r.noise = std::max(-y, 0.5 * dy);
+    r.com_db = 20.0 * std::log10(r.signal / r.noise);
+    return r;
+}
+
+} // namespace
+
+ComAnalyzer::ComAnalyzer(const ComParams& params, const TxParams& tx, const RxParams& rx,
+                         const AdaptionParams& adaption, double ui, int samples_per_ui)
+    : m_params(params)
+    , m_spu(samples_per_ui)
+    , m_nfft(0)
+    , m_num_dfe(adaption.dfe_num_taps())
+    , m_tap_min(adaption.dfe.tap_min)
+    , m_tap_max(adaption.dfe.tap_max)
+    , m_vtap(rx.dfe_summer.vtap)
+{
+    if (!(ui > 0.0) || samples_per_ui < 2) {
+        throw std::invalid_argument("COM: ui must be positive and samples_per_ui >= 2");
+    }
+    if (params.pulse_ui < 8) {
+        throw std::invalid_argument("COM: pulse_ui must be >= 8");
+    }
+    if (!(params.target_der > 0.0 && params.target_der < 1.0)) {
+        throw std::invalid_argument("COM: target_der must be in (0, 1)");
+    }
+    if (!(params.voltage_step > 0.0 && params.voltage_step <= 0.1)) {
+        throw std::invalid_argument("COM: voltage_step must be in (0, 0.1]");
+    }
+    if (params.eta0 < 0.0 || params.rj < 0.0 || params.dj < 0.0 || params.num_threads < 0) {
+        throw std::invalid_argument("COM: eta0, rj, dj and num_threads must be >= 0");
+    }
+    if (m_num_dfe > 0 && !(m_vtap != 0.0 && m_tap_min <= m_tap_max)) {
+        throw std::invalid_argument("COM: DFE needs vtap != 0 and tap_min <= tap_max");
+    }
+    if (rx.ctle.zeros.size() > rx.ctle.poles.size() || rx.vga.zeros.size() > rx.vga.poles.size()) {
+        throw std::invalid_argument("COM: CTLE/VGA have more zeros than poles");
+    }
+    if ((!params.ctle_zeros.empty() && rx.ctle.zeros.empty()) ||
+        (!params.ctle_poles.empty() && rx.ctle.poles.empty())) {
+        throw std::invalid_argument("COM: a zero/pole family needs a base CTLE zero/pole to replace");
+    }
+
+    // TX FFE presets at UI spacing
+    if (params.ffe_presets.empty()) {
+        m_ffe.push_back(tx.ffe);
+    }
+    for (const std::vector<double>& taps : params.ffe_presets) {
+        if (taps.empty()) {
+            throw std::invalid_argument("COM: empty TX FFE preset");
+        }
+        TxFfeParams ffe;
+        ffe.taps = taps;
+        ffe.tap_spacing = samples_per_ui;
+        m_ffe.push_back(ffe);
+    }
+
+    // CTLE family: every zero x pole x DC gain combination
+    std::vector<double> zeros = params.ctle_zeros;
+    std::vector<double> poles = params.ctle_poles;
+    std::vector<double> gains = params.ctle_dc_gains;
+    if (zeros.empty()) zeros.push_back(rx.ctle.zeros.empty() ? 0.0 : rx.ctle.zeros[0]);
+    if (poles.empty()) poles.push_back(rx.ctle.poles.empty() ? 0.0 : rx.ctle.poles[0]);
+    if (gains.empty()) gains.push_back(rx.ctle.dc_gain);
+    for (double z : zeros) {
+        for (double p : poles) {
+            for (double g : gains) {
+                if ((!rx.ctle.zeros.empty() && !(z > 0.0)) || (!rx.ctle.poles.empty() && !(p > 0.0))) {
+                    throw std::invalid_argument("COM: CTLE zeros/poles must be positive");
+                }
+                ComCtleSetting s = {z, p, g};
+                m_ctle.push_back(s);
+            }
+        }
+    }
+
+    // Frequency grid of an N-point FFT over the pulse window
+    m_nfft = next_pow2(static_cast<size_t>(params.pulse_ui) * samples_per_ui);
+    const double fs = samples_per_ui / ui;
+    const size_t nf = m_nfft / 2 + 1;
+    m_freqs.resize(nf);
+    for (size_t k = 0; k < nf; ++k) {
+        m_freqs[k] = fs * static_cast<double>(k) / static_cast<double>(m_nfft);
+    }
+
+    // One-UI symbol (DFT of spu unit samples) at the driver level
+    const double level = driver_symbol_level(tx.driver);
+    m_tx_response.resize(nf);
+    for (size_t k = 0; k < nf; ++k) {
+        Complex sym(0.0, 0.0);
+        for (int n = 0; n < samples_per_ui; ++n) {
+            sym += std::polar(1.0, -2.0 * M_PI * static_cast<double>(k * n) / static_cast<double>(m_nfft));
+        }
+        m_tx_response[k] = level * sym * zero_pole_response({}, tx.driver.poles, 1.0, m_freqs[k]);
+    }
+
+    // CTLE x VGA per setting, and the RX noise integrated up to the baud rate
+    const double df = fs / static_cast<double>(m_nfft);
+    m_rx_response.resize(m_ctle.size());
+    m_rx_noise_var.assign(m_ctle.size(), 0.0);
+    for (size_t c = 0; c < m_ctle.size(); ++c) {
+        std::vector<double> cz = rx.ctle.zeros;
+        std::vector<double> cp = rx.ctle.poles;
+        if (!cz.empty()) cz[0] = m_ctle[c].zero;
+        if (!cp.empty()) cp[0] = m_ctle[c].pole;
+        m_rx_response[c].resize(nf);
+        for (size_t k = 0; k < nf; ++k) {
+            Complex h = zero_pole_response(cz, cp, m_ctle[c].dc_gain, m_freqs[k]) *
+                        zero_pole_response(rx.vga.zeros, rx.vga.poles, rx.vga.dc_gain, m_freqs[k]);
+            m_rx_response[c][k] = h;
+            if (m_freqs[k] <= 1.0 / ui) {
+                m_rx_noise_var[c] += params.eta0 * std::norm(h) * df;
+            }
+        }
+    }
+}
+
+std::vector<Complex> ComAnalyzer::channel_product(const std::vector<Complex>& channel) const {
+    if (channel.size() != m_freqs.size()) {
+        throw std::invalid_argument("COM: channel response does not match get_frequencies()");
+    }
+    std::vector<Complex> product(channel.size());
+    for (size_t k = 0; k < channel.size(); ++k) {
+        product[k] = m_tx_response[k] * channel[k];
+    }
+    return product;
+}
+
+std::vector<double> ComAnalyzer::inverse(const std::vector<Complex>& product, int ctle_index) const {
+    const size_t half = m_nfft / 2;
+    std::vector<Complex> X(m_nfft);
+    for (size_t k = 0; k <= half; ++k) {
+        X[k] = product[k] * m_rx_response[ctle_index][k];
+    }
+    X[half] = Complex(X[half].real(), 0.0);
+    for (size_t k = 1; k < half; ++k) {
+        X[m_nfft - k] = std::conj(X[k]);
+    }
+    fft_radix2(X, true);
+    std::vector<double> pulse(m_nfft);
+    for (size_t n = 0; n < m_nfft; ++n) {
+        pulse[n] = X[n].real() / static_cast<double>(m_nfft);
+    }
+    return pulse;
+}
+
+std::vector<double> ComAnalyzer::pulse_response(const std::vector<Complex>& channel,
+                                                int ctle_index) const {
+    if (ctle_index < 0 || ctle_index >= get_num_ctle()) {
+        throw std::invalid_argument("COM: CTLE index out of range");
+    }
+    return inverse(channel_product(channel), ctle_index);
+}
+
+ComResult ComAnalyzer::evaluate(const std::vector<Complex>& channel) const {
+    const std::vector<Complex> product = channel_product(channel);
+    const int num_ctle = get_num_ctle();
+    const int num_ffe = get_num_ffe();
+    std::vector<CaseResult> cases(static_cast<size_t>(num_ctle) * num_ffe);
+
+    std::atomic<int> next_ctle(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]() {
+        for (int c = next_ctle++; c < num_ctle && !failed; c = next_ctle++) {
+            try {
+                std::vector<double> pulse = inverse(product, c);
+                for (int f = 0; f < num_ffe; ++f) {
+                    cases[static_cast<size_t>(c) * num_ffe + f] =
+                        com_case(apply_ffe_to_pulse(pulse, m_ffe[f]), m_spu, m_params,
+                                 m_rx_noise_var[c], m_num_dfe, m_tap_min, m_tap_max, m_vtap);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+    int num_threads = m_params.num_threads > 0
+                      ? m_params.num_threads
+                      : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    num_threads = std::min(num_threads, num_ctle);
+    std::vector<std::thread> pool;
+    for (int t = 1; t < num_threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    ComResult result;
+    result.com_table.resize(cases.size());
+    size_t best = 0;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        result.com_table[i] = cases[i].com_db;
+        if (cases[i].com_db > cases[best].com_db) {
+            best = i;
+        }
+    }
+    result.com_db = cases[best].com_db;
+    result.signal = cases[best].signal;
+    result.noise = cases[best].noise;
+    result.ctle_index = static_cast<int>(best) / num_ffe;
+    result.ffe_index = static_cast<int>(best) % num_ffe;
+    result.ffe_taps = m_ffe[result.ffe_index].taps;
+    result.ctle = m_ctle[result.ctle_index];
+    result.dfe_taps = cases[best].dfe_taps;
+    return result;
+}
+
+} // namespace serdes
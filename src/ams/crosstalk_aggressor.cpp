@@ -0,0 +1,161 @@
+#include "ams/crosstalk_aggressor.h"
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include <iostream>
+
+namespace serdes {
+
+CrosstalkAggressor::CrosstalkAggressor(const CrosstalkAggressorParams& params, double ui)
+    : m_params(params)
+    , m_ui(ui)
+    , m_samples_per_ui(0)
+    , m_span_ui(0)
+    , m_skew_samples(0)
+    , m_pos(0)
+    , m_sample_index(0)
+    , m_phase(0)
+    , m_lfsr(params.prbs, params.seed)
+{
+    std::string type = params.type;
+    std::transform(type.begin(), type.end(), type.begin(), ::tolower);
+    if (type != "next" && type != "fext") {
+        throw std::invalid_argument("Crosstalk: type must be 'next' or 'fext'");
+    }
+    if (ui <= 0.0) {
+        throw std::invalid_argument("Crosstalk: ui must be positive");
+    }
+    if (params.pulse_response.empty()) {
+        throw std::invalid_argument("Crosstalk: pulse_response is empty");
+    }
+    if (params.pulse_dt < 0.0) {
+        throw std::invalid_argument("Crosstalk: pulse_dt cannot be negative");
+    }
+}
+
+void CrosstalkAggressor::initialize(double timestep) {
+    if (timestep <= 0.0) {
+        throw std::invalid_argument("Crosstalk: timestep must be positive");
+    }
+
+    double exact_spu = m_ui / timestep;
+    m_samples_per_ui = static_cast<int>(std::round(exact_spu));
+    if (exact_spu < 1.0 - 1e-9) {
+        throw std::invalid_argument("Crosstalk: timestep larger than UI");
+    }
+    if (std::abs(exact_spu - m_samples_per_ui) > 1e-6 * exact_spu) {
+        std::cerr << "Warning: crosstalk UI is not an integer multiple of the channel timestep" << std::endl;
+    }
+
+    // Pulse duration in channel samples
+    double src_dt = (m_params.pulse_dt > 0.0) ? m_params.pulse_dt : timestep;
+    double duration = m_params.pulse_response.size() * src_dt;
+    int n_samples = std::max(1, static_cast<int>(std::ceil(duration / timestep - 1e-9)));
+    m_span_ui = (n_samples + m_samples_per_ui - 1) / m_samples_per_ui;
+
+    // Resample pulse onto the channel grid and scatter into polyphase layout
+    m_taps.assign(static_cast<size_t>(m_samples_per_ui) * m_span_ui, 0.0);
+    for (int k = 0; k < m_span_ui; ++k) {
+        for (int ph = 0; ph < m_samples_per_ui; ++ph) {
+            int n = k * m_samples_per_ui + ph;
+            if (n >= n_samples) continue;
+            m_taps[ph * m_span_ui + k] = m_params.amplitude * interpolate_pulse(n * timestep, src_dt);
+        }
+    }
+
+    // Skew is only meaningful modulo one UI for an uncorrelated aggressor
+    int skew = static_cast<int>(std::round(m_params.skew_ui * m_samples_per_ui));
+    m_skew_samples = ((skew % m_samples_per_ui) + m_samples_per_ui) % m_samples_per_ui;
+
+    reset();
+}
+
+void CrosstalkAggressor::reset() {
+    m_lfsr.reset(m_params.seed);
+    m_symbols.assign(2 * static_cast<size_t>(m_span_ui), 0.0);
+    m_pos = 0;
+    m_sample_index = -m_skew_samples;
+    m_phase = 0;
+}
+
+void CrosstalkAggressor::save_state(StateCheckpoint& cp, const std::string& key) const {
+    cp.put_real(key + ".symbols", m_symbols);
+    cp.put_int(key + ".pos", m_pos);
+    cp.put_int(key + ".sample_index", m_sample_index);
+    cp.put_int(key + ".phase", m_phase);
+    cp.put_int(key + ".lfsr", m_lfsr.get_state());
+}
+
+void CrosstalkAggressor::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    const std::vector<double>& symbols = cp.get_real_vector(key + ".symbols");
+    std::int64_t pos = cp.get_int(key + ".pos");
+    std::int64_t phase = cp.get_int(key + ".phase");
+    if (symbols.size() != m_symbols.size() || pos < 0 || pos >= m_span_ui ||
+        phase < 0 || phase >= m_samples_per_ui) {
+        throw std::invalid_argument("CrosstalkAggressor: checkpoint size mismatch at '" +
+                                    key + "'");
+    }
+    m_symbols = symbols;
+    m_pos = static_cast<int>(pos);
+    m_sample_index = cp.get_int(key + ".sample_index");
+    m_phase = static_cast<int>(phase);
+    m_lfsr.set_state(static_cast<unsigned int>(cp.get_int(key + ".lfsr")));
+}
+
+double CrosstalkAggressor::interpolate_pulse(double t, double src_dt) const {
+    // Linear interpolation of the source pulse response, zero past its end
+    const std::vector<double>& p = m_params.pulse_response;
+    double x = t / src_dt;
+    size_t i0 = static_cast<size_t>(x);
+    if (i0 >= p.size()) return 0.0;
+    if (i0 + 1 >= p.size()) return p[i0];
+    double frac = x - static_cast<double>(i0);
+    return p[i0] + frac * (p[i0 + 1] - p[i0]);
+}
+
+void CrosstalkAggressor::push_symbol(double a) {
+    m_pos = (m_pos == 0) ? m_span_ui - 1 : m_pos - 1;
+    m_symbols[m_pos] = a;
+    m_symbols[m_pos + m_span_ui] = a;
+}
+
+double CrosstalkAggressor::process() {
+    if (m_sample_index < 0) {
+        ++m_sample_index;
+        return 0.0;
+    }
+
+    if (m_phase == 0) {
+        push_symbol(m_lfsr.next_bit() ? 1.0 : -1.0);
+    }
+
+    const double* taps = &m_taps[static_cast<size_t>(m_phase) * m_span_ui];
+    const double* sym = &m_symbols[m_pos];
+    double y = 0.0;
+    for (int k = 0; k < m_span_ui; ++k) {
+        y += taps[k] * sym[k];
+    }
+
+    ++m_sample_index;
+    if (++m_phase >= m_samples_per_ui) {
+        m_phase = 0;
+    }
+    return y;
+}
+
+double CrosstalkAggressor::get_peak_coupling() const {
+    double peak = 0.0;
+    for (double h : m_taps) {
+        peak = std::max(peak, std::abs(h));
+    }
+    return peak;
+}
+
+double crosstalk_output_share(int n_outputs, int index) {
+    if (n_outputs == 2) {
+        return (index == 0) ? 0.5 : -0.5;
+    }
+    return (index == 0) ? 1.0 : 0.0;
+}
+
+} // namespace serdes
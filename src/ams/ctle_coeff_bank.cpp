@@ -0,0 +1,150 @@
+#include "ams/ctle_coeff_bank.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace serdes {
+
+CtleCoeffBank::CtleCoeffBank()
+    : m_timestep(0.0)
+    , m_num_sections(0)
+{
+}
+
+void CtleCoeffBank::configure(const std::vector<double>& zeros,
+                              const std::vector<double>& poles,
+                              double timestep) {
+    if (timestep <= 0.0) {
+        throw std::invalid_argument("CTLE: timestep must be positive");
+    }
+
+    // Non-positive entries are ignored, matching build_transfer_function()
+    m_zeros.clear();
+    m_poles.clear();
+    for (double fz : zeros) {
+        if (fz > 0.0) m_zeros.push_back(fz);
+    }
+    for (double fp : poles) {
+        if (fp > 0.0) m_poles.push_back(fp);
+    }
+    if (m_zeros.size() > m_poles.size()) {
+        throw std::invalid_argument("CTLE: runtime reconfiguration requires zeros <= poles");
+    }
+
+    m_timestep = timestep;
+    m_num_sections = static_cast<int>(m_poles.size());
+    m_sets.clear();
+    m_index.clear();
+}
+
+int CtleCoeffBank::find_or_build(double zero, double pole, double dc_gain) {
+    auto key = std::make_tuple(zero, pole, dc_gain);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        return it->second;
+    }
+    m_sets.push_back(discretize(zero, pole, dc_gain));
+    int index = static_cast<int>(m_sets.size()) - 1;
+    m_index[key] = index;
+    return index;
+}
+
+int CtleCoeffBank::find_nearest(double zero, double pole, double dc_gain) const {
+    int best = -1;
+    double best_dist = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < m_sets.size(); ++i) {
+        const CtleCoeffSet& s = m_sets[i];
+        double dz = (zero > 0.0 && s.zero > 0.0) ? std::log(zero / s.zero) : 0.0;
+        double dp = (pole > 0.0 && s.pole > 0.0) ? std::log(pole / s.pole) : 0.0;
+        double dg = (dc_gain > 0.0 && s.dc_gain > 0.0) ? std::log(dc_gain / s.dc_gain) : 0.0;
+        double dist = dz * dz + dp * dp + dg * dg;
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+CtleCoeffSet CtleCoeffBank::discretize(double zero, double pole, double dc_gain) const {
+    CtleCoeffSet set;
+    set.zero = zero;
+    set.pole = pole;
+    set.dc_gain = dc_gain;
+
+    std::vector<double> zeros = m_zeros;
+    std::vector<double> poles = m_poles;
+    if (zero > 0.0) {
+        if (zeros.empty()) zeros.push_back(zero); else zeros[0] = zero;
+    }
+    if (pole > 0.0 && !poles.empty()) {
+        poles[0] = pole;
+    }
+
+    set.sections.reserve(poles.size());
+    for (size_t i = 0; i < poles.size(); ++i) {
+        double fz = (i < zeros.size()) ? zeros[i] : 0.0;
+        set.sections.push_back(bilinear_section(fz, poles[i]));
+    }
+    return set;
+}
+
+// Bilinear transform of (1 + s/wz) / (1 + s/wp), s = K (1 - z^-1) / (1 + z^-1)
+CtleSectionCoeffs CtleCoeffBank::bilinear_section(double fz, double fp) const {
+    double K = 2.0 / m_timestep;
+    double kp = K / (2.0 * M_PI * fp);
+    double a0 = 1.0 + kp;
+
+    CtleSectionCoeffs c;
+    if (fz > 0.0) {
+        double kz = K / (2.0 * M_PI * fz);
+        c.b0 = (1.0 + kz) / a0;
+        c.b1 = (1.0 - kz) / a0;
+    } else {
+        c.b0 = 1.0 / a0;
+        c.b1 = 1.0 / a0;
+    }
+    c.a1 = (1.0 - kp) / a0;
+    return c;
+}
+
+void CtleSectionCascade::resize(int num_sections) {
+    m_x1.assign(num_sections, 0.0);
+    m_y1.assign(num_sections, 0.0);
+}
+
+void CtleSectionCascade::reset() {
+    std::fill(m_x1.begin(), m_x1.end(), 0.0);
+    std::fill(m_y1.begin(), m_y1.end(), 0.0);
+}
+
+void CtleSectionCascade::save_state(StateCheckpoint& cp, const std::string& key) const {
+    cp.put_real(key + ".x1", m_x1);
+    cp.put_real(key + ".y1", m_y1);
+}
+
+void CtleSectionCascade::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    const std::vector<double>& x1 = cp.get_real_vector(key + ".x1");
+    const std::vector<double>& y1 = cp.get_real_vector(key + ".y1");
+    if (x1.size() != m_x1.size() || y1.size() != m_y1.size()) {
+        throw std::invalid_argument("CtleSectionCascade: checkpoint section count mismatch at '" +
+                                    key + "'");
+    }
+    m_x1 = x1;
+    m_y1 = y1;
+}
+
+double CtleSectionCascade::process(const CtleCoeffSet& set, double x) {
+    size_t n = std::min(set.sections.size(), m_x1.size());
+    for (size_t i = 0; i < n; ++i) {
+        const CtleSectionCoeffs& c = set.sections[i];
+        double y = c.b0 * x + c.b1 * m_x1[i] - c.a1 * m_y1[i];
+        m_x1[i] = x;
+        m_y1[i] = y;
+        x = y;
+    }
+    return set.dc_gain * x;
+}
+
+} // namespace serdes
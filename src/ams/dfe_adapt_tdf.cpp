@@ -2,9 +2,10 @@
  * @file dfe_adapt_tdf.cpp
  * @brief DfeAdaptTdf class implementation - TDF domain DFE adaptation engine
  *
- * Implements the dual-threshold Sign-Sign LMS DFE adaptation algorithm:
+ * Implements the dual-threshold DFE adaptation algorithm:
  * - Per-UI history maintenance
- * - Per-UI Sign-Sign LMS tap update: c[n] -= mu * sign_e * d[k-n]
+ * - Per-UI tap update: Sign-Sign LMS c[n] -= mu * sign_e * d[k] * d[k-n] (default),
+ *   or LMS / NLMS / RLS on the sampled error magnitude (DfeTapUpdater)
  * - Statistics accumulation every M UI
  * - Optional Vref adaptation
  * - State machine: STARTUP -> ACQUIRE -> TRACK with variable step size
@@ -13,37 +14,31 @@
 #include "ams/dfe_adapt_tdf.h"
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
 
 namespace serdes {
 
-// Static const member definition (required by linker)
-const int DfeAdaptTdf::MAX_TAPS;
-
 // ============================================================================
 // Constructor
 // ============================================================================
 DfeAdaptTdf::DfeAdaptTdf(sc_core::sc_module_name nm,
                            const AdaptionParams::DfeAdaptParams& dfe_params,
-                           const AdaptionParams::VrefAdaptParams& vref_params)
+                           const AdaptionParams::VrefAdaptParams& vref_params,
+                           int tick_period_ui)
     : sca_tdf::sca_module(nm)
     // TDF inputs
     , data_in("data_in")
     , vref_pos_in("vref_pos_in")
     , vref_neg_in("vref_neg_in")
     , sampling_trigger("sampling_trigger")
+    , value_in("value_in")
     // DE inputs
     , mode_de("mode_de")
     , reset_de("reset_de")
     , vref_cmd_de("vref_cmd_de")
     // DE outputs - taps
-    , tap1_de("tap1_de")
-    , tap2_de("tap2_de")
-    , tap3_de("tap3_de")
-    , tap4_de("tap4_de")
-    , tap5_de("tap5_de")
-    , tap6_de("tap6_de")
-    , tap7_de("tap7_de")
-    , tap8_de("tap8_de")
+    , tap_de("tap_de")
+    , tap_seq_de("tap_seq_de")
     // DE outputs - statistics
     , stat_N_A("stat_N_A")
     , stat_N_B("stat_N_B")
@@ -57,10 +52,11 @@ DfeAdaptTdf::DfeAdaptTdf(sc_core::sc_module_name nm,
     , stat_mu("stat_mu")
     , stat_update_count("stat_update_count")
     , vref_current("vref_current")
+    , adapt_tick("adapt_tick")
     // Parameters
     , m_dfe_params(dfe_params)
     , m_vref_params(vref_params)
-    , m_num_taps(std::min(dfe_params.num_taps, MAX_TAPS))
+    , m_num_taps(dfe_params.num_taps)
     // State initialization
     , m_N_A(0)
     , m_N_B(0)
@@ -75,21 +71,36 @@ DfeAdaptTdf::DfeAdaptTdf(sc_core::sc_module_name nm,
     , m_current_mu(dfe_params.mu_startup)
     , m_current_vref(vref_params.enabled ? vref_params.vref_initial : vref_params.vref_pos)
     , m_update_count(0)
+    , m_tap_seq(0)
+    , m_tick_period_ui(tick_period_ui)
+    , m_tick_ui(0)
+    , m_tick_count(0)
     , m_prev_data(false)
     , m_hold_data(false)
     , m_hold_s_pos(false)
     , m_hold_s_neg(false)
 {
-    // Initialize taps
-    for (int i = 0; i < MAX_TAPS; ++i) {
-        m_taps[i] = 0.0;
-        m_history[i] = 0.0;
+    if (m_num_taps < 1) {
+        throw std::invalid_argument("DfeAdaptTdf: num_taps must be >= 1");
     }
-
-    // Set initial taps from parameters if provided
-    for (size_t i = 0; i < dfe_params.initial_taps.size() && i < static_cast<size_t>(MAX_TAPS); ++i) {
-        m_taps[i] = dfe_params.initial_taps[i];
+    if (tick_period_ui < 0) {
+        throw std::invalid_argument("DfeAdaptTdf: tick_period_ui must be >= 0");
+    }
+    tap_de.init(m_num_taps);
+    if (tick_period_ui > 0) {
+        adapt_tick.init(1);
     }
+    m_updater.configure(parse_dfe_update_algorithm(dfe_params.algorithm), m_num_taps,
+                        dfe_params.rls_lambda, dfe_params.rls_delta, dfe_params.nlms_eps);
+    if (m_updater.needs_error_magnitude()) {
+        value_in.init(1);
+    }
+    reset_taps();
+}
+
+void DfeAdaptTdf::set_summer_mapping(double vtap, const std::string& map_mode)
+{
+    m_updater.set_bit_mapping(map_mode == "pm1", vtap);
 }
 
 // ============================================================================
@@ -102,11 +113,18 @@ void DfeAdaptTdf::set_attributes()
     vref_pos_in.set_rate(1);
     vref_neg_in.set_rate(1);
     sampling_trigger.set_rate(1);
+    for (auto& port : value_in) {
+        port.set_rate(1);
+    }
 }
 
 void DfeAdaptTdf::initialize()
 {
     reset_stats();
+    m_tick_ui = 0;
+    if (!m_restore.empty()) {
+        apply_restore();
+    }
     // Note: write_tap_outputs() and DE output writes cannot be called in initialize()
     // because sca_de::sca_out ports can only be written in processing().
     // They will be written on the first processing() call.
@@ -130,13 +148,7 @@ void DfeAdaptTdf::processing()
     // Step 2: Handle reset
     // ========================================================================
     if (reset) {
-        for (int i = 0; i < MAX_TAPS; ++i) {
-            m_taps[i] = 0.0;
-            m_history[i] = 0.0;
-        }
-        for (size_t i = 0; i < m_dfe_params.initial_taps.size() && i < static_cast<size_t>(MAX_TAPS); ++i) {
-            m_taps[i] = m_dfe_params.initial_taps[i];
-        }
+        reset_taps();
         reset_stats();
         m_state = 0;  // STARTUP
         m_current_mu = m_dfe_params.mu_startup;
@@ -147,6 +159,17 @@ void DfeAdaptTdf::processing()
         return;
     }
 
+    // ========================================================================
+    // Step 2b: Decimated wake-up tick for the event-driven AdaptionDe
+    //          (counts UI whether or not the DFE itself adapts)
+    // ========================================================================
+    if (adapt_tick.size() > 0 && trigger && current_mode != 3) {
+        if (++m_tick_ui >= m_tick_period_ui) {
+            m_tick_ui = 0;
+            adapt_tick[0].write(++m_tick_count);
+        }
+    }
+
     // ========================================================================
     // Step 3: Skip if DFE not enabled or in freeze mode
     // ========================================================================
@@ -168,23 +191,26 @@ void DfeAdaptTdf::processing()
     m_hold_s_pos = (s_pos_raw > 0.5);
     m_hold_s_neg = (s_neg_raw > 0.5);
 
-    // Map data to ±1 for history and LMS
-    double d_pm1 = m_hold_data ? 1.0 : -1.0;
-
     // ========================================================================
-    // Step 6: Shift history and insert current decision
+    // Step 6: Generate error: sign(e) per proposal formula, and the
+    //         a-priori error magnitude for LMS / NLMS / RLS
     // ========================================================================
-    shift_history(d_pm1);
+    double sign_e = compute_sign_e(d_raw, s_pos_raw, s_neg_raw);
+    double error = 0.0;
+    if (value_in.size() > 0) {
+        error = compute_error(value_in[0].read(), m_hold_data ? 1.0 : -1.0);
+    }
 
     // ========================================================================
-    // Step 7: Generate sign(e) per proposal formula
+    // Step 7: Execute tap update (per UI); the regressor is the history of
+    //         previous decisions d[k-1..k-N]
     // ========================================================================
-    double sign_e = compute_sign_e(d_raw, s_pos_raw, s_neg_raw);
+    update_taps(sign_e, m_hold_data ? 1.0 : -1.0, error);
 
     // ========================================================================
-    // Step 8: Execute Sign-Sign LMS tap update (per UI)
+    // Step 8: Shift history and insert current decision
     // ========================================================================
-    update_taps(sign_e);
+    m_history.push(m_hold_data);
 
     // ========================================================================
     // Step 9: Accumulate statistics
@@ -241,32 +267,38 @@ double DfeAdaptTdf::compute_sign_e(double d, double s_pos, double s_neg) const
 }
 
 // ============================================================================
-// Shift history buffer
+// Restore initial taps and clear history
 // ============================================================================
-void DfeAdaptTdf::shift_history(double new_decision)
+void DfeAdaptTdf::reset_taps()
 {
-    for (int i = MAX_TAPS - 1; i > 0; --i) {
-        m_history[i] = m_history[i - 1];
+    m_taps.assign(m_num_taps, 0.0);
+    for (size_t i = 0; i < m_dfe_params.initial_taps.size() && i < m_taps.size(); ++i) {
+        m_taps[i] = m_dfe_params.initial_taps[i];
     }
-    m_history[0] = new_decision;
+    m_history.resize(m_num_taps);
+    // Nothing written yet: the summer still holds its configured taps, which
+    // RxTopModule initializes from initial_taps
+    m_written_taps = m_taps;
+    m_updater.reset();
 }
 
 // ============================================================================
-// Sign-Sign LMS tap update (per UI)
+// Tap update (per UI)
 // ============================================================================
-void DfeAdaptTdf::update_taps(double sign_e)
+void DfeAdaptTdf::update_taps(double sign_e, double d, double error)
 {
-    // Only update if sign_e is non-zero (i.e., we have meaningful error info)
-    if (sign_e == 0.0) {
+    // sign_e > 0 means the sample fell short of ±Vref, i.e. the error
+    // e = y - d * Vref points back toward zero: sign(e) = -d * sign_e.
+    // (Before the rule became selectable, sign-lms used -sign_e * d[k-n]
+    // after the history push, whose mean update is zero; see adaption.md.)
+    double sign_err = -d * sign_e;
+    if (!m_updater.update(m_taps, m_history, m_current_mu, sign_err, error)) {
         return;
     }
 
     for (int i = 0; i < m_num_taps; ++i) {
-        // Sign-Sign LMS: c[n] -= mu * sign(e) * d[k-n]
-        double update = m_current_mu * sign_e * sign_fn(m_history[i]);
-
         // Apply leakage
-        m_taps[i] = (1.0 - m_dfe_params.leakage) * m_taps[i] - update;
+        m_taps[i] = (1.0 - m_dfe_params.leakage) * m_taps[i];
 
         // Apply saturation
         m_taps[i] = clamp(m_taps[i], m_dfe_params.tap_min, m_dfe_params.tap_max);
@@ -275,6 +307,23 @@ void DfeAdaptTdf::update_taps(double sign_e)
     m_update_count++;
 }
 
+// ============================================================================
+// A-priori error for the current taps
+// ============================================================================
+double DfeAdaptTdf::compute_error(double y, double d) const
+{
+    // The summer applied the last written taps; swap them for the current
+    // taps so the error does not lag by up to one stats period:
+    //   e = y + sum((c_written[n] - c[n]) * u[n]) - d * Vref
+    // with u[n] the summer's feedback per unit tap (vtap, pm1 / 01 mapping)
+    int filled = static_cast<int>(m_history.filled());
+    double correction = 0.0;
+    for (int i = 0; i < m_num_taps && i < filled; ++i) {
+        correction += (m_written_taps[i] - m_taps[i]) * m_updater.regressor(m_history.bit(i));
+    }
+    return y + correction - d * m_current_vref;
+}
+
 // ============================================================================
 // Accumulate statistics
 // ============================================================================
@@ -415,29 +464,84 @@ void DfeAdaptTdf::update_state_machine()
 // ============================================================================
 void DfeAdaptTdf::write_tap_outputs()
 {
-    tap1_de.write(m_taps[0]);
-    tap2_de.write(m_taps[1]);
-    tap3_de.write(m_taps[2]);
-    tap4_de.write(m_taps[3]);
-    tap5_de.write(m_taps[4]);
-    tap6_de.write(m_taps[5]);
-    tap7_de.write(m_taps[6]);
-    tap8_de.write(m_taps[7]);
+    for (int i = 0; i < m_num_taps; ++i) {
+        tap_de[i].write(m_taps[i]);
+    }
+    m_written_taps = m_taps;
+    tap_seq_de.write(++m_tap_seq);
 }
 
 // ============================================================================
-// Utility functions
+// Checkpoint
 // ============================================================================
-double DfeAdaptTdf::clamp(double val, double min_val, double max_val) const
+void DfeAdaptTdf::save_state(StateCheckpoint& cp) const
 {
-    return std::max(min_val, std::min(max_val, val));
+    const std::string key = std::string(name()) + ".";
+    cp.put_real(key + "taps", m_taps);
+    cp.put_real(key + "written_taps", m_written_taps);
+    m_history.save_state(cp, key + "history");
+    m_updater.save_state(cp, key + "updater");
+    cp.put_int(key + "counts", std::vector<std::int64_t>{m_N_A, m_N_B, m_N_C, m_N_D, m_ui_counter});
+    cp.put_real(key + "stats", std::vector<double>{m_P_pos, m_P_neg, m_C, m_Delta});
+    cp.put_int(key + "state", m_state);
+    cp.put_real(key + "mu", m_current_mu);
+    cp.put_real(key + "vref", m_current_vref);
+    cp.put_int(key + "update_count", m_update_count);
+    cp.put_int(key + "tick", std::vector<std::int64_t>{m_tick_ui, m_tick_count});
+    cp.put_int(key + "hold", std::vector<std::int64_t>{m_prev_data, m_hold_data,
+                                                       m_hold_s_pos, m_hold_s_neg});
+}
+
+void DfeAdaptTdf::restore_state(const StateCheckpoint& cp)
+{
+    m_restore = cp.subset(std::string(name()) + ".");
 }
 
-double DfeAdaptTdf::sign_fn(double val)
+void DfeAdaptTdf::apply_restore()
 {
-    if (val > 0) return 1.0;
-    if (val < 0) return -1.0;
-    return 0.0;
+    const std::string key = std::string(name()) + ".";
+    const std::vector<double>& taps = m_restore.get_real_vector(key + "taps");
+    const std::vector<double>& written = m_restore.get_real_vector(key + "written_taps");
+    const std::vector<std::int64_t>& counts = m_restore.get_int_vector(key + "counts");
+    const std::vector<double>& stats = m_restore.get_real_vector(key + "stats");
+    const std::vector<std::int64_t>& tick = m_restore.get_int_vector(key + "tick");
+    const std::vector<std::int64_t>& hold = m_restore.get_int_vector(key + "hold");
+    if (taps.size() != m_taps.size() || written.size() != m_taps.size() ||
+        counts.size() != 5 || stats.size() != 4 || tick.size() != 2 || hold.size() != 4) {
+        throw std::invalid_argument("DfeAdaptTdf: checkpoint does not match the configuration");
+    }
+    m_taps = taps;
+    m_written_taps = written;
+    m_history.restore_state(m_restore, key + "history");
+    m_updater.restore_state(m_restore, key + "updater");
+    m_N_A = static_cast<int>(counts[0]);
+    m_N_B = static_cast<int>(counts[1]);
+    m_N_C = static_cast<int>(counts[2]);
+    m_N_D = static_cast<int>(counts[3]);
+    m_ui_counter = static_cast<int>(counts[4]);
+    m_P_pos = stats[0];
+    m_P_neg = stats[1];
+    m_C = stats[2];
+    m_Delta = stats[3];
+    m_state = static_cast<int>(m_restore.get_int(key + "state"));
+    m_current_mu = m_restore.get_real(key + "mu");
+    m_current_vref = m_restore.get_real(key + "vref");
+    m_update_count = static_cast<int>(m_restore.get_int(key + "update_count"));
+    m_tick_ui = static_cast<int>(tick[0]);
+    m_tick_count = static_cast<int>(tick[1]);
+    m_prev_data = hold[0] != 0;
+    m_hold_data = hold[1] != 0;
+    m_hold_s_pos = hold[2] != 0;
+    m_hold_s_neg = hold[3] != 0;
+    m_restore.clear();
+}
+
+// ============================================================================
+// Utility functions
+// ============================================================================
+double DfeAdaptTdf::clamp(double val, double min_val, double max_val) const
+{
+    return std::max(min_val, std::min(max_val, val));
 }
 
 } // namespace serdes
@@ -0,0 +1,148 @@
+#include "ams/dfe_feedback.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace serdes {
+
+// ============================================================================
+// DfeBitHistory
+// ============================================================================
+DfeBitHistory::DfeBitHistory()
+    : m_top_mask(0)
+    , m_depth(0)
+    , m_filled(0)
+{
+}
+
+void DfeBitHistory::resize(std::size_t depth) {
+    m_depth = depth;
+    m_words.assign((depth + 63) / 64, 0);
+    std::size_t top_bits = depth % 64;
+    m_top_mask = (top_bits == 0) ? ~std::uint64_t(0)
+                                 : ((std::uint64_t(1) << top_bits) - 1);
+    m_filled = 0;
+}
+
+void DfeBitHistory::clear() {
+    for (std::uint64_t& w : m_words) {
+        w = 0;
+    }
+    m_filled = 0;
+}
+
+void DfeBitHistory::save_state(StateCheckpoint& cp, const std::string& key) const {
+    std::vector<std::int64_t> words(m_words.begin(), m_words.end());
+    cp.put_int(key + ".words", words);
+    cp.put_int(key + ".filled", static_cast<std::int64_t>(m_filled));
+}
+
+void DfeBitHistory::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    const std::vector<std::int64_t>& words = cp.get_int_vector(key + ".words");
+    std::int64_t filled = cp.get_int(key + ".filled");
+    if (words.size() != m_words.size() || filled < 0 ||
+        static_cast<std::size_t>(filled) > m_depth) {
+        throw std::invalid_argument("DfeBitHistory: checkpoint depth mismatch at '" + key + "'");
+    }
+    for (std::size_t i = 0; i < m_words.size(); ++i) {
+        m_words[i] = static_cast<std::uint64_t>(words[i]);
+    }
+    m_filled = static_cast<std::size_t>(filled);
+}
+
+// ============================================================================
+// DfeFeedbackKernel
+// ============================================================================
+DfeFeedbackKernel::DfeFeedbackKernel()
+    : m_pm1(true)
+    , m_vtap(1.0)
+{
+}
+
+void DfeFeedbackKernel::configure(const std::vector<double>& taps, bool pm1, double vtap) {
+    m_pm1 = pm1;
+    m_vtap = vtap;
+    m_taps = taps;
+    m_select.assign(2 * taps.size(), 0.0);
+    for (std::size_t k = 0; k < taps.size(); ++k) {
+        fill_select(k);
+    }
+    m_float_pos.clear();
+    m_float_taps.clear();
+    m_float_select.clear();
+    m_history.resize(taps.size());
+}
+
+void DfeFeedbackKernel::configure_floating(const std::vector<int>& positions,
+                                           const std::vector<double>& coeffs) {
+    if (positions.size() != coeffs.size()) {
+        throw std::invalid_argument("DfeFeedbackKernel: floating position / coefficient count mismatch");
+    }
+    std::size_t depth = m_taps.size();
+    for (int pos : positions) {
+        if (pos <= static_cast<int>(m_taps.size())) {
+            throw std::invalid_argument("DfeFeedbackKernel: floating tap position must be beyond the fixed taps");
+        }
+        depth = std::max(depth, static_cast<std::size_t>(pos));
+    }
+    m_float_pos = positions;
+    m_float_taps = coeffs;
+    m_float_select.assign(2 * coeffs.size(), 0.0);
+    for (std::size_t i = 0; i < coeffs.size(); ++i) {
+        double c = coeffs[i] * m_vtap;
+        m_float_select[2 * i] = m_pm1 ? -c : 0.0;
+        m_float_select[2 * i + 1] = c;
+    }
+    m_history.resize(depth);
+}
+
+bool DfeFeedbackKernel::set_tap(std::size_t k, double value) {
+    if (k >= m_taps.size() || m_taps[k] == value) {
+        return false;
+    }
+    m_taps[k] = value;
+    fill_select(k);
+    return true;
+}
+
+void DfeFeedbackKernel::save_state(StateCheckpoint& cp, const std::string& key) const {
+    cp.put_real(key + ".taps", m_taps);
+    m_history.save_state(cp, key + ".history");
+}
+
+void DfeFeedbackKernel::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    const std::vector<double>& taps = cp.get_real_vector(key + ".taps");
+    if (taps.size() != m_taps.size()) {
+        throw std::invalid_argument("DfeFeedbackKernel: checkpoint tap count mismatch at '" +
+                                    key + "'");
+    }
+    for (std::size_t k = 0; k < taps.size(); ++k) {
+        set_tap(k, taps[k]);
+    }
+    m_history.restore_state(cp, key + ".history");
+}
+
+void DfeFeedbackKernel::fill_select(std::size_t k) {
+    double c = m_taps[k] * m_vtap;
+    m_select[2 * k] = m_pm1 ? -c : 0.0;
+    m_select[2 * k + 1] = c;
+}
+
+double DfeFeedbackKernel::feedback() const {
+    double v_fb = 0.0;
+    const std::size_t n = m_taps.size();
+    const double* sel = m_select.data();
+    const std::size_t words = (n + 63) / 64;   // Floating taps may deepen the history
+    for (std::size_t i = 0, base = 0; i < words; ++i, base += 64) {
+        std::uint64_t w = m_history.word(i);
+        std::size_t end = (n - base < 64) ? (n - base) : 64;
+        for (std::size_t j = 0; j < end; ++j) {
+            v_fb += sel[2 * (base + j) + ((w >> j) & 1u)];
+        }
+    }
+    for (std::size_t i = 0; i < m_float_pos.size(); ++i) {
+        v_fb += m_float_select[2 * i + m_history.bit(static_cast<std::size_t>(m_float_pos[i] - 1))];
+    }
+    return v_fb;
+}
+
+} // namespace serdes
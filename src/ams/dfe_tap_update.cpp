@@ -0,0 +1,180 @@
+#include "ams/dfe_tap_update.h"
+#include <cctype>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace serdes {
+
+DFEUpdateAlgorithm parse_dfe_update_algorithm(const std::string& name) {
+    std::string key;
+    for (char ch : name) {
+        if (ch == '_' || ch == ' ') {
+            key += '-';
+        } else {
+            key += static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        }
+    }
+    if (key == "sign-lms" || key == "sign-sign" || key == "sign-sign-lms" ||
+        key == "ss-lms" || key == "sslms") {
+        return DFEUpdateAlgorithm::SIGN_LMS;
+    }
+    if (key == "lms") return DFEUpdateAlgorithm::LMS;
+    if (key == "nlms") return DFEUpdateAlgorithm::NLMS;
+    if (key == "rls") return DFEUpdateAlgorithm::RLS;
+    if (key == "fixed") return DFEUpdateAlgorithm::FIXED;
+    std::cerr << "Warning: unknown DFE adaptation algorithm '" << name
+              << "', using 'sign-lms'" << std::endl;
+    return DFEUpdateAlgorithm::SIGN_LMS;
+}
+
+bool dfe_update_needs_error_magnitude(DFEUpdateAlgorithm algorithm) {
+    return algorithm == DFEUpdateAlgorithm::LMS ||
+           algorithm == DFEUpdateAlgorithm::NLMS ||
+           algorithm == DFEUpdateAlgorithm::RLS;
+}
+
+DfeTapUpdater::DfeTapUpdater()
+    : m_algorithm(DFEUpdateAlgorithm::SIGN_LMS)
+    , m_num_taps(0)
+    , m_lambda(0.999)
+    , m_delta(1.0)
+    , m_eps(1e-3)
+    , m_pm1(true)
+    , m_vtap(1.0)
+{
+}
+
+void DfeTapUpdater::configure(DFEUpdateAlgorithm algorithm, int num_taps,
+                              double rls_lambda, double rls_delta, double nlms_eps) {
+    if (num_taps < 1) {
+        throw std::invalid_argument("DFE adaptation: num_taps must be >= 1");
+    }
+    if (algorithm == DFEUpdateAlgorithm::RLS) {
+        if (!(rls_lambda > 0.0 && rls_lambda <= 1.0)) {
+            throw std::invalid_argument("DFE adaptation: rls_lambda must be in (0, 1]");
+        }
+        if (!(rls_delta > 0.0)) {
+            throw std::invalid_argument("DFE adaptation: rls_delta must be > 0");
+        }
+    }
+    if (algorithm == DFEUpdateAlgorithm::NLMS && !(nlms_eps >= 0.0)) {
+        throw std::invalid_argument("DFE adaptation: nlms_eps must be >= 0");
+    }
+    m_algorithm = algorithm;
+    m_num_taps = num_taps;
+    m_lambda = rls_lambda;
+    m_delta = rls_delta;
+    m_eps = nlms_eps;
+    m_u.assign(num_taps, 0.0);
+    m_Pu.assign(num_taps, 0.0);
+    reset();
+}
+
+void DfeTapUpdater::set_bit_mapping(bool pm1, double vtap) {
+    m_pm1 = pm1;
+    m_vtap = vtap;
+}
+
+void DfeTapUpdater::reset() {
+    m_P.clear();
+    if (m_algorithm == DFEUpdateAlgorithm::RLS) {
+        m_P.assign(static_cast<size_t>(m_num_taps) * m_num_taps, 0.0);
+        for (int i = 0; i < m_num_taps; ++i) {
+            m_P[static_cast<size_t>(i) * m_num_taps + i] = m_delta;
+        }
+    }
+}
+
+void DfeTapUpdater::save_state(StateCheckpoint& cp, const std::string& key) const {
+    cp.put_real(key + ".P", m_P);
+}
+
+void DfeTapUpdater::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    const std::vector<double>& P = cp.get_real_vector(key + ".P");
+    if (P.size() != m_P.size()) {
+        throw std::invalid_argument("DfeTapUpdater: checkpoint size mismatch at '" + key + "'");
+    }
+    m_P = P;
+}
+
+bool DfeTapUpdater::update(std::vector<double>& taps, const DfeBitHistory& history,
+                           double mu, double sign_err, double error) {
+    const int n = m_num_taps;
+    int filled = static_cast<int>(history.filled());
+    bool sign_sign = m_algorithm == DFEUpdateAlgorithm::SIGN_LMS;
+    double norm = 0.0;
+    for (int i = 0; i < n; ++i) {
+        if (i >= filled) {
+            m_u[i] = 0.0;
+        } else if (sign_sign) {
+            m_u[i] = history.bit(i) ? 1.0 : -1.0;
+        } else {
+            m_u[i] = regressor(history.bit(i));
+        }
+        norm += m_u[i] * m_u[i];
+    }
+
+    switch (m_algorithm) {
+        case DFEUpdateAlgorithm::SIGN_LMS:
+            if (sign_err == 0.0) {
+                return false;
+            }
+            for (int i = 0; i < n; ++i) {
+                taps[i] += mu * sign_err * m_u[i];
+            }
+            return true;
+
+        case DFEUpdateAlgorithm::LMS:
+            for (int i = 0; i < n; ++i) {
+                taps[i] += mu * error * m_u[i];
+            }
+            return true;
+
+        case DFEUpdateAlgorithm::NLMS: {
+            double step = mu * error / (m_eps + norm);
+            for (int i = 0; i < n; ++i) {
+                taps[i] += step * m_u[i];
+            }
+            return true;
+        }
+
+        case DFEUpdateAlgorithm::RLS: {
+            // pi = P u; kappa = lambda + u' pi
+            double kappa = m_lambda;
+            for (int i = 0; i < n; ++i) {
+                const double* row = &m_P[static_cast<size_t>(i) * n];
+                double acc = 0.0;
+                for (int j = 0; j < n; ++j) {
+                    acc += row[j] * m_u[j];
+                }
+                m_Pu[i] = acc;
+                kappa += m_u[i] * acc;
+            }
+            if (!(kappa > 0.0) || !std::isfinite(kappa)) {
+                reset();                // P lost positive definiteness
+                return false;
+            }
+            // c += k e with k = pi / kappa; P = (P - pi pi' / kappa) / lambda,
+            // computed on the upper triangle and mirrored so P stays symmetric
+            double inv_kappa = 1.0 / kappa;
+            double inv_lambda = 1.0 / m_lambda;
+            for (int i = 0; i < n; ++i) {
+                double gi = m_Pu[i] * inv_kappa;
+                taps[i] += gi * error;
+                double* row = &m_P[static_cast<size_t>(i) * n];
+                for (int j = i; j < n; ++j) {
+                    row[j] = (row[j] - gi * m_Pu[j]) * inv_lambda;
+                    m_P[static_cast<size_t>(j) * n + i] = row[j];
+                }
+            }
+            return true;
+        }
+
+        case DFEUpdateAlgorithm::FIXED:
+        default:
+            return false;
+    }
+}
+
+} // namespace serdes
@@ -0,0 +1,465 @@
+#include "ams/eq_optimizer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "../third_party/json.hpp"
+
+using json = nlohmann::json;
+
+namespace serdes {
+
+namespace {
+
+const double NEG_INF = -std::numeric_limits<double>::infinity();
+
+ComParams analyzer_params(const EqOptParams& p) {
+    ComParams cp;
+    cp.ctle_dc_gains = p.ctle_dc_gains;
+    cp.ctle_zeros = p.ctle_zeros;
+    cp.ctle_poles = p.ctle_poles;
+    cp.eta0 = p.eta0;
+    cp.pulse_ui = p.pulse_ui;
+    cp.num_threads = p.num_threads;
+    return cp;
+}
+
+// The VGA gain is searched as a scale factor on the unity-gain pulse
+RxParams unity_vga(const RxParams& rx) {
+    RxParams r = rx;
+    r.vga.dc_gain = 1.0;
+    return r;
+}
+
+// x such that P(N(0,1) > x) = p
+double inverse_q(double p) {
+    double lo = 0.0, hi = 40.0;
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (lo + hi);
+        (0.5 * std::erfc(mid / std::sqrt(2.0)) > p ? lo : hi) = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+// Distance of x outside [lo, hi]: what a limited DFE tap cannot cancel
+double dfe_excess(double x, double lo, double hi) {
+    return x > hi ? x - hi : (x < lo ? lo - x : 0.0);
+}
+
+// UI-spaced cursors of one CTLE pulse for each phase around its peak:
+// row(d)[j + j1] = pulse[peak + d + j * spu], j = -j1..j2 (0 outside the pulse)
+struct CursorTable {
+    int d_lo, d_hi;
+    int j1, j2;
+    double sigma_rx2;
+    std::vector<double> c;
+
+    int width() const { return j1 + j2 + 1; }
+    const double* row(int d) const { return &c[static_cast<size_t>(d - d_lo) * width()]; }
+};
+
+CursorTable build_table(const std::vector<double>& pulse, int spu, int span, double sigma_rx2) {
+    CursorTable t;
+    const int n = static_cast<int>(pulse.size());
+    const int peak = static_cast<int>(std::max_element(pulse.begin(), pulse.end()) - pulse.begin());
+    t.d_lo = std::max(-span, -peak);
+    t.d_hi = std::min(span, n - 1 - peak);
+    t.j1 = (peak + t.d_hi) / spu;
+    t.j2 = (n - 1 - peak - t.d_lo) / spu;
+    t.sigma_rx2 = sigma_rx2;
+    t.c.resize(static_cast<size_t>(t.d_hi - t.d_lo + 1) * t.width());
+    for (int d = t.d_lo; d <= t.d_hi; ++d) {
+        double* r = &t.c[static_cast<size_t>(d - t.d_lo) * t.width()];
+        for (int j = -t.j1; j <= t.j2; ++j) {
+            int idx = peak + d + j * spu;
+            r[j + t.j1] = idx >= 0 && idx < n ? pulse[idx] : 0.0;
+        }
+    }
+    return t;
+}
+
+// Sums of one equalized phase; DFE cursors are kept for the per-VGA excess
+struct PhaseSums {
+    double g0;
+    double isi_abs;
+    double isi_sq;
+    std::vector<double> dfe;
+};
+
+struct Hit {
+    double score;
+    std::uint64_t id;
+    int phase;
+
+    bool operator<(const Hit& o) const {
+        return score > o.score || (score == o.score && id < o.id);
+    }
+};
+
+// Sorted best-first list of at most k hits
+class TopK {
+public:
+    explicit TopK(size_t k) : m_k(k) {}
+
+    double threshold() const { return m_hits.size() < m_k ? NEG_INF : m_hits.back().score; }
+
+    void offer(const Hit& h) {
+        if (m_hits.size() == m_k && !(h < m_hits.back())) {
+            return;
+        }
+        m_hits.insert(std::upper_bound(m_hits.begin(), m_hits.end(), h), h);
+        if (m_hits.size() > m_k) {
+            m_hits.pop_back();
+        }
+    }
+
+    const std::vector<Hit>& hits() const { return m_hits; }
+
+private:
+    size_t m_k;
+    std::vector<Hit> m_hits;
+};
+
+// Candidate evaluation shared by the search and the final report
+class Scorer {
+public:
+    Scorer(const EqOptParams& p, const std::vector<double>& vga, int num_dfe,
+           double dfe_lo, double dfe_hi, double q)
+        : m_eye(p.metric == "eye"), m_vga(vga), m_num_dfe(num_dfe)
+        , m_lo(dfe_lo), m_hi(dfe_hi), m_q(q)
+        , m_slicer2(p.slicer_sigma * p.slicer_sigma) {}
+
+    double sigma(const CursorTable& t, double v) const {
+        return std::sqrt(v * v * t.sigma_rx2 + m_slicer2);
+    }
+
+    // Score at gain v; the DFE excess is left out for the bound (excess >= 0)
+    void score(const CursorTable& t, const PhaseSums& s, double v, bool with_dfe,
+               double& eye, double& snr_db) const {
+        double excess = 0.0, excess2 = 0.0;
+        if (with_dfe) {
+            for (double g : s.dfe) {
+                double e = dfe_excess(v * g, m_lo, m_hi);
+                excess += e;
+                excess2 += e * e;
+            }
+        }
+        double sig = sigma(t, v);
+        eye = v * (s.g0 - s.isi_abs) - excess - m_q * sig;
+        double denom = v * v * s.isi_sq + excess2 + sig * sig;
+        double sig_pow = v * v * s.g0 * s.g0;
+        snr_db = denom > 0.0 ? 10.0 * std::log10(sig_pow / denom)
+                             : std::numeric_limits<double>::infinity();
+    }
+
+    double metric(const CursorTable& t, const PhaseSums& s, double v, bool with_dfe) const {
+        double eye, snr;
+        score(t, s, v, with_dfe, eye, snr);
+        return m_eye ? eye : snr;
+    }
+
+    double bound(const CursorTable& t, const PhaseSums& s) const {
+        double b = NEG_INF;
+        for (double v : m_vga) b = std::max(b, metric(t, s, v, false));
+        return b;
+    }
+
+    /**
+     * Equalize one phase and sum its ISI, nearest cursors first; returns
+     * false as soon as the running bound drops below `threshold`
+     */
+    bool sum_phase(const CursorTable& t, int d, const std::vector<double>& taps, int pre,
+                   double threshold, std::vector<double>& g, PhaseSums& s) const {
+        const int T = static_cast<int>(taps.size());
+        const int w = t.width();
+        const double* c = t.row(d);
+
+        // Main cursor alone first: sum_i f_i c[pre - i]
+        s.g0 = 0.0;
+        for (int i = 0; i < T; ++i) {
+            int j = pre - i;
+            if (j >= -t.j1 && j <= t.j2) s.g0 += taps[i] * c[j + t.j1];
+        }
+        s.isi_abs = 0.0;
+        s.isi_sq = 0.0;
+        s.dfe.clear();
+        if (!(s.g0 > 0.0) || bound(t, s) < threshold) {
+            return false;
+        }
+
+        // g[k + j1 + pre] = sum_i f_i c[k - i + pre], k = -(j1 + pre) .. j2 + post
+        g.assign(w + T - 1, 0.0);
+        for (int i = 0; i < T; ++i) {
+            if (taps[i] == 0.0) continue;
+            for (int j = 0; j < w; ++j) g[j + i] += taps[i] * c[j];
+        }
+        const int k_min = -(t.j1 + pre);
+        const int k_max = static_cast<int>(g.size()) - 1 + k_min;
+        for (int k = 1; k <= m_num_dfe; ++k) {
+            s.dfe.push_back(k <= k_max ? g[k - k_min] : 0.0);
+        }
+        for (int dist = 1, n = 0; -dist >= k_min || m_num_dfe + dist <= k_max; ++dist) {
+            for (int k : {-dist, m_num_dfe + dist}) {
+                if (k < k_min || k > k_max) continue;
+                double x = g[k - k_min];
+                s.isi_abs += std::fabs(x);
+                s.isi_sq += x * x;
+                if (++n % 8 == 0 && bound(t, s) < threshold) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    bool m_eye;
+    const std::vector<double>& m_vga;
+    int m_num_dfe;
+    double m_lo, m_hi, m_q;
+    double m_slicer2;
+};
+
+std::vector<double> full_taps(const std::vector<double>& others, int pre) {
+    std::vector<double> taps;
+    double main = 1.0;
+    for (double x : others) main -= std::fabs(x);
+    for (int i = 0; i < static_cast<int>(others.size()); ++i) {
+        if (i == pre) taps.push_back(main);
+        taps.push_back(others[i]);
+    }
+    if (static_cast<int>(taps.size()) == pre) taps.push_back(main);
+    return taps;
+}
+
+} // namespace
+
+EqOptimizer::EqOptimizer(const EqOptParams& params, const TxParams& tx, const RxParams& rx,
+                         const AdaptionParams& adaption, double ui, int samples_per_ui)
+    : m_params(params)
+    , m_spu(samples_per_ui)
+    , m_num_dfe(adaption.dfe_num_taps())
+    , m_vtap(rx.dfe_summer.vtap)
+    , m_dfe_lo(std::min(adaption.dfe.tap_min * rx.dfe_summer.vtap, adaption.dfe.tap_max * rx.dfe_summer.vtap))
+    , m_dfe_hi(std::max(adaption.dfe.tap_min * rx.dfe_summer.vtap, adaption.dfe.tap_max * rx.dfe_summer.vtap))
+    , m_q(0.0)
+    , m_analyzer(analyzer_params(params), tx, unity_vga(rx), adaption, ui, samples_per_ui)
+{
+    if (params.metric != "eye" && params.metric != "snr") {
+        throw std::invalid_argument("EqOpt: metric must be 'eye' or 'snr'. Current value: " +
+                                    params.metric);
+    }
+    if (params.ffe_pre < 0 || params.ffe_post < 0 || params.ffe_max < 0.0 || params.ffe_max >= 1.0 ||
+        (params.ffe_pre + params.ffe_post > 0 && !(params.ffe_step > 0.0))) {
+        throw std::invalid_argument("EqOpt: FFE grid needs pre/post >= 0, 0 <= ffe_max < 1, ffe_step > 0");
+    }
+    if (!(params.target_ber > 0.0 && params.target_ber < 0.5)) {
+        throw std::invalid_argument("EqOpt: target_ber must be in (0, 0.5)");
+    }
+    if (params.phase_span < 0 || params.top_k < 1 || params.slicer_sigma < 0.0) {
+        throw std::invalid_argument("EqOpt: phase_span/slicer_sigma must be >= 0 and top_k >= 1");
+    }
+    m_vga = params.vga_gains.empty() ? std::vector<double>(1, rx.vga.dc_gain) : params.vga_gains;
+    for (double v : m_vga) {
+        if (!(v > 0.0)) {
+            throw std::invalid_argument("EqOpt: VGA gains must be positive");
+        }
+    }
+    m_q = inverse_q(params.target_ber);
+
+    // Non-main taps on a symmetric grid, keeping the main tap positive
+    const int n_other = params.ffe_pre + params.ffe_post;
+    const int levels = n_other > 0 ? 2 * static_cast<int>(std::floor(params.ffe_max / params.ffe_step + 1e-9)) + 1 : 1;
+    std::vector<int> digit(n_other, 0);
+    for (;;) {
+        std::vector<double> others(n_other);
+        double sum = 0.0;
+        for (int i = 0; i < n_other; ++i) {
+            others[i] = (digit[i] - (levels - 1) / 2) * params.ffe_step;
+            sum += std::fabs(others[i]);
+        }
+        if (sum < 1.0) {
+            m_ffe_grid.push_back(others);
+        }
+        int i = 0;
+        while (i < n_other && ++digit[i] == levels) digit[i++] = 0;
+        if (i == n_other) break;
+    }
+}
+
+std::uint64_t EqOptimizer::get_num_candidates() const {
+    return static_cast<std::uint64_t>(m_analyzer.get_num_ctle()) * m_ffe_grid.size() * m_vga.size();
+}
+
+EqOptResult EqOptimizer::optimize(const std::vector<std::complex<double>>& channel) const {
+    const int num_ctle = m_analyzer.get_num_ctle();
+    const int num_ffe = static_cast<int>(m_ffe_grid.size());
+    const int num_vga = static_cast<int>(m_vga.size());
+    const int pre = m_params.ffe_pre;
+
+    std::vector<CursorTable> tables;
+    for (int c = 0; c < num_ctle; ++c) {
+        tables.push_back(build_table(m_analyzer.pulse_response(channel, c), m_spu,
+                                     m_params.phase_span, m_analyzer.get_rx_noise_var(c)));
+    }
+    const Scorer scorer(m_params, m_vga, m_num_dfe, m_dfe_lo, m_dfe_hi, m_q);
+
+    // Work items: one CTLE setting x a slice of the FFE grid
+    const int slice = 256;
+    const int slices = (num_ffe + slice - 1) / slice;
+    const int num_items = num_ctle * slices;
+    int num_threads = m_params.num_threads > 0
+                      ? m_params.num_threads
+                      : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    num_threads = std::max(1, std::min(num_threads, num_items));
+    std::vector<TopK> tops(num_threads, TopK(m_params.top_k));
+    std::vector<std::uint64_t> pruned(num_threads, 0);
+    std::atomic<int> next_item(0);
+
+    auto worker = [&](int w) {
+        TopK& top = tops[w];
+        std::vector<double> g;
+        PhaseSums s;
+        std::vector<double> best(num_vga);
+        std::vector<int> best_d(num_vga);
+        for (int item = next_item++; item < num_items; item = next_item++) {
+            const int c = item / slices;
+            const CursorTable& t = tables[c];
+            const int f_end = std::min(num_ffe, (item % slices + 1) * slice);
+            for (int f = (item % slices) * slice; f < f_end; ++f) {
+                std::vector<double> taps = full_taps(m_ffe_grid[f], pre);
+                std::fill(best.begin(), best.end(), NEG_INF);
+                bool evaluated = false;
+                for (int d = t.d_lo; d <= t.d_hi; ++d) {
+                    if (!scorer.sum_phase(t, d, taps, pre, top.threshold(), g, s)) {
+                        continue;
+                    }
+                    evaluated = true;
+                    for (int v = 0; v < num_vga; ++v) {
+                        double m = scorer.metric(t, s, m_vga[v], true);
+                        if (m > best[v]) {
+                            best[v] = m;
+                            best_d[v] = d;
+                        }
+                    }
+                }
+                if (!evaluated) {
+                    pruned[w] += num_vga;
+                    continue;
+                }
+                for (int v = 0; v < num_vga; ++v) {
+                    if (best[v] > NEG_INF) {
+                        Hit h = {best[v], (static_cast<std::uint64_t>(c) * num_ffe + f) * num_vga + v,
+                                 best_d[v]};
+                        top.offer(h);
+                    }
+                }
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int w = 1; w < num_threads; ++w) {
+        pool.emplace_back(worker, w);
+    }
+    worker(0);
+    for (std::thread& t : pool) {
+        t.join();
+    }
+
+    // Merge the private lists and rebuild the reported configurations
+    TopK merged(m_params.top_k);
+    EqOptResult result;
+    result.num_candidates = get_num_candidates();
+    result.num_pruned = 0;
+    for (int w = 0; w < num_threads; ++w) {
+        for (const Hit& h : tops[w].hits()) merged.offer(h);
+        result.num_pruned += pruned[w];
+    }
+    for (const Hit& h : merged.hits()) {
+        const int v = static_cast<int>(h.id % num_vga);
+        const int f = static_cast<int>((h.id / num_vga) % num_ffe);
+        const int c = static_cast<int>(h.id / num_vga / num_ffe);
+        EqCandidate cand;
+        cand.ffe_taps = full_taps(m_ffe_grid[f], pre);
+        std::vector<double> g;
+        PhaseSums s;
+        scorer.sum_phase(tables[c], h.phase, cand.ffe_taps, pre, NEG_INF, g, s);
+        scorer.score(tables[c], s, m_vga[v], true, cand.eye_height, cand.snr_db);
+        cand.score = h.score;
+        cand.phase = static_cast<double>(h.phase) / m_spu;
+        cand.ctle = m_analyzer.get_ctle(c);
+        cand.vga_gain = m_vga[v];
+        for (double x : s.dfe) {
+            cand.dfe_taps.push_back(std::max(m_dfe_lo, std::min(m_dfe_hi, m_vga[v] * x)) / m_vtap);
+        }
+        result.best.push_back(cand);
+    }
+    return result;
+}
+
+void apply_eq_candidate(const EqCandidate& c, int samples_per_ui,
+                        TxParams& tx, RxParams& rx, AdaptionParams& adaption) {
+    tx.ffe.taps = c.ffe_taps;
+    tx.ffe.tap_spacing = samples_per_ui;
+    if (!rx.ctle.zeros.empty()) rx.ctle.zeros[0] = c.ctle.zero;
+    if (!rx.ctle.poles.empty()) rx.ctle.poles[0] = c.ctle.pole;
+    rx.ctle.dc_gain = c.ctle.dc_gain;
+    rx.vga.dc_gain = c.vga_gain;
+    rx.dfe_summer.tap_coeffs = c.dfe_taps;
+    adaption.dfe.initial_taps = c.dfe_taps;
+}
+
+bool save_eq_candidate(const std::string& path, const EqCandidate& c, int rank,
+                       const std::string& metric) {
+    json j;
+    j["tx"]["ffe_taps"] = c.ffe_taps;
+    j["rx"]["ctle"]["zero"] = c.ctle.zero;
+    j["rx"]["ctle"]["pole"] = c.ctle.pole;
+    j["rx"]["ctle"]["dc_gain"] = c.ctle.dc_gain;
+    j["rx"]["vga"]["gain"] = c.vga_gain;
+    j["rx"]["dfe"]["taps"] = c.dfe_taps;
+    j["eq_opt"]["rank"] = rank;
+    j["eq_opt"]["metric"] = metric;
+    j["eq_opt"]["score"] = c.score;
+    j["eq_opt"]["eye_height"] = c.eye_height;
+    j["eq_opt"]["snr_db"] = c.snr_db;
+    j["eq_opt"]["phase_ui"] = c.phase;
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << j.dump(2) << "\n";
+    return static_cast<bool>(file);
+}
+
+EqCandidate load_eq_candidate(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("EqOpt: cannot open " + path);
+    }
+    EqCandidate c;
+    try {
+        json j = json::parse(file);
+        c.ffe_taps = j.at("tx").at("ffe_taps").get<std::vector<double>>();
+        const json& rx = j.at("rx");
+        c.ctle.zero = rx.at("ctle").at("zero").get<double>();
+        c.ctle.pole = rx.at("ctle").at("pole").get<double>();
+        c.ctle.dc_gain = rx.at("ctle").at("dc_gain").get<double>();
+        c.vga_gain = rx.at("vga").at("gain").get<double>();
+        c.dfe_taps = rx.at("dfe").at("taps").get<std::vector<double>>();
+        const json& info = j.value("eq_opt", json::object());
+        c.score = info.value("score", 0.0);
+        c.eye_height = info.value("eye_height", 0.0);
+        c.snr_db = info.value("snr_db", 0.0);
+        c.phase = info.value("phase_ui", 0.0);
+    } catch (const json::exception& e) {
+        throw std::invalid_argument("EqOpt: malformed candidate " + path + ": " + e.what());
+    }
+    return c;
+}
+
+} // namespace serdes
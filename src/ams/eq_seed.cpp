@@ -0,0 +1,319 @@
+#include "ams/eq_seed.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace serdes {
+
+// ============================================================================
+// Pulse response cascade
+// ============================================================================
+
+PulseResponseCascade::PulseResponseCascade(double timestep)
+    : m_timestep(timestep)
+{
+    if (timestep <= 0.0) {
+        throw std::invalid_argument("EqSeed: timestep must be positive");
+    }
+}
+
+void PulseResponseCascade::add_zero_pole(const std::vector<double>& zeros,
+                                         const std::vector<double>& poles, double dc_gain) {
+    CtleCoeffBank bank;
+    bank.configure(zeros, poles, m_timestep);
+    // The base setting: first zero/pole as configured
+    double fz = 0.0;
+    double fp = 0.0;
+    for (double z : zeros) if (z > 0.0) { fz = z; break; }
+    for (double p : poles) if (p > 0.0) { fp = p; break; }
+    m_stages.push_back(bank.get(bank.find_or_build(fz, fp, dc_gain)));
+}
+
+void PulseResponseCascade::add_simple_channel(double attenuation_db, double bandwidth_hz) {
+    // Same discretization as ChannelSParamTdf::init_simple_model():
+    // y = alpha * x + (1 - alpha) * y[n-1]
+    double omega_c = 2.0 * M_PI * bandwidth_hz;
+    double alpha = omega_c * m_timestep / (1.0 + omega_c * m_timestep);
+
+    CtleCoeffSet set;
+    set.zero = 0.0;
+    set.pole = bandwidth_hz;
+    set.dc_gain = std::pow(10.0, -attenuation_db / 20.0);
+    CtleSectionCoeffs c;
+    c.b0 = alpha;
+    c.b1 = 0.0;
+    c.a1 = -(1.0 - alpha);
+    set.sections.push_back(c);
+    m_stages.push_back(set);
+}
+
+std::vector<double> PulseResponseCascade::pulse(int samples_per_ui, int num_ui,
+                                                double amplitude) const {
+    if (samples_per_ui < 1 || num_ui < 1) {
+        throw std::invalid_argument("EqSeed: samples_per_ui and num_ui must be >= 1");
+    }
+    std::vector<CtleSectionCascade> states(m_stages.size());
+    for (size_t s = 0; s < m_stages.size(); ++s) {
+        states[s].resize(static_cast<int>(m_stages[s].sections.size()));
+    }
+
+    size_t n = static_cast<size_t>(samples_per_ui) * num_ui;
+    std::vector<double> out(n);
+    for (size_t i = 0; i < n; ++i) {
+        double x = (i < static_cast<size_t>(samples_per_ui)) ? amplitude : 0.0;
+        for (size_t s = 0; s < m_stages.size(); ++s) {
+            x = states[s].process(m_stages[s], x);
+        }
+        out[i] = x;
+    }
+    return out;
+}
+
+// ============================================================================
+// Cursor extraction
+// ============================================================================
+
+PulseCursors extract_cursors(const std::vector<double>& pulse, int samples_per_ui,
+                             int num_pre, int num_post) {
+    if (pulse.empty() || samples_per_ui < 1) {
+        throw std::invalid_argument("EqSeed: empty pulse or samples_per_ui < 1");
+    }
+    if (num_pre < 0 || num_post < 0) {
+        throw std::invalid_argument("EqSeed: cursor counts must be >= 0");
+    }
+    PulseCursors c;
+    c.num_pre = num_pre;
+    c.main_sample = static_cast<int>(
+        std::max_element(pulse.begin(), pulse.end()) - pulse.begin());
+    c.h.assign(num_pre + 1 + num_post, 0.0);
+    for (int k = -num_pre; k <= num_post; ++k) {
+        long idx = c.main_sample + static_cast<long>(k) * samples_per_ui;
+        if (idx >= 0 && idx < static_cast<long>(pulse.size())) {
+            c.h[num_pre + k] = pulse[idx];
+        }
+    }
+    return c;
+}
+
+// ============================================================================
+// ZF / MMSE solve
+// ============================================================================
+
+EqSeedCriterion parse_eq_seed_criterion(const std::string& name) {
+    if (name == "zf") return EqSeedCriterion::ZERO_FORCING;
+    if (name == "mmse") return EqSeedCriterion::MMSE;
+    throw std::invalid_argument(
+        "EqSeed: criterion must be 'zf' or 'mmse'. Current value: " + name);
+}
+
+namespace {
+
+// g = f * h
+std::vector<double> convolve(const std::vector<double>& f, const std::vector<double>& h) {
+    std::vector<double> g(f.size() + h.size() - 1, 0.0);
+    for (size_t i = 0; i < f.size(); ++i) {
+        for (size_t j = 0; j < h.size(); ++j) {
+            g[i + j] += f[i] * h[j];
+        }
+    }
+    return g;
+}
+
+// Solve A x = b (row-major n x n) by Gaussian elimination with partial pivoting
+std::vector<double> solve_dense(std::vector<double> A, std::vector<double> b) {
+    const size_t n = b.size();
+    for (size_t col = 0; col < n; ++col) {
+        size_t piv = col;
+        for (size_t r = col + 1; r < n; ++r) {
+            if (std::abs(A[r * n + col]) > std::abs(A[piv * n + col])) piv = r;
+        }
+        if (!(std::abs(A[piv * n + col]) > 0.0)) {
+            throw std::invalid_argument("EqSeed: singular equalizer system");
+        }
+        if (piv != col) {
+            for (size_t k = 0; k < n; ++k) std::swap(A[col * n + k], A[piv * n + k]);
+            std::swap(b[col], b[piv]);
+        }
+        for (size_t r = col + 1; r < n; ++r) {
+            double m = A[r * n + col] / A[col * n + col];
+            for (size_t k = col; k < n; ++k) A[r * n + k] -= m * A[col * n + k];
+            b[r] -= m * b[col];
+        }
+    }
+    std::vector<double> x(n, 0.0);
+    for (size_t i = n; i-- > 0;) {
+        double acc = b[i];
+        for (size_t k = i + 1; k < n; ++k) acc -= A[i * n + k] * x[k];
+        x[i] = acc / A[i * n + i];
+    }
+    return x;
+}
+
+} // namespace
+
+EqSeedResult compute_eq_seed(const PulseCursors& cursors, int num_ffe, int ffe_main,
+                             int num_dfe, double vtap, EqSeedCriterion criterion,
+                             double noise_sigma) {
+    const std::vector<double>& h = cursors.h;
+    if (h.empty() || cursors.num_pre < 0 || cursors.num_pre >= static_cast<int>(h.size())) {
+        throw std::invalid_argument("EqSeed: invalid cursor set");
+    }
+    if (num_dfe < 0 || vtap == 0.0) {
+        throw std::invalid_argument("EqSeed: num_dfe must be >= 0 and vtap non-zero");
+    }
+    if (num_ffe > 1 && (ffe_main < 0 || ffe_main >= num_ffe)) {
+        throw std::invalid_argument("EqSeed: ffe_main must be in [0, ffe_taps)");
+    }
+
+    std::vector<double> f(1, 1.0);
+    int m = 0;
+    if (num_ffe > 1) {
+        m = ffe_main;
+        const int L = static_cast<int>(h.size());
+        const int Lg = L + num_ffe - 1;
+        const int t0 = cursors.num_pre + m;
+
+        // Normal equations over the rows outside the DFE span
+        std::vector<double> A(static_cast<size_t>(num_ffe) * num_ffe, 0.0);
+        std::vector<double> b(num_ffe, 0.0);
+        for (int t = 0; t < Lg; ++t) {
+            if (t > t0 && t <= t0 + num_dfe) {
+                continue;           // Cancelled by the DFE
+            }
+            double target = (t == t0) ? 1.0 : 0.0;
+            for (int i = 0; i < num_ffe; ++i) {
+                int ji = t - i;
+                double hi = (ji >= 0 && ji < L) ? h[ji] : 0.0;
+                if (hi == 0.0) continue;
+                b[i] += hi * target;
+                for (int k = 0; k < num_ffe; ++k) {
+                    int jk = t - k;
+                    double hk = (jk >= 0 && jk < L) ? h[jk] : 0.0;
+                    A[static_cast<size_t>(i) * num_ffe + k] += hi * hk;
+                }
+            }
+        }
+        double trace = 0.0;
+        for (int i = 0; i < num_ffe; ++i) trace += A[static_cast<size_t>(i) * num_ffe + i];
+        double lambda = (criterion == EqSeedCriterion::MMSE)
+                        ? noise_sigma * noise_sigma
+                        : 1e-12 * trace / num_ffe;
+        lambda = std::max(lambda, 1e-12 * trace / num_ffe);
+        for (int i = 0; i < num_ffe; ++i) A[static_cast<size_t>(i) * num_ffe + i] += lambda;
+        f = solve_dense(A, b);
+
+        // TX peak-swing constraint
+        double norm = 0.0;
+        for (double v : f) norm += std::abs(v);
+        if (!(norm > 0.0) || !std::isfinite(norm)) {
+            throw std::invalid_argument("EqSeed: degenerate FFE solution");
+        }
+        for (double& v : f) v /= norm;
+    }
+
+    EqSeedResult r;
+    r.ffe_taps = f;
+    r.combined = convolve(f, h);
+    r.main_index = cursors.num_pre + m;
+    r.main_cursor = r.combined[r.main_index];
+    r.dfe_taps.assign(num_dfe, 0.0);
+    r.residual_isi = 0.0;
+    for (int t = 0; t < static_cast<int>(r.combined.size()); ++t) {
+        int k = t - r.main_index;
+        if (k >= 1 && k <= num_dfe) {
+            r.dfe_taps[k - 1] = r.combined[t] / vtap;
+        } else if (k != 0) {
+            r.residual_isi += std::abs(r.combined[t]);
+        }
+    }
+    return r;
+}
+
+// ============================================================================
+// Link-level helpers
+// ============================================================================
+
+double driver_symbol_level(const TxDriverParams& driver) {
+    double x = 2.0 * driver.dc_gain;
+    double vsat = driver.vswing / 2.0;
+    if (driver.sat_mode == "soft" && vsat > 0.0 && driver.vlin > 0.0) {
+        return vsat * std::tanh(x / driver.vlin);
+    } else if (driver.sat_mode == "hard" && vsat > 0.0) {
+        return std::max(-vsat, std::min(vsat, x));
+    }
+    return x;
+}
+
+std::vector<double> link_pulse_response(const TxParams& tx, const ChannelParams& channel,
+                                        const RxParams& rx, double timestep,
+                                        int samples_per_ui, int num_ui) {
+    PulseResponseCascade cascade(timestep);
+    cascade.add_zero_pole({}, tx.driver.poles, 1.0);
+    cascade.add_simple_channel(channel.attenuation_db, channel.bandwidth_hz);
+    cascade.add_zero_pole(rx.ctle.zeros, rx.ctle.poles, rx.ctle.dc_gain);
+    cascade.add_zero_pole(rx.vga.zeros, rx.vga.poles, rx.vga.dc_gain);
+
+    return cascade.pulse(samples_per_ui, num_ui, driver_symbol_level(tx.driver));
+}
+
+std::vector<double> apply_ffe_to_pulse(const std::vector<double>& pulse, const TxFfeParams& ffe) {
+    if (ffe.taps.empty()) {
+        return pulse;
+    }
+    std::vector<double> shaped(pulse.size(), 0.0);
+    size_t spacing = static_cast<size_t>(std::max(ffe.tap_spacing, 1));
+    for (size_t i = 0; i < ffe.taps.size(); ++i) {
+        for (size_t n = i * spacing; n < pulse.size(); ++n) {
+            shaped[n] += ffe.taps[i] * pulse[n - i * spacing];
+        }
+    }
+    return shaped;
+}
+
+EqSeedResult compute_link_eq_seed(const EqSeedParams& seed, const TxParams& tx,
+                                  const ChannelParams& channel, const RxParams& rx,
+                                  const AdaptionParams& adaption,
+                                  double timestep, int samples_per_ui) {
+    if (seed.pulse_ui < 2) {
+        throw std::invalid_argument("EqSeed: pulse_ui must be >= 2");
+    }
+    EqSeedCriterion criterion = parse_eq_seed_criterion(seed.criterion);
+    std::vector<double> pulse = link_pulse_response(tx, channel, rx, timestep,
+                                                    samples_per_ui, seed.pulse_ui);
+
+    // Keeping the configured FFE: apply it at its own tap spacing in the
+    // sample domain, then solve the DFE alone
+    bool solve_ffe = seed.ffe_taps > 1;
+    if (!solve_ffe) {
+        pulse = apply_ffe_to_pulse(pulse, tx.ffe);
+    }
+
+    int num_dfe = adaption.dfe.num_taps;
+    int num_pre = solve_ffe ? seed.ffe_main + 2 : 2;
+    int num_post = std::max(num_dfe, solve_ffe ? seed.ffe_taps : 0) + 8;
+    PulseCursors cursors = extract_cursors(pulse, samples_per_ui, num_pre, num_post);
+
+    EqSeedResult r = compute_eq_seed(cursors, solve_ffe ? seed.ffe_taps : 1, seed.ffe_main,
+                                     num_dfe, rx.dfe_summer.vtap, criterion,
+                                     seed.noise_sigma);
+    if (!solve_ffe) {
+        r.ffe_taps = tx.ffe.taps;
+    }
+    return r;
+}
+
+void apply_eq_seed(const EqSeedResult& result, bool ffe_solved, int samples_per_ui,
+                   TxParams& tx, RxParams& rx, AdaptionParams& adaption) {
+    if (ffe_solved) {
+        tx.ffe.taps = result.ffe_taps;
+        tx.ffe.tap_spacing = samples_per_ui;
+    }
+    std::vector<double> taps = result.dfe_taps;
+    for (double& c : taps) {
+        c = std::max(adaption.dfe.tap_min, std::min(adaption.dfe.tap_max, c));
+    }
+    rx.dfe_summer.tap_coeffs = taps;
+    adaption.dfe.initial_taps = taps;
+}
+
+} // namespace serdes
@@ -0,0 +1,164 @@
+#include "ams/eye_histogram_tdf.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace serdes {
+
+EyeHistogramTdf::EyeHistogramTdf(sc_core::sc_module_name nm, const BathtubParams& params,
+                                 const PrbsCheckerParams& checker)
+    : sca_tdf::sca_module(nm)
+    , in_p("in_p")
+    , in_n("in_n")
+    , sampling_trigger("sampling_trigger")
+    , data_in("data_in")
+    , m_params(params)
+    , m_use_reference(params.reference == "prbs")
+    , m_hist(1, 2, -1.0, 1.0)          // Sized in initialize() once the timestep is known
+    , m_samples_per_ui(1)
+    , m_slot(0)
+    , m_warmup_left(0)
+    , m_aligned(false)
+    , m_center(0)
+    , m_fill(0)
+    , m_num_ui(0)
+    , m_ring_pos(0)
+    , m_hold(0)
+    , m_num_errors(0)
+{
+    validate_bathtub_params(params);
+    if (m_use_reference) {
+        m_reference.configure(checker);
+        sampling_trigger.init(1);
+        data_in.init(1);
+    }
+}
+
+void EyeHistogramTdf::set_attributes() {
+    in_p.set_rate(1);
+    in_n.set_rate(1);
+    for (auto& port : sampling_trigger) {
+        port.set_rate(1);
+    }
+    for (auto& port : data_in) {
+        port.set_rate(1);
+    }
+}
+
+void EyeHistogramTdf::initialize() {
+    double dt = get_timestep().to_seconds();
+    m_samples_per_ui = std::max(1, static_cast<int>(std::lround(m_params.ui / dt)));
+    m_hist = EyeHistogram(m_samples_per_ui, m_params.num_bins, -m_params.v_range, m_params.v_range);
+    m_abs_sum.assign(m_samples_per_ui, 0.0);
+    m_window.assign(m_samples_per_ui, 0.0);
+    m_slot = 0;
+    m_warmup_left = m_params.warmup_ui;
+    m_aligned = false;
+    m_center = 0;
+    m_fill = 0;
+    m_num_ui = 0;
+
+    // A window is complete spu - 1 - spu/2 samples after its trigger, the
+    // decision decision_latency samples after it
+    const int spu = m_samples_per_ui;
+    m_hold = std::max(spu - 1 - spu / 2, m_params.decision_latency);
+    m_ring.assign(static_cast<size_t>(m_hold + spu / 2 + 1), 0.0);
+    m_ring_pos = 0;
+    m_pending.clear();
+    m_reference.reset();
+    m_num_errors = 0;
+}
+
+void EyeHistogramTdf::processing() {
+    double v = in_p.read() - in_n.read();
+    if (m_use_reference) {
+        accumulate_reference(v);
+    } else {
+        accumulate_center(v);
+    }
+}
+
+void EyeHistogramTdf::accumulate_center(double v) {
+    const int spu = m_samples_per_ui;
+    int slot = m_slot;
+    if (++m_slot == spu) {
+        m_slot = 0;
+    }
+
+    if (!m_aligned) {
+        m_abs_sum[slot] += std::fabs(v);
+        if (m_slot == 0 && --m_warmup_left == 0) {
+            m_center = static_cast<int>(std::max_element(m_abs_sum.begin(), m_abs_sum.end()) -
+                                        m_abs_sum.begin());
+            m_aligned = true;
+        }
+        return;
+    }
+
+    // Windows run from center - spu/2 to center + spu/2 - 1
+    if (m_fill == 0 && slot != (m_center - spu / 2 + spu) % spu) {
+        return;
+    }
+    m_window[m_fill++] = v;
+    if (m_fill < spu) {
+        return;
+    }
+    bool one = m_window[spu / 2] > m_params.threshold;
+    for (int p = 0; p < spu; ++p) {
+        m_hist.add(p, one, m_window[p]);
+    }
+    m_fill = 0;
+    ++m_num_ui;
+}
+
+void EyeHistogramTdf::accumulate_reference(double v) {
+    const int spu = m_samples_per_ui;
+    const int size = static_cast<int>(m_ring.size());
+    m_ring[m_ring_pos] = v;
+    const int newest = m_ring_pos;
+    if (++m_ring_pos == size) {
+        m_ring_pos = 0;
+    }
+    for (int& age : m_pending) {
+        ++age;
+    }
+    if (sampling_trigger[0].read()) {
+        m_pending.push_back(0);
+    }
+
+    while (!m_pending.empty() && m_pending.front() >= m_hold) {
+        const int age = m_pending.front();
+        m_pending.pop_front();
+        bool was_locked = m_reference.is_locked();
+        bool bit = data_in[0].read() > 0.5;
+        m_reference.push(bit);
+        if (m_warmup_left > 0) {
+            if (--m_warmup_left == 0) {
+                m_aligned = true;
+            }
+            continue;
+        }
+        if (!was_locked) {
+            continue;
+        }
+        bool one = m_reference.get_expected();
+        if (bit != one) {
+            ++m_num_errors;
+        }
+        // Sample p of the window is age - (p - spu/2) samples old
+        for (int p = 0; p < spu; ++p) {
+            int idx = (newest - (age - p + spu / 2)) % size;
+            m_hist.add(p, one, m_ring[idx < 0 ? idx + size : idx]);
+        }
+        ++m_num_ui;
+    }
+}
+
+BathtubResult EyeHistogramTdf::compute() const {
+    if (m_num_ui == 0) {
+        throw std::invalid_argument("EyeHistogramTdf: no UI accumulated");
+    }
+    return compute_bathtub(m_hist, m_params);
+}
+
+} // namespace serdes
@@ -0,0 +1,111 @@
+#include "ams/flight_recorder.h"
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+namespace serdes {
+
+void validate_flight_recorder_params(const FlightRecorderParams& params) {
+    if (!(params.ui > 0.0)) {
+        throw std::invalid_argument("FlightRecorder: ui must be positive");
+    }
+    if (params.pre_ui < 0 || params.post_ui < 1) {
+        throw std::invalid_argument("FlightRecorder: need pre_ui >= 0 and post_ui >= 1");
+    }
+    if (params.decimation < 1 || params.max_captures < 0) {
+        throw std::invalid_argument("FlightRecorder: need decimation >= 1 and max_captures >= 0");
+    }
+    if (params.tap_bound < 0.0) {
+        throw std::invalid_argument("FlightRecorder: tap_bound must be >= 0");
+    }
+}
+
+FlightRecorder::FlightRecorder(const std::vector<std::string>& channels, int pre_samples,
+                               int post_samples, int max_captures)
+    : m_channels(channels)
+    , m_num_channels(channels.size())
+    , m_capacity(0)
+    , m_post_samples(post_samples)
+    , m_max_captures(max_captures)
+    , m_head(0)
+    , m_size(0)
+    , m_capturing(false)
+    , m_post_left(0)
+    , m_num_captures(0)
+    , m_num_triggers(0)
+    , m_trigger_time(0.0)
+{
+    if (channels.empty() || pre_samples < 0 || post_samples < 1 || max_captures < 0) {
+        throw std::invalid_argument("FlightRecorder: need channels, pre_samples >= 0, post_samples >= 1, max_captures >= 0");
+    }
+    m_capacity = static_cast<size_t>(pre_samples) + 1 + static_cast<size_t>(post_samples);
+    m_time.assign(m_capacity, 0.0);
+    m_data.assign(m_capacity * m_num_channels, 0.0);
+    m_bounds.assign(m_num_channels, 0.0);
+    m_over.assign(m_num_channels, 0);
+}
+
+void FlightRecorder::set_bound(size_t channel, double bound) {
+    m_bounds.at(channel) = bound;
+}
+
+bool FlightRecorder::push(double time, const double* values) {
+    m_time[m_head] = time;
+    double* row = &m_data[m_head * m_num_channels];
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        row[c] = values[c];
+    }
+    m_head = (m_head + 1) % m_capacity;
+    if (m_size < m_capacity) ++m_size;
+
+    bool done = false;
+    if (m_capturing && --m_post_left == 0) {
+        m_capturing = false;
+        done = true;
+    }
+
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        if (m_bounds[c] <= 0.0) continue;
+        bool over = std::fabs(values[c]) > m_bounds[c];
+        if (over && !m_over[c]) {
+            // The completed capture must be written first: fire on the next sample
+            if (done) continue;
+            trigger(m_channels[c] + " out of bound");
+        }
+        m_over[c] = over ? 1 : 0;
+    }
+    return done;
+}
+
+bool FlightRecorder::trigger(const std::string& reason) {
+    ++m_num_triggers;
+    if (m_capturing || m_num_captures >= m_max_captures) {
+        return false;
+    }
+    m_capturing = true;
+    m_post_left = m_post_samples;
+    ++m_num_captures;
+    m_reason = reason;
+    m_trigger_time = m_size > 0 ? m_time[(m_head + m_capacity - 1) % m_capacity] : 0.0;
+    return true;
+}
+
+void FlightRecorder::write_capture(std::ostream& os) const {
+    os << "time_s";
+    for (const std::string& name : m_channels) {
+        os << "," << name;
+    }
+    os << "\n" << std::scientific << std::setprecision(9);
+    size_t start = (m_head + m_capacity - m_size) % m_capacity;
+    for (size_t i = 0; i < m_size; ++i) {
+        size_t slot = (start + i) % m_capacity;
+        os << m_time[slot];
+        const double* row = &m_data[slot * m_num_channels];
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            os << "," << row[c];
+        }
+        os << "\n";
+    }
+}
+
+} // namespace serdes
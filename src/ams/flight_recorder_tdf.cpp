@@ -0,0 +1,105 @@
+#include "ams/flight_recorder_tdf.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace serdes {
+
+FlightRecorderTdf::FlightRecorderTdf(sc_core::sc_module_name nm, const FlightRecorderParams& params,
+                                     const std::vector<std::string>& channels, const std::string& prefix)
+    : sca_tdf::sca_module(nm)
+    , in("in", channels.size())
+    , error_count("error_count")
+    , freeze("freeze")
+    , m_params(params)
+    , m_channels(channels)
+    , m_prefix(prefix)
+    , m_recorder(channels, 0, 1, 0)   // Sized in initialize() once the timestep is known
+    , m_bounds(channels.size(), 0.0)
+    , m_values(channels.size(), 0.0)
+    , m_phase(0)
+    , m_last_errors(0.0)
+    , m_last_freeze(false)
+{
+    validate_flight_recorder_params(params);
+}
+
+void FlightRecorderTdf::set_bound(size_t channel, double bound) {
+    m_bounds.at(channel) = bound;
+}
+
+void FlightRecorderTdf::set_attributes() {
+    for (size_t c = 0; c < in.size(); ++c) {
+        in[c].set_rate(1);
+    }
+}
+
+void FlightRecorderTdf::initialize() {
+    double dt = get_timestep().to_seconds();
+    double samples_per_ui = m_params.ui / dt / m_params.decimation;
+    int pre = static_cast<int>(std::ceil(m_params.pre_ui * samples_per_ui));
+    int post = std::max(1, static_cast<int>(std::ceil(m_params.post_ui * samples_per_ui)));
+    m_recorder = FlightRecorder(m_channels, pre, post, m_params.max_captures);
+    for (size_t c = 0; c < m_bounds.size(); ++c) {
+        m_recorder.set_bound(c, m_bounds[c]);
+    }
+    m_phase = 0;
+    m_last_errors = 0.0;
+    m_last_freeze = false;
+}
+
+void FlightRecorderTdf::processing() {
+    if (++m_phase == m_params.decimation) {
+        m_phase = 0;
+        for (size_t c = 0; c < in.size(); ++c) {
+            m_values[c] = in[c].read();
+        }
+        if (m_recorder.push(get_time().to_seconds(), m_values.data())) {
+            dump();
+        }
+    }
+
+    double errors = error_count.read();
+    if (errors > m_last_errors && m_params.trigger_on_error) {
+        std::ostringstream reason;
+        reason << "checker error (" << static_cast<long long>(errors) << " total)";
+        m_recorder.trigger(reason.str());
+    }
+    m_last_errors = errors;
+
+    bool frozen = freeze.read();
+    if (frozen && !m_last_freeze && m_params.trigger_on_freeze) {
+        m_recorder.trigger("adaption freeze");
+    }
+    m_last_freeze = frozen;
+}
+
+void FlightRecorderTdf::flush() {
+    if (m_recorder.is_capturing()) {
+        dump();
+    }
+}
+
+void FlightRecorderTdf::dump() {
+    std::string file = m_prefix + "_flight" + std::to_string(m_recorder.get_num_captures()) + ".csv";
+    std::ofstream out(file);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot open " << file << std::endl;
+        return;
+    }
+    m_recorder.write_capture(out);
+
+    if (!m_index.is_open()) {
+        m_index.open(m_prefix + "_flight.csv");
+        m_index << "capture,trigger_time_s,reason,samples,file\n";
+    }
+    m_index << m_recorder.get_num_captures() << "," << std::scientific << std::setprecision(9)
+            << m_recorder.get_trigger_time() << "," << m_recorder.get_reason() << ","
+            << m_recorder.get_size() << "," << file << std::endl;
+    std::cout << "[Flight] Capture " << m_recorder.get_num_captures() << " (" << m_recorder.get_reason()
+              << " at " << m_recorder.get_trigger_time() * 1e9 << " ns) saved to " << file << std::endl;
+}
+
+} // namespace serdes
@@ -0,0 +1,250 @@
+#include "ams/jitter_decomposition.h"
+#include "common/fft.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+
+namespace serdes {
+
+namespace {
+
+// x such that P(N(0,1) > x) = p
+double inverse_q(double p) {
+    double lo = 0.0, hi = 40.0;
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (lo + hi);
+        (0.5 * std::erfc(mid / std::sqrt(2.0)) > p ? lo : hi) = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+} // anonymous namespace
+
+void validate_jitter_monitor_params(const JitterMonitorParams& params) {
+    if (!(params.ui > 0.0)) {
+        throw std::invalid_argument("JitterMonitor: ui must be positive");
+    }
+    if (params.warmup_ui < 1) {
+        throw std::invalid_argument("JitterMonitor: warmup_ui must be >= 1");
+    }
+    if (params.pattern_bits < 1 || params.pattern_bits > 12) {
+        throw std::invalid_argument("JitterMonitor: pattern_bits must be in [1, 12]");
+    }
+    if (params.min_pattern_count < 1) {
+        throw std::invalid_argument("JitterMonitor: min_pattern_count must be >= 1");
+    }
+    if (params.psd_length < 64 || (params.psd_length & (params.psd_length - 1)) != 0) {
+        throw std::invalid_argument("JitterMonitor: psd_length must be a power of 2 >= 64");
+    }
+    if (params.psd_decimation < 1) {
+        throw std::invalid_argument("JitterMonitor: psd_decimation must be >= 1");
+    }
+    if (!(params.pj_threshold > 1.0) || params.max_pj_tones < 0 || params.min_pj_freq < 0.0) {
+        throw std::invalid_argument("JitterMonitor: need pj_threshold > 1, max_pj_tones >= 0, min_pj_freq >= 0");
+    }
+    if (!(params.target_ber > 0.0 && params.target_ber < 0.5)) {
+        throw std::invalid_argument("JitterMonitor: target_ber must be in (0, 0.5)");
+    }
+}
+
+JitterDecomposer::JitterDecomposer(const JitterMonitorParams& params)
+    : m_params(params)
+    , m_pattern_mask(0)
+    , m_window_power(0.0)
+{
+    validate_jitter_monitor_params(params);
+    m_pattern_mask = (1u << params.pattern_bits) - 1u;
+    const int n = params.psd_length;
+    m_window.resize(n);
+    for (int i = 0; i < n; ++i) {
+        m_window[i] = 0.5 - 0.5 * std::cos(2.0 * M_PI * i / n);
+        m_window_power += m_window[i] * m_window[i];
+    }
+    clear();
+}
+
+void JitterDecomposer::clear() {
+    m_patterns.assign(m_pattern_mask + 1, Moments{0, 0.0, 0.0});
+    m_total = Moments{0, 0.0, 0.0};
+    m_min = std::numeric_limits<double>::infinity();
+    m_max = -std::numeric_limits<double>::infinity();
+    m_num_edges = 0;
+    m_started = false;
+    m_next_ui = 0;
+    m_hold = 0.0;
+    m_dec_sum = 0.0;
+    m_dec_count = 0;
+    m_segment.assign(m_params.psd_length, 0.0);
+    m_fill = 0;
+    m_psd_sum.assign(m_params.psd_length / 2 + 1, 0.0);
+    m_segments = 0;
+}
+
+void JitterDecomposer::update(Moments& m, double x) {
+    ++m.n;
+    double d = x - m.mean;
+    m.mean += d / static_cast<double>(m.n);
+    m.m2 += d * (x - m.mean);
+}
+
+void JitterDecomposer::add_edge(std::uint64_t ui_index, double tie, unsigned pattern) {
+    Moments& pm = m_patterns[pattern & m_pattern_mask];
+    // Out-of-sample residual: the pattern mean before this edge
+    double residual = pm.n > 0 ? tie - pm.mean : (m_total.n > 0 ? tie - m_total.mean : 0.0);
+    update(pm, tie);
+    update(m_total, tie);
+    m_min = std::min(m_min, tie);
+    m_max = std::max(m_max, tie);
+    ++m_num_edges;
+
+    // Hold the previous residual over the UIs up to this edge; a gap longer
+    // than a segment (e.g. loss of signal) restarts the segment
+    const std::uint64_t max_gap = static_cast<std::uint64_t>(m_params.psd_length) * m_params.psd_decimation;
+    if (!m_started || ui_index > m_next_ui + max_gap) {
+        m_started = true;
+        m_next_ui = ui_index;
+        m_dec_sum = 0.0;
+        m_dec_count = 0;
+        m_fill = 0;
+    }
+    for (; m_next_ui < ui_index; ++m_next_ui) {
+        push_ui(m_hold);
+    }
+    m_hold = residual;
+}
+
+void JitterDecomposer::push_ui(double residual) {
+    m_dec_sum += residual;
+    if (++m_dec_count < m_params.psd_decimation) {
+        return;
+    }
+    m_segment[m_fill++] = m_dec_sum / m_params.psd_decimation;
+    m_dec_sum = 0.0;
+    m_dec_count = 0;
+    if (m_fill == m_params.psd_length) {
+        process_segment();
+    }
+}
+
+void JitterDecomposer::process_segment() {
+    const int n = m_params.psd_length;
+    double mean = 0.0;
+    for (int i = 0; i < n; ++i) mean += m_segment[i];
+    mean /= n;
+    std::vector<std::complex<double>> x(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = (m_segment[i] - mean) * m_window[i];
+    }
+    fft_radix2(x, false);
+    for (int k = 0; k <= n / 2; ++k) {
+        m_psd_sum[k] += std::norm(x[k]);
+    }
+    ++m_segments;
+
+    // 50 % overlap
+    std::copy(m_segment.begin() + n / 2, m_segment.end(), m_segment.begin());
+    m_fill = n / 2;
+}
+
+JitterReport JitterDecomposer::report() const {
+    if (m_num_edges == 0) {
+        throw std::invalid_argument("JitterDecomposer: no edges added");
+    }
+    JitterReport r;
+    r.num_edges = m_num_edges;
+    r.mean = m_total.mean;
+    r.tie_rms = std::sqrt(m_total.m2 / static_cast<double>(m_total.n));
+    r.tie_pp = m_max - m_min;
+    r.target_ber = m_params.target_ber;
+
+    // Pattern-aligned averages
+    r.num_patterns = 0;
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -std::numeric_limits<double>::infinity();
+    double m2_sum = 0.0;
+    std::uint64_t used = 0;
+    double sum_rise = 0.0, sum_fall = 0.0;
+    std::uint64_t n_rise = 0, n_fall = 0;
+    for (unsigned p = 0; p < m_patterns.size(); ++p) {
+        const Moments& m = m_patterns[p];
+        if (m.n == 0) continue;
+        m2_sum += m.m2;
+        ++used;
+        (p & 1u ? sum_rise : sum_fall) += m.mean * static_cast<double>(m.n);
+        (p & 1u ? n_rise : n_fall) += m.n;
+        if (m.n >= static_cast<std::uint64_t>(m_params.min_pattern_count)) {
+            ++r.num_patterns;
+            lo = std::min(lo, m.mean);
+            hi = std::max(hi, m.mean);
+        }
+    }
+    r.ddj_pp = r.num_patterns > 0 ? hi - lo : 0.0;
+    r.dcd = (n_rise > 0 && n_fall > 0) ? sum_rise / n_rise - sum_fall / n_fall : 0.0;
+    double residual_var = m_num_edges > used ? m2_sum / static_cast<double>(m_num_edges - used) : 0.0;
+    r.residual_rms = std::sqrt(residual_var);
+
+    // Welch PSD of the decimated residual and its PJ peaks
+    r.psd_segments = m_segments;
+    r.pj_pp = 0.0;
+    double tone_var = 0.0;
+    if (m_segments > 0) {
+        const int n = m_params.psd_length;
+        const int half = n / 2;
+        const double t_ui = m_params.ui;
+        const double fs = 1.0 / (m_params.psd_decimation * t_ui);
+        const double df = fs / n;
+        r.psd_freq.resize(half + 1);
+        r.psd.resize(half + 1);
+        for (int k = 0; k <= half; ++k) {
+            double scale = (k == 0 || k == half) ? 1.0 : 2.0;
+            r.psd_freq[k] = k * df;
+            r.psd[k] = scale * m_psd_sum[k] / (m_segments * fs * m_window_power);
+        }
+        std::vector<double> sorted(r.psd.begin() + 1, r.psd.end());
+        std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+        const double floor = sorted[sorted.size() / 2];
+
+        std::vector<int> peaks;
+        for (int k = 1; k < half; ++k) {
+            if (r.psd_freq[k] >= m_params.min_pj_freq && r.psd[k] > m_params.pj_threshold * floor &&
+                r.psd[k] >= r.psd[k - 1] && r.psd[k] > r.psd[k + 1]) {
+                peaks.push_back(k);
+            }
+        }
+        std::sort(peaks.begin(), peaks.end(), [&](int a, int b) { return r.psd[a] > r.psd[b]; });
+        std::vector<int> taken;
+        for (int k : peaks) {
+            if (static_cast<int>(taken.size()) >= m_params.max_pj_tones) break;
+            bool near = false;
+            for (int t : taken) near = near || std::abs(t - k) <= 3;
+            if (near) continue;
+            taken.push_back(k);
+
+            // Hann main lobe: +/- 2 bins above the floor
+            double power = 0.0, moment = 0.0;
+            for (int j = std::max(1, k - 2); j <= std::min(half, k + 2); ++j) {
+                double p = std::max(0.0, r.psd[j] - floor) * df;
+                power += p;
+                moment += p * r.psd_freq[j];
+            }
+            double f = moment / power;
+            // Undo the block average over psd_decimation UIs
+            double x = M_PI * f * t_ui;
+            double gain = std::fabs(std::sin(m_params.psd_decimation * x) /
+                                    (m_params.psd_decimation * std::sin(x)));
+            double amplitude = std::sqrt(2.0 * power) / gain;
+            r.pj_tones.push_back(PjTone{f, 2.0 * amplitude});
+            r.pj_pp += 2.0 * amplitude;
+            tone_var += 0.5 * amplitude * amplitude;
+        }
+    }
+
+    r.rj_rms = std::sqrt(std::max(0.0, residual_var - tone_var));
+    r.dj_pp = r.ddj_pp + r.pj_pp;
+    r.tj = r.dj_pp + 2.0 * inverse_q(m_params.target_ber) * r.rj_rms;
+    return r;
+}
+
+} // namespace serdes
@@ -0,0 +1,112 @@
+#include "ams/jitter_monitor_tdf.h"
+#include <cmath>
+
+namespace serdes {
+
+JitterMonitorTdf::JitterMonitorTdf(sc_core::sc_module_name nm, const JitterMonitorParams& params)
+    : sca_tdf::sca_module(nm)
+    , in_p("in_p")
+    , in_n("in_n")
+    , clk_phase("clk_phase")
+    , m_params(params)
+    , m_data(params)
+    , m_clock(params)
+    , m_have_prev(false)
+    , m_prev_t(0.0)
+    , m_prev_v(0.0)
+    , m_clk(0.0)
+    , m_aligned(false)
+    , m_cos_sum(0.0)
+    , m_sin_sum(0.0)
+    , m_warmup_edges(0)
+    , m_ref(0.0)
+    , m_next_bit(0)
+    , m_history(0)
+    , m_pending(false)
+    , m_pending_k(0)
+    , m_pending_tie(0.0)
+    , m_dropped(0)
+{
+}
+
+void JitterMonitorTdf::set_attributes() {
+    in_p.set_rate(1);
+    in_n.set_rate(1);
+    clk_phase.set_rate(1);
+}
+
+void JitterMonitorTdf::initialize() {
+    m_data.clear();
+    m_clock.clear();
+    m_have_prev = false;
+    m_aligned = false;
+    m_cos_sum = 0.0;
+    m_sin_sum = 0.0;
+    m_warmup_edges = 0;
+    m_history = 0;
+    m_pending = false;
+    m_dropped = 0;
+}
+
+void JitterMonitorTdf::processing() {
+    const double ui = m_params.ui;
+    double t = get_time().to_seconds();
+    double v = in_p.read() - in_n.read() - m_params.threshold;
+    m_clk = clk_phase.read();
+    if (!m_have_prev) {
+        m_have_prev = true;
+        m_prev_t = t;
+        m_prev_v = v;
+        return;
+    }
+
+    bool crossed = (v > 0.0) != (m_prev_v > 0.0);
+    double tc = crossed ? m_prev_t + (t - m_prev_t) * m_prev_v / (m_prev_v - v) : 0.0;
+
+    if (!m_aligned) {
+        if (crossed) {
+            double phase = 2.0 * M_PI * tc / ui;
+            m_cos_sum += std::cos(phase);
+            m_sin_sum += std::sin(phase);
+            ++m_warmup_edges;
+        }
+        if (t >= m_params.warmup_ui * ui && m_warmup_edges > 0) {
+            m_ref = std::atan2(m_sin_sum, m_cos_sum) / (2.0 * M_PI) * ui;
+            m_next_bit = static_cast<std::int64_t>(std::ceil((t - m_ref) / ui - 0.5));
+            m_aligned = true;
+        }
+        m_prev_t = t;
+        m_prev_v = v;
+        return;
+    }
+
+    if (crossed) {
+        if (m_pending) {
+            ++m_dropped;              // Second crossing before the bit was decided
+        }
+        double x = (tc - m_ref) / ui;
+        m_pending_k = std::llround(x);
+        m_pending_tie = (x - static_cast<double>(m_pending_k)) * ui;
+        m_pending = true;
+    }
+
+    // Decide the bits whose grid center lies in (m_prev_t, t]
+    for (double tcen = center_time(m_next_bit); tcen <= t; tcen = center_time(++m_next_bit)) {
+        double vc = m_prev_v + (v - m_prev_v) * (tcen - m_prev_t) / (t - m_prev_t);
+        m_history = (m_history << 1) | (vc > 0.0 ? 1u : 0u);
+        if (m_pending && m_pending_k <= m_next_bit) {
+            bool transition = ((m_history ^ (m_history >> 1)) & 1u) != 0;
+            if (m_pending_k == m_next_bit && transition) {
+                m_data.add_edge(static_cast<std::uint64_t>(m_next_bit), m_pending_tie, m_history);
+            } else {
+                ++m_dropped;
+            }
+            m_pending = false;
+        }
+        m_clock.add_edge(static_cast<std::uint64_t>(m_next_bit), m_clk, 0);
+    }
+    m_prev_t = t;
+    m_prev_v = v;
+}
+
+} // namespace serdes
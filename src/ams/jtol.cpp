@@ -0,0 +1,180 @@
+#include "ams/jtol.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace serdes {
+
+namespace {
+
+struct NamedMask {
+    const char* name;
+    std::vector<double> freqs;
+    std::vector<double> limits;
+};
+
+const std::vector<NamedMask>& named_masks() {
+    static const std::vector<NamedMask> masks = {
+        {"ieee_802_3ck", {1e4, 1e5, 1e6, 10e6, 100e6, 1e9, 4e9},
+                         {0.1, 0.1, 0.1, 0.1, 0.01, 0.001, 0.0005}},
+        {"oif_cei_112g", {1e4, 1e5, 1e6, 4e6, 10e6, 100e6, 1e9, 4e9},
+                         {0.1, 0.1, 0.1, 0.1, 0.05, 0.005, 0.0005, 0.00025}},
+        {"jedec_ddr5",   {1e4, 1e5, 1e6, 4e6, 10e6, 50e6, 200e6, 800e6},
+                         {0.15, 0.15, 0.15, 0.15, 0.075, 0.03, 0.015, 0.0075}},
+        {"pcie_gen6",    {1e4, 1e5, 1e6, 10e6, 100e6, 500e6, 2e9, 4e9},
+                         {0.12, 0.12, 0.12, 0.12, 0.012, 0.0024, 0.0006, 0.0003}},
+    };
+    return masks;
+}
+
+void validate_jtol_params(const JtolParams& params) {
+    if (!(params.amp_min > 0.0) || !(params.amp_max > params.amp_min)) {
+        throw std::invalid_argument("JTOL: need 0 < amp_min < amp_max");
+    }
+    if (!(params.resolution > 0.0)) {
+        throw std::invalid_argument("JTOL: resolution must be positive");
+    }
+    if (!(params.target_ber > 0.0 && params.target_ber < 0.5)) {
+        throw std::invalid_argument("JTOL: target_ber must be in (0, 0.5)");
+    }
+    if (params.min_sj_periods < 1 || params.num_workers < 0) {
+        throw std::invalid_argument("JTOL: min_sj_periods must be >= 1 and num_workers >= 0");
+    }
+    for (double f : params.frequencies) {
+        if (!(f > 0.0)) {
+            throw std::invalid_argument("JTOL: frequencies must be positive");
+        }
+    }
+}
+
+JtolPoint search_point(double freq, const JtolParams& params, const JtolMask& mask,
+                       const JtolTrial& trial) {
+    JtolPoint pt;
+    pt.frequency = freq;
+    pt.mask = mask.limit(freq);
+    pt.trials = 0;
+    double lo = 0.0;    // Largest passing amplitude so far
+    double hi = 0.0;    // Smallest failing amplitude so far
+    auto run = [&](double amp) {
+        ++pt.trials;
+        (trial(freq, amp) ? lo : hi) = amp;
+    };
+
+    // Compliance first, then bracket, then bisect
+    run(std::min(std::max(pt.mask, params.amp_min), params.amp_max));
+    while (hi == 0.0 && lo > 0.0 && lo < params.amp_max) {
+        run(std::min(2.0 * lo, params.amp_max));
+    }
+    while (lo == 0.0 && hi > params.amp_min) {
+        run(std::max(0.5 * hi, params.amp_min));
+    }
+    if (lo > 0.0 && hi > 0.0) {
+        while (hi / lo > 1.0 + params.resolution) {
+            run(std::sqrt(lo * hi));
+        }
+    }
+
+    pt.tolerance = lo;
+    pt.failing = hi;
+    pt.pass = lo > 0.0 && lo >= pt.mask * (1.0 - 1e-12);
+    pt.margin_db = lo > 0.0 ? 20.0 * std::log10(lo / pt.mask)
+                            : -std::numeric_limits<double>::infinity();
+    return pt;
+}
+
+} // anonymous namespace
+
+JtolMask::JtolMask(const std::vector<double>& frequencies, const std::vector<double>& limits)
+    : m_freqs(frequencies)
+    , m_limits(limits)
+{
+    if (frequencies.size() < 2 || frequencies.size() != limits.size()) {
+        throw std::invalid_argument("JtolMask: need >= 2 frequencies with one limit each");
+    }
+    for (size_t i = 0; i < frequencies.size(); ++i) {
+        if (!(frequencies[i] > 0.0) || !(limits[i] > 0.0) ||
+            (i > 0 && !(frequencies[i] > frequencies[i - 1]))) {
+            throw std::invalid_argument("JtolMask: frequencies must be positive and increasing, limits positive");
+        }
+    }
+}
+
+JtolMask JtolMask::from_name(const std::string& name) {
+    for (const NamedMask& m : named_masks()) {
+        if (name == m.name) {
+            return JtolMask(m.freqs, m.limits);
+        }
+    }
+    throw std::invalid_argument("JtolMask: unknown mask '" + name + "'");
+}
+
+std::vector<std::string> JtolMask::names() {
+    std::vector<std::string> out;
+    for (const NamedMask& m : named_masks()) {
+        out.push_back(m.name);
+    }
+    return out;
+}
+
+double JtolMask::limit(double frequency) const {
+    if (frequency <= m_freqs.front()) return m_limits.front();
+    if (frequency >= m_freqs.back()) return m_limits.back();
+    size_t i = std::upper_bound(m_freqs.begin(), m_freqs.end(), frequency) - m_freqs.begin();
+    double x = std::log(frequency / m_freqs[i - 1]) / std::log(m_freqs[i] / m_freqs[i - 1]);
+    return m_limits[i - 1] * std::pow(m_limits[i] / m_limits[i - 1], x);
+}
+
+JtolResult run_jtol_sweep(const JtolParams& params, const JtolMask& mask, const JtolTrial& trial) {
+    validate_jtol_params(params);
+    std::vector<double> freqs = params.frequencies.empty() ? mask.get_frequencies() : params.frequencies;
+    std::sort(freqs.begin(), freqs.end());
+    const int num_points = static_cast<int>(freqs.size());
+
+    JtolResult result;
+    result.points.resize(num_points);
+    std::atomic<int> next_point(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]() {
+        for (int i = next_point++; i < num_points && !failed; i = next_point++) {
+            try {
+                result.points[i] = search_point(freqs[i], params, mask, trial);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+    int num_threads = params.num_workers > 0
+                      ? params.num_workers
+                      : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    num_threads = std::max(1, std::min(num_threads, num_points));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < num_threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    result.pass = true;
+    result.total_trials = 0;
+    for (const JtolPoint& pt : result.points) {
+        result.pass = result.pass && pt.pass;
+        result.total_trials += pt.trials;
+    }
+    return result;
+}
+
+} // namespace serdes
@@ -0,0 +1,171 @@
+#include "ams/noise_generator.h"
+#include <cmath>
+#include "common/constants.h"
+
+namespace serdes {
+
+namespace {
+
+const std::uint32_t PHILOX_M0 = 0xD2511F53u;
+const std::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+const std::uint32_t PHILOX_W0 = 0x9E3779B9u;
+const std::uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+// Counter word 3 separates the normal and uniform counter spaces
+const std::uint32_t SPACE_NORMAL = 0u;
+const std::uint32_t SPACE_UNIFORM = 1u;
+
+inline void philox4x32_10(std::uint32_t c[4], std::uint32_t k0, std::uint32_t k1) {
+    for (int r = 0; r < 10; ++r) {
+        std::uint64_t p0 = static_cast<std::uint64_t>(PHILOX_M0) * c[0];
+        std::uint64_t p1 = static_cast<std::uint64_t>(PHILOX_M1) * c[2];
+        std::uint32_t hi0 = static_cast<std::uint32_t>(p0 >> 32);
+        std::uint32_t lo0 = static_cast<std::uint32_t>(p0);
+        std::uint32_t hi1 = static_cast<std::uint32_t>(p1 >> 32);
+        std::uint32_t lo1 = static_cast<std::uint32_t>(p1);
+        c[0] = hi1 ^ c[1] ^ k0;
+        c[1] = lo1;
+        c[2] = hi0 ^ c[3] ^ k1;
+        c[3] = lo0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+}
+
+// Map a 32-bit word to (0, 1), never 0 so log() is safe
+inline double to_unit(std::uint32_t x) {
+    return (static_cast<double>(x) + 0.5) * (1.0 / 4294967296.0);
+}
+
+inline void block_words(std::uint64_t block, std::uint32_t space,
+                        std::uint32_t k0, std::uint32_t k1, std::uint32_t out[4]) {
+    out[0] = static_cast<std::uint32_t>(block);
+    out[1] = static_cast<std::uint32_t>(block >> 32);
+    out[2] = 0u;
+    out[3] = space;
+    philox4x32_10(out, k0, k1);
+}
+
+// Four normals per counter block: two Box-Muller pairs
+inline void block_normals(std::uint64_t block, std::uint32_t k0, std::uint32_t k1, double z[4]) {
+    std::uint32_t w[4];
+    block_words(block, SPACE_NORMAL, k0, k1, w);
+    const double two_pi = 6.283185307179586;
+    double r0 = std::sqrt(-2.0 * std::log(to_unit(w[0])));
+    double r1 = std::sqrt(-2.0 * std::log(to_unit(w[2])));
+    double t0 = two_pi * to_unit(w[1]);
+    double t1 = two_pi * to_unit(w[3]);
+    z[0] = r0 * std::cos(t0);
+    z[1] = r0 * std::sin(t0);
+    z[2] = r1 * std::cos(t1);
+    z[3] = r1 * std::sin(t1);
+}
+
+} // namespace
+
+NoiseStream::NoiseStream()
+    : m_key0(0)
+    , m_key1(0)
+    , m_normal_pos(0)
+    , m_uniform_pos(0)
+    , m_batch_start(0)
+    , m_batch_valid(false)
+{
+}
+
+NoiseStream::NoiseStream(std::uint64_t seed, const std::string& path)
+    : NoiseStream()
+{
+    reseed(seed, path);
+}
+
+void NoiseStream::reseed(std::uint64_t seed, const std::string& path) {
+    if (seed == 0) {
+        seed = DEFAULT_SEED;
+    }
+    // Mix the seed so that seed and path bits do not cancel
+    std::uint64_t s = seed * 0x9E3779B97F4A7C15ull;
+    std::uint64_t key = s ^ hash_path(path);
+    m_key0 = static_cast<std::uint32_t>(key);
+    m_key1 = static_cast<std::uint32_t>(key >> 32);
+    set_position(0, 0);
+}
+
+std::uint64_t NoiseStream::get_key() const {
+    return (static_cast<std::uint64_t>(m_key1) << 32) | m_key0;
+}
+
+std::uint64_t NoiseStream::hash_path(const std::string& path) {
+    std::uint64_t h = 0xCBF29CE484222325ull;
+    for (unsigned char ch : path) {
+        h ^= ch;
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+void NoiseStream::set_position(std::uint64_t normal_pos, std::uint64_t uniform_pos) {
+    m_normal_pos = normal_pos;
+    m_uniform_pos = uniform_pos;
+    m_batch_valid = false;
+}
+
+void NoiseStream::save_state(StateCheckpoint& cp, const std::string& key) const {
+    cp.put_uint(key + ".normal_pos", m_normal_pos);
+    cp.put_uint(key + ".uniform_pos", m_uniform_pos);
+}
+
+void NoiseStream::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    set_position(cp.get_uint(key + ".normal_pos"), cp.get_uint(key + ".uniform_pos"));
+}
+
+double NoiseStream::normal_at(std::uint64_t index) const {
+    double z[4];
+    block_normals(index >> 2, m_key0, m_key1, z);
+    return z[index & 3u];
+}
+
+double NoiseStream::uniform_at(std::uint64_t index) const {
+    std::uint32_t w[4];
+    block_words(index >> 2, SPACE_UNIFORM, m_key0, m_key1, w);
+    return to_unit(w[index & 3u]);
+}
+
+void NoiseStream::fill_normal(std::uint64_t first_index, double* out, std::size_t n) const {
+    std::size_t i = 0;
+
+    // Unaligned head
+    while (i < n && ((first_index + i) & 3u) != 0) {
+        out[i] = normal_at(first_index + i);
+        ++i;
+    }
+
+    // Aligned 4-lane blocks
+    std::uint64_t block = (first_index + i) >> 2;
+    for (; i + 4 <= n; i += 4, ++block) {
+        block_normals(block, m_key0, m_key1, out + i);
+    }
+
+    // Tail
+    for (; i < n; ++i) {
+        out[i] = normal_at(first_index + i);
+    }
+}
+
+double NoiseStream::next_normal() {
+    if (!m_batch_valid || m_normal_pos < m_batch_start ||
+        m_normal_pos >= m_batch_start + BATCH) {
+        m_batch_start = m_normal_pos & ~static_cast<std::uint64_t>(BATCH - 1);
+        fill_normal(m_batch_start, m_batch, BATCH);
+        m_batch_valid = true;
+    }
+    double z = m_batch[m_normal_pos - m_batch_start];
+    ++m_normal_pos;
+    return z;
+}
+
+double NoiseStream::next_uniform() {
+    return uniform_at(m_uniform_pos++);
+}
+
+} // namespace serdes
@@ -0,0 +1,137 @@
+#include "ams/pll_phase_model.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace serdes {
+
+PllPhaseModel::PllPhaseModel()
+    : m_target(0.0)
+    , m_t_ref(0.0)
+    , m_vc_initial(0.0)
+    , m_vc(0.0)
+    , m_icp(0.0)
+    , m_tau(0.0)
+    , m_phase_error(0.0)
+    , m_ref_edges(0)
+    , m_vco_count(0)
+    , m_vco_frac(0.0)
+    , m_last_edge_offset(-1.0)
+{
+}
+
+void PllPhaseModel::configure(const ClockPllParams& params, double frequency,
+                              const std::string& path) {
+    if (params.pd_type != "tri-state") {
+        throw std::invalid_argument("PLL: pd_type must be 'tri-state'. Current value: " +
+                                    params.pd_type);
+    }
+    if (!(frequency > 0.0)) {
+        throw std::invalid_argument("PLL: frequency must be positive");
+    }
+    if (params.cp_current <= 0.0 || params.lf_R <= 0.0 || params.lf_C <= 0.0) {
+        throw std::invalid_argument("PLL: cp_current, lf_R and lf_C must be positive");
+    }
+    if (params.vco_Kvco <= 0.0 || params.vco_f0 <= 0.0) {
+        throw std::invalid_argument("PLL: vco_Kvco and vco_f0 must be positive");
+    }
+    if (params.divider <= 0) {
+        throw std::invalid_argument("PLL: divider must be positive");
+    }
+    if (params.ref_jitter_rms < 0.0 || params.vco_jitter_rms < 0.0) {
+        throw std::invalid_argument("PLL: jitter must be non-negative");
+    }
+
+    m_params = params;
+    m_target = frequency;
+    m_t_ref = params.divider / frequency;
+    m_vc_initial = (frequency + params.initial_freq_offset - params.vco_f0) / params.vco_Kvco;
+    m_noise.reseed(params.noise_seed, path);
+    reset();
+}
+
+void PllPhaseModel::reset() {
+    m_vc = m_vc_initial;
+    m_icp = 0.0;
+    m_tau = 0.0;
+    m_phase_error = 0.0;
+    m_ref_edges = 0;
+    m_vco_count = 0;
+    m_vco_frac = 0.0;
+    m_last_edge_offset = -1.0;
+    m_noise.set_position(0, 0);
+}
+
+double PllPhaseModel::get_control_voltage() const {
+    return m_vc + m_icp * (m_params.lf_R + m_tau / m_params.lf_C);
+}
+
+double PllPhaseModel::frequency() const {
+    return m_params.vco_f0 + m_params.vco_Kvco * get_control_voltage();
+}
+
+void PllPhaseModel::advance(double dt) {
+    m_last_edge_offset = -1.0;
+    if (!(dt > 0.0) || m_t_ref <= 0.0) {
+        return;
+    }
+    std::int64_t count0 = m_vco_count;
+    double frac0 = m_vco_frac;
+    double remaining = dt;
+    while (m_tau + remaining >= m_t_ref) {
+        double step = m_t_ref - m_tau;
+        advance_within_cycle(step);
+        remaining -= step;
+        // Capacitor charge over the completed reference cycle
+        m_vc += m_icp * m_t_ref / m_params.lf_C;
+        m_tau = 0.0;
+        reference_edge();
+    }
+    advance_within_cycle(remaining);
+
+    std::int64_t wraps = m_vco_count - count0;
+    if (wraps > 0) {
+        double total = static_cast<double>(wraps) + m_vco_frac - frac0;
+        m_last_edge_offset = (static_cast<double>(wraps) - frac0) / total * dt;
+    }
+}
+
+void PllPhaseModel::advance_within_cycle(double tau) {
+    if (tau <= 0.0) {
+        return;
+    }
+    const double kvco = m_params.vco_Kvco;
+    double t0 = m_tau;
+    double t1 = m_tau + tau;
+    double dtheta = (m_params.vco_f0 + kvco * (m_vc + m_icp * m_params.lf_R)) * tau
+                  + kvco * m_icp * (t1 * t1 - t0 * t0) / (2.0 * m_params.lf_C);
+
+    if (m_params.vco_jitter_rms > 0.0) {
+        // White FM: the VCO edge time random-walks by vco_jitter_rms per cycle
+        double f = dtheta / tau;
+        dtheta += m_noise.next_normal() * m_params.vco_jitter_rms * f * std::sqrt(tau * f);
+    }
+
+    m_tau = t1;
+    m_vco_frac += dtheta;
+    double whole = std::floor(m_vco_frac);
+    m_vco_count += static_cast<std::int64_t>(whole);
+    m_vco_frac -= whole;
+}
+
+void PllPhaseModel::reference_edge() {
+    ++m_ref_edges;
+    // Reference leads by k cycles; the divided VCO by (count + frac) / N
+    std::int64_t lead = m_ref_edges * m_params.divider - m_vco_count;
+    double phi_e = (static_cast<double>(lead) - m_vco_frac) / m_params.divider;
+    if (m_params.ref_jitter_rms > 0.0) {
+        // A late reference edge sees the VCO further ahead
+        phi_e -= m_noise.next_normal() * m_params.ref_jitter_rms * frequency() / m_params.divider;
+    }
+    // Tri-state PFD linear range is one reference cycle; beyond it the
+    // charge pump stays fully on, which pulls the frequency in
+    m_phase_error = std::max(-1.0, std::min(1.0, phi_e));
+    m_icp = m_params.cp_current * m_phase_error;
+}
+
+} // namespace serdes
@@ -0,0 +1,107 @@
+#include "ams/prbs_checker.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace serdes {
+
+PrbsCheckerTdf::PrbsCheckerTdf(sc_core::sc_module_name nm, const PrbsCheckerParams& params)
+    : sca_tdf::sca_module(nm)
+    , data_in("data_in")
+    , locked("locked")
+    , bit_count("bit_count")
+    , error_count("error_count")
+    , ber("ber")
+    , ber_upper("ber_upper")
+    , burst_count("burst_count")
+    , max_burst("max_burst")
+    , sync_losses("sync_losses")
+    , m_params(params)
+    , m_samples_per_ui(1)
+    , m_sample_index(0)
+    , m_sample_counter(0)
+{
+    if (params.use_trigger) {
+        if (params.decision_latency < 0) {
+            throw std::invalid_argument("PRBS checker: decision_latency must be non-negative");
+        }
+    } else {
+        if (!(params.ui > 0.0)) {
+            throw std::invalid_argument("PRBS checker: ui must be positive");
+        }
+        if (params.sample_phase < 0.0 || params.sample_phase >= 1.0) {
+            throw std::invalid_argument("PRBS checker: sample_phase must be in [0, 1)");
+        }
+    }
+    m_checker.configure(params);
+    if (params.use_trigger) {
+        trigger.init(1);
+    }
+}
+
+void PrbsCheckerTdf::set_attributes() {
+    data_in.set_rate(1);
+    for (auto& port : trigger) {
+        port.set_rate(1);
+    }
+}
+
+void PrbsCheckerTdf::initialize() {
+    m_checker.reset();
+    m_sample_counter = 0;
+    m_pending.clear();
+    if (!m_params.use_trigger) {
+        // A rounded grid would drift against the data by the remainder
+        double ratio = m_params.ui / get_timestep().to_seconds();
+        if (std::fabs(ratio - std::round(ratio)) > 1e-6 * ratio || ratio < 0.5) {
+            throw std::invalid_argument("PRBS checker: ui must be an integer multiple of the "
+                                        "timestep without a trigger");
+        }
+        m_samples_per_ui = static_cast<int>(std::lround(ratio));
+        m_sample_index = std::min(m_samples_per_ui - 1,
+                                  static_cast<int>(m_params.sample_phase * m_samples_per_ui));
+    }
+}
+
+void PrbsCheckerTdf::processing() {
+    bool take;
+    if (m_params.use_trigger) {
+        for (int& age : m_pending) {
+            ++age;
+        }
+        if (trigger[0].read()) {
+            m_pending.push_back(0);
+        }
+        take = !m_pending.empty() && m_pending.front() >= m_params.decision_latency;
+        if (take) {
+            m_pending.pop_front();
+        }
+    } else {
+        take = (m_sample_counter == m_sample_index);
+        if (++m_sample_counter >= m_samples_per_ui) {
+            m_sample_counter = 0;
+        }
+    }
+    if (!take) {
+        return;
+    }
+
+    bool was_locked = m_checker.is_locked();
+    bool word_closed = m_checker.push(data_in.read() > 0.5);
+    if (word_closed || was_locked != m_checker.is_locked()) {
+        write_outputs();
+    }
+}
+
+void PrbsCheckerTdf::write_outputs() {
+    locked.write(m_checker.is_locked());
+    bit_count.write(static_cast<double>(m_checker.get_bit_count()));
+    error_count.write(static_cast<double>(m_checker.get_error_count()));
+    ber.write(m_checker.get_ber());
+    ber_upper.write(m_checker.get_ber_upper());
+    burst_count.write(static_cast<int>(m_checker.get_burst_count()));
+    max_burst.write(static_cast<int>(m_checker.get_max_burst_length()));
+    sync_losses.write(static_cast<int>(m_checker.get_sync_losses()));
+}
+
+} // namespace serdes
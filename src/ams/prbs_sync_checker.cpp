@@ -0,0 +1,299 @@
+#include "ams/prbs_sync_checker.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace serdes {
+
+namespace {
+
+inline int popcount64(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+inline int lowest_bit(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1u)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// P(X <= k) for X ~ Poisson(lambda), summed in log space
+double poisson_cdf(std::uint64_t k, double lambda) {
+    if (lambda <= 0.0) {
+        return 1.0;
+    }
+    double log_term = -lambda;
+    double sum = std::exp(log_term);
+    for (std::uint64_t i = 1; i <= k; ++i) {
+        log_term += std::log(lambda) - std::log(static_cast<double>(i));
+        sum += std::exp(log_term);
+    }
+    return std::min(1.0, sum);
+}
+
+// Standard normal quantile by bisection on erfc
+double normal_quantile(double p) {
+    double lo = -10.0, hi = 10.0;
+    for (int it = 0; it < 100; ++it) {
+        double mid = 0.5 * (lo + hi);
+        if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+} // namespace
+
+double ber_upper_bound(std::uint64_t errors, std::uint64_t bits, double confidence) {
+    if (!(confidence > 0.0 && confidence < 1.0)) {
+        throw std::invalid_argument("ber_upper_bound: confidence must be in (0, 1)");
+    }
+    if (bits == 0) {
+        return 1.0;
+    }
+    double lambda;
+    if (errors > 1000) {
+        // Wilson-Hilferty approximation of the chi-square quantile
+        double k = static_cast<double>(errors) + 1.0;
+        double z = normal_quantile(confidence);
+        double c = 1.0 - 1.0 / (9.0 * k) + z / (3.0 * std::sqrt(k));
+        lambda = k * c * c * c;
+    } else {
+        // Solve P(X <= errors; lambda) = 1 - confidence
+        double lo = static_cast<double>(errors);
+        double hi = lo + 10.0 * std::sqrt(lo + 1.0) + 10.0;
+        while (poisson_cdf(errors, hi) > 1.0 - confidence) {
+            hi *= 2.0;
+        }
+        for (int it = 0; it < 100; ++it) {
+            double mid = 0.5 * (lo + hi);
+            if (poisson_cdf(errors, mid) > 1.0 - confidence) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        lambda = 0.5 * (lo + hi);
+    }
+    return std::min(1.0, lambda / static_cast<double>(bits));
+}
+
+double ber_lower_bound(std::uint64_t errors, std::uint64_t bits, double confidence) {
+    if (!(confidence > 0.0 && confidence < 1.0)) {
+        throw std::invalid_argument("ber_lower_bound: confidence must be in (0, 1)");
+    }
+    if (bits == 0 || errors == 0) {
+        return 0.0;
+    }
+    double lambda;
+    if (errors > 1000) {
+        double k = static_cast<double>(errors);
+        double z = normal_quantile(confidence);
+        double c = 1.0 - 1.0 / (9.0 * k) - z / (3.0 * std::sqrt(k));
+        lambda = k * c * c * c;
+    } else {
+        // Solve P(X >= errors; lambda) = 1 - confidence
+        double lo = 0.0;
+        double hi = static_cast<double>(errors);
+        for (int it = 0; it < 100; ++it) {
+            double mid = 0.5 * (lo + hi);
+            if (poisson_cdf(errors - 1, mid) > confidence) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        lambda = 0.5 * (lo + hi);
+    }
+    return std::min(1.0, lambda / static_cast<double>(bits));
+}
+
+PrbsSyncChecker::PrbsSyncChecker()
+    : m_mask(0)
+    , m_expected(false)
+{
+    configure(PrbsCheckerParams());
+}
+
+void PrbsSyncChecker::configure(const PrbsCheckerParams& params) {
+    if (params.sync_bits < 1) {
+        throw std::invalid_argument("PRBS checker: sync_bits must be >= 1");
+    }
+    if (params.loss_errors < 1 || params.loss_errors > 64) {
+        throw std::invalid_argument("PRBS checker: loss_errors must be in [1, 64]");
+    }
+    if (params.burst_gap < 1) {
+        throw std::invalid_argument("PRBS checker: burst_gap must be >= 1");
+    }
+    if (!(params.confidence > 0.0 && params.confidence < 1.0)) {
+        throw std::invalid_argument("PRBS checker: confidence must be in (0, 1)");
+    }
+    m_params = params;
+    m_lfsr = PrbsLfsr(params.type);
+    m_mask = m_lfsr.get_config().mask;
+    reset();
+}
+
+void PrbsSyncChecker::reset() {
+    m_seed = 0;
+    m_seed_fill = 0;
+    m_run_match = 0;
+    m_run_mismatch = 0;
+    m_locked = false;
+    m_invert = false;
+    m_expected = false;
+    m_diff = 0;
+    m_fill = 0;
+    m_bits = 0;
+    m_errors = 0;
+    m_sync_losses = 0;
+    m_in_burst = false;
+    m_gap = 0;
+    m_burst_len = 0;
+    m_burst_errors = 0;
+    m_burst_count = 0;
+    m_max_burst_len = 0;
+    m_max_burst_errors = 0;
+}
+
+bool PrbsSyncChecker::push(bool bit) {
+    if (!m_locked) {
+        m_expected = bit;
+        acquire(bit);
+        return false;
+    }
+    bool expected = m_lfsr.next_bit() != m_invert;
+    m_expected = expected;
+    m_diff |= static_cast<std::uint64_t>(bit != expected) << m_fill;
+    if (++m_fill < 64) {
+        return false;
+    }
+    close_word();
+    return true;
+}
+
+void PrbsSyncChecker::acquire(bool bit) {
+    const int length = m_lfsr.get_config().length;
+    if (m_seed_fill >= length) {
+        PrbsLfsr probe(m_params.type);
+        probe.set_state(m_seed);
+        if (probe.next_bit() == bit) {
+            ++m_run_match;
+            m_run_mismatch = 0;
+        } else {
+            ++m_run_mismatch;
+            m_run_match = 0;
+        }
+    }
+    m_seed = ((m_seed << 1) | (bit ? 1u : 0u)) & m_mask;
+    m_seed_fill = std::min(m_seed_fill + 1, length);
+
+    if (m_run_match >= m_params.sync_bits || m_run_mismatch >= m_params.sync_bits) {
+        // The complement of a PRBS is predicted wrong on every bit, since
+        // the two-tap feedback of complemented bits equals the original
+        m_invert = m_run_mismatch >= m_params.sync_bits;
+        m_lfsr.set_state(m_invert ? (~m_seed & m_mask) : m_seed);
+        m_locked = true;
+        m_run_match = 0;
+        m_run_mismatch = 0;
+        m_gap = 0;
+    }
+}
+
+void PrbsSyncChecker::close_word() {
+    int n = m_fill;
+    std::uint64_t err = m_diff;
+    m_diff = 0;
+    m_fill = 0;
+
+    int count = popcount64(err);
+    if (n == 64 && count > m_params.loss_errors) {
+        // Bit slip or loss of signal: re-acquire, keep the counts clean
+        ++m_sync_losses;
+        if (m_in_burst) {
+            close_burst();
+        }
+        m_locked = false;
+        m_seed_fill = 0;
+        m_run_match = 0;
+        m_run_mismatch = 0;
+        return;
+    }
+    m_bits += static_cast<std::uint64_t>(n);
+    m_errors += static_cast<std::uint64_t>(count);
+    account_bursts(err, n);
+}
+
+void PrbsSyncChecker::account_bursts(std::uint64_t err, int n) {
+    const std::uint64_t gap_limit = static_cast<std::uint64_t>(m_params.burst_gap);
+    int prev = -1;
+    while (err) {
+        int pos = lowest_bit(err);
+        err &= err - 1;
+        std::uint64_t gap = m_gap + static_cast<std::uint64_t>(pos - prev - 1);
+        if (m_in_burst && gap >= gap_limit) {
+            close_burst();
+        }
+        if (m_in_burst) {
+            m_burst_len += gap + 1;
+        } else {
+            m_in_burst = true;
+            m_burst_len = 1;
+            m_burst_errors = 0;
+        }
+        ++m_burst_errors;
+        m_gap = 0;
+        prev = pos;
+    }
+    m_gap += static_cast<std::uint64_t>(n - 1 - prev);
+    if (m_in_burst && m_gap >= gap_limit) {
+        close_burst();
+    }
+}
+
+void PrbsSyncChecker::close_burst() {
+    ++m_burst_count;
+    m_max_burst_len = std::max(m_max_burst_len, m_burst_len);
+    m_max_burst_errors = std::max(m_max_burst_errors, m_burst_errors);
+    m_in_burst = false;
+}
+
+std::uint64_t PrbsSyncChecker::get_error_count() const {
+    return m_errors + static_cast<std::uint64_t>(popcount64(m_diff));
+}
+
+double PrbsSyncChecker::get_ber() const {
+    std::uint64_t bits = get_bit_count();
+    return bits > 0 ? static_cast<double>(get_error_count()) / static_cast<double>(bits) : 0.0;
+}
+
+double PrbsSyncChecker::get_ber_upper() const {
+    return ber_upper_bound(get_error_count(), get_bit_count(), m_params.confidence);
+}
+
+std::uint64_t PrbsSyncChecker::get_max_burst_length() const {
+    return m_in_burst ? std::max(m_max_burst_len, m_burst_len) : m_max_burst_len;
+}
+
+std::uint64_t PrbsSyncChecker::get_max_burst_errors() const {
+    return m_in_burst ? std::max(m_max_burst_errors, m_burst_errors) : m_max_burst_errors;
+}
+
+} // namespace serdes
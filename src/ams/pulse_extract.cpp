@@ -0,0 +1,90 @@
+#include "ams/pulse_extract.h"
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace serdes {
+
+// ============================================================================
+// PulseStimulusTdf
+// ============================================================================
+
+PulseStimulusTdf::PulseStimulusTdf(sc_core::sc_module_name nm, const PulseExtractParams& params,
+                                   double sample_rate, double ui)
+    : sca_tdf::sca_module(nm)
+    , out("out")
+    , m_params(params)
+    , m_ui(ui)
+    , m_samples_per_ui(0)
+    , m_count(0)
+{
+    if (sample_rate <= 0.0 || ui <= 0.0) {
+        throw std::invalid_argument("PulseStimulus: sample_rate and ui must be positive");
+    }
+    if (params.mode != "pulse" && params.mode != "step") {
+        throw std::invalid_argument("PulseStimulus: mode must be \"pulse\" or \"step\"");
+    }
+    m_samples_per_ui = static_cast<int>(std::round(ui * sample_rate));
+    if (m_samples_per_ui < 1) {
+        throw std::invalid_argument("PulseStimulus: sample rate must be at least 1/UI");
+    }
+}
+
+void PulseStimulusTdf::set_attributes() {
+    out.set_rate(1);
+    out.set_timestep(m_ui / m_samples_per_ui, sc_core::SC_SEC);
+}
+
+void PulseStimulusTdf::initialize() {
+    m_count = 0;
+}
+
+void PulseStimulusTdf::processing() {
+    const long edge = static_cast<long>(m_params.lead_ui) * m_samples_per_ui;
+    bool high = m_count >= edge &&
+                (m_params.mode == "step" || m_count < edge + m_samples_per_ui);
+    out.write(high ? m_params.amplitude : 0.0);
+    ++m_count;
+}
+
+// ============================================================================
+// PulseResponseProbeTdf
+// ============================================================================
+
+PulseResponseProbeTdf::PulseResponseProbeTdf(sc_core::sc_module_name nm,
+                                             const PulseExtractParams& params,
+                                             int samples_per_ui, bool stop_when_done)
+    : sca_tdf::sca_module(nm)
+    , in_p("in_p")
+    , in_n("in_n")
+    , m_stop_when_done(stop_when_done)
+    , m_stopped(false)
+{
+    m_collector.configure(params, samples_per_ui);
+}
+
+void PulseResponseProbeTdf::set_attributes() {
+    in_p.set_rate(1);
+    in_n.set_rate(1);
+}
+
+void PulseResponseProbeTdf::initialize() {
+    m_collector.reset();
+    m_stopped = false;
+}
+
+void PulseResponseProbeTdf::processing() {
+    if (m_collector.is_done()) {
+        return;
+    }
+    if (m_collector.push(in_p.read() - in_n.read()) && m_stop_when_done && !m_stopped) {
+        m_stopped = true;
+        std::cout << "[" << name() << "] Pulse response complete: "
+                  << m_collector.get_pulse().size() / m_collector.get_samples_per_ui() << " UI, tail "
+                  << m_collector.get_tail_ratio()
+                  << (m_collector.is_converged() ? "" : " (max_ui reached)") << std::endl;
+        sc_core::sc_stop();
+    }
+}
+
+} // namespace serdes
@@ -0,0 +1,120 @@
+#include "ams/pulse_response_collector.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace serdes {
+
+PulseResponseCollector::PulseResponseCollector()
+    : m_spu(1)
+    , m_step(false)
+{
+    reset();
+}
+
+void PulseResponseCollector::configure(const PulseExtractParams& params, int samples_per_ui) {
+    if (params.mode != "pulse" && params.mode != "step") {
+        throw std::invalid_argument("PulseExtract: mode must be \"pulse\" or \"step\"");
+    }
+    if (samples_per_ui < 1 || params.lead_ui < 1 || params.tail_ui < 1 ||
+        params.min_ui < params.tail_ui || params.max_ui < params.min_ui) {
+        throw std::invalid_argument("PulseExtract: need samples_per_ui, lead_ui, tail_ui >= 1 and "
+                                    "tail_ui <= min_ui <= max_ui");
+    }
+    if (params.amplitude == 0.0 || !(params.tail_threshold > 0.0)) {
+        throw std::invalid_argument("PulseExtract: amplitude must be non-zero, tail_threshold positive");
+    }
+    m_params = params;
+    m_spu = samples_per_ui;
+    m_step = (params.mode == "step");
+    reset();
+}
+
+void PulseResponseCollector::reset() {
+    m_count = 0;
+    m_baseline_sum = 0.0;
+    m_baseline = 0.0;
+    m_step_resp.clear();
+    m_pulse.clear();
+    m_energy = 0.0;
+    m_main = 0;
+    m_tail_ratio = 1.0;
+    m_done = false;
+    m_converged = false;
+}
+
+bool PulseResponseCollector::push(double y) {
+    if (m_done) {
+        return true;
+    }
+    const long lead = static_cast<long>(m_params.lead_ui) * m_spu;
+    if (m_count < lead) {
+        // Baseline from the last lead UI, after start-up transients
+        if (m_count >= lead - m_spu) {
+            m_baseline_sum += y;
+        }
+        if (++m_count == lead) {
+            m_baseline = m_baseline_sum / m_spu;
+        }
+        return false;
+    }
+    ++m_count;
+
+    double r = (y - m_baseline) / m_params.amplitude;
+    double p = r;
+    if (m_step) {
+        m_step_resp.push_back(r);
+        size_t n = m_step_resp.size();
+        p = r - (n > static_cast<size_t>(m_spu) ? m_step_resp[n - 1 - m_spu] : 0.0);
+    }
+    m_pulse.push_back(p);
+    m_energy += p * p;
+    if (std::fabs(p) > std::fabs(m_pulse[m_main])) {
+        m_main = static_cast<int>(m_pulse.size()) - 1;
+    }
+
+    if (m_pulse.size() % static_cast<size_t>(m_spu) == 0) {
+        check_tail();
+    }
+    return m_done;
+}
+
+void PulseResponseCollector::check_tail() {
+    const size_t n = m_pulse.size();
+    const size_t window = static_cast<size_t>(m_params.tail_ui) * m_spu;
+    double tail = 0.0;
+    for (size_t i = n - window; i < n; ++i) {
+        tail += m_pulse[i] * m_pulse[i];
+    }
+    m_tail_ratio = m_energy > 0.0 ? tail / m_energy : 1.0;
+
+    const int ui = static_cast<int>(n / m_spu);
+    bool peak_passed = static_cast<size_t>(m_main) < n - window;
+    if (ui >= m_params.min_ui && peak_passed && m_energy > 0.0 &&
+        m_tail_ratio < m_params.tail_threshold) {
+        m_done = true;
+        m_converged = true;
+    } else if (ui >= m_params.max_ui) {
+        m_done = true;
+    }
+}
+
+std::vector<std::vector<double>> PulseResponseCollector::get_phase_cursors(int num_pre,
+                                                                           int num_post) const {
+    if (num_pre < 0 || num_post < 0) {
+        throw std::invalid_argument("PulseExtract: num_pre and num_post must be >= 0");
+    }
+    const int n = static_cast<int>(m_pulse.size());
+    std::vector<std::vector<double>> table(m_spu, std::vector<double>(num_pre + 1 + num_post, 0.0));
+    for (int p = 0; p < m_spu; ++p) {
+        int center = m_main + p - m_spu / 2;
+        for (int k = -num_pre; k <= num_post; ++k) {
+            int idx = center + k * m_spu;
+            if (idx >= 0 && idx < n) {
+                table[p][num_pre + k] = m_pulse[idx];
+            }
+        }
+    }
+    return table;
+}
+
+} // namespace serdes
@@ -22,18 +22,36 @@ RxCdrTdf::RxCdrTdf(sc_core::sc_module_name nm, const CdrParams& params)
     , in("in")
     , phase_out("phase_out")
     , sampling_trigger("sampling_trigger")
+    , edge_trigger("edge_trigger")
+    , edge_in("edge_in")
+    , sampling_offset("sampling_offset")
     , m_params(params)
     , m_sample_state(SampleState::WAIT_EDGE)
-    , m_edge_sample(false)
-    , m_data_sample(false)
-    , m_prev_data_sample(false)
+    , m_edge_value(0.0)
     , m_phase(0.0)
     , m_integral(0.0)
     , m_last_phase_error(0.0)
-    , m_free_running_phase(0.0)
+    , m_quantized_phase(0.0)
+    , m_num_updates(0)
+    , m_trigger_bits(0)
+    , m_edge_out(false)
+    , m_offset_out(0.0)
 {
     // Validate parameters during construction
     validate_params();
+    
+    // Two-sample PDs decide on the sampler's 0/1 output, baud-rate and
+    // linear PDs on the sampled voltage (decision boundary at 0)
+    double pd_threshold = (m_params.pd == PhaseDetectorType::BANG_BANG) ? 0.5 : 0.0;
+    m_pd.configure(m_params.pd, pd_threshold);
+    
+    if (m_params.fractional_trigger) {
+        sampling_offset.init(1);
+    }
+    if (m_params.edge_strobe && m_pd.needs_edge_sample()) {
+        edge_trigger.init(1);
+        edge_in.init(1);
+    }
 }
 
 // ============================================================================
@@ -63,6 +81,9 @@ void RxCdrTdf::validate_params()
     if (m_params.pai.range < m_params.pai.resolution) {
         throw std::invalid_argument("CDR: PAI range must be >= resolution");
     }
+    if (m_params.decision_latency < 0) {
+        throw std::invalid_argument("CDR: decision_latency must be >= 0");
+    }
 }
 
 // ============================================================================
@@ -77,6 +98,17 @@ void RxCdrTdf::set_attributes()
     phase_out.set_delay(1);  // 添加延迟以打破 Sampler-CDR 反馈环路
     sampling_trigger.set_rate(1);
     sampling_trigger.set_delay(1);  // 添加延迟以打破环路
+    for (auto& port : sampling_offset) {
+        port.set_rate(1);
+        port.set_delay(1);          // 与 sampling_trigger 对齐
+    }
+    for (auto& port : edge_trigger) {
+        port.set_rate(1);
+        port.set_delay(1);          // 与 sampling_trigger 对齐
+    }
+    for (auto& port : edge_in) {
+        port.set_rate(1);
+    }
 }
 
 // ============================================================================
@@ -89,13 +121,133 @@ void RxCdrTdf::initialize()
     m_phase = 0.0;
     m_integral = 0.0;
     m_last_phase_error = 0.0;
-    m_free_running_phase = 0.0;
+    m_quantized_phase = 0.0;
+    m_num_updates = 0;
+    
+    // Fixed-point sampling clock: increment and PAI step are rounded once here
+    m_nco.configure(m_params.ui, get_timestep().to_seconds(), m_params.pai.resolution);
+    m_nco.reset();
     
     // Initialize sampling state machine
-    m_sample_state = SampleState::WAIT_EDGE;
-    m_edge_sample = false;
-    m_data_sample = false;
-    m_prev_data_sample = false;
+    m_sample_state = m_pd.needs_edge_sample() ? SampleState::WAIT_EDGE : SampleState::WAIT_DATA;
+    m_edge_value = 0.0;
+    m_pending.clear();
+    m_trigger_bits = 0;
+    m_edge_out = false;
+    m_offset_out = 0.0;
+    m_pd.reset();
+    
+    if (!m_restore.empty()) {
+        const std::string key = std::string(name()) + ".";
+        m_phase = m_restore.get_real(key + "phase");
+        m_integral = m_restore.get_real(key + "integral");
+        m_last_phase_error = m_restore.get_real(key + "last_phase_error");
+        m_quantized_phase = m_restore.get_real(key + "quantized_phase");
+        m_sample_state = (m_restore.get_int(key + "wait_edge") != 0) ? SampleState::WAIT_EDGE
+                                                                     : SampleState::WAIT_DATA;
+        m_edge_value = m_restore.get_real(key + "edge_value");
+        const std::vector<std::int64_t>& wait = m_restore.get_int_vector(key + "pending_wait");
+        const std::vector<std::int64_t>& edge = m_restore.get_int_vector(key + "pending_edge");
+        if (wait.size() != edge.size()) {
+            throw std::invalid_argument("CDR: malformed checkpoint pending samples");
+        }
+        for (size_t k = 0; k < wait.size(); ++k) {
+            m_pending.push_back({static_cast<int>(wait[k]), edge[k] != 0});
+        }
+        m_nco.restore_state(m_restore, key + "nco");
+        m_pd.restore_state(m_restore, key + "pd");
+        // The last outputs were written into the port delays and not read
+        // yet; the continued run reads them first
+        if (m_restore.has(key + "trigger_bits")) {
+            m_trigger_bits = m_restore.get_uint(key + "trigger_bits");
+            m_offset_out = m_restore.get_real(key + "offset_out");
+            phase_out.initialize(m_quantized_phase);
+            sampling_trigger.initialize((m_trigger_bits & 1u) != 0);
+            if (edge_trigger.size() > 0) {
+                m_edge_out = m_restore.get_int(key + "edge_out") != 0;
+                edge_trigger[0].initialize(m_edge_out);
+            }
+            if (sampling_offset.size() > 0) {
+                sampling_offset[0].initialize(m_offset_out);
+            }
+        }
+        m_restore.clear();
+    }
+}
+
+// ============================================================================
+// Checkpoint
+// ============================================================================
+
+void RxCdrTdf::save_state(StateCheckpoint& cp) const
+{
+    const std::string key = std::string(name()) + ".";
+    cp.put_real(key + "phase", m_phase);
+    cp.put_real(key + "integral", m_integral);
+    cp.put_real(key + "last_phase_error", m_last_phase_error);
+    cp.put_real(key + "quantized_phase", m_quantized_phase);
+    cp.put_int(key + "wait_edge", m_sample_state == SampleState::WAIT_EDGE ? 1 : 0);
+    cp.put_real(key + "edge_value", m_edge_value);
+    std::vector<std::int64_t> wait;
+    std::vector<std::int64_t> edge;
+    for (const auto& p : m_pending) {
+        wait.push_back(p.wait);
+        edge.push_back(p.edge ? 1 : 0);
+    }
+    cp.put_int(key + "pending_wait", wait);
+    cp.put_int(key + "pending_edge", edge);
+    cp.put_uint(key + "trigger_bits", m_trigger_bits);
+    cp.put_int(key + "edge_out", m_edge_out ? 1 : 0);
+    cp.put_real(key + "offset_out", m_offset_out);
+    m_nco.save_state(cp, key + "nco");
+    m_pd.save_state(cp, key + "pd");
+}
+
+void RxCdrTdf::restore_state(const StateCheckpoint& cp)
+{
+    m_restore = cp.subset(std::string(name()) + ".");
+}
+
+// ============================================================================
+// Loop Filter
+// ============================================================================
+
+void RxCdrTdf::update_loop(double phase_error)
+{
+    // Store for debug
+    m_last_phase_error = phase_error;
+    ++m_num_updates;
+    
+    // =====================================================================
+    // Step 3: PI controller update
+    // =====================================================================
+    // Update integral term
+    m_integral += m_params.pi.ki * phase_error;
+    
+    // Calculate proportional term
+    double prop_term = m_params.pi.kp * phase_error;
+    
+    // Total PI output (in UI units)
+    double pi_output = prop_term + m_integral;
+    
+    // Scale to seconds
+    m_phase = pi_output * m_params.ui;
+    
+    // =====================================================================
+    // Step 4: Phase range limiting
+    // =====================================================================
+    double range = m_params.pai.range;
+    m_phase = std::max(-range, std::min(range, m_phase));
+    
+    // Anti-windup
+    if (m_phase >= range || m_phase <= -range) {
+        m_integral = m_phase / m_params.ui - prop_term;
+    }
+    
+    // Phase quantization: integer phase interpolator code
+    std::int64_t code = std::llround(m_phase / m_params.pai.resolution);
+    m_nco.set_code(code);
+    m_quantized_phase = static_cast<double>(code) * m_params.pai.resolution;
 }
 
 // ============================================================================
@@ -104,131 +256,70 @@ void RxCdrTdf::initialize()
 
 void RxCdrTdf::processing()
 {
-    double timestep = get_timestep().to_seconds();
-    
     // ========================================================================
-    // Step 1: Read sampled value from Sampler (result of previous trigger)
+    // Step 1: Read the samples of earlier triggers
     // ========================================================================
-    // Due to TDF delay, we read the sample from the previous trigger here
-    bool sampled_value = (in.read() > 0.5);
-    
-    // Store sample based on what we were waiting for
-    if (m_sample_state == SampleState::WAIT_DATA) {
-        // We were waiting for data sample (second trigger in UI)
-        m_data_sample = sampled_value;
-        
-        // =====================================================================
-        // Step 2: Bang-Bang Phase Detection (now we have both samples)
-        // =====================================================================
-        double phase_error = 0.0;
-        
-        // Check for data transition by comparing with previous UI's data
-        if (m_data_sample != m_prev_data_sample) {
-            // Data transition detected - can perform BBPD
-            if (m_edge_sample == m_data_sample) {
-                // Edge sample equals new data value → clock is EARLY
-                // (we sampled edge after the transition)
-                phase_error = -1.0;
-            } else {
-                // Edge sample equals old data value → clock is LATE
-                // (we sampled edge before the transition)
-                phase_error = +1.0;
-            }
-        }
-        // No transition: phase_error remains 0 (no update)
-        
-        // Store for debug
-        m_last_phase_error = phase_error;
-        
-        // =====================================================================
-        // Step 3: PI controller update
-        // =====================================================================
-        // Update integral term
-        m_integral += m_params.pi.ki * phase_error;
-        
-        // Calculate proportional term
-        double prop_term = m_params.pi.kp * phase_error;
-        
-        // Total PI output (in UI units)
-        double pi_output = prop_term + m_integral;
-        
-        // Scale to seconds
-        m_phase = pi_output * m_params.ui;
-        
-        // =====================================================================
-        // Step 4: Phase range limiting
-        // =====================================================================
-        double range = m_params.pai.range;
-        m_phase = std::max(-range, std::min(range, m_phase));
-        
-        // Anti-windup
-        if (m_phase >= range || m_phase <= -range) {
-            m_integral = m_phase / m_params.ui - prop_term;
-        }
-        
-        // Save current data sample for next comparison
-        m_prev_data_sample = m_data_sample;
-        
-        // Reset state for next UI
-        m_sample_state = SampleState::WAIT_EDGE;
+    // A trigger's sample reaches `in` (or `edge_in`) one step of trigger
+    // delay plus decision_latency after the trigger was written. The held
+    // sampler output in between is not re-evaluated, so the loop updates
+    // once per UI and the proportional step lasts the whole UI.
+    for (auto& p : m_pending) {
+        --p.wait;
     }
-    else if (m_sample_state == SampleState::WAIT_EDGE) {
-        // We were waiting for edge sample (first trigger in UI)
-        m_edge_sample = sampled_value;
-        // Next we wait for data sample
-        m_sample_state = SampleState::WAIT_DATA;
+    while (!m_pending.empty() && m_pending.front().wait <= 0) {
+        bool edge = m_pending.front().edge;
+        m_pending.pop_front();
+        if (edge) {
+            // Edge sample (UI boundary): kept for the next data sample
+            m_edge_value = (edge_in.size() > 0) ? edge_in[0].read() : in.read();
+        } else {
+            // Data sample (UI center): phase detection, then loop update.
+            // Two-sample PDs compare it with the edge before it.
+            update_loop(m_pd.detect(m_edge_value, in.read()));
+        }
     }
     
     // ========================================================================
-    // Step 5: Generate sampling triggers (two per UI)
+    // Step 5: Generate sampling triggers
     // ========================================================================
-    // Update free-running phase
-    m_free_running_phase += timestep;
-    
-    // Calculate total phase with current CDR adjustment
-    double quantized_phase = std::round(m_phase / m_params.pai.resolution) 
-                             * m_params.pai.resolution;
-    double total_phase = m_free_running_phase + quantized_phase;
-    
-    // Phase within UI
-    double phase_in_ui = std::fmod(total_phase, m_params.ui);
-    if (phase_in_ui < 0) phase_in_ui += m_params.ui;
-    
-    // Previous phase
-    double prev_total = total_phase - timestep;
-    double prev_in_ui = std::fmod(prev_total, m_params.ui);
-    if (prev_in_ui < 0) prev_in_ui += m_params.ui;
-    
-    // Two sampling points within UI
-    // Edge at UI boundary (0 or UI), Data at UI/2
-    double edge_point = 0.0;  // or m_params.ui (same position)
-    double data_point = m_params.ui / 2.0;
-    
-    bool trigger = false;
-    
-    // Check which trigger to generate based on state
-    if (m_sample_state == SampleState::WAIT_EDGE) {
-        // Waiting for edge trigger (at UI boundary)
-        if (prev_in_ui < edge_point && phase_in_ui >= edge_point) {
-            trigger = true;
-        }
-        // Handle wrap-around at UI boundary
-        else if (prev_in_ui > phase_in_ui && phase_in_ui >= edge_point) {
-            trigger = true;
-        }
-    }
-    else { // WAIT_DATA
-        // Waiting for data trigger (at UI/2)
-        if (prev_in_ui < data_point && phase_in_ui >= data_point) {
-            trigger = true;
+    // Advance the fixed-point sampling clock; total phase = accumulator -
+    // PAI code offset (positive phase delays sampling), one UI = 2^64.
+    // Edge at UI boundary, data at UI/2 (edge only for two-sample PDs).
+    // The next sampling point is armed only once the current one fired, so
+    // each fires exactly once per UI.
+    m_nco.advance();
+    
+    std::uint64_t target = (m_sample_state == SampleState::WAIT_EDGE)
+                           ? CdrPhaseNco::EDGE_POINT
+                           : CdrPhaseNco::DATA_POINT;
+    std::uint64_t since = 0;
+    bool fired = m_nco.crossed(target, since);
+    bool edge_fired = fired && m_sample_state == SampleState::WAIT_EDGE;
+    if (fired) {
+        m_pending.push_back({1 + m_params.decision_latency, edge_fired});
+        if (m_pd.needs_edge_sample()) {
+            m_sample_state = edge_fired ? SampleState::WAIT_DATA : SampleState::WAIT_EDGE;
         }
     }
     
     // ========================================================================
     // Step 6: Output
     // ========================================================================
-    phase_out.write(quantized_phase);
+    // With a separate edge strobe, sampling_trigger carries data triggers only
+    bool trigger = fired && (edge_trigger.size() == 0 || !edge_fired);
+    phase_out.write(m_quantized_phase);
     sampling_trigger.write(trigger);
+    m_trigger_bits = (m_trigger_bits << 1) | (trigger ? 1u : 0u);
+    if (edge_trigger.size() > 0) {
+        m_edge_out = edge_fired;
+        edge_trigger[0].write(m_edge_out);
+    }
+    
+    if (sampling_offset.size() > 0) {
+        // crossed() guarantees since < one timestep increment
+        m_offset_out = fired ? m_nco.to_seconds(since) : 0.0;
+        sampling_offset[0].write(m_offset_out);
+    }
 }
 
 } // namespace serdes
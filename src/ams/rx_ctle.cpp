@@ -1,6 +1,7 @@
 #include "ams/rx_ctle.h"
 #include <cmath>
 #include <sstream>
+#include <stdexcept>
 
 namespace serdes {
 
@@ -11,6 +12,7 @@ RxCtleTdf::RxCtleTdf(sc_core::sc_module_name nm, const RxCtleParams& params)
     , vdd("vdd")
     , out_p("out_p")
     , out_n("out_n")
+    , cfg_de("cfg_de")
     , m_params(params)
     , m_ctle_filter_enabled(false)
     , m_psrr_enabled(false)
@@ -19,9 +21,27 @@ RxCtleTdf::RxCtleTdf(sc_core::sc_module_name nm, const RxCtleParams& params)
     , m_vcm_prev(params.vcm_out)
     , m_out_p_prev(params.vcm_out)
     , m_out_n_prev(params.vcm_out)
-    , m_rng(std::random_device{}())
-    , m_noise_dist(0.0, params.vnoise_sigma)
+    , m_active_setting(0)
+    , m_cfg_zero(0.0)
+    , m_cfg_pole(0.0)
+    , m_cfg_dc_gain(0.0)
+    , m_noise(params.noise_seed, name())
 {
+    if (m_params.adapt.enable) {
+        int n_zeros = 0, n_poles = 0;
+        for (double fz : m_params.zeros) if (fz > 0.0) ++n_zeros;
+        for (double fp : m_params.poles) if (fp > 0.0) ++n_poles;
+        if (n_zeros > n_poles) {
+            throw std::invalid_argument("CTLE: runtime reconfiguration requires zeros <= poles");
+        }
+        for (const auto& st : m_params.adapt.settings) {
+            if (!(std::isfinite(st.zero) && st.zero > 0.0 && std::isfinite(st.pole) && st.pole > 0.0 &&
+                  std::isfinite(st.dc_gain) && st.dc_gain > 0.0)) {
+                throw std::invalid_argument("CTLE: adapt.settings must have positive zero, pole and dc_gain");
+            }
+        }
+        cfg_de.init(3);
+    }
 }
 
 RxCtleTdf::~RxCtleTdf() {
@@ -43,6 +63,10 @@ void RxCtleTdf::initialize() {
     m_vcm_prev = m_params.vcm_out;
     m_out_p_prev = m_params.vcm_out;
     m_out_n_prev = m_params.vcm_out;
+    m_state_ctle.resize(0);
+    m_state_psrr.resize(0);
+    m_state_cmrr.resize(0);
+    m_state_cmfb.resize(0);
     
     // Build main CTLE transfer function if zeros or poles are defined
     if (!m_params.zeros.empty() || !m_params.poles.empty()) {
@@ -58,6 +82,20 @@ void RxCtleTdf::initialize() {
         m_ctle_filter_enabled = false;
     }
     
+    // Runtime reconfiguration: pre-discretize the base setting and the bank;
+    // processing() only selects among these, it never discretizes
+    if (m_params.adapt.enable) {
+        m_bank.configure(m_params.zeros, m_params.poles, get_timestep().to_seconds());
+        m_cfg_zero = m_params.zeros.empty() ? 0.0 : m_params.zeros[0];
+        m_cfg_pole = m_params.poles.empty() ? 0.0 : m_params.poles[0];
+        m_cfg_dc_gain = m_params.dc_gain;
+        m_active_setting = m_bank.find_or_build(m_cfg_zero, m_cfg_pole, m_cfg_dc_gain);
+        for (const auto& st : m_params.adapt.settings) {
+            m_bank.find_or_build(st.zero, st.pole, st.dc_gain);
+        }
+        m_cascade.resize(m_bank.get_num_sections());
+    }
+    
     // Build PSRR transfer function if enabled
     if (m_params.psrr.enable) {
         build_transfer_function(m_params.psrr.zeros, m_params.psrr.poles,
@@ -81,6 +119,48 @@ void RxCtleTdf::initialize() {
                                m_params.cmfb.loop_gain, m_num_cmfb, m_den_cmfb);
         m_cmfb_enabled = true;
     }
+    
+    if (!m_restore.empty()) {
+        const std::string key = std::string(name()) + ".";
+        m_restore.get_sca_vector(key + "ctle_state", m_state_ctle);
+        m_restore.get_sca_vector(key + "psrr_state", m_state_psrr);
+        m_restore.get_sca_vector(key + "cmrr_state", m_state_cmrr);
+        m_restore.get_sca_vector(key + "cmfb_state", m_state_cmfb);
+        m_out_p_prev = m_restore.get_real(key + "out_p_prev");
+        m_out_n_prev = m_restore.get_real(key + "out_n_prev");
+        m_noise.restore_state(m_restore, key + "noise");
+        if (m_params.adapt.enable) {
+            m_cascade.restore_state(m_restore, key + "cascade");
+            const std::vector<double>& cfg = m_restore.get_real_vector(key + "cfg");
+            if (cfg.size() != 3) {
+                throw std::invalid_argument("RX CTLE: malformed checkpoint entry 'cfg'");
+            }
+            m_cfg_zero = cfg[0];
+            m_cfg_pole = cfg[1];
+            m_cfg_dc_gain = cfg[2];
+            m_active_setting = m_bank.find_nearest(m_cfg_zero, m_cfg_pole, m_cfg_dc_gain);
+        }
+        m_restore.clear();
+    }
+}
+
+void RxCtleTdf::save_state(StateCheckpoint& cp) const {
+    const std::string key = std::string(name()) + ".";
+    cp.put_sca_vector(key + "ctle_state", m_state_ctle);
+    cp.put_sca_vector(key + "psrr_state", m_state_psrr);
+    cp.put_sca_vector(key + "cmrr_state", m_state_cmrr);
+    cp.put_sca_vector(key + "cmfb_state", m_state_cmfb);
+    cp.put_real(key + "out_p_prev", m_out_p_prev);
+    cp.put_real(key + "out_n_prev", m_out_n_prev);
+    m_noise.save_state(cp, key + "noise");
+    if (m_params.adapt.enable) {
+        m_cascade.save_state(cp, key + "cascade");
+        cp.put_real(key + "cfg", std::vector<double>{m_cfg_zero, m_cfg_pole, m_cfg_dc_gain});
+    }
+}
+
+void RxCtleTdf::restore_state(const StateCheckpoint& cp) {
+    m_restore = cp.subset(std::string(name()) + ".");
 }
 
 void RxCtleTdf::processing() {
@@ -100,16 +180,20 @@ void RxCtleTdf::processing() {
     
     // Step 3: Add noise if enabled
     if (m_params.noise_enable) {
-        vin_diff += m_noise_dist(m_rng);
+        vin_diff += m_params.vnoise_sigma * m_noise.next_normal();
     }
     
     // Step 4: Main CTLE filtering with zero-pole transfer function
     // H(s) = dc_gain * prod(1 + s/wz_i) / prod(1 + s/wp_j)
     double vout_diff_linear;
-    if (m_ctle_filter_enabled) {
+    if (m_params.adapt.enable) {
+        // Cached discrete coefficients; state carries over setting changes
+        read_cfg_updates();
+        vout_diff_linear = m_cascade.process(m_bank.get(m_active_setting), vin_diff);
+    } else if (m_ctle_filter_enabled) {
         // Apply Laplace transfer function using sca_ltf_nd
         // The ltf_nd operator() applies the filter: output = H(s) * input
-        vout_diff_linear = m_ltf_ctle(m_num_ctle, m_den_ctle, vin_diff);
+        vout_diff_linear = m_ltf_ctle(m_num_ctle, m_den_ctle, m_state_ctle, vin_diff);
     } else {
         // Fallback to simple DC gain
         vout_diff_linear = m_params.dc_gain * vin_diff;
@@ -124,14 +208,14 @@ void RxCtleTdf::processing() {
     double vout_psrr = 0.0;
     if (m_psrr_enabled) {
         double vdd_deviation = v_vdd - m_params.psrr.vdd_nom;
-        vout_psrr = m_ltf_psrr(m_num_psrr, m_den_psrr, vdd_deviation);
+        vout_psrr = m_ltf_psrr(m_num_psrr, m_den_psrr, m_state_psrr, vdd_deviation);
     }
     
     // Step 7: CMRR path - common-mode to differential conversion
     // Models imperfect common-mode rejection
     double vout_cmrr = 0.0;
     if (m_cmrr_enabled) {
-        vout_cmrr = m_ltf_cmrr(m_num_cmrr, m_den_cmrr, vin_cm);
+        vout_cmrr = m_ltf_cmrr(m_num_cmrr, m_den_cmrr, m_state_cmrr, vin_cm);
     }
     
     // Step 8: Combine all differential contributions
@@ -146,7 +230,7 @@ void RxCtleTdf::processing() {
         // Error signal: difference from target
         double vcm_error = m_params.vcm_out - vcm_measured;
         // CMFB correction through loop filter
-        double vcm_correction = m_ltf_cmfb(m_num_cmfb, m_den_cmfb, vcm_error);
+        double vcm_correction = m_ltf_cmfb(m_num_cmfb, m_den_cmfb, m_state_cmfb, vcm_error);
         vcm_eff = m_params.vcm_out + vcm_correction;
     }
     
@@ -163,6 +247,30 @@ void RxCtleTdf::processing() {
     m_out_n_prev = v_out_n;
 }
 
+// read_cfg_updates: 读取DE域配置并切换系数组
+// 1. 非正或非有限值视为"保持当前值"（AdaptionDe 初始化前信号为0）
+// 2. 仅在配置变化时查找/构建系数组，常规路径只有三次比较
+// 3. 吸附到预构建设置（adapt.settings 与基础设置）中最近的一组，
+//    处理路径不离散化、不分配内存
+void RxCtleTdf::read_cfg_updates() {
+    double zero = cfg_de[CFG_ZERO].read();
+    double pole = cfg_de[CFG_POLE].read();
+    double dc_gain = cfg_de[CFG_DC_GAIN].read();
+    
+    if (!(std::isfinite(zero) && zero > 0.0)) zero = m_cfg_zero;
+    if (!(std::isfinite(pole) && pole > 0.0)) pole = m_cfg_pole;
+    if (!(std::isfinite(dc_gain) && dc_gain > 0.0)) dc_gain = m_cfg_dc_gain;
+    
+    if (zero == m_cfg_zero && pole == m_cfg_pole && dc_gain == m_cfg_dc_gain) {
+        return;
+    }
+    m_cfg_zero = zero;
+    m_cfg_pole = pole;
+    m_cfg_dc_gain = dc_gain;
+    
+    m_active_setting = m_bank.find_nearest(zero, pole, dc_gain);
+}
+
 // apply_saturation: 应用软饱和函数
 // 功能说明：
 // 1. 使用双曲正切函数(tanh)实现软饱和特性
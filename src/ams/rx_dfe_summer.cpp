@@ -6,6 +6,8 @@
 #include "ams/rx_dfe_summer.h"
 #include <iostream>
 #include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 
 namespace serdes {
 
@@ -15,23 +17,38 @@ RxDfeSummerTdf::RxDfeSummerTdf(sc_core::sc_module_name nm,
     , in_p("in_p")
     , in_n("in_n")
     , data_in("data_in")
+    , sampling_trigger("sampling_trigger")
     , out_p("out_p")
     , out_n("out_n")
-    , tap1_de("tap1_de")
-    , tap2_de("tap2_de")
-    , tap3_de("tap3_de")
-    , tap4_de("tap4_de")
-    , tap5_de("tap5_de")
+    , tap_de("tap_de")
+    , tap_seq_de("tap_seq_de")
     , m_params(params)
     , m_last_feedback(0.0)
+    , m_feedback_dirty(true)
+    , m_feedback_updates(0)
+    , m_decisions(0)
+    , m_samples_per_ui(1)
+    , m_ui_count(0)
+    , m_last_tap_seq(0)
     , m_de_ports_connected(false)
 {
-    // 初始化抽头系数
-    m_tap_coeffs = m_params.tap_coeffs;
+    // 初始化抽头系数与历史缓冲区（全零）
+    m_kernel.configure(m_params.tap_coeffs, m_params.map_mode == "pm1", m_params.vtap);
+    if (!m_params.floating_positions.empty() || !m_params.floating_coeffs.empty()) {
+        m_kernel.configure_floating(m_params.floating_positions, m_params.floating_coeffs);
+    }
     
-    // 初始化历史缓冲区（全零）
-    size_t tap_count = m_tap_coeffs.size();
-    m_history_bits.resize(tap_count, 0.0);
+    // 每个抽头一个 DE 更新端口
+    tap_de.init(m_params.tap_coeffs.size());
+    if (m_params.tap_update_seq) {
+        tap_seq_de.init(1);
+    }
+    if (m_params.decision_trigger) {
+        if (m_params.decision_latency < 0) {
+            throw std::invalid_argument("DFE Summer: decision_latency must be >= 0");
+        }
+        sampling_trigger.init(1);
+    }
 }
 
 void RxDfeSummerTdf::set_attributes()
@@ -46,6 +63,30 @@ void RxDfeSummerTdf::set_attributes()
     data_in.set_delay(1);  // 添加 1 个样本延迟，打破反馈环路
     out_p.set_rate(1);
     out_n.set_rate(1);
+    
+    // 触发与 data_in 对齐：触发步（加插值延迟）的判决在其后一个样本可读
+    if (sampling_trigger.size() > 0) {
+        sampling_trigger[0].set_rate(1);
+        sampling_trigger[0].set_delay(1 + m_params.decision_latency);
+    }
+}
+
+void RxDfeSummerTdf::initialize()
+{
+    double dt = get_timestep().to_seconds();
+    m_samples_per_ui = std::max(1, static_cast<int>(std::lround(m_params.ui / dt)));
+    
+    // 检查点恢复：延迟端口中尚未读取的样本
+    for (size_t i = 0; i < m_data_in_tokens.size(); ++i) {
+        data_in.initialize(m_data_in_tokens[i], i);
+    }
+    if (sampling_trigger.size() > 0) {
+        for (size_t i = 0; i < m_trigger_tokens.size(); ++i) {
+            sampling_trigger[0].initialize(m_trigger_tokens[i], i);
+        }
+    }
+    m_data_in_tokens.clear();
+    m_trigger_tokens.clear();
 }
 
 void RxDfeSummerTdf::processing()
@@ -68,63 +109,47 @@ void RxDfeSummerTdf::processing()
     }
     
     // ========================================================================
-    // 步骤 3: 读取历史判决并更新缓冲区
+    // 步骤 3: UI 判决沿移入新判决并读取抽头更新（UI 内其余样本复用反馈）
     // ========================================================================
     double new_bit = data_in.read();
-    update_history(new_bit);
-    
-    // ========================================================================
-    // 步骤 4: 尝试从 DE 端口读取抽头更新
-    // ========================================================================
-    read_de_tap_updates();
+    if (decision_edge()) {
+        update_history(new_bit);
+        read_de_tap_updates();
+    }
     
     // ========================================================================
-    // 步骤 5: 计算反馈电压
+    // 步骤 4: 计算反馈电压（仅在历史或抽头变化时重算，否则复用缓存）
     // ========================================================================
-    double v_fb = compute_feedback();
-    m_last_feedback = v_fb;
+    if (m_feedback_dirty) {
+        m_last_feedback = compute_feedback();
+        m_feedback_dirty = false;
+        ++m_feedback_updates;
+    }
+    double v_fb = m_last_feedback;
     
     // ========================================================================
-    // 步骤 6: 差分求和
+    // 步骤 5: 差分求和
     // ========================================================================
     double v_eq = v_main - v_fb;
     
     // ========================================================================
-    // 步骤 7: 可选软饱和限幅
+    // 步骤 6: 可选软饱和限幅
     // ========================================================================
     if (m_params.sat_enable) {
         v_eq = soft_saturate(v_eq);
     }
     
     // ========================================================================
-    // 步骤 8: 共模合成输出
+    // 步骤 7: 共模合成输出
     // ========================================================================
     out_p.write(m_params.vcm_out + 0.5 * v_eq);
     out_n.write(m_params.vcm_out - 0.5 * v_eq);
 }
 
-double RxDfeSummerTdf::bit_map(double bit_val) const
-{
-    if (m_params.map_mode == "pm1") {
-        // ±1 映射：0 → -1, 1 → +1
-        return (bit_val > 0.5) ? 1.0 : -1.0;
-    } else {
-        // 0/1 映射：0 → 0, 1 → 1
-        return (bit_val > 0.5) ? 1.0 : 0.0;
-    }
-}
-
 double RxDfeSummerTdf::compute_feedback() const
 {
-    double v_fb = 0.0;
-    size_t tap_count = std::min(m_tap_coeffs.size(), m_history_bits.size());
-    
-    for (size_t k = 0; k < tap_count; ++k) {
-        double bit_mapped = bit_map(m_history_bits[k]);
-        v_fb += m_tap_coeffs[k] * bit_mapped * m_params.vtap;
-    }
-    
-    return v_fb;
+    // 打包比特点积：每个抽头按历史比特选择 ±c·vtap（或 0/c·vtap）并累加
+    return m_kernel.feedback();
 }
 
 double RxDfeSummerTdf::soft_saturate(double v_in) const
@@ -136,59 +161,71 @@ double RxDfeSummerTdf::soft_saturate(double v_in) const
     return v_center + v_sat * std::tanh(v_in / v_sat);
 }
 
+bool RxDfeSummerTdf::decision_edge()
+{
+    if (sampling_trigger.size() > 0) {
+        return sampling_trigger[0].read();
+    }
+    // 无 CDR 触发：每 ui / 时间步 个样本移入一次
+    if (++m_ui_count < m_samples_per_ui) {
+        return false;
+    }
+    m_ui_count = 0;
+    return true;
+}
+
 void RxDfeSummerTdf::update_history(double new_bit)
 {
-    // FIFO 队列：移位并插入新比特
-    // history[0] = b[n-1] (最近), history[N-1] = b[n-N] (最远)
-    
-    if (m_history_bits.empty()) return;
-    
-    // 右移所有元素
-    for (size_t i = m_history_bits.size() - 1; i > 0; --i) {
-        m_history_bits[i] = m_history_bits[i - 1];
+    // 移位寄存器：bit 0 = b[k-1] (上一 UI), bit N-1 = b[k-N] (N UI 前)
+    // 连续相同判决时打包历史可能不变，反馈无需重算
+    ++m_decisions;
+    if (m_kernel.push(new_bit > 0.5)) {
+        m_feedback_dirty = true;
     }
-    
-    // 插入新比特到位置 0
-    m_history_bits[0] = new_bit;
 }
 
 void RxDfeSummerTdf::read_de_tap_updates()
 {
-    // 尝试从 DE 端口读取抽头更新
-    // 注意：只有当端口被连接时才读取
-    // SystemC-AMS 的 sca_de 端口在未连接时会返回默认值
-    
-    // 读取各抽头更新（如果有变化则更新）
-    if (m_tap_coeffs.size() >= 1) {
-        double tap1_val = tap1_de.read();
-        if (std::isfinite(tap1_val)) {
-            m_tap_coeffs[0] = tap1_val;
+    // 序号模式：DfeAdaptTdf 每次写抽头时递增序号，序号不变则跳过
+    if (tap_seq_de.size() > 0) {
+        int seq = tap_seq_de[0].read();
+        if (seq == m_last_tap_seq) {
+            return;
         }
+        m_last_tap_seq = seq;
     }
-    if (m_tap_coeffs.size() >= 2) {
-        double tap2_val = tap2_de.read();
-        if (std::isfinite(tap2_val)) {
-            m_tap_coeffs[1] = tap2_val;
+    
+    // 逐端口读取抽头更新，非有限值忽略
+    for (size_t k = 0; k < tap_de.size(); ++k) {
+        double tap_val = tap_de[k].read();
+        if (std::isfinite(tap_val) && m_kernel.set_tap(k, tap_val)) {
+            m_feedback_dirty = true;
         }
     }
-    if (m_tap_coeffs.size() >= 3) {
-        double tap3_val = tap3_de.read();
-        if (std::isfinite(tap3_val)) {
-            m_tap_coeffs[2] = tap3_val;
-        }
+}
+
+void RxDfeSummerTdf::save_state(StateCheckpoint& cp) const
+{
+    m_kernel.save_state(cp, std::string(name()) + ".kernel");
+    cp.put_int(std::string(name()) + ".ui_count", m_ui_count);
+}
+
+void RxDfeSummerTdf::restore_state(const StateCheckpoint& cp)
+{
+    m_kernel.restore_state(cp, std::string(name()) + ".kernel");
+    if (cp.has(std::string(name()) + ".ui_count")) {
+        m_ui_count = static_cast<int>(cp.get_int(std::string(name()) + ".ui_count"));
     }
-    if (m_tap_coeffs.size() >= 4) {
-        double tap4_val = tap4_de.read();
-        if (std::isfinite(tap4_val)) {
-            m_tap_coeffs[3] = tap4_val;
-        }
+    if (cp.has(std::string(name()) + ".data_in_tokens")) {
+        m_data_in_tokens = cp.get_real_vector(std::string(name()) + ".data_in_tokens");
     }
-    if (m_tap_coeffs.size() >= 5) {
-        double tap5_val = tap5_de.read();
-        if (std::isfinite(tap5_val)) {
-            m_tap_coeffs[4] = tap5_val;
+    if (cp.has(std::string(name()) + ".trigger_tokens")) {
+        m_trigger_tokens.clear();
+        for (std::int64_t t : cp.get_int_vector(std::string(name()) + ".trigger_tokens")) {
+            m_trigger_tokens.push_back(t != 0);
         }
     }
+    m_feedback_dirty = true;
 }
 
 } // namespace serdes
@@ -10,17 +10,26 @@ RxSamplerTdf::RxSamplerTdf(sc_core::sc_module_name nm, const RxSamplerParams& pa
     , in_n("in_n")
     , clk_sample("clk_sample")
     , sampling_trigger("sampling_trigger")
+    , sampling_offset("sampling_offset")
     , data_out("data_out")
     , data_out_de("data_out_de")
+    , value_out("value_out")
     , m_params(params)
     , m_prev_bit(false)
     , m_last_sampled_bit(false)
-    , m_rng(params.noise_seed)
-    , m_noise_dist(0.0, params.noise_sigma)
-    , m_decision_dist(0.0, 1.0)
+    , m_last_value(0.0)
+    , m_noise(params.noise_seed, name())
 {
     // Validate parameters during construction
     validate_parameters();
+    
+    m_interp.configure(parse_sample_interp(m_params.interp), m_params.interp_taps);
+    if (m_interp.get_kind() != SampleInterpKind::NONE) {
+        sampling_offset.init(1);
+    }
+    if (m_params.value_output) {
+        value_out.init(1);
+    }
 }
 
 void RxSamplerTdf::set_attributes() {
@@ -29,7 +38,13 @@ void RxSamplerTdf::set_attributes() {
     in_n.set_rate(1);
     clk_sample.set_rate(1);
     sampling_trigger.set_rate(1);
+    for (auto& port : sampling_offset) {
+        port.set_rate(1);
+    }
     data_out.set_rate(1);
+    for (auto& port : value_out) {
+        port.set_rate(1);
+    }
     // data_out_de is DE domain, no need to set rate
     // Inherit timestep from upstream modules
 }
@@ -38,10 +53,56 @@ void RxSamplerTdf::initialize() {
     // Initialize previous bit state
     m_prev_bit = false;
     m_last_sampled_bit = false;
+    m_last_value = 0.0;
+    
+    // Restart noise stream from the configured seed
+    m_noise.reseed(m_params.noise_seed, name());
+    
+    m_interp.reset();
+    m_pending.clear();
     
-    // Reset random number generator with configured seed
-    m_rng.seed(m_params.noise_seed);
-    m_noise_dist = std::normal_distribution<double>(0.0, m_params.noise_sigma);
+    if (!m_restore.empty()) {
+        const std::string key = std::string(name()) + ".";
+        m_prev_bit = m_restore.get_int(key + "prev_bit") != 0;
+        m_last_sampled_bit = m_restore.get_int(key + "last_bit") != 0;
+        m_last_value = m_restore.get_real(key + "last_value");
+        m_noise.restore_state(m_restore, key + "noise");
+        if (m_interp.get_kind() != SampleInterpKind::NONE) {
+            m_interp.restore_state(m_restore, key + "interp");
+            const std::vector<std::int64_t>& wait = m_restore.get_int_vector(key + "pending_wait");
+            const std::vector<double>& offset = m_restore.get_real_vector(key + "pending_offset");
+            if (wait.size() != offset.size()) {
+                throw std::invalid_argument("Sampler: malformed checkpoint pending decisions");
+            }
+            for (size_t k = 0; k < wait.size(); ++k) {
+                m_pending.push_back({static_cast<int>(wait[k]), offset[k]});
+            }
+        }
+        m_restore.clear();
+    }
+}
+
+void RxSamplerTdf::save_state(StateCheckpoint& cp) const {
+    const std::string key = std::string(name()) + ".";
+    cp.put_int(key + "prev_bit", m_prev_bit ? 1 : 0);
+    cp.put_int(key + "last_bit", m_last_sampled_bit ? 1 : 0);
+    cp.put_real(key + "last_value", m_last_value);
+    m_noise.save_state(cp, key + "noise");
+    if (m_interp.get_kind() != SampleInterpKind::NONE) {
+        m_interp.save_state(cp, key + "interp");
+        std::vector<std::int64_t> wait;
+        std::vector<double> offset;
+        for (const auto& p : m_pending) {
+            wait.push_back(p.wait);
+            offset.push_back(p.offset);
+        }
+        cp.put_int(key + "pending_wait", wait);
+        cp.put_real(key + "pending_offset", offset);
+    }
+}
+
+void RxSamplerTdf::restore_state(const StateCheckpoint& cp) {
+    m_restore = cp.subset(std::string(name()) + ".");
 }
 
 void RxSamplerTdf::processing() {
@@ -50,28 +111,30 @@ void RxSamplerTdf::processing() {
     
     bool trigger = sampling_trigger.read();
     
-    if (trigger) {
-        // Read differential inputs
-        double v_in_p = in_p.read();
-        double v_in_n = in_n.read();
-        
-        // Calculate differential voltage
-        double v_diff = v_in_p - v_in_n;
-        
-        // Apply offset if enabled
-        if (m_params.offset_enable) {
-            v_diff += m_params.offset_value;
+    if (m_interp.get_kind() == SampleInterpKind::NONE) {
+        if (trigger) {
+            // Decide on the grid sample at the trigger step
+            decide(in_p.read() - in_n.read());
         }
+        // else: no trigger, keep previous value (sample-and-hold)
+    } else {
+        // Interpolated mode: the decision for a trigger is taken get_interp_latency()
+        // steps later, once the kernel has samples on both sides of the instant
+        m_interp.push(in_p.read() - in_n.read());
         
-        // Inject noise if enabled
-        if (m_params.noise_enable) {
-            v_diff += m_noise_dist(m_rng);
+        for (auto& p : m_pending) {
+            --p.wait;
+        }
+        if (trigger) {
+            double dt = get_timestep().to_seconds();
+            m_pending.push_back({m_interp.get_latency(), sampling_offset[0].read() / dt});
+        }
+        while (!m_pending.empty() && m_pending.front().wait <= 0) {
+            const PendingDecision& p = m_pending.front();
+            decide(m_interp.at(m_interp.get_latency() - p.wait + p.offset));
+            m_pending.pop_front();
         }
-        
-        // Make decision and save
-        m_last_sampled_bit = make_decision(v_diff);
     }
-    // else: no trigger, keep previous value (sample-and-hold)
     
     // Update previous bit state (for hysteresis in decision)
     m_prev_bit = m_last_sampled_bit;
@@ -79,6 +142,25 @@ void RxSamplerTdf::processing() {
     // Write outputs (always the last sampled value)
     data_out.write(m_last_sampled_bit ? 1.0 : 0.0);
     data_out_de.write(m_last_sampled_bit);
+    if (value_out.size() > 0) {
+        value_out[0].write(m_last_value);
+    }
+}
+
+void RxSamplerTdf::decide(double v_diff) {
+    // Apply offset if enabled
+    if (m_params.offset_enable) {
+        v_diff += m_params.offset_value;
+    }
+    
+    // Inject noise if enabled
+    if (m_params.noise_enable) {
+        v_diff += m_params.noise_sigma * m_noise.next_normal();
+    }
+    
+    // Make decision and save
+    m_last_sampled_bit = make_decision(v_diff);
+    m_last_value = v_diff - m_params.threshold;
 }
 
 void RxSamplerTdf::validate_parameters() {
@@ -106,7 +188,7 @@ bool RxSamplerTdf::make_decision(double v_diff) {
     // Check if we're in the fuzzy decision region
     if (std::abs(v_diff) < m_params.resolution) {
         // Fuzzy region: random decision based on Bernoulli distribution
-        bit_out = (m_decision_dist(m_rng) < 0.5) ? false : true;
+        bit_out = (m_noise.next_uniform() < 0.5) ? false : true;
     } else {
         // Deterministic region: hysteresis-based decision
         if (v_diff > m_params.threshold + m_params.hysteresis / 2.0) {
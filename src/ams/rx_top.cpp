@@ -1,5 +1,10 @@
 #include "ams/rx_top.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace serdes {
 
@@ -23,17 +28,16 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     , m_sig_vref_neg_out("sig_vref_neg_out")
     , m_sig_cdr_phase("sig_cdr_phase")
     , m_sig_cdr_in("sig_cdr_in")
+    , m_sig_edge_trigger("sig_edge_trigger")
+    , m_sig_edge_out("sig_edge_out")
+    , m_sig_edge_value("sig_edge_value")
+    , m_sig_sampling_offset("sig_sampling_offset")
+    , m_sig_sampler_value("sig_sampler_value")
     , m_sig_data_feedback("sig_data_feedback")
     , m_sig_clk("sig_clk")
     // DfeAdaptTdf -> DFE Summer taps
-    , m_sig_dfe_tap1_de("sig_dfe_tap1_de")
-    , m_sig_dfe_tap2_de("sig_dfe_tap2_de")
-    , m_sig_dfe_tap3_de("sig_dfe_tap3_de")
-    , m_sig_dfe_tap4_de("sig_dfe_tap4_de")
-    , m_sig_dfe_tap5_de("sig_dfe_tap5_de")
-    , m_sig_dfe_tap6_de("sig_dfe_tap6_de")
-    , m_sig_dfe_tap7_de("sig_dfe_tap7_de")
-    , m_sig_dfe_tap8_de("sig_dfe_tap8_de")
+    , m_sig_dfe_tap_de("sig_dfe_tap_de")
+    , m_sig_dfe_tap_seq_de("sig_dfe_tap_seq_de")
     // DfeAdaptTdf -> AdaptionDe statistics
     , m_sig_stat_N_A_de("sig_stat_N_A_de")
     , m_sig_stat_N_B_de("sig_stat_N_B_de")
@@ -47,6 +51,7 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     , m_sig_stat_mu_de("sig_stat_mu_de")
     , m_sig_stat_update_count_de("sig_stat_update_count_de")
     , m_sig_vref_current_de("sig_vref_current_de")
+    , m_sig_adapt_tick_de("sig_adapt_tick_de")
     // AdaptionDe -> DfeAdaptTdf control
     , m_sig_mode_de("sig_mode_de")
     , m_sig_reset_de("sig_reset_de")
@@ -77,13 +82,18 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
 
     m_ctle = new RxCtleTdf("ctle", m_params.ctle);
     m_vga = new RxVgaTdf("vga", m_params.vga);
-    m_dfe_summer = new RxDfeSummerTdf("dfe_summer", m_params.dfe_summer);
-
     // Main sampler: threshold = 0 (data decision d_k)
     RxSamplerParams sampler_params = m_params.sampler;
     sampler_params.phase_source = "phase";
     sampler_params.threshold = 0.0;
+    // Linear and baud-rate phase detectors, and the error-magnitude DFE
+    // adaptation algorithms, need the sampled voltage
+    bool cdr_uses_value = (m_params.cdr.pd != PhaseDetectorType::BANG_BANG);
+    bool dfe_uses_value = dfe_update_needs_error_magnitude(
+        parse_dfe_update_algorithm(m_adaption_params.dfe.algorithm));
+    sampler_params.value_output = cdr_uses_value || dfe_uses_value;
     m_sampler = new RxSamplerTdf("sampler", sampler_params);
+    sampler_params.value_output = false;
 
     // +Vref comparator: threshold = +Vref
     double vref_pos = m_adaption_params.vref_adapt.vref_pos;
@@ -99,18 +109,62 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     vref_neg_params.hysteresis = 0.0;
     m_vref_neg_sampler = new RxSamplerTdf("vref_neg_sampler", vref_neg_params);
 
-    m_cdr = new RxCdrTdf("cdr", m_params.cdr);
-
-    // DFE Adaptation Engine (TDF domain, Plan A)
+    // Edge sampler for the two-sample phase detectors, on the CDR's edge
+    // triggers, so the main sampler and everything behind it see one
+    // (data) trigger per UI
+    m_edge_sampler = nullptr;
+    if (m_params.cdr.pd != PhaseDetectorType::MUELLER_MULLER) {
+        RxSamplerParams edge_params = sampler_params;
+        edge_params.value_output = cdr_uses_value;
+        m_edge_sampler = new RxSamplerTdf("edge_sampler", edge_params);
+    }
+
+    // Summer re-reads the tap ports only when DfeAdaptTdf bumps tap_seq_de;
+    // until the first write it runs on the adaptation engine's initial taps.
+    // Its history shifts on the CDR sampling trigger, once per UI, so tap k
+    // is the decision k UIs back as DfeAdaptTdf assumes
+    RxDfeSummerParams dfe_summer_params = m_params.dfe_summer;
+    dfe_summer_params.tap_update_seq = true;
+    dfe_summer_params.decision_trigger = true;
+    dfe_summer_params.decision_latency = m_sampler->get_interp_latency();
+    for (size_t k = 0; k < dfe_summer_params.tap_coeffs.size(); ++k) {
+        const std::vector<double>& init = m_adaption_params.dfe.initial_taps;
+        dfe_summer_params.tap_coeffs[k] = (k < init.size()) ? init[k] : 0.0;
+    }
+    m_dfe_summer = new RxDfeSummerTdf("dfe_summer", dfe_summer_params);
+
+    // Interpolating samplers need the CDR's sub-timestep sampling offset
+    bool sampler_interp = (m_params.sampler.interp != "none");
+    CdrParams cdr_params = m_params.cdr;
+    cdr_params.fractional_trigger = cdr_params.fractional_trigger || sampler_interp;
+    cdr_params.decision_latency = m_sampler->get_interp_latency();
+    cdr_params.edge_strobe = true;
+    m_cdr = new RxCdrTdf("cdr", cdr_params);
+
+    // DFE Adaptation Engine (TDF domain, Plan A); in "event" mode it also
+    // ticks AdaptionDe every event_decimation fast periods
+    int tick_period_ui = 0;
+    if (m_adaption_params.update_mode == "event") {
+        long n = std::lround(m_adaption_params.event_decimation *
+                             m_adaption_params.fast_update_period / m_adaption_params.UI);
+        tick_period_ui = static_cast<int>(std::max(1L, n));
+    }
     m_dfe_adapt = new DfeAdaptTdf("dfe_adapt",
                                    m_adaption_params.dfe,
-                                   m_adaption_params.vref_adapt);
+                                   m_adaption_params.vref_adapt,
+                                   tick_period_ui);
+    m_dfe_adapt->set_summer_mapping(dfe_summer_params.vtap, dfe_summer_params.map_mode);
 
     // ========================================================================
     // Instantiate sub-modules (DE domain)
     // ========================================================================
 
     m_adaption = new AdaptionDe("adaption", m_adaption_params);
+    // AdaptionDe holds the CTLE knobs; start them at the configured CTLE
+    // so the cfg_de link does not override it
+    m_adaption->set_ctle_setting(m_params.ctle.zeros.empty() ? 0.0 : m_params.ctle.zeros[0],
+                                 m_params.ctle.poles.empty() ? 0.0 : m_params.ctle.poles[0],
+                                 m_params.ctle.dc_gain);
 
     // ========================================================================
     // Instantiate helper modules
@@ -131,6 +185,13 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     m_ctle->vdd(vdd);
     m_ctle->out_p(m_sig_ctle_out_p);
     m_ctle->out_n(m_sig_ctle_out_n);
+    
+    // AdaptionDe CTLE outputs -> CTLE runtime configuration (if enabled)
+    if (m_params.ctle.adapt.enable) {
+        m_ctle->cfg_de[RxCtleTdf::CFG_ZERO](m_sig_ctle_zero_de);
+        m_ctle->cfg_de[RxCtleTdf::CFG_POLE](m_sig_ctle_pole_de);
+        m_ctle->cfg_de[RxCtleTdf::CFG_DC_GAIN](m_sig_ctle_dc_gain_de);
+    }
 
     m_vga->in_p(m_sig_ctle_out_p);
     m_vga->in_n(m_sig_ctle_out_n);
@@ -168,11 +229,42 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     m_vref_pos_sampler->clk_sample(m_sig_clk);
     m_vref_neg_sampler->clk_sample(m_sig_clk);
 
-    // CDR sampling trigger -> all three comparators
+    // CDR data trigger -> all three comparators
     m_cdr->sampling_trigger(m_sig_sampling_trigger);
     m_sampler->sampling_trigger(m_sig_sampling_trigger);
     m_vref_pos_sampler->sampling_trigger(m_sig_sampling_trigger);
     m_vref_neg_sampler->sampling_trigger(m_sig_sampling_trigger);
+    m_dfe_summer->sampling_trigger[0](m_sig_sampling_trigger);
+
+    if (cdr_params.fractional_trigger) {
+        m_cdr->sampling_offset[0](m_sig_sampling_offset);
+    }
+    if (sampler_interp) {
+        m_sampler->sampling_offset[0](m_sig_sampling_offset);
+        m_vref_pos_sampler->sampling_offset[0](m_sig_sampling_offset);
+        m_vref_neg_sampler->sampling_offset[0](m_sig_sampling_offset);
+    }
+
+    // CDR edge trigger -> edge sampler -> CDR edge_in (same differential
+    // input as the main sampler)
+    if (m_edge_sampler) {
+        m_edge_sampler->in_p(m_sig_dfe_to_main_in);
+        m_edge_sampler->in_n(m_sig_dfe_out_n);
+        m_edge_sampler->clk_sample(m_sig_clk);
+        m_cdr->edge_trigger[0](m_sig_edge_trigger);
+        m_edge_sampler->sampling_trigger(m_sig_edge_trigger);
+        if (sampler_interp) {
+            m_edge_sampler->sampling_offset[0](m_sig_sampling_offset);
+        }
+        m_edge_sampler->data_out(m_sig_edge_out);
+        m_edge_sampler->data_out_de(m_sig_dummy_data_out_de_edge);
+        if (cdr_uses_value) {
+            m_edge_sampler->value_out[0](m_sig_edge_value);
+            m_cdr->edge_in[0](m_sig_edge_value);
+        } else {
+            m_cdr->edge_in[0](m_sig_edge_out);
+        }
+    }
 
     // Main sampler output (data_out) -> downstream
     m_sampler->data_out(m_sig_sampler_out);
@@ -187,7 +279,14 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     m_sampler_splitter->out2(m_sig_cdr_in);         // -> CDR
 
     m_dfe_summer->data_in(m_sig_data_feedback);
-    m_cdr->in(m_sig_cdr_in);
+    if (m_sampler->value_out.size() > 0) {
+        m_sampler->value_out[0](m_sig_sampler_value);
+    }
+    if (cdr_uses_value) {
+        m_cdr->in(m_sig_sampler_value);
+    } else {
+        m_cdr->in(m_sig_cdr_in);
+    }
     m_cdr->phase_out(m_sig_cdr_phase);
 
     // Bind unused data_out_de ports to dummy signals (required by SystemC-AMS)
@@ -214,6 +313,9 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     m_dfe_adapt->vref_pos_in(m_sig_vref_pos_out);
     m_dfe_adapt->vref_neg_in(m_sig_vref_neg_out);
     m_dfe_adapt->sampling_trigger(m_sig_sampling_trigger);
+    if (m_dfe_adapt->value_in.size() > 0) {
+        m_dfe_adapt->value_in[0](m_sig_sampler_value);
+    }
 
     // DE control inputs
     m_dfe_adapt->mode_de(m_sig_mode_de);
@@ -223,20 +325,19 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     // ========================================================================
     // Connect DfeAdaptTdf outputs -> DFE Summer taps
     // ========================================================================
-    m_dfe_adapt->tap1_de(m_sig_dfe_tap1_de);
-    m_dfe_adapt->tap2_de(m_sig_dfe_tap2_de);
-    m_dfe_adapt->tap3_de(m_sig_dfe_tap3_de);
-    m_dfe_adapt->tap4_de(m_sig_dfe_tap4_de);
-    m_dfe_adapt->tap5_de(m_sig_dfe_tap5_de);
-    m_dfe_adapt->tap6_de(m_sig_dfe_tap6_de);
-    m_dfe_adapt->tap7_de(m_sig_dfe_tap7_de);
-    m_dfe_adapt->tap8_de(m_sig_dfe_tap8_de);
-
-    m_dfe_summer->tap1_de(m_sig_dfe_tap1_de);
-    m_dfe_summer->tap2_de(m_sig_dfe_tap2_de);
-    m_dfe_summer->tap3_de(m_sig_dfe_tap3_de);
-    m_dfe_summer->tap4_de(m_sig_dfe_tap4_de);
-    m_dfe_summer->tap5_de(m_sig_dfe_tap5_de);
+    // One signal per tap; sized for the larger of the two tap counts, so
+    // summer taps beyond the adaptation engine's read an unwritten signal
+    size_t n_tap_signals = std::max(m_dfe_adapt->tap_de.size(),
+                                    m_dfe_summer->tap_de.size());
+    m_sig_dfe_tap_de.init(n_tap_signals);
+    for (size_t k = 0; k < m_dfe_adapt->tap_de.size(); ++k) {
+        m_dfe_adapt->tap_de[k](m_sig_dfe_tap_de[k]);
+    }
+    for (size_t k = 0; k < m_dfe_summer->tap_de.size(); ++k) {
+        m_dfe_summer->tap_de[k](m_sig_dfe_tap_de[k]);
+    }
+    m_dfe_adapt->tap_seq_de(m_sig_dfe_tap_seq_de);
+    m_dfe_summer->tap_seq_de[0](m_sig_dfe_tap_seq_de);
 
     // ========================================================================
     // Connect DfeAdaptTdf statistics -> AdaptionDe
@@ -263,6 +364,10 @@ RxTopModule::RxTopModule(sc_core::sc_module_name nm,
     m_adaption->stat_C(m_sig_stat_C_de);
     m_adaption->stat_Delta(m_sig_stat_Delta_de);
     m_adaption->stat_dfe_state(m_sig_stat_state_de);
+    if (m_adaption->adapt_tick.size() > 0) {
+        m_dfe_adapt->adapt_tick[0](m_sig_adapt_tick_de);
+        m_adaption->adapt_tick[0](m_sig_adapt_tick_de);
+    }
 
     // ========================================================================
     // Connect AdaptionDe -> DfeAdaptTdf (control)
@@ -309,6 +414,7 @@ RxTopModule::~RxTopModule()
     delete m_sampler;
     delete m_vref_pos_sampler;
     delete m_vref_neg_sampler;
+    delete m_edge_sampler;
     delete m_cdr;
     delete m_dfe_adapt;
     delete m_adaption;
@@ -328,4 +434,51 @@ double RxTopModule::get_cdr_integral_state() const
     return m_cdr->get_integral_state();
 }
 
+void RxTopModule::save_state(StateCheckpoint& cp) const
+{
+    m_ctle->save_state(cp);
+    m_vga->save_state(cp);
+    m_dfe_summer->save_state(cp);
+    m_sampler->save_state(cp);
+    m_vref_pos_sampler->save_state(cp);
+    m_vref_neg_sampler->save_state(cp);
+    if (m_edge_sampler) {
+        m_edge_sampler->save_state(cp);
+    }
+    m_cdr->save_state(cp);
+    m_dfe_adapt->save_state(cp);
+    m_adaption->save_state(cp);
+    
+    // Samples in flight through the summer's delayed inputs, which only the
+    // writers know: the sampler's last decision (data_in, delay 1) and the
+    // CDR triggers written 1 .. 1 + latency steps before the end (the
+    // newest one sits in the CDR's own output delay)
+    const std::string summer = std::string(m_dfe_summer->name()) + ".";
+    cp.put_real(summer + "data_in_tokens",
+                std::vector<double>{m_sampler->get_last_sampled_bit() ? 1.0 : 0.0});
+    const int latency = m_sampler->get_interp_latency();
+    const std::uint64_t triggers = m_cdr->get_trigger_history();
+    std::vector<std::int64_t> tokens;
+    for (int i = 0; i <= latency; ++i) {
+        tokens.push_back(static_cast<std::int64_t>((triggers >> (latency + 1 - i)) & 1u));
+    }
+    cp.put_int(summer + "trigger_tokens", tokens);
+}
+
+void RxTopModule::restore_state(const StateCheckpoint& cp)
+{
+    m_ctle->restore_state(cp);
+    m_vga->restore_state(cp);
+    m_dfe_summer->restore_state(cp);
+    m_sampler->restore_state(cp);
+    m_vref_pos_sampler->restore_state(cp);
+    m_vref_neg_sampler->restore_state(cp);
+    if (m_edge_sampler) {
+        m_edge_sampler->restore_state(cp);
+    }
+    m_cdr->restore_state(cp);
+    m_dfe_adapt->restore_state(cp);
+    m_adaption->restore_state(cp);
+}
+
 } // namespace serdes
@@ -19,8 +19,7 @@ RxVgaTdf::RxVgaTdf(sc_core::sc_module_name nm, const RxVgaParams& params)
     , m_vcm_prev(params.vcm_out)
     , m_out_p_prev(params.vcm_out)
     , m_out_n_prev(params.vcm_out)
-    , m_rng(std::random_device{}())
-    , m_noise_dist(0.0, params.vnoise_sigma)
+    , m_noise(params.noise_seed, name())
 {
 }
 
@@ -43,6 +42,10 @@ void RxVgaTdf::initialize() {
     m_vcm_prev = m_params.vcm_out;
     m_out_p_prev = m_params.vcm_out;
     m_out_n_prev = m_params.vcm_out;
+    m_state_vga.resize(0);
+    m_state_psrr.resize(0);
+    m_state_cmrr.resize(0);
+    m_state_cmfb.resize(0);
     
     // Build main VGA transfer function if zeros or poles are defined
     if (!m_params.zeros.empty() || !m_params.poles.empty()) {
@@ -81,6 +84,33 @@ void RxVgaTdf::initialize() {
                                m_params.cmfb.loop_gain, m_num_cmfb, m_den_cmfb);
         m_cmfb_enabled = true;
     }
+    
+    if (!m_restore.empty()) {
+        const std::string key = std::string(name()) + ".";
+        m_restore.get_sca_vector(key + "vga_state", m_state_vga);
+        m_restore.get_sca_vector(key + "psrr_state", m_state_psrr);
+        m_restore.get_sca_vector(key + "cmrr_state", m_state_cmrr);
+        m_restore.get_sca_vector(key + "cmfb_state", m_state_cmfb);
+        m_out_p_prev = m_restore.get_real(key + "out_p_prev");
+        m_out_n_prev = m_restore.get_real(key + "out_n_prev");
+        m_noise.restore_state(m_restore, key + "noise");
+        m_restore.clear();
+    }
+}
+
+void RxVgaTdf::save_state(StateCheckpoint& cp) const {
+    const std::string key = std::string(name()) + ".";
+    cp.put_sca_vector(key + "vga_state", m_state_vga);
+    cp.put_sca_vector(key + "psrr_state", m_state_psrr);
+    cp.put_sca_vector(key + "cmrr_state", m_state_cmrr);
+    cp.put_sca_vector(key + "cmfb_state", m_state_cmfb);
+    cp.put_real(key + "out_p_prev", m_out_p_prev);
+    cp.put_real(key + "out_n_prev", m_out_n_prev);
+    m_noise.save_state(cp, key + "noise");
+}
+
+void RxVgaTdf::restore_state(const StateCheckpoint& cp) {
+    m_restore = cp.subset(std::string(name()) + ".");
 }
 
 void RxVgaTdf::processing() {
@@ -100,7 +130,7 @@ void RxVgaTdf::processing() {
     
     // Step 3: Add noise if enabled
     if (m_params.noise_enable) {
-        vin_diff += m_noise_dist(m_rng);
+        vin_diff += m_params.vnoise_sigma * m_noise.next_normal();
     }
     
     // Step 4: Main VGA filtering with zero-pole transfer function
@@ -109,7 +139,7 @@ void RxVgaTdf::processing() {
     if (m_vga_filter_enabled) {
         // Apply Laplace transfer function using sca_ltf_nd
         // The ltf_nd operator() applies the filter: output = H(s) * input
-        vout_diff_linear = m_ltf_vga(m_num_vga, m_den_vga, vin_diff);
+        vout_diff_linear = m_ltf_vga(m_num_vga, m_den_vga, m_state_vga, vin_diff);
     } else {
         // Fallback to simple DC gain
         vout_diff_linear = m_params.dc_gain * vin_diff;
@@ -124,14 +154,14 @@ void RxVgaTdf::processing() {
     double vout_psrr = 0.0;
     if (m_psrr_enabled) {
         double vdd_deviation = v_vdd - m_params.psrr.vdd_nom;
-        vout_psrr = m_ltf_psrr(m_num_psrr, m_den_psrr, vdd_deviation);
+        vout_psrr = m_ltf_psrr(m_num_psrr, m_den_psrr, m_state_psrr, vdd_deviation);
     }
     
     // Step 7: CMRR path - common-mode to differential conversion
     // Models imperfect common-mode rejection
     double vout_cmrr = 0.0;
     if (m_cmrr_enabled) {
-        vout_cmrr = m_ltf_cmrr(m_num_cmrr, m_den_cmrr, vin_cm);
+        vout_cmrr = m_ltf_cmrr(m_num_cmrr, m_den_cmrr, m_state_cmrr, vin_cm);
     }
     
     // Step 8: Combine all differential contributions
@@ -146,7 +176,7 @@ void RxVgaTdf::processing() {
         // Error signal: difference from target
         double vcm_error = m_params.vcm_out - vcm_measured;
         // CMFB correction through loop filter
-        double vcm_correction = m_ltf_cmfb(m_num_cmfb, m_den_cmfb, vcm_error);
+        double vcm_correction = m_ltf_cmfb(m_num_cmfb, m_den_cmfb, m_state_cmfb, vcm_error);
         vcm_eff = m_params.vcm_out + vcm_correction;
     }
     
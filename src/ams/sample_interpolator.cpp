@@ -0,0 +1,152 @@
+#include "ams/sample_interpolator.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace serdes {
+
+SampleInterpKind parse_sample_interp(const std::string& name) {
+    if (name == "none") return SampleInterpKind::NONE;
+    if (name == "cubic") return SampleInterpKind::CUBIC;
+    if (name == "sinc") return SampleInterpKind::SINC;
+    throw std::invalid_argument(
+        "Sampler interpolation must be 'none', 'cubic' or 'sinc'. "
+        "Current value: " + name);
+}
+
+SampleInterpolator::SampleInterpolator()
+    : m_kind(SampleInterpKind::NONE)
+    , m_half_width(0)
+    , m_size(1)
+    , m_head(0)
+{
+    m_hist.assign(2, 0.0);
+}
+
+void SampleInterpolator::configure(SampleInterpKind kind, int sinc_taps) {
+    m_kind = kind;
+    switch (kind) {
+        case SampleInterpKind::NONE:
+            m_half_width = 0;
+            break;
+        case SampleInterpKind::CUBIC:
+            m_half_width = 2;
+            break;
+        case SampleInterpKind::SINC:
+            if (sinc_taps < 4 || sinc_taps > 32 || (sinc_taps % 2) != 0) {
+                throw std::invalid_argument(
+                    "Sampler sinc interpolation taps must be even and in [4, 32]");
+            }
+            m_half_width = sinc_taps / 2;
+            break;
+    }
+
+    // Enough history for the kernel plus a few samples of caller slack
+    m_size = 4 * m_half_width + 4;
+    m_hist.assign(2 * m_size, 0.0);
+    m_head = 0;
+
+    m_table.clear();
+    if (kind == SampleInterpKind::SINC) {
+        build_sinc_table();
+    }
+}
+
+void SampleInterpolator::reset() {
+    std::fill(m_hist.begin(), m_hist.end(), 0.0);
+    m_head = 0;
+}
+
+void SampleInterpolator::push(double x) {
+    m_head = (m_head == 0) ? m_size - 1 : m_head - 1;
+    m_hist[m_head] = x;
+    m_hist[m_head + m_size] = x;
+}
+
+void SampleInterpolator::save_state(StateCheckpoint& cp, const std::string& key) const {
+    cp.put_real(key + ".hist", m_hist);
+    cp.put_int(key + ".head", m_head);
+}
+
+void SampleInterpolator::restore_state(const StateCheckpoint& cp, const std::string& key) {
+    const std::vector<double>& hist = cp.get_real_vector(key + ".hist");
+    std::int64_t head = cp.get_int(key + ".head");
+    if (hist.size() != m_hist.size() || head < 0 || head >= m_size) {
+        throw std::invalid_argument("SampleInterpolator: checkpoint size mismatch at '" +
+                                    key + "'");
+    }
+    m_hist = hist;
+    m_head = static_cast<int>(head);
+}
+
+// Tap k of phase f multiplies the sample at age i-W+1+k, i.e. sits at
+// tau = f + W - 1 - k timesteps from the target instant
+void SampleInterpolator::build_sinc_table() {
+    const int W = m_half_width;
+    const int n_taps = 2 * W;
+    m_table.assign(static_cast<size_t>(TABLE_PHASES + 1) * n_taps, 0.0);
+
+    for (int p = 0; p <= TABLE_PHASES; ++p) {
+        double f = static_cast<double>(p) / TABLE_PHASES;
+        double* row = &m_table[static_cast<size_t>(p) * n_taps];
+        double sum = 0.0;
+        for (int k = 0; k < n_taps; ++k) {
+            double tau = f + (W - 1 - k);
+            double s = (std::abs(tau) < 1e-12) ? 1.0 : std::sin(M_PI * tau) / (M_PI * tau);
+            double u = tau / W;
+            double w = (std::abs(u) >= 1.0) ? 0.0
+                     : 0.42 + 0.5 * std::cos(M_PI * u) + 0.08 * std::cos(2.0 * M_PI * u);
+            row[k] = s * w;
+            sum += row[k];
+        }
+        for (int k = 0; k < n_taps; ++k) {
+            row[k] /= sum;
+        }
+    }
+}
+
+double SampleInterpolator::at(double delay) const {
+    if (m_kind == SampleInterpKind::NONE) {
+        int age = std::max(0, std::min(m_size - 1, static_cast<int>(std::lround(delay))));
+        return sample_age(age);
+    }
+
+    const int W = m_half_width;
+    double lo = static_cast<double>(W - 1);
+    double hi = static_cast<double>(m_size - W - 1);
+    delay = std::max(lo, std::min(hi, delay));
+
+    int i = static_cast<int>(std::floor(delay));
+    double f = delay - i;
+
+    if (m_kind == SampleInterpKind::CUBIC) {
+        // Lagrange through ages i+2, i+1, i, i-1 at positions -1, 0, 1, 2
+        double x = 1.0 - f;
+        double ym1 = sample_age(i + 2);
+        double y0 = sample_age(i + 1);
+        double y1 = sample_age(i);
+        double y2 = sample_age(i - 1);
+        double wm1 = -x * (x - 1.0) * (x - 2.0) / 6.0;
+        double w0 = (x + 1.0) * (x - 1.0) * (x - 2.0) / 2.0;
+        double w1 = -(x + 1.0) * x * (x - 2.0) / 2.0;
+        double w2 = (x + 1.0) * x * (x - 1.0) / 6.0;
+        return wm1 * ym1 + w0 * y0 + w1 * y1 + w2 * y2;
+    }
+
+    // Windowed sinc: blend the two nearest tabulated phases
+    const int n_taps = 2 * W;
+    double pos = f * TABLE_PHASES;
+    int p = std::min(static_cast<int>(pos), TABLE_PHASES - 1);
+    double g = pos - p;
+    const double* h0 = &m_table[static_cast<size_t>(p) * n_taps];
+    const double* h1 = h0 + n_taps;
+    const double* x = &m_hist[m_head + i - W + 1];
+
+    double acc = 0.0;
+    for (int k = 0; k < n_taps; ++k) {
+        acc += (h0[k] + g * (h1[k] - h0[k])) * x[k];
+    }
+    return acc;
+}
+
+} // namespace serdes
@@ -24,6 +24,9 @@ SerdesLinkTopModule::SerdesLinkTopModule(sc_core::sc_module_name nm,
     , m_sig_rx_in_n("sig_rx_in_n")
     , m_sig_data_out("sig_data_out")
     , m_params(params)
+    , m_wavegen(nullptr)
+    , m_pulse_stim(nullptr)
+    , m_pulse_probe(nullptr)
     , m_dfe_tap_p(nullptr)
     , m_dfe_tap_n(nullptr)
     , m_vga_tap_p(nullptr)
@@ -34,14 +37,25 @@ SerdesLinkTopModule::SerdesLinkTopModule(sc_core::sc_module_name nm,
     // Create Sub-modules
     // ========================================================================
     
-    std::cout << "    [Link] Creating WaveGen..." << std::endl;
-    // Wave Generator - data rate determined by UI (1 / data_rate)
     double ui = 1.0 / m_params.data_rate;
-    m_wavegen = new WaveGenerationTdf("wavegen", 
-                                      m_params.wave, 
-                                      m_params.sample_rate, 
-                                      ui,           // UI parameter
-                                      m_params.seed);
+    // Noise blocks without their own noise_seed draw from the link seed
+    m_params.rx.inherit_noise_seed(m_params.seed);
+    
+    if (m_params.pulse_extract.enabled) {
+        std::cout << "    [Link] Creating pulse-response extraction stimulus/probe..." << std::endl;
+        m_pulse_stim = new PulseStimulusTdf("pulse_stim", m_params.pulse_extract,
+                                            m_params.sample_rate, ui);
+        m_pulse_probe = new PulseResponseProbeTdf("pulse_probe", m_params.pulse_extract,
+                                                  m_pulse_stim->get_samples_per_ui());
+    } else {
+        std::cout << "    [Link] Creating WaveGen..." << std::endl;
+        // Wave Generator - data rate determined by UI (1 / data_rate)
+        m_wavegen = new WaveGenerationTdf("wavegen", 
+                                          m_params.wave, 
+                                          m_params.sample_rate, 
+                                          ui,           // UI parameter
+                                          m_params.seed);
+    }
     
     std::cout << "    [Link] Creating TX..." << std::endl;
     
@@ -82,8 +96,12 @@ SerdesLinkTopModule::SerdesLinkTopModule(sc_core::sc_module_name nm,
     // Connect Signal Chain
     // ========================================================================
     
-    // WaveGen output -> TX input
-    m_wavegen->out(m_sig_wavegen_out);
+    // WaveGen (or extraction stimulus) output -> TX input
+    if (m_pulse_stim) {
+        m_pulse_stim->out(m_sig_wavegen_out);
+    } else {
+        m_wavegen->out(m_sig_wavegen_out);
+    }
     m_tx->in(m_sig_wavegen_out);
     
     // TX vdd connection
@@ -138,6 +156,12 @@ SerdesLinkTopModule::SerdesLinkTopModule(sc_core::sc_module_name nm,
     m_vga_tap_n->in(const_cast<sca_tdf::sca_signal<double>&>(m_rx->get_vga_out_n_signal()));
     m_vga_tap_n->out(mon_vga_out_n);
     
+    // Extraction probe on the linear-path output (VGA, before the DFE)
+    if (m_pulse_probe) {
+        m_pulse_probe->in_p(const_cast<sca_tdf::sca_signal<double>&>(m_rx->get_vga_out_p_signal()));
+        m_pulse_probe->in_n(const_cast<sca_tdf::sca_signal<double>&>(m_rx->get_vga_out_n_signal()));
+    }
+    
     // CDR phase output monitoring
     m_cdr_tap->in(const_cast<sca_tdf::sca_signal<double>&>(m_rx->get_cdr_phase_signal()));
     m_cdr_tap->out(mon_cdr_phase);
@@ -145,6 +169,8 @@ SerdesLinkTopModule::SerdesLinkTopModule(sc_core::sc_module_name nm,
 
 SerdesLinkTopModule::~SerdesLinkTopModule() {
     delete m_wavegen;
+    delete m_pulse_stim;
+    delete m_pulse_probe;
     delete m_tx;
     delete m_d2s;
     delete m_channel;
@@ -161,7 +187,7 @@ SerdesLinkTopModule::~SerdesLinkTopModule() {
 }
 
 double SerdesLinkTopModule::get_dfe_tap(int tap_index) const {
-    if (!m_rx || tap_index < 1 || tap_index > 5) return 0.0;
+    if (!m_rx || tap_index < 1 || tap_index > m_rx->get_num_dfe_tap_signals()) return 0.0;
     // Access through RxTop's getter
     return const_cast<SerdesLinkTopModule*>(this)->m_rx->get_dfe_tap_signal(tap_index).read();
 }
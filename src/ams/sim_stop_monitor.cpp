@@ -0,0 +1,58 @@
+#include "ams/sim_stop_monitor.h"
+#include <iostream>
+#include <stdexcept>
+
+namespace serdes {
+
+SimStopMonitor::SimStopMonitor(sc_core::sc_module_name nm, const StopCriteriaParams& params,
+                               int num_taps)
+    : sc_core::sc_module(nm)
+    , locked("locked")
+    , bit_count("bit_count")
+    , error_count("error_count")
+    , sync_losses("sync_losses")
+    , tap("tap")
+    , m_params(params)
+    , m_stop_time(0.0)
+    , m_check_count(0)
+{
+    if (num_taps < 0) {
+        throw std::invalid_argument("SimStopMonitor: num_taps must be >= 0");
+    }
+    m_criteria.configure(params);
+    tap.init(num_taps);
+    SC_THREAD(check_process);
+}
+
+void SimStopMonitor::check_process() {
+    const sc_core::sc_time period(m_params.check_interval, sc_core::SC_SEC);
+    LinkMetrics m;
+    m.taps.resize(tap.size());
+
+    while (true) {
+        wait(period);
+        ++m_check_count;
+
+        m.time = sc_core::sc_time_stamp().to_seconds();
+        m.locked = locked.read();
+        m.bits = static_cast<std::uint64_t>(bit_count.read());
+        m.errors = static_cast<std::uint64_t>(error_count.read());
+        m.sync_losses = static_cast<std::uint64_t>(sync_losses.read());
+        for (size_t i = 0; i < tap.size(); ++i) {
+            m.taps[i] = tap[i].read();
+        }
+        m.cdr_phase = m_phase_probe ? m_phase_probe() : 0.0;
+
+        StopReason reason = m_criteria.evaluate(m);
+        if (reason != StopReason::NONE) {
+            m_stop_time = m.time;
+            std::cout << "[" << name() << "] Stop at " << m.time * 1e6 << " us: "
+                      << stop_reason_name(reason) << " (" << m.errors << " errors in "
+                      << m.bits << " bits)" << std::endl;
+            sc_core::sc_stop();
+            return;
+        }
+    }
+}
+
+} // namespace serdes
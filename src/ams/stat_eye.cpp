@@ -0,0 +1,280 @@
+#include "ams/stat_eye.h"
+#include "ams/eq_seed.h"
+#include "common/fft.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+namespace serdes {
+
+namespace {
+
+typedef std::complex<double> Complex;
+
+/**
+ * Spectrum of a unit mass at fractional bin position u on an N-point
+ * circular grid, split linearly between the two neighbouring bins;
+ * twiddle[m] = exp(-2 pi i m / N) keeps every term exact.
+ */
+class DeltaSpectrum {
+public:
+    explicit DeltaSpectrum(size_t n) : m_twiddle(n) {
+        for (size_t m = 0; m < n; ++m) {
+            m_twiddle[m] = std::polar(1.0, -2.0 * M_PI * static_cast<double>(m) / static_cast<double>(n));
+        }
+    }
+
+    void add(std::vector<Complex>& X, double u, double weight) const {
+        const size_t n = m_twiddle.size();
+        double fl = std::floor(u);
+        double frac = u - fl;
+        long long j0 = static_cast<long long>(fl) % static_cast<long long>(n);
+        size_t m0 = static_cast<size_t>(j0 < 0 ? j0 + static_cast<long long>(n) : j0);
+        size_t m1 = (m0 + 1) % n;
+        double w0 = weight * (1.0 - frac);
+        double w1 = weight * frac;
+        size_t i0 = 0, i1 = 0;
+        for (size_t k = 0; k < n; ++k) {
+            X[k] += w0 * m_twiddle[i0] + w1 * m_twiddle[i1];
+            i0 += m0; if (i0 >= n) i0 -= n;
+            i1 += m1; if (i1 >= n) i1 -= n;
+        }
+    }
+
+private:
+    std::vector<Complex> m_twiddle;
+};
+
+double normal_cdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+// Jitter PDF over phase offsets -J..J (samples): dual-Dirac at +/-dj/2
+// convolved with Gaussian rj
+std::vector<double> jitter_kernel(double dj, double rj, int samples_per_ui, int& half_span) {
+    const double spu = static_cast<double>(samples_per_ui);
+    if (dj <= 0.0 && rj <= 0.0) {
+        half_span = 0;
+        return std::vector<double>(1, 1.0);
+    }
+    std::vector<double> w;
+    if (rj > 0.0) {
+        half_span = static_cast<int>(std::ceil((0.5 * dj + 7.0 * rj) * spu));
+        w.assign(2 * half_span + 1, 0.0);
+        for (int j = -half_span; j <= half_span; ++j) {
+            double lo = (j - 0.5) / spu;
+            double hi = (j + 0.5) / spu;
+            for (double d : {-0.5 * dj, 0.5 * dj}) {
+                w[j + half_span] += 0.5 * (normal_cdf((hi - d) / rj) - normal_cdf((lo - d) / rj));
+            }
+        }
+    } else {
+        double u = 0.5 * dj * spu;
+        half_span = static_cast<int>(std::floor(u)) + 1;
+        w.assign(2 * half_span + 1, 0.0);
+        int j0 = static_cast<int>(std::floor(u));
+        double frac = u - j0;
+        for (int s : {-1, 1}) {
+            w[half_span + s * j0] += 0.5 * (1.0 - frac);
+            w[half_span + s * (j0 + 1)] += 0.5 * frac;
+        }
+    }
+    double sum = 0.0;
+    for (double x : w) sum += x;
+    for (double& x : w) x /= sum;
+    return w;
+}
+
+} // namespace
+
+StatEyeResult compute_stat_eye(const std::vector<double>& pulse_in, int samples_per_ui,
+                               const StatEyeParams& params) {
+    if (pulse_in.empty() || samples_per_ui < 1) {
+        throw std::invalid_argument("StatEye: empty pulse or samples_per_ui < 1");
+    }
+    if (params.voltage_bins < 4 || params.voltage_bins % 2 != 0 || params.window_factor <= 0.0) {
+        throw std::invalid_argument("StatEye: voltage_bins must be even and >= 4, window_factor > 0");
+    }
+    if (params.num_dfe < 0 || params.noise_sigma < 0.0 || params.dj < 0.0 || params.rj < 0.0) {
+        throw std::invalid_argument("StatEye: num_dfe, noise and jitter must be >= 0");
+    }
+    if (!(params.target_ber > 0.0 && params.target_ber < 0.5)) {
+        throw std::invalid_argument("StatEye: target_ber must be in (0, 0.5)");
+    }
+
+    // Main cursor at the pulse peak; an inverting path is flipped
+    const int n = static_cast<int>(pulse_in.size());
+    int main = 0;
+    for (int i = 1; i < n; ++i) {
+        if (std::fabs(pulse_in[i]) > std::fabs(pulse_in[main])) main = i;
+    }
+    if (pulse_in[main] == 0.0) {
+        throw std::invalid_argument("StatEye: pulse response is zero");
+    }
+    const double sign = pulse_in[main] > 0.0 ? 1.0 : -1.0;
+    std::vector<double> pulse(pulse_in);
+    for (double& x : pulse) x *= sign;
+    const int spu = samples_per_ui;
+    auto at = [&](int idx) { return (idx >= 0 && idx < n) ? pulse[idx] : 0.0; };
+
+    // DFE: fixed taps or ideal cancellation at the main phase
+    std::vector<double> dfe = params.dfe_taps;
+    if (dfe.empty()) {
+        for (int k = 1; k <= params.num_dfe; ++k) dfe.push_back(at(main + k * spu));
+    }
+
+    int half_span = 0;
+    std::vector<double> jitter = jitter_kernel(params.dj, params.rj, spu, half_span);
+    const int first = -spu / 2 - half_span;               // Phase offsets (samples)
+    const int last = first + spu + 2 * half_span;         // Exclusive
+    const int num_k_pre = (main - first) / spu + 1;      // Cursors reaching sample 0
+    const int num_k_post = (n - main - first) / spu + 1;  // and the pulse end
+
+    // Cursors per phase: c[0] is the main cursor
+    std::vector<std::vector<double>> cursors;
+    double reach = 0.0;
+    for (int o = first; o < last; ++o) {
+        std::vector<double> c(1, at(main + o));
+        double sum = std::fabs(c[0]);
+        for (int k = -num_k_pre; k <= num_k_post; ++k) {
+            if (k == 0) continue;
+            double h = at(main + o + k * spu);
+            if (k >= 1 && k <= static_cast<int>(dfe.size())) h -= dfe[k - 1];
+            if (h != 0.0) {
+                c.push_back(h);
+                sum += std::fabs(h);
+            }
+        }
+        reach = std::max(reach, sum);
+        cursors.push_back(c);
+    }
+
+    // Voltage grid: display window of voltage_bins inside a power-of-two
+    // FFT grid wide enough that the ISI + noise support does not wrap
+    const int vb = params.voltage_bins;
+    const double dv = 2.0 * params.window_factor * pulse[main] / vb;
+    reach += 8.0 * params.noise_sigma + 2.0 * dv;
+    const size_t nfft = next_pow2(std::max<size_t>(2 * static_cast<size_t>(vb),
+                                  2 * static_cast<size_t>(std::ceil(reach / dv)) + 2));
+    const int half = static_cast<int>(nfft / 2);
+    DeltaSpectrum delta(nfft);
+
+    // Noise as a binned Gaussian histogram (exact bin masses keep the
+    // convolution non-negative even when sigma is below one bin)
+    std::vector<Complex> noise_cf(nfft, Complex(1.0, 0.0));
+    if (params.noise_sigma > 0.0) {
+        std::fill(noise_cf.begin(), noise_cf.end(), Complex(0.0, 0.0));
+        const double s = params.noise_sigma;
+        const int span = std::min(half - 1, static_cast<int>(std::ceil(8.0 * s / dv)) + 1);
+        for (int j = -span; j <= span; ++j) {
+            double mass = normal_cdf(((j + 0.5) * dv) / s) - normal_cdf(((j - 0.5) * dv) / s);
+            noise_cf[(j + static_cast<int>(nfft)) % nfft] = mass;
+        }
+        fft_radix2(noise_cf, false);
+    }
+
+    // Raw (jitter-free) BER per phase over display bins, plus threshold 0
+    const int num_raw = last - first;
+    std::vector<double> raw(static_cast<size_t>(num_raw) * (vb + 1), 0.0);
+    std::vector<Complex> S(nfft), D(nfft);
+    std::vector<double> cdf(nfft);
+    for (int r = 0; r < num_raw; ++r) {
+        const std::vector<double>& c = cursors[r];
+        std::fill(S.begin(), S.end(), Complex(0.0, 0.0));
+        delta.add(S, c[0] / dv, 1.0);                     // Data bit +1
+        for (size_t i = 1; i < c.size(); ++i) {
+            std::fill(D.begin(), D.end(), Complex(0.0, 0.0));
+            delta.add(D, c[i] / dv, 0.5);
+            delta.add(D, -c[i] / dv, 0.5);
+            for (size_t k = 0; k < nfft; ++k) S[k] *= D[k];
+        }
+        for (size_t k = 0; k < nfft; ++k) S[k] *= noise_cf[k];
+        fft_radix2(S, true);
+
+        // cdf[t]: P(X < voltage of bin t - half), half of the bin itself included
+        double acc = 0.0;
+        for (size_t t = 0; t < nfft; ++t) {
+            size_t idx = (t + nfft - static_cast<size_t>(half)) % nfft;
+            double p = std::max(0.0, S[idx].real() / static_cast<double>(nfft));
+            cdf[t] = acc + 0.5 * p;
+            acc += p;
+        }
+        // NRZ: BER(v) = (P(X1 < v) + P(X0 > v)) / 2 and X0 = -X1 in law
+        double* row = &raw[static_cast<size_t>(r) * (vb + 1)];
+        for (int v = 0; v < vb; ++v) {
+            int i = v - vb / 2;
+            double b = 0.5 * (cdf[half + i] + cdf[half - i]) / acc;
+            row[v] = std::min(1.0, b);
+        }
+        row[vb] = std::min(1.0, cdf[half] / acc);
+    }
+
+    // Jitter: average the BER over the phase-offset PDF
+    StatEyeResult res;
+    res.num_phases = spu;
+    res.num_bins = vb;
+    res.main_cursor = pulse[main] * sign;
+    res.phase.resize(spu);
+    res.voltage.resize(vb);
+    res.ber.assign(static_cast<size_t>(spu) * vb, 0.0);
+    res.ber_zero.assign(spu, 0.0);
+    for (int v = 0; v < vb; ++v) res.voltage[v] = (v - vb / 2) * dv;
+    for (int p = 0; p < spu; ++p) {
+        res.phase[p] = static_cast<double>(p - spu / 2) / spu;
+        for (int j = 0; j <= 2 * half_span; ++j) {
+            const double* row = &raw[static_cast<size_t>(p + j) * (vb + 1)];
+            double w = jitter[j];
+            if (w == 0.0) continue;
+            for (int v = 0; v < vb; ++v) res.ber[static_cast<size_t>(p) * vb + v] += w * row[v];
+            res.ber_zero[p] += w * row[vb];
+        }
+    }
+
+    // Contour at target BER and eye opening
+    const double target = params.target_ber;
+    res.contour_upper.assign(spu, 0.0);
+    res.contour_lower.assign(spu, 0.0);
+    res.eye_height = 0.0;
+    int best = 0;
+    for (int p = 0; p < spu; ++p) {
+        if (res.ber_zero[p] < res.ber_zero[best]) best = p;
+        if (res.ber_zero[p] >= target) continue;
+        int up = vb / 2 + 1;
+        while (up < vb - 1 && res.ber_at(p, up) < target) ++up;
+        int dn = vb / 2 - 1;
+        while (dn > 0 && res.ber_at(p, dn) < target) --dn;
+        res.contour_upper[p] = res.voltage[up];
+        res.contour_lower[p] = res.voltage[dn];
+    }
+    for (int p = 0; p < spu; ++p) {
+        double h = res.contour_upper[p] - res.contour_lower[p];
+        if (h > res.eye_height) {
+            res.eye_height = h;
+            best = p;
+        }
+    }
+    res.best_phase = res.phase[best];
+    int width = 0;
+    if (res.ber_zero[best] < target) {
+        int lo = best, hi = best;
+        while (lo > 0 && res.ber_zero[lo - 1] < target) --lo;
+        while (hi < spu - 1 && res.ber_zero[hi + 1] < target) ++hi;
+        width = hi - lo + 1;
+    }
+    res.eye_width = static_cast<double>(width) / spu;
+    return res;
+}
+
+StatEyeResult link_stat_eye(const StatEyeParams& params, const TxParams& tx,
+                            const ChannelParams& channel, const RxParams& rx,
+                            double timestep, int samples_per_ui) {
+    if (params.pulse_ui < 2) {
+        throw std::invalid_argument("StatEye: pulse_ui must be >= 2");
+    }
+    std::vector<double> pulse = link_pulse_response(tx, channel, rx, timestep,
+                                                    samples_per_ui, params.pulse_ui);
+    return compute_stat_eye(apply_ffe_to_pulse(pulse, tx.ffe), samples_per_ui, params);
+}
+
+} // namespace serdes
@@ -0,0 +1,270 @@
+#include "ams/state_space_kernel.h"
+#include "common/prbs.h"
+#include <cmath>
+#include <algorithm>
+
+namespace serdes {
+
+// Solve M * X = R in place (M: n x n, R: n x m, row-major), partial pivoting
+static bool solve_in_place(std::vector<double>& M, std::vector<double>& R, int n, int m) {
+    for (int k = 0; k < n; ++k) {
+        int piv = k;
+        double max_val = std::abs(M[k * n + k]);
+        for (int i = k + 1; i < n; ++i) {
+            if (std::abs(M[i * n + k]) > max_val) {
+                max_val = std::abs(M[i * n + k]);
+                piv = i;
+            }
+        }
+        if (max_val < 1e-300) {
+            return false;
+        }
+        if (piv != k) {
+            for (int j = 0; j < n; ++j) std::swap(M[k * n + j], M[piv * n + j]);
+            for (int j = 0; j < m; ++j) std::swap(R[k * m + j], R[piv * m + j]);
+        }
+        for (int i = k + 1; i < n; ++i) {
+            double f = M[i * n + k] / M[k * n + k];
+            if (f == 0.0) continue;
+            for (int j = k; j < n; ++j) M[i * n + j] -= f * M[k * n + j];
+            for (int j = 0; j < m; ++j) R[i * m + j] -= f * R[k * m + j];
+        }
+    }
+    for (int k = n - 1; k >= 0; --k) {
+        for (int j = 0; j < m; ++j) {
+            double s = R[k * m + j];
+            for (int i = k + 1; i < n; ++i) s -= M[k * n + i] * R[i * m + j];
+            R[k * m + j] = s / M[k * n + k];
+        }
+    }
+    return true;
+}
+
+bool discretize_trapezoidal(const std::vector<double>& A,
+                            const std::vector<double>& B,
+                            const std::vector<double>& C,
+                            const std::vector<double>& D,
+                            int n_states, int n_inputs, int n_outputs,
+                            double h,
+                            DiscreteStateSpace& out) {
+    const int n = n_states;
+    const int m = n_inputs;
+
+    // M = I - A*h/2, R = [I + A*h/2 | B*h/2]
+    std::vector<double> M(static_cast<size_t>(n) * n);
+    std::vector<double> R(static_cast<size_t>(n) * (n + m));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double a = A[i * n + j] * h * 0.5;
+            double eye = (i == j) ? 1.0 : 0.0;
+            M[i * n + j] = eye - a;
+            R[i * (n + m) + j] = eye + a;
+        }
+        for (int j = 0; j < m; ++j) {
+            R[i * (n + m) + n + j] = B[i * m + j] * h * 0.5;
+        }
+    }
+    if (!solve_in_place(M, R, n, n + m)) {
+        return false;
+    }
+
+    out.n_states = n;
+    out.n_inputs = m;
+    out.n_outputs = n_outputs;
+    out.Ad.resize(static_cast<size_t>(n) * n);
+    out.Bt.resize(static_cast<size_t>(n) * m);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) out.Ad[i * n + j] = R[i * (n + m) + j];
+        for (int j = 0; j < m; ++j) out.Bt[i * m + j] = R[i * (n + m) + n + j];
+    }
+    out.C = C;
+    out.D = D;
+    out.Eh.clear();
+    return true;
+}
+
+bool discretize_trapezoidal(const std::vector<double>& A,
+                            const std::vector<double>& B,
+                            const std::vector<double>& C,
+                            const std::vector<double>& D,
+                            const std::vector<double>& E,
+                            int n_states, int n_inputs, int n_outputs,
+                            double h,
+                            DiscreteStateSpace& out) {
+    if (!discretize_trapezoidal(A, B, C, D, n_states, n_inputs, n_outputs, h, out)) {
+        return false;
+    }
+    bool any = false;
+    for (double e : E) {
+        any = any || e != 0.0;
+    }
+    if (any) {
+        out.Eh.resize(E.size());
+        for (size_t k = 0; k < E.size(); ++k) {
+            out.Eh[k] = E[k] / h;
+        }
+    }
+    return true;
+}
+
+// Reflect rows/columns lo..n-1 with P = I - 2 v v' / (v' v), v[0] at index lo
+static void householder_similarity(std::vector<double>& H, std::vector<double>& b,
+                                   std::vector<double>& c, const std::vector<double>& v,
+                                   int n, int lo) {
+    double vv = 0.0;
+    for (double x : v) vv += x * x;
+    if (vv == 0.0) {
+        return;
+    }
+    const int len = n - lo;
+    for (int j = 0; j < n; ++j) {
+        double s = 0.0;
+        for (int m = 0; m < len; ++m) s += v[m] * H[(lo + m) * n + j];
+        s *= 2.0 / vv;
+        for (int m = 0; m < len; ++m) H[(lo + m) * n + j] -= s * v[m];
+    }
+    for (int i = 0; i < n; ++i) {
+        double s = 0.0;
+        for (int m = 0; m < len; ++m) s += H[i * n + lo + m] * v[m];
+        s *= 2.0 / vv;
+        for (int m = 0; m < len; ++m) H[i * n + lo + m] -= s * v[m];
+    }
+    for (std::vector<double>* x : {&b, &c}) {
+        double s = 0.0;
+        for (int m = 0; m < len; ++m) s += v[m] * (*x)[lo + m];
+        s *= 2.0 / vv;
+        for (int m = 0; m < len; ++m) (*x)[lo + m] -= s * v[m];
+    }
+}
+
+std::vector<std::complex<double>> state_space_frequency_response(
+    const std::vector<double>& A, const std::vector<double>& B,
+    const std::vector<double>& C, const std::vector<double>& D,
+    int n_states, int n_inputs, int n_outputs,
+    int input, int output, const std::vector<double>& freqs) {
+    typedef std::complex<double> Complex;
+    const int n = n_states;
+    if (n < 0 || input < 0 || input >= n_inputs || output < 0 || output >= n_outputs ||
+        A.size() != static_cast<size_t>(n) * n ||
+        B.size() != static_cast<size_t>(n) * n_inputs ||
+        C.size() != static_cast<size_t>(n_outputs) * n ||
+        D.size() != static_cast<size_t>(n_outputs) * n_inputs) {
+        throw std::invalid_argument("state_space_frequency_response: inconsistent sizes");
+    }
+
+    // H = Q' A Q upper Hessenberg; b = Q' B(:, input), c = Q' C(output, :)'
+    std::vector<double> H = A;
+    std::vector<double> b(n), c(n);
+    for (int i = 0; i < n; ++i) {
+        b[i] = B[i * n_inputs + input];
+        c[i] = C[output * n + i];
+    }
+    for (int k = 0; k + 2 < n; ++k) {
+        std::vector<double> v(n - k - 1);
+        double norm = 0.0;
+        for (int i = k + 1; i < n; ++i) {
+            v[i - k - 1] = H[i * n + k];
+            norm += v[i - k - 1] * v[i - k - 1];
+        }
+        norm = std::sqrt(norm);
+        if (norm == 0.0) {
+            continue;
+        }
+        v[0] += v[0] >= 0.0 ? norm : -norm;
+        householder_similarity(H, b, c, v, n, k + 1);
+    }
+
+    const double d = D[output * n_inputs + input];
+    std::vector<Complex> result(freqs.size());
+    std::vector<Complex> M(static_cast<size_t>(n) * n);
+    std::vector<Complex> x(n);
+    for (size_t f = 0; f < freqs.size(); ++f) {
+        Complex s(0.0, 2.0 * M_PI * freqs[f]);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) M[i * n + j] = -H[i * n + j];
+            M[i * n + i] += s;
+            x[i] = b[i];
+        }
+        // Hessenberg elimination: only the subdiagonal entry below each pivot
+        for (int k = 0; k + 1 < n; ++k) {
+            if (std::abs(M[(k + 1) * n + k]) > std::abs(M[k * n + k])) {
+                for (int j = k; j < n; ++j) std::swap(M[k * n + j], M[(k + 1) * n + j]);
+                std::swap(x[k], x[k + 1]);
+            }
+            if (M[(k + 1) * n + k] == 0.0) {
+                continue;
+            }
+            Complex l = M[(k + 1) * n + k] / M[k * n + k];
+            for (int j = k + 1; j < n; ++j) M[(k + 1) * n + j] -= l * M[k * n + j];
+            x[k + 1] -= l * x[k];
+        }
+        Complex y = d;
+        for (int k = n - 1; k >= 0; --k) {
+            Complex acc = x[k];
+            for (int j = k + 1; j < n; ++j) acc -= M[k * n + j] * x[j];
+            x[k] = acc / M[k * n + k];
+            y += c[k] * x[k];
+        }
+        result[f] = y;
+    }
+    return result;
+}
+
+void PrecisionReport::add(const double* y_policy, const double* y_ref, int n_outputs) {
+    for (int i = 0; i < n_outputs; ++i) {
+        double e = std::abs(y_policy[i] - y_ref[i]);
+        max_abs_error = std::max(max_abs_error, e);
+        peak_output = std::max(peak_output, std::abs(y_ref[i]));
+        sq_sum += e * e;
+    }
+    ++n_samples;
+}
+
+void PrecisionReport::finish(int n_outputs) {
+    int n_total = n_samples * std::max(1, n_outputs);
+    rms_error = (n_total > 0) ? std::sqrt(sq_sum / n_total) : 0.0;
+    rel_error = (peak_output > 0.0) ? max_abs_error / peak_output : 0.0;
+}
+
+template <typename StateT, typename AccT>
+static PrecisionReport run_against_double(const DiscreteStateSpace& dss,
+                                          int n_samples, int samples_per_ui) {
+    StateSpaceStepper<double, double> ref;
+    StateSpaceStepper<StateT, AccT> dut;
+    ref.configure(dss);
+    dut.configure(dss);
+
+    PrbsLfsr lfsr(PRBSType::PRBS7, 1);
+    std::vector<double> u(dss.n_inputs, 0.0);
+    std::vector<double> y_ref(dss.n_outputs), y_dut(dss.n_outputs);
+    int spu = std::max(1, samples_per_ui);
+
+    PrecisionReport rep;
+    for (int n = 0; n < n_samples; ++n) {
+        if (n % spu == 0 && dss.n_inputs > 0) {
+            u[0] = lfsr.next_bit() ? 1.0 : -1.0;
+        }
+        ref.step(u.data(), y_ref.data());
+        dut.step(u.data(), y_dut.data());
+        rep.add(y_dut.data(), y_ref.data(), dss.n_outputs);
+    }
+    rep.finish(dss.n_outputs);
+    return rep;
+}
+
+PrecisionReport check_precision(const DiscreteStateSpace& dss,
+                                ChannelPrecision policy,
+                                int n_samples,
+                                int samples_per_ui) {
+    switch (policy) {
+        case ChannelPrecision::FLOAT:
+            return run_against_double<float, float>(dss, n_samples, samples_per_ui);
+        case ChannelPrecision::MIXED:
+            return run_against_double<float, double>(dss, n_samples, samples_per_ui);
+        case ChannelPrecision::DOUBLE:
+        default:
+            return run_against_double<double, double>(dss, n_samples, samples_per_ui);
+    }
+}
+
+} // namespace serdes
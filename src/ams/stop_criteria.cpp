@@ -0,0 +1,105 @@
+#include "ams/stop_criteria.h"
+#include "ams/prbs_sync_checker.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace serdes {
+
+const char* stop_reason_name(StopReason reason) {
+    switch (reason) {
+        case StopReason::BER_PASS: return "ber_pass";
+        case StopReason::BER_FAIL: return "ber_fail";
+        case StopReason::SYNC_LOSS: return "sync_loss";
+        case StopReason::SETTLED:  return "settled";
+        default:                   return "duration";
+    }
+}
+
+StopCriteria::StopCriteria() {
+    configure(StopCriteriaParams());
+}
+
+void StopCriteria::configure(const StopCriteriaParams& params) {
+    if (!(params.check_interval > 0.0)) {
+        throw std::invalid_argument("Stop criteria: check_interval must be positive");
+    }
+    if ((params.stop_on_pass || params.stop_on_fail) && !(params.target_ber > 0.0 && params.target_ber < 1.0)) {
+        throw std::invalid_argument("Stop criteria: target_ber must be in (0, 1)");
+    }
+    if (!(params.confidence > 0.0 && params.confidence < 1.0)) {
+        throw std::invalid_argument("Stop criteria: confidence must be in (0, 1)");
+    }
+    if (params.settle_checks < 0 || params.tap_tolerance < 0.0 || params.phase_tolerance < 0.0) {
+        throw std::invalid_argument("Stop criteria: settle_checks and tolerances must be >= 0");
+    }
+    m_params = params;
+    reset();
+}
+
+void StopCriteria::reset() {
+    m_reason = StopReason::NONE;
+    m_stable_checks = 0;
+    m_have_prev = false;
+    m_prev_taps.clear();
+    m_prev_phase = 0.0;
+}
+
+bool StopCriteria::is_stable(const LinkMetrics& m) const {
+    if (!m_have_prev || m.taps.size() != m_prev_taps.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < m.taps.size(); ++i) {
+        if (std::fabs(m.taps[i] - m_prev_taps[i]) > m_params.tap_tolerance) {
+            return false;
+        }
+    }
+    return std::fabs(m.cdr_phase - m_prev_phase) <= m_params.phase_tolerance;
+}
+
+StopReason StopCriteria::evaluate(const LinkMetrics& m) {
+    if (m_reason != StopReason::NONE) {
+        return m_reason;
+    }
+
+    // Stability is tracked during min_time too, so the count is ready at once
+    m_stable_checks = is_stable(m) ? m_stable_checks + 1 : 0;
+    m_prev_taps = m.taps;
+    m_prev_phase = m.cdr_phase;
+    m_have_prev = true;
+
+    if (m.time < m_params.min_time) {
+        return StopReason::NONE;
+    }
+    if (m_params.stop_on_fail && m.sync_losses > 0) {
+        m_reason = StopReason::SYNC_LOSS;
+    } else if (m.locked && m.bits > 0) {
+        if (m_params.stop_on_fail &&
+            ber_lower_bound(m.errors, m.bits, m_params.confidence) > m_params.target_ber) {
+            m_reason = StopReason::BER_FAIL;
+        } else if (m_params.stop_on_pass && m.sync_losses == 0 &&
+                   ber_upper_bound(m.errors, m.bits, m_params.confidence) < m_params.target_ber) {
+            m_reason = StopReason::BER_PASS;
+        }
+    }
+    if (m_reason == StopReason::NONE && m_params.settle_checks > 0 &&
+        m_stable_checks >= m_params.settle_checks) {
+        m_reason = StopReason::SETTLED;
+    }
+    return m_reason;
+}
+
+bool trial_passed(const LinkMetrics& m, StopReason reason, double target_ber) {
+    if (!m.locked || m.sync_losses > 0) {
+        return false;
+    }
+    if (reason == StopReason::BER_PASS) {
+        return true;
+    }
+    if (reason != StopReason::NONE && reason != StopReason::SETTLED) {
+        return false;
+    }
+    double ber = m.bits > 0 ? static_cast<double>(m.errors) / static_cast<double>(m.bits) : 0.0;
+    return ber <= target_ber;
+}
+
+} // namespace serdes
@@ -47,6 +47,8 @@ void TxDriverTdf::initialize() {
     m_prev_vout_p = m_params.vcm_out;
     m_prev_vout_n = m_params.vcm_out;
     m_prev_vin_diff = 0.0;
+    m_state_bw.resize(0);
+    m_state_psrr.resize(0);
     
     // Build bandwidth limiting transfer function if poles are defined
     // H(s) = dc_gain / prod(1 + s/wp_j)
@@ -71,6 +73,33 @@ void TxDriverTdf::initialize() {
                                m_params.psrr.gain, m_num_psrr, m_den_psrr);
         m_psrr_enabled = true;
     }
+    
+    if (!m_restore.empty()) {
+        const std::string key = std::string(name()) + ".";
+        m_restore.get_sca_vector(key + "bw_state", m_state_bw);
+        m_restore.get_sca_vector(key + "psrr_state", m_state_psrr);
+        m_prev_vout_p = m_restore.get_real(key + "prev_vout_p");
+        m_prev_vout_n = m_restore.get_real(key + "prev_vout_n");
+        m_prev_vin_diff = m_restore.get_real(key + "prev_vin_diff");
+        m_restore.clear();
+    }
+}
+
+// ============================================================================
+// Checkpoint
+// ============================================================================
+
+void TxDriverTdf::save_state(StateCheckpoint& cp) const {
+    const std::string key = std::string(name()) + ".";
+    cp.put_sca_vector(key + "bw_state", m_state_bw);
+    cp.put_sca_vector(key + "psrr_state", m_state_psrr);
+    cp.put_real(key + "prev_vout_p", m_prev_vout_p);
+    cp.put_real(key + "prev_vout_n", m_prev_vout_n);
+    cp.put_real(key + "prev_vin_diff", m_prev_vin_diff);
+}
+
+void TxDriverTdf::restore_state(const StateCheckpoint& cp) {
+    m_restore = cp.subset(std::string(name()) + ".");
 }
 
 void TxDriverTdf::processing() {
@@ -94,7 +123,7 @@ void TxDriverTdf::processing() {
     if (m_bw_filter_enabled) {
         // Apply Laplace transfer function using sca_ltf_nd
         // H(s) = dc_gain / prod(1 + s/wp_j)
-        vout_diff = m_bw_filter(m_num_bw, m_den_bw, vin_diff);
+        vout_diff = m_bw_filter(m_num_bw, m_den_bw, m_state_bw, vin_diff);
     } else {
         // Fallback to simple DC gain
         vout_diff = m_params.dc_gain * vin_diff;
@@ -117,7 +146,7 @@ void TxDriverTdf::processing() {
     // ========================================================================
     if (m_psrr_enabled) {
         double vdd_ripple = v_vdd - m_params.psrr.vdd_nom;
-        double vpsrr = m_psrr_filter(m_num_psrr, m_den_psrr, vdd_ripple);
+        double vpsrr = m_psrr_filter(m_num_psrr, m_den_psrr, m_state_psrr, vdd_ripple);
         vout_diff += vpsrr;
     }
     
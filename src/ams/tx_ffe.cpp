@@ -1,5 +1,6 @@
 #include "ams/tx_ffe.h"
 #include <cmath>
+#include <stdexcept>
 
 namespace serdes {
 
@@ -10,12 +11,16 @@ TxFfeTdf::TxFfeTdf(sc_core::sc_module_name nm, const TxFfeParams& params)
     , m_params(params)
     , m_buffer_ptr(0)
 {
-    // 初始化循环缓冲区
+    if (params.tap_spacing < 1) {
+        throw std::invalid_argument("TX FFE: tap_spacing must be >= 1");
+    }
+    
+    // 初始化循环缓冲区：跨度 (num_taps - 1) * tap_spacing + 1 个样本
     size_t num_taps = params.taps.size();
     if (num_taps == 0) {
         num_taps = 1;  // 至少需要1个抽头
     }
-    m_buffer.resize(num_taps, 0.0);
+    m_buffer.resize((num_taps - 1) * params.tap_spacing + 1, 0.0);
 }
 
 void TxFfeTdf::set_attributes() {
@@ -34,19 +39,38 @@ void TxFfeTdf::processing() {
     // 计算FIR卷积输出
     double y = 0.0;
     size_t num_taps = m_params.taps.size();
+    size_t len = m_buffer.size();
+    size_t spacing = static_cast<size_t>(m_params.tap_spacing);
     
     for (size_t i = 0; i < num_taps; ++i) {
-        // 计算循环索引
-        size_t idx = (m_buffer_ptr + num_taps - i) % num_taps;
+        // 计算循环索引：第 i 个抽头延迟 i * tap_spacing 个样本
+        size_t idx = (m_buffer_ptr + len - i * spacing) % len;
         // 累加卷积结果
         y += m_params.taps[i] * m_buffer[idx];
     }
     
     // 更新缓冲区指针
-    m_buffer_ptr = (m_buffer_ptr + 1) % num_taps;
+    m_buffer_ptr = (m_buffer_ptr + 1) % len;
     
     // 输出
     out.write(y);
 }
 
+void TxFfeTdf::save_state(StateCheckpoint& cp) const {
+    const std::string key = std::string(name()) + ".";
+    cp.put_real(key + "buffer", m_buffer);
+    cp.put_uint(key + "buffer_ptr", m_buffer_ptr);
+}
+
+void TxFfeTdf::restore_state(const StateCheckpoint& cp) {
+    const std::string key = std::string(name()) + ".";
+    const std::vector<double>& buffer = cp.get_real_vector(key + "buffer");
+    size_t ptr = static_cast<size_t>(cp.get_uint(key + "buffer_ptr"));
+    if (buffer.size() != m_buffer.size() || ptr >= m_buffer.size()) {
+        throw std::invalid_argument("TX FFE: checkpoint buffer length mismatch");
+    }
+    m_buffer = buffer;
+    m_buffer_ptr = ptr;
+}
+
 } // namespace serdes
@@ -72,4 +72,14 @@ TxTopModule::~TxTopModule()
     delete m_driver;
 }
 
+void TxTopModule::save_state(StateCheckpoint& cp) const {
+    m_ffe->save_state(cp);
+    m_driver->save_state(cp);
+}
+
+void TxTopModule::restore_state(const StateCheckpoint& cp) {
+    m_ffe->restore_state(cp);
+    m_driver->restore_state(cp);
+}
+
 } // namespace serdes
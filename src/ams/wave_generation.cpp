@@ -1,28 +1,12 @@
 #include "ams/wave_generation.h"
+#include "common/prbs.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <iostream>
 
 namespace serdes {
 
-// PRBS polynomial configuration table
-struct PRBSConfig {
-    int length;              // LFSR length
-    unsigned int mask;       // Mask for state bits
-    int tap1;                // First tap position
-    int tap2;                // Second tap position
-    unsigned int default_init;  // Default initial state
-};
-
-// Standard PRBS configurations per ITU-T O.150
-static const PRBSConfig PRBS_CONFIGS[] = {
-    {7,  0x7F,       6,  5, 0x7F},       // PRBS7:  x^7 + x^6 + 1
-    {9,  0x1FF,      8,  4, 0x1FF},      // PRBS9:  x^9 + x^5 + 1
-    {15, 0x7FFF,     14, 13, 0x7FFF},    // PRBS15: x^15 + x^14 + 1
-    {23, 0x7FFFFF,   22, 17, 0x7FFFFF},  // PRBS23: x^23 + x^18 + 1
-    {31, 0x7FFFFFFF, 30, 27, 0x7FFFFFFF} // PRBS31: x^31 + x^28 + 1
-};
-
 WaveGenerationTdf::WaveGenerationTdf(sc_core::sc_module_name nm, 
                                      const WaveGenParams& params,
                                      double sample_rate,
@@ -39,7 +23,11 @@ WaveGenerationTdf::WaveGenerationTdf(sc_core::sc_module_name nm,
     , m_current_bit_value(0.0)
     , m_time(0.0)
     , m_seed(seed)
-    , m_rng(seed)
+    , m_noise(seed, name())
+    , m_jitter(params.jitter.RJ_sigma > 0.0 || !params.jitter.SJ_freq.empty())
+    , m_sample_index(0)
+    , m_symbol(0)
+    , m_next_edge(0.0)
 {
     // Parameter validation
     if (sample_rate <= 0.0) {
@@ -51,6 +39,17 @@ WaveGenerationTdf::WaveGenerationTdf(sc_core::sc_module_name nm,
     if (params.single_pulse < 0.0) {
         throw std::invalid_argument("Single pulse width cannot be negative");
     }
+    if (params.jitter.RJ_sigma < 0.0) {
+        throw std::invalid_argument("RJ sigma cannot be negative");
+    }
+    if (params.jitter.SJ_freq.size() != params.jitter.SJ_pp.size()) {
+        throw std::invalid_argument("SJ_freq and SJ_pp must have the same length");
+    }
+    for (size_t i = 0; i < params.jitter.SJ_freq.size(); ++i) {
+        if (params.jitter.SJ_freq[i] <= 0.0 || params.jitter.SJ_pp[i] < 0.0) {
+            throw std::invalid_argument("SJ frequency must be positive and SJ_pp non-negative");
+        }
+    }
     
     // Calculate oversampling ratio
     double exact_samples = ui * sample_rate;
@@ -83,20 +82,14 @@ void WaveGenerationTdf::initialize() {
     // Reset time and counter
     m_time = 0.0;
     m_sample_counter = 0;
+    m_sample_index = 0;
+    m_symbol = 0;
+    m_next_edge = 0.0;
     
-    // Initialize LFSR state based on PRBS type
-    int prbs_index = static_cast<int>(m_params.type);
-    unsigned int default_state = 0;
-    unsigned int mask = 0;
-    
-    if (prbs_index >= 0 && prbs_index < 5) {
-        default_state = PRBS_CONFIGS[prbs_index].default_init;
-        mask = PRBS_CONFIGS[prbs_index].mask;
-    } else {
-        // Default to PRBS31
-        default_state = 0x7FFFFFFF;
-        mask = 0x7FFFFFFF;
-    }
+    // Initialize LFSR state based on PRBS type (unknown types use PRBS31)
+    const PRBSConfig& config = get_prbs_config(m_params.type);
+    unsigned int default_state = config.default_init;
+    unsigned int mask = config.mask;
     
     // Use seed to modify LFSR initial state
     m_lfsr_state = (default_state ^ (m_seed & mask)) & mask;
@@ -114,8 +107,8 @@ void WaveGenerationTdf::initialize() {
         m_current_bit_value = bit ? 1.0 : -1.0;
     }
     
-    // Re-seed RNG for jitter
-    m_rng.seed(m_seed);
+    // Restart jitter noise stream
+    m_noise.reseed(m_seed, name());
     
     // Warning for pulse width quantization
     if (m_params.single_pulse > 0.0) {
@@ -124,25 +117,87 @@ void WaveGenerationTdf::initialize() {
             std::cerr << "Warning: single_pulse is not an integer multiple of UI" << std::endl;
         }
     }
+    
+    if (!m_restore.empty()) {
+        const std::string key = std::string(name()) + ".";
+        m_lfsr_state = static_cast<unsigned int>(m_restore.get_uint(key + "lfsr"));
+        m_sample_counter = static_cast<int>(m_restore.get_int(key + "sample_counter"));
+        m_current_bit_value = m_restore.get_real(key + "bit_value");
+        m_time = m_restore.get_real(key + "time");
+        m_noise.restore_state(m_restore, key + "noise");
+        if (m_restore.has(key + "sample_index")) {
+            m_sample_index = m_restore.get_uint(key + "sample_index");
+            m_symbol = m_restore.get_uint(key + "symbol");
+            m_next_edge = m_restore.get_real(key + "next_edge");
+        }
+        m_restore.clear();
+    }
+}
+
+void WaveGenerationTdf::save_state(StateCheckpoint& cp) const {
+    const std::string key = std::string(name()) + ".";
+    cp.put_uint(key + "lfsr", m_lfsr_state);
+    cp.put_int(key + "sample_counter", m_sample_counter);
+    cp.put_real(key + "bit_value", m_current_bit_value);
+    cp.put_real(key + "time", m_time);
+    m_noise.save_state(cp, key + "noise");
+    cp.put_uint(key + "sample_index", m_sample_index);
+    cp.put_uint(key + "symbol", m_symbol);
+    cp.put_real(key + "next_edge", m_next_edge);
+}
+
+void WaveGenerationTdf::restore_state(const StateCheckpoint& cp) {
+    m_restore = cp.subset(std::string(name()) + ".");
 }
 
 bool WaveGenerationTdf::generate_prbs_bit() {
-    int prbs_index = static_cast<int>(m_params.type);
-    unsigned int feedback = 0;
-    
-    if (prbs_index >= 0 && prbs_index < 5) {
-        const PRBSConfig& config = PRBS_CONFIGS[prbs_index];
-        feedback = ((m_lfsr_state >> config.tap1) ^ (m_lfsr_state >> config.tap2)) & 0x1;
-        m_lfsr_state = ((m_lfsr_state << 1) | feedback) & config.mask;
-    } else {
-        feedback = ((m_lfsr_state >> 30) ^ (m_lfsr_state >> 27)) & 0x1;
-        m_lfsr_state = ((m_lfsr_state << 1) | feedback) & 0x7FFFFFFF;
-    }
+    const PRBSConfig& config = get_prbs_config(m_params.type);
+    unsigned int feedback = ((m_lfsr_state >> config.tap1) ^ (m_lfsr_state >> config.tap2)) & 0x1;
+    m_lfsr_state = ((m_lfsr_state << 1) | feedback) & config.mask;
     
     return (m_lfsr_state & 0x1) != 0;
 }
 
+double WaveGenerationTdf::next_symbol_value(std::uint64_t k) {
+    if (m_params.single_pulse > 0.0) {
+        return static_cast<double>(k) * m_ui < m_params.single_pulse ? 1.0 : -1.0;
+    }
+    return generate_prbs_bit() ? 1.0 : -1.0;
+}
+
+double WaveGenerationTdf::edge_position(std::uint64_t k) {
+    double t = static_cast<double>(k) * m_ui;
+    double delta = 0.0;
+    for (size_t i = 0; i < m_params.jitter.SJ_freq.size(); ++i) {
+        delta += 0.5 * m_params.jitter.SJ_pp[i] * std::sin(2.0 * M_PI * m_params.jitter.SJ_freq[i] * t);
+    }
+    if (m_params.jitter.RJ_sigma > 0.0) {
+        delta += m_params.jitter.RJ_sigma * m_noise.next_normal();
+    }
+    return static_cast<double>(k) * m_samples_per_ui + delta * m_sample_rate;
+}
+
 void WaveGenerationTdf::processing() {
+    if (m_jitter) {
+        // Symbol 0 is in force from the start; later edges are jittered
+        if (m_sample_index == 0) {
+            m_symbol = 0;
+            m_current_bit_value = next_symbol_value(0);
+            m_next_edge = edge_position(1);
+        }
+        double n = static_cast<double>(m_sample_index);
+        while (n >= m_next_edge) {
+            ++m_symbol;
+            m_current_bit_value = next_symbol_value(m_symbol);
+            // Edges never move backwards past the previous one
+            m_next_edge = std::max(edge_position(m_symbol + 1), m_next_edge);
+        }
+        out.write(m_current_bit_value);
+        ++m_sample_index;
+        m_time += 1.0 / m_sample_rate;
+        return;
+    }
+    
     // Only generate new bit at UI boundary (every samples_per_ui samples)
     if (m_sample_counter == 0) {
         // Mode selection: Single-bit pulse vs PRBS
@@ -158,12 +213,17 @@ void WaveGenerationTdf::processing() {
             bool bit = generate_prbs_bit();
             m_current_bit_value = bit ? 1.0 : -1.0;
         }
+        // Keep the jittered-path position current, so a checkpoint taken
+        // here can be continued with jitter enabled
+        m_symbol = m_sample_index / m_samples_per_ui;
+        m_next_edge = static_cast<double>(m_symbol + 1) * m_samples_per_ui;
     }
     
     // Write output (held constant during UI for oversampling)
     out.write(m_current_bit_value);
     
     // Update counter and time
+    ++m_sample_index;
     m_sample_counter++;
     if (m_sample_counter >= m_samples_per_ui) {
         m_sample_counter = 0;
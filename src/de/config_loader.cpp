@@ -93,6 +93,9 @@ SystemParams ConfigLoader::load_default() {
     params.clock.type = ClockType::IDEAL;
     params.clock.frequency = 40e9;  // 40 GHz
     
+    // Noise streams without their own noise_seed derive from global.seed
+    params.apply_global_seed();
+    
     return params;
 }
 
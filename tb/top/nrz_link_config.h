@@ -86,8 +86,10 @@ struct NrzLinkConfig {
     // 仿真控制
     // ========================================================================
     double sim_duration;           ///< 仿真时长 (s)
-    unsigned int seed;             ///< 随机种子
+    unsigned int seed;             ///< 链路随机种子（PRBS 抖动及各模块噪声流）
     std::string output_prefix;     ///< 输出文件前缀
+    std::string load_state_file;   ///< 仿真前恢复的链路检查点（空 = 从零训练）
+    std::string save_state_file;   ///< 仿真后保存的链路检查点（空 = 不保存）
     
     int sim_ui_count() const { 
         return static_cast<int>(sim_duration / ui()); 
@@ -103,6 +105,22 @@ struct NrzLinkConfig {
     RxParams rx;
     AdaptionParams adaption;
     ClockParams clock;
+    EqSeedParams eq_seed;          ///< 仿真前 FFE/DFE 初值求解
+    PrbsCheckerParams checker;     ///< 接收数据 PRBS 误码检测
+    StopCriteriaParams stop;       ///< 提前结束仿真的判据
+    StatEyeParams stat_eye;        ///< 仿真前统计眼评估
+    bool run_stat_eye;             ///< 仿真前计算统计眼
+    ComParams com;                 ///< COM 计算与均衡器搜索
+    bool run_com;                  ///< 建模后计算信道 COM
+    EqOptParams eq_opt;            ///< 仿真前 FFE/CTLE/VGA/DFE 联合优化
+    std::string eq_load_file;      ///< 应用已保存的均衡器候选配置
+    BathtubParams bathtub;         ///< 采样器输入直方图与 BER 外推
+    JtolParams jtol;               ///< SJ 抖动容限扫描（协调进程）
+    JitterMonitorParams jitter_monitor;   ///< 仿真内边沿提取与抖动分解
+    std::string jitter_node;       ///< 抖动分解的数据节点："channel" 或 "dfe"
+    FlightRecorderParams flight_recorder; ///< 误码/冻结/抽头越界触发的环形缓冲抓取
+    bool jtol_trial;               ///< 作为 JTOL 试验子进程运行：退出码给出判决
+    bool record_waveforms;         ///< 记录各节点波形并保存 CSV
     
     // ========================================================================
     // 构造函数: 10Gbps NRZ 默认配置
@@ -113,6 +131,11 @@ struct NrzLinkConfig {
         , sim_duration(2e-6)       // 2µs = 20000 UI
         , seed(12345)
         , output_prefix("nrz_10g")
+        , run_stat_eye(false)
+        , run_com(false)
+        , jtol_trial(false)
+        , record_waveforms(true)
+        , jitter_node("channel")
     {
         init_10g_defaults();
         sync_ui();
@@ -141,6 +164,34 @@ struct NrzLinkConfig {
         
         // Clock 频率
         clock.frequency = data_rate;
+        
+        // PRBS 检测器按 UI 取样，图样与 WaveGen 一致
+        checker.ui = ui_val;
+        checker.type = wave.type;
+        
+        // 直方图每 UI 一组相位
+        bathtub.ui = ui_val;
+        
+        // 抖动分解的参考网格
+        jitter_monitor.ui = ui_val;
+        
+        // 飞行记录器窗口以 UI 计
+        flight_recorder.ui = ui_val;
+        
+        // 停止判据每 1000 UI 检查一次
+        stop.check_interval = 1000.0 * ui_val;
+    }
+    
+    /**
+     * @brief 链路种子派生所有噪声流
+     * 
+     * 未单独设置 noise_seed（0）的模块使用 seed，噪声流按模块路径区分；
+     * 单独设置的 noise_seed 覆盖链路种子。WaveGen 抖动直接以 seed 构造。
+     */
+    void sync_seed() {
+        rx.inherit_noise_seed(seed);
+        clock.inherit_noise_seed(seed);
+        adaption.seed = seed;
     }
     
     /**
@@ -16,6 +16,12 @@
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <sys/wait.h>
 
 #include "nrz_link_config.h"
 
@@ -23,6 +29,16 @@
 #include "ams/tx_top.h"
 #include "ams/channel_sparam.h"
 #include "ams/rx_top.h"
+#include "ams/eq_seed.h"
+#include "ams/stat_eye.h"
+#include "ams/com_analysis.h"
+#include "ams/eq_optimizer.h"
+#include "ams/prbs_checker.h"
+#include "ams/eye_histogram_tdf.h"
+#include "ams/jitter_monitor_tdf.h"
+#include "ams/flight_recorder_tdf.h"
+#include "ams/jtol.h"
+#include "ams/sim_stop_monitor.h"
 
 using namespace serdes;
 
@@ -45,7 +61,11 @@ public:
         in_n.set_rate(1);
     }
     
+    // 关闭后不再保存波形（JTOL 试验等只需判决结果的运行）
+    void set_enabled(bool enabled) { m_enabled = enabled; }
+    
     void processing() override {
+        if (!m_enabled) return;
         double time = get_time().to_seconds();
         double vp = in_p.read();
         double vn = in_n.read();
@@ -102,6 +122,7 @@ public:
     
 private:
     std::string m_name;
+    bool m_enabled = true;
     std::vector<double> m_time;
     std::vector<double> m_voltage_p;
     std::vector<double> m_voltage_n;
@@ -121,7 +142,10 @@ public:
 
     void set_attributes() override { in.set_rate(1); }
 
+    void set_enabled(bool enabled) { m_enabled = enabled; }
+
     void processing() override {
+        if (!m_enabled) return;
         m_time.push_back(get_time().to_seconds());
         m_data.push_back(in.read());
     }
@@ -140,6 +164,7 @@ public:
     }
 
 private:
+    bool m_enabled = true;
     std::vector<double> m_time;
     std::vector<double> m_data;
 };
@@ -151,42 +176,29 @@ private:
 
 class DeToTdfTapBridge : public sca_tdf::sca_module {
 public:
-    sca_tdf::sca_out<double> out1;
-    sca_tdf::sca_out<double> out2;
-    sca_tdf::sca_out<double> out3;
-    sca_tdf::sca_out<double> out4;
-    sca_tdf::sca_out<double> out5;
+    sc_core::sc_vector<sca_tdf::sca_out<double>> out;
 
     // DE inputs for reading DFE tap values (using sca_tdf::sca_de namespace)
-    sca_tdf::sca_de::sca_in<double> de_tap1;
-    sca_tdf::sca_de::sca_in<double> de_tap2;
-    sca_tdf::sca_de::sca_in<double> de_tap3;
-    sca_tdf::sca_de::sca_in<double> de_tap4;
-    sca_tdf::sca_de::sca_in<double> de_tap5;
+    sc_core::sc_vector<sca_tdf::sca_de::sca_in<double>> de_tap;
 
-    DeToTdfTapBridge(sc_core::sc_module_name nm)
+    DeToTdfTapBridge(sc_core::sc_module_name nm, size_t num_taps)
         : sca_tdf::sca_module(nm)
-        , out1("out1"), out2("out2"), out3("out3"), out4("out4"), out5("out5")
-        , de_tap1("de_tap1"), de_tap2("de_tap2"), de_tap3("de_tap3")
-        , de_tap4("de_tap4"), de_tap5("de_tap5") {}
+        , out("out", num_taps)
+        , de_tap("de_tap", num_taps) {}
 
     void set_attributes() override {
         // Set timestep to match other TDF modules (2 ps)
         this->set_timestep(2.0, sc_core::SC_PS);
-        out1.set_rate(1);
-        out2.set_rate(1);
-        out3.set_rate(1);
-        out4.set_rate(1);
-        out5.set_rate(1);
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i].set_rate(1);
+        }
     }
 
     void processing() override {
         // Read DE domain signals and write to TDF domain outputs
-        out1.write(de_tap1.read());
-        out2.write(de_tap2.read());
-        out3.write(de_tap3.read());
-        out4.write(de_tap4.read());
-        out5.write(de_tap5.read());
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i].write(de_tap[i].read());
+        }
     }
 };
 
@@ -196,35 +208,32 @@ public:
 
 class MultiChannelRecorder : public sca_tdf::sca_module {
 public:
-    sca_tdf::sca_in<double> in1;
-    sca_tdf::sca_in<double> in2;
-    sca_tdf::sca_in<double> in3;
-    sca_tdf::sca_in<double> in4;
-    sca_tdf::sca_in<double> in5;
+    // One input per channel name
+    sc_core::sc_vector<sca_tdf::sca_in<double>> in;
 
     MultiChannelRecorder(sc_core::sc_module_name nm, const std::string& name,
                          const std::vector<std::string>& channel_names)
         : sca_tdf::sca_module(nm)
-        , in1("in1"), in2("in2"), in3("in3"), in4("in4"), in5("in5")
+        , in("in", channel_names.size())
         , m_name(name)
         , m_channel_names(channel_names)
-        , m_num_channels(channel_names.size()) {}
+        , m_num_channels(channel_names.size())
+        , m_data(channel_names.size()) {}
 
     void set_attributes() override {
-        in1.set_rate(1);
-        in2.set_rate(1);
-        in3.set_rate(1);
-        in4.set_rate(1);
-        in5.set_rate(1);
+        for (size_t ch = 0; ch < in.size(); ++ch) {
+            in[ch].set_rate(1);
+        }
     }
 
+    void set_enabled(bool enabled) { m_enabled = enabled; }
+
     void processing() override {
+        if (!m_enabled) return;
         m_time.push_back(get_time().to_seconds());
-        m_data[0].push_back(in1.read());
-        if (m_num_channels > 1) m_data[1].push_back(in2.read());
-        if (m_num_channels > 2) m_data[2].push_back(in3.read());
-        if (m_num_channels > 3) m_data[3].push_back(in4.read());
-        if (m_num_channels > 4) m_data[4].push_back(in5.read());
+        for (size_t ch = 0; ch < m_num_channels; ++ch) {
+            m_data[ch].push_back(in[ch].read());
+        }
     }
 
     void save_csv(const std::string& filename) {
@@ -261,8 +270,9 @@ private:
     std::string m_name;
     std::vector<std::string> m_channel_names;
     size_t m_num_channels;
+    bool m_enabled = true;
     std::vector<double> m_time;
-    std::vector<std::vector<double>> m_data{5};  // Max 5 channels
+    std::vector<std::vector<double>> m_data;
 };
 
 // ============================================================================
@@ -272,15 +282,16 @@ private:
 SC_MODULE(NrzLinkTb) {
     // 子模块
     ConstVddSource* vdd_src;
-    ConstVddSource* dummy1_src;
-    ConstVddSource* dummy2_src;
-    ConstVddSource* dummy3_src;
-    ConstVddSource* dummy4_src;
     WaveGenerationTdf* wavegen;
     DeToTdfTapBridge* dfe_tap_bridge;
     TxTopModule* tx;
     ChannelSParamTdf* channel;
     RxTopModule* rx;
+    PrbsCheckerTdf* checker;
+    SimStopMonitor* stop_monitor;
+    EyeHistogramTdf* eye_hist;
+    JitterMonitorTdf* jitter_mon;
+    FlightRecorderTdf* flight;
     
     // 记录器
     EyeDataRecorder* rec_tx;
@@ -302,31 +313,35 @@ SC_MODULE(NrzLinkTb) {
     sca_tdf::sca_signal<double> sig_data_out;
 
     // DFE Tap signals (converted from DE to TDF for recording)
-    sca_tdf::sca_signal<double> sig_dfe_tap1;
-    sca_tdf::sca_signal<double> sig_dfe_tap2;
-    sca_tdf::sca_signal<double> sig_dfe_tap3;
-    sca_tdf::sca_signal<double> sig_dfe_tap4;
-    sca_tdf::sca_signal<double> sig_dfe_tap5;
+    sc_core::sc_vector<sca_tdf::sca_signal<double>> sig_dfe_tap;   // One per RX DFE tap
 
     // CDR Phase signal
     sca_tdf::sca_signal<double> sig_cdr_phase;
 
     // Dummy signals for unused recorder inputs
-    sca_tdf::sca_signal<double> sig_dummy1;
-    sca_tdf::sca_signal<double> sig_dummy2;
-    sca_tdf::sca_signal<double> sig_dummy3;
-    sca_tdf::sca_signal<double> sig_dummy4;
+
+    // PRBS checker results (DE)
+    sc_core::sc_signal<bool> sig_chk_locked;
+    sc_core::sc_signal<double> sig_chk_bits;
+    sc_core::sc_signal<double> sig_chk_errors;
+    sc_core::sc_signal<double> sig_chk_ber;
+    sc_core::sc_signal<double> sig_chk_ber_upper;
+    sc_core::sc_signal<int> sig_chk_bursts;
+    sc_core::sc_signal<int> sig_chk_max_burst;
+    sc_core::sc_signal<int> sig_chk_sync_losses;
     
     // 配置
     NrzLinkConfig m_config;
     
     SC_CTOR(NrzLinkTb)
         : vdd_src(nullptr)
-        , dummy1_src(nullptr), dummy2_src(nullptr), dummy3_src(nullptr), dummy4_src(nullptr)
         , wavegen(nullptr)
         , dfe_tap_bridge(nullptr)
         , tx(nullptr)
-        , channel(nullptr), rx(nullptr)
+        , channel(nullptr), rx(nullptr), checker(nullptr), stop_monitor(nullptr)
+        , eye_hist(nullptr)
+        , jitter_mon(nullptr)
+        , flight(nullptr)
         , rec_tx(nullptr), rec_channel(nullptr), rec_dfe(nullptr)
         , rec_ctle(nullptr), rec_vga(nullptr), rec_data(nullptr)
         , rec_dfe_taps(nullptr), rec_cdr_phase(nullptr)
@@ -337,21 +352,28 @@ SC_MODULE(NrzLinkTb) {
         , sig_channel_out_p("sig_channel_out_p")
         , sig_channel_out_n("sig_channel_out_n")
         , sig_data_out("sig_data_out")
-        , sig_dfe_tap1("sig_dfe_tap1"), sig_dfe_tap2("sig_dfe_tap2")
-        , sig_dfe_tap3("sig_dfe_tap3"), sig_dfe_tap4("sig_dfe_tap4")
-        , sig_dfe_tap5("sig_dfe_tap5")
+        , sig_dfe_tap("sig_dfe_tap")
         , sig_cdr_phase("sig_cdr_phase")
-        , sig_dummy1("sig_dummy1"), sig_dummy2("sig_dummy2")
-        , sig_dummy3("sig_dummy3"), sig_dummy4("sig_dummy4")
+        , sig_chk_locked("sig_chk_locked"), sig_chk_bits("sig_chk_bits")
+        , sig_chk_errors("sig_chk_errors"), sig_chk_ber("sig_chk_ber")
+        , sig_chk_ber_upper("sig_chk_ber_upper"), sig_chk_bursts("sig_chk_bursts")
+        , sig_chk_max_burst("sig_chk_max_burst"), sig_chk_sync_losses("sig_chk_sync_losses")
     {}
     
     void configure(const NrzLinkConfig& config) {
         m_config = config;
         m_config.sync_ui();  // 确保 UI 同步
+        m_config.sync_seed();  // 噪声流由链路种子派生
     }
     
     void build() {
         std::cout << "\n=== Building NRZ Link Testbench ===" << std::endl;
+        if (m_config.eq_seed.enabled) {
+            seed_equalizers();
+        }
+        if (m_config.run_stat_eye) {
+            evaluate_stat_eye();
+        }
         m_config.print_summary();
         
         double ui = m_config.ui();
@@ -361,20 +383,6 @@ SC_MODULE(NrzLinkTb) {
         
         std::cout << "[Build] Creating VDD source..." << std::endl;
         vdd_src = new ConstVddSource("vdd_src", 1.0, m_config.timestep_ps());
-
-        std::cout << "[Build] Creating DE-to-TDF bridge for DFE taps..." << std::endl;
-        dfe_tap_bridge = new DeToTdfTapBridge("dfe_tap_bridge");
-
-        dummy1_src = new ConstVddSource("dummy1_src", 0.0, m_config.timestep_ps());
-        dummy2_src = new ConstVddSource("dummy2_src", 0.0, m_config.timestep_ps());
-        dummy3_src = new ConstVddSource("dummy3_src", 0.0, m_config.timestep_ps());
-        dummy4_src = new ConstVddSource("dummy4_src", 0.0, m_config.timestep_ps());
-        
-        // Bind dummy sources to signals
-        dummy1_src->out(sig_dummy1);
-        dummy2_src->out(sig_dummy2);
-        dummy3_src->out(sig_dummy3);
-        dummy4_src->out(sig_dummy4);
         
         std::cout << "[Build] Creating WaveGen (PRBS)..." << std::endl;
         wavegen = new WaveGenerationTdf("wavegen", 
@@ -383,17 +391,73 @@ SC_MODULE(NrzLinkTb) {
                                         ui, 
                                         m_config.seed);
         
-        std::cout << "[Build] Creating TX (FFE + Driver)..." << std::endl;
-        tx = new TxTopModule("tx", m_config.tx);
-        
+        // 信道先于 TX/RX 创建：均衡器优化需要其频率响应
         std::cout << "[Build] Creating Channel (Differential MIMO)..." << std::endl;
         channel = new ChannelSParamTdf("channel", 
                                        m_config.channel,
                                        m_config.channel_ext);
         
+        if (!m_config.eq_load_file.empty()) {
+            load_equalizers();
+        } else if (m_config.eq_opt.enabled) {
+            optimize_equalizers();
+        }
+        
+        std::cout << "[Build] Creating TX (FFE + Driver)..." << std::endl;
+        tx = new TxTopModule("tx", m_config.tx);
+        
         std::cout << "[Build] Creating RX (CTLE + VGA + DFE + CDR)..." << std::endl;
         rx = new RxTopModule("rx", m_config.rx, m_config.adaption);
         
+        // 抽头数由 RX（adaption.dfe.num_taps）决定，桥接/记录/飞行记录器按此分配
+        const int num_taps = rx->get_num_dfe_tap_signals();
+        std::cout << "[Build] Creating DE-to-TDF bridge for " << num_taps << " DFE taps..." << std::endl;
+        dfe_tap_bridge = new DeToTdfTapBridge("dfe_tap_bridge", num_taps);
+        sig_dfe_tap.init(num_taps);
+        
+        std::cout << "[Build] Creating PRBS checker..." << std::endl;
+        // 按 CDR 采样触发取比特（判决延迟后），与恢复时钟对齐
+        PrbsCheckerParams checker_params = m_config.checker;
+        checker_params.use_trigger = true;
+        checker_params.decision_latency = rx->get_decision_latency();
+        checker = new PrbsCheckerTdf("checker", checker_params);
+        
+        if (m_config.stop.enabled) {
+            std::cout << "[Build] Creating stop monitor..." << std::endl;
+            stop_monitor = new SimStopMonitor("stop_monitor", m_config.stop,
+                                              rx->get_num_dfe_tap_signals());
+        }
+        
+        if (m_config.bathtub.enabled) {
+            std::cout << "[Build] Creating sampler-input histogram..." << std::endl;
+            BathtubParams bathtub = m_config.bathtub;
+            bathtub.decision_latency = rx->get_decision_latency();
+            eye_hist = new EyeHistogramTdf("eye_hist", bathtub, m_config.checker);
+        }
+        
+        if (m_config.jitter_monitor.enabled) {
+            std::cout << "[Build] Creating jitter monitor on " << m_config.jitter_node << " output..." << std::endl;
+            jitter_mon = new JitterMonitorTdf("jitter_mon", m_config.jitter_monitor);
+        }
+        
+        if (m_config.flight_recorder.enabled) {
+            // p/n 分开记录，共模问题也可见；抽头经 DE->TDF 桥接，每个抽头一路
+            std::vector<std::string> channels = {
+                "tx_p", "tx_n", "channel_p", "channel_n", "ctle_p", "ctle_n",
+                "vga_p", "vga_n", "dfe_p", "dfe_n", "cdr_phase"};
+            for (int i = 0; i < num_taps; ++i) {
+                channels.push_back("tap" + std::to_string(i + 1));
+            }
+            std::cout << "[Build] Creating flight recorder (" << channels.size() << " channels)..." << std::endl;
+            flight = new FlightRecorderTdf("flight", m_config.flight_recorder, channels,
+                                           m_config.output_prefix);
+            if (m_config.flight_recorder.tap_bound > 0.0) {
+                for (int i = 0; i < num_taps; ++i) {
+                    flight->set_bound(channels.size() - num_taps + i, m_config.flight_recorder.tap_bound);
+                }
+            }
+        }
+        
         std::cout << "[Build] Creating recorders..." << std::endl;
         rec_tx = new EyeDataRecorder("rec_tx", "tx_out");
         rec_channel = new EyeDataRecorder("rec_channel", "channel_out");
@@ -402,16 +466,29 @@ SC_MODULE(NrzLinkTb) {
         rec_vga = new EyeDataRecorder("rec_vga", "vga_out");
         rec_data = new DataRecorder("rec_data");
 
-        // DFE taps recorder (5 channels) - NOTE: DFE taps are DE domain signals
-        // For now we record constant 0 since DE-to-TDF conversion requires sca_de::sca_in/out bridge
-        // The actual tap values can be obtained from the final summary or by reading DE signals directly
-        rec_dfe_taps = new MultiChannelRecorder("rec_dfe_taps", "dfe_taps",
-            std::vector<std::string>{"tap1", "tap2", "tap3", "tap4", "tap5"});
+        // DFE taps recorder (one channel per tap, read through the DE-to-TDF bridge)
+        std::vector<std::string> tap_names;
+        for (int i = 0; i < num_taps; ++i) {
+            tap_names.push_back("tap" + std::to_string(i + 1));
+        }
+        rec_dfe_taps = new MultiChannelRecorder("rec_dfe_taps", "dfe_taps", tap_names);
 
         // CDR phase recorder (1 channel for phase, can be extended)
         rec_cdr_phase = new MultiChannelRecorder("rec_cdr_phase", "cdr_phase",
             std::vector<std::string>{"phase"});
 
+        if (!m_config.record_waveforms) {
+            std::cout << "[Build] Waveform recording disabled" << std::endl;
+            rec_tx->set_enabled(false);
+            rec_channel->set_enabled(false);
+            rec_dfe->set_enabled(false);
+            rec_ctle->set_enabled(false);
+            rec_vga->set_enabled(false);
+            rec_data->set_enabled(false);
+            rec_dfe_taps->set_enabled(false);
+            rec_cdr_phase->set_enabled(false);
+        }
+
 
         
         // ====== 连接信号链 ======
@@ -441,6 +518,31 @@ SC_MODULE(NrzLinkTb) {
         rx->vdd(sig_vdd);
         rx->data_out(sig_data_out);
         
+        // RX -> PRBS checker
+        checker->data_in(sig_data_out);
+        checker->trigger[0](rx->get_sampling_trigger_signal());
+        checker->locked(sig_chk_locked);
+        checker->bit_count(sig_chk_bits);
+        checker->error_count(sig_chk_errors);
+        checker->ber(sig_chk_ber);
+        checker->ber_upper(sig_chk_ber_upper);
+        checker->burst_count(sig_chk_bursts);
+        checker->max_burst(sig_chk_max_burst);
+        checker->sync_losses(sig_chk_sync_losses);
+        
+        // PRBS checker / DFE taps / CDR phase -> stop monitor
+        if (stop_monitor) {
+            stop_monitor->locked(sig_chk_locked);
+            stop_monitor->bit_count(sig_chk_bits);
+            stop_monitor->error_count(sig_chk_errors);
+            stop_monitor->sync_losses(sig_chk_sync_losses);
+            for (int i = 0; i < rx->get_num_dfe_tap_signals(); ++i) {
+                stop_monitor->tap[i](rx->get_dfe_tap_signal(i + 1));
+            }
+            RxTopModule* rx_top = rx;
+            stop_monitor->set_phase_probe([rx_top]() { return rx_top->get_cdr_phase(); });
+        }
+        
         // 连接记录器
         rec_tx->in_p(sig_tx_out_p);
         rec_tx->in_n(sig_tx_out_n);
@@ -459,39 +561,202 @@ SC_MODULE(NrzLinkTb) {
         // DFE 输出 (从 RX 内部获取)
         rec_dfe->in_p(const_cast<sca_tdf::sca_signal<double>&>(rx->get_dfe_out_p_signal()));
         rec_dfe->in_n(const_cast<sca_tdf::sca_signal<double>&>(rx->get_dfe_out_n_signal()));
+        
+        // 采样器输入直方图（DFE 求和输出），按 CDR 触发对齐、按 PRBS 期望比特分类
+        if (eye_hist) {
+            eye_hist->in_p(const_cast<sca_tdf::sca_signal<double>&>(rx->get_dfe_out_p_signal()));
+            eye_hist->in_n(const_cast<sca_tdf::sca_signal<double>&>(rx->get_dfe_out_n_signal()));
+            if (m_config.bathtub.reference == "prbs") {
+                eye_hist->sampling_trigger[0](rx->get_sampling_trigger_signal());
+                eye_hist->data_in[0](sig_data_out);
+            }
+        }
+        
+        // 边沿提取：信道输出或 DFE 求和输出，加 CDR 恢复时钟相位
+        if (jitter_mon) {
+            if (m_config.jitter_node == "dfe") {
+                jitter_mon->in_p(const_cast<sca_tdf::sca_signal<double>&>(rx->get_dfe_out_p_signal()));
+                jitter_mon->in_n(const_cast<sca_tdf::sca_signal<double>&>(rx->get_dfe_out_n_signal()));
+            } else {
+                jitter_mon->in_p(sig_channel_out_p);
+                jitter_mon->in_n(sig_channel_out_n);
+            }
+            jitter_mon->clk_phase(const_cast<sca_tdf::sca_signal<double>&>(rx->get_cdr_phase_signal()));
+        }
 
         // CDR 相位 - 连接到真实的 CDR 相位输出
-        rec_cdr_phase->in1(const_cast<sca_tdf::sca_signal<double>&>(rx->get_cdr_phase_signal()));
-        // 其他通道暂时不用
-        rec_cdr_phase->in2(sig_dummy1);
-        rec_cdr_phase->in3(sig_dummy2);
-        rec_cdr_phase->in4(sig_dummy3);
-        rec_cdr_phase->in5(sig_dummy4);
-
-        // DFE Taps - connect via DE-to-TDF bridge
-        // Connect DE inputs from RX to bridge
-        dfe_tap_bridge->de_tap1(rx->get_dfe_tap_signal(1));
-        dfe_tap_bridge->de_tap2(rx->get_dfe_tap_signal(2));
-        dfe_tap_bridge->de_tap3(rx->get_dfe_tap_signal(3));
-        dfe_tap_bridge->de_tap4(rx->get_dfe_tap_signal(4));
-        dfe_tap_bridge->de_tap5(rx->get_dfe_tap_signal(5));
-
-        // Connect TDF outputs from bridge to recorder
-        dfe_tap_bridge->out1(sig_dfe_tap1);
-        dfe_tap_bridge->out2(sig_dfe_tap2);
-        dfe_tap_bridge->out3(sig_dfe_tap3);
-        dfe_tap_bridge->out4(sig_dfe_tap4);
-        dfe_tap_bridge->out5(sig_dfe_tap5);
-
-        rec_dfe_taps->in1(sig_dfe_tap1);
-        rec_dfe_taps->in2(sig_dfe_tap2);
-        rec_dfe_taps->in3(sig_dfe_tap3);
-        rec_dfe_taps->in4(sig_dfe_tap4);
-        rec_dfe_taps->in5(sig_dfe_tap5);
+        rec_cdr_phase->in[0](const_cast<sca_tdf::sca_signal<double>&>(rx->get_cdr_phase_signal()));
+
+        // DFE Taps - RX DE signals -> bridge -> TDF signals -> recorder
+        for (size_t i = 0; i < sig_dfe_tap.size(); ++i) {
+            dfe_tap_bridge->de_tap[i](rx->get_dfe_tap_signal(static_cast<int>(i) + 1));
+            dfe_tap_bridge->out[i](sig_dfe_tap[i]);
+            rec_dfe_taps->in[i](sig_dfe_tap[i]);
+        }
 
         rec_data->in(sig_data_out);
         
+        // 飞行记录器：各节点 + CDR 相位 + DFE 抽头，误码计数与冻结标志触发
+        if (flight) {
+            std::vector<sca_tdf::sca_signal<double>*> nodes = {
+                &sig_tx_out_p, &sig_tx_out_n, &sig_channel_out_p, &sig_channel_out_n,
+                const_cast<sca_tdf::sca_signal<double>*>(&rx->get_ctle_out_p_signal()),
+                const_cast<sca_tdf::sca_signal<double>*>(&rx->get_ctle_out_n_signal()),
+                const_cast<sca_tdf::sca_signal<double>*>(&rx->get_vga_out_p_signal()),
+                const_cast<sca_tdf::sca_signal<double>*>(&rx->get_vga_out_n_signal()),
+                const_cast<sca_tdf::sca_signal<double>*>(&rx->get_dfe_out_p_signal()),
+                const_cast<sca_tdf::sca_signal<double>*>(&rx->get_dfe_out_n_signal()),
+                const_cast<sca_tdf::sca_signal<double>*>(&rx->get_cdr_phase_signal())};
+            for (size_t i = 0; nodes.size() < flight->in.size(); ++i) {
+                nodes.push_back(&sig_dfe_tap[i]);
+            }
+            for (size_t i = 0; i < flight->in.size(); ++i) {
+                flight->in[i](*nodes[i]);
+            }
+            flight->error_count(sig_chk_errors);
+            flight->freeze(rx->get_freeze_flag_signal());
+        }
+        
         std::cout << "[Build] NRZ Link built successfully (differential direct connection)" << std::endl;
+        
+        if (m_config.run_com) {
+            evaluate_com();
+        }
+    }
+    
+    /**
+     * @brief 由解析脉冲响应求 ZF/MMSE 系数，作为 FFE/DFE 初值（仅 SIMPLE 信道）
+     */
+    void seed_equalizers() {
+        if (m_config.channel_ext.method != ChannelMethod::SIMPLE) {
+            std::cout << "[Seed] Skipped: pulse-response seeding needs the SIMPLE channel" << std::endl;
+            return;
+        }
+        EqSeedResult seed = compute_link_eq_seed(m_config.eq_seed, m_config.tx, m_config.channel,
+                                                 m_config.rx, m_config.adaption,
+                                                 m_config.timestep_s(), m_config.oversampling);
+        apply_eq_seed(seed, m_config.eq_seed.ffe_taps > 1, m_config.oversampling,
+                      m_config.tx, m_config.rx, m_config.adaption);
+        
+        std::cout << "[Seed] " << m_config.eq_seed.criterion << ": main cursor "
+                  << seed.main_cursor * 1000 << " mV, residual ISI "
+                  << seed.residual_isi * 1000 << " mV" << std::endl;
+        std::cout << "[Seed] FFE:";
+        for (double c : m_config.tx.ffe.taps) std::cout << " " << c;
+        std::cout << "\n[Seed] DFE:";
+        for (double c : m_config.adaption.dfe.initial_taps) std::cout << " " << c;
+        std::cout << std::endl;
+    }
+    
+    /**
+     * @brief 时域仿真前的统计眼：线性链路脉冲响应 + 理想 DFE（仅 SIMPLE 信道）
+     */
+    void evaluate_stat_eye() {
+        if (m_config.channel_ext.method != ChannelMethod::SIMPLE) {
+            std::cout << "[StatEye] Skipped: the pulse response needs the SIMPLE channel" << std::endl;
+            return;
+        }
+        StatEyeResult eye = link_stat_eye(m_config.stat_eye, m_config.tx, m_config.channel,
+                                          m_config.rx, m_config.timestep_s(), m_config.oversampling);
+        std::cout << "[StatEye] Main cursor " << eye.main_cursor * 1000 << " mV, eye at BER "
+                  << m_config.stat_eye.target_ber << ": height " << eye.eye_height * 1000
+                  << " mV, width " << eye.eye_width << " UI (best phase "
+                  << eye.best_phase << " UI)" << std::endl;
+
+        std::string filename = m_config.output_prefix + "_stat_eye.csv";
+        std::ofstream file(filename);
+        file << "phase_ui,voltage,ber\n";
+        file << std::setprecision(6);
+        for (int p = 0; p < eye.num_phases; ++p) {
+            for (int v = 0; v < eye.num_bins; ++v) {
+                file << eye.phase[p] << "," << eye.voltage[v] << "," << eye.ber_at(p, v) << "\n";
+            }
+        }
+        std::cout << "[StatEye] Saved " << filename << std::endl;
+    }
+    
+    /**
+     * @brief 信道 COM：TX FFE 预设 × CTLE 族 × DFE 限幅空间内的最优设置
+     */
+    void evaluate_com() {
+        ComAnalyzer com(m_config.com, m_config.tx, m_config.rx, m_config.adaption,
+                        m_config.ui(), m_config.oversampling);
+        ComResult r = com.evaluate(channel->get_frequency_response(com.get_frequencies()));
+        std::cout << "[COM] " << com.get_num_ctle() * com.get_num_ffe() << " cases: COM "
+                  << r.com_db << " dB (A_s " << r.signal * 1000 << " mV, A_ni "
+                  << r.noise * 1000 << " mV)" << std::endl;
+        std::cout << "[COM] FFE:";
+        for (double c : r.ffe_taps) std::cout << " " << c;
+        std::cout << "\n[COM] CTLE: zero " << r.ctle.zero / 1e9 << " GHz, pole "
+                  << r.ctle.pole / 1e9 << " GHz, dc_gain " << r.ctle.dc_gain;
+        std::cout << "\n[COM] DFE:";
+        for (double c : r.dfe_taps) std::cout << " " << c;
+        std::cout << std::endl;
+    }
+    
+    /**
+     * @brief 联合搜索 TX FFE / CTLE / VGA / DFE，输出前 K 名并应用第一名
+     */
+    void optimize_equalizers() {
+        EqOptimizer opt(m_config.eq_opt, m_config.tx, m_config.rx, m_config.adaption,
+                        m_config.ui(), m_config.oversampling);
+        auto t0 = std::chrono::steady_clock::now();
+        EqOptResult r = opt.optimize(channel->get_frequency_response(opt.get_frequencies()));
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "[EqOpt] " << r.num_candidates << " candidates in " << secs << " s ("
+                  << r.num_candidates / std::max(secs, 1e-9) << " /s), "
+                  << r.num_pruned << " pruned" << std::endl;
+        for (size_t k = 0; k < r.best.size(); ++k) {
+            const EqCandidate& c = r.best[k];
+            std::cout << "[EqOpt] #" << k + 1 << ": eye " << c.eye_height * 1000 << " mV, SNR "
+                      << c.snr_db << " dB, phase " << c.phase << " UI, CTLE "
+                      << c.ctle.zero / 1e9 << "/" << c.ctle.pole / 1e9 << " GHz x"
+                      << c.ctle.dc_gain << ", VGA " << c.vga_gain << ", FFE:";
+            for (double f : c.ffe_taps) std::cout << " " << f;
+            std::cout << std::endl;
+            std::string filename = m_config.output_prefix + "_eq_rank" + std::to_string(k + 1) + ".json";
+            if (!save_eq_candidate(filename, c, static_cast<int>(k + 1), m_config.eq_opt.metric)) {
+                std::cerr << "[EqOpt] Cannot write " << filename << std::endl;
+            }
+        }
+        if (!r.best.empty()) {
+            apply_eq_candidate(r.best[0], m_config.oversampling,
+                               m_config.tx, m_config.rx, m_config.adaption);
+            std::cout << "[EqOpt] Applied rank 1 (candidates saved as "
+                      << m_config.output_prefix << "_eq_rank<k>.json)" << std::endl;
+        }
+    }
+    
+    /**
+     * @brief 应用 optimize_equalizers() 保存的候选配置，用于时域确认仿真
+     */
+    void load_equalizers() {
+        EqCandidate c = load_eq_candidate(m_config.eq_load_file);
+        apply_eq_candidate(c, m_config.oversampling, m_config.tx, m_config.rx, m_config.adaption);
+        std::cout << "[EqOpt] Loaded " << m_config.eq_load_file << " (predicted eye "
+                  << c.eye_height * 1000 << " mV, SNR " << c.snr_db << " dB)" << std::endl;
+    }
+    
+    // 链路检查点：发送端/信道/接收端全部自适应与滤波器状态
+    void save_state(const std::string& path) const {
+        StateCheckpoint cp;
+        wavegen->save_state(cp);
+        tx->save_state(cp);
+        channel->save_state(cp);
+        rx->save_state(cp);
+        cp.save(path);
+        std::cout << "[State] Saved " << cp.size() << " entries to " << path << std::endl;
+    }
+    
+    // 须在 sc_start 之前调用：仿真从已训练状态继续，只需运行测量窗口
+    void load_state(const std::string& path) {
+        StateCheckpoint cp;
+        cp.load(path);
+        wavegen->restore_state(cp);
+        tx->restore_state(cp);
+        channel->restore_state(cp);
+        rx->restore_state(cp);
+        std::cout << "[State] Restored " << cp.size() << " entries from " << path << std::endl;
     }
     
     void run() {
@@ -501,7 +766,12 @@ SC_MODULE(NrzLinkTb) {
         
         sc_core::sc_start(m_config.sim_duration, sc_core::SC_SEC);
         
-        std::cout << "Simulation completed." << std::endl;
+        if (stop_monitor && stop_monitor->get_reason() != StopReason::NONE) {
+            std::cout << "Simulation stopped early at " << stop_monitor->get_stop_time() * 1e6
+                      << " us (" << stop_reason_name(stop_monitor->get_reason()) << ")." << std::endl;
+        } else {
+            std::cout << "Simulation completed." << std::endl;
+        }
     }
     
     void save_results() {
@@ -509,23 +779,115 @@ SC_MODULE(NrzLinkTb) {
 
         std::string prefix = m_config.output_prefix;
 
-        rec_tx->save_csv(prefix + "_tx.csv");
-        rec_channel->save_csv(prefix + "_channel.csv");
-        rec_ctle->save_csv(prefix + "_ctle.csv");
-        rec_vga->save_csv(prefix + "_vga.csv");
-        rec_dfe->save_csv(prefix + "_dfe.csv");
-        rec_data->save_csv(prefix + "_data.csv");
+        if (m_config.record_waveforms) {
+            rec_tx->save_csv(prefix + "_tx.csv");
+            rec_channel->save_csv(prefix + "_channel.csv");
+            rec_ctle->save_csv(prefix + "_ctle.csv");
+            rec_vga->save_csv(prefix + "_vga.csv");
+            rec_dfe->save_csv(prefix + "_dfe.csv");
+            rec_data->save_csv(prefix + "_data.csv");
 
-        // Save DFE taps evolution
-        rec_dfe_taps->save_csv(prefix + "_dfe_taps.csv");
+            // Save DFE taps evolution
+            rec_dfe_taps->save_csv(prefix + "_dfe_taps.csv");
 
-        // Save CDR phase evolution
-        rec_cdr_phase->save_csv(prefix + "_cdr_phase.csv");
+            // Save CDR phase evolution
+            rec_cdr_phase->save_csv(prefix + "_cdr_phase.csv");
+        }
+
+        if (eye_hist) {
+            save_bathtub(prefix);
+        }
+        if (jitter_mon) {
+            save_jitter(prefix);
+        }
+        if (flight) {
+            flight->flush();
+            std::cout << "[Flight] " << flight->get_num_captures() << " capture(s) of "
+                      << flight->get_capacity() << " samples, " << flight->get_num_triggers()
+                      << " trigger(s)" << std::endl;
+        }
 
         // 保存配置元数据
         save_metadata(prefix + "_metadata.json");
     }
     
+    /**
+     * @brief 由采样器输入直方图外推浴盆曲线与 BER 等高线
+     */
+    void save_bathtub(const std::string& prefix) {
+        if (eye_hist->get_num_ui() == 0) {
+            std::cout << "[Bathtub] Skipped: no UI accumulated after the warm-up" << std::endl;
+            return;
+        }
+        BathtubResult r = eye_hist->compute();
+        std::cout << "[Bathtub] " << eye_hist->get_num_ui() << " UI ("
+                  << eye_hist->get_num_decision_errors() << " decision errors), best phase "
+                  << r.best_phase << " UI, BER there " << r.ber_threshold[r.best_index] << std::endl;
+        for (size_t t = 0; t < r.target_bers.size(); ++t) {
+            std::cout << "[Bathtub] BER " << r.target_bers[t] << ": height "
+                      << r.eye_height[t] * 1000 << " mV, width " << r.eye_width[t] << " UI" << std::endl;
+        }
+
+        std::ofstream h(prefix + "_bathtub_h.csv");
+        h << "phase_ui,ber\n" << std::setprecision(6);
+        for (int p = 0; p < r.num_phases; ++p) h << r.phase[p] << "," << r.ber_threshold[p] << "\n";
+
+        std::ofstream v(prefix + "_bathtub_v.csv");
+        v << "voltage,ber\n" << std::setprecision(6);
+        for (size_t b = 0; b < r.voltage.size(); ++b) v << r.voltage[b] << "," << r.ber_vertical[b] << "\n";
+
+        std::ofstream c(prefix + "_contour.csv");
+        c << "target_ber,phase_ui,upper,lower\n" << std::setprecision(6);
+        for (size_t t = 0; t < r.target_bers.size(); ++t) {
+            for (int p = 0; p < r.num_phases; ++p) {
+                c << r.target_bers[t] << "," << r.phase[p] << "," << r.contour_upper[t][p]
+                  << "," << r.contour_lower[t][p] << "\n";
+            }
+        }
+        std::cout << "[Bathtub] Saved " << prefix << "_bathtub_h.csv, _bathtub_v.csv, _contour.csv" << std::endl;
+    }
+    
+    /**
+     * @brief 打印数据边沿与恢复时钟的抖动分解，保存指标与残差谱
+     */
+    void save_jitter(const std::string& prefix) {
+        if (jitter_mon->get_num_edges() == 0) {
+            std::cout << "[Jitter] Skipped: no edges analysed after the warm-up" << std::endl;
+            return;
+        }
+        JitterReport data = jitter_mon->data_report();
+        JitterReport clock = jitter_mon->clock_report();
+        std::cout << "[Jitter] " << data.num_edges << " " << m_config.jitter_node << " edges, "
+                  << jitter_mon->get_dropped_edges() << " dropped, " << clock.num_edges
+                  << " clock samples" << std::endl;
+
+        std::ofstream f(prefix + "_jitter.csv");
+        f << "source,tie_rms_ps,tie_pp_ps,ddj_pp_ps,dcd_ps,pj_pp_ps,rj_rms_ps,dj_pp_ps,tj_ps,target_ber\n";
+        f << std::setprecision(6);
+        const JitterReport* reports[] = {&data, &clock};
+        const char* names[] = {"data", "clock"};
+        for (int i = 0; i < 2; ++i) {
+            const JitterReport& r = *reports[i];
+            std::cout << "[Jitter] " << std::setw(5) << names[i] << ": TJ@" << r.target_ber << " "
+                      << r.tj * 1e12 << " ps = DJ " << r.dj_pp * 1e12 << " (DDJ " << r.ddj_pp * 1e12
+                      << ", PJ " << r.pj_pp * 1e12 << ") + RJ " << r.rj_rms * 1e12 << " ps rms" << std::endl;
+            for (const PjTone& t : r.pj_tones) {
+                std::cout << "[Jitter]        PJ " << t.frequency / 1e6 << " MHz, "
+                          << t.amplitude_pp * 1e12 << " ps pp" << std::endl;
+            }
+            f << names[i] << "," << r.tie_rms * 1e12 << "," << r.tie_pp * 1e12 << "," << r.ddj_pp * 1e12
+              << "," << r.dcd * 1e12 << "," << r.pj_pp * 1e12 << "," << r.rj_rms * 1e12 << ","
+              << r.dj_pp * 1e12 << "," << r.tj * 1e12 << "," << r.target_ber << "\n";
+        }
+
+        std::ofstream psd(prefix + "_jitter_psd.csv");
+        psd << "freq_hz,data_s2_per_hz,clock_s2_per_hz\n" << std::setprecision(6);
+        for (size_t k = 0; k < data.psd.size() && k < clock.psd.size(); ++k) {
+            psd << data.psd_freq[k] << "," << data.psd[k] << "," << clock.psd[k] << "\n";
+        }
+        std::cout << "[Jitter] Saved " << prefix << "_jitter.csv, _jitter_psd.csv" << std::endl;
+    }
+    
     void save_metadata(const std::string& filename) {
         std::ofstream file(filename);
         if (!file.is_open()) return;
@@ -553,43 +915,47 @@ SC_MODULE(NrzLinkTb) {
         std::cout << "|           Simulation Summary                 |" << std::endl;
         std::cout << "+----------------------------------------------+" << std::endl;
 
-        // TX 统计
-        SignalStats tx_stats = rec_tx->get_diff_stats();
-        std::cout << "| TX Output:                                   |" << std::endl;
-        std::cout << "|   Peak-to-Peak: " << std::setw(10) << tx_stats.peak_to_peak * 1000
-                  << " mV            |" << std::endl;
-
-        // Channel 统计
-        SignalStats ch_stats = rec_channel->get_diff_stats();
-        double attn = 20 * std::log10(ch_stats.peak_to_peak / tx_stats.peak_to_peak);
-        std::cout << "| Channel Output:                              |" << std::endl;
-        std::cout << "|   Peak-to-Peak: " << std::setw(10) << ch_stats.peak_to_peak * 1000
-                  << " mV            |" << std::endl;
-        std::cout << "|   Attenuation:  " << std::setw(10) << attn
-                  << " dB            |" << std::endl;
-
-        // CTLE 统计
-        SignalStats ctle_stats = rec_ctle->get_diff_stats();
-        std::cout << "| CTLE Output:                                 |" << std::endl;
-        std::cout << "|   Peak-to-Peak: " << std::setw(10) << ctle_stats.peak_to_peak * 1000
-                  << " mV            |" << std::endl;
-
-        // VGA 统计
-        SignalStats vga_stats = rec_vga->get_diff_stats();
-        std::cout << "| VGA Output:                                  |" << std::endl;
-        std::cout << "|   Peak-to-Peak: " << std::setw(10) << vga_stats.peak_to_peak * 1000
-                  << " mV            |" << std::endl;
-
-        // DFE 统计
-        SignalStats dfe_stats = rec_dfe->get_diff_stats();
-        std::cout << "| DFE Output:                                  |" << std::endl;
-        std::cout << "|   Peak-to-Peak: " << std::setw(10) << dfe_stats.peak_to_peak * 1000
-                  << " mV            |" << std::endl;
+        if (m_config.record_waveforms) {
+            // TX 统计
+            SignalStats tx_stats = rec_tx->get_diff_stats();
+            std::cout << "| TX Output:                                   |" << std::endl;
+            std::cout << "|   Peak-to-Peak: " << std::setw(10) << tx_stats.peak_to_peak * 1000
+                      << " mV            |" << std::endl;
+
+            // Channel 统计
+            SignalStats ch_stats = rec_channel->get_diff_stats();
+            double attn = 20 * std::log10(ch_stats.peak_to_peak / tx_stats.peak_to_peak);
+            std::cout << "| Channel Output:                              |" << std::endl;
+            std::cout << "|   Peak-to-Peak: " << std::setw(10) << ch_stats.peak_to_peak * 1000
+                      << " mV            |" << std::endl;
+            std::cout << "|   Attenuation:  " << std::setw(10) << attn
+                      << " dB            |" << std::endl;
+
+            // CTLE 统计
+            SignalStats ctle_stats = rec_ctle->get_diff_stats();
+            std::cout << "| CTLE Output:                                 |" << std::endl;
+            std::cout << "|   Peak-to-Peak: " << std::setw(10) << ctle_stats.peak_to_peak * 1000
+                      << " mV            |" << std::endl;
+
+            // VGA 统计
+            SignalStats vga_stats = rec_vga->get_diff_stats();
+            std::cout << "| VGA Output:                                  |" << std::endl;
+            std::cout << "|   Peak-to-Peak: " << std::setw(10) << vga_stats.peak_to_peak * 1000
+                      << " mV            |" << std::endl;
+
+            // DFE 统计
+            SignalStats dfe_stats = rec_dfe->get_diff_stats();
+            std::cout << "| DFE Output:                                  |" << std::endl;
+            std::cout << "|   Peak-to-Peak: " << std::setw(10) << dfe_stats.peak_to_peak * 1000
+                      << " mV            |" << std::endl;
+        } else {
+            std::cout << "| Waveforms not recorded                       |" << std::endl;
+        }
 
         // DFE Tap 系数
         std::cout << "+----------------------------------------------+" << std::endl;
         std::cout << "| DFE Tap Coefficients (Final):                |" << std::endl;
-        for (int i = 1; i <= 5; ++i) {
+        for (int i = 1; rx && i <= rx->get_num_dfe_tap_signals(); ++i) {
             double tap = get_dfe_tap(i);
             std::cout << "|   Tap " << i << ": " << std::setw(12) << std::setprecision(6) << tap
                       << "                 |" << std::endl;
@@ -603,19 +969,64 @@ SC_MODULE(NrzLinkTb) {
         std::cout << "|   Integral:     " << std::setw(12) << std::setprecision(6)
                   << get_cdr_integral_state() << "               |" << std::endl;
 
-        std::cout << "+----------------------------------------------+" << std::endl;
-        std::cout << "| Output Files:                                |" << std::endl;
-        std::cout << "|   " << m_config.output_prefix << "_tx.csv" << std::endl;
-        std::cout << "|   " << m_config.output_prefix << "_channel.csv" << std::endl;
-        std::cout << "|   " << m_config.output_prefix << "_ctle.csv" << std::endl;
-        std::cout << "|   " << m_config.output_prefix << "_vga.csv" << std::endl;
-        std::cout << "|   " << m_config.output_prefix << "_dfe.csv" << std::endl;
-        std::cout << "|   " << m_config.output_prefix << "_data.csv" << std::endl;
-        std::cout << "|   " << m_config.output_prefix << "_dfe_taps.csv" << std::endl;
-        std::cout << "|   " << m_config.output_prefix << "_cdr_phase.csv" << std::endl;
+        // PRBS 误码统计
+        if (checker) {
+            const PrbsSyncChecker& chk = checker->get_checker();
+            std::cout << "+----------------------------------------------+" << std::endl;
+            std::cout << "| PRBS Checker:                                |" << std::endl;
+            std::cout << "|   Locked:       " << std::setw(12)
+                      << (chk.is_locked() ? (chk.is_inverted() ? "inverted" : "yes") : "no")
+                      << "               |" << std::endl;
+            std::cout << "|   Bits:         " << std::setw(12) << chk.get_bit_count()
+                      << "               |" << std::endl;
+            std::cout << "|   Errors:       " << std::setw(12) << chk.get_error_count()
+                      << "               |" << std::endl;
+            std::cout << "|   BER:          " << std::setw(12) << std::setprecision(3)
+                      << chk.get_ber() << "               |" << std::endl;
+            std::cout << "|   BER (" << std::setw(2) << static_cast<int>(m_config.checker.confidence * 100)
+                      << "% CL): " << std::setw(12) << std::setprecision(3)
+                      << chk.get_ber_upper() << "               |" << std::endl;
+            std::cout << "|   Bursts:       " << std::setw(12) << chk.get_burst_count()
+                      << "               |" << std::endl;
+            std::cout << "|   Sync losses:  " << std::setw(12) << chk.get_sync_losses()
+                      << "               |" << std::endl;
+        }
+        if (stop_monitor) {
+            std::cout << "|   Stopped by:   " << std::setw(12) << stop_reason_name(stop_monitor->get_reason())
+                      << "               |" << std::endl;
+        }
+
+        if (m_config.record_waveforms) {
+            std::cout << "+----------------------------------------------+" << std::endl;
+            std::cout << "| Output Files:                                |" << std::endl;
+            std::cout << "|   " << m_config.output_prefix << "_tx.csv" << std::endl;
+            std::cout << "|   " << m_config.output_prefix << "_channel.csv" << std::endl;
+            std::cout << "|   " << m_config.output_prefix << "_ctle.csv" << std::endl;
+            std::cout << "|   " << m_config.output_prefix << "_vga.csv" << std::endl;
+            std::cout << "|   " << m_config.output_prefix << "_dfe.csv" << std::endl;
+            std::cout << "|   " << m_config.output_prefix << "_data.csv" << std::endl;
+            std::cout << "|   " << m_config.output_prefix << "_dfe_taps.csv" << std::endl;
+            std::cout << "|   " << m_config.output_prefix << "_cdr_phase.csv" << std::endl;
+        }
         std::cout << "+----------------------------------------------+" << std::endl;
     }
     
+    /**
+     * @brief JTOL 试验判决
+     *
+     * 见 serdes::trial_passed()：检测器失锁或发生失步（滑码字不计入 BER）即失败
+     */
+    bool trial_passed() const {
+        const PrbsSyncChecker& chk = checker->get_checker();
+        LinkMetrics m;
+        m.locked = chk.is_locked();
+        m.bits = chk.get_bit_count();
+        m.errors = chk.get_error_count();
+        m.sync_losses = chk.get_sync_losses();
+        StopReason reason = stop_monitor ? stop_monitor->get_reason() : StopReason::NONE;
+        return serdes::trial_passed(m, reason, m_config.stop.target_ber);
+    }
+    
     double get_dfe_tap(int index) const {
         if (!rx) return 0.0;
         return rx->get_dfe_tap_signal(index).read();
@@ -633,15 +1044,16 @@ SC_MODULE(NrzLinkTb) {
     
     ~NrzLinkTb() {
         delete vdd_src;
-        delete dummy1_src;
-        delete dummy2_src;
-        delete dummy3_src;
-        delete dummy4_src;
         delete wavegen;
         delete dfe_tap_bridge;
         delete tx;
         delete channel;
         delete rx;
+        delete checker;
+        delete stop_monitor;
+        delete eye_hist;
+        delete jitter_mon;
+        delete flight;
         delete rec_tx;
         delete rec_channel;
         delete rec_ctle;
@@ -653,6 +1065,118 @@ SC_MODULE(NrzLinkTb) {
     }
 };
 
+// ============================================================================
+// JTOL Sweep (抖动容限扫描：每次试验是本程序的一个子进程)
+// ============================================================================
+
+namespace {
+
+std::string shell_quote(const std::string& arg) {
+    std::string out = "'";
+    for (char c : arg) {
+        if (c == '\'') out += "'\\''";
+        else out += c;
+    }
+    return out + "'";
+}
+
+// 去掉由扫描本身决定的选项（时长、输出、检查点、停止判据、SJ）及仅用于报告的选项，
+// 其余（信道、均衡器配置等）原样传给训练与试验进程
+std::string jtol_passthrough_args(int argc, char* argv[]) {
+    static const std::vector<std::string> one_value = {
+        "jtol", "-d", "-o", "load-state", "save-state", "stop-ber", "stop-settle", "jitter",
+        "flight-bound"};
+    static const std::vector<std::string> dropped = {
+        "no-record", "jtol-trial", "stat-eye", "com", "bathtub", "flight"};
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (std::find(one_value.begin(), one_value.end(), arg) != one_value.end()) {
+            ++i;
+        } else if (arg == "sj") {
+            i += 2;
+        } else if (std::find(dropped.begin(), dropped.end(), arg) == dropped.end()) {
+            out += " " + shell_quote(arg);
+        }
+    }
+    return out;
+}
+
+// 返回子进程退出码，无法运行或被信号终止时返回 -1
+int run_child(const std::string& command) {
+    int status = std::system(command.c_str());
+    return (status != -1 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+}
+
+} // namespace
+
+/**
+ * @brief JTOL 协调进程
+ *
+ * 先运行一次训练（除非已给出 load-state），保存链路检查点；此后每次试验
+ * 从该检查点启动子进程，注入单频 SJ，由 stop-ber 判据在试验 BER 下提前
+ * 判决，并以退出码返回结果。各频点的二分搜索由 run_jtol_sweep 分配到多个
+ * 线程，每个线程阻塞于自己的子进程。
+ */
+int run_jtol(const NrzLinkConfig& config, int argc, char* argv[]) {
+    const JtolParams& jp = config.jtol;
+    JtolMask mask = JtolMask::from_name(jp.mask);
+    const std::string self = shell_quote(argv[0]);
+    const std::string common = jtol_passthrough_args(argc, argv);
+    const std::string prefix = config.output_prefix + "_jtol";
+
+    std::string checkpoint = config.load_state_file;
+    if (checkpoint.empty()) {
+        checkpoint = prefix + "_trained.ckpt";
+        std::cout << "[JTOL] Training the link for " << config.sim_ui_count() << " UI..." << std::endl;
+        std::string cmd = self + common + " -d " + std::to_string(config.sim_ui_count())
+                          + " -o " + shell_quote(prefix + "_train") + " save-state " + shell_quote(checkpoint)
+                          + " no-record > " + shell_quote(prefix + "_train.log") + " 2>&1";
+        if (run_child(cmd) != 0) {
+            std::cerr << "[JTOL] Training run failed, see " << prefix << "_train.log" << std::endl;
+            return 1;
+        }
+    }
+
+    const double ui = config.ui();
+    std::atomic<int> next_id(0);
+    JtolTrial trial = [&](double freq, double amp) {
+        // 足够在目标 BER 下判决，且至少覆盖 min_sj_periods 个 SJ 周期
+        double ui_count = std::max(4.5 / jp.target_ber, jp.min_sj_periods / (freq * ui));
+        std::string tag = prefix + "_trial" + std::to_string(next_id++);
+        std::ostringstream cmd;
+        cmd << std::setprecision(9) << self << common << " sj " << freq << " " << amp
+            << " load-state " << shell_quote(checkpoint) << " stop-ber " << jp.target_ber
+            << " no-record jtol-trial -d " << static_cast<long long>(std::ceil(ui_count))
+            << " -o " << shell_quote(tag) << " > " << shell_quote(tag + ".log") << " 2>&1";
+        int code = run_child(cmd.str());
+        if (code != 0 && code != 1) {
+            throw std::runtime_error("JTOL trial aborted (see " + tag + ".log)");
+        }
+        return code == 0;
+    };
+
+    std::cout << "[JTOL] Sweeping mask " << jp.mask << " at trial BER " << jp.target_ber << "..." << std::endl;
+    auto t0 = std::chrono::steady_clock::now();
+    JtolResult r = run_jtol_sweep(jp, mask, trial);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::ofstream csv(prefix + ".csv");
+    csv << "freq_hz,mask_ui,tolerance_ui,failing_ui,margin_db,trials,pass\n" << std::setprecision(6);
+    std::cout << "\n    Freq (Hz)   Mask (UI)    Tol (UI)  Margin (dB)  Result" << std::endl;
+    for (const JtolPoint& pt : r.points) {
+        csv << pt.frequency << "," << pt.mask << "," << pt.tolerance << "," << pt.failing << ","
+            << pt.margin_db << "," << pt.trials << "," << (pt.pass ? 1 : 0) << "\n";
+        std::cout << std::setw(13) << std::setprecision(4) << pt.frequency
+                  << std::setw(12) << pt.mask << std::setw(12) << pt.tolerance
+                  << std::setw(13) << std::setprecision(3) << pt.margin_db
+                  << "  " << (pt.pass ? "PASS" : "FAIL") << std::endl;
+    }
+    std::cout << "[JTOL] Mask " << (r.pass ? "PASSED" : "FAILED") << " (" << r.total_trials
+              << " trials, " << std::setprecision(3) << seconds << " s), saved " << prefix << ".csv" << std::endl;
+    return 0;
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -695,6 +1219,69 @@ int sc_main(int argc, char* argv[]) {
             std::cout << "Using STATE_SPACE channel: " << config_file << std::endl;
             config.use_state_space_channel(config_file);
         }
+        else if (arg == "seed") {
+            std::cout << "Seeding DFE taps from the pulse response..." << std::endl;
+            config.eq_seed.enabled = true;
+        }
+        else if (arg == "seed-ffe" && i + 1 < argc) {
+            config.eq_seed.enabled = true;
+            config.eq_seed.ffe_taps = std::atoi(argv[++i]);
+            std::cout << "Seeding " << config.eq_seed.ffe_taps
+                      << "-tap FFE and DFE taps from the pulse response..." << std::endl;
+        }
+        else if (arg == "stat-eye") {
+            config.run_stat_eye = true;
+            config.stat_eye.num_dfe = config.adaption.dfe.num_taps;
+        }
+        else if (arg == "com") {
+            config.run_com = true;
+            config.com.ffe_presets = {{1.0}, {0.9, -0.1}, {0.8, -0.2}, {0.7, -0.3},
+                                      {-0.1, 0.8, -0.1}, {-0.1, 0.7, -0.2}};
+            config.com.ctle_dc_gains = {1.0, 0.79, 0.63, 0.5, 0.4, 0.32, 0.25};
+        }
+        else if (arg == "eq-opt") {
+            config.eq_opt.enabled = true;
+            config.eq_opt.ctle_dc_gains = {1.0, 0.79, 0.63, 0.5, 0.4, 0.32, 0.25};
+            config.eq_opt.vga_gains = {1.0, 1.5, 2.0, 3.0};
+        }
+        else if (arg == "eq-load" && i + 1 < argc) {
+            config.eq_load_file = argv[++i];
+        }
+        else if (arg == "bathtub") {
+            config.bathtub.enabled = true;
+        }
+        else if (arg == "jitter" && i + 1 < argc) {
+            config.jitter_monitor.enabled = true;
+            config.jitter_node = argv[++i];
+            if (config.jitter_node != "channel" && config.jitter_node != "dfe") {
+                std::cerr << "Error: jitter node must be 'channel' or 'dfe'" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "flight") {
+            config.flight_recorder.enabled = true;
+        }
+        else if (arg == "flight-bound" && i + 1 < argc) {
+            config.flight_recorder.enabled = true;
+            config.flight_recorder.tap_bound = std::atof(argv[++i]);
+        }
+        else if (arg == "sj" && i + 2 < argc) {
+            double freq = std::atof(argv[++i]);
+            double pp_ui = std::atof(argv[++i]);
+            config.wave.jitter.SJ_freq.push_back(freq);
+            config.wave.jitter.SJ_pp.push_back(pp_ui * config.ui());
+            std::cout << "Injecting SJ " << pp_ui << " UI pp at " << freq << " Hz" << std::endl;
+        }
+        else if (arg == "jtol" && i + 1 < argc) {
+            config.jtol.enabled = true;
+            config.jtol.mask = argv[++i];
+        }
+        else if (arg == "jtol-trial") {
+            config.jtol_trial = true;
+        }
+        else if (arg == "no-record") {
+            config.record_waveforms = false;
+        }
         else if (arg == "-d" && i + 1 < argc) {
             int ui_count = std::atoi(argv[++i]);
             std::cout << "Setting duration to " << ui_count << " UI..." << std::endl;
@@ -703,6 +1290,23 @@ int sc_main(int argc, char* argv[]) {
         else if (arg == "-o" && i + 1 < argc) {
             config.output_prefix = argv[++i];
         }
+        else if (arg == "load-state" && i + 1 < argc) {
+            config.load_state_file = argv[++i];
+        }
+        else if (arg == "save-state" && i + 1 < argc) {
+            config.save_state_file = argv[++i];
+        }
+        else if (arg == "stop-ber" && i + 1 < argc) {
+            config.stop.enabled = true;
+            config.stop.target_ber = std::atof(argv[++i]);
+            std::cout << "Stopping once BER is decided against " << config.stop.target_ber << std::endl;
+        }
+        else if (arg == "stop-settle" && i + 1 < argc) {
+            config.stop.enabled = true;
+            config.stop.settle_checks = std::atoi(argv[++i]);
+            std::cout << "Stopping once taps/CDR are stable for " << config.stop.settle_checks
+                      << " checks" << std::endl;
+        }
         else if (arg == "-h" || arg == "--help") {
             std::cout << "\nUsage: nrz_link_tb [options]\n" << std::endl;
             std::cout << "Options:" << std::endl;
@@ -710,21 +1314,66 @@ int sc_main(int argc, char* argv[]) {
             std::cout << "  short       Use short channel (3dB loss)" << std::endl;
             std::cout << "  no-adapt    Disable adaption" << std::endl;
             std::cout << "  ss <file>   Use State Space channel from JSON" << std::endl;
+            std::cout << "  seed        Seed DFE taps from the pulse response (MMSE)" << std::endl;
+            std::cout << "  seed-ffe <n> Also solve an n-tap UI-spaced TX FFE" << std::endl;
+            std::cout << "  stat-eye    Print the statistical eye of the linear link before the run" << std::endl;
+            std::cout << "  com         Print the channel COM and the best FFE preset / CTLE / DFE setting" << std::endl;
+            std::cout << "  eq-opt      Search FFE/CTLE/VGA/DFE on the pulse response, save the top-K and apply the best" << std::endl;
+            std::cout << "  eq-load <file> Apply a candidate saved by eq-opt (confirmation run)" << std::endl;
+            std::cout << "  bathtub     Extrapolate bathtubs / BER contours (1e-12..1e-15) from sampler-input histograms" << std::endl;
+            std::cout << "  jitter <node> Decompose TJ/RJ/DJ/DDJ/PJ of the channel or dfe edges and the CDR clock in-sim" << std::endl;
+            std::cout << "  flight      Capture all nodes around checker errors / adaption freeze to <prefix>_flight<N>.csv" << std::endl;
+            std::cout << "  flight-bound <v> Also capture when a DFE tap leaves +/-v" << std::endl;
+            std::cout << "  sj <hz> <ui> Inject sinusoidal jitter (UI pp) at the TX data edges" << std::endl;
+            std::cout << "  jtol <mask> Sweep SJ tolerance against a mask (ieee_802_3ck, oif_cei_112g, jedec_ddr5, pcie_gen6)" << std::endl;
+            std::cout << "  jtol-trial  Run one JTOL trial: exit code 0 = BER met, 1 = not met" << std::endl;
+            std::cout << "  no-record   Do not record or save waveforms" << std::endl;
             std::cout << "  -d <ui>     Set duration in UI count" << std::endl;
             std::cout << "  -o <prefix> Set output file prefix" << std::endl;
+            std::cout << "  load-state <file> Start from a saved (trained) link state" << std::endl;
+            std::cout << "  save-state <file> Save the link state at the end of the run" << std::endl;
+            std::cout << "  stop-ber <ber> Stop once BER is above/below target at 95% confidence" << std::endl;
+            std::cout << "  stop-settle <n> Stop once DFE taps/CDR phase are stable for n checks (1000 UI each)" << std::endl;
             return 0;
         }
     }
     
+    if (config.jtol.enabled) {
+        return run_jtol(config, argc, argv);
+    }
+    if (config.jtol_trial) {
+        // 至少覆盖 min_sj_periods 个最低频 SJ 周期后才允许提前判决
+        for (double f : config.wave.jitter.SJ_freq) {
+            double t = config.jtol.min_sj_periods / f;
+            config.stop.min_time = std::max(config.stop.min_time, std::min(t, config.sim_duration));
+        }
+    }
+    
     // 创建测试台
     NrzLinkTb tb("tb");
     tb.configure(config);
     tb.build();
+    if (!config.load_state_file.empty()) {
+        tb.load_state(config.load_state_file);
+    }
     tb.run();
+    if (!config.save_state_file.empty()) {
+        tb.save_state(config.save_state_file);
+    }
+    if (config.jtol_trial) {
+        bool pass = tb.trial_passed();
+        std::cout << "[JTOL] Trial " << (pass ? "PASS" : "FAIL") << std::endl;
+        if (sc_core::sc_get_status() != sc_core::SC_STOPPED) {
+            sc_core::sc_stop();
+        }
+        return pass ? 0 : 1;
+    }
     tb.save_results();
     tb.print_summary();
     
-    sc_core::sc_stop();
+    if (sc_core::sc_get_status() != sc_core::SC_STOPPED) {
+        sc_core::sc_stop();
+    }
     
     std::cout << "\nTestbench completed successfully." << std::endl;
     return 0;
@@ -19,6 +19,8 @@ namespace test {
 // Test Helper: Simple Data Source
 // ============================================================================
 
+// Four samples per 100 ps UI, each pattern entry held for half a UI: the
+// CDR's edge and data triggers read alternate entries (edge, data, edge, ...)
 class SimpleDataSource : public sca_tdf::sca_module {
 public:
     sca_tdf::sca_out<double> out;
@@ -35,12 +37,12 @@ public:
 
     void set_attributes() {
         out.set_rate(1);
-        out.set_timestep(1.0 / 10e9, sc_core::SC_SEC);  // 10 GHz
+        out.set_timestep(1.0 / 40e9, sc_core::SC_SEC);  // 4x 10 Gbps
     }
 
     void processing() {
         if (!m_data_pattern.empty()) {
-            out.write(m_data_pattern[m_index % m_data_pattern.size()]);
+            out.write(m_data_pattern[(m_index / 2) % m_data_pattern.size()]);
             m_index++;
         } else {
             out.write(0.0);
@@ -0,0 +1,167 @@
+/**
+ * @file test_adaption_event_scheduler.cpp
+ * @brief Unit test for AdaptionDe - Event-Driven Scheduler ("event" mode)
+ */
+
+#include <gtest/gtest.h>
+#include <systemc>
+#include "ams/adaption.h"
+#include "common/parameters.h"
+
+using namespace serdes;
+
+namespace {
+
+// Constant loop inputs plus a decimated tick standing in for DfeAdaptTdf
+class TickSource : public sc_core::sc_module {
+public:
+    sc_core::sc_out<double> phase_error;
+    sc_core::sc_out<double> amplitude_rms;
+    sc_core::sc_out<int> mode;
+    sc_core::sc_out<bool> reset;
+    sc_core::sc_out<double> scenario_switch;
+    sc_core::sc_out<int> tick;
+
+    sc_core::sc_time m_tick_period;
+    int m_mode;
+
+    SC_HAS_PROCESS(TickSource);
+
+    TickSource(sc_core::sc_module_name nm, const sc_core::sc_time& tick_period)
+        : sc_core::sc_module(nm)
+        , phase_error("phase_error")
+        , amplitude_rms("amplitude_rms")
+        , mode("mode")
+        , reset("reset")
+        , scenario_switch("scenario_switch")
+        , tick("tick")
+        , m_tick_period(tick_period)
+        , m_mode(2)
+    {
+        SC_THREAD(source_process);
+    }
+
+    void source_process() {
+        phase_error.write(1e-12);
+        amplitude_rms.write(0.3);
+        reset.write(false);
+        scenario_switch.write(0.0);
+        int count = 0;
+        while (true) {
+            mode.write(m_mode);
+            wait(m_tick_period);
+            tick.write(++count);
+        }
+    }
+};
+
+// One AdaptionDe with all outputs bound to local signals
+struct AdaptionUnderTest {
+    AdaptionDe* dut;
+    sc_core::sc_signal<int> stat_int[5];
+    sc_core::sc_signal<double> stat_double[4];
+    sc_core::sc_signal<double> out_double[8];
+    sc_core::sc_signal<int> out_update_count;
+    sc_core::sc_signal<bool> out_freeze;
+
+    AdaptionUnderTest(const char* name, const AdaptionParams& params, TickSource& src,
+                      sc_core::sc_signal<double>& phase_error,
+                      sc_core::sc_signal<double>& amplitude,
+                      sc_core::sc_signal<int>& mode,
+                      sc_core::sc_signal<bool>& reset,
+                      sc_core::sc_signal<double>& scenario,
+                      sc_core::sc_signal<int>& tick) {
+        (void)src;
+        dut = new AdaptionDe(name, params);
+        dut->phase_error(phase_error);
+        dut->amplitude_rms(amplitude);
+        dut->mode(mode);
+        dut->reset(reset);
+        dut->scenario_switch(scenario);
+        dut->stat_N_A(stat_int[0]);
+        dut->stat_N_B(stat_int[1]);
+        dut->stat_N_C(stat_int[2]);
+        dut->stat_N_D(stat_int[3]);
+        dut->stat_dfe_state(stat_int[4]);
+        dut->stat_P_pos(stat_double[0]);
+        dut->stat_P_neg(stat_double[1]);
+        dut->stat_C(stat_double[2]);
+        dut->stat_Delta(stat_double[3]);
+        dut->vga_gain(out_double[0]);
+        dut->ctle_zero(out_double[1]);
+        dut->ctle_pole(out_double[2]);
+        dut->ctle_dc_gain(out_double[3]);
+        dut->vref_cmd(out_double[4]);
+        dut->sampler_threshold(out_double[5]);
+        dut->sampler_hysteresis(out_double[6]);
+        dut->phase_cmd(out_double[7]);
+        dut->update_count(out_update_count);
+        dut->freeze_flag(out_freeze);
+        if (dut->adapt_tick.size() > 0) {
+            dut->adapt_tick[0](tick);
+        }
+    }
+};
+
+} // namespace
+
+// 事件调度：批量更新与周期调度一致，唤醒次数按抽取比例减少，冻结时完全休眠
+TEST(AdaptionEventTest, TickDrivenBatchesMatchPeriodicLoop) {
+    AdaptionParams periodic;
+    periodic.agc.enabled = false;
+    periodic.dfe.enabled = false;
+    periodic.cdr_pi.kp = 1.0;
+    periodic.cdr_pi.ki = 2e7;
+    periodic.safety.rollback_enable = false;
+    periodic.fast_update_period = 2.5e-10;
+    periodic.event_decimation = 8;
+
+    AdaptionParams event = periodic;
+    event.update_mode = "event";
+
+    sc_core::sc_signal<double> sig_phase_error, sig_amplitude, sig_scenario;
+    sc_core::sc_signal<int> sig_mode, sig_tick;
+    sc_core::sc_signal<bool> sig_reset;
+
+    // Tick every event_decimation fast periods (2 ns)
+    TickSource src("src", sc_core::sc_time(2.0, sc_core::SC_NS));
+    src.phase_error(sig_phase_error);
+    src.amplitude_rms(sig_amplitude);
+    src.mode(sig_mode);
+    src.reset(sig_reset);
+    src.scenario_switch(sig_scenario);
+    src.tick(sig_tick);
+
+    AdaptionUnderTest ref("adaption_periodic", periodic, src, sig_phase_error, sig_amplitude,
+                          sig_mode, sig_reset, sig_scenario, sig_tick);
+    AdaptionUnderTest evt("adaption_event", event, src, sig_phase_error, sig_amplitude,
+                          sig_mode, sig_reset, sig_scenario, sig_tick);
+    ASSERT_EQ(evt.dut->adapt_tick.size(), 1u);
+    ASSERT_EQ(ref.dut->adapt_tick.size(), 0u);
+
+    sc_core::sc_start(1, sc_core::SC_US);
+
+    int n_ref = ref.dut->get_update_count();
+    int n_evt = evt.dut->get_update_count();
+    EXPECT_NEAR(n_ref, 4000, 1);
+    EXPECT_NEAR(n_evt, n_ref, event.event_decimation);
+    EXPECT_NEAR(evt.dut->get_wake_count(), n_evt / event.event_decimation, 1);
+    EXPECT_NEAR(evt.out_double[7].read(), ref.out_double[7].read(),
+                2.0 * periodic.cdr_pi.phase_resolution);
+
+    // Freeze: ticks keep coming but the event scheduler does not run
+    src.m_mode = 3;
+    sc_core::sc_start(10, sc_core::SC_NS);
+    int wakes = evt.dut->get_wake_count();
+    int count = evt.dut->get_update_count();
+    sc_core::sc_start(1, sc_core::SC_US);
+    EXPECT_EQ(evt.dut->get_wake_count(), wakes);
+    EXPECT_EQ(evt.dut->get_update_count(), count);
+
+    // Resume: the schedule restarts from the wake, not from the freeze
+    src.m_mode = 2;
+    sc_core::sc_start(100, sc_core::SC_NS);
+    EXPECT_NEAR(evt.dut->get_update_count() - count, 400, 2 * event.event_decimation);
+
+    sc_core::sc_stop();
+}
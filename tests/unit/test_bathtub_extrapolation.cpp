@@ -0,0 +1,193 @@
+/**
+ * @file test_bathtub_extrapolation.cpp
+ * @brief Unit tests for the histogram tail fits, bathtubs and BER contours
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "ams/bathtub.h"
+
+using namespace serdes;
+
+namespace {
+
+double q_function(double x) {
+    return 0.5 * std::erfc(x / std::sqrt(2.0));
+}
+
+double inverse_q(double p) {
+    double lo = 0.0, hi = 40.0;
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (lo + hi);
+        (q_function(mid) > p ? lo : hi) = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+BathtubParams default_params() {
+    BathtubParams p;
+    p.num_bins = 400;
+    p.v_range = 0.4;
+    return p;
+}
+
+// Levels +/-amp with Gaussian noise at every phase; amp(p) may vary with phase
+template <typename Amp>
+EyeHistogram gaussian_eye(int num_phases, int per_level, double sigma, Amp amp, unsigned seed) {
+    EyeHistogram hist(num_phases, 400, -0.4, 0.4);
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, sigma);
+    for (int p = 0; p < num_phases; ++p) {
+        double a = amp(p);
+        for (int i = 0; i < per_level; ++i) {
+            hist.add(p, true, a + noise(rng));
+            hist.add(p, false, -a + noise(rng));
+        }
+    }
+    return hist;
+}
+
+} // namespace
+
+// 高斯尾部拟合：恢复均值与标准差，1e-12 等高线与解析值一致
+TEST(BathtubTest, GaussianTailExtrapolatesToLowBer) {
+    const double amp = 0.16, sigma = 0.02;
+    EyeHistogram hist = gaussian_eye(1, 1000000, sigma, [&](int) { return amp; }, 1);
+    BathtubParams params = default_params();
+    params.tail_model = "gaussian";
+
+    TailFit f1 = fit_level_tail(hist, 0, true, params);
+    TailFit f0 = fit_level_tail(hist, 0, false, params);
+    EXPECT_GE(f1.num_points, 3);
+    EXPECT_NEAR(f1.mu, amp, 0.003);
+    EXPECT_NEAR(f1.sigma, sigma, 0.001);
+    EXPECT_NEAR(f0.mu, -amp, 0.003);
+    EXPECT_NEAR(f0.sigma, sigma, 0.001);
+
+    // Q(8) = 6.2e-16 at the threshold: far below anything a 1e6-UI run sees
+    double ber0 = extrapolated_ber(hist, 0, 0.0, f1, f0, params);
+    EXPECT_NEAR(std::log10(ber0), std::log10(q_function(amp / sigma)), 0.3);
+
+    BathtubResult r = compute_bathtub(hist, params);
+    ASSERT_EQ(r.target_bers.size(), 4u);
+    for (size_t t = 0; t < r.target_bers.size(); ++t) {
+        // Upper contour: 0.5 * Q((amp - v) / sigma) = target
+        double expected = amp - sigma * inverse_q(2.0 * r.target_bers[t]);
+        EXPECT_NEAR(r.contour_upper[t][0], expected, 0.004) << "target " << r.target_bers[t];
+        EXPECT_NEAR(r.contour_lower[t][0], -expected, 0.004);
+        EXPECT_NEAR(r.eye_height[t], 2.0 * expected, 0.008);
+    }
+    EXPECT_GT(r.eye_height[0], r.eye_height[3]);   // 1e-12 opening > 1e-15 opening
+}
+
+// 双狄拉克拟合：识别最内侧狄拉克的权重与位置
+TEST(BathtubTest, DualDiracFitFindsInnerDirac) {
+    const double amp = 0.2, isi = 0.05, sigma = 0.015;
+    EyeHistogram hist(1, 400, -0.4, 0.4);
+    std::mt19937 rng(2);
+    std::normal_distribution<double> noise(0.0, sigma);
+    for (int i = 0; i < 1000000; ++i) {
+        double level = amp + ((i & 1) ? isi : -isi);    // Inner Dirac at amp - isi, weight 0.5
+        hist.add(0, true, level + noise(rng));
+        hist.add(0, false, -level + noise(rng));
+    }
+    BathtubParams params = default_params();
+    TailFit f1 = fit_level_tail(hist, 0, true, params);
+    EXPECT_NEAR(f1.rho, 0.5, 0.15);
+    EXPECT_NEAR(f1.mu, amp - isi, 0.005);
+    EXPECT_NEAR(f1.sigma, sigma, 0.0015);
+
+    BathtubResult r = compute_bathtub(hist, params);
+    for (size_t t = 0; t < r.target_bers.size(); ++t) {
+        // 0.5 (level share) * 0.5 (inner Dirac) * Q((amp - isi - v) / sigma) = target
+        double expected = amp - isi - sigma * inverse_q(4.0 * r.target_bers[t]);
+        EXPECT_NEAR(r.contour_upper[t][0], expected, 0.004) << "target " << r.target_bers[t];
+    }
+}
+
+// 水平浴盆：各相位独立外推，最佳相位居中，眼宽与解析值一致
+TEST(BathtubTest, HorizontalBathtubAndEyeWidth) {
+    const int np = 32;
+    const double sigma = 0.02;
+    auto amp = [&](int p) {
+        double x = static_cast<double>(p - np / 2) / np;       // UI from the center
+        return 0.25 * std::cos(M_PI * x);
+    };
+    EyeHistogram hist = gaussian_eye(np, 200000, sigma, amp, 3);
+    BathtubParams params = default_params();
+    BathtubResult r = compute_bathtub(hist, params);
+
+    ASSERT_EQ(r.num_phases, np);
+    EXPECT_NEAR(r.best_phase, 0.0, 1.5 / np);
+    for (int p = 0; p < np; ++p) {
+        double expected = q_function(amp(p) / sigma);
+        if (expected < 1e-16) continue;      // Deeper than any target
+        EXPECT_NEAR(std::log10(r.ber_threshold[p]), std::log10(expected), 0.5) << "phase " << p;
+    }
+    for (size_t t = 0; t < r.target_bers.size(); ++t) {
+        // Q(amp(x) / sigma) = target  ->  cos(pi x) = sigma * Q^-1(target) / 0.25
+        double x = std::acos(sigma * inverse_q(r.target_bers[t]) / 0.25) / M_PI;
+        EXPECT_NEAR(r.eye_width[t], 2.0 * x, 2.0 / np) << "target " << r.target_bers[t];
+    }
+    EXPECT_GE(r.eye_width[0], r.eye_width[3]);
+
+    // Vertical bathtub at the best phase: low in the middle, 0.5 level at the rails
+    ASSERT_EQ(r.voltage.size(), 400u);
+    EXPECT_LT(r.ber_vertical[200], 1e-15);
+    EXPECT_GT(r.ber_vertical[0], 0.4);
+    EXPECT_GT(r.ber_vertical[399], 0.4);
+}
+
+// 尾部样本不足时退回矩估计；窗口外样本计入端点箱
+TEST(BathtubTest, MomentFallbackAndClamping) {
+    EyeHistogram hist(1, 64, -0.1, 0.1);
+    std::mt19937 rng(4);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    for (int i = 0; i < 50; ++i) {
+        hist.add(0, true, 0.05 + noise(rng));
+        hist.add(0, false, -0.05 + noise(rng));
+    }
+    hist.add(0, true, 5.0);
+    hist.add(0, false, -5.0);
+    EXPECT_EQ(hist.count(0, true, 63), 1u);
+    EXPECT_EQ(hist.count(0, false, 0), 1u);
+    EXPECT_EQ(hist.total(0, true), 51u);
+
+    BathtubParams params = default_params();
+    params.num_bins = 64;
+    TailFit f = fit_level_tail(hist, 0, true, params);
+    EXPECT_EQ(f.num_points, 0);
+    EXPECT_DOUBLE_EQ(f.rho, 1.0);
+    EXPECT_GT(f.sigma, 0.0);
+    EXPECT_GT(f.mu, 0.0);
+
+    hist.clear();
+    EXPECT_EQ(hist.total(0, true), 0u);
+    EXPECT_THROW(compute_bathtub(hist, params), std::invalid_argument);
+}
+
+// 参数校验
+TEST(BathtubTest, RejectsInvalidParameters) {
+    EXPECT_THROW(EyeHistogram(0, 64, -1.0, 1.0), std::invalid_argument);
+    EXPECT_THROW(EyeHistogram(1, 1, -1.0, 1.0), std::invalid_argument);
+    EXPECT_THROW(EyeHistogram(1, 64, 1.0, 1.0), std::invalid_argument);
+
+    BathtubParams p = default_params();
+    EXPECT_NO_THROW(validate_bathtub_params(p));
+    p.tail_model = "spline";
+    EXPECT_THROW(validate_bathtub_params(p), std::invalid_argument);
+    p = default_params();
+    p.tail_fraction = 0.8;
+    EXPECT_THROW(validate_bathtub_params(p), std::invalid_argument);
+    p = default_params();
+    p.target_bers = {1e-12, 0.0};
+    EXPECT_THROW(validate_bathtub_params(p), std::invalid_argument);
+    p = default_params();
+    p.num_bins = 8;
+    EXPECT_THROW(validate_bathtub_params(p), std::invalid_argument);
+    p = default_params();
+    p.ui = 0.0;
+    EXPECT_THROW(validate_bathtub_params(p), std::invalid_argument);
+}
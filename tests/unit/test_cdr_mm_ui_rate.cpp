@@ -0,0 +1,137 @@
+/**
+ * @file test_cdr_mm_ui_rate.cpp
+ * @brief RxCdrTdf with the Mueller-Muller detector updates its loop once per
+ *        data trigger, on the step the trigger's sample arrives
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <cmath>
+#include <deque>
+#include <vector>
+#include "ams/rx_cdr.h"
+#include "common/parameters.h"
+#include "common/prbs.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 100e-12;
+const int SPU = 16;
+const int NUM_UI = 3000;
+
+// Band-limited NRZ, eye centers at (k + 1/2) UI
+double waveform(const std::vector<double>& d, double t_ui) {
+    auto step = [](double x) { return 0.5 * (1.0 + std::erf(x / 0.45)); };
+    int k = static_cast<int>(std::floor(t_ui));
+    double v = 0.0;
+    for (int j = k - 3; j <= k + 3; ++j) {
+        if (j >= 0 && j < static_cast<int>(d.size())) {
+            double t = t_ui - j - 0.5;
+            v += d[j] * (step(t + 0.5) - step(t - 0.5));
+        }
+    }
+    return v;
+}
+
+/**
+ * @brief Samples the waveform at each trigger and publishes the value
+ *        `latency` steps later (an interpolating sampler's decision delay)
+ */
+class DelayedSampler : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<bool> trigger;
+    sca_tdf::sca_out<double> value;
+    int num_triggers;
+
+    DelayedSampler(sc_core::sc_module_name nm, int latency)
+        : sca_tdf::sca_module(nm)
+        , trigger("trigger"), value("value")
+        , num_triggers(0), m_latency(latency), m_n(0), m_held(0.0)
+    {
+        PrbsLfsr lfsr(PRBSType::PRBS7, 1);
+        m_symbols.resize(NUM_UI + 8);
+        for (double& s : m_symbols) s = lfsr.next_bit() ? 0.4 : -0.4;
+    }
+
+    void set_attributes() override {
+        trigger.set_rate(1);
+        value.set_rate(1);
+        set_timestep(UI / SPU, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        for (int& w : m_wait) --w;
+        if (trigger.read()) {
+            ++num_triggers;
+            m_wait.push_back(m_latency);
+            m_value.push_back(waveform(m_symbols, static_cast<double>(m_n) / SPU));
+        }
+        while (!m_wait.empty() && m_wait.front() <= 0) {
+            m_held = m_value.front();
+            m_wait.pop_front();
+            m_value.pop_front();
+        }
+        value.write(m_held);
+        ++m_n;
+    }
+
+private:
+    int m_latency;
+    long m_n;
+    double m_held;
+    std::vector<double> m_symbols;
+    std::deque<int> m_wait;
+    std::deque<double> m_value;
+};
+
+SC_MODULE(CdrMmTb) {
+    DelayedSampler* sampler[2];
+    RxCdrTdf* cdr[2];
+
+    sca_tdf::sca_signal<bool> sig_trigger[2];
+    sca_tdf::sca_signal<double> sig_value[2];
+    sca_tdf::sca_signal<double> sig_phase[2];
+
+    SC_CTOR(CdrMmTb) {
+        const int latency[2] = {0, 3};
+        for (int i = 0; i < 2; ++i) {
+            CdrParams params;
+            params.pd = PhaseDetectorType::MUELLER_MULLER;
+            params.ui = UI;
+            params.pi.kp = 0.01;
+            params.pi.ki = 1e-4;
+            params.pai.resolution = UI / 256;
+            params.pai.range = UI / 2;
+            params.decision_latency = latency[i];
+            std::string n = std::to_string(i);
+            sampler[i] = new DelayedSampler(("sampler" + n).c_str(), latency[i]);
+            cdr[i] = new RxCdrTdf(("cdr" + n).c_str(), params);
+            cdr[i]->sampling_trigger(sig_trigger[i]);
+            sampler[i]->trigger(sig_trigger[i]);
+            sampler[i]->value(sig_value[i]);
+            cdr[i]->in(sig_value[i]);
+            cdr[i]->phase_out(sig_phase[i]);
+        }
+    }
+};
+
+} // namespace
+
+// 波特率 MM：每个数据触发仅一次环路更新（含采样器判决延迟），并保持锁定在眼图中心附近
+TEST(CdrMmUiRateTest, OneLoopUpdatePerDataTrigger) {
+    CdrMmTb tb("tb");
+    sc_core::sc_start(NUM_UI * UI, sc_core::SC_SEC);
+
+    for (int i = 0; i < 2; ++i) {
+        int triggers = tb.sampler[i]->num_triggers;
+        EXPECT_NEAR(triggers, NUM_UI, 2) << "cdr " << i;
+        // The last trigger may still be in flight
+        EXPECT_LE(tb.cdr[i]->get_num_updates(), static_cast<unsigned long>(triggers)) << "cdr " << i;
+        EXPECT_GE(tb.cdr[i]->get_num_updates(), static_cast<unsigned long>(triggers - 1)) << "cdr " << i;
+        EXPECT_LT(std::abs(tb.cdr[i]->get_raw_phase()), 0.1 * UI) << "cdr " << i;
+    }
+
+    sc_core::sc_stop();
+}
@@ -0,0 +1,145 @@
+/**
+ * @file test_cdr_nco.cpp
+ * @brief Unit tests for the fixed-point CDR sampling clock phase accumulator
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "ams/cdr_nco.h"
+#include "ams/cdr_phase_detector.h"
+
+using namespace serdes;
+
+// 长时间运行：触发间隔恒定，无累积漂移
+TEST(CdrNcoTest, LongRunTriggerCadenceIsExact) {
+    const double ui = 100e-12;
+    CdrPhaseNco nco;
+    nco.configure(ui, ui / 10.0, 1e-12);
+
+    const std::uint64_t n_steps = 100000000ull;
+    std::uint64_t n_data = 0;
+    std::uint64_t first = 0;
+    bool aligned = true;
+    for (std::uint64_t n = 0; n < n_steps; ++n) {
+        nco.advance();
+        std::uint64_t since;
+        if (nco.crossed(CdrPhaseNco::DATA_POINT, since)) {
+            if (n_data == 0) first = n;
+            aligned = aligned && ((n - first) % 10 == 0);
+            ++n_data;
+        }
+    }
+    EXPECT_EQ(n_data, n_steps / 10);
+    EXPECT_TRUE(aligned);
+}
+
+// 相位插值码：正码延后采样 code * resolution，负码按 UI 回绕
+TEST(CdrNcoTest, CodeShiftsCrossingByResolution) {
+    const double ui = 100e-12;
+    const double ts = 6.25e-12;     // 16 samples/UI
+    CdrPhaseNco nco;
+    nco.configure(ui, ts, 1e-12);
+
+    for (std::int64_t code : {0, 3, -3, 7}) {
+        nco.reset();
+        nco.set_code(code);
+        for (int n = 0; n < 64; ++n) {
+            nco.advance();
+            std::uint64_t since;
+            if (nco.crossed(CdrPhaseNco::DATA_POINT, since)) {
+                // Crossing time of UI/2 + code*res, measured from t = 0
+                double t_ideal = ui / 2.0 + code * 1e-12;
+                while (t_ideal < 0.0) t_ideal += ui;
+                double t_step = (n + 1) * ts;
+                double t_cross = t_step - nco.to_seconds(since);
+                double err = std::fmod(t_cross - t_ideal + 10 * ui, ui);
+                EXPECT_NEAR(std::min(err, ui - err), 0.0, 1e-18);
+                EXPECT_LT(nco.to_seconds(since), ts);
+            }
+        }
+    }
+}
+
+// 时间步长等于 UI 时相位不前进（与原浮点实现一致，无触发）
+TEST(CdrNcoTest, TimestepEqualToUiNeverCrosses) {
+    CdrPhaseNco nco;
+    nco.configure(100e-12, 100e-12, 1e-12);
+    EXPECT_EQ(nco.get_increment(), 0u);
+    std::uint64_t since;
+    for (int n = 0; n < 100; ++n) {
+        nco.advance();
+        EXPECT_FALSE(nco.crossed(CdrPhaseNco::EDGE_POINT, since));
+        EXPECT_FALSE(nco.crossed(CdrPhaseNco::DATA_POINT, since));
+    }
+}
+
+// 正码延后采样：BB 闭环（RxCdrTdf 的 PI、限幅与量化）锁定到偏移的眼图中心；符号相反时环路正反馈，锁在数据跳变沿
+TEST(CdrNcoTest, ClosedLoopLocksToShiftedEyeCenter) {
+    const double ui = 100e-12;
+    const double ts = ui / 16.0;
+    const double res = ui / 256.0;
+    const double range = ui / 2.0;
+    const double skew = 0.2;        // Eye centers at (k + 1/2 + skew) UI
+    CdrPhaseNco nco;
+    nco.configure(ui, ts, res);
+    CdrPhaseDetector pd;
+    pd.configure(PhaseDetectorType::BANG_BANG, 0.0);
+
+    std::mt19937 rng(5);
+    std::vector<double> d(3000);
+    for (double& v : d) v = (rng() & 1u) ? 0.4 : -0.4;
+    auto waveform = [&](double t_ui) {
+        auto step = [](double x) { return 0.5 * (1.0 + std::erf(x / 0.2)); };
+        int k = static_cast<int>(std::floor(t_ui - skew));
+        double v = 0.0;
+        for (int j = std::max(0, k - 2); j <= k + 2 && j < static_cast<int>(d.size()); ++j) {
+            double t = t_ui - skew - j - 0.5;
+            v += d[j] * (step(t + 0.5) - step(t - 0.5));
+        }
+        return v;
+    };
+
+    double integral = 0.0;
+    double phase = 0.0;
+    double edge = 0.0;
+    for (long n = 0; n < 16L * 2900; ++n) {
+        nco.advance();
+        std::uint64_t since;
+        if (nco.crossed(CdrPhaseNco::EDGE_POINT, since)) {
+            edge = waveform(((n + 1) * ts - nco.to_seconds(since)) / ui);
+        }
+        if (!nco.crossed(CdrPhaseNco::DATA_POINT, since)) continue;
+        double e = pd.detect(edge, waveform(((n + 1) * ts - nco.to_seconds(since)) / ui));
+        integral += 5e-4 * e;
+        phase = std::max(-range, std::min(range, (0.01 * e + integral) * ui));
+        if (std::abs(phase) >= range) integral = phase / ui - 0.01 * e;
+        nco.set_code(std::llround(phase / res));
+    }
+    EXPECT_NEAR(phase / ui, skew, 0.05);
+}
+
+// 相位插值码向后跳变不会重新跨越已触发的采样点：每 UI 恰好一次触发
+TEST(CdrNcoTest, BackwardCodeStepDoesNotRefire) {
+    const double ui = 100e-12;
+    const double ts = ui / 16.0;
+    CdrPhaseNco nco;
+    nco.configure(ui, ts, ui / 256.0);
+
+    int fired = 0;
+    for (int n = 0; n < 16 * 40; ++n) {
+        nco.advance();
+        std::uint64_t since;
+        if (nco.crossed(CdrPhaseNco::DATA_POINT, since)) {
+            ++fired;
+            // Delay by half a timestep (code step back) right after each crossing
+            nco.set_code(nco.get_code() + 8);
+        }
+    }
+    // Each step back lengthens the UI by 8/256 UI: at most one trigger per UI
+    EXPECT_GT(fired, 35);
+    EXPECT_LE(fired, 40);
+}
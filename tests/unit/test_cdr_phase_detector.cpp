@@ -0,0 +1,201 @@
+/**
+ * @file test_cdr_phase_detector.cpp
+ * @brief Unit tests for the selectable CDR phase detectors (Alexander, Hogge,
+ *        Mueller-Muller) and a discrete closed-loop comparison
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "ams/cdr_nco.h"
+#include "ams/cdr_phase_detector.h"
+#include "ams/sample_interpolator.h"
+#include "common/prbs.h"
+
+using namespace serdes;
+
+namespace {
+
+// Band-limited NRZ pulse (UI = 1) centered at t = 0, with first pre/post
+// cursors large enough for a baud-rate detector to see
+double pulse(double t) {
+    auto step = [](double x) { return 0.5 * (1.0 + std::erf(x / 0.45)); };
+    return step(t + 0.5) - step(t - 0.5);
+}
+
+std::vector<double> make_symbols(size_t n) {
+    PrbsLfsr lfsr(PRBSType::PRBS15, 1);
+    std::vector<double> d(n);
+    for (auto& v : d) v = lfsr.next_bit() ? 1.0 : -1.0;
+    return d;
+}
+
+double waveform(const std::vector<double>& d, double t) {
+    int k = static_cast<int>(std::floor(t + 0.5));
+    double v = 0.0;
+    for (int j = k - 3; j <= k + 3; ++j) {
+        if (j >= 0 && j < static_cast<int>(d.size())) v += d[j] * pulse(t - j);
+    }
+    return v;
+}
+
+// Mean PD output for a fixed sampling offset (UI, positive = late)
+double mean_error(PhaseDetectorType type, double offset) {
+    std::vector<double> d = make_symbols(4000);
+    CdrPhaseDetector pd;
+    pd.configure(type, 0.0);
+    double sum = 0.0;
+    for (int k = 4; k < 3996; ++k) {
+        double t = k + offset;
+        sum += pd.detect(waveform(d, t - 0.5), waveform(d, t));
+    }
+    return sum / 3992.0;
+}
+
+// Closed loop: PI in UI units, positive phase delays sampling
+double run_loop(PhaseDetectorType type, double phase0, int n_ui) {
+    std::vector<double> d = make_symbols(n_ui + 8);
+    CdrPhaseDetector pd;
+    pd.configure(type, 0.0);
+    const double kp = 0.01, ki = 1e-4;
+    double integral = phase0, phase = phase0;
+    for (int k = 4; k < n_ui; ++k) {
+        double t = k + phase;
+        double e = pd.detect(waveform(d, t - 0.5), waveform(d, t));
+        integral += ki * e;
+        phase = std::max(-0.5, std::min(0.5, kp * e + integral));
+    }
+    return phase;
+}
+
+struct DiscreteLoopResult {
+    double decisions_per_ui;
+    double final_phase;           // UI, positive = late
+};
+
+// Discrete-time CDR loop: fixed-point NCO, cubic interpolation at the exact
+// trigger phase, PD and PI, on a waveform sampled at `spu` samples/UI
+DiscreteLoopResult run_discrete_loop(PhaseDetectorType type, int spu, int n_ui) {
+    std::vector<double> d = make_symbols(n_ui + 8);
+    // x[n] is the input at NCO time (n + 1) / spu, eye centers at NCO phase UI/2
+    std::vector<double> x(static_cast<size_t>(n_ui) * spu);
+    for (size_t n = 0; n < x.size(); ++n) {
+        x[n] = waveform(d, static_cast<double>(n + 1) / spu - 0.5);
+    }
+
+    CdrPhaseDetector pd;
+    pd.configure(type, 0.0);
+    SampleInterpolator interp;
+    interp.configure(SampleInterpKind::CUBIC);
+    CdrPhaseNco nco;
+    nco.configure(1.0, 1.0 / spu, 1.0 / 256);
+    nco.set_code(64);                 // Start 0.25 UI late
+
+    double integral = 0.25, edge = 0.0;
+    int pending = -1;                 // 0 = edge, 1 = data
+    double pending_frac = 0.0;
+    long decisions = 0;
+
+    for (size_t n = 0; n < x.size(); ++n) {
+        interp.push(x[n]);
+        if (pending >= 0) {
+            // One step later the kernel has a sample past the instant
+            double v = interp.at(1.0 + pending_frac);
+            if (pending == 0) {
+                edge = v;
+            } else {
+                double e = pd.detect(edge, v);
+                integral += 1e-4 * e;
+                double phase = std::max(-0.5, std::min(0.5, 0.01 * e + integral));
+                nco.set_code(std::llround(phase * 256));
+            }
+            ++decisions;
+            pending = -1;
+        }
+        nco.advance();
+        std::uint64_t since;
+        if (nco.crossed(CdrPhaseNco::DATA_POINT, since)) {
+            pending = 1;
+            pending_frac = nco.to_seconds(since) * spu;
+        } else if (pd.needs_edge_sample() && nco.crossed(CdrPhaseNco::EDGE_POINT, since)) {
+            pending = 0;
+            pending_frac = nco.to_seconds(since) * spu;
+        }
+    }
+
+    DiscreteLoopResult r;
+    r.decisions_per_ui = static_cast<double>(decisions) / n_ui;
+    r.final_phase = nco.get_code() / 256.0;
+    return r;
+}
+
+} // namespace
+
+// 各鉴相器对早/晚采样的输出极性一致：晚为负，早为正
+TEST(CdrPhaseDetectorTest, PolarityMatchesAcrossDetectors) {
+    for (PhaseDetectorType type : {PhaseDetectorType::BANG_BANG,
+                                   PhaseDetectorType::HOGGE,
+                                   PhaseDetectorType::MUELLER_MULLER}) {
+        EXPECT_LT(mean_error(type, +0.15), 0.0) << PhaseDetectorTypeToString(type);
+        EXPECT_GT(mean_error(type, -0.15), 0.0) << PhaseDetectorTypeToString(type);
+    }
+}
+
+// Hogge 为线性特性：误差随偏移单调增大
+TEST(CdrPhaseDetectorTest, HoggeIsProportional) {
+    double e1 = mean_error(PhaseDetectorType::HOGGE, 0.05);
+    double e2 = mean_error(PhaseDetectorType::HOGGE, 0.15);
+    EXPECT_LT(e2, e1);
+    EXPECT_LT(e1, 0.0);
+    EXPECT_GT(e2 / e1, 2.0);
+
+    // Bang-bang saturates: same magnitude for small and large offsets
+    double b1 = mean_error(PhaseDetectorType::BANG_BANG, 0.05);
+    double b2 = mean_error(PhaseDetectorType::BANG_BANG, 0.15);
+    EXPECT_NEAR(b1, b2, 0.05);
+}
+
+// 闭环锁定：从 ±0.3 UI 初始偏移收敛到眼图中心
+TEST(CdrPhaseDetectorTest, ClosedLoopLocksToEyeCenter) {
+    for (PhaseDetectorType type : {PhaseDetectorType::BANG_BANG,
+                                   PhaseDetectorType::HOGGE,
+                                   PhaseDetectorType::MUELLER_MULLER}) {
+        EXPECT_NEAR(run_loop(type, +0.3, 20000), 0.0, 0.05) << PhaseDetectorTypeToString(type);
+        EXPECT_NEAR(run_loop(type, -0.3, 20000), 0.0, 0.05) << PhaseDetectorTypeToString(type);
+    }
+}
+
+// Mueller-Muller 不需要边沿采样
+TEST(CdrPhaseDetectorTest, BaudRateDetectorSkipsEdgeSample) {
+    CdrPhaseDetector pd;
+    pd.configure(PhaseDetectorType::MUELLER_MULLER, 0.0);
+    EXPECT_FALSE(pd.needs_edge_sample());
+    // Held (repeated) sample carries no timing information
+    pd.detect(0.0, 0.8);
+    EXPECT_EQ(pd.detect(0.0, 0.8), 0.0);
+
+    pd.configure(PhaseDetectorType::HOGGE, 0.0);
+    EXPECT_TRUE(pd.needs_edge_sample());
+    EXPECT_THROW(pd.configure(PhaseDetectorType::LINEAR, 0.0), std::invalid_argument);
+}
+
+// 离散闭环对比：双采样鉴相器每 UI 两次判决；波特率 MM 每 UI 一次，且可降低过采样率
+TEST(CdrPhaseDetectorTest, DiscreteLoopDecisionRate) {
+    struct Case { PhaseDetectorType type; int spu; };
+    const Case cases[] = {
+        {PhaseDetectorType::BANG_BANG, 8},
+        {PhaseDetectorType::HOGGE, 8},
+        {PhaseDetectorType::MUELLER_MULLER, 8},
+        {PhaseDetectorType::MUELLER_MULLER, 4},
+    };
+    const int n_ui = 200000;
+
+    for (const Case& c : cases) {
+        DiscreteLoopResult r = run_discrete_loop(c.type, c.spu, n_ui);
+        double expected_decisions = (c.type == PhaseDetectorType::MUELLER_MULLER) ? 1.0 : 2.0;
+        EXPECT_NEAR(r.decisions_per_ui, expected_decisions, 0.01);
+        EXPECT_NEAR(r.final_phase, 0.0, 0.05) << PhaseDetectorTypeToString(c.type);
+    }
+}
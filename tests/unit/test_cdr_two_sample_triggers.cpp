@@ -0,0 +1,211 @@
+/**
+ * @file test_cdr_two_sample_triggers.cpp
+ * @brief RxCdrTdf with a two-sample detector fires one edge and one data
+ *        trigger per UI, updates its loop once per UI and locks
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <cmath>
+#include <deque>
+#include <string>
+#include <vector>
+#include "ams/rx_cdr.h"
+#include "common/parameters.h"
+#include "common/prbs.h"
+
+using namespace serdes;
+
+namespace {
+
+const double DT = 100e-12 / 16;
+const double SPU[] = {16.0, 15.0, 8.0, 7.0};
+const int NUM_SPU = 4;
+const int NUM_UI = 3000;                  // At 16 samples per UI
+const double SHIFT = 0.2;                 // Eye centers at (k + 1/2 + SHIFT) UI
+const int LATENCY = 2;
+
+// Band-limited NRZ, transitions at (k + SHIFT) UI
+double waveform(const std::vector<double>& d, double t_ui) {
+    auto step = [](double x) { return 0.5 * (1.0 + std::erf(x / 0.45)); };
+    t_ui -= SHIFT;
+    int k = static_cast<int>(std::floor(t_ui));
+    double v = 0.0;
+    for (int j = k - 3; j <= k + 3; ++j) {
+        if (j >= 0 && j < static_cast<int>(d.size())) {
+            double t = t_ui - j - 0.5;
+            v += d[j] * (step(t + 0.5) - step(t - 0.5));
+        }
+    }
+    return v;
+}
+
+/**
+ * @brief Samples the waveform at each trigger and publishes the sample
+ *        LATENCY steps later: the voltage, or the 0/1 decision in `bits`
+ *        mode. Records where the triggers land relative to the eye center.
+ */
+class DelayedSampler : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<bool> trigger;
+    sca_tdf::sca_out<double> value;
+    int num_triggers;
+    double center_sum;                    // Sum of trigger offsets from the eye center (UI)
+    double center_abs_sum;                // Sum of their magnitudes
+    int center_count;                     // Triggers in the second half of the run
+
+    DelayedSampler(sc_core::sc_module_name nm, double spu, bool bits)
+        : sca_tdf::sca_module(nm)
+        , trigger("trigger"), value("value")
+        , num_triggers(0), center_sum(0.0), center_abs_sum(0.0), center_count(0)
+        , m_spu(spu), m_bits(bits), m_n(0), m_held(0.0)
+    {
+        PrbsLfsr lfsr(PRBSType::PRBS7, 1);
+        m_symbols.resize(3 * NUM_UI);
+        for (double& s : m_symbols) s = lfsr.next_bit() ? 0.4 : -0.4;
+    }
+
+    void set_attributes() override {
+        trigger.set_rate(1);
+        value.set_rate(1);
+        set_timestep(DT, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        for (int& w : m_wait) --w;
+        if (trigger.read()) {
+            double t_ui = static_cast<double>(m_n) / m_spu;
+            double v = waveform(m_symbols, t_ui);
+            ++num_triggers;
+            m_wait.push_back(LATENCY);
+            m_value.push_back(m_bits ? (v > 0.0 ? 1.0 : 0.0) : v);
+            if (m_n > NUM_UI * 8) {
+                double off = t_ui - 0.5 - SHIFT;
+                off -= std::floor(off + 0.5);
+                center_sum += off;
+                center_abs_sum += std::abs(off);
+                ++center_count;
+            }
+        }
+        while (!m_wait.empty() && m_wait.front() <= 0) {
+            m_held = m_value.front();
+            m_wait.pop_front();
+            m_value.pop_front();
+        }
+        value.write(m_held);
+        ++m_n;
+    }
+
+    double mean_center_offset() const {
+        return center_count > 0 ? center_sum / center_count : 1.0;
+    }
+    double mean_center_distance() const {
+        return center_count > 0 ? center_abs_sum / center_count : 0.0;
+    }
+
+private:
+    double m_spu;
+    bool m_bits;
+    long m_n;
+    double m_held;
+    std::vector<double> m_symbols;
+    std::deque<int> m_wait;
+    std::deque<double> m_value;
+};
+
+CdrParams loop_params(PhaseDetectorType pd, double spu) {
+    CdrParams params;
+    params.pd = pd;
+    params.ui = spu * DT;
+    params.pi.kp = 0.01;
+    params.pi.ki = 1e-3;
+    params.pai.resolution = params.ui / 256;
+    params.pai.range = params.ui / 2;
+    params.decision_latency = LATENCY;
+    return params;
+}
+
+const PhaseDetectorType PD[] = {PhaseDetectorType::BANG_BANG, PhaseDetectorType::HOGGE};
+const int NUM_PD = 2;
+const int NUM_CASES = NUM_PD * NUM_SPU;
+
+/**
+ * @brief Per detector and samples-per-UI: CDR with separate edge / data
+ *        samplers (edge_strobe), and CDR with one sampler on both triggers
+ */
+SC_MODULE(CdrTwoSampleTb) {
+    RxCdrTdf* cdr[NUM_CASES];
+    DelayedSampler* edge_sampler[NUM_CASES];
+    DelayedSampler* data_sampler[NUM_CASES];
+    RxCdrTdf* shared_cdr[NUM_CASES];
+    DelayedSampler* shared_sampler[NUM_CASES];
+
+    sca_tdf::sca_signal<bool> sig_edge_trigger[NUM_CASES], sig_data_trigger[NUM_CASES];
+    sca_tdf::sca_signal<double> sig_edge[NUM_CASES], sig_data[NUM_CASES], sig_phase[NUM_CASES];
+    sca_tdf::sca_signal<bool> sig_shared_trigger[NUM_CASES];
+    sca_tdf::sca_signal<double> sig_shared[NUM_CASES], sig_shared_phase[NUM_CASES];
+
+    SC_CTOR(CdrTwoSampleTb) {
+        for (int i = 0; i < NUM_CASES; ++i) {
+            PhaseDetectorType pd = PD[i / NUM_SPU];
+            double spu = SPU[i % NUM_SPU];
+            bool bits = (pd == PhaseDetectorType::BANG_BANG);
+            std::string n = std::to_string(i);
+            CdrParams params = loop_params(pd, spu);
+            params.edge_strobe = true;
+            cdr[i] = new RxCdrTdf(("cdr" + n).c_str(), params);
+            edge_sampler[i] = new DelayedSampler(("edge_sampler" + n).c_str(), spu, bits);
+            data_sampler[i] = new DelayedSampler(("data_sampler" + n).c_str(), spu, bits);
+            cdr[i]->sampling_trigger(sig_data_trigger[i]);
+            cdr[i]->edge_trigger[0](sig_edge_trigger[i]);
+            data_sampler[i]->trigger(sig_data_trigger[i]);
+            data_sampler[i]->value(sig_data[i]);
+            edge_sampler[i]->trigger(sig_edge_trigger[i]);
+            edge_sampler[i]->value(sig_edge[i]);
+            cdr[i]->in(sig_data[i]);
+            cdr[i]->edge_in[0](sig_edge[i]);
+            cdr[i]->phase_out(sig_phase[i]);
+
+            shared_cdr[i] = new RxCdrTdf(("shared_cdr" + n).c_str(), loop_params(pd, spu));
+            shared_sampler[i] = new DelayedSampler(("shared_sampler" + n).c_str(), spu, bits);
+            shared_cdr[i]->sampling_trigger(sig_shared_trigger[i]);
+            shared_sampler[i]->trigger(sig_shared_trigger[i]);
+            shared_sampler[i]->value(sig_shared[i]);
+            shared_cdr[i]->in(sig_shared[i]);
+            shared_cdr[i]->phase_out(sig_shared_phase[i]);
+        }
+    }
+};
+
+} // namespace
+
+// Alexander / Hogge 鉴相：每 UI 各一次边沿和数据触发、一次环路更新，锁定后数据触发位于眼图中心
+TEST(CdrTwoSampleTriggerTest, EdgeAndDataOncePerUi) {
+    CdrTwoSampleTb tb("tb");
+    const double sim_time = NUM_UI * SPU[0] * DT;
+    sc_core::sc_start(sim_time, sc_core::SC_SEC);
+
+    for (int i = 0; i < NUM_CASES; ++i) {
+        const double uis = sim_time / (SPU[i % NUM_SPU] * DT);
+        const std::string tag = (i < NUM_SPU ? "BANG_BANG spu " : "HOGGE spu ") +
+                                std::to_string(SPU[i % NUM_SPU]);
+        // One edge and one data trigger per UI, one loop update per data
+        // trigger (the last ones may still be in flight)
+        int edges = tb.edge_sampler[i]->num_triggers;
+        int data = tb.data_sampler[i]->num_triggers;
+        EXPECT_NEAR(edges, uis, 2) << tag;
+        EXPECT_NEAR(data, uis, 2) << tag;
+        EXPECT_LE(tb.cdr[i]->get_num_updates(), static_cast<unsigned long>(data)) << tag;
+        EXPECT_GE(tb.cdr[i]->get_num_updates(), static_cast<unsigned long>(data - 1)) << tag;
+        // Locked: data triggers at the eye center, edge triggers half a UI off
+        EXPECT_LT(std::abs(tb.data_sampler[i]->mean_center_offset()), 0.1) << tag;
+        EXPECT_GT(tb.edge_sampler[i]->mean_center_distance(), 0.4) << tag;
+
+        // Shared trigger port: both triggers on it, still one update per UI
+        int shared = tb.shared_sampler[i]->num_triggers;
+        EXPECT_NEAR(shared, 2 * uis, 3) << tag;
+        EXPECT_NEAR(static_cast<double>(tb.shared_cdr[i]->get_num_updates()), uis, 2) << tag;
+    }
+
+    sc_core::sc_stop();
+}
@@ -0,0 +1,325 @@
+/**
+ * @file test_channel_sparam_precision.cpp
+ * @brief Unit tests for the channel state-space kernel precision policies
+ *
+ * Tests verify the trapezoidal discretization against the analytic step
+ * response, bound the FLOAT/MIXED error relative to the double path and
+ * check the channel's lockstep validation against its sca_ss output.
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <unistd.h>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ams/channel_sparam.h"
+#include "ams/state_space_kernel.h"
+#include "common/prbs.h"
+#include "../third_party/json.hpp"
+
+namespace serdes {
+namespace test {
+
+/**
+ * Pole-residue style SISO model: diagonal A with real poles
+ */
+class ChannelPrecisionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const double poles_hz[] = {3e9, 8e9, 15e9, 25e9, 40e9, 60e9};
+        const double residues[] = {0.15, 0.10, 0.08, 0.05, 0.03, 0.02};
+        n_ = 6;
+        A_.assign(n_ * n_, 0.0);
+        B_.assign(n_, 1.0);
+        C_.assign(n_, 0.0);
+        D_ = {0.0};
+        dc_gain_ = 0.0;
+        for (int i = 0; i < n_; ++i) {
+            double p = -2.0 * M_PI * poles_hz[i];
+            A_[i * n_ + i] = p;
+            C_[i] = -p * residues[i];
+            dc_gain_ += residues[i];
+        }
+        dt_ = 1.5625e-12;  // 64 samples per UI at 10 Gbps
+        ASSERT_TRUE(discretize_trapezoidal(A_, B_, C_, D_, n_, 1, 1, dt_, dss_));
+    }
+
+    int n_;
+    std::vector<double> A_, B_, C_, D_;
+    double dc_gain_;
+    double dt_;
+    DiscreteStateSpace dss_;
+};
+
+TEST_F(ChannelPrecisionTest, StepResponseSettlesToDcGain) {
+    StateSpaceStepper<double, double> kernel;
+    kernel.configure(dss_);
+
+    double u = 1.0;
+    double y = 0.0;
+    for (int i = 0; i < 20000; ++i) {
+        kernel.step(&u, &y);
+    }
+    EXPECT_NEAR(y, dc_gain_, 1e-9);
+}
+
+TEST_F(ChannelPrecisionTest, DoublePolicyIsExact) {
+    PrecisionReport rep = check_precision(dss_, ChannelPrecision::DOUBLE, 4096, 64);
+    EXPECT_EQ(rep.n_samples, 4096);
+    EXPECT_DOUBLE_EQ(rep.max_abs_error, 0.0);
+    EXPECT_GT(rep.peak_output, 0.1);
+}
+
+TEST_F(ChannelPrecisionTest, ReducedPrecisionWithinTolerance) {
+    PrecisionReport mixed = check_precision(dss_, ChannelPrecision::MIXED, 16384, 64);
+    PrecisionReport flt = check_precision(dss_, ChannelPrecision::FLOAT, 16384, 64);
+
+    EXPECT_LT(mixed.rel_error, 1e-4);
+    EXPECT_LT(flt.rel_error, 1e-3);
+    EXPECT_LE(mixed.max_abs_error, flt.max_abs_error * 1.5);
+}
+
+TEST_F(ChannelPrecisionTest, FrequencyResponseMatchesPoleResidueForm) {
+    // Dense but similar model: A' = Q A Q', B' = Q B, C' = C Q' with Q a
+    // product of Givens rotations, so the Hessenberg reduction has work to do
+    std::vector<double> Q(n_ * n_, 0.0);
+    for (int i = 0; i < n_; ++i) Q[i * n_ + i] = 1.0;
+    for (int k = 0; k + 1 < n_; ++k) {
+        double th = 0.3 + 0.2 * k;
+        double cs = std::cos(th), sn = std::sin(th);
+        for (int j = 0; j < n_; ++j) {
+            double a = Q[k * n_ + j], b = Q[(k + 1) * n_ + j];
+            Q[k * n_ + j] = cs * a - sn * b;
+            Q[(k + 1) * n_ + j] = sn * a + cs * b;
+        }
+    }
+    std::vector<double> A(n_ * n_, 0.0), B(n_, 0.0), C(n_, 0.0);
+    for (int i = 0; i < n_; ++i) {
+        for (int j = 0; j < n_; ++j) {
+            for (int k = 0; k < n_; ++k) {
+                A[i * n_ + j] += Q[i * n_ + k] * A_[k * n_ + k] * Q[j * n_ + k];
+            }
+            B[i] += Q[i * n_ + j] * B_[j];
+            C[i] += C_[j] * Q[i * n_ + j];
+        }
+    }
+
+    std::vector<double> freqs = {0.0, 1e9, 5e9, 20e9, 80e9};
+    std::vector<std::complex<double>> h =
+        state_space_frequency_response(A, B, C, D_, n_, 1, 1, 0, 0, freqs);
+    ASSERT_EQ(h.size(), freqs.size());
+    for (size_t f = 0; f < freqs.size(); ++f) {
+        std::complex<double> s(0.0, 2.0 * M_PI * freqs[f]);
+        std::complex<double> ref = D_[0];
+        for (int i = 0; i < n_; ++i) {
+            ref += C_[i] * B_[i] / (s - A_[i * n_ + i]);
+        }
+        EXPECT_NEAR(h[f].real(), ref.real(), 1e-12);
+        EXPECT_NEAR(h[f].imag(), ref.imag(), 1e-12);
+    }
+    EXPECT_NEAR(h[0].real(), dc_gain_, 1e-12);
+    EXPECT_THROW(state_space_frequency_response(A, B, C, D_, n_, 1, 1, 1, 0, freqs),
+                 std::invalid_argument);
+}
+
+TEST_F(ChannelPrecisionTest, KernelAppliesDerivativeTerm) {
+    const std::vector<double> E = {2e-14};
+    DiscreteStateSpace with_e;
+    ASSERT_TRUE(discretize_trapezoidal(A_, B_, C_, D_, E, n_, 1, 1, dt_, with_e));
+    ASSERT_EQ(with_e.Eh.size(), 1u);
+    DiscreteStateSpace zero_e;
+    ASSERT_TRUE(discretize_trapezoidal(A_, B_, C_, D_, {0.0}, n_, 1, 1, dt_, zero_e));
+    EXPECT_TRUE(zero_e.Eh.empty());
+
+    StateSpaceStepper<double, double> ref, dut;
+    ref.configure(dss_);
+    dut.configure(with_e);
+    const double u[] = {0.0, 1.0, 1.0, -1.0, -1.0};
+    for (int n = 0; n < 5; ++n) {
+        double y_ref = 0.0, y = 0.0;
+        ref.step(&u[n], &y_ref);
+        dut.step(&u[n], &y);
+        double du = u[n] - (n > 0 ? u[n - 1] : 0.0);
+        EXPECT_NEAR(y - y_ref, E[0] / dt_ * du, 1e-12) << "step " << n;
+    }
+}
+
+namespace {
+
+/**
+ * @brief NRZ PRBS7 at 64 samples per UI, recorded for offline references
+ */
+class PrbsNrzSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out;
+    std::vector<double> samples;
+
+    PrbsNrzSource(sc_core::sc_module_name nm, double dt)
+        : sca_tdf::sca_module(nm), out("out"), m_prbs(PRBSType::PRBS7), m_dt(dt), m_n(0), m_v(0.0) {}
+
+    void set_attributes() override {
+        out.set_rate(1);
+        set_timestep(m_dt, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        if (m_n++ % 64 == 0) {
+            m_v = m_prbs.next_bit() ? 1.0 : -1.0;
+        }
+        samples.push_back(m_v);
+        out.write(m_v);
+    }
+
+private:
+    PrbsLfsr m_prbs;
+    double m_dt;
+    long m_n;
+    double m_v;
+};
+
+class ChannelRecorder : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<double> in;
+    std::vector<double> samples;
+
+    ChannelRecorder(sc_core::sc_module_name nm) : sca_tdf::sca_module(nm), in("in") {}
+
+    void set_attributes() override { in.set_rate(1); }
+    void processing() override { samples.push_back(in.read()); }
+};
+
+const int CHECK_SAMPLES = 4096;
+const int NUM_CHANNELS = 5;
+
+// Same source into DOUBLE, FLOAT and FLOAT with an unreachable tolerance,
+// then DOUBLE and FLOAT with apply_e_matrix
+SC_MODULE(PrecisionCheckTb) {
+    PrbsNrzSource* src;
+    ChannelSParamTdf* channel[NUM_CHANNELS];
+    ChannelRecorder* rec[NUM_CHANNELS];
+
+    sca_tdf::sca_signal<double> sig_in;
+    sca_tdf::sca_signal<double> sig_out[NUM_CHANNELS];
+
+    PrecisionCheckTb(sc_core::sc_module_name nm, const std::string& config, double dt)
+        : sc_core::sc_module(nm) {
+        src = new PrbsNrzSource("src", dt);
+        src->out(sig_in);
+        const ChannelPrecision precision[NUM_CHANNELS] = {
+            ChannelPrecision::DOUBLE, ChannelPrecision::FLOAT, ChannelPrecision::FLOAT,
+            ChannelPrecision::DOUBLE, ChannelPrecision::FLOAT};
+        const double tolerance[NUM_CHANNELS] = {1e-3, 1e-3, 1e-12, 1e-3, 1e-3};
+        const bool apply_e[NUM_CHANNELS] = {false, false, false, true, true};
+        for (int k = 0; k < NUM_CHANNELS; ++k) {
+            ChannelExtendedParams ext;
+            ext.method = ChannelMethod::STATE_SPACE;
+            ext.config_file = config;
+            ext.precision = precision[k];
+            ext.apply_e_matrix = apply_e[k];
+            ext.precision_check_samples = CHECK_SAMPLES;
+            ext.precision_tolerance = tolerance[k];
+            std::string n = std::to_string(k);
+            channel[k] = new ChannelSParamTdf(("channel" + n).c_str(), ChannelParams(), ext);
+            rec[k] = new ChannelRecorder(("rec" + n).c_str());
+            channel[k]->in[0](sig_in);
+            channel[k]->out[0](sig_out[k]);
+            rec[k]->in(sig_out[k]);
+        }
+    }
+};
+
+// The FLOAT output of a checked channel: the sca_ss output during the
+// check, then the kernel's within tolerance
+void expect_checked_float(const ChannelSParamTdf& channel, const std::vector<double>& y_float,
+                          const std::vector<double>& y_double, double peak) {
+    const PrecisionReport& rep = channel.get_precision_report();
+    EXPECT_EQ(channel.get_precision(), ChannelPrecision::FLOAT);
+    EXPECT_EQ(rep.n_samples, CHECK_SAMPLES);
+    EXPECT_GT(rep.rel_error, 0.0);
+    EXPECT_LT(rep.rel_error, 1e-3);
+    bool kernel_used = false;
+    for (size_t i = 0; i < y_float.size(); ++i) {
+        if (i < static_cast<size_t>(CHECK_SAMPLES)) {
+            EXPECT_EQ(y_float[i], y_double[i]) << "sample " << i;
+        } else {
+            EXPECT_NEAR(y_float[i], y_double[i], 1e-3 * peak) << "sample " << i;
+            kernel_used = kernel_used || y_float[i] != y_double[i];
+        }
+    }
+    EXPECT_TRUE(kernel_used);
+}
+
+} // namespace
+
+// 降精度核与 sca_ss 路径逐样本锁步比较，超出容差时保持 DOUBLE；E 项仅在 apply_e_matrix 时加入
+TEST_F(ChannelPrecisionTest, ChannelChecksKernelAgainstScaSs) {
+    const double E = 5e-14;
+    nlohmann::json ss;
+    for (int i = 0; i < n_; ++i) {
+        std::vector<double> row(A_.begin() + i * n_, A_.begin() + (i + 1) * n_);
+        ss["A"].push_back(row);
+        ss["B"].push_back(std::vector<double>{B_[i]});
+    }
+    ss["C"].push_back(C_);
+    ss["D"].push_back(D_);
+    ss["E"].push_back(std::vector<double>{E});
+    nlohmann::json config;
+    config["method"] = "state_space";
+    config["full_model"]["n_diff_ports"] = 1;
+    config["full_model"]["n_outputs"] = 1;
+    config["full_model"]["n_states"] = n_;
+    config["full_model"]["state_space"] = ss;
+    const std::string path = "channel_precision_" + std::to_string(getpid()) + ".json";
+    {
+        std::ofstream f(path);
+        f << config.dump();
+    }
+
+    PrecisionCheckTb tb("tb", path, dt_);
+    sc_core::sc_start(3 * CHECK_SAMPLES * dt_, sc_core::SC_SEC);
+    std::remove(path.c_str());
+
+    const std::vector<double>& u = tb.src->samples;
+    const std::vector<double>& y_double = tb.rec[0]->samples;
+    const std::vector<double>& y_double_e = tb.rec[3]->samples;
+    ASSERT_GT(y_double.size(), static_cast<size_t>(2 * CHECK_SAMPLES));
+    for (int k = 1; k < NUM_CHANNELS; ++k) {
+        ASSERT_EQ(tb.rec[k]->samples.size(), y_double.size()) << "channel " << k;
+    }
+
+    // Default DOUBLE is C*x + D*u; apply_e_matrix adds exactly E*du/dt
+    StateSpaceStepper<double, double> ref;
+    ref.configure(dss_);
+    ref.prime(&u[0]);
+    double max_err = 0.0, max_e_err = 0.0, peak = 0.0;
+    for (size_t i = 0; i < y_double.size(); ++i) {
+        double y_ref = 0.0;
+        ref.step(&u[i], &y_ref);
+        double du = u[i] - u[i > 0 ? i - 1 : 0];
+        max_err = std::max(max_err, std::abs(y_double[i] - y_ref));
+        max_e_err = std::max(max_e_err, std::abs(y_double_e[i] - y_double[i] - E / dt_ * du));
+        peak = std::max(peak, std::abs(y_ref));
+    }
+    EXPECT_LT(max_err, 1e-6 * peak);
+    EXPECT_LT(max_e_err, 1e-9 * peak);
+
+    // FLOAT is checked against the matching sca_ss output
+    expect_checked_float(*tb.channel[1], tb.rec[1]->samples, y_double, peak);
+    expect_checked_float(*tb.channel[4], tb.rec[4]->samples, y_double_e, peak);
+
+    // Out of tolerance: the channel stays on the sca_ss path
+    EXPECT_EQ(tb.channel[2]->get_precision(), ChannelPrecision::DOUBLE);
+    EXPECT_GT(tb.channel[2]->get_precision_report().rel_error, 1e-12);
+    EXPECT_EQ(tb.rec[2]->samples, y_double);
+
+    sc_core::sc_stop();
+}
+
+} // namespace test
+} // namespace serdes
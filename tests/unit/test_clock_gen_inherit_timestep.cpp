@@ -0,0 +1,101 @@
+/**
+ * @file test_clock_gen_inherit_timestep.cpp
+ * @brief Unit test for ClockGenerationTdf module - Inherited Timestep and
+ *        Edge Timestamp Output
+ */
+
+#include "clock_generation_test_common.h"
+
+using namespace serdes;
+using namespace serdes::test;
+
+static bool time_resolution_set = []() {
+    sc_core::sc_set_time_resolution(1, sc_core::SC_FS);
+    return true;
+}();
+
+namespace {
+
+// Data-path stand-in: sets the cluster timestep and records phase and edges
+class DataRateMonitor : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<double> phase_in;
+    sca_tdf::sca_in<double> edge_in;
+
+    std::vector<double> m_phase;
+    std::vector<double> m_edges;
+    double m_timestep;
+
+    DataRateMonitor(sc_core::sc_module_name nm, double timestep)
+        : sca_tdf::sca_module(nm)
+        , phase_in("phase_in")
+        , edge_in("edge_in")
+        , m_timestep(timestep)
+    {}
+
+    void set_attributes() {
+        phase_in.set_rate(1);
+        edge_in.set_rate(1);
+        phase_in.set_timestep(m_timestep, sc_core::SC_SEC);
+    }
+
+    void processing() {
+        m_phase.push_back(phase_in.read());
+        if (edge_in.read() >= 0.0) {
+            m_edges.push_back(edge_in.read());
+        }
+    }
+};
+
+} // namespace
+
+// 继承数据通路时间步长：相位增量由实际步长决定，边沿时刻落在理想边沿上
+TEST(ClockGenerationTimestepTest, InheritsClusterTimestep) {
+    (void)time_resolution_set;
+
+    ClockParams params;
+    params.type = ClockType::IDEAL;
+    params.frequency = 10e9;
+    params.samples_per_period = 0;
+    params.edge_output = true;
+
+    // Data path sampled at 3 ps: 33.3 samples per clock period
+    const double ts = 3e-12;
+
+    ClockGenerationTdf* clk = new ClockGenerationTdf("clk_gen", params);
+    DataRateMonitor* mon = new DataRateMonitor("monitor", ts);
+    sca_tdf::sca_signal<double> sig_phase("sig_phase");
+    sca_tdf::sca_signal<double> sig_edge("sig_edge");
+    clk->clk_phase(sig_phase);
+    clk->clk_edge[0](sig_edge);
+    mon->phase_in(sig_phase);
+    mon->edge_in(sig_edge);
+
+    sc_core::sc_start(20.0 / params.frequency, sc_core::SC_SEC);
+
+    EXPECT_NEAR(clk->get_expected_timestep(), ts, 1e-18);
+    EXPECT_NEAR(clk->get_phase_increment(), 2.0 * M_PI * params.frequency * ts, 1e-12);
+
+    ASSERT_GT(mon->m_phase.size(), 2u);
+    for (size_t i = 1; i < mon->m_phase.size(); ++i) {
+        double delta = mon->m_phase[i] - mon->m_phase[i - 1];
+        if (delta < -M_PI) delta += 2.0 * M_PI;
+        EXPECT_NEAR(delta, clk->get_phase_increment(), 1e-9);
+    }
+
+    // One edge per clock period at k / f, including t = 0
+    ASSERT_GE(mon->m_edges.size(), 19u);
+    for (size_t k = 0; k < mon->m_edges.size(); ++k) {
+        EXPECT_NEAR(mon->m_edges[k], k / params.frequency, 1e-14) << "edge " << k;
+    }
+
+    sc_core::sc_stop();
+}
+
+// 非法 samples_per_period
+TEST(ClockGenerationTimestepTest, RejectsNegativeSamplesPerPeriod) {
+    ClockParams params;
+    params.type = ClockType::IDEAL;
+    params.samples_per_period = -1;
+    EXPECT_THROW(ClockGenerationTdf("clk_bad", params), std::invalid_argument);
+}
@@ -0,0 +1,192 @@
+/**
+ * @file test_com_analysis.cpp
+ * @brief Unit tests for the COM (channel operating margin) calculator
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "ams/com_analysis.h"
+#include "ams/eq_seed.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 1e-10;
+const int SPU = 32;
+
+// 与 nrz_link_tb 默认配置一致的线性链路
+struct LinkSetup {
+    TxParams tx;
+    RxParams rx;
+    AdaptionParams adaption;
+
+    LinkSetup() {
+        tx.ffe.taps = {1.0};
+        tx.driver.dc_gain = 1.0;
+        tx.driver.vswing = 0.8;
+        tx.driver.poles = {25e9};
+        tx.driver.sat_mode = "soft";
+        tx.driver.vlin = 0.5;
+        rx.ctle.zeros = {1e9};
+        rx.ctle.poles = {3e9, 15e9};
+        rx.ctle.dc_gain = 1.0;
+        rx.vga.zeros = {};
+        rx.vga.poles = {20e9};
+        rx.vga.dc_gain = 1.0;
+        rx.dfe_summer.vtap = 1.0;
+        adaption.dfe.num_taps = 3;
+        adaption.dfe.tap_min = -0.5;
+        adaption.dfe.tap_max = 0.5;
+    }
+};
+
+// SIMPLE 信道的连续时间响应
+std::vector<std::complex<double>> simple_channel(const std::vector<double>& freqs,
+                                                 double attenuation_db, double bandwidth_hz) {
+    std::vector<std::complex<double>> h(freqs.size());
+    double a = std::pow(10.0, -attenuation_db / 20.0);
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        h[i] = a / std::complex<double>(1.0, freqs[i] / bandwidth_hz);
+    }
+    return h;
+}
+
+} // namespace
+
+// 频域脉冲响应与时域级联（link_pulse_response）一致
+TEST(ComAnalysisTest, PulseMatchesTimeDomainCascade) {
+    LinkSetup s;
+    ComParams p;
+    ComAnalyzer com(p, s.tx, s.rx, s.adaption, UI, SPU);
+    ASSERT_EQ(com.get_num_ctle(), 1);
+    std::vector<double> pulse = com.pulse_response(simple_channel(com.get_frequencies(), 10.0, 8e9), 0);
+
+    ChannelParams ch;
+    ch.attenuation_db = 10.0;
+    ch.bandwidth_hz = 8e9;
+    std::vector<double> ref = link_pulse_response(s.tx, ch, s.rx, UI / SPU, SPU, 32);
+    double peak = *std::max_element(ref.begin(), ref.end());
+    for (size_t n = 0; n < ref.size(); ++n) {
+        EXPECT_NEAR(pulse[n], ref[n], 0.03 * peak) << "sample " << n;
+    }
+}
+
+// 无 ISI、仅 TX 噪声时 COM = SNR_TX - 20log10(Q^-1(DER))
+TEST(ComAnalysisTest, GaussianOnlyMatchesClosedForm) {
+    LinkSetup s;
+    s.tx.driver.poles.clear();
+    s.tx.driver.sat_mode = "none";
+    s.rx.ctle.zeros.clear();
+    s.rx.ctle.poles.clear();
+    s.rx.vga.poles.clear();
+    s.adaption.dfe.num_taps = 0;
+    ComParams p;
+    p.eta0 = 0.0;
+    p.rj = 0.0;
+    p.dj = 0.0;
+    ComAnalyzer com(p, s.tx, s.rx, s.adaption, UI, SPU);
+    std::vector<std::complex<double>> flat(com.get_frequencies().size(), 1.0);
+    ComResult r = com.evaluate(flat);
+    EXPECT_NEAR(r.signal, 2.0, 1e-9);
+    EXPECT_NEAR(r.com_db, p.snr_tx - 20.0 * std::log10(7.0345), 0.05);
+}
+
+// 搜索结果为表中最大值，且与线程数无关
+TEST(ComAnalysisTest, SearchIsDeterministicAcrossThreads) {
+    LinkSetup s;
+    ComParams p;
+    p.ffe_presets = {{1.0}, {0.9, -0.1}, {0.8, -0.2}, {-0.05, 0.75, -0.2}};
+    p.ctle_dc_gains = {1.0, 0.7, 0.5, 0.35, 0.25};
+    p.ctle_zeros = {1e9, 2e9};
+    p.num_threads = 1;
+    ComAnalyzer serial(p, s.tx, s.rx, s.adaption, UI, SPU);
+    p.num_threads = 4;
+    ComAnalyzer parallel(p, s.tx, s.rx, s.adaption, UI, SPU);
+    ASSERT_EQ(serial.get_num_ctle(), 10);
+    ASSERT_EQ(serial.get_num_ffe(), 4);
+
+    std::vector<std::complex<double>> h = simple_channel(serial.get_frequencies(), 20.0, 3e9);
+    ComResult a = serial.evaluate(h);
+    ComResult b = parallel.evaluate(h);
+    ASSERT_EQ(a.com_table.size(), 40u);
+    EXPECT_EQ(a.com_table, b.com_table);
+    for (double c : a.com_table) {
+        EXPECT_LE(c, a.com_db);
+    }
+    EXPECT_EQ(a.com_table[a.ctle_index * 4 + a.ffe_index], a.com_db);
+    EXPECT_EQ(a.ffe_taps, p.ffe_presets[a.ffe_index]);
+    EXPECT_DOUBLE_EQ(a.ctle.dc_gain, p.ctle_dc_gains[a.ctle_index % 5]);
+    EXPECT_GT(a.com_db, a.com_table[0]);     // Equalization beats the plain setting
+}
+
+// 信道损耗与噪声增大时 COM 下降
+TEST(ComAnalysisTest, MarginDropsWithLossAndNoise) {
+    LinkSetup s;
+    ComParams p;
+    ComAnalyzer com(p, s.tx, s.rx, s.adaption, UI, SPU);
+    double short_ch = com.evaluate(simple_channel(com.get_frequencies(), 3.0, 15e9)).com_db;
+    double long_ch = com.evaluate(simple_channel(com.get_frequencies(), 20.0, 3e9)).com_db;
+    EXPECT_GT(short_ch, long_ch);
+
+    p.eta0 *= 100.0;
+    ComAnalyzer noisy(p, s.tx, s.rx, s.adaption, UI, SPU);
+    EXPECT_LT(noisy.evaluate(simple_channel(com.get_frequencies(), 3.0, 15e9)).com_db, short_ch);
+}
+
+// DFE 抽头受 tap_min/tap_max 限制，限制越紧 COM 越低
+TEST(ComAnalysisTest, DfeTapLimitsAreApplied) {
+    LinkSetup s;
+    ComParams p;
+    ComAnalyzer wide(p, s.tx, s.rx, s.adaption, UI, SPU);
+    std::vector<std::complex<double>> h = simple_channel(wide.get_frequencies(), 20.0, 3e9);
+    ComResult rw = wide.evaluate(h);
+    ASSERT_EQ(rw.dfe_taps.size(), 3u);
+    EXPECT_GT(std::fabs(rw.dfe_taps[0]), 0.002);
+
+    s.adaption.dfe.tap_min = -0.002;
+    s.adaption.dfe.tap_max = 0.002;
+    ComAnalyzer tight(p, s.tx, s.rx, s.adaption, UI, SPU);
+    ComResult rt = tight.evaluate(h);
+    for (double c : rt.dfe_taps) {
+        EXPECT_LE(std::fabs(c), 0.002);
+    }
+    EXPECT_DOUBLE_EQ(std::fabs(rt.dfe_taps[0]), 0.002);
+    EXPECT_LT(rt.com_db, rw.com_db);
+}
+
+// 非法参数与频点数不匹配
+TEST(ComAnalysisTest, RejectsInvalidInput) {
+    LinkSetup s;
+    ComParams p;
+    p.target_der = 0.0;
+    EXPECT_THROW(ComAnalyzer(p, s.tx, s.rx, s.adaption, UI, SPU), std::invalid_argument);
+    p = ComParams();
+    p.ffe_presets = {{}};
+    EXPECT_THROW(ComAnalyzer(p, s.tx, s.rx, s.adaption, UI, SPU), std::invalid_argument);
+    p = ComParams();
+    EXPECT_THROW(ComAnalyzer(p, s.tx, s.rx, s.adaption, UI, 1), std::invalid_argument);
+    ComAnalyzer com(p, s.tx, s.rx, s.adaption, UI, SPU);
+    std::vector<std::complex<double>> h(com.get_frequencies().size() - 1, 1.0);
+    EXPECT_THROW(com.evaluate(h), std::invalid_argument);
+}
+
+// 工作线程中的异常在 join 后重新抛出，而不是终止进程
+TEST(ComAnalysisTest, WorkerExceptionIsRethrown) {
+    LinkSetup s;
+    ComParams p;
+    p.ctle_dc_gains = {1.0, 0.7, 0.5, 0.35};
+    p.num_threads = 4;
+    ComAnalyzer com(p, s.tx, s.rx, s.adaption, UI, SPU);
+    std::vector<std::complex<double>> h = simple_channel(com.get_frequencies(), 20.0, 3e9);
+    h[3] = std::complex<double>(std::numeric_limits<double>::quiet_NaN(), 0.0);
+    EXPECT_THROW(com.evaluate(h), std::invalid_argument);
+    // The analyzer is still usable afterwards
+    h = simple_channel(com.get_frequencies(), 20.0, 3e9);
+    EXPECT_GT(com.evaluate(h).com_db, 0.0);
+}
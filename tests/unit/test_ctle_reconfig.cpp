@@ -0,0 +1,214 @@
+/**
+ * @file test_ctle_reconfig.cpp
+ * @brief Unit tests for CTLE runtime reconfiguration (coefficient bank)
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <cmath>
+#include <stdexcept>
+#include "ams/ctle_coeff_bank.h"
+#include "ams/rx_ctle.h"
+#include "common/parameters.h"
+
+using namespace serdes;
+
+static const double kTimestep = 1.0 / 640e9;
+
+namespace {
+
+/**
+ * @brief Constant differential input and supply; after switch_at samples
+ *        requests an off-grid CTLE setting on the DE config ports
+ */
+class CtleCfgSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out_p;
+    sca_tdf::sca_out<double> out_n;
+    sca_tdf::sca_out<double> vdd;
+    sca_tdf::sca_de::sca_out<double> zero;
+    sca_tdf::sca_de::sca_out<double> pole;
+    sca_tdf::sca_de::sca_out<double> dc_gain;
+
+    CtleCfgSource(sc_core::sc_module_name nm, int switch_at)
+        : sca_tdf::sca_module(nm)
+        , out_p("out_p"), out_n("out_n"), vdd("vdd")
+        , zero("zero"), pole("pole"), dc_gain("dc_gain")
+        , m_switch_at(switch_at), m_n(0) {}
+
+    void set_attributes() override {
+        out_p.set_rate(1);
+        out_n.set_rate(1);
+        vdd.set_rate(1);
+        set_timestep(kTimestep, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        out_p.write(0.05);
+        out_n.write(-0.05);
+        vdd.write(1.0);
+        // 0 = keep the configured setting
+        bool on = m_n++ >= m_switch_at;
+        zero.write(on ? 2.9e9 : 0.0);
+        pole.write(on ? 31e9 : 0.0);
+        dc_gain.write(on ? 0.95 : 0.0);
+    }
+
+private:
+    int m_switch_at;
+    int m_n;
+};
+
+class CtleSink : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<double> in_p;
+    sca_tdf::sca_in<double> in_n;
+    double last;
+
+    CtleSink(sc_core::sc_module_name nm) : sca_tdf::sca_module(nm), in_p("in_p"), in_n("in_n"), last(0.0) {}
+
+    void set_attributes() override {
+        in_p.set_rate(1);
+        in_n.set_rate(1);
+    }
+
+    void processing() override { last = in_p.read() - in_n.read(); }
+};
+
+SC_MODULE(CtleSnapTb) {
+    CtleCfgSource* src;
+    RxCtleTdf* ctle;
+    CtleSink* sink;
+
+    sca_tdf::sca_signal<double> sig_in_p, sig_in_n, sig_vdd, sig_out_p, sig_out_n;
+    sc_core::sc_signal<double> sig_zero, sig_pole, sig_dc_gain;
+
+    CtleSnapTb(sc_core::sc_module_name nm, const RxCtleParams& params, int switch_at)
+        : sc_core::sc_module(nm)
+    {
+        src = new CtleCfgSource("src", switch_at);
+        ctle = new RxCtleTdf("ctle", params);
+        sink = new CtleSink("sink");
+        src->out_p(sig_in_p);
+        src->out_n(sig_in_n);
+        src->vdd(sig_vdd);
+        src->zero(sig_zero);
+        src->pole(sig_pole);
+        src->dc_gain(sig_dc_gain);
+        ctle->in_p(sig_in_p);
+        ctle->in_n(sig_in_n);
+        ctle->vdd(sig_vdd);
+        ctle->out_p(sig_out_p);
+        ctle->out_n(sig_out_n);
+        ctle->cfg_de[RxCtleTdf::CFG_ZERO](sig_zero);
+        ctle->cfg_de[RxCtleTdf::CFG_POLE](sig_pole);
+        ctle->cfg_de[RxCtleTdf::CFG_DC_GAIN](sig_dc_gain);
+        sink->in_p(sig_out_p);
+        sink->in_n(sig_out_n);
+    }
+};
+
+} // namespace
+
+// 阶跃响应稳态值应等于直流增益
+TEST(CtleReconfigTest, StepResponseSettlesToDcGain) {
+    CtleCoeffBank bank;
+    bank.configure({2e9}, {30e9, 60e9}, kTimestep);
+    int idx = bank.find_or_build(2e9, 30e9, 1.5);
+
+    CtleSectionCascade cascade;
+    cascade.resize(bank.get_num_sections());
+    double y = 0.0;
+    for (int i = 0; i < 200000; ++i) {
+        y = cascade.process(bank.get(idx), 1.0);
+    }
+    EXPECT_NEAR(y, 1.5, 1e-6);
+    EXPECT_EQ(bank.get_num_sections(), 2);
+}
+
+// 高频增益 = dc_gain * prod(wp/wz)，由零极点决定
+TEST(CtleReconfigTest, PeakingFollowsZeroPole) {
+    CtleCoeffBank bank;
+    bank.configure({2e9}, {30e9}, kTimestep);
+    const CtleCoeffSet& set = bank.get(bank.find_or_build(2e9, 30e9, 1.0));
+
+    // Nyquist-of-simulation gain of one bilinear section: (b0 - b1) / (1 - a1)
+    const CtleSectionCoeffs& c = set.sections[0];
+    double hf_gain = (c.b0 - c.b1) / (1.0 - c.a1);
+    EXPECT_NEAR(hf_gain, 30e9 / 2e9, 1e-6);
+}
+
+// 相同设置命中缓存，不重复离散化
+TEST(CtleReconfigTest, BankCachesSettings) {
+    CtleCoeffBank bank;
+    bank.configure({2e9}, {30e9}, kTimestep);
+    int a = bank.find_or_build(2e9, 30e9, 1.5);
+    int b = bank.find_or_build(3e9, 30e9, 1.5);
+    int c = bank.find_or_build(2e9, 30e9, 1.5);
+    EXPECT_EQ(a, c);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(bank.size(), 2);
+
+    EXPECT_EQ(bank.find_nearest(3.2e9, 30e9, 1.5), b);
+    EXPECT_EQ(bank.find_nearest(1.9e9, 29e9, 1.4), a);
+}
+
+// 切换系数组时状态保持：输出连续，无从零重启的瞬态
+TEST(CtleReconfigTest, StateCarriedAcrossSwitch) {
+    CtleCoeffBank bank;
+    bank.configure({2e9}, {30e9}, kTimestep);
+    int a = bank.find_or_build(2e9, 30e9, 1.0);
+    int b = bank.find_or_build(2.2e9, 30e9, 1.0);
+
+    CtleSectionCascade cascade;
+    cascade.resize(bank.get_num_sections());
+    double y_prev = 0.0;
+    for (int i = 0; i < 100000; ++i) {
+        y_prev = cascade.process(bank.get(a), 0.2);
+    }
+    double y_next = cascade.process(bank.get(b), 0.2);
+    EXPECT_NEAR(y_next, y_prev, 0.01);
+
+    CtleSectionCascade fresh;
+    fresh.resize(bank.get_num_sections());
+    double y_fresh = fresh.process(bank.get(b), 0.2);
+    EXPECT_GT(std::abs(y_fresh - y_prev), 0.1);
+}
+
+TEST(CtleReconfigTest, RejectsMoreZerosThanPoles) {
+    CtleCoeffBank bank;
+    EXPECT_THROW(bank.configure({1e9, 2e9}, {30e9}, kTimestep), std::invalid_argument);
+    EXPECT_THROW(bank.configure({1e9}, {30e9}, 0.0), std::invalid_argument);
+}
+
+// 运行时非网格设置吸附到最近的预构建设置，处理路径不扩充系数库
+TEST(CtleReconfigTest, OffGridRequestSnapsToPrebuiltSetting) {
+    RxCtleParams params;
+    params.zeros = {2e9};
+    params.poles = {30e9};
+    params.dc_gain = 1.5;
+    params.sat_min = -10.0;               // Linear range
+    params.sat_max = 10.0;
+    params.adapt.enable = true;
+    params.adapt.settings = {{3e9, 30e9, 1.0}, {1e9, 30e9, 2.0}};
+
+    CtleSnapTb tb("tb", params, 20000);
+    sc_core::sc_start(200000 * kTimestep, sc_core::SC_SEC);
+
+    EXPECT_EQ(tb.ctle->get_bank_size(), 3);
+    const CtleCoeffSet& active = tb.ctle->get_active_coeffs();
+    EXPECT_DOUBLE_EQ(active.zero, 3e9);
+    EXPECT_DOUBLE_EQ(active.dc_gain, 1.0);
+    // Settled at the snapped setting's DC gain
+    EXPECT_NEAR(tb.sink->last, 0.1 * 1.0, 1e-4);
+
+    sc_core::sc_stop();
+}
+
+// 预构建设置的零极点与增益须为正的有限值
+TEST(CtleReconfigTest, RejectsNonPositiveSetting) {
+    RxCtleParams params;
+    params.adapt.enable = true;
+    params.adapt.settings = {{2e9, 0.0, 1.0}};
+    EXPECT_THROW(RxCtleTdf("ctle_bad", params), std::invalid_argument);
+}
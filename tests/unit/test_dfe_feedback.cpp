@@ -0,0 +1,212 @@
+/**
+ * @file test_dfe_feedback.cpp
+ * @brief Unit tests for the packed-bit DFE history and feedback kernel
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ams/dfe_feedback.h"
+
+using namespace serdes;
+
+namespace {
+
+// Reference: element-wise FIFO and per-tap mapped multiply-accumulate
+double reference_feedback(const std::vector<double>& taps, const std::deque<bool>& hist,
+                          bool pm1, double vtap) {
+    double v = 0.0;
+    for (size_t k = 0; k < taps.size(); ++k) {
+        double b = hist[k] ? 1.0 : (pm1 ? -1.0 : 0.0);
+        v += taps[k] * b * vtap;
+    }
+    return v;
+}
+
+} // namespace
+
+// 打包比特点积与逐抽头参考实现一致（含跨 64 位字的抽头数）
+TEST(DfeFeedbackTest, MatchesReferenceForManyTapCounts) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coeff(-0.1, 0.1);
+    for (size_t n : {1u, 5u, 24u, 63u, 64u, 65u, 130u}) {
+        for (bool pm1 : {true, false}) {
+            std::vector<double> taps(n);
+            for (double& c : taps) c = coeff(rng);
+
+            DfeFeedbackKernel kernel;
+            kernel.configure(taps, pm1, 0.8);
+            std::deque<bool> hist(n, false);
+
+            for (int step = 0; step < 500; ++step) {
+                bool bit = (rng() & 1u) != 0;
+                kernel.push(bit);
+                hist.push_front(bit);
+                hist.pop_back();
+                if (step % 37 == 0) {
+                    size_t k = rng() % n;
+                    taps[k] = coeff(rng);
+                    kernel.set_tap(k, taps[k]);
+                }
+                ASSERT_NEAR(kernel.feedback(), reference_feedback(taps, hist, pm1, 0.8), 1e-12)
+                    << "taps=" << n << " pm1=" << pm1 << " step=" << step;
+            }
+        }
+    }
+}
+
+// 历史缓冲区：bit 0 为最近判决，filled() 统计已接收判决数
+TEST(DfeFeedbackTest, HistoryOrderAndFillCount) {
+    DfeBitHistory hist;
+    hist.resize(70);
+    EXPECT_EQ(hist.num_words(), 2u);
+    EXPECT_EQ(hist.filled(), 0u);
+
+    hist.push(true);
+    hist.push(false);
+    hist.push(true);
+    EXPECT_TRUE(hist.bit(0));
+    EXPECT_FALSE(hist.bit(1));
+    EXPECT_TRUE(hist.bit(2));
+    EXPECT_EQ(hist.filled(), 3u);
+
+    // Decisions move across the word boundary and then drop out
+    for (int i = 0; i < 67; ++i) hist.push(false);
+    EXPECT_TRUE(hist.bit(67));
+    EXPECT_TRUE(hist.bit(69));
+    hist.push(false);
+    hist.push(false);
+    EXPECT_TRUE(hist.bit(69));
+    hist.push(false);
+    for (size_t k = 0; k < 70; ++k) EXPECT_FALSE(hist.bit(k)) << k;
+    EXPECT_EQ(hist.filled(), 70u);
+
+    hist.clear();
+    EXPECT_EQ(hist.filled(), 0u);
+}
+
+// 浮动抽头：按各自位置选取判决，历史加深到最远位置，与逐抽头参考一致
+TEST(DfeFeedbackTest, FloatingTapsMatchReference) {
+    const std::vector<double> taps = {-0.05, -0.02, 0.01};
+    const std::vector<int> positions = {9, 40, 70};      // 70 crosses a word boundary
+    const std::vector<double> coeffs = {0.03, -0.01, 0.004};
+    std::mt19937 rng(13);
+    for (bool pm1 : {true, false}) {
+        DfeFeedbackKernel kernel;
+        kernel.configure(taps, pm1, 0.8);
+        kernel.configure_floating(positions, coeffs);
+        EXPECT_EQ(kernel.history().size(), 70u);
+        EXPECT_EQ(kernel.size(), taps.size());
+        std::deque<bool> hist(70, false);
+
+        for (int step = 0; step < 500; ++step) {
+            bool bit = (rng() & 1u) != 0;
+            kernel.push(bit);
+            hist.push_front(bit);
+            hist.pop_back();
+            double expected = reference_feedback(taps, hist, pm1, 0.8);
+            for (size_t i = 0; i < positions.size(); ++i) {
+                double b = hist[positions[i] - 1] ? 1.0 : (pm1 ? -1.0 : 0.0);
+                expected += coeffs[i] * b * 0.8;
+            }
+            ASSERT_NEAR(kernel.feedback(), expected, 1e-12) << "pm1=" << pm1 << " step=" << step;
+        }
+    }
+}
+
+// 浮动抽头参数校验：数量一致，位置在固定抽头之外
+TEST(DfeFeedbackTest, FloatingTapsRejectInvalidPositions) {
+    DfeFeedbackKernel kernel;
+    kernel.configure({-0.05, -0.02, 0.01}, true, 1.0);
+    EXPECT_THROW(kernel.configure_floating({8}, {0.01, 0.02}), std::invalid_argument);
+    EXPECT_THROW(kernel.configure_floating({3}, {0.01}), std::invalid_argument);
+    EXPECT_THROW(kernel.configure_floating({-1}, {0.01}), std::invalid_argument);
+    EXPECT_NO_THROW(kernel.configure_floating({4}, {0.01}));
+}
+
+// set_tap 仅在数值变化时返回 true
+TEST(DfeFeedbackTest, SetTapReportsChange) {
+    DfeFeedbackKernel kernel;
+    kernel.configure({-0.05, -0.02, 0.01}, true, 1.0);
+    EXPECT_FALSE(kernel.set_tap(1, -0.02));
+    EXPECT_TRUE(kernel.set_tap(1, -0.03));
+    EXPECT_FALSE(kernel.set_tap(5, 0.1));          // Out of range is ignored
+    EXPECT_DOUBLE_EQ(kernel.taps()[1], -0.03);
+
+    // Empty history in pm1 mode maps every bit to -1
+    EXPECT_NEAR(kernel.feedback(), 0.05 + 0.03 - 0.01, 1e-15);
+}
+
+// push 仅在打包历史实际变化时返回 true（此时才需要重算反馈）
+TEST(DfeFeedbackTest, PushReportsHistoryChange) {
+    DfeFeedbackKernel kernel;
+    kernel.configure({-0.05, -0.02, 0.01, 0.005, 0.002}, true, 1.0);
+    std::deque<bool> hist(5, false);
+
+    std::mt19937 rng(11);
+    for (int ui = 0; ui < 2000; ++ui) {
+        // Long runs of equal decisions leave a 5-bit history unchanged
+        bool bit = (rng() % 4u) == 0;
+        std::deque<bool> next = hist;
+        next.push_front(bit);
+        next.pop_back();
+        double before = kernel.feedback();
+        ASSERT_EQ(kernel.push(bit), next != hist) << "ui=" << ui;
+        if (next == hist) {
+            ASSERT_DOUBLE_EQ(kernel.feedback(), before);
+        }
+        hist = next;
+    }
+}
+
+// 吞吐量：24 抽头打包比特点积与逐元素移位 + 分支映射结果一致，耗时仅记录不断言
+TEST(DfeFeedbackTest, ThroughputAt24Taps) {
+    const size_t n = 24;
+    const int steps = 2000000;
+    std::vector<double> taps(n);
+    for (size_t k = 0; k < n; ++k) taps[k] = -0.05 / (k + 1);
+
+    std::mt19937 rng(3);
+    std::vector<bool> bits(steps);
+    for (int i = 0; i < steps; ++i) bits[i] = (rng() & 1u) != 0;
+
+    DfeFeedbackKernel kernel;
+    kernel.configure(taps, true, 1.0);
+    double acc_packed = 0.0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i) {
+        kernel.push(bits[i]);
+        acc_packed += kernel.feedback();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::vector<double> hist(n, 0.0);
+    std::string mode = "pm1";
+    double acc_ref = 0.0;
+    for (int i = 0; i < steps; ++i) {
+        for (size_t k = n - 1; k > 0; --k) hist[k] = hist[k - 1];
+        hist[0] = bits[i] ? 1.0 : 0.0;
+        double v = 0.0;
+        for (size_t k = 0; k < n; ++k) {
+            double b = (mode == "pm1") ? ((hist[k] > 0.5) ? 1.0 : -1.0)
+                                       : ((hist[k] > 0.5) ? 1.0 : 0.0);
+            v += taps[k] * b;
+        }
+        acc_ref += v;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    EXPECT_NEAR(acc_packed, acc_ref, 1e-6 * std::abs(acc_ref) + 1e-9);
+
+    // Wall-clock time depends on the machine and build; report, don't assert
+    using us = std::chrono::microseconds;
+    ::testing::Test::RecordProperty("packed_us",
+        static_cast<int>(std::chrono::duration_cast<us>(t1 - t0).count()));
+    ::testing::Test::RecordProperty("reference_us",
+        static_cast<int>(std::chrono::duration_cast<us>(t2 - t1).count()));
+}
@@ -0,0 +1,172 @@
+/**
+ * @file test_dfe_summer_ui_rate.cpp
+ * @brief RxDfeSummerTdf history is UI-rate: tap k cancels the cursor k UIs back,
+ *        a floating tap the reflection at its position
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "ams/rx_dfe_summer.h"
+#include "common/parameters.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 100e-12;
+const int SPU = 16;                       // Samples per UI
+const int NUM_UI = 400;
+// Pulse-response cursors h0..h5 (UI-spaced)
+const std::vector<double> CURSORS = {0.4, 0.15, -0.08, 0.05, 0.03, -0.02};
+// Isolated reflection beyond the fixed taps, cancelled by a floating tap
+const int REFLECTION_UI = 12;
+const double REFLECTION = 0.04;
+
+/**
+ * @brief NRZ symbols through a known UI-spaced channel, with an ideal
+ *        sampler decision and the CDR trigger at mid-UI
+ */
+class CursorChannelSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out_p;
+    sca_tdf::sca_out<double> out_n;
+    sca_tdf::sca_out<double> data;
+    sca_tdf::sca_out<bool> trigger;
+
+    std::vector<double> symbols;
+
+    CursorChannelSource(sc_core::sc_module_name nm)
+        : sca_tdf::sca_module(nm)
+        , out_p("out_p"), out_n("out_n"), data("data"), trigger("trigger")
+        , m_n(0), m_decision(0.0)
+    {
+        std::mt19937 rng(5);
+        symbols.resize(NUM_UI + 2);
+        for (double& s : symbols) s = (rng() & 1u) ? 1.0 : -1.0;
+    }
+
+    void set_attributes() override {
+        out_p.set_rate(1);
+        out_n.set_rate(1);
+        data.set_rate(1);
+        trigger.set_rate(1);
+        set_timestep(UI / SPU, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        long k = std::min<long>(m_n / SPU, NUM_UI);
+        double y = 0.0;
+        for (size_t j = 0; j < CURSORS.size(); ++j) {
+            if (k >= static_cast<long>(j)) y += CURSORS[j] * symbols[k - j];
+        }
+        if (k >= REFLECTION_UI) y += REFLECTION * symbols[k - REFLECTION_UI];
+        bool sample = (m_n % SPU) == SPU / 2;
+        if (sample) m_decision = symbols[k] > 0.0 ? 1.0 : 0.0;
+        out_p.write(0.5 * y);
+        out_n.write(-0.5 * y);
+        data.write(m_decision);
+        trigger.write(sample);
+        ++m_n;
+    }
+
+private:
+    long m_n;
+    double m_decision;
+};
+
+class DiffSink : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<double> in_p;
+    sca_tdf::sca_in<double> in_n;
+    std::vector<double> samples;
+
+    DiffSink(sc_core::sc_module_name nm) : sca_tdf::sca_module(nm), in_p("in_p"), in_n("in_n") {}
+
+    void set_attributes() override {
+        in_p.set_rate(1);
+        in_n.set_rate(1);
+    }
+
+    void processing() override { samples.push_back(in_p.read() - in_n.read()); }
+};
+
+SC_MODULE(DfeSummerUiRateTb) {
+    CursorChannelSource* src;
+    RxDfeSummerTdf* summer_trig;          // History on the CDR trigger
+    RxDfeSummerTdf* summer_count;         // History on the samples-per-UI counter
+    DiffSink* sink_trig;
+    DiffSink* sink_count;
+
+    sca_tdf::sca_signal<double> sig_p, sig_n, sig_data;
+    sca_tdf::sca_signal<bool> sig_trigger;
+    sca_tdf::sca_signal<double> sig_trig_p, sig_trig_n, sig_count_p, sig_count_n;
+    sc_core::sc_signal<double> sig_tap[5];
+    sc_core::sc_signal<int> sig_seq;
+
+    SC_CTOR(DfeSummerUiRateTb) {
+        RxDfeSummerParams params;
+        params.ui = UI;
+        params.tap_coeffs.assign(CURSORS.begin() + 1, CURSORS.end());
+        params.floating_positions = {REFLECTION_UI};
+        params.floating_coeffs = {REFLECTION};
+        params.tap_update_seq = true;     // Sequence stays 0: keep tap_coeffs
+
+        src = new CursorChannelSource("src");
+        RxDfeSummerParams trig_params = params;
+        trig_params.decision_trigger = true;
+        summer_trig = new RxDfeSummerTdf("summer_trig", trig_params);
+        summer_count = new RxDfeSummerTdf("summer_count", params);
+        sink_trig = new DiffSink("sink_trig");
+        sink_count = new DiffSink("sink_count");
+
+        src->out_p(sig_p);
+        src->out_n(sig_n);
+        src->data(sig_data);
+        src->trigger(sig_trigger);
+
+        RxDfeSummerTdf* summers[2] = {summer_trig, summer_count};
+        for (RxDfeSummerTdf* s : summers) {
+            s->in_p(sig_p);
+            s->in_n(sig_n);
+            s->data_in(sig_data);
+            for (int k = 0; k < 5; ++k) s->tap_de[k](sig_tap[k]);
+            s->tap_seq_de[0](sig_seq);
+        }
+        summer_trig->sampling_trigger[0](sig_trigger);
+        summer_trig->out_p(sig_trig_p);
+        summer_trig->out_n(sig_trig_n);
+        summer_count->out_p(sig_count_p);
+        summer_count->out_n(sig_count_n);
+        sink_trig->in_p(sig_trig_p);
+        sink_trig->in_n(sig_trig_n);
+        sink_count->in_p(sig_count_p);
+        sink_count->in_n(sig_count_n);
+    }
+};
+
+} // namespace
+
+// 已知信道：UI 速率历史下抽头 k 抵消 k UI 前的游标、浮动抽头抵消远端反射，采样点只剩主游标
+TEST(DfeSummerUiRateTest, TapKCancelsCursorKUisBack) {
+    DfeSummerUiRateTb tb("tb");
+    sc_core::sc_start(NUM_UI * UI, sc_core::SC_SEC);
+
+    const std::vector<double>* outs[2] = {&tb.sink_trig->samples, &tb.sink_count->samples};
+    for (int m = 0; m < 2; ++m) {
+        const std::vector<double>& y = *outs[m];
+        ASSERT_GE(y.size(), static_cast<size_t>((NUM_UI - 1) * SPU)) << "summer " << m;
+        for (int k = REFLECTION_UI; k < NUM_UI - 1; ++k) {
+            double expected = CURSORS[0] * tb.src->symbols[k];
+            ASSERT_NEAR(y[k * SPU + SPU / 2], expected, 1e-12) << "summer " << m << " UI " << k;
+        }
+    }
+    // One history shift per UI, not per sample
+    EXPECT_NEAR(static_cast<double>(tb.summer_trig->get_decisions()), NUM_UI, 2.0);
+    EXPECT_NEAR(static_cast<double>(tb.summer_count->get_decisions()), NUM_UI, 2.0);
+    EXPECT_LE(tb.summer_trig->get_feedback_updates(), tb.summer_trig->get_decisions() + 1);
+
+    sc_core::sc_stop();
+}
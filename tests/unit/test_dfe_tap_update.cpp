@@ -0,0 +1,197 @@
+/**
+ * @file test_dfe_tap_update.cpp
+ * @brief Unit tests for the DFE tap update rules (sign-sign LMS, LMS, NLMS,
+ *        RLS) and a convergence-time comparison
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ams/dfe_feedback.h"
+#include "ams/dfe_tap_update.h"
+
+using namespace serdes;
+
+namespace {
+
+struct ConvergenceResult {
+    long ui_to_converge;          // -1 if never within tolerance at the end
+    double final_error;           // |c - h| / |h|
+};
+
+// Closed DFE loop at UI rate on x[k] = h0 d[k] + sum h[n] d[k-n-1] + noise:
+// y = x - vtap c'u, d = sign(y), e = y - d h0 (pm1 summer with scale vtap,
+// so the taps converge to h / vtap)
+ConvergenceResult run_adaptation(const std::string& algorithm, double mu,
+                                 const std::vector<double>& post, int n_ui,
+                                 double noise_sigma = 0.01, double vtap = 1.0) {
+    const double h0 = 0.3;
+    const int n = static_cast<int>(post.size());
+    DfeTapUpdater updater;
+    updater.configure(parse_dfe_update_algorithm(algorithm), n, 0.999, 1.0, 1e-3);   // Defaults
+    updater.set_bit_mapping(true, vtap);
+    DfeBitHistory history;
+    history.resize(n);
+
+    std::mt19937 rng(5);
+    std::normal_distribution<double> noise(0.0, noise_sigma);
+    std::vector<double> tx(n + 1, 1.0);       // tx[0] = d[k], tx[j] = d[k-j]
+    std::vector<double> c(n, 0.0);
+
+    double h_norm = 0.0;
+    for (double h : post) h_norm += h * h;
+    h_norm = std::sqrt(h_norm);
+
+    long last_outside = 0;
+    double rel = 1.0;
+    for (int k = 0; k < n_ui; ++k) {
+        for (int j = n; j > 0; --j) tx[j] = tx[j - 1];
+        tx[0] = (rng() & 1u) ? 1.0 : -1.0;
+
+        double x = h0 * tx[0] + noise(rng);
+        for (int j = 0; j < n; ++j) x += post[j] * tx[j + 1];
+        double fb = 0.0;
+        for (int j = 0; j < n; ++j) {
+            if (j < static_cast<int>(history.filled())) {
+                fb += c[j] * vtap * (history.bit(j) ? 1.0 : -1.0);
+            }
+        }
+        double y = x - fb;
+        double d = (y > 0.0) ? 1.0 : -1.0;
+        double e = y - d * h0;
+        double sign_err = (e > 0.0) ? 1.0 : ((e < 0.0) ? -1.0 : 0.0);
+
+        updater.update(c, history, mu, sign_err, e);
+        history.push(d > 0.0);
+
+        double err2 = 0.0;
+        for (int j = 0; j < n; ++j) err2 += (vtap * c[j] - post[j]) * (vtap * c[j] - post[j]);
+        rel = std::sqrt(err2) / h_norm;
+        if (rel > 0.1) last_outside = k + 1;
+    }
+
+    ConvergenceResult r;
+    r.ui_to_converge = (rel > 0.1) ? -1 : last_outside;
+    r.final_error = rel;
+    return r;
+}
+
+} // namespace
+
+// 各算法从零抽头收敛到信道后游标
+TEST(DfeTapUpdateTest, AllAlgorithmsConvergeToPostCursors) {
+    const std::vector<double> post = {0.08, 0.05, -0.03, 0.02, 0.01};
+    struct Case { const char* name; double mu; };
+    const Case cases[] = {
+        {"sign-lms", 1.0 / 4096},
+        {"lms", 1.0 / 32},
+        {"nlms", 0.25},
+        {"rls", 0.0},
+    };
+    for (const Case& c : cases) {
+        ConvergenceResult r = run_adaptation(c.name, c.mu, post, 100000);
+        EXPECT_GE(r.ui_to_converge, 0) << c.name;
+        EXPECT_LT(r.final_error, 0.1) << c.name;
+    }
+}
+
+// 收敛时间对比：5 抽头与 16 抽头
+TEST(DfeTapUpdateTest, ConvergenceTimeComparison) {
+    const std::vector<double> post5 = {0.08, 0.05, -0.03, 0.02, 0.01};
+    std::vector<double> post16;
+    const std::vector<double>* posts[] = {&post5, &post16};
+    for (int n = 0; n < 16; ++n) post16.push_back(0.08 * std::pow(0.8, n) * ((n % 3 == 2) ? -1.0 : 1.0));
+
+    for (const std::vector<double>* post : posts) {
+        ConvergenceResult ss = run_adaptation("sign-lms", 1.0 / 4096, *post, 200000);
+        ConvergenceResult lms = run_adaptation("lms", 1.0 / 64, *post, 200000);
+        ConvergenceResult nlms = run_adaptation("nlms", 0.25, *post, 200000);
+        ConvergenceResult rls = run_adaptation("rls", 0.0, *post, 200000);
+
+        ASSERT_GT(ss.ui_to_converge, 0);
+        ASSERT_GT(lms.ui_to_converge, 0);
+        ASSERT_GT(nlms.ui_to_converge, 0);
+        ASSERT_GT(rls.ui_to_converge, 0);
+        // Step sizes give comparable steady-state error for the LMS family;
+        // the error-magnitude rules train faster, RLS by an order of magnitude
+        // while also settling closer to the channel
+        EXPECT_LT(lms.ui_to_converge, ss.ui_to_converge);
+        EXPECT_LT(nlms.ui_to_converge, ss.ui_to_converge);
+        EXPECT_LT(rls.ui_to_converge * 10, ss.ui_to_converge);
+        EXPECT_LT(rls.final_error, lms.final_error);
+    }
+}
+
+// RLS 逆相关矩阵保持对称；fixed 不更新
+TEST(DfeTapUpdateTest, RlsKeepsSymmetricInverseAndFixedIsInert) {
+    DfeTapUpdater rls;
+    rls.configure(DFEUpdateAlgorithm::RLS, 4, 0.99, 10.0, 0.0);
+    DfeBitHistory hist;
+    hist.resize(4);
+    std::vector<double> c(4, 0.0);
+    std::mt19937 rng(1);
+    for (int k = 0; k < 500; ++k) {
+        rls.update(c, hist, 0.0, 0.0, 0.01 * ((rng() & 1u) ? 1.0 : -1.0));
+        hist.push((rng() & 1u) != 0);
+    }
+    const std::vector<double>& P = rls.get_inverse_correlation();
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_GT(P[i * 4 + i], 0.0);
+        for (int j = 0; j < 4; ++j) EXPECT_NEAR(P[i * 4 + j], P[j * 4 + i], 1e-9);
+    }
+
+    DfeTapUpdater fixed;
+    fixed.configure(DFEUpdateAlgorithm::FIXED, 4, 0.999, 100.0, 1e-3);
+    std::vector<double> f = {0.1, 0.2, 0.3, 0.4};
+    EXPECT_FALSE(fixed.update(f, hist, 0.1, 1.0, 0.5));
+    EXPECT_DOUBLE_EQ(f[3], 0.4);
+    EXPECT_FALSE(fixed.needs_error_magnitude());
+}
+
+// 误差幅值算法按求和器的 vtap 缩放回归量：抽头收敛到 h / vtap；01 映射下比特 0 不贡献反馈
+TEST(DfeTapUpdateTest, ErrorMagnitudeRulesFollowSummerMapping) {
+    const std::vector<double> post = {0.08, 0.05, -0.03, 0.02, 0.01};
+    const double vtap = 0.5;
+    ConvergenceResult lms = run_adaptation("lms", 1.0 / 32, post, 100000, 0.01, vtap);
+    ConvergenceResult nlms = run_adaptation("nlms", 0.25, post, 100000, 0.01, vtap);
+    ConvergenceResult rls = run_adaptation("rls", 0.0, post, 100000, 0.01, vtap);
+    EXPECT_LT(lms.final_error, 0.1);
+    EXPECT_LT(nlms.final_error, 0.1);
+    EXPECT_LT(rls.final_error, 0.1);
+
+    DfeTapUpdater u;
+    u.configure(DFEUpdateAlgorithm::LMS, 2, 0.999, 1.0, 1e-3);
+    u.set_bit_mapping(false, 0.25);
+    EXPECT_DOUBLE_EQ(u.regressor(true), 0.25);
+    EXPECT_DOUBLE_EQ(u.regressor(false), 0.0);
+    DfeBitHistory hist;
+    hist.resize(2);
+    hist.push(true);
+    hist.push(false);                 // u = {0 (b[k-1] = 0), 0.25 (b[k-2] = 1)}
+    std::vector<double> c(2, 0.0);
+    u.update(c, hist, 0.5, 0.0, 0.2);
+    EXPECT_DOUBLE_EQ(c[0], 0.0);
+    EXPECT_DOUBLE_EQ(c[1], 0.5 * 0.2 * 0.25);
+}
+
+// 旧式算法拼写与未知名称（告警后回退到 sign-lms）
+TEST(DfeTapUpdateTest, ParsesLegacySpellings) {
+    EXPECT_EQ(parse_dfe_update_algorithm("sign_lms"), DFEUpdateAlgorithm::SIGN_LMS);
+    EXPECT_EQ(parse_dfe_update_algorithm("Sign-Sign"), DFEUpdateAlgorithm::SIGN_LMS);
+    EXPECT_EQ(parse_dfe_update_algorithm("SSLMS"), DFEUpdateAlgorithm::SIGN_LMS);
+    EXPECT_EQ(parse_dfe_update_algorithm("NLMS"), DFEUpdateAlgorithm::NLMS);
+    EXPECT_EQ(parse_dfe_update_algorithm("zf"), DFEUpdateAlgorithm::SIGN_LMS);
+}
+
+// 非法参数
+TEST(DfeTapUpdateTest, RejectsInvalidConfiguration) {
+    EXPECT_EQ(parse_dfe_update_algorithm("nlms"), DFEUpdateAlgorithm::NLMS);
+    DfeTapUpdater u;
+    EXPECT_THROW(u.configure(DFEUpdateAlgorithm::RLS, 3, 1.5, 100.0, 0.0), std::invalid_argument);
+    EXPECT_THROW(u.configure(DFEUpdateAlgorithm::LMS, 0, 0.999, 100.0, 0.0), std::invalid_argument);
+    EXPECT_TRUE(dfe_update_needs_error_magnitude(DFEUpdateAlgorithm::RLS));
+    EXPECT_FALSE(dfe_update_needs_error_magnitude(DFEUpdateAlgorithm::SIGN_LMS));
+}
@@ -0,0 +1,259 @@
+/**
+ * @file test_eq_candidate_summer.cpp
+ * @brief An applied EqOptimizer candidate, run through RxDfeSummerTdf,
+ *        reproduces the optimizer's predicted eye height
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "ams/com_analysis.h"
+#include "ams/eq_optimizer.h"
+#include "ams/eq_seed.h"
+#include "ams/rx_dfe_summer.h"
+#include "common/parameters.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 1e-10;
+const int SPU = 16;
+const int NUM_BLOCKS = 6;
+
+std::vector<std::complex<double>> lossy_channel(const std::vector<double>& freqs) {
+    std::vector<std::complex<double>> h(freqs.size());
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        h[i] = 0.2 / std::complex<double>(1.0, freqs[i] / 2.5e9);
+    }
+    return h;
+}
+
+/**
+ * @brief Worst-case symbol blocks: in each block every neighbour of the
+ *        centre UI opposes it through the sign of its cursor, so the
+ *        slicer sample at the centre is the worst-case eye. Post-cursors
+ *        1..num_dfe are fully cancelled (taps inside their limits), so
+ *        those symbols alternate instead: only a UI-spaced history then
+ *        feeds each tap the right decision.
+ */
+std::vector<double> worst_case_symbols(const std::vector<double>& pulse, int main_sample,
+                                       int num_dfe, int block, std::vector<int>& centres) {
+    const int n = static_cast<int>(pulse.size());
+    const int j_lo = -(main_sample / SPU);
+    const int j_hi = (n - 1 - main_sample) / SPU;
+    std::vector<double> symbols(static_cast<size_t>(block) * NUM_BLOCKS, 1.0);
+    for (int b = 0; b < NUM_BLOCKS; ++b) {
+        const double s0 = (b % 2) ? -1.0 : 1.0;
+        const int centre = b * block + j_hi;
+        centres.push_back(centre);
+        for (int j = j_lo; j <= j_hi; ++j) {
+            double x = pulse[main_sample + j * SPU];
+            if (j >= 1 && j <= num_dfe) {
+                symbols[centre - j] = (j % 2) ? -s0 : s0;
+            } else {
+                symbols[centre - j] = j == 0 ? s0 : (x > 0.0 ? -s0 : s0);
+            }
+        }
+    }
+    return symbols;
+}
+
+class SymbolPulseSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out_p;
+    sca_tdf::sca_out<double> out_n;
+    sca_tdf::sca_out<double> data;
+    sca_tdf::sca_out<bool> trigger;
+
+    SymbolPulseSource(sc_core::sc_module_name nm, const std::vector<double>& pulse,
+                      int main_sample, const std::vector<double>& symbols)
+        : sca_tdf::sca_module(nm)
+        , out_p("out_p"), out_n("out_n"), data("data"), trigger("trigger")
+        , m_pulse(pulse), m_symbols(symbols), m_main(main_sample), m_n(0), m_decision(0.0) {}
+
+    void set_attributes() override {
+        out_p.set_rate(1);
+        out_n.set_rate(1);
+        data.set_rate(1);
+        trigger.set_rate(1);
+        set_timestep(UI / SPU, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        const long num = static_cast<long>(m_symbols.size());
+        double y = 0.0;
+        long k_max = std::min<long>(m_n / SPU, num - 1);
+        long k_min = std::max<long>(0, (m_n - static_cast<long>(m_pulse.size())) / SPU);
+        for (long k = k_min; k <= k_max; ++k) {
+            long i = m_n - k * SPU;
+            if (i >= 0 && i < static_cast<long>(m_pulse.size())) y += m_symbols[k] * m_pulse[i];
+        }
+        long k = (m_n - m_main) / SPU;
+        bool sample = m_n >= m_main && (m_n - m_main) % SPU == 0 && k < num;
+        if (sample) m_decision = m_symbols[k] > 0.0 ? 1.0 : 0.0;
+        out_p.write(0.5 * y);
+        out_n.write(-0.5 * y);
+        data.write(m_decision);
+        trigger.write(sample);
+        ++m_n;
+    }
+
+private:
+    std::vector<double> m_pulse;
+    std::vector<double> m_symbols;
+    long m_main;
+    long m_n;
+    double m_decision;
+};
+
+class DiffSink : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<double> in_p;
+    sca_tdf::sca_in<double> in_n;
+    std::vector<double> samples;
+
+    DiffSink(sc_core::sc_module_name nm) : sca_tdf::sca_module(nm), in_p("in_p"), in_n("in_n") {}
+
+    void set_attributes() override {
+        in_p.set_rate(1);
+        in_n.set_rate(1);
+    }
+
+    void processing() override { samples.push_back(in_p.read() - in_n.read()); }
+};
+
+SC_MODULE(EqCandidateSummerTb) {
+    SymbolPulseSource* src;
+    RxDfeSummerTdf* summer_cand;          // Taps from apply_eq_candidate()
+    RxDfeSummerTdf* summer_zero;          // No DFE
+    DiffSink* sink_cand;
+    DiffSink* sink_zero;
+
+    sca_tdf::sca_signal<double> sig_p, sig_n, sig_data;
+    sca_tdf::sca_signal<bool> sig_trigger;
+    sca_tdf::sca_signal<double> sig_cand_p, sig_cand_n, sig_zero_p, sig_zero_n;
+    sc_core::sc_vector<sc_core::sc_signal<double>> sig_tap;
+    sc_core::sc_signal<int> sig_seq;
+
+    EqCandidateSummerTb(sc_core::sc_module_name nm, const std::vector<double>& pulse,
+                        int main_sample, const std::vector<double>& symbols,
+                        const RxDfeSummerParams& applied)
+        : sc_core::sc_module(nm)
+        , sig_tap("sig_tap", applied.tap_coeffs.size())
+    {
+        RxDfeSummerParams params = applied;
+        params.ui = UI;
+        params.tap_update_seq = true;     // Sequence stays 0: keep tap_coeffs
+        params.decision_trigger = true;
+        RxDfeSummerParams zero = params;
+        std::fill(zero.tap_coeffs.begin(), zero.tap_coeffs.end(), 0.0);
+
+        src = new SymbolPulseSource("src", pulse, main_sample, symbols);
+        summer_cand = new RxDfeSummerTdf("summer_cand", params);
+        summer_zero = new RxDfeSummerTdf("summer_zero", zero);
+        sink_cand = new DiffSink("sink_cand");
+        sink_zero = new DiffSink("sink_zero");
+
+        src->out_p(sig_p);
+        src->out_n(sig_n);
+        src->data(sig_data);
+        src->trigger(sig_trigger);
+        RxDfeSummerTdf* summers[2] = {summer_cand, summer_zero};
+        for (RxDfeSummerTdf* s : summers) {
+            s->in_p(sig_p);
+            s->in_n(sig_n);
+            s->data_in(sig_data);
+            s->sampling_trigger[0](sig_trigger);
+            for (size_t k = 0; k < sig_tap.size(); ++k) s->tap_de[k](sig_tap[k]);
+            s->tap_seq_de[0](sig_seq);
+        }
+        summer_cand->out_p(sig_cand_p);
+        summer_cand->out_n(sig_cand_n);
+        summer_zero->out_p(sig_zero_p);
+        summer_zero->out_n(sig_zero_n);
+        sink_cand->in_p(sig_cand_p);
+        sink_cand->in_n(sig_cand_n);
+        sink_zero->in_p(sig_zero_p);
+        sink_zero->in_n(sig_zero_n);
+    }
+};
+
+} // namespace
+
+// 最优候选写回链路参数后，经 DFE Summer 的最坏码型眼高与优化器预测一致
+TEST(EqCandidateSummerTest, AppliedCandidateReproducesPredictedEye) {
+    TxParams tx;
+    RxParams rx;
+    AdaptionParams ad;
+    tx.driver.poles = {25e9};
+    tx.driver.sat_mode = "soft";
+    tx.driver.vswing = 0.8;
+    tx.driver.vlin = 0.5;
+    rx.ctle.zeros = {1e9};
+    rx.ctle.poles = {3e9, 15e9};
+    rx.vga.zeros = {};
+    rx.vga.poles = {20e9};
+    rx.vga.dc_gain = 1.0;
+    rx.dfe_summer.vtap = 1.0;
+    ad.dfe.num_taps = 2;
+    ad.dfe.tap_min = -0.05;
+    ad.dfe.tap_max = 0.05;
+
+    // Noise-free metric: the predicted eye is the pure worst-case ISI eye
+    EqOptParams p;
+    p.ffe_pre = 1;
+    p.ffe_post = 1;
+    p.ffe_step = 0.05;
+    p.ctle_dc_gains = {1.0, 0.5, 0.3};
+    p.vga_gains = {1.0, 2.0, 4.0};
+    p.phase_span = 3;
+    p.top_k = 1;
+    p.eta0 = 0.0;
+    p.slicer_sigma = 0.0;
+    p.pulse_ui = 32;
+    EqOptimizer opt(p, tx, rx, ad, UI, SPU);
+    EqCandidate best = opt.optimize(lossy_channel(opt.get_frequencies())).best[0];
+    apply_eq_candidate(best, SPU, tx, rx, ad);
+    ASSERT_EQ(rx.dfe_summer.tap_coeffs.size(), 2u);
+    for (double t : rx.dfe_summer.tap_coeffs) {
+        ASSERT_GT(t, ad.dfe.tap_min);
+        ASSERT_LT(t, ad.dfe.tap_max);
+    }
+
+    // Pulse of the applied configuration, rebuilt from the written parameters
+    ComParams cp;
+    cp.pulse_ui = p.pulse_ui;
+    ComAnalyzer com(cp, tx, rx, ad, UI, SPU);
+    ASSERT_EQ(com.get_num_ctle(), 1);
+    std::vector<double> pulse = com.pulse_response(lossy_channel(com.get_frequencies()), 0);
+    const int peak = static_cast<int>(std::max_element(pulse.begin(), pulse.end()) - pulse.begin());
+    pulse.resize(pulse.size() + tx.ffe.taps.size() * SPU, 0.0);
+    pulse = apply_ffe_to_pulse(pulse, tx.ffe);
+    // The CDR locks at the candidate phase; the FFE pre-cursor delays the main cursor
+    const int main_sample = peak + static_cast<int>(std::lround(best.phase * SPU)) + p.ffe_pre * SPU;
+    const double h0 = pulse[main_sample];
+    ASSERT_GT(h0, 0.0);
+
+    const int block = static_cast<int>(pulse.size()) / SPU + 2;
+    std::vector<int> centres;
+    std::vector<double> symbols = worst_case_symbols(pulse, main_sample, ad.dfe.num_taps, block, centres);
+    EqCandidateSummerTb tb("tb", pulse, main_sample, symbols, rx.dfe_summer);
+    sc_core::sc_start(static_cast<double>(symbols.size() + 2) * UI, sc_core::SC_SEC);
+
+    for (int centre : centres) {
+        size_t n = static_cast<size_t>(centre) * SPU + main_sample;
+        ASSERT_LT(n, tb.sink_cand->samples.size());
+        double s0 = symbols[centre];
+        double eye_cand = s0 * tb.sink_cand->samples[n];
+        double eye_zero = s0 * tb.sink_zero->samples[n];
+        EXPECT_NEAR(eye_cand, best.eye_height, 1e-3 * h0) << "UI " << centre;
+        // The candidate's DFE taps are what closes the gap to the prediction
+        EXPECT_LT(eye_zero, best.eye_height - 5e-3 * h0) << "UI " << centre;
+    }
+
+    sc_core::sc_stop();
+}
@@ -0,0 +1,226 @@
+/**
+ * @file test_eq_optimizer.cpp
+ * @brief Unit tests for the joint FFE/CTLE/VGA/DFE pulse-response optimizer
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+#include "ams/eq_optimizer.h"
+#include "ams/eq_seed.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 1e-10;
+const int SPU = 16;
+
+struct LinkSetup {
+    TxParams tx;
+    RxParams rx;
+    AdaptionParams adaption;
+
+    LinkSetup() {
+        tx.driver.poles = {25e9};
+        tx.driver.sat_mode = "soft";
+        tx.driver.vswing = 0.8;
+        tx.driver.vlin = 0.5;
+        rx.ctle.zeros = {1e9};
+        rx.ctle.poles = {3e9, 15e9};
+        rx.vga.zeros = {};
+        rx.vga.poles = {20e9};
+        rx.vga.dc_gain = 1.0;
+        rx.dfe_summer.vtap = 1.0;
+        adaption.dfe.num_taps = 2;
+        adaption.dfe.tap_min = -0.05;
+        adaption.dfe.tap_max = 0.05;
+    }
+};
+
+std::vector<std::complex<double>> lossy_channel(const std::vector<double>& freqs) {
+    std::vector<std::complex<double>> h(freqs.size());
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        h[i] = 0.2 / std::complex<double>(1.0, freqs[i] / 2.5e9);
+    }
+    return h;
+}
+
+double q_of(double ber) {
+    double lo = 0.0, hi = 40.0;
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (lo + hi);
+        (0.5 * std::erfc(mid / std::sqrt(2.0)) > ber ? lo : hi) = mid;
+    }
+    return lo;
+}
+
+// 直接由均衡后脉冲逐点计算眼高（与优化器独立实现）
+double brute_force_eye(const EqOptParams& p, const LinkSetup& s) {
+    ComParams cp;
+    cp.ctle_dc_gains = p.ctle_dc_gains;
+    cp.eta0 = p.eta0;
+    cp.pulse_ui = p.pulse_ui;
+    RxParams rx = s.rx;
+    rx.vga.dc_gain = 1.0;
+    ComAnalyzer com(cp, s.tx, rx, s.adaption, UI, SPU);
+    std::vector<std::complex<double>> h = lossy_channel(com.get_frequencies());
+    double q = q_of(p.target_ber);
+    int levels = 2 * static_cast<int>(std::floor(p.ffe_max / p.ffe_step + 1e-9)) + 1;
+    double best = -1e9;
+    for (int c = 0; c < com.get_num_ctle(); ++c) {
+        std::vector<double> pulse = com.pulse_response(h, c);
+        int peak = static_cast<int>(std::max_element(pulse.begin(), pulse.end()) - pulse.begin());
+        for (int a = 0; a < levels; ++a) {
+            for (int b = 0; b < levels; ++b) {
+                double pre = (a - levels / 2) * p.ffe_step;
+                double post = (b - levels / 2) * p.ffe_step;
+                if (std::fabs(pre) + std::fabs(post) >= 1.0) continue;
+                TxFfeParams ffe;
+                ffe.taps = {pre, 1.0 - std::fabs(pre) - std::fabs(post), post};
+                ffe.tap_spacing = SPU;
+                std::vector<double> g = apply_ffe_to_pulse(pulse, ffe);
+                for (int d = -p.phase_span; d <= p.phase_span; ++d) {
+                    int m = peak + d + SPU;
+                    for (double v : p.vga_gains) {
+                        double isi = 0.0, excess = 0.0;
+                        for (int k = -(m / SPU); m + k * SPU < static_cast<int>(g.size()); ++k) {
+                            double x = g[m + k * SPU];
+                            if (k == 0) continue;
+                            if (k >= 1 && k <= 2) {
+                                excess += std::max(0.0, std::fabs(v * x) - 0.05);
+                            } else {
+                                isi += std::fabs(x);
+                            }
+                        }
+                        double sigma = std::sqrt(v * v * com.get_rx_noise_var(c) +
+                                                 p.slicer_sigma * p.slicer_sigma);
+                        best = std::max(best, v * (g[m] - isi) - excess - q * sigma);
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+EqOptParams small_space() {
+    EqOptParams p;
+    p.ffe_pre = 1;
+    p.ffe_post = 1;
+    p.ffe_step = 0.05;
+    p.ffe_max = 0.3;
+    p.ctle_dc_gains = {1.0, 0.5, 0.3};
+    p.vga_gains = {1.0, 2.0, 4.0};
+    p.phase_span = 3;
+    p.top_k = 5;
+    return p;
+}
+
+} // namespace
+
+// 剪枝搜索的最优解与穷举一致
+TEST(EqOptimizerTest, MatchesBruteForce) {
+    LinkSetup s;
+    EqOptParams p = small_space();
+    EqOptimizer opt(p, s.tx, s.rx, s.adaption, UI, SPU);
+    EqOptResult r = opt.optimize(lossy_channel(opt.get_frequencies()));
+    ASSERT_EQ(r.best.size(), 5u);
+    // apply_ffe_to_pulse truncates the shaped tail at the window end
+    EXPECT_NEAR(r.best[0].score, brute_force_eye(p, s), 1e-5);
+    EXPECT_DOUBLE_EQ(r.best[0].eye_height, r.best[0].score);
+    for (size_t i = 1; i < r.best.size(); ++i) {
+        EXPECT_LE(r.best[i].score, r.best[i - 1].score);
+    }
+    double sum = 0.0;
+    for (double f : r.best[0].ffe_taps) sum += std::fabs(f);
+    EXPECT_NEAR(sum, 1.0, 1e-12);
+    ASSERT_EQ(r.best[0].dfe_taps.size(), 2u);
+    for (double t : r.best[0].dfe_taps) {
+        EXPECT_LE(std::fabs(t), 0.05 + 1e-15);
+    }
+}
+
+// 结果与线程数无关，且大部分候选被剪枝
+TEST(EqOptimizerTest, DeterministicAndPruned) {
+    LinkSetup s;
+    EqOptParams p;
+    p.ffe_step = 0.02;
+    p.ctle_dc_gains = {1.0, 0.7, 0.5, 0.35, 0.25};
+    p.vga_gains = {1.0, 1.5, 2.0, 3.0};
+    p.num_threads = 1;
+    EqOptimizer serial(p, s.tx, s.rx, s.adaption, UI, SPU);
+    p.num_threads = 4;
+    EqOptimizer parallel(p, s.tx, s.rx, s.adaption, UI, SPU);
+    std::vector<std::complex<double>> h = lossy_channel(serial.get_frequencies());
+    EqOptResult a = serial.optimize(h);
+    EqOptResult b = parallel.optimize(h);
+
+    EXPECT_GT(a.num_candidates, 100000u);
+    EXPECT_GT(a.num_pruned, a.num_candidates / 2);
+    ASSERT_EQ(a.best.size(), b.best.size());
+    for (size_t i = 0; i < a.best.size(); ++i) {
+        EXPECT_EQ(a.best[i].score, b.best[i].score);
+        EXPECT_EQ(a.best[i].ffe_taps, b.best[i].ffe_taps);
+        EXPECT_EQ(a.best[i].vga_gain, b.best[i].vga_gain);
+    }
+}
+
+// SNR 指标：得分即 snr_db，且不低于其余保留候选
+TEST(EqOptimizerTest, SnrMetric) {
+    LinkSetup s;
+    EqOptParams p = small_space();
+    p.metric = "snr";
+    EqOptimizer opt(p, s.tx, s.rx, s.adaption, UI, SPU);
+    EqOptResult r = opt.optimize(lossy_channel(opt.get_frequencies()));
+    ASSERT_FALSE(r.best.empty());
+    EXPECT_DOUBLE_EQ(r.best[0].snr_db, r.best[0].score);
+    EXPECT_GT(r.best[0].snr_db, 10.0);
+}
+
+// 候选写入链路参数，并可保存/读回 JSON
+TEST(EqOptimizerTest, ApplySaveAndLoad) {
+    LinkSetup s;
+    EqOptimizer opt(small_space(), s.tx, s.rx, s.adaption, UI, SPU);
+    EqCandidate best = opt.optimize(lossy_channel(opt.get_frequencies())).best[0];
+
+    std::string path = ::testing::TempDir() + "eq_candidate.json";
+    ASSERT_TRUE(save_eq_candidate(path, best, 1, "eye"));
+    EqCandidate c = load_eq_candidate(path);
+    std::remove(path.c_str());
+    EXPECT_EQ(c.ffe_taps, best.ffe_taps);
+    EXPECT_EQ(c.dfe_taps, best.dfe_taps);
+    EXPECT_DOUBLE_EQ(c.ctle.dc_gain, best.ctle.dc_gain);
+    EXPECT_DOUBLE_EQ(c.score, best.score);
+
+    apply_eq_candidate(c, SPU, s.tx, s.rx, s.adaption);
+    EXPECT_EQ(s.tx.ffe.taps, best.ffe_taps);
+    EXPECT_EQ(s.tx.ffe.tap_spacing, SPU);
+    EXPECT_DOUBLE_EQ(s.rx.ctle.dc_gain, best.ctle.dc_gain);
+    EXPECT_DOUBLE_EQ(s.rx.vga.dc_gain, best.vga_gain);
+    EXPECT_EQ(s.rx.ctle.poles.size(), 2u);
+    EXPECT_EQ(s.adaption.dfe.initial_taps, best.dfe_taps);
+
+    EXPECT_THROW(load_eq_candidate(path), std::runtime_error);
+}
+
+// 非法参数
+TEST(EqOptimizerTest, RejectsInvalidParameters) {
+    LinkSetup s;
+    EqOptParams p;
+    p.metric = "ber";
+    EXPECT_THROW(EqOptimizer(p, s.tx, s.rx, s.adaption, UI, SPU), std::invalid_argument);
+    p = EqOptParams();
+    p.ffe_max = 1.0;
+    EXPECT_THROW(EqOptimizer(p, s.tx, s.rx, s.adaption, UI, SPU), std::invalid_argument);
+    p = EqOptParams();
+    p.vga_gains = {0.0};
+    EXPECT_THROW(EqOptimizer(p, s.tx, s.rx, s.adaption, UI, SPU), std::invalid_argument);
+    p = EqOptParams();
+    p.top_k = 0;
+    EXPECT_THROW(EqOptimizer(p, s.tx, s.rx, s.adaption, UI, SPU), std::invalid_argument);
+}
@@ -0,0 +1,201 @@
+/**
+ * @file test_eq_seed.cpp
+ * @brief Unit tests for pulse-response extraction and ZF/MMSE equalizer
+ *        seeding, including the adaptation warm-up it removes
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "ams/dfe_feedback.h"
+#include "ams/dfe_tap_update.h"
+#include "ams/eq_seed.h"
+
+using namespace serdes;
+
+namespace {
+
+// 10 Gbps link of the NRZ testbench: 6 dB / 20 GHz channel, CTLE, VGA
+void make_link(TxParams& tx, ChannelParams& ch, RxParams& rx, AdaptionParams& ad) {
+    tx.ffe.taps = {1.0};
+    tx.driver.dc_gain = 1.0;
+    tx.driver.vswing = 0.8;
+    tx.driver.poles = {25e9};
+    tx.driver.sat_mode = "soft";
+    tx.driver.vlin = 0.5;
+    ch.attenuation_db = 6.0;
+    ch.bandwidth_hz = 20e9;
+    rx.ctle.zeros = {1e9};
+    rx.ctle.poles = {3e9, 15e9};
+    rx.ctle.dc_gain = 1.0;
+    rx.vga.zeros = {};
+    rx.vga.poles = {25e9};
+    rx.vga.dc_gain = 2.0;
+    rx.dfe_summer.vtap = 1.0;
+    ad.dfe.num_taps = 5;
+}
+
+// UI-rate sign-sign LMS on x[k] = sum h[j] d[k-j]; UI until taps are within
+// 10% of the post-cursors and stay there. Algorithm-level only: the seeded
+// taps in the real RxDfeSummerTdf are checked in test_eq_seed_summer.cpp
+long sign_lms_warmup(const PulseCursors& cur, const std::vector<double>& initial,
+                     int n_ui) {
+    const int n = static_cast<int>(initial.size());
+    const int L = static_cast<int>(cur.h.size());
+    const double h0 = cur.h[cur.num_pre];
+    std::vector<double> post(n, 0.0);
+    for (int j = 0; j < n && cur.num_pre + 1 + j < L; ++j) post[j] = cur.h[cur.num_pre + 1 + j];
+    double h_norm = 0.0;
+    for (double h : post) h_norm += h * h;
+    h_norm = std::sqrt(h_norm);
+
+    DfeTapUpdater updater;
+    updater.configure(DFEUpdateAlgorithm::SIGN_LMS, n, 0.999, 1.0, 1e-3);
+    DfeBitHistory history;
+    history.resize(n);
+    std::vector<double> c = initial;
+    std::vector<double> tx(L, 1.0);              // tx[j] = d[k + num_pre - j]
+    std::mt19937 rng(21);
+
+    long last_outside = 0;
+    for (int k = 0; k < n_ui; ++k) {
+        for (int j = L - 1; j > 0; --j) tx[j] = tx[j - 1];
+        tx[0] = (rng() & 1u) ? 1.0 : -1.0;
+        double x = 0.0;
+        for (int j = 0; j < L; ++j) x += cur.h[j] * tx[j];
+        double fb = 0.0;
+        for (int j = 0; j < n; ++j) {
+            if (j < static_cast<int>(history.filled())) fb += c[j] * (history.bit(j) ? 1.0 : -1.0);
+        }
+        double y = x - fb;
+        double d = (y > 0.0) ? 1.0 : -1.0;
+        double e = y - d * h0;
+        updater.update(c, history, 1.0 / 2048, (e > 0.0) ? 1.0 : ((e < 0.0) ? -1.0 : 0.0), e);
+        history.push(d > 0.0);
+
+        double err2 = 0.0;
+        for (int j = 0; j < n; ++j) err2 += (c[j] - post[j]) * (c[j] - post[j]);
+        if (std::sqrt(err2) > 0.1 * h_norm) last_outside = k + 1;
+    }
+    return last_outside;
+}
+
+} // namespace
+
+// SIMPLE 信道级联与 ChannelSParamTdf 一阶 IIR 逐样本一致
+TEST(EqSeedTest, SimpleChannelMatchesOnePoleIir) {
+    const double dt = 2e-12;
+    PulseResponseCascade cascade(dt);
+    cascade.add_simple_channel(6.0, 20e9);
+    std::vector<double> p = cascade.pulse(50, 10, 1.0);
+    ASSERT_EQ(p.size(), 500u);
+
+    double wc = 2.0 * M_PI * 20e9;
+    double alpha = wc * dt / (1.0 + wc * dt);
+    double atten = std::pow(10.0, -6.0 / 20.0);
+    double state = 0.0;
+    for (size_t i = 0; i < p.size(); ++i) {
+        state = alpha * ((i < 50) ? 1.0 : 0.0) + (1.0 - alpha) * state;
+        ASSERT_NEAR(p[i], atten * state, 1e-12) << i;
+    }
+}
+
+// 纯 DFE：抽头等于后游标 / vtap
+TEST(EqSeedTest, DfeOnlySeedCancelsPostCursors) {
+    PulseCursors cur;
+    cur.h = {0.01, 0.02, 0.3, 0.08, 0.05, -0.03, 0.01};
+    cur.num_pre = 2;
+    cur.main_sample = 0;
+    EqSeedResult r = compute_eq_seed(cur, 1, 0, 3, 0.5, EqSeedCriterion::ZERO_FORCING, 0.0);
+    ASSERT_EQ(r.dfe_taps.size(), 3u);
+    EXPECT_DOUBLE_EQ(r.dfe_taps[0], 0.16);
+    EXPECT_DOUBLE_EQ(r.dfe_taps[1], 0.10);
+    EXPECT_DOUBLE_EQ(r.dfe_taps[2], -0.06);
+    EXPECT_DOUBLE_EQ(r.main_cursor, 0.3);
+    EXPECT_NEAR(r.residual_isi, 0.01 + 0.02 + 0.01, 1e-15);
+    EXPECT_EQ(r.ffe_taps, std::vector<double>({1.0}));
+}
+
+// ZF FFE 消除预游标与 DFE 范围外的后游标；MMSE 以残余 ISI 换取更小的抽头能量
+TEST(EqSeedTest, ZeroForcingAndMmseFfe) {
+    PulseCursors cur;
+    cur.h = {0.0, 0.04, 0.3, 0.12, 0.06, 0.03, 0.015, 0.008};
+    cur.num_pre = 2;
+    cur.main_sample = 0;
+    EqSeedResult zf = compute_eq_seed(cur, 4, 1, 2, 1.0, EqSeedCriterion::ZERO_FORCING, 0.0);
+    EqSeedResult mmse = compute_eq_seed(cur, 4, 1, 2, 1.0, EqSeedCriterion::MMSE, 0.1);
+
+    for (const EqSeedResult* r : {&zf, &mmse}) {
+        double sum_abs = 0.0;
+        for (double f : r->ffe_taps) sum_abs += std::abs(f);
+        EXPECT_NEAR(sum_abs, 1.0, 1e-12);
+        EXPECT_GT(r->main_cursor, 0.0);
+        // DFE taps are the equalized post-cursors
+        EXPECT_DOUBLE_EQ(r->dfe_taps[0], r->combined[r->main_index + 1]);
+        EXPECT_DOUBLE_EQ(r->dfe_taps[1], r->combined[r->main_index + 2]);
+    }
+
+    // The FFE leaves far less ISI than the channel alone (0.04 + post 3..5)
+    double raw_isi = 0.04 + 0.03 + 0.015 + 0.008;
+    EXPECT_LT(zf.residual_isi, 0.2 * raw_isi * zf.main_cursor / 0.3);
+    EXPECT_LT(std::abs(zf.combined[zf.main_index - 1]), 1e-2 * zf.main_cursor);
+    EXPECT_GE(mmse.residual_isi / mmse.main_cursor, zf.residual_isi / zf.main_cursor);
+}
+
+// 链路脉冲响应种子：DFE 从种子起步无需热身，从零起步需数百 UI
+TEST(EqSeedTest, LinkSeedRemovesDfeWarmup) {
+    TxParams tx;
+    ChannelParams ch;
+    RxParams rx;
+    AdaptionParams ad;
+    make_link(tx, ch, rx, ad);
+    const int spu = 50;
+    const double dt = 1.0 / (10e9 * spu);
+
+    std::vector<double> pulse = link_pulse_response(tx, ch, rx, dt, spu, 64);
+    PulseCursors cur = extract_cursors(pulse, spu, 2, 13);
+    EXPECT_GT(cur.h[cur.num_pre], 0.1);           // Driver 0.4 V, -6 dB, x2 VGA
+
+    EqSeedParams seed;
+    seed.enabled = true;
+    EqSeedResult r = compute_link_eq_seed(seed, tx, ch, rx, ad, dt, spu);
+    ASSERT_EQ(r.dfe_taps.size(), 5u);
+    EXPECT_NEAR(r.dfe_taps[0], cur.h[cur.num_pre + 1], 1e-12);
+
+    apply_eq_seed(r, false, spu, tx, rx, ad);
+    EXPECT_EQ(tx.ffe.taps, std::vector<double>({1.0}));
+    EXPECT_EQ(tx.ffe.tap_spacing, 1);
+    EXPECT_EQ(rx.dfe_summer.tap_coeffs, ad.dfe.initial_taps);
+
+    long from_zero = sign_lms_warmup(cur, std::vector<double>(5, 0.0), 50000);
+    long from_seed = sign_lms_warmup(cur, ad.dfe.initial_taps, 50000);
+    EXPECT_GT(from_zero, 100);
+    EXPECT_LT(from_seed * 10, from_zero);
+
+    // Solving the FFE writes UI-spaced taps
+    seed.ffe_taps = 3;
+    seed.ffe_main = 1;
+    EqSeedResult rf = compute_link_eq_seed(seed, tx, ch, rx, ad, dt, spu);
+    apply_eq_seed(rf, true, spu, tx, rx, ad);
+    EXPECT_EQ(tx.ffe.taps.size(), 3u);
+    EXPECT_EQ(tx.ffe.tap_spacing, spu);
+    EXPECT_GT(tx.ffe.taps[1], std::abs(tx.ffe.taps[0]));
+}
+
+// 非法参数
+TEST(EqSeedTest, RejectsInvalidInput) {
+    EXPECT_THROW(parse_eq_seed_criterion("lms"), std::invalid_argument);
+    EXPECT_EQ(parse_eq_seed_criterion("zf"), EqSeedCriterion::ZERO_FORCING);
+    EXPECT_THROW(PulseResponseCascade(0.0), std::invalid_argument);
+    PulseResponseCascade c(1e-12);
+    EXPECT_THROW(c.add_zero_pole({1e9, 2e9}, {3e9}, 1.0), std::invalid_argument);
+    EXPECT_THROW(extract_cursors({}, 8, 1, 1), std::invalid_argument);
+    PulseCursors cur;
+    cur.h = {0.3, 0.1};
+    cur.num_pre = 0;
+    cur.main_sample = 0;
+    EXPECT_THROW(compute_eq_seed(cur, 3, 3, 1, 1.0, EqSeedCriterion::MMSE, 0.01),
+                 std::invalid_argument);
+}
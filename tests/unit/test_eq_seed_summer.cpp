@@ -0,0 +1,201 @@
+/**
+ * @file test_eq_seed_summer.cpp
+ * @brief Seeded DFE taps loaded into RxDfeSummerTdf cancel the link's
+ *        post-cursor ISI at the sampling instant
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "ams/eq_seed.h"
+#include "ams/rx_dfe_summer.h"
+#include "common/parameters.h"
+
+using namespace serdes;
+
+namespace {
+
+const int SPU = 50;
+const double UI = 100e-12;
+const int NUM_UI = 600;
+const int NUM_TAPS = 5;
+
+/**
+ * @brief Superposition of the link pulse response for random NRZ symbols,
+ *        with an ideal decision and the CDR trigger on the main cursor
+ */
+class PulseTrainSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out_p;
+    sca_tdf::sca_out<double> out_n;
+    sca_tdf::sca_out<double> data;
+    sca_tdf::sca_out<bool> trigger;
+
+    std::vector<double> symbols;
+
+    PulseTrainSource(sc_core::sc_module_name nm, const std::vector<double>& pulse, int main_sample)
+        : sca_tdf::sca_module(nm)
+        , out_p("out_p"), out_n("out_n"), data("data"), trigger("trigger")
+        , m_pulse(pulse), m_main(main_sample), m_n(0), m_decision(0.0)
+    {
+        std::mt19937 rng(17);
+        symbols.resize(NUM_UI + 1);
+        for (double& s : symbols) s = (rng() & 1u) ? 1.0 : -1.0;
+    }
+
+    void set_attributes() override {
+        out_p.set_rate(1);
+        out_n.set_rate(1);
+        data.set_rate(1);
+        trigger.set_rate(1);
+        set_timestep(UI / SPU, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        double y = 0.0;
+        long k_max = std::min<long>(m_n / SPU, NUM_UI);
+        long k_min = std::max<long>(0, (m_n - static_cast<long>(m_pulse.size())) / SPU);
+        for (long k = k_min; k <= k_max; ++k) {
+            long i = m_n - k * SPU;
+            if (i >= 0 && i < static_cast<long>(m_pulse.size())) y += symbols[k] * m_pulse[i];
+        }
+        bool sample = m_n >= m_main && (m_n - m_main) % SPU == 0;
+        if (sample) m_decision = symbols[(m_n - m_main) / SPU] > 0.0 ? 1.0 : 0.0;
+        out_p.write(0.5 * y);
+        out_n.write(-0.5 * y);
+        data.write(m_decision);
+        trigger.write(sample);
+        ++m_n;
+    }
+
+private:
+    std::vector<double> m_pulse;
+    long m_main;
+    long m_n;
+    double m_decision;
+};
+
+class DiffSink : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<double> in_p;
+    sca_tdf::sca_in<double> in_n;
+    std::vector<double> samples;
+
+    DiffSink(sc_core::sc_module_name nm) : sca_tdf::sca_module(nm), in_p("in_p"), in_n("in_n") {}
+
+    void set_attributes() override {
+        in_p.set_rate(1);
+        in_n.set_rate(1);
+    }
+
+    void processing() override { samples.push_back(in_p.read() - in_n.read()); }
+};
+
+SC_MODULE(EqSeedSummerTb) {
+    PulseTrainSource* src;
+    RxDfeSummerTdf* summer_seed;          // Taps from apply_eq_seed()
+    RxDfeSummerTdf* summer_zero;          // No DFE
+    DiffSink* sink_seed;
+    DiffSink* sink_zero;
+
+    sca_tdf::sca_signal<double> sig_p, sig_n, sig_data;
+    sca_tdf::sca_signal<bool> sig_trigger;
+    sca_tdf::sca_signal<double> sig_seed_p, sig_seed_n, sig_zero_p, sig_zero_n;
+    sc_core::sc_signal<double> sig_tap[NUM_TAPS];
+    sc_core::sc_signal<int> sig_seq;
+
+    EqSeedSummerTb(sc_core::sc_module_name nm, const std::vector<double>& pulse, int main_sample,
+                   const RxDfeSummerParams& seeded)
+        : sc_core::sc_module(nm)
+    {
+        RxDfeSummerParams params = seeded;
+        params.ui = UI;
+        params.tap_update_seq = true;     // Sequence stays 0: keep tap_coeffs
+        params.decision_trigger = true;
+        RxDfeSummerParams zero = params;
+        zero.tap_coeffs.assign(NUM_TAPS, 0.0);
+
+        src = new PulseTrainSource("src", pulse, main_sample);
+        summer_seed = new RxDfeSummerTdf("summer_seed", params);
+        summer_zero = new RxDfeSummerTdf("summer_zero", zero);
+        sink_seed = new DiffSink("sink_seed");
+        sink_zero = new DiffSink("sink_zero");
+
+        src->out_p(sig_p);
+        src->out_n(sig_n);
+        src->data(sig_data);
+        src->trigger(sig_trigger);
+        RxDfeSummerTdf* summers[2] = {summer_seed, summer_zero};
+        for (RxDfeSummerTdf* s : summers) {
+            s->in_p(sig_p);
+            s->in_n(sig_n);
+            s->data_in(sig_data);
+            s->sampling_trigger[0](sig_trigger);
+            for (int k = 0; k < NUM_TAPS; ++k) s->tap_de[k](sig_tap[k]);
+            s->tap_seq_de[0](sig_seq);
+        }
+        summer_seed->out_p(sig_seed_p);
+        summer_seed->out_n(sig_seed_n);
+        summer_zero->out_p(sig_zero_p);
+        summer_zero->out_n(sig_zero_n);
+        sink_seed->in_p(sig_seed_p);
+        sink_seed->in_n(sig_seed_n);
+        sink_zero->in_p(sig_zero_p);
+        sink_zero->in_n(sig_zero_n);
+    }
+};
+
+} // namespace
+
+// 种子抽头装入 RxDfeSummerTdf：采样点残余 ISI 不超过种子预测，且远小于无 DFE
+TEST(EqSeedSummerTest, SeededSummerCancelsPostCursors) {
+    TxParams tx;
+    ChannelParams ch;
+    RxParams rx;
+    AdaptionParams ad;
+    tx.ffe.taps = {1.0};
+    tx.driver.poles = {25e9};
+    ch.attenuation_db = 6.0;
+    ch.bandwidth_hz = 20e9;
+    rx.ctle.zeros = {1e9};
+    rx.ctle.poles = {3e9, 15e9};
+    rx.vga.zeros = {};
+    rx.vga.poles = {25e9};
+    rx.vga.dc_gain = 2.0;
+    rx.dfe_summer.vtap = 1.0;
+    ad.dfe.num_taps = NUM_TAPS;
+    const double dt = UI / SPU;
+
+    EqSeedParams seed;
+    seed.enabled = true;
+    EqSeedResult r = compute_link_eq_seed(seed, tx, ch, rx, ad, dt, SPU);
+    apply_eq_seed(r, false, SPU, tx, rx, ad);
+    ASSERT_EQ(rx.dfe_summer.tap_coeffs.size(), static_cast<size_t>(NUM_TAPS));
+
+    std::vector<double> pulse = link_pulse_response(tx, ch, rx, dt, SPU, seed.pulse_ui);
+    PulseCursors cur = extract_cursors(pulse, SPU, 2, NUM_TAPS + 8);
+    double h0 = cur.h[cur.num_pre];
+    ASSERT_GT(h0, 0.0);
+
+    EqSeedSummerTb tb("tb", pulse, cur.main_sample, rx.dfe_summer);
+    sc_core::sc_start(NUM_UI * UI, sc_core::SC_SEC);
+
+    double err_seed = 0.0;
+    double err_zero = 0.0;
+    int first = seed.pulse_ui;            // Full ISI and a full DFE history
+    for (int k = first; k < NUM_UI - 2; ++k) {
+        size_t n = static_cast<size_t>(k) * SPU + cur.main_sample;
+        ASSERT_LT(n, tb.sink_seed->samples.size());
+        double ideal = h0 * tb.src->symbols[k];
+        err_seed = std::max(err_seed, std::abs(tb.sink_seed->samples[n] - ideal));
+        err_zero = std::max(err_zero, std::abs(tb.sink_zero->samples[n] - ideal));
+    }
+    // Left over: pre-cursors and post-cursors beyond the DFE span
+    EXPECT_LE(err_seed, r.residual_isi + 1e-3 * h0);
+    EXPECT_LT(err_seed * 100.0, err_zero);
+
+    sc_core::sc_stop();
+}
@@ -0,0 +1,175 @@
+/**
+ * @file test_eye_histogram_tdf.cpp
+ * @brief EyeHistogramTdf: windows on the CDR trigger, levels from the PRBS
+ *        reference rather than the window's own center sample
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include "ams/eye_histogram_tdf.h"
+#include "common/parameters.h"
+#include "common/prbs.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 100e-12;
+const int SPU = 16;
+const int NUM_UI = 20000;
+const int PEAK_SLOT = 5;                  // Largest |v|: where a free-running grid centers
+const int TRIGGER_SLOT = 8;               // Where the CDR samples
+
+double pulse_shape(int slot) {
+    return 0.2 * std::max(0.1, 1.0 - std::abs(slot - PEAK_SLOT) / 8.0);
+}
+
+/**
+ * @brief PRBS7 NRZ with one post-cursor and Gaussian noise; the sampler
+ *        decision (v > 0 at the trigger) is held on data
+ */
+class NoisyPrbsSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out_p;
+    sca_tdf::sca_out<double> out_n;
+    sca_tdf::sca_out<bool> trigger;
+    sca_tdf::sca_out<double> data;
+
+    NoisyPrbsSource(sc_core::sc_module_name nm)
+        : sca_tdf::sca_module(nm)
+        , out_p("out_p"), out_n("out_n"), trigger("trigger"), data("data")
+        , m_prbs(PRBSType::PRBS7), m_rng(3), m_noise(0.0, 0.04)
+        , m_n(0), m_bit(1.0), m_prev(-1.0), m_decision(0.0) {}
+
+    void set_attributes() override {
+        out_p.set_rate(1);
+        out_n.set_rate(1);
+        trigger.set_rate(1);
+        data.set_rate(1);
+        set_timestep(UI / SPU, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        int slot = static_cast<int>(m_n % SPU);
+        if (slot == 0) {
+            m_prev = m_bit;
+            m_bit = m_prbs.next_bit() ? 1.0 : -1.0;
+        }
+        double v = pulse_shape(slot) * (m_bit + 0.25 * m_prev) + m_noise(m_rng);
+        bool sample = slot == TRIGGER_SLOT;
+        if (sample) m_decision = v > 0.0 ? 1.0 : 0.0;
+        out_p.write(0.5 * v);
+        out_n.write(-0.5 * v);
+        trigger.write(sample);
+        data.write(m_decision);
+        ++m_n;
+    }
+
+private:
+    PrbsLfsr m_prbs;
+    std::mt19937 m_rng;
+    std::normal_distribution<double> m_noise;
+    long m_n;
+    double m_bit;
+    double m_prev;
+    double m_decision;
+};
+
+SC_MODULE(EyeHistogramTb) {
+    NoisyPrbsSource* src;
+    EyeHistogramTdf* hist_ref;            // reference = "prbs"
+    EyeHistogramTdf* hist_center;         // reference = "center"
+
+    sca_tdf::sca_signal<double> sig_p, sig_n, sig_data;
+    sca_tdf::sca_signal<bool> sig_trigger;
+
+    SC_CTOR(EyeHistogramTb) {
+        BathtubParams params;
+        params.ui = UI;
+        params.warmup_ui = 200;
+        params.v_range = 0.6;
+        params.num_bins = 240;
+        PrbsCheckerParams checker;
+        checker.type = PRBSType::PRBS7;
+        BathtubParams center = params;
+        center.reference = "center";
+
+        src = new NoisyPrbsSource("src");
+        hist_ref = new EyeHistogramTdf("hist_ref", params, checker);
+        hist_center = new EyeHistogramTdf("hist_center", center);
+
+        src->out_p(sig_p);
+        src->out_n(sig_n);
+        src->trigger(sig_trigger);
+        src->data(sig_data);
+        hist_ref->in_p(sig_p);
+        hist_ref->in_n(sig_n);
+        hist_ref->sampling_trigger[0](sig_trigger);
+        hist_ref->data_in[0](sig_data);
+        hist_center->in_p(sig_p);
+        hist_center->in_n(sig_n);
+    }
+};
+
+// Samples of the phase on the wrong side of 0 V for their level
+std::uint64_t wrong_side(const EyeHistogram& h, int phase) {
+    const int half = h.get_num_bins() / 2;    // Bin edge at 0 V
+    std::uint64_t n = 0;
+    for (int b = 0; b < h.get_num_bins(); ++b) {
+        n += b < half ? h.count(phase, true, b) : h.count(phase, false, b);
+    }
+    return n;
+}
+
+double level_mean(const EyeHistogram& h, int phase, bool one) {
+    double sum = 0.0;
+    for (int b = 0; b < h.get_num_bins(); ++b) {
+        sum += h.count(phase, one, b) * (h.get_v_min() + (b + 0.5) * h.get_bin_width());
+    }
+    return sum / static_cast<double>(h.total(phase, one));
+}
+
+} // namespace
+
+// 参考比特分类保留内侧尾部（误判样本），窗口中心对齐 CDR 触发；中心样本分类则截断尾部
+TEST(EyeHistogramTdfTest, PrbsReferenceKeepsInnerTailsOnTriggerGrid) {
+    EyeHistogramTb tb("tb");
+    sc_core::sc_start(NUM_UI * UI, sc_core::SC_SEC);
+
+    const EyeHistogram& ref = tb.hist_ref->get_histogram();
+    const EyeHistogram& center = tb.hist_center->get_histogram();
+    const int mid = SPU / 2;
+    ASSERT_GT(tb.hist_ref->get_num_ui(), static_cast<std::uint64_t>(NUM_UI - 400));
+    ASSERT_GT(tb.hist_center->get_num_ui(), 0u);
+
+    // Every wrong decision lands in its transmitted level's inner tail
+    EXPECT_GT(tb.hist_ref->get_num_decision_errors(), 50u);
+    EXPECT_EQ(wrong_side(ref, mid), tb.hist_ref->get_num_decision_errors());
+    EXPECT_EQ(wrong_side(center, mid), 0u);
+
+    // Window center = trigger sample, not the largest-|v| slot
+    EXPECT_EQ(tb.hist_center->get_center_slot(), PEAK_SLOT);
+    EXPECT_NEAR(level_mean(ref, mid, true), pulse_shape(TRIGGER_SLOT), 0.01);
+    EXPECT_NEAR(level_mean(ref, mid, false), -pulse_shape(TRIGGER_SLOT), 0.01);
+
+    // The bathtub at the sampling phase matches the error ratio actually seen
+    BathtubResult r = tb.hist_ref->compute();
+    double measured = static_cast<double>(tb.hist_ref->get_num_decision_errors()) /
+                      static_cast<double>(tb.hist_ref->get_num_ui());
+    EXPECT_NEAR(std::log10(r.ber_threshold[mid]), std::log10(measured), 0.3);
+
+    sc_core::sc_stop();
+}
+
+// 参数校验：reference 取值与判决延迟
+TEST(EyeHistogramTdfTest, RejectsInvalidReference) {
+    BathtubParams p;
+    p.reference = "decision";
+    EXPECT_THROW(validate_bathtub_params(p), std::invalid_argument);
+    p = BathtubParams();
+    p.decision_latency = -1;
+    EXPECT_THROW(validate_bathtub_params(p), std::invalid_argument);
+}
@@ -0,0 +1,141 @@
+/**
+ * @file test_flight_recorder.cpp
+ * @brief Unit tests for the ring-buffer flight recorder
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ams/flight_recorder.h"
+
+using namespace serdes;
+
+namespace {
+
+// Rows of a written capture: {time, ch0, ch1, ...}
+std::vector<std::vector<double>> parse_capture(const FlightRecorder& rec, std::string* header) {
+    std::ostringstream os;
+    rec.write_capture(os);
+    std::istringstream is(os.str());
+    std::string line;
+    std::getline(is, *header);
+    std::vector<std::vector<double>> rows;
+    while (std::getline(is, line)) {
+        std::vector<double> row;
+        std::istringstream ls(line);
+        std::string cell;
+        while (std::getline(ls, cell, ',')) row.push_back(std::stod(cell));
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+void push_sample(FlightRecorder& rec, int n, bool* done = nullptr) {
+    double v[2] = {static_cast<double>(n), -static_cast<double>(n)};
+    bool d = rec.push(n * 1e-12, v);
+    if (done) *done = d;
+}
+
+} // namespace
+
+// 触发后再记录 post 个样本，缓冲区恰为 [触发-pre, 触发+post]，内存固定
+TEST(FlightRecorderTest, CaptureWindowAroundTrigger) {
+    FlightRecorder rec({"a", "b"}, 20, 10, 4);
+    EXPECT_EQ(rec.get_capacity(), 31u);
+    for (int n = 0; n <= 500; ++n) push_sample(rec, n);
+    EXPECT_EQ(rec.get_size(), 31u);
+    EXPECT_TRUE(rec.trigger("test"));
+    EXPECT_DOUBLE_EQ(rec.get_trigger_time(), 500e-12);
+
+    bool done = false;
+    for (int n = 501; n <= 509; ++n) {
+        push_sample(rec, n, &done);
+        EXPECT_FALSE(done);
+    }
+    push_sample(rec, 510, &done);
+    EXPECT_TRUE(done);
+    EXPECT_FALSE(rec.is_capturing());
+
+    std::string header;
+    auto rows = parse_capture(rec, &header);
+    EXPECT_EQ(header, "time_s,a,b");
+    ASSERT_EQ(rows.size(), 31u);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        EXPECT_DOUBLE_EQ(rows[i][1], 480.0 + i);
+        EXPECT_DOUBLE_EQ(rows[i][2], -(480.0 + i));
+        EXPECT_NEAR(rows[i][0], (480.0 + i) * 1e-12, 1e-20);
+    }
+}
+
+// 早期触发：预窗口不足时从第一个样本开始；运行结束时写出截短的捕获
+TEST(FlightRecorderTest, EarlyTriggerAndOpenCapture) {
+    FlightRecorder rec({"a", "b"}, 20, 10, 4);
+    for (int n = 0; n < 5; ++n) push_sample(rec, n);
+    EXPECT_TRUE(rec.trigger("early"));
+    for (int n = 5; n < 8; ++n) push_sample(rec, n);
+    EXPECT_TRUE(rec.is_capturing());
+    std::string header;
+    auto rows = parse_capture(rec, &header);
+    ASSERT_EQ(rows.size(), 8u);
+    EXPECT_DOUBLE_EQ(rows.front()[1], 0.0);
+    EXPECT_DOUBLE_EQ(rows.back()[1], 7.0);
+}
+
+// 捕获进行中的触发被合并，超过 max_captures 后只计数
+TEST(FlightRecorderTest, MergedAndLimitedTriggers) {
+    FlightRecorder rec({"a", "b"}, 4, 3, 2);
+    int n = 0;
+    for (; n < 10; ++n) push_sample(rec, n);
+    EXPECT_TRUE(rec.trigger("first"));
+    push_sample(rec, n++);
+    EXPECT_FALSE(rec.trigger("during"));
+    EXPECT_EQ(rec.get_reason(), "first");
+    for (int i = 0; i < 2; ++i) push_sample(rec, n++);
+    EXPECT_FALSE(rec.is_capturing());
+    EXPECT_TRUE(rec.trigger("second"));
+    for (int i = 0; i < 3; ++i) push_sample(rec, n++);
+    EXPECT_FALSE(rec.trigger("third"));
+    EXPECT_EQ(rec.get_num_captures(), 2);
+    EXPECT_EQ(rec.get_num_triggers(), 4u);
+}
+
+// 通道越界触发一次，回到界内后重新武装
+TEST(FlightRecorderTest, BoundTriggerRearms) {
+    FlightRecorder rec({"tap1", "tap2"}, 4, 2, 8);
+    rec.set_bound(1, 0.5);
+    EXPECT_THROW(rec.set_bound(2, 0.5), std::out_of_range);
+    auto push = [&](double a, double b) { double v[2] = {a, b}; return rec.push(0.0, v); };
+    push(9.0, 0.1);                 // Unbounded channel never triggers
+    EXPECT_EQ(rec.get_num_triggers(), 0u);
+    push(0.0, -0.6);
+    EXPECT_TRUE(rec.is_capturing());
+    EXPECT_EQ(rec.get_reason(), "tap2 out of bound");
+    push(0.0, -0.7);                // Still outside: no new trigger
+    EXPECT_TRUE(push(0.0, -0.7));   // Window complete
+    EXPECT_EQ(rec.get_num_triggers(), 1u);
+    push(0.0, 0.2);
+    push(0.0, 0.9);
+    EXPECT_EQ(rec.get_num_triggers(), 2u);
+    EXPECT_EQ(rec.get_num_captures(), 2);
+}
+
+// 构造参数与配置参数校验
+TEST(FlightRecorderTest, InvalidParameters) {
+    EXPECT_THROW(FlightRecorder({}, 4, 2, 1), std::invalid_argument);
+    EXPECT_THROW(FlightRecorder({"a"}, -1, 2, 1), std::invalid_argument);
+    EXPECT_THROW(FlightRecorder({"a"}, 4, 0, 1), std::invalid_argument);
+    EXPECT_NO_THROW(FlightRecorder({"a"}, 0, 1, 0));
+
+    FlightRecorderParams p;
+    EXPECT_NO_THROW(validate_flight_recorder_params(p));
+    p.post_ui = 0;
+    EXPECT_THROW(validate_flight_recorder_params(p), std::invalid_argument);
+    p = FlightRecorderParams();
+    p.decimation = 0;
+    EXPECT_THROW(validate_flight_recorder_params(p), std::invalid_argument);
+    p = FlightRecorderParams();
+    p.tap_bound = -0.1;
+    EXPECT_THROW(validate_flight_recorder_params(p), std::invalid_argument);
+}
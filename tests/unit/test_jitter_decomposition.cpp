@@ -0,0 +1,237 @@
+/**
+ * @file test_jitter_decomposition.cpp
+ * @brief Unit tests for the streaming TJ/RJ/DJ/DDJ/PJ decomposition and the
+ *        in-sim edge extractor
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "ams/jitter_decomposition.h"
+#include "ams/jitter_monitor_tdf.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 100e-12;
+
+JitterMonitorParams test_params() {
+    JitterMonitorParams p;
+    p.ui = UI;
+    return p;
+}
+
+// Random data; an edge at every transition with TIE = model(k, bits) + RJ
+template <typename Model>
+JitterReport run_data(const JitterMonitorParams& p, int num_ui, double rj, Model model) {
+    JitterDecomposer d(p);
+    std::mt19937 rng(7);
+    std::bernoulli_distribution bit(0.5);
+    std::normal_distribution<double> noise(0.0, rj);
+    unsigned history = 0;
+    for (int k = 0; k < num_ui; ++k) {
+        history = (history << 1) | (bit(rng) ? 1u : 0u);
+        if (k > 0 && ((history ^ (history >> 1)) & 1u)) {
+            d.add_edge(k, model(k, history) + noise(rng), history);
+        }
+    }
+    return d.report();
+}
+
+// Differential NRZ with known edge times: linear 0.3 UI ramps centered on
+// k*UI + 2 ps after a single-UI run + PJ; clk_phase carries its own PJ tone
+class JitteredEdgeSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out_p;
+    sca_tdf::sca_out<double> out_n;
+    sca_tdf::sca_out<double> out_clk;
+
+    JitteredEdgeSource(sc_core::sc_module_name nm, int num_ui, double pj_freq, double pj_amp,
+                       double clk_freq, double clk_amp)
+        : sca_tdf::sca_module(nm)
+        , out_p("out_p"), out_n("out_n"), out_clk("out_clk")
+        , m_bits(num_ui + 2), m_pj_freq(pj_freq), m_pj_amp(pj_amp)
+        , m_clk_freq(clk_freq), m_clk_amp(clk_amp)
+    {
+        std::mt19937 rng(11);
+        for (size_t k = 0; k < m_bits.size(); ++k) m_bits[k] = static_cast<int>(rng() & 1u);
+    }
+
+    void set_attributes() override { set_timestep(10.0, sc_core::SC_PS); }
+
+    void processing() override {
+        double t = get_time().to_seconds();
+        long k = std::max(1L, std::min(static_cast<long>(m_bits.size()) - 1, std::lround(t / UI)));
+        double level_before = m_bits[k - 1] ? 0.5 : -0.5;
+        double level_after = m_bits[k] ? 0.5 : -0.5;
+        double v = level_before;
+        if (level_before != level_after) {
+            double x = std::min(1.0, std::max(0.0, (t - edge_time(k)) / (0.3 * UI) + 0.5));
+            v = level_before + (level_after - level_before) * x;
+        } else if (t >= edge_time(k)) {
+            v = level_after;
+        }
+        out_p.write(0.5 * v);
+        out_n.write(-0.5 * v);
+        out_clk.write(m_clk_amp * std::sin(2.0 * M_PI * m_clk_freq * t));
+    }
+
+private:
+    double edge_time(long k) const {
+        double ddj = (k >= 2 && m_bits[k - 2] != m_bits[k - 1]) ? 2e-12 : 0.0;
+        return k * UI + ddj + m_pj_amp * std::sin(2.0 * M_PI * m_pj_freq * k * UI);
+    }
+
+    std::vector<int> m_bits;
+    double m_pj_freq, m_pj_amp, m_clk_freq, m_clk_amp;
+};
+
+SC_MODULE(JitterMonitorTestbench) {
+    JitteredEdgeSource* src;
+    JitterMonitorTdf* monitor;
+    sca_tdf::sca_signal<double> sig_p, sig_n, sig_clk;
+
+    JitterMonitorTestbench(sc_core::sc_module_name nm, const JitterMonitorParams& params, int num_ui)
+        : sc_core::sc_module(nm)
+    {
+        src = new JitteredEdgeSource("src", num_ui, 20e6, 1.5e-12, 50e6, 0.5e-12);
+        monitor = new JitterMonitorTdf("monitor", params);
+        src->out_p(sig_p);
+        src->out_n(sig_n);
+        src->out_clk(sig_clk);
+        monitor->in_p(sig_p);
+        monitor->in_n(sig_n);
+        monitor->clk_phase(sig_clk);
+    }
+};
+
+} // namespace
+
+// 纯随机抖动：RJ 与设定一致，无 DDJ/PJ，TJ = 2·Q(1e-12)·RJ
+TEST(JitterDecompositionTest, PureRandomJitter) {
+    JitterReport r = run_data(test_params(), 1000000, 1e-12, [](int, unsigned) { return 0.0; });
+    EXPECT_NEAR(r.rj_rms, 1e-12, 0.03e-12);
+    EXPECT_NEAR(r.tie_rms, 1e-12, 0.03e-12);
+    EXPECT_LT(r.ddj_pp, 0.1e-12);
+    EXPECT_TRUE(r.pj_tones.empty());
+    EXPECT_EQ(r.num_patterns, 16);   // 5-bit patterns ending in a transition
+    EXPECT_NEAR(r.tj - r.dj_pp, 2.0 * 7.034 * r.rj_rms, 0.01e-12);
+    EXPECT_GT(r.psd_segments, 100);
+}
+
+// 码型相关抖动：按码型平均分离 DDJ 与 DCD，残差只剩 RJ
+TEST(JitterDecompositionTest, PatternAlignedDdjAndDcd) {
+    // +3 ps after a single-UI run, -1 ps after longer runs; rising edges 0.5 ps late
+    auto isi = [](int, unsigned h) {
+        double t = (((h >> 1) ^ (h >> 2)) & 1u) ? 3e-12 : -1e-12;
+        return t + ((h & 1u) ? 0.25e-12 : -0.25e-12);
+    };
+    JitterReport r = run_data(test_params(), 500000, 0.5e-12, isi);
+    EXPECT_NEAR(r.ddj_pp, 4.5e-12, 0.05e-12);
+    EXPECT_NEAR(r.dcd, 0.5e-12, 0.02e-12);
+    EXPECT_NEAR(r.residual_rms, 0.5e-12, 0.02e-12);
+    EXPECT_NEAR(r.rj_rms, 0.5e-12, 0.02e-12);
+    EXPECT_GT(r.tie_rms, 1e-12);
+    EXPECT_NEAR(r.dj_pp, r.ddj_pp + r.pj_pp, 1e-18);
+}
+
+// 周期抖动：运行谱检出单音，频率与幅度正确，RJ 扣除单音功率
+TEST(JitterDecompositionTest, PeriodicJitterTone) {
+    const double f_pj = 5e6;
+    const double a = 2e-12;   // 4 ps pp
+    auto pj = [&](int k, unsigned) { return a * std::sin(2.0 * M_PI * f_pj * k * UI); };
+    JitterReport r = run_data(test_params(), 2000000, 1e-12, pj);
+    ASSERT_EQ(r.pj_tones.size(), 1u);
+    double bin = 1.0 / (test_params().psd_decimation * UI * test_params().psd_length);
+    EXPECT_NEAR(r.pj_tones[0].frequency, f_pj, bin);
+    EXPECT_NEAR(r.pj_tones[0].amplitude_pp, 2.0 * a, 0.4e-12);
+    EXPECT_NEAR(r.rj_rms, 1e-12, 0.1e-12);
+    EXPECT_GT(r.residual_rms, 1.5e-12);
+    EXPECT_LT(r.ddj_pp, 0.2e-12);
+}
+
+// 恢复时钟：每 UI 一个相位样本、无码型，只分解为 RJ 与 PJ
+TEST(JitterDecompositionTest, ClockStreamWithoutPatterns) {
+    JitterMonitorParams p = test_params();
+    JitterDecomposer d(p);
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 0.3e-12);
+    for (int k = 0; k < 1000000; ++k) {
+        d.add_edge(k, 1e-12 + 1.5e-12 * std::sin(2.0 * M_PI * 20e6 * k * UI) + noise(rng), 0);
+    }
+    JitterReport r = d.report();
+    EXPECT_EQ(r.num_patterns, 1);
+    EXPECT_EQ(r.ddj_pp, 0.0);
+    EXPECT_EQ(r.dcd, 0.0);
+    EXPECT_NEAR(r.mean, 1e-12, 0.01e-12);
+    ASSERT_EQ(r.pj_tones.size(), 1u);
+    EXPECT_NEAR(r.pj_tones[0].frequency, 20e6, 1e6);
+    EXPECT_NEAR(r.pj_tones[0].amplitude_pp, 3e-12, 0.3e-12);
+    EXPECT_NEAR(r.rj_rms, 0.3e-12, 0.05e-12);
+}
+
+// 有界内存：长间隔重启谱段；clear 复位；参数与空数据校验
+TEST(JitterDecompositionTest, GapsClearAndInvalidParameters) {
+    JitterMonitorParams p = test_params();
+    p.psd_length = 64;
+    p.psd_decimation = 1;
+    JitterDecomposer d(p);
+    EXPECT_THROW(d.report(), std::invalid_argument);
+    for (int k = 0; k < 96; ++k) d.add_edge(k, 0.0, 1);
+    EXPECT_EQ(d.get_psd_segments(), 1);
+    d.add_edge(1000000, 0.0, 1);              // Beyond one segment: restart, nothing pushed
+    for (int k = 1; k < 40; ++k) d.add_edge(1000000 + k, 0.0, 1);
+    EXPECT_EQ(d.get_psd_segments(), 1);
+    for (int k = 40; k < 80; ++k) d.add_edge(1000000 + k, 0.0, 1);
+    EXPECT_EQ(d.get_psd_segments(), 2);
+    d.clear();
+    EXPECT_EQ(d.get_num_edges(), 0u);
+    EXPECT_EQ(d.get_psd_segments(), 0);
+
+    JitterMonitorParams bad = test_params();
+    bad.psd_length = 1000;
+    EXPECT_THROW(JitterDecomposer{bad}, std::invalid_argument);
+    bad = test_params();
+    bad.pattern_bits = 0;
+    EXPECT_THROW(JitterDecomposer{bad}, std::invalid_argument);
+    bad = test_params();
+    bad.pj_threshold = 1.0;
+    EXPECT_THROW(JitterDecomposer{bad}, std::invalid_argument);
+    bad = test_params();
+    bad.target_ber = 0.0;
+    EXPECT_THROW(JitterDecomposer{bad}, std::invalid_argument);
+}
+
+// 仿真内边沿提取：亚采样过零插值 + 在线分解，恢复 DDJ、数据 PJ 与时钟 PJ
+TEST(JitterDecompositionTest, MonitorExtractsEdgesInSim) {
+    const int num_ui = 200000;
+    JitterMonitorParams p = test_params();
+    JitterMonitorTestbench* tb = new JitterMonitorTestbench("tb_jitter", p, num_ui);
+
+    sc_core::sc_start(num_ui * UI, sc_core::SC_SEC);
+
+    ASSERT_TRUE(tb->monitor->is_aligned());
+    EXPECT_LT(std::abs(tb->monitor->get_reference_phase()), 3e-12);
+    EXPECT_EQ(tb->monitor->get_dropped_edges(), 0u);
+    EXPECT_GT(tb->monitor->get_num_edges(), 0.4 * (num_ui - p.warmup_ui));
+    EXPECT_NEAR(static_cast<double>(tb->monitor->get_num_clock_samples()), num_ui - p.warmup_ui, 2.0);
+
+    JitterReport data = tb->monitor->data_report();
+    EXPECT_NEAR(data.ddj_pp, 2e-12, 0.1e-12);
+    ASSERT_EQ(data.pj_tones.size(), 1u);
+    EXPECT_NEAR(data.pj_tones[0].frequency, 20e6, 1e6);
+    EXPECT_NEAR(data.pj_tones[0].amplitude_pp, 3e-12, 0.4e-12);
+    EXPECT_LT(data.rj_rms, 0.3e-12);
+
+    JitterReport clock = tb->monitor->clock_report();
+    EXPECT_EQ(clock.ddj_pp, 0.0);
+    ASSERT_EQ(clock.pj_tones.size(), 1u);
+    EXPECT_NEAR(clock.pj_tones[0].frequency, 50e6, 1e6);
+    EXPECT_NEAR(clock.pj_tones[0].amplitude_pp, 1e-12, 0.15e-12);
+
+    sc_core::sc_stop();
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_jtol.cpp
+ * @brief Unit tests for the JTOL masks and the parallel SJ tolerance search
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include "ams/jtol.h"
+
+using namespace serdes;
+
+namespace {
+
+// Link model: tolerates 0.4 UI at high frequency, rising 20 dB/decade below 4 MHz
+double true_tolerance(double f) {
+    return 0.4 * std::max(1.0, 4e6 / f);
+}
+
+JtolParams sweep_params(int workers) {
+    JtolParams p;
+    p.frequencies = {1e5, 1e6, 4e6, 1e7, 1e8, 1e9};
+    p.num_workers = workers;
+    return p;
+}
+
+} // namespace
+
+// 模板：对数-对数插值，两端外保持常数，未知名称报错
+TEST(JtolTest, MaskInterpolation) {
+    JtolMask mask = JtolMask::from_name("ieee_802_3ck");
+    EXPECT_DOUBLE_EQ(mask.limit(1e6), 0.1);
+    EXPECT_DOUBLE_EQ(mask.limit(1e3), 0.1);
+    EXPECT_DOUBLE_EQ(mask.limit(1e10), 0.0005);
+    EXPECT_NEAR(mask.limit(std::sqrt(10e6 * 100e6)), std::sqrt(0.1 * 0.01), 1e-12);
+    EXPECT_EQ(JtolMask::names().size(), 4u);
+    for (const std::string& name : JtolMask::names()) {
+        EXPECT_NO_THROW(JtolMask::from_name(name));
+    }
+    EXPECT_THROW(JtolMask::from_name("sonet"), std::invalid_argument);
+    EXPECT_THROW(JtolMask({1e6}, {0.1}), std::invalid_argument);
+    EXPECT_THROW(JtolMask({1e6, 1e5}, {0.1, 0.1}), std::invalid_argument);
+}
+
+// 每个频点：容限夹在通过/失败幅度之间，区间满足分辨率，合规判定与模板一致
+TEST(JtolTest, BisectionBracketsTolerance) {
+    JtolMask mask = JtolMask::from_name("ieee_802_3ck");
+    JtolParams p = sweep_params(1);
+    JtolResult r = run_jtol_sweep(p, mask, [](double f, double a) { return a <= true_tolerance(f); });
+
+    ASSERT_EQ(r.points.size(), p.frequencies.size());
+    for (const JtolPoint& pt : r.points) {
+        double t = true_tolerance(pt.frequency);
+        EXPECT_LE(pt.tolerance, t) << "f " << pt.frequency;
+        EXPECT_GT(pt.failing, t) << "f " << pt.frequency;
+        EXPECT_LE(pt.failing / pt.tolerance, 1.0 + p.resolution);
+        EXPECT_EQ(pt.pass, t >= pt.mask);
+        EXPECT_NEAR(pt.margin_db, 20.0 * std::log10(pt.tolerance / pt.mask), 1e-9);
+        EXPECT_LE(pt.trials, 16);   // Widening spans at most log2(amp_max / amp_min)
+    }
+    EXPECT_TRUE(r.pass);
+    EXPECT_LT(r.points.front().tolerance, 20.0);   // 16 UI at 100 kHz, below amp_max
+
+    // A weaker link misses the 0.1 UI low-frequency mask
+    JtolResult weak = run_jtol_sweep(p, mask, [](double, double a) { return a <= 0.05; });
+    EXPECT_FALSE(weak.pass);
+    EXPECT_FALSE(weak.points.front().pass);
+    EXPECT_TRUE(weak.points.back().pass);
+}
+
+// 并行：各频点同时运行，结果与单线程完全相同
+TEST(JtolTest, ParallelPointsMatchSerial) {
+    JtolMask mask = JtolMask::from_name("oif_cei_112g");
+    std::atomic<int> in_flight(0), max_in_flight(0);
+    auto trial = [&](double f, double a) {
+        int now = ++in_flight;
+        int seen = max_in_flight.load();
+        while (now > seen && !max_in_flight.compare_exchange_weak(seen, now)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        --in_flight;
+        return a <= true_tolerance(f);
+    };
+    JtolResult serial = run_jtol_sweep(sweep_params(1), mask, trial);
+    EXPECT_EQ(max_in_flight.load(), 1);
+    max_in_flight = 0;
+    JtolResult parallel = run_jtol_sweep(sweep_params(4), mask, trial);
+    EXPECT_GT(max_in_flight.load(), 1);
+
+    ASSERT_EQ(serial.points.size(), parallel.points.size());
+    for (size_t i = 0; i < serial.points.size(); ++i) {
+        EXPECT_EQ(serial.points[i].frequency, parallel.points[i].frequency);
+        EXPECT_EQ(serial.points[i].tolerance, parallel.points[i].tolerance);
+        EXPECT_EQ(serial.points[i].trials, parallel.points[i].trials);
+    }
+    EXPECT_EQ(serial.total_trials, parallel.total_trials);
+}
+
+// 搜索边界：amp_max 仍通过 / amp_min 仍失败
+TEST(JtolTest, SearchLimits) {
+    JtolMask mask = JtolMask::from_name("pcie_gen6");
+    JtolParams p = sweep_params(2);
+    JtolResult always = run_jtol_sweep(p, mask, [](double, double) { return true; });
+    for (const JtolPoint& pt : always.points) {
+        EXPECT_DOUBLE_EQ(pt.tolerance, p.amp_max);
+        EXPECT_EQ(pt.failing, 0.0);
+        EXPECT_TRUE(pt.pass);
+    }
+    JtolResult never = run_jtol_sweep(p, mask, [](double, double) { return false; });
+    for (const JtolPoint& pt : never.points) {
+        EXPECT_EQ(pt.tolerance, 0.0);
+        EXPECT_DOUBLE_EQ(pt.failing, p.amp_min);
+        EXPECT_FALSE(pt.pass);
+        EXPECT_TRUE(std::isinf(pt.margin_db));
+    }
+    EXPECT_FALSE(never.pass);
+}
+
+// 试验异常在所有线程结束后抛出；参数校验
+TEST(JtolTest, ErrorsAndInvalidParameters) {
+    JtolMask mask = JtolMask::from_name("jedec_ddr5");
+    auto broken = [](double f, double) -> bool {
+        if (f > 5e7) throw std::runtime_error("trial crashed");
+        return true;
+    };
+    EXPECT_THROW(run_jtol_sweep(sweep_params(3), mask, broken), std::runtime_error);
+
+    auto ok = [](double, double) { return true; };
+    JtolParams p = sweep_params(1);
+    p.amp_min = 0.0;
+    EXPECT_THROW(run_jtol_sweep(p, mask, ok), std::invalid_argument);
+    p = sweep_params(1);
+    p.amp_max = p.amp_min;
+    EXPECT_THROW(run_jtol_sweep(p, mask, ok), std::invalid_argument);
+    p = sweep_params(1);
+    p.resolution = 0.0;
+    EXPECT_THROW(run_jtol_sweep(p, mask, ok), std::invalid_argument);
+    p = sweep_params(1);
+    p.frequencies.push_back(-1.0);
+    EXPECT_THROW(run_jtol_sweep(p, mask, ok), std::invalid_argument);
+    p = sweep_params(1);
+    p.num_workers = -1;
+    EXPECT_THROW(run_jtol_sweep(p, mask, ok), std::invalid_argument);
+}
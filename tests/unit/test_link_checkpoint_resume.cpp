@@ -0,0 +1,286 @@
+/**
+ * @file test_link_checkpoint_resume.cpp
+ * @brief A link restored from a checkpoint continues exactly like the
+ *        uninterrupted simulation
+ *
+ * SystemC elaborates once per process, so every run (train + save, restore
+ * + continue, uninterrupted reference) is a forked child that writes its
+ * recorded waveforms to a file for the parent to compare.
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ams/channel_sparam.h"
+#include "ams/rx_top.h"
+#include "ams/tx_top.h"
+#include "ams/wave_generation.h"
+#include "common/checkpoint.h"
+#include "common/parameters.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 100e-12;
+const double FS = 80e9;
+// Multiples of both adaption update periods, so the DE schedule of the
+// restored run lines up with the uninterrupted one
+const int TRAIN_UI = 5000;
+const int CONTINUE_UI = 2500;
+
+class ConstSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<double> out;
+
+    ConstSource(sc_core::sc_module_name nm, double v)
+        : sca_tdf::sca_module(nm), out("out"), m_v(v) {}
+
+    void set_attributes() override { out.set_rate(1); }
+    void processing() override { out.write(m_v); }
+
+private:
+    double m_v;
+};
+
+/**
+ * @brief Records the recovered data, the DFE output and the CDR phase
+ */
+class LinkProbe : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_in<double> data;
+    sca_tdf::sca_in<double> dfe_p;
+    sca_tdf::sca_in<double> dfe_n;
+    sca_tdf::sca_in<double> phase;
+
+    std::vector<double> data_samples;
+    std::vector<double> dfe_samples;
+    std::vector<double> phase_samples;
+
+    LinkProbe(sc_core::sc_module_name nm)
+        : sca_tdf::sca_module(nm), data("data"), dfe_p("dfe_p"), dfe_n("dfe_n"), phase("phase") {}
+
+    void set_attributes() override {
+        data.set_rate(1);
+        dfe_p.set_rate(1);
+        dfe_n.set_rate(1);
+        phase.set_rate(1);
+    }
+
+    void processing() override {
+        data_samples.push_back(data.read());
+        dfe_samples.push_back(dfe_p.read() - dfe_n.read());
+        phase_samples.push_back(phase.read());
+    }
+};
+
+// WaveGen (PRBS + RJ) -> TX -> SIMPLE channel -> RX with DFE adaptation
+SC_MODULE(CheckpointLinkTb) {
+    ConstSource* vdd_src;
+    WaveGenerationTdf* wavegen;
+    TxTopModule* tx;
+    ChannelSParamTdf* channel;
+    RxTopModule* rx;
+    LinkProbe* probe;
+
+    sca_tdf::sca_signal<double> sig_vdd, sig_wave, sig_tx_p, sig_tx_n;
+    sca_tdf::sca_signal<double> sig_ch_p, sig_ch_n, sig_data;
+
+    SC_CTOR(CheckpointLinkTb) {
+        WaveGenParams wave;
+        wave.type = PRBSType::PRBS15;
+        wave.jitter.RJ_sigma = 1e-12;
+
+        TxParams txp;
+        txp.ffe.taps = {1.0, -0.15};
+        txp.driver.dc_gain = 1.0;
+        txp.driver.vswing = 0.8;
+        txp.driver.poles = {25e9};
+
+        ChannelParams chp;
+        chp.ports = 4;                    // Differential: in/out p and n
+        chp.attenuation_db = 6.0;
+        chp.bandwidth_hz = 20e9;
+
+        RxParams rxp;
+        rxp.ctle.zeros = {1e9};
+        rxp.ctle.poles = {3e9, 15e9};
+        rxp.ctle.dc_gain = 1.0;
+        rxp.vga.poles = {25e9};
+        rxp.vga.dc_gain = 2.0;
+        rxp.dfe_summer.tap_coeffs = {0.0, 0.0, 0.0};
+        rxp.dfe_summer.ui = UI;
+        rxp.dfe_summer.vtap = 1.0;
+        rxp.sampler.hysteresis = 0.01;
+        rxp.cdr.pi.kp = 0.01;
+        rxp.cdr.pi.ki = 1e-4;
+        rxp.cdr.pai.resolution = 1e-12;
+        rxp.cdr.pai.range = 5e-11;
+        rxp.cdr.ui = UI;
+
+        AdaptionParams ad;
+        ad.Fs = FS;
+        ad.UI = UI;
+        ad.agc.enabled = false;
+        ad.dfe.enabled = true;
+        ad.dfe.num_taps = 3;
+        ad.dfe.initial_taps = {0.0, 0.0, 0.0};
+        ad.cdr_pi.enabled = false;
+        ad.safety.freeze_on_error = false;
+        ad.safety.rollback_enable = false;
+
+        vdd_src = new ConstSource("vdd_src", 1.0);
+        wavegen = new WaveGenerationTdf("wavegen", wave, FS, UI, 7);
+        tx = new TxTopModule("tx", txp);
+        channel = new ChannelSParamTdf("channel", chp, ChannelExtendedParams());
+        rx = new RxTopModule("rx", rxp, ad);
+        probe = new LinkProbe("probe");
+
+        vdd_src->out(sig_vdd);
+        wavegen->out(sig_wave);
+        tx->in(sig_wave);
+        tx->vdd(sig_vdd);
+        tx->out_p(sig_tx_p);
+        tx->out_n(sig_tx_n);
+        channel->in[0](sig_tx_p);
+        channel->in[1](sig_tx_n);
+        channel->out[0](sig_ch_p);
+        channel->out[1](sig_ch_n);
+        rx->in_p(sig_ch_p);
+        rx->in_n(sig_ch_n);
+        rx->vdd(sig_vdd);
+        rx->data_out(sig_data);
+        probe->data(sig_data);
+        probe->dfe_p(const_cast<sca_tdf::sca_signal<double>&>(rx->get_dfe_out_p_signal()));
+        probe->dfe_n(const_cast<sca_tdf::sca_signal<double>&>(rx->get_dfe_out_n_signal()));
+        probe->phase(const_cast<sca_tdf::sca_signal<double>&>(rx->get_cdr_phase_signal()));
+    }
+
+    void save_state(const std::string& path) const {
+        StateCheckpoint cp;
+        wavegen->save_state(cp);
+        tx->save_state(cp);
+        channel->save_state(cp);
+        rx->save_state(cp);
+        cp.save(path);
+    }
+
+    void load_state(const std::string& path) {
+        StateCheckpoint cp;
+        cp.load(path);
+        wavegen->restore_state(cp);
+        tx->restore_state(cp);
+        channel->restore_state(cp);
+        rx->restore_state(cp);
+    }
+};
+
+/**
+ * @brief One simulation in a forked child
+ * @param load Checkpoint to continue from ("" = start fresh)
+ * @param save Checkpoint written at the end ("" = none)
+ * @param out  Recorded waveforms
+ * @return true if the child ran to completion
+ */
+bool run_child(const std::string& load, int num_ui, const std::string& save,
+               const std::string& out) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        int status = 0;
+        try {
+            CheckpointLinkTb tb("tb");
+            if (!load.empty()) {
+                tb.load_state(load);
+            }
+            sc_core::sc_start(num_ui * UI, sc_core::SC_SEC);
+            if (!save.empty()) {
+                tb.save_state(save);
+            }
+            StateCheckpoint rec;
+            rec.put_real("data", tb.probe->data_samples);
+            rec.put_real("dfe", tb.probe->dfe_samples);
+            rec.put_real("phase", tb.probe->phase_samples);
+            rec.save(out);
+        } catch (const std::exception& e) {
+            std::cerr << "child: " << e.what() << std::endl;
+            status = 1;
+        }
+        std::fflush(nullptr);
+        _exit(status);
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid) {
+        return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+std::vector<double> tail(const std::vector<double>& v, size_t n) {
+    return std::vector<double>(v.end() - static_cast<std::ptrdiff_t>(std::min(n, v.size())), v.end());
+}
+
+} // namespace
+
+// 训练 N UI 后保存检查点，新进程恢复再跑 M UI，与不间断 N+M UI 的输出逐样本一致
+TEST(LinkCheckpointResumeTest, RestoredRunMatchesUninterruptedRun) {
+    const std::string prefix = "link_checkpoint_resume_" + std::to_string(getpid());
+    const std::string state = prefix + ".state";
+    const std::string rec_train = prefix + "_train.rec";
+    const std::string rec_resume = prefix + "_resume.rec";
+    const std::string rec_full = prefix + "_full.rec";
+
+    ASSERT_TRUE(run_child("", TRAIN_UI, state, rec_train));
+    ASSERT_TRUE(run_child(state, CONTINUE_UI, "", rec_resume));
+    ASSERT_TRUE(run_child("", TRAIN_UI + CONTINUE_UI, "", rec_full));
+
+    StateCheckpoint resume;
+    StateCheckpoint full;
+    resume.load(rec_resume);
+    full.load(rec_full);
+    for (const char* key : {"data", "dfe", "phase"}) {
+        std::vector<double> r = resume.get_real_vector(key);
+        std::vector<double> f = full.get_real_vector(key);
+        const size_t spu = static_cast<size_t>(FS * UI + 0.5);
+        ASSERT_GE(r.size(), static_cast<size_t>(CONTINUE_UI - 1) * spu) << key;
+        ASSERT_GE(f.size(), r.size()) << key;
+        // Compare the continuation with the same stretch of the reference run
+        std::vector<double> ref = tail(f, r.size());
+        size_t mismatches = 0;
+        size_t first = r.size();
+        for (size_t i = 0; i < r.size(); ++i) {
+            if (r[i] != ref[i]) {
+                ++mismatches;
+                first = std::min(first, i);
+            }
+        }
+        EXPECT_EQ(mismatches, 0u) << key << ": first mismatch at sample " << first;
+    }
+
+    // The comparison is over a live signal, not a constant output
+    std::vector<double> dfe = full.get_real_vector("dfe");
+    double lo = dfe.front();
+    double hi = dfe.front();
+    for (double v : dfe) {
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+    }
+    EXPECT_GT(hi - lo, 0.1);
+
+    std::remove(state.c_str());
+    std::remove(rec_train.c_str());
+    std::remove(rec_resume.c_str());
+    std::remove(rec_full.c_str());
+}
@@ -0,0 +1,102 @@
+/**
+ * @file test_noise_stream_repro.cpp
+ * @brief Unit tests for the counter-based NoiseStream shared by noisy blocks
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "ams/noise_generator.h"
+#include "common/parameters.h"
+
+using namespace serdes;
+
+TEST(NoiseStreamTest, SameSeedAndPathReproduce) {
+    NoiseStream a(12345, "top.rx.ctle");
+    NoiseStream b(12345, "top.rx.ctle");
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(a.next_normal(), b.next_normal());
+    }
+}
+
+TEST(NoiseStreamTest, PathAndSeedSelectIndependentStreams) {
+    NoiseStream a(12345, "top.rx.ctle");
+    NoiseStream b(12345, "top.rx.vga");
+    NoiseStream c(12346, "top.rx.ctle");
+    int equal_ab = 0, equal_ac = 0;
+    for (int i = 0; i < 1000; ++i) {
+        double za = a.next_normal();
+        if (za == b.next_normal()) ++equal_ab;
+        if (za == c.next_normal()) ++equal_ac;
+    }
+    EXPECT_EQ(equal_ab, 0);
+    EXPECT_EQ(equal_ac, 0);
+}
+
+TEST(NoiseStreamTest, RandomAccessMatchesSequential) {
+    NoiseStream seq(7, "tb.sampler");
+    std::vector<double> z(1000);
+    for (auto& v : z) v = seq.next_normal();
+
+    NoiseStream ra(7, "tb.sampler");
+    for (size_t i = 0; i < z.size(); i += 37) {
+        EXPECT_EQ(ra.normal_at(i), z[i]);
+    }
+
+    // Batch fill from an unaligned index
+    std::vector<double> batch(101);
+    ra.fill_normal(13, batch.data(), batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_EQ(batch[i], z[13 + i]);
+    }
+
+    // Resume from a saved position
+    NoiseStream resumed(7, "tb.sampler");
+    resumed.set_position(500, 0);
+    EXPECT_EQ(resumed.next_normal(), z[500]);
+    EXPECT_EQ(resumed.get_normal_position(), 501u);
+}
+
+TEST(NoiseStreamTest, NormalMoments) {
+    NoiseStream s(12345, "moments");
+    const int N = 200000;
+    double sum = 0.0, sum2 = 0.0, sum4 = 0.0;
+    for (int i = 0; i < N; ++i) {
+        double z = s.next_normal();
+        sum += z;
+        sum2 += z * z;
+        sum4 += z * z * z * z;
+    }
+    double mean = sum / N;
+    double var = sum2 / N - mean * mean;
+    EXPECT_NEAR(mean, 0.0, 0.01);
+    EXPECT_NEAR(var, 1.0, 0.02);
+    EXPECT_NEAR(sum4 / N, 3.0, 0.1);
+}
+
+TEST(NoiseStreamTest, UniformRange) {
+    NoiseStream s(1, "uniform");
+    double sum = 0.0;
+    for (int i = 0; i < 100000; ++i) {
+        double u = s.next_uniform();
+        ASSERT_GT(u, 0.0);
+        ASSERT_LT(u, 1.0);
+        sum += u;
+    }
+    EXPECT_NEAR(sum / 100000, 0.5, 0.01);
+}
+
+TEST(NoiseStreamTest, LinkSeedFeedsBlocksWithoutOverride) {
+    SystemParams p;
+    p.global.seed = 777;
+    p.rx.vga.noise_seed = 42;
+    p.apply_global_seed();
+    EXPECT_EQ(p.rx.ctle.noise_seed, 777u);
+    EXPECT_EQ(p.rx.sampler.noise_seed, 777u);
+    EXPECT_EQ(p.clock.pll.noise_seed, 777u);
+    EXPECT_EQ(p.rx.vga.noise_seed, 42u);
+
+    // No seed configured anywhere: the documented default
+    EXPECT_EQ(NoiseStream(0, "top.rx.ctle").get_key(),
+              NoiseStream(DEFAULT_SEED, "top.rx.ctle").get_key());
+}
@@ -0,0 +1,138 @@
+/**
+ * @file test_pll_phase_model.cpp
+ * @brief Unit tests for the phase-domain charge-pump PLL model
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "ams/pll_phase_model.h"
+
+using namespace serdes;
+
+namespace {
+
+// Default loop (50 uA, 10 kOhm, 100 pF, 100 MHz/V, /4) at 10 GHz
+ClockPllParams default_loop() {
+    ClockPllParams p;
+    p.vco_f0 = 10e9;
+    return p;
+}
+
+// Output phase error vs an ideal clock, in output UI (cycles), with unwrap
+double tie_cycles(double phase, double t, double f) {
+    double ideal = f * t;
+    double d = phase - (ideal - std::floor(ideal));
+    return d - std::round(d);
+}
+
+} // namespace
+
+// 预充电锁定：任意时间步长下相位均线性增长
+TEST(PllPhaseModelTest, LockedLoopTracksIdealPhaseAtAnyTimestep) {
+    for (double dt : {1e-12, 0.37e-12, 3.1e-12, 97e-12}) {
+        PllPhaseModel pll;
+        pll.configure(default_loop(), 10e9, "pll");
+        double t = 0.0;
+        for (int i = 0; i < 20000; ++i) {
+            pll.advance(dt);
+            t += dt;
+            ASSERT_NEAR(tie_cycles(pll.phase(), t, 10e9), 0.0, 1e-6) << "dt=" << dt << " i=" << i;
+        }
+        EXPECT_NEAR(pll.frequency(), 10e9, 1.0);
+        EXPECT_NEAR(static_cast<double>(pll.get_ref_edges()), t / pll.get_ref_period(), 1.5);
+    }
+}
+
+// 频偏启动：环路锁定，锁定轨迹与时间步长无关
+TEST(PllPhaseModelTest, AcquiresLockIndependentOfTimestep) {
+    ClockPllParams p = default_loop();
+    p.initial_freq_offset = 20e6;
+
+    const double t_end = 10e-6;
+    std::vector<double> vctrl;
+    for (double dt : {1e-12, 7.3e-12}) {
+        PllPhaseModel pll;
+        pll.configure(p, 10e9, "pll");
+        EXPECT_NEAR(pll.frequency(), 10.02e9, 1.0);
+        long n = static_cast<long>(std::llround(t_end / dt));
+        double max_err = 0.0;
+        for (long i = 0; i < n; ++i) {
+            pll.advance(dt);
+            max_err = std::max(max_err, std::abs(pll.get_phase_error()));
+        }
+        EXPECT_GT(max_err, 0.1);                       // Real acquisition transient
+        EXPECT_LT(std::abs(pll.get_phase_error()), 1e-4);
+        EXPECT_NEAR(pll.frequency(), 10e9, 1e3);
+        vctrl.push_back(pll.get_control_voltage());
+    }
+    // Loop state is set by the reference edges, not by the sampling grid
+    EXPECT_NEAR(vctrl[0], vctrl[1], 1e-6);
+}
+
+// VCO 随机游走抖动被环路高通滤除：闭环 TIE 有界，远小于开环累积
+TEST(PllPhaseModelTest, LoopBoundsVcoPhaseNoise) {
+    ClockPllParams p = default_loop();
+    p.vco_jitter_rms = 20e-15;            // 20 fs per cycle
+
+    PllPhaseModel pll;
+    pll.configure(p, 10e9, "pll");
+    const double dt = 10e-12;
+    const long n = 2000000;              // 20 us, many loop time constants
+    double t = 0.0;
+    double sum2 = 0.0;
+    long count = 0;
+    for (long i = 0; i < n; ++i) {
+        pll.advance(dt);
+        t += dt;
+        if (i > n / 2) {
+            double e = tie_cycles(pll.phase(), t, 10e9);
+            sum2 += e * e;
+            ++count;
+        }
+    }
+    double tie_rms_s = std::sqrt(sum2 / count) / 10e9;
+    // Open loop the error would random-walk to 20 fs * sqrt(2e5 cycles) ~ 9 ps
+    double open_loop_s = 20e-15 * std::sqrt(10e9 * t);
+    EXPECT_GT(tie_rms_s, 20e-15);
+    EXPECT_LT(tie_rms_s, 0.2 * open_loop_s);
+}
+
+// 上升沿时刻：锁定时插值边沿落在理想时钟边沿上
+TEST(PllPhaseModelTest, EdgeOffsetMatchesIdealEdges) {
+    PllPhaseModel pll;
+    pll.configure(default_loop(), 10e9, "pll");
+    const double dt = 0.37e-12;
+    double t = 0.0;
+    int edges = 0;
+    for (int i = 0; i < 10000; ++i) {
+        pll.advance(dt);
+        if (pll.get_last_edge_offset() >= 0.0) {
+            ASSERT_LT(pll.get_last_edge_offset(), dt);
+            double edge = t + pll.get_last_edge_offset();
+            double cycles = edge * 10e9;
+            ASSERT_NEAR(cycles, std::round(cycles), 1e-6) << "i=" << i;
+            ++edges;
+        }
+        t += dt;
+    }
+    EXPECT_NEAR(edges, t * 10e9, 1.0);
+    pll.reset();
+    EXPECT_EQ(pll.get_last_edge_offset(), -1.0);
+}
+
+// 参数校验
+TEST(PllPhaseModelTest, RejectsInvalidParameters) {
+    PllPhaseModel pll;
+    ClockPllParams p = default_loop();
+    p.pd_type = "bang-bang";
+    EXPECT_THROW(pll.configure(p, 10e9, "pll"), std::invalid_argument);
+    p = default_loop();
+    p.lf_C = 0.0;
+    EXPECT_THROW(pll.configure(p, 10e9, "pll"), std::invalid_argument);
+    p = default_loop();
+    p.vco_jitter_rms = -1e-15;
+    EXPECT_THROW(pll.configure(p, 10e9, "pll"), std::invalid_argument);
+    EXPECT_THROW(pll.configure(default_loop(), 0.0, "pll"), std::invalid_argument);
+}
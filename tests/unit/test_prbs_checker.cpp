@@ -0,0 +1,131 @@
+/**
+ * @file test_prbs_checker.cpp
+ * @brief Unit tests for the self-synchronizing PRBS checker / BER counter
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include "ams/prbs_sync_checker.h"
+
+using namespace serdes;
+
+namespace {
+
+PrbsCheckerParams checker_params(PRBSType type) {
+    PrbsCheckerParams p;
+    p.type = type;
+    return p;
+}
+
+} // namespace
+
+// 自同步：任意种子与链路延迟，锁定后零误码
+TEST(PrbsCheckerTest, SynchronizesToAnySeedAndLatency) {
+    for (PRBSType type : {PRBSType::PRBS7, PRBSType::PRBS15, PRBSType::PRBS31}) {
+        PrbsSyncChecker checker;
+        checker.configure(checker_params(type));
+        std::mt19937 rng(7);
+        for (int i = 0; i < 37; ++i) checker.push(rng() & 1u);     // Link latency / garbage
+
+        PrbsLfsr tx(type, 12345);
+        int lock_bit = -1;
+        for (int i = 0; i < 100000; ++i) {
+            checker.push(tx.next_bit());
+            if (lock_bit < 0 && checker.is_locked()) lock_bit = i;
+        }
+        const int length = get_prbs_config(type).length;
+        EXPECT_GE(lock_bit, 0);
+        EXPECT_LE(lock_bit, length + 64 + 37) << "type " << static_cast<int>(type);
+        EXPECT_FALSE(checker.is_inverted());
+        EXPECT_EQ(checker.get_error_count(), 0u);
+        EXPECT_EQ(checker.get_bit_count(), static_cast<std::uint64_t>(100000 - 1 - lock_bit));
+        EXPECT_EQ(checker.get_sync_losses(), 0u);
+    }
+}
+
+// 注入误码：计数精确，突发按 burst_gap 分组
+TEST(PrbsCheckerTest, CountsInjectedErrorsAndBursts) {
+    PrbsCheckerParams p = checker_params(PRBSType::PRBS15);
+    p.burst_gap = 32;
+    PrbsSyncChecker checker;
+    checker.configure(p);
+    PrbsLfsr tx(PRBSType::PRBS15, 1);
+    for (int i = 0; i < 200; ++i) checker.push(tx.next_bit());
+    ASSERT_TRUE(checker.is_locked());
+
+    // Isolated errors far apart, plus one burst of 5 errors spanning 9 bits
+    std::set<int> flips = {1000, 5000, 9000, 20000, 20002, 20004, 20006, 20008};
+    for (int i = 0; i < 40000; ++i) {
+        bool b = tx.next_bit();
+        checker.push(flips.count(i) ? !b : b);
+    }
+    EXPECT_GT(checker.get_bit_count(), 40000u);
+    EXPECT_EQ(checker.get_error_count(), flips.size());
+    EXPECT_EQ(checker.get_burst_count(), 4u);
+    EXPECT_EQ(checker.get_max_burst_length(), 9u);
+    EXPECT_EQ(checker.get_max_burst_errors(), 5u);
+    EXPECT_NEAR(checker.get_ber(), 8.0 / checker.get_bit_count(), 1e-15);
+    EXPECT_GT(checker.get_ber_upper(), checker.get_ber());
+}
+
+// 极性反转：锁定反相图样，零误码
+TEST(PrbsCheckerTest, LocksToInvertedPattern) {
+    PrbsSyncChecker checker;
+    checker.configure(checker_params(PRBSType::PRBS9));
+    PrbsLfsr tx(PRBSType::PRBS9, 3);
+    for (int i = 0; i < 10000; ++i) checker.push(!tx.next_bit());
+    EXPECT_TRUE(checker.is_locked());
+    EXPECT_TRUE(checker.is_inverted());
+    EXPECT_EQ(checker.get_error_count(), 0u);
+}
+
+// 比特滑移：判为失步，不计入误码，重新锁定
+TEST(PrbsCheckerTest, BitSlipTriggersResync) {
+    PrbsSyncChecker checker;
+    checker.configure(checker_params(PRBSType::PRBS31));
+    PrbsLfsr tx(PRBSType::PRBS31, 9);
+    for (int i = 0; i < 1000; ++i) checker.push(tx.next_bit());
+    ASSERT_TRUE(checker.is_locked());
+    tx.next_bit();                                  // Receiver drops one bit
+    for (int i = 0; i < 1000; ++i) checker.push(tx.next_bit());
+    EXPECT_EQ(checker.get_sync_losses(), 1u);
+    EXPECT_TRUE(checker.is_locked());
+    EXPECT_LE(checker.get_error_count(), 64u);      // At most the partial word before the slip
+}
+
+// 置信区间：零误码 -ln(1-CL)/N，随误码单调增加，大误码数近似连续
+TEST(PrbsCheckerTest, BerUpperBound) {
+    const std::uint64_t n = 1000000000000ull;
+    EXPECT_NEAR(ber_upper_bound(0, n, 0.95) * n, -std::log(0.05), 1e-9);
+    EXPECT_NEAR(ber_upper_bound(0, n, 0.99) * n, -std::log(0.01), 1e-9);
+    EXPECT_NEAR(ber_upper_bound(1, n, 0.95) * n, 4.7439, 1e-3);       // Chi-square table
+    EXPECT_NEAR(ber_upper_bound(10, n, 0.95) * n, 16.9622, 1e-3);
+    double prev = 0.0;
+    for (std::uint64_t e : {0ull, 1ull, 5ull, 100ull, 1000ull, 1001ull, 5000ull}) {
+        double b = ber_upper_bound(e, n, 0.95);
+        EXPECT_GT(b, prev);
+        EXPECT_GT(b * n, static_cast<double>(e));
+        prev = b;
+    }
+    EXPECT_NEAR(ber_upper_bound(1000, n, 0.95) / ber_upper_bound(1001, n, 0.95), 1.0, 2e-3);
+    EXPECT_EQ(ber_upper_bound(0, 0, 0.95), 1.0);
+    EXPECT_THROW(ber_upper_bound(0, n, 1.0), std::invalid_argument);
+}
+
+// 非法参数
+TEST(PrbsCheckerTest, RejectsInvalidParameters) {
+    PrbsSyncChecker checker;
+    PrbsCheckerParams p;
+    p.sync_bits = 0;
+    EXPECT_THROW(checker.configure(p), std::invalid_argument);
+    p = PrbsCheckerParams();
+    p.loss_errors = 65;
+    EXPECT_THROW(checker.configure(p), std::invalid_argument);
+    p = PrbsCheckerParams();
+    p.confidence = 0.0;
+    EXPECT_THROW(checker.configure(p), std::invalid_argument);
+}
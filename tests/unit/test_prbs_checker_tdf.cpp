@@ -0,0 +1,124 @@
+/**
+ * @file test_prbs_checker_tdf.cpp
+ * @brief PrbsCheckerTdf takes one bit per CDR trigger, after the decision
+ *        latency, also when the UI is not a whole number of timesteps
+ */
+
+#include <gtest/gtest.h>
+#include <systemc-ams>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include "ams/prbs_checker.h"
+#include "common/parameters.h"
+#include "common/prbs.h"
+
+using namespace serdes;
+
+namespace {
+
+const double UI = 100e-12;
+const double DT = UI / 12.5;              // Triggers 12 and 13 samples apart
+const int LATENCY = 20;                   // Longer than the trigger spacing
+const int NUM_UI = 20000;
+
+/**
+ * @brief Trigger at the sample nearest each UI center; the decision for it
+ *        is held on data LATENCY samples later
+ */
+class TriggeredPrbsSource : public sca_tdf::sca_module {
+public:
+    sca_tdf::sca_out<bool> trigger;
+    sca_tdf::sca_out<double> data;
+    int num_triggers;
+
+    TriggeredPrbsSource(sc_core::sc_module_name nm)
+        : sca_tdf::sca_module(nm), trigger("trigger"), data("data")
+        , num_triggers(0), m_prbs(PRBSType::PRBS15), m_n(0), m_ui(0), m_held(0.0) {}
+
+    void set_attributes() override {
+        trigger.set_rate(1);
+        data.set_rate(1);
+        set_timestep(DT, sc_core::SC_SEC);
+    }
+
+    void processing() override {
+        for (auto& p : m_pending) {
+            --p.first;
+        }
+        bool fire = std::lround((m_ui + 0.5) * 12.5) == m_n;
+        if (fire) {
+            ++num_triggers;
+            ++m_ui;
+            m_pending.emplace_back(LATENCY, m_prbs.next_bit() ? 1.0 : 0.0);
+        }
+        while (!m_pending.empty() && m_pending.front().first <= 0) {
+            m_held = m_pending.front().second;
+            m_pending.pop_front();
+        }
+        trigger.write(fire);
+        data.write(m_held);
+        ++m_n;
+    }
+
+private:
+    PrbsLfsr m_prbs;
+    long m_n;
+    long m_ui;
+    double m_held;
+    std::deque<std::pair<int, double>> m_pending;
+};
+
+SC_MODULE(PrbsCheckerTb) {
+    TriggeredPrbsSource* src;
+    PrbsCheckerTdf* checker;
+
+    sca_tdf::sca_signal<bool> sig_trigger;
+    sca_tdf::sca_signal<double> sig_data;
+    sc_core::sc_signal<bool> sig_locked;
+    sc_core::sc_signal<double> sig_bits, sig_errors, sig_ber, sig_ber_upper;
+    sc_core::sc_signal<int> sig_bursts, sig_max_burst, sig_sync_losses;
+
+    SC_CTOR(PrbsCheckerTb) {
+        PrbsCheckerParams params;
+        params.type = PRBSType::PRBS15;
+        params.use_trigger = true;
+        params.decision_latency = LATENCY;
+
+        src = new TriggeredPrbsSource("src");
+        checker = new PrbsCheckerTdf("checker", params);
+        src->trigger(sig_trigger);
+        src->data(sig_data);
+        checker->trigger[0](sig_trigger);
+        checker->data_in(sig_data);
+        checker->locked(sig_locked);
+        checker->bit_count(sig_bits);
+        checker->error_count(sig_errors);
+        checker->ber(sig_ber);
+        checker->ber_upper(sig_ber_upper);
+        checker->burst_count(sig_bursts);
+        checker->max_burst(sig_max_burst);
+        checker->sync_losses(sig_sync_losses);
+    }
+};
+
+} // namespace
+
+// 非整数 UI/dt：每个触发取一个比特（判决延迟后），锁定后零误码
+TEST(PrbsCheckerTdfTest, OneBitPerTriggerAfterDecisionLatency) {
+    PrbsCheckerTb tb("tb");
+    sc_core::sc_start(NUM_UI * UI, sc_core::SC_SEC);
+
+    const PrbsSyncChecker& chk = tb.checker->get_checker();
+    const std::uint64_t triggers = static_cast<std::uint64_t>(tb.src->num_triggers);
+    EXPECT_NEAR(static_cast<double>(triggers), NUM_UI, 1.0);
+    EXPECT_TRUE(chk.is_locked());
+    EXPECT_EQ(chk.get_error_count(), 0u);
+    EXPECT_EQ(chk.get_sync_losses(), 0u);
+    // One bit per trigger, less the ones acquiring the pattern and the
+    // last ones still waiting for their decision
+    EXPECT_LE(chk.get_bit_count(), triggers);
+    EXPECT_GE(chk.get_bit_count(), triggers - 200);
+
+    sc_core::sc_stop();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file test_pulse_extract.cpp
+ * @brief Unit tests for single-bit-response extraction
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "ams/pulse_response_collector.h"
+
+using namespace serdes;
+
+namespace {
+
+// Two cascaded one-pole sections plus a DC offset, stepped like a TDF chain
+class TwoPoleLink {
+public:
+    TwoPoleLink(double a1, double a2, double gain, double offset)
+        : m_a1(a1), m_a2(a2), m_gain(gain), m_offset(offset), m_y1(0.0), m_y2(0.0) {}
+    double step(double x) {
+        m_y1 += m_a1 * (m_gain * x - m_y1);
+        m_y2 += m_a2 * (m_y1 - m_y2);
+        return m_y2 + m_offset;
+    }
+private:
+    double m_a1, m_a2, m_gain, m_offset, m_y1, m_y2;
+};
+
+// Stimulus as PulseStimulusTdf: lead zeros, then a one-UI pulse or a step
+double stimulus(const PulseExtractParams& p, int spu, long n) {
+    long edge = static_cast<long>(p.lead_ui) * spu;
+    bool high = n >= edge && (p.mode == "step" || n < edge + spu);
+    return high ? p.amplitude : 0.0;
+}
+
+PulseResponseCollector run(const PulseExtractParams& p, int spu, double offset, long limit = 100000) {
+    PulseResponseCollector c;
+    c.configure(p, spu);
+    TwoPoleLink link(0.05, 0.1, 0.5, offset);
+    for (long n = 0; n < limit && !c.push(link.step(stimulus(p, spu, n))); ++n) {
+    }
+    return c;
+}
+
+} // namespace
+
+// 脉冲模式：去除基线，尾能量衰减后停止，归一化到幅度
+TEST(PulseExtractTest, PulseModeRemovesBaselineAndStopsOnTail) {
+    PulseExtractParams p;
+    p.amplitude = 0.5;
+    const int spu = 16;
+    PulseResponseCollector c = run(p, spu, 0.3);
+    ASSERT_TRUE(c.is_done());
+    EXPECT_TRUE(c.is_converged());
+    EXPECT_NEAR(c.get_baseline(), 0.3, 1e-12);
+    EXPECT_LT(c.get_tail_ratio(), p.tail_threshold);
+    EXPECT_EQ(c.get_pulse().size() % spu, 0u);
+    EXPECT_LT(c.get_pulse().size(), static_cast<size_t>(p.max_ui) * spu);
+
+    // Reference: the same link driven by a unit pulse without offset
+    TwoPoleLink ref(0.05, 0.1, 0.5, 0.0);
+    for (size_t n = 0; n < c.get_pulse().size(); ++n) {
+        double expected = ref.step(n < static_cast<size_t>(spu) ? 1.0 : 0.0);
+        EXPECT_NEAR(c.get_pulse()[n], expected, 1e-12);
+    }
+}
+
+// 阶跃叠加模式与脉冲模式一致
+TEST(PulseExtractTest, StepModeMatchesPulseMode) {
+    PulseExtractParams p;
+    const int spu = 8;
+    PulseResponseCollector pulse = run(p, spu, 0.0);
+    p.mode = "step";
+    PulseResponseCollector step = run(p, spu, -0.1);
+    ASSERT_TRUE(step.is_converged());
+    size_t n = std::min(pulse.get_pulse().size(), step.get_pulse().size());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(step.get_pulse()[i], pulse.get_pulse()[i], 1e-12);
+    }
+    EXPECT_EQ(step.get_main_sample(), pulse.get_main_sample());
+}
+
+// 各相位游标对齐：中心相位第 0 列为峰值
+TEST(PulseExtractTest, PhaseCursorsAreAlignedToPeak) {
+    PulseExtractParams p;
+    const int spu = 8;
+    PulseResponseCollector c = run(p, spu, 0.0);
+    std::vector<std::vector<double>> t = c.get_phase_cursors(2, 5);
+    ASSERT_EQ(t.size(), static_cast<size_t>(spu));
+    ASSERT_EQ(t[0].size(), 8u);
+    const std::vector<double>& h = c.get_pulse();
+    int m = c.get_main_sample();
+    EXPECT_EQ(t[spu / 2][2], h[m]);
+    EXPECT_EQ(t[spu / 2][3], h[m + spu]);
+    EXPECT_EQ(t[0][2], h[m - spu / 2]);
+    for (int p2 = 0; p2 < spu; ++p2) {
+        EXPECT_LE(std::fabs(t[p2][2]), std::fabs(h[m]));
+    }
+}
+
+// 达到 max_ui 时停止但标记未收敛
+TEST(PulseExtractTest, MaxLengthBoundsTheRun) {
+    PulseExtractParams p;
+    p.tail_threshold = 1e-30;
+    p.max_ui = 20;
+    PulseResponseCollector c = run(p, 8, 0.0);
+    EXPECT_TRUE(c.is_done());
+    EXPECT_FALSE(c.is_converged());
+    EXPECT_EQ(c.get_pulse().size(), 160u);
+}
+
+// 非法参数
+TEST(PulseExtractTest, RejectsInvalidParameters) {
+    PulseResponseCollector c;
+    PulseExtractParams p;
+    p.mode = "impulse";
+    EXPECT_THROW(c.configure(p, 8), std::invalid_argument);
+    p = PulseExtractParams();
+    p.min_ui = 2;                    // Shorter than tail_ui
+    EXPECT_THROW(c.configure(p, 8), std::invalid_argument);
+    p = PulseExtractParams();
+    p.amplitude = 0.0;
+    EXPECT_THROW(c.configure(p, 8), std::invalid_argument);
+    EXPECT_THROW(c.configure(PulseExtractParams(), 0), std::invalid_argument);
+}
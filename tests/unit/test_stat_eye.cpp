@@ -0,0 +1,147 @@
+/**
+ * @file test_stat_eye.cpp
+ * @brief Unit tests for the statistical-eye engine
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "ams/stat_eye.h"
+
+using namespace serdes;
+
+namespace {
+
+double q_func(double x) {
+    return 0.5 * std::erfc(x / std::sqrt(2.0));
+}
+
+// Trapezoid-free pulse: flat cursors held for a whole UI each
+std::vector<double> ui_pulse(const std::vector<double>& cursors, int spu, int lead_ui) {
+    std::vector<double> p(static_cast<size_t>(lead_ui) * spu, 0.0);
+    for (double c : cursors) {
+        for (int s = 0; s < spu; ++s) p.push_back(c);
+    }
+    for (int s = 0; s < 4 * spu; ++s) p.push_back(0.0);
+    return p;
+}
+
+} // namespace
+
+// 无 ISI：阈值处 BER 等于高斯 Q 函数
+TEST(StatEyeTest, GaussianNoiseOnlyMatchesQFunction) {
+    StatEyeParams p;
+    p.noise_sigma = 0.015;
+    p.voltage_bins = 512;
+    std::vector<double> pulse = ui_pulse({0.1}, 8, 2);
+    StatEyeResult r = compute_stat_eye(pulse, 8, p);
+
+    int center = r.num_phases / 2;
+    double expected = q_func(0.1 / 0.015);
+    EXPECT_NEAR(r.ber_zero[center] / expected, 1.0, 0.05);
+    int v = r.num_bins / 2 + r.num_bins / 8;                 // v = 0.05 V
+    double vv = r.voltage[v];
+    double ber_v = 0.5 * (q_func((0.1 - vv) / 0.015) + q_func((0.1 + vv) / 0.015));
+    EXPECT_NEAR(r.ber_at(center, v) / ber_v, 1.0, 0.05);
+    EXPECT_NEAR(r.main_cursor, 0.1, 1e-12);
+}
+
+// 与穷举法一致（少量游标 + 噪声）
+TEST(StatEyeTest, MatchesBruteForceEnumeration) {
+    const std::vector<double> c = {0.02, 0.2, 0.05, -0.03, 0.01};   // Main is index 1
+    const double sigma = 0.02;
+    StatEyeParams p;
+    p.noise_sigma = sigma;
+    p.voltage_bins = 1024;
+    StatEyeResult r = compute_stat_eye(ui_pulse(c, 4, 1), 4, p);
+
+    double brute = 0.0;
+    const int others = 4;
+    for (int m = 0; m < (1 << others); ++m) {
+        double isi = 0.0;
+        int b = 0;
+        for (size_t i = 0; i < c.size(); ++i) {
+            if (i == 1) continue;
+            isi += ((m >> b++) & 1 ? 1.0 : -1.0) * c[i];
+        }
+        brute += q_func((0.2 + isi) / sigma);
+    }
+    brute /= (1 << others);
+    EXPECT_NEAR(r.ber_zero[r.num_phases / 2] / brute, 1.0, 0.02);
+}
+
+// 后游标压缩眼高；理想 DFE 抵消后恢复
+TEST(StatEyeTest, DfeCancelsPostCursors) {
+    StatEyeParams p;
+    p.noise_sigma = 0.001;
+    p.voltage_bins = 400;
+    std::vector<double> pulse = ui_pulse({0.2, 0.06, 0.03}, 8, 2);
+    StatEyeResult no_dfe = compute_stat_eye(pulse, 8, p);
+    p.num_dfe = 2;
+    StatEyeResult dfe = compute_stat_eye(pulse, 8, p);
+
+    double margin = 7.0 * 0.001;                             // Q^-1(1e-12) ~ 7 sigma per side
+    EXPECT_NEAR(no_dfe.eye_height, 2.0 * (0.2 - 0.09) - 2.0 * margin, 0.005);
+    EXPECT_NEAR(dfe.eye_height, 2.0 * 0.2 - 2.0 * margin, 0.005);
+    p.dfe_taps = {0.06};                                     // Fixed taps override num_dfe
+    StatEyeResult one_tap = compute_stat_eye(pulse, 8, p);
+    EXPECT_NEAR(one_tap.eye_height, 2.0 * (0.2 - 0.03) - 2.0 * margin, 0.005);
+}
+
+// 双狄拉克抖动缩小眼宽
+TEST(StatEyeTest, DualDiracJitterClosesWidth) {
+    // Linear edges so the eye width depends on the sampling phase
+    const int spu = 32;
+    std::vector<double> pulse(4 * spu, 0.0);
+    for (int i = 0; i < 2 * spu; ++i) {
+        pulse[spu + i] = 0.2 * (1.0 - std::fabs(i - spu) / static_cast<double>(spu));
+    }
+    StatEyeParams p;
+    p.noise_sigma = 0.002;
+    StatEyeResult clean = compute_stat_eye(pulse, spu, p);
+    p.dj = 0.25;
+    StatEyeResult dj = compute_stat_eye(pulse, spu, p);
+    p.rj = 0.01;
+    StatEyeResult tj = compute_stat_eye(pulse, spu, p);
+    EXPECT_GT(clean.eye_width, 0.5);
+    EXPECT_NEAR(clean.eye_width - dj.eye_width, 0.25, 2.0 / spu);
+    EXPECT_LT(tj.eye_width, dj.eye_width - 1.5 / spu);
+    EXPECT_LT(dj.eye_height, clean.eye_height);
+}
+
+// 链路脉冲响应的统计眼：张开，加 DFE 后眼高不减
+TEST(StatEyeTest, LinkStatEyeOpens) {
+    TxParams tx;
+    tx.ffe.taps = {1.0};
+    ChannelParams ch;
+    ch.attenuation_db = 6.0;
+    ch.bandwidth_hz = 20e9;
+    RxParams rx;
+    rx.ctle.zeros = {1e9};
+    rx.ctle.poles = {3e9, 15e9};
+    rx.vga.zeros = {};
+    rx.vga.poles = {25e9};
+    rx.vga.dc_gain = 2.0;
+    StatEyeParams p;
+    p.pulse_ui = 32;
+    StatEyeResult r0 = link_stat_eye(p, tx, ch, rx, 2e-12, 50);
+    p.num_dfe = 3;
+    StatEyeResult r3 = link_stat_eye(p, tx, ch, rx, 2e-12, 50);
+    EXPECT_GT(r0.eye_height, 0.0);
+    EXPECT_GE(r3.eye_height, r0.eye_height);
+    EXPECT_EQ(r0.num_phases, 50);
+    EXPECT_EQ(static_cast<int>(r0.ber.size()), 50 * p.voltage_bins);
+}
+
+// 非法参数
+TEST(StatEyeTest, RejectsInvalidInput) {
+    StatEyeParams p;
+    EXPECT_THROW(compute_stat_eye({}, 8, p), std::invalid_argument);
+    EXPECT_THROW(compute_stat_eye(std::vector<double>(16, 0.0), 8, p), std::invalid_argument);
+    p.voltage_bins = 7;
+    EXPECT_THROW(compute_stat_eye(ui_pulse({0.1}, 8, 1), 8, p), std::invalid_argument);
+    p = StatEyeParams();
+    p.target_ber = 0.0;
+    EXPECT_THROW(compute_stat_eye(ui_pulse({0.1}, 8, 1), 8, p), std::invalid_argument);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file test_state_checkpoint.cpp
+ * @brief Unit tests for the link state checkpoint and the per-block
+ *        save/restore of adaptive and filter state
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "common/checkpoint.h"
+#include "ams/cdr_nco.h"
+#include "ams/crosstalk_aggressor.h"
+#include "ams/dfe_feedback.h"
+#include "ams/dfe_tap_update.h"
+#include "ams/noise_generator.h"
+
+using namespace serdes;
+
+// 文本往返：实数 17 位有效数字，整数（含 64 位无符号位型）精确恢复
+TEST(StateCheckpointTest, TextRoundTripIsExact) {
+    StateCheckpoint cp;
+    cp.put_real("tb.rx.cdr.integral", 0.1 + 0.2);
+    cp.put_real("tb.rx.dfe.taps", std::vector<double>{1.0 / 3.0, -2e-17, 0.0});
+    cp.put_int("tb.rx.dfe.counts", std::vector<std::int64_t>{0, -5, 7});
+    cp.put_uint("tb.rx.cdr.nco.acc", 0xfedcba9876543210ull);
+    cp.put_real("tb.rx.empty", std::vector<double>());
+
+    std::stringstream ss;
+    cp.write(ss);
+    StateCheckpoint back;
+    back.read(ss);
+
+    EXPECT_EQ(back.size(), cp.size());
+    EXPECT_EQ(back.get_real("tb.rx.cdr.integral"), 0.1 + 0.2);
+    EXPECT_EQ(back.get_real_vector("tb.rx.dfe.taps"), cp.get_real_vector("tb.rx.dfe.taps"));
+    EXPECT_EQ(back.get_int_vector("tb.rx.dfe.counts"), cp.get_int_vector("tb.rx.dfe.counts"));
+    EXPECT_EQ(back.get_uint("tb.rx.cdr.nco.acc"), 0xfedcba9876543210ull);
+    EXPECT_TRUE(back.get_real_vector("tb.rx.empty").empty());
+
+    StateCheckpoint cdr = back.subset("tb.rx.cdr.");
+    EXPECT_EQ(cdr.size(), 2u);
+    EXPECT_TRUE(cdr.has("tb.rx.cdr.nco.acc"));
+    EXPECT_FALSE(cdr.has("tb.rx.dfe.taps"));
+}
+
+// 缺失键、非标量、格式错误均抛出异常
+TEST(StateCheckpointTest, RejectsMissingAndMalformedEntries) {
+    StateCheckpoint cp;
+    cp.put_real("a", std::vector<double>{1.0, 2.0});
+    EXPECT_THROW(cp.get_real("a"), std::invalid_argument);
+    EXPECT_THROW(cp.get_real("b"), std::invalid_argument);
+    EXPECT_THROW(cp.get_int("a"), std::invalid_argument);
+
+    std::istringstream bad("r key 3 1.0 2.0\n");
+    EXPECT_THROW(cp.read(bad), std::invalid_argument);
+    std::istringstream unknown("x key 1 1\n");
+    EXPECT_THROW(cp.read(unknown), std::invalid_argument);
+    EXPECT_THROW(cp.load("/nonexistent/dir/state.txt"), std::runtime_error);
+
+    DfeFeedbackKernel kernel;
+    kernel.configure({0.1, 0.05}, true, 1.0);
+    StateCheckpoint other;
+    DfeFeedbackKernel wider;
+    wider.configure({0.1, 0.05, 0.02}, true, 1.0);
+    wider.save_state(other, "k");
+    EXPECT_THROW(kernel.restore_state(other, "k"), std::invalid_argument);
+}
+
+// 噪声流：恢复位置后继续产生完全相同的序列
+TEST(StateCheckpointTest, NoiseStreamContinuesIdentically) {
+    NoiseStream a(42, "tb.rx.ctle");
+    for (int i = 0; i < 1001; ++i) a.next_normal();
+    for (int i = 0; i < 17; ++i) a.next_uniform();
+    StateCheckpoint cp;
+    a.save_state(cp, "noise");
+
+    NoiseStream b(42, "tb.rx.ctle");
+    b.restore_state(cp, "noise");
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(a.next_normal(), b.next_normal()) << i;
+        ASSERT_EQ(a.next_uniform(), b.next_uniform()) << i;
+    }
+}
+
+// DFE：已训练抽头、判决历史与 RLS 逆相关矩阵恢复后，后续更新逐位一致
+TEST(StateCheckpointTest, TrainedDfeContinuesIdentically) {
+    const int n = 4;
+    DfeTapUpdater upd_a;
+    upd_a.configure(DFEUpdateAlgorithm::RLS, n, 0.99, 1.0, 1e-3);
+    DfeBitHistory hist_a;
+    hist_a.resize(n);
+    std::vector<double> taps_a(n, 0.0);
+    std::uint32_t lfsr = 0x5a5au;
+    auto next_bit = [&lfsr]() {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xb400u);
+        return (lfsr & 1u) != 0;
+    };
+    for (int k = 0; k < 300; ++k) {
+        bool d = next_bit();
+        upd_a.update(taps_a, hist_a, 0.01, d ? 1.0 : -1.0, d ? 0.05 : -0.03);
+        hist_a.push(d);
+    }
+
+    StateCheckpoint cp;
+    cp.put_real("dfe.taps", taps_a);
+    hist_a.save_state(cp, "dfe.history");
+    upd_a.save_state(cp, "dfe.updater");
+
+    DfeTapUpdater upd_b;
+    upd_b.configure(DFEUpdateAlgorithm::RLS, n, 0.99, 1.0, 1e-3);
+    DfeBitHistory hist_b;
+    hist_b.resize(n);
+    std::vector<double> taps_b = cp.get_real_vector("dfe.taps");
+    hist_b.restore_state(cp, "dfe.history");
+    upd_b.restore_state(cp, "dfe.updater");
+    EXPECT_EQ(upd_b.get_inverse_correlation(), upd_a.get_inverse_correlation());
+
+    for (int k = 0; k < 200; ++k) {
+        bool d = next_bit();
+        double e = d ? 0.04 : -0.02;
+        upd_a.update(taps_a, hist_a, 0.01, d ? 1.0 : -1.0, e);
+        upd_b.update(taps_b, hist_b, 0.01, d ? 1.0 : -1.0, e);
+        hist_a.push(d);
+        hist_b.push(d);
+        ASSERT_EQ(taps_a, taps_b) << k;
+    }
+
+    DfeFeedbackKernel ka;
+    ka.configure(taps_a, true, 0.5);
+    for (int k = 0; k < 3; ++k) ka.push(next_bit());
+    ka.save_state(cp, "summer");
+    DfeFeedbackKernel kb;
+    kb.configure(std::vector<double>(n, 0.0), true, 0.5);
+    kb.restore_state(cp, "summer");
+    EXPECT_EQ(kb.taps(), ka.taps());
+    EXPECT_EQ(kb.feedback(), ka.feedback());
+}
+
+// CDR 相位累加器与串扰攻击者：恢复后触发时刻和输出逐样本一致
+TEST(StateCheckpointTest, CdrNcoAndAggressorContinueIdentically) {
+    const double ui = 100e-12;
+    const double ts = ui / 16.0;
+    CdrPhaseNco a;
+    a.configure(ui, ts, 1e-12);
+    a.set_code(5);
+    for (int i = 0; i < 1237; ++i) a.advance();
+    StateCheckpoint cp;
+    a.save_state(cp, "nco");
+
+    CdrPhaseNco b;
+    b.configure(ui, ts, 1e-12);
+    b.restore_state(cp, "nco");
+    EXPECT_EQ(b.get_code(), 5);
+    for (int i = 0; i < 1000; ++i) {
+        a.advance();
+        b.advance();
+        std::uint64_t sa = 0, sb = 0;
+        ASSERT_EQ(a.crossed(CdrPhaseNco::DATA_POINT, sa), b.crossed(CdrPhaseNco::DATA_POINT, sb));
+        ASSERT_EQ(sa, sb);
+    }
+
+    CrosstalkAggressorParams p;
+    p.pulse_response = {0.0, 0.02, 0.05, 0.03, 0.01, 0.005};
+    p.pulse_dt = ui / 2.0;
+    p.prbs = PRBSType::PRBS7;
+    p.seed = 3;
+    CrosstalkAggressor xa(p, ui);
+    xa.initialize(ts);
+    for (int i = 0; i < 777; ++i) xa.process();
+    xa.save_state(cp, "xtalk0");
+    CrosstalkAggressor xb(p, ui);
+    xb.initialize(ts);
+    xb.restore_state(cp, "xtalk0");
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(xa.process(), xb.process()) << i;
+    }
+}
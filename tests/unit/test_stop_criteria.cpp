@@ -0,0 +1,157 @@
+/**
+ * @file test_stop_criteria.cpp
+ * @brief Unit tests for the early-termination stop criteria
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include "ams/stop_criteria.h"
+#include "ams/prbs_sync_checker.h"
+#include "common/prbs.h"
+
+using namespace serdes;
+
+namespace {
+
+LinkMetrics metrics(double t, std::uint64_t bits, std::uint64_t errors, bool locked = true) {
+    LinkMetrics m;
+    m.time = t;
+    m.locked = locked;
+    m.bits = bits;
+    m.errors = errors;
+    m.taps = {0.1, -0.02};
+    m.cdr_phase = 1e-12;
+    return m;
+}
+
+} // namespace
+
+// BER 置信下限：零误码为 0，低于点估计，与上限构成区间
+TEST(StopCriteriaTest, BerLowerBound) {
+    const std::uint64_t n = 1000000;
+    EXPECT_EQ(ber_lower_bound(0, n, 0.95), 0.0);
+    EXPECT_NEAR(ber_lower_bound(1, n, 0.95) * n, -std::log(0.95), 1e-6);
+    EXPECT_NEAR(ber_lower_bound(10, n, 0.95) * n, 5.4254, 1e-3);       // Chi-square table
+    for (std::uint64_t e : {1ull, 10ull, 1000ull, 1001ull, 100000ull}) {
+        EXPECT_LT(ber_lower_bound(e, n, 0.95) * n, static_cast<double>(e));
+        EXPECT_GT(ber_upper_bound(e, n, 0.95) * n, static_cast<double>(e));
+    }
+    EXPECT_NEAR(ber_lower_bound(1000, n, 0.95) / ber_lower_bound(1001, n, 0.95), 1.0, 2e-3);
+}
+
+// 零误码比特数足够时判通过，之前不判
+TEST(StopCriteriaTest, PassesWhenUpperBoundBelowTarget) {
+    StopCriteriaParams p;
+    p.target_ber = 1e-6;
+    StopCriteria sc;
+    sc.configure(p);
+    EXPECT_EQ(sc.evaluate(metrics(1e-6, 2000000, 0)), StopReason::NONE);     // 1.5e-6 > target
+    EXPECT_EQ(sc.evaluate(metrics(2e-6, 3100000, 0)), StopReason::BER_PASS);
+    EXPECT_EQ(sc.evaluate(metrics(3e-6, 3100000, 500)), StopReason::BER_PASS);  // Latched
+    EXPECT_STREQ(stop_reason_name(sc.get_reason()), "ber_pass");
+}
+
+// 误码率明显超标时判失败；未锁定与 min_time 之前不判
+TEST(StopCriteriaTest, FailsWhenLowerBoundAboveTarget) {
+    StopCriteriaParams p;
+    p.target_ber = 1e-6;
+    p.min_time = 1e-6;
+    StopCriteria sc;
+    sc.configure(p);
+    EXPECT_EQ(sc.evaluate(metrics(0.5e-6, 100000, 50)), StopReason::NONE);        // Before min_time
+    EXPECT_EQ(sc.evaluate(metrics(2e-6, 100000, 50, false)), StopReason::NONE);   // Not locked
+    EXPECT_EQ(sc.evaluate(metrics(2e-6, 1000000, 1)), StopReason::NONE);          // Undecided
+    EXPECT_EQ(sc.evaluate(metrics(3e-6, 1000000, 8)), StopReason::BER_FAIL);
+}
+
+// 抽头与 CDR 相位连续 N 次稳定后判收敛；任何一次波动清零计数
+TEST(StopCriteriaTest, SettlesAfterStableChecks) {
+    StopCriteriaParams p;
+    p.stop_on_pass = false;
+    p.stop_on_fail = false;
+    p.settle_checks = 3;
+    StopCriteria sc;
+    sc.configure(p);
+    LinkMetrics m = metrics(1e-7, 0, 0, false);
+    EXPECT_EQ(sc.evaluate(m), StopReason::NONE);               // First check has no reference
+    EXPECT_EQ(sc.evaluate(m), StopReason::NONE);
+    EXPECT_EQ(sc.evaluate(m), StopReason::NONE);
+    m.taps[1] += 5e-3;                                         // Tap still moving
+    EXPECT_EQ(sc.evaluate(m), StopReason::NONE);
+    EXPECT_EQ(sc.get_stable_checks(), 0);
+    m.cdr_phase += 0.2e-12;                                    // Within tolerance
+    EXPECT_EQ(sc.evaluate(m), StopReason::NONE);
+    EXPECT_EQ(sc.evaluate(m), StopReason::NONE);
+    EXPECT_EQ(sc.evaluate(m), StopReason::SETTLED);
+}
+
+// 失步：判失败，且之后不再判通过
+TEST(StopCriteriaTest, SyncLossFailsAndBlocksPass) {
+    StopCriteriaParams p;
+    p.target_ber = 1e-6;
+    StopCriteria sc;
+    sc.configure(p);
+    LinkMetrics m = metrics(2e-6, 3100000, 0);
+    m.sync_losses = 1;
+    EXPECT_EQ(sc.evaluate(m), StopReason::SYNC_LOSS);
+    EXPECT_STREQ(stop_reason_name(sc.get_reason()), "sync_loss");
+
+    p.stop_on_fail = false;
+    sc.configure(p);
+    EXPECT_EQ(sc.evaluate(m), StopReason::NONE);                // Relocked, zero errors counted
+    m.sync_losses = 0;
+    EXPECT_EQ(sc.evaluate(m), StopReason::BER_PASS);
+}
+
+// JTOL 试验：SJ 造成的滑码被检测器丢弃、BER 仍低于目标，但试验必须判失败
+TEST(StopCriteriaTest, SlippingTrialFails) {
+    const double target = 1e-5;
+    for (bool slip : {false, true}) {
+        PrbsCheckerParams cp;
+        cp.type = PRBSType::PRBS15;
+        PrbsSyncChecker checker;
+        checker.configure(cp);
+        PrbsLfsr tx(PRBSType::PRBS15, 5);
+        for (int i = 0; i < 4000000; ++i) {
+            if (slip && i % 1000000 == 500000) {
+                tx.next_bit();                                  // Receiver drops one bit
+            }
+            checker.push(tx.next_bit());
+        }
+        LinkMetrics m;
+        m.locked = checker.is_locked();
+        m.bits = checker.get_bit_count();
+        m.errors = checker.get_error_count();
+        m.sync_losses = checker.get_sync_losses();
+        ASSERT_TRUE(m.locked);
+        EXPECT_LE(checker.get_ber(), target);                   // The slips are not in the BER
+
+        StopCriteriaParams p;
+        p.target_ber = target;
+        StopCriteria sc;
+        sc.configure(p);
+        m.time = 1e-3;
+        StopReason reason = sc.evaluate(m);
+        EXPECT_EQ(reason, slip ? StopReason::SYNC_LOSS : StopReason::BER_PASS);
+        EXPECT_EQ(trial_passed(m, reason, target), !slip);
+        EXPECT_EQ(trial_passed(m, StopReason::NONE, target), !slip);   // Undecided run
+    }
+}
+
+// 非法参数
+TEST(StopCriteriaTest, RejectsInvalidParameters) {
+    StopCriteria sc;
+    StopCriteriaParams p;
+    p.check_interval = 0.0;
+    EXPECT_THROW(sc.configure(p), std::invalid_argument);
+    p = StopCriteriaParams();
+    p.target_ber = 0.0;
+    EXPECT_THROW(sc.configure(p), std::invalid_argument);
+    p.stop_on_pass = false;
+    p.stop_on_fail = false;
+    EXPECT_NO_THROW(sc.configure(p));
+    p = StopCriteriaParams();
+    p.settle_checks = -1;
+    EXPECT_THROW(sc.configure(p), std::invalid_argument);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file test_wave_gen_sj_injection.cpp
+ * @brief Unit test for WaveGenerationTdf module - Sinusoidal Jitter Injection
+ */
+
+#include "wave_generation_test_common.h"
+
+using namespace serdes;
+using namespace serdes::test;
+
+namespace {
+
+SC_MODULE(SjTestbench) {
+    WaveGenerationTdf* wave_gen;
+    SimpleReceiver* receiver;
+    sca_tdf::sca_signal<double> sig_wave;
+
+    SjTestbench(sc_core::sc_module_name nm, const WaveGenParams& params,
+                double sample_rate, double ui, size_t max_samples)
+        : sc_core::sc_module(nm)
+    {
+        wave_gen = new WaveGenerationTdf("wave_gen", params, sample_rate, ui, 12345);
+        receiver = new SimpleReceiver("receiver", max_samples);
+        wave_gen->out(sig_wave);
+        receiver->in(sig_wave);
+    }
+};
+
+} // namespace
+
+// SJ 注入：每个跳变沿按 k*UI + A*sin(2*pi*f*k*UI) 移位（一个时间步分辨率），电平保持 ±1
+TEST(WaveGenJitterTest, SinusoidalJitterMovesEdges) {
+    const double ui = 100e-12;
+    const double fs = 100e9;              // 10 samples per UI
+    const double sj_freq = 250e6;         // 40 UI period
+    const double sj_pp = 0.5 * ui;        // +/-2.5 samples
+
+    WaveGenParams params;
+    params.type = PRBSType::PRBS7;
+    params.jitter.SJ_freq.push_back(sj_freq);
+    params.jitter.SJ_pp.push_back(sj_pp);
+
+    SjTestbench* tb = new SjTestbench("tb_sj", params, fs, ui, 4000);
+    EXPECT_TRUE(tb->wave_gen->has_jitter());
+
+    sc_core::sc_start(40, sc_core::SC_NS);
+
+    const std::vector<double>& s = tb->receiver->get_samples();
+    ASSERT_EQ(s.size(), 4000u);
+    int edges = 0;
+    double max_shift = 0.0;
+    for (size_t n = 1; n < s.size(); ++n) {
+        EXPECT_TRUE(std::abs(s[n] - 1.0) < 1e-9 || std::abs(s[n] + 1.0) < 1e-9);
+        if (s[n] == s[n - 1]) continue;
+        // Edge before symbol k sits at the first sample at or after its jittered time
+        int k = static_cast<int>(std::lround(static_cast<double>(n) / 10.0));
+        double expected = 10.0 * k + 0.5 * sj_pp * fs * std::sin(2.0 * M_PI * sj_freq * k * ui);
+        EXPECT_NEAR(static_cast<double>(n), std::ceil(expected), 1.0) << "edge at sample " << n;
+        max_shift = std::max(max_shift, std::abs(static_cast<double>(n) - 10.0 * k));
+        ++edges;
+    }
+    EXPECT_GT(edges, 100);
+    EXPECT_GE(max_shift, 2.0);
+    EXPECT_LE(max_shift, 3.0);
+
+    sc_core::sc_stop();
+}